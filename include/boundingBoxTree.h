@@ -0,0 +1,163 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef boundingBoxTree_H_
+#define boundingBoxTree_H_
+#include "headers.h"
+
+namespace dftfe
+{
+  namespace vectorTools
+  {
+
+    /**
+     *  @brief Axis aligned bounding box stored as lower and upper corners.
+     */
+    struct boundingBox
+    {
+      double lower[3];
+      double upper[3];
+
+      /// constructs an empty (inverted) box
+      boundingBox();
+
+      /// extends the box to also contain box
+      void extend(const boundingBox & box);
+
+      /// returns true if p lies inside the box (boundaries included)
+      bool containsPoint(const dealii::Point<3> & p) const;
+
+      /// returns true if the box and box overlap (boundaries included)
+      bool intersects(const boundingBox & box) const;
+
+      /// returns center of the box along idim
+      double center(const unsigned int idim) const;
+    };
+
+    /** @brief bounding box of a cell computed from its vertices (exact for MappingQ1) and
+     *  enlarged by a small tolerance relative to the cell diameter.
+     */
+    boundingBox cellBoundingBox(const dealii::TriaAccessor<3,3,3> & cell);
+
+    /**
+     *  @brief Bounding volume hierarchy over a set of boxes, each box carrying an id.
+     *
+     *  Built by recursive median splits along the longest extent of the box centers.
+     *  Used for fast point location without a serial triangulation.
+     */
+    class boundingBoxTree
+    {
+     public:
+
+      /** @brief builds the tree
+       *
+       *  @param[in] boxes bounding boxes
+       *  @param[in] ids id attached to each box, need not be unique
+       */
+      void build(const std::vector<boundingBox> & boxes,
+		 const std::vector<unsigned int> & ids);
+
+      /** @brief appends the ids of all boxes containing p
+       *
+       *  @param[in] p point to be located
+       *  @param[out] idsFound ids of the boxes containing p are appended
+       */
+      void findBoxesContainingPoint(const dealii::Point<3> & p,
+				    std::vector<unsigned int> & idsFound) const;
+
+      /** @brief appends the ids of all boxes intersecting box
+       *
+       *  @param[in] box query box
+       *  @param[out] idsFound ids of the boxes intersecting box are appended
+       */
+      void findBoxesIntersectingBox(const boundingBox & box,
+				    std::vector<unsigned int> & idsFound) const;
+
+     private:
+
+      struct node
+      {
+	boundingBox box;
+	int left;
+	int right;
+	unsigned int begin;
+	unsigned int end;
+      };
+
+      unsigned int buildNode(const unsigned int begin,
+			     const unsigned int end);
+
+      std::vector<boundingBox> d_boxes;
+      std::vector<unsigned int> d_ids;
+      std::vector<unsigned int> d_order;
+      std::vector<node> d_nodes;
+    };
+
+    /** @brief gathers coarse bounding boxes of the locally owned cells of all processors and
+     *  builds a tree over them with the owning processor id attached to each box.
+     *
+     *  The locally owned cells are expected in the p4est space filling curve order, so that chunks of
+     *  consecutive cells are spatially compact. Each processor contributes at most maxBoxesPerProc boxes.
+     *
+     *  @param[in] locallyOwnedCellBoxes bounding boxes of locally owned cells
+     *  @param[in] maxBoxesPerProc maximum number of boxes per processor
+     *  @param[in] mpi_comm communicator of the domain decomposition
+     *  @param[out] partitionBoxesTree tree over the boxes of all processors
+     */
+    void buildPartitionBoundingBoxTree(const std::vector<boundingBox> & locallyOwnedCellBoxes,
+				       const unsigned int maxBoxesPerProc,
+				       const MPI_Comm & mpi_comm,
+				       boundingBoxTree & partitionBoxesTree);
+
+    /** @brief radius beyond which the Gaussian generator weight exp(-(r/gaussianConstant)^exponent)
+     *  falls below weightTolerance.
+     *
+     *  @param[in] gaussianConstant constant in the Gaussian generator
+     *  @param[in] exponent exponent of r in the Gaussian generator (2 or 4)
+     *  @param[in] weightTolerance weight below which the Gaussian generator is treated as zero
+     */
+    double gaussianGeneratorSupportRadius(const double gaussianConstant,
+					  const unsigned int exponent,
+					  const double weightTolerance=1.0e-16);
+
+    /** @brief builds a tree over the cubes of half width supportRadius centered at the control points
+     *  with the index of the control point attached to each cube. Used to find the control points
+     *  whose pruned Gaussian generator support intersects a cell.
+     *
+     *  @param[in] controlPoints control point locations
+     *  @param[in] supportRadius support radius of the Gaussian generator
+     *  @param[out] controlPointsTree tree over the control point supports
+     */
+    void buildControlPointsSupportTree(const std::vector<dealii::Point<3> > & controlPoints,
+				       const double supportRadius,
+				       boundingBoxTree & controlPointsTree);
+
+    /** @brief sorted ids of the control points whose support intersects the bounding box of a cell
+     *  enlarged by padding along each direction.
+     *
+     *  @param[in] cell cell
+     *  @param[in] controlPointsTree tree built by buildControlPointsSupportTree
+     *  @param[in] padding enlargement of the cell bounding box
+     *  @param[out] candidateIds sorted ids of the candidate control points
+     */
+    void findCellControlPointCandidates(const dealii::TriaAccessor<3,3,3> & cell,
+					const boundingBoxTree & controlPointsTree,
+					const double padding,
+					std::vector<unsigned int> & candidateIds);
+
+  }
+}
+#endif
@@ -27,6 +27,12 @@ namespace dftfe {
     /// Boltzmann constant
     const double C_kb = 3.166811429e-06;
 
+    /// atomic unit of time in femtoseconds
+    const double C_AtomicUnitOfTimeFs = 2.418884326585747e-02;
+
+    /// atomic mass unit (Dalton) in electron masses
+    const double C_AMUToElectronMass = 1822.888486;
+
     /// problem space dimensions
     const int C_DIM = 3;
 
@@ -71,6 +71,14 @@ namespace dftUtils
 			const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & partitioner2,
 			const unsigned int blockSize);
 
+    /**
+     * @brief sets the map between local processor index of unflattened deallii array to the local processor index of
+     * the first field associated with the multi-field flattened dealii array from a map precomputed elsewhere
+     *
+     * @param localIndexMapUnflattenedToFlattened precomputed map which is shared and not copied
+     */
+    void precomputeMaps(const std::shared_ptr<const std::vector<unsigned int> > & localIndexMapUnflattenedToFlattened);
+
     /**
      * @brief overloaded dealii internal function "distribute" which sets the slave node
      * field values from master nodes
@@ -128,7 +136,7 @@ namespace dftUtils
     std::vector<double> d_columnValues;
     std::vector<double> d_inhomogenities;
     std::vector<dealii::types::global_dof_index> d_rowSizes;
-    std::vector<dealii::types::global_dof_index> d_localIndexMapUnflattenedToFlattened;
+    std::shared_ptr<const std::vector<unsigned int> > d_localIndexMapUnflattenedToFlattened;
 
 
   };
@@ -26,6 +26,7 @@
 #include <headers.h>
 #include <constants.h>
 #include <constraintMatrixInfo.h>
+#include <flattenedArrayRegistry.h>
 
 #include <kohnShamDFTOperator.h>
 #include <meshMovementAffineTransform.h>
@@ -75,6 +76,10 @@ namespace dftfe {
   template <unsigned int T> class forceClass;
   template <unsigned int T> class geoOptIon;
   template <unsigned int T> class geoOptCell;
+  template <unsigned int T> class geoOptIonCell;
+  template <unsigned int T> class molecularDynamics;
+  template <unsigned int T> class perturbedGeometryForces;
+  template <unsigned int T> class kernelBenchmark;
 
 #endif /* DOXYGEN_SHOULD_SKIP_THIS */
 
@@ -99,6 +104,18 @@ namespace dftfe {
       template <unsigned int T>
 	friend class geoOptCell;
 
+      template <unsigned int T>
+	friend class geoOptIonCell;
+
+      template <unsigned int T>
+	friend class molecularDynamics;
+
+      template <unsigned int T>
+	friend class perturbedGeometryForces;
+
+      template <unsigned int T>
+	friend class kernelBenchmark;
+
       template <unsigned int T>
 	friend class symmetryClass;
 
@@ -110,10 +127,12 @@ namespace dftfe {
        *  @param[in] mpi_comm_replica  mpi_communicator for domain decomposition parallelization
        *  @param[in] interpoolcomm  mpi_communicator for parallelization over k points
        *  @param[in] interBandGroupComm  mpi_communicator for parallelization over bands
+       *  @param[in] interSpinGroupComm  mpi_communicator for parallelization over spin channels
        */
       dftClass(const MPI_Comm &mpi_comm_replica,
 	       const MPI_Comm &interpoolcomm,
-	       const MPI_Comm &interBandGroupComm);
+	       const MPI_Comm &interBandGroupComm,
+	       const MPI_Comm &interSpinGroupComm);
 
       /**
        * @brief dftClass destructor
@@ -146,6 +165,13 @@ namespace dftfe {
        */
       void run();
 
+      /**
+       * @brief Solves the ground-state of each structure of the ENSEMBLE STRUCTURES FILE in a single launch.
+       * The set, init and run steps are performed for each structure, starting from the ground-state
+       * of the most similar compatible structure solved before it
+       */
+      void runEnsemble();
+
       /**
        * @brief compute approximation to ground-state without solving the SCF iteration
        */
@@ -316,6 +342,35 @@ namespace dftfe {
       void initElectronicFields(const unsigned int usePreviousGroundStateFields=0);
       void initPseudoPotentialAll();
 
+      /**
+       *@brief computes the additional cost of the locally owned cells in the Hamiltonian times
+       * wavefunctions product due to the nonlocal pseudopotential projectors, relative to the
+       * default p4est cell weight of 1000 representing the cost of the local part. A cell is taken to
+       * lie in the compact support of a nonlocal atom if its bounding ball intersects the ball of the
+       * outermost projector radius around the atom or one of its images. Only requires the triangulation
+       * and the projector data read by initNonLocalPseudoPotential_OV, so that it can be called before
+       * the mesh dependent data is initialized.
+       *
+       *@param[in] triangulation parallel triangulation whose locally owned cells are weighted
+       *@param[out] cellWeights map from CellId to the additional cost of the cell
+       *@return estimated load imbalance (maximum/average cost over MPI tasks)
+       */
+      double computeCellCostWeights(const parallel::distributed::Triangulation<3> & triangulation,
+				    std::map<dealii::CellId,unsigned int> & cellWeights) const;
+
+      /**
+       *@brief estimates the peak memory of the ground-state solve (and the force computation if required) on each
+       * processor from the mesh, the pseudopotential data and the input parameters, and compares the estimated
+       * memory of each compute node with MEMORY BUDGET PER NODE. Must be called at the end of init.
+       */
+      void estimateMemory();
+
+      /**
+       *@brief updates the memory ledger with the sizes of the electron-density mixing history and the
+       * local pseudopotential quadrature data
+       */
+      void updateMemoryLedgerDensityData();
+
       /**
        * create a dofHandler containing finite-element interpolating polynomial twice of the original polynomial
        * required for Kerker mixing
@@ -362,6 +417,60 @@ namespace dftfe {
 	                             const dealii::ConstraintMatrix & constraintMatrixBase,
 	                             dealii::ConstraintMatrix & constraintMatrix);
       void initRho();
+
+      /**
+       *@brief reads the single atom electron-densities of all atom types and creates their cubic spline
+       * interpolants along with their outermost radial points
+       */
+      void readSingleAtomRhoSplines(std::map<unsigned int, alglib::spline1dinterpolant> & denSpline,
+				    std::map<unsigned int, double> & outerMostPointDen);
+
+      /**
+       *@brief computes the superposition of single atom electron-densities (and its gradient for GGA)
+       * at the cell quadrature points for the current atomic positions
+       */
+      void computeAtomicRhoSuperposition(std::map<dealii::CellId, std::vector<double> > & rhoAtomic,
+					 std::map<dealii::CellId, std::vector<double> > & gradRhoAtomic);
+
+      /**
+       *@brief adds scalingFactor times the superposition of single atom electron-densities to the
+       * density fields (rho, grad rho (GGA), and spin-polarized rho and grad rho, in that order)
+       */
+      void addAtomicRhoSuperposition(std::vector<std::map<dealii::CellId, std::vector<double> > > & rhoFields,
+				     const std::map<dealii::CellId, std::vector<double> > & rhoAtomic,
+				     const std::map<dealii::CellId, std::vector<double> > & gradRhoAtomic,
+				     const double scalingFactor);
+
+      /**
+       *@brief stores the current ground-state electron-density relative to the superposition of
+       * single atom electron-densities, before the atoms are moved
+       */
+      void storeGroundStateForExtrapolation();
+
+      /**
+       *@brief extrapolates the starting electron-density at the new atomic positions from the stored
+       * ground-states. Returns true if a linear or higher order extrapolation was used.
+       */
+      bool extrapolateRho();
+
+      /**
+       *@brief linearly extrapolates the starting wavefunctions from the current and the previous
+       * ground-state wavefunctions after aligning the previous subspace to the current subspace.
+       * Returns true if the extrapolation was done.
+       */
+      bool extrapolateSubspace();
+
+      /**
+       *@brief clears the ground-state history used in the extrapolation
+       */
+      void clearGroundStateExtrapolationHistory();
+
+      /**
+       *@brief returns true if the starting guess of the next ground-state solve will be extrapolated,
+       * i.e. if previous ground-state electron-densities or wavefunctions are stored
+       */
+      bool isGroundStateExtrapolationDataAvailable() const;
+
       void computeRhoInitialGuessFromPSI(std::vector<std::vector<vectorType>> eigenVectors);
       void clearRhoData();
 
@@ -399,6 +508,24 @@ namespace dftfe {
 		      const bool isGradRhoDataPresent,
 		      const MPI_Comm &interComm);
 
+      /**
+       *@brief true if the spin channel is solved by the current spin group (NPSPIN=2) or if
+       *the spin channels are not parallelized
+       */
+      bool isSpinChannelOwned(const unsigned int spinIndex) const;
+
+      /**
+       *@brief broadcasts the eigenvalues and residual norms of each spin channel from the spin group
+       *owning it to the other spin group
+       */
+      void exchangeSpinChannelEigenValues(std::vector<std::vector<std::vector<double> > > & residualNormWaveFunctionsSpins);
+
+      /**
+       *@brief broadcasts the wavefunctions of each spin channel from the spin group owning it to the
+       *other spin group. Only required by the post-processing of the wavefunctions.
+       */
+      void exchangeSpinChannelWaveFunctions();
+
       /**
        *@brief resize and allocate table storage for rho cell quadratrue data
        */
@@ -437,6 +564,35 @@ namespace dftfe {
 
       void computeElementalOVProjectorKets();
 
+      /**
+       *@brief Flattens the elemental nonlocal projector matrices of all the nonlocal atoms
+       * touching a locally owned cell into one contiguous slab with CSR offsets per cell, and
+       * precomputes the local indices of the projectors in the parallel layout of
+       * d_projectorKetTimesVectorParFlattened. Must be called after the sparse structure of the
+       * nonlocal projectors is computed.
+       *
+       * @param nonLocalProjectorElementMatrices elemental projector matrices of each nonlocal atom
+       * in the order of its compact support elements (and of the k points for complex)
+       */
+#ifdef USE_COMPLEX
+      void flattenElementalProjectorKets(const std::vector<std::vector<std::vector<std::vector<std::complex<double> > > > > & nonLocalProjectorElementMatrices);
+#else
+      void flattenElementalProjectorKets(const std::vector<std::vector<std::vector<double> > > & nonLocalProjectorElementMatrices);
+#endif
+
+      /**
+       *@brief returns the elemental projector matrix (numberNodesPerElement x number of pseudo
+       * wavefunctions, column major) of a nonlocal atom in its compact support element from the
+       * flattened cell slab
+       *
+       * @param atomId nonlocal atom id
+       * @param nonZeroElementMatrixId index of the element in the compact support of the atom
+       * @param kPointIndex k point index (ignored for real)
+       */
+      const dataTypes::number * getNonLocalProjectorElementMatrix(const unsigned int atomId,
+								  const unsigned int nonZeroElementMatrixId,
+								  const unsigned int kPointIndex) const;
+
       /**
        *@brief Computes total charge by integrating the electron-density
        */
@@ -496,7 +652,9 @@ namespace dftfe {
        * Re solves the all electrostatics on a h refined mesh, and computes
        * the corresponding energy. This function
        * is called after reaching the ground state electron density. Currently the h refinement
-       * is hardcoded to a one subdivison of carser mesh
+       * is hardcoded to a one subdivison of carser mesh. If REUSE H REFINED ELECTROSTATICS is true,
+       * the h refined mesh data structures are reused across calls, and only the electron-density
+       * transfer and the total electrostatic potential solve are repeated if the atoms have not moved.
        * FIXME: The function is not yet extened to the case when point group symmetry is used.
        * However, it works for time reversal symmetry.
        *
@@ -513,6 +671,13 @@ namespace dftfe {
        */
       void compute_fermienergy_constraintMagnetization(const std::vector<std::vector<double>> & eigenValuesInput);
 
+      /**
+       *@brief Computes the number of lowest Kohn-Sham states, common to all k-points and spin channels,
+       *beyond which all states have a partial occupancy below OCCUPANCY CUTOFF. The unoccupied tail
+       *beyond this number is skipped in the electron-density, force and stress computations.
+       */
+      unsigned int computeNumberStatesAboveOccupancyCutoff() const;
+
       /**
        *@brief compute density of states and local density of states
        */
@@ -595,6 +760,9 @@ namespace dftfe {
 
       bool d_isAtomsGaussianDisplacementsReadFromFile=false;
 
+      /// pseudopotential files are converted to dftfe format only once in a single launch
+      bool d_isPseudoPotentialFilesConverted=false;
+
       /// Gaussian generator parameter for force computation and Gaussian deformation of atoms and FEM mesh
       /// Gaussian generator: Gamma(r)= exp(-(r/d_gaussianConstant)^2)
       const double d_gaussianConstantForce=0.75;
@@ -647,6 +815,26 @@ namespace dftfe {
       double d_autoMeshMaxJacobianRatio;
       unsigned int d_autoMesh;
 
+      /// maximum number of Chebyshev filter passes in a SCF iteration
+      unsigned int d_maxChebyshevFilterPassesPerScfIter;
+
+      /// history of the ground-state density fields relative to the superposition of single atom
+      /// electron-densities (front is the latest) used in the extrapolation of the starting electron-density
+      std::deque<std::vector<std::map<dealii::CellId,std::vector<double> > > > d_groundStateRhoDiffHistory;
+
+      /// previous ground-state wavefunctions used in the extrapolation of the starting wavefunctions
+      std::vector<std::vector<dataTypes::number> > d_eigenVectorsFlattenedSTLPrevious;
+
+      /// single atom electron-density splines and their outermost radial points used in the extrapolation
+      std::map<unsigned int, alglib::spline1dinterpolant> d_atomicRhoSplines;
+      std::map<unsigned int, double> d_atomicRhoOuterMostPoint;
+
+      /// true if the ground-state was stored before the last atomic position update
+      bool d_isGroundStateExtrapolationPending;
+
+      /// true if the starting guess of the next ground-state solve is extrapolated from previous ground-states
+      bool d_isGroundStateGuessExtrapolated;
+
 
       /// affine transformation object
       meshMovementAffineTransform d_affineTransformMesh;
@@ -681,6 +869,7 @@ namespace dftfe {
       const MPI_Comm   mpi_communicator;
       const MPI_Comm   interpoolcomm;
       const MPI_Comm   interBandGroupComm;
+      const MPI_Comm   interSpinGroupComm;
       const unsigned int n_mpi_processes;
       const unsigned int this_mpi_process;
       IndexSet   locally_owned_dofs, locally_owned_dofsEigen;
@@ -693,6 +882,9 @@ namespace dftfe {
       symmetryClass<FEOrder> * symmetryPtr;
       geoOptIon<FEOrder> * geoOptIonPtr;
       geoOptCell<FEOrder> * geoOptCellPtr;
+      geoOptIonCell<FEOrder> * geoOptIonCellPtr;
+      molecularDynamics<FEOrder> * molecularDynamicsPtr;
+      perturbedGeometryForces<FEOrder> * perturbedGeometryForcesPtr;
 
       /**
        * constraint Matrices
@@ -730,6 +922,13 @@ namespace dftfe {
        */
       dftUtils::constraintMatrixInfo constraintsNoneDataInfo2;
 
+      /**
+       *registry of the partitioners and index maps of the flattened wavefunction and projector arrays
+       *for each block size, reused until the mesh changes
+       *
+       */
+      vectorTools::flattenedArrayRegistry d_flattenedArrayRegistry;
+
 
       ConstraintMatrix constraintsNone, constraintsNoneEigen, d_constraintsForTotalPotential, d_noConstraints, d_constraintsPRefined;
 
@@ -838,8 +1037,34 @@ namespace dftfe {
       IndexSet d_locallyOwnedProjectorIdsCurrentProcess;
       IndexSet d_ghostProjectorIdsCurrentProcess;
       std::map<std::pair<unsigned int,unsigned int>, unsigned int> d_projectorIdsNumberingMapCurrentProcess;
+
+      //
+      //CSR-style cell storage of the nonlocal projectors used in the nonlocal Hamiltonian times X.
+      //The projectors touching the locally owned cell iElem are the entries
+      //[d_nonLocalProjectorCellStartIds[iElem],d_nonLocalProjectorCellStartIds[iElem+1]), whose
+      //local indices in the parallel layout of d_projectorKetTimesVectorParFlattened (in units of
+      //the number of wavefunctions) are stored in d_nonLocalProjectorCellLocalIds
+      //
+      std::vector<unsigned int> d_nonLocalProjectorCellStartIds;
+      std::vector<unsigned int> d_nonLocalProjectorCellLocalIds;
+
+      //
+      //cell projector id in the above CSR storage of the first projector of each nonlocal atom in each
+      //element of its compact support, [atomId][nonZeroElementMatrixId]
+      //
+      std::vector<std::vector<unsigned int> > d_nonLocalProjectorAtomElemCellIds;
+
+      //
+      //local indices and the nonlocal pseudopotential constants of all the projectors
+      //of the nonlocal atoms in d_nonLocalAtomIdsInCurrentProcess
+      //
+      std::vector<unsigned int> d_nonLocalProjectorLocalIdsCurrentProcess;
+      std::vector<double> d_nonLocalProjectorConstantsCurrentProcess;
 #ifdef USE_COMPLEX
-      std::vector<std::vector<std::vector<std::vector<std::complex<double> > > > > d_nonLocalProjectorElementMatrices,d_nonLocalProjectorElementMatricesConjugate,d_nonLocalProjectorElementMatricesTranspose;
+      /// element matrices of the projectors touching each locally owned cell (numberNodesPerElement x
+      /// number of cell projectors, column major) stored contiguously for all cells and k points in
+      /// the cell order given by d_nonLocalProjectorCellStartIds, and the complex conjugate of the same
+      dealii::AlignedVector<std::complex<double> > d_nonLocalProjectorElementMatricesCellFlattened,d_nonLocalProjectorElementMatricesConjugateCellFlattened;
 
 
       std::vector<dealii::parallel::distributed::Vector<std::complex<double> > > d_projectorKetTimesVectorPar;
@@ -849,7 +1074,10 @@ namespace dftfe {
       /// layout for every nonLocalHamiltionan times wavefunction computation
       dealii::parallel::distributed::Vector<std::complex<double> >  d_projectorKetTimesVectorParFlattened;
 #else
-      std::vector<std::vector<std::vector<double> > > d_nonLocalProjectorElementMatrices,d_nonLocalProjectorElementMatricesConjugate,d_nonLocalProjectorElementMatricesTranspose;
+      /// element matrices of the projectors touching each locally owned cell (numberNodesPerElement x
+      /// number of cell projectors, column major) stored contiguously for all cells in the cell order
+      /// given by d_nonLocalProjectorCellStartIds
+      dealii::AlignedVector<double> d_nonLocalProjectorElementMatricesCellFlattened;
 
 
       std::vector<dealii::parallel::distributed::Vector<double> > d_projectorKetTimesVectorPar;
@@ -888,6 +1116,38 @@ namespace dftfe {
       /// vselfBinsManager object
       vselfBinsManager<FEOrder> d_vselfBinsManager;
 
+      /// vselfBinsManager object on the h refined electrostatics mesh
+      vselfBinsManager<FEOrder> d_vselfBinsManagerHRefined;
+
+      /**
+       * data structures on the h refined electrostatics mesh. If REUSE H REFINED ELECTROSTATICS
+       * is true, they are built on the subdivided electrostatics triangulation of d_mesh and reused in
+       * subsequent calls to computeElectrostaticEnergyHRefined. The data depending only on the mesh
+       * topology is reused until the mesh is regenerated in init, while the data depending on the
+       * mesh geometry is recomputed when the atoms move. Otherwise they are freed at the end of each call.
+       */
+      DoFHandler<3> d_dofHandlerHRefined;
+      MatrixFree<3,double> d_matrixFreeDataHRefined;
+      ConstraintMatrix d_onlyHangingNodeConstraintsHRefined, d_constraintsHRefined, d_constraintsForTotalPotentialHRefined;
+      std::vector<const ConstraintMatrix * > d_constraintsVectorHRefined;
+      std::vector<const DoFHandler<3> * > d_dofHandlerVectorHRefined;
+      std::map<dealii::types::global_dof_index, double> d_atomHRefinedNodeIdToChargeMap;
+      std::vector<std::vector<double> > d_localVselfsHRefined;
+      std::map<dealii::CellId, std::vector<double> > d_pseudoVLocHRefined;
+      std::map<dealii::CellId, std::vector<double> > d_gradPseudoVLocHRefined;
+      std::map<unsigned int,std::map<dealii::CellId, std::vector<double> > > d_gradPseudoVLocAtomsHRefined;
+      vectorType d_phiExtHRefined;
+
+      /// total electrostatic potential on the h refined mesh, which is used as the initial guess of the next solve
+      vectorType d_phiTotRhoOutHRefined;
+
+      /// atom locations and domain bounding vectors at which the geometry dependent h refined data was computed
+      std::vector<std::vector<double> > d_atomLocationsHRefined;
+      std::vector<std::vector<double> > d_domainBoundingVectorsHRefined;
+
+      /// flag to check if the mesh topology dependent h refined data can be reused
+      bool d_isHRefinedElectrostaticsMeshCached;
+
       /// kPoint cartesian coordinates
       std::vector<double> d_kPointCoordinates;
 
@@ -903,6 +1163,18 @@ namespace dftfe {
 
       /// global k index of lower bound of the local k point set
       unsigned int lowerBoundKindex ;
+
+      /// Chebyshev filtering wall times and passes of the local k points in the current scf iteration
+      std::vector<double> d_kPointEigenSolveTimes;
+      std::vector<unsigned int> d_kPointChebyshevPassCounts;
+
+      /// cost history of the local k points used for the dynamic k point scheduling
+      std::vector<double> d_kPointCosts;
+
+      /// accumulated Chebyshev filtering and idle wall times, and Chebyshev filtering passes of the current pool
+      double d_kPointPoolEigenSolveTime;
+      double d_kPointPoolIdleTime;
+      unsigned int d_kPointPoolChebyshevPassCount;
       /**
        * Recomputes the k point cartesian coordinates from the crystal k point coordinates
        * and the current lattice vectors, which can change in each ground state solve when
@@ -910,6 +1182,32 @@ namespace dftfe {
        */
       void recomputeKPointCoordinates();
 
+      /**
+       * Initializes the per k-point cost and the per pool timing data used in the dynamic
+       * k-point scheduling across the k-point pools
+       */
+      void initKPointLoadBalancingData();
+
+      /**
+       * Updates the k-point cost history from the Chebyshev filtering wall times measured in the
+       * current scf iteration, accumulates the pool idle time, and re-assigns the k-points across
+       * the k-point pools if the load imbalance exceeds K POINT LOAD IMBALANCE TOL
+       */
+      void updateKPointCostsAndRebalance(const bool isRebalancingAllowed);
+
+      /**
+       * Moves the k-point data including the wavefunctions to the new contiguous assignment of
+       * the global k-points to the k-point pools
+       *
+       * @param[in] numberKPointsPerPool number of k-points assigned to each pool
+       */
+      void redistributeKPoints(const std::vector<unsigned int> & numberKPointsPerPool);
+
+      /**
+       * Prints the per pool Chebyshev filtering and idle wall times of the scf solve
+       */
+      void printKPointPoolTimings();
+
       /// fermi energy
       double fermiEnergy, fermiEnergyUp, fermiEnergyDown, d_groundStateEnergy, d_groundStateEnergyInitial;
 
@@ -49,7 +49,7 @@ namespace dftfe {
       extern bool autoUserMeshParams;
       extern double meshSizeInnerBall, meshSizeOuterBall;
       extern double chebyshevTolerance, topfrac, kerkerParameter;
-      extern std::string mixingMethod,ionOptSolver;
+      extern std::string mixingMethod,ionOptSolver,ionCellOptSolver;
 
 
       extern bool isIonOpt, isCellOpt, isIonForce, isCellStress;
@@ -57,9 +57,20 @@ namespace dftfe {
       extern double forceRelaxTol, stressRelaxTol, toleranceKinetic;
       extern unsigned int cellConstraintType;
 
+      extern bool isBOMD, isXLBOMD;
+      extern double timeStepBOMD, startingTempBOMD, thermostatTimeConstantBOMD;
+      extern unsigned int numberStepsBOMD, dissipationOrderXLBOMD, numSCFIterationsBOMD, chebyshevPassesBOMD;
+      extern std::string thermostatTypeBOMD, trajectoryFileBOMD;
+
+      extern std::string perturbedGeometriesFile, forcesFilePerturbedGeometry;
+      extern unsigned int chebyshevPassesPerturbedGeometry;
+
+      extern std::string ensembleStructuresFile, ensembleEnergiesFile;
+
       extern unsigned int verbosity, chkType;
       extern bool restartFromChk;
       extern bool electrostaticsHRefinement;
+      extern bool reuseElectrostaticsHRefinement;
       extern bool electrostaticsPRefinement;
 
       extern bool reproducible_output;
@@ -76,6 +87,7 @@ namespace dftfe {
       extern unsigned int subspaceRotDofsBlockSize;
       extern bool enableSwitchToGS;
       extern unsigned int nbandGrps;
+      extern unsigned int nspinGrps;
       extern bool computeEnergyEverySCF;
       extern unsigned int scalapackParalProcs;
       extern unsigned int scalapackBlockSize;
@@ -85,6 +97,8 @@ namespace dftfe {
       extern bool triMatPGSOpt;
       extern bool reuseWfcGeoOpt;
       extern bool reuseDensityGeoOpt;
+      extern unsigned int groundStateExtrapolationOrder;
+      extern bool extrapolateWfcGeoOpt;
       extern double mpiAllReduceMessageBlockSizeMB;
       extern bool useHigherQuadNLP;
       extern bool useMixedPrecPGS_SR;
@@ -97,10 +111,21 @@ namespace dftfe {
       extern bool useELPA;
       extern bool constraintsParallelCheck;
       extern bool createConstraintsFromSerialDofhandler;
+      extern bool fullyDistributedMesh;
+      extern bool costWeightedPartitioning;
       extern bool bandParalOpt;
+      extern bool dynamicKPointScheduling;
+      extern double kPointLoadImbalanceTol;
       extern bool rrGEP;
       extern bool rrGEPFullMassMatrix;
       extern bool readWfcForPdosPspFile;
+      extern double occupancyCutoff;
+      extern std::string performanceTelemetryFile;
+      extern unsigned int benchmarkRepetitions;
+      extern std::string benchmarkResultsFile, benchmarkReferenceFile;
+      extern double benchmarkRegressionTolerance;
+      extern double memoryBudgetPerNode;
+      extern bool memoryDryRun;
 
       /**
        * Declare parameters.
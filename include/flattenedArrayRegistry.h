@@ -0,0 +1,106 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018  The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+
+#ifndef flattenedArrayRegistry_h
+#define flattenedArrayRegistry_h
+
+#include <headers.h>
+
+namespace dftfe{
+
+  namespace vectorTools
+  {
+
+    /**
+     *  @brief Registry of the partitioners and index maps of the custom partitioned flattened dealii vectors.
+     *  The flattened partitioner, the cell local index maps and the map from the unflattened to the
+     *  flattened local indices are created once for each pair of (single component partitioner, block size)
+     *  and reused afterwards. The entries of a single component partitioner which is no longer referenced
+     *  outside the registry (for example after the matrix free data is reinitialized on a new mesh) are
+     *  discarded. The local proc indices are stored as 32-bit offsets, which is sufficient as the
+     *  local indices of dealii's partitioner are unsigned int.
+     */
+    class flattenedArrayRegistry
+    {
+
+    public:
+
+      /// partitioner and index maps of a flattened array of a given block size
+      struct flattenedArrayData
+      {
+	/// partitioner of the flattened array
+	std::shared_ptr<const dealii::Utilities::MPI::Partitioner> partitioner;
+
+	/// flattened local proc index of the first component of each node of the locally owned cells
+	/// in the macrocell, subcell order, stored contiguously with dofs_per_cell entries per cell
+	std::vector<unsigned int> macroCellLocalProcIndexIdMap;
+
+	/// same as macroCellLocalProcIndexIdMap in the order of the locally owned active cells
+	std::vector<unsigned int> cellLocalProcIndexIdMap;
+
+	/// flattened local proc index of the first component of each unflattened local proc index
+	std::shared_ptr<const std::vector<unsigned int> > localIndexMapUnflattenedToFlattened;
+      };
+
+      /**
+       * @brief returns the partitioner and index maps of the flattened array associated with the
+       * first dofHandler of the matrix free data, creating them on the first request
+       *
+       * @param matrixFreeData matrix free data whose first dofHandler is used
+       * @param blockSize number of components associated with each node
+       */
+      std::shared_ptr<const flattenedArrayData>
+      getFlattenedArrayData(const dealii::MatrixFree<3,double> & matrixFreeData,
+			    const unsigned int blockSize);
+
+      /**
+       * @brief returns the partitioner of the flattened array associated with the given single
+       * component partitioner, creating it on the first request
+       *
+       * @param partitioner associated with single component vector
+       * @param blockSize number of components associated with each node
+       */
+      std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+      getFlattenedPartitioner(const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & partitioner,
+			      const unsigned int blockSize);
+
+      /**
+       * @brief discards all entries. Must be called when the mesh changes.
+       */
+      void clear();
+
+    private:
+
+      struct registryEntry
+      {
+	std::shared_ptr<const dealii::Utilities::MPI::Partitioner> unFlattenedPartitioner;
+	unsigned int blockSize;
+	bool isIndexMapsComputed;
+	std::shared_ptr<flattenedArrayData> data;
+      };
+
+      /// returns the entry of the given single component partitioner and block size, creating the
+      /// flattened partitioner if it does not exist
+      registryEntry & getEntry(const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & partitioner,
+			       const unsigned int blockSize);
+
+      std::vector<registryEntry> d_entries;
+    };
+
+  }
+
+}
+#endif
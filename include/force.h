@@ -391,6 +391,8 @@ namespace dftfe {
 
       void distributeForceContributionFnlGammaAtoms(const std::map<unsigned int, std::vector<double> > & forceContributionFnlGammaAtoms);
 
+      void computeGaussianGeneratorCellCandidates();
+
       void computeAtomsForcesGaussianGenerator(bool allowGaussianOverlapOnAtoms=false);
 
 #ifdef USE_COMPLEX
@@ -470,6 +472,33 @@ namespace dftfe {
 
       void computeElementalNonLocalPseudoOVDataForce();
 
+#ifdef USE_COMPLEX
+      /** @brief Applies the k point phase factors on the fly to the real space nonlocal pseudopotential
+       *  quadrature data of a given cell in the compact support of a nonlocal atom.
+       *
+       *  @param nonLocalAtomId nonlocal atom id in the current process (with non-zero compact support)
+       *  @param cellInSupportId index of the cell in the compact support of the nonlocal atom
+       *  @param kPointIndex k point index
+       *  @param computeDyadic whether to compute gradZetalmDeltaVlDyadicDistImageAtoms
+       *  @param zetalmDeltaVl output with index ((iPseudoWave*num_quad_points+q)*2+realImag)
+       *  @param gradZetalmDeltaVl output with index (((iPseudoWave*num_quad_points+q)*3+idim)*2+realImag)
+       *  @param gradZetalmDeltaVl_minusZetalmDeltaVl output with the same index as gradZetalmDeltaVl
+       *  @param gradZetalmDeltaVlDyadicDistImageAtoms output with index ((((iPseudoWave*num_quad_points+q)*3+idim)*3+jdim)*2+realImag)
+       */
+      void computeNonLocalPSPQuadDataKPoint(const unsigned int nonLocalAtomId,
+					    const unsigned int cellInSupportId,
+					    const unsigned int kPointIndex,
+					    const bool computeDyadic,
+					    std::vector<double> & zetalmDeltaVl,
+					    std::vector<double> & gradZetalmDeltaVl,
+					    std::vector<double> & gradZetalmDeltaVl_minusZetalmDeltaVl,
+					    std::vector<double> & gradZetalmDeltaVlDyadicDistImageAtoms) const;
+#endif
+
+      /// Reports the memory of the nonlocal pseudopotential quadrature data and the memory saved
+      /// compared to storing per k point copies of the quadrature data
+      void reportNonLocalPSPQuadDataMemory(const double perKPointStorageBytes);
+
       void computeNonLocalProjectorKetTimesPsiTimesV(const std::vector<vectorType> &src,
 						     std::vector<std::vector<double> > & projectorKetTimesPsiTimesVReal,
 						     std::vector<std::vector<std::complex<double> > > & projectorKetTimesPsiTimesVComplex,
@@ -502,64 +531,70 @@ namespace dftfe {
 #endif
 
 
+      /// Number of pseudo wave functions of each nonlocal atom in the current process with non-zero compact support
+      std::vector<unsigned int> d_nonLocalPSP_numberPseudoWaveFunctions;
+
+      /// Map from the cell id to the index of the cell in the compact support (cell-in-support id)
+      /// for each nonlocal atom in the current process with non-zero compact support
+      std::vector<std::map<dealii::CellId,unsigned int> > d_nonLocalPSP_cellIdToCellInSupportIdMap;
+
 #ifdef USE_COMPLEX
-      /* Storage for precomputed nonlocal pseudopotential quadrature data. This is to speedup the
-       * configurational force computation. Data format: vector(numNonLocalAtomsCurrentProcess with
-       * non-zero compact support, vector(number pseudo wave functions,map<cellid,num_quad_points*2>)).
-       * Refer to (https://link.aps.org/doi/10.1103/PhysRevB.97.165132) for details of the expression of the configurational force terms
-       * for the norm-conserving Troullier-Martins pseudopotential in the Kleinman-Bylander form.
-       * The same expressions also extend to the Optimized Norm-Conserving Vanderbilt (ONCV) pseudopotentials.
+      /* For each nonlocal atom in the current process with non-zero compact support, the image atoms whose
+       * projector tails intersect a given cell in the compact support are stored in compressed row format.
+       * The (cell-in-support,image) pairs of the cell with cell-in-support id c are given by the range
+       * [d_nonLocalPSP_cellImageStartIds[atom][c],d_nonLocalPSP_cellImageStartIds[atom][c+1]).
        */
-      std::vector<std::vector<std::map<dealii::CellId, std::vector<double > > > > d_nonLocalPSP_ZetalmDeltaVl;
+      std::vector<std::vector<unsigned int> > d_nonLocalPSP_cellImageStartIds;
 
-      /* Storage for precomputed nonlocal pseudopotential quadrature data. This is to speedup the
-       * configurational force computation. Data format: vector(numNonLocalAtomsCurrentProcess with
-       * non-zero compact support, vector(number pseudo wave functions,map<cellid,num_quad_points*num_k_points*3*2>)).
-       * Refer to (https://link.aps.org/doi/10.1103/PhysRevB.97.165132) for details of the expression of the configurational force terms
-       * for the norm-conserving Troullier-Martins pseudopotential in the Kleinman-Bylander form.
-       * The same expressions also extend to the Optimized Norm-Conserving Vanderbilt (ONCV) pseudopotentials.
-       */
-      std::vector<std::vector<std::map<dealii::CellId, std::vector<double > > > > d_nonLocalPSP_gradZetalmDeltaVl_KPoint;
+      /// Cartesian coordinates of the image atom of each (cell-in-support,image) pair. Data format:
+      /// vector(numNonLocalAtomsCurrentProcess with non-zero compact support, vector(num pairs*3))
+      std::vector<std::vector<double> > d_nonLocalPSP_cellImageChargePoints;
 
-      /* Storage for precomputed nonlocal pseudopotential quadrature data. This is to speedup the
-       * configurational force computation. Data format: vector(numNonLocalAtomsCurrentProcess with
-       * non-zero compact support, vector(number pseudo wave functions,map<cellid,num_quad_points*num_k_points*3*2>)).
-       * Refer to (https://link.aps.org/doi/10.1103/PhysRevB.97.165132) for details of the expression of the configurational force terms
-       * for the norm-conserving Troullier-Martins pseudopotential in the Kleinman-Bylander form.
-       * The same expressions also extend to the Optimized Norm-Conserving Vanderbilt (ONCV) pseudopotentials.
-       */
-      std::vector<std::vector<std::map<dealii::CellId, std::vector<double > > > > d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint;
+      /// Cartesian coordinates of each nonlocal atom in the current process with non-zero compact support.
+      /// Data format: vector(numNonLocalAtomsCurrentProcess with non-zero compact support*3)
+      std::vector<double> d_nonLocalPSP_nuclearCoordinates;
 
-      /* Storage for precomputed nonlocal pseudopotential quadrature data. This is to speedup the
-       * configurational stress computation. Data format: vector(numNonLocalAtomsCurrentProcess with
-       * non-zero compact support, vector(number pseudo wave functions,map<cellid,num_quad_points*num_k_points*3*3*2>)).
+      /// Cartesian coordinates of the quadrature points of each cell in the compact support. Data format:
+      /// vector(numNonLocalAtomsCurrentProcess with non-zero compact support, vector(num cells in support*num_quad_points*3))
+      std::vector<std::vector<double> > d_nonLocalPSP_cellQuadPoints;
+
+      /* Storage for precomputed nonlocal pseudopotential quadrature data in real space without the k point phase factors,
+       * which are applied on the fly by computeNonLocalPSPQuadDataKPoint. This is to speedup the
+       * configurational force and stress computation. Data format: vector(numNonLocalAtomsCurrentProcess with
+       * non-zero compact support, vector(num (cell-in-support,image) pairs*number pseudo wave functions*num_quad_points))
+       * with the index ((pairId*numberPseudoWaveFunctions+iPseudoWave)*num_quad_points+q).
        * Refer to (https://link.aps.org/doi/10.1103/PhysRevB.97.165132) for details of the expression of the configurational force terms
        * for the norm-conserving Troullier-Martins pseudopotential in the Kleinman-Bylander form.
        * The same expressions also extend to the Optimized Norm-Conserving Vanderbilt (ONCV) pseudopotentials.
        */
-      std::vector<std::vector<std::map<dealii::CellId, std::vector<double > > > > d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint;
+      std::vector<std::vector<double> > d_nonLocalPSP_ZetalmDeltaVl;
 
+      /* Gradient of d_nonLocalPSP_ZetalmDeltaVl with the index
+       * (((pairId*numberPseudoWaveFunctions+iPseudoWave)*num_quad_points+q)*3+idim).
+       */
+      std::vector<std::vector<double> > d_nonLocalPSP_gradZetalmDeltaVl;
 #else
 
       /* Storage for precomputed nonlocal pseudopotential quadrature data. This is to speedup the
-       * configurational stress computation. Data format: vector(numNonLocalAtomsCurrentProcess with
-       * non-zero compact support, vector(number pseudo wave functions,map<cellid,num_quad_points>)).
+       * configurational force computation. Data format: vector(numNonLocalAtomsCurrentProcess with
+       * non-zero compact support, vector(num cells in support*number pseudo wave functions*num_quad_points))
+       * with the index ((cellInSupportId*numberPseudoWaveFunctions+iPseudoWave)*num_quad_points+q).
        * Refer to (https://link.aps.org/doi/10.1103/PhysRevB.97.165132) for details of the expression of the configurational force terms
        * for the norm-conserving Troullier-Martins pseudopotential in the Kleinman-Bylander form.
        * The same expressions also extend to the Optimized Norm-Conserving Vanderbilt (ONCV) pseudopotentials.
        */
-      std::vector<std::vector<std::map<dealii::CellId, std::vector<double > > > > d_nonLocalPSP_ZetalmDeltaVl;
+      std::vector<std::vector<double> > d_nonLocalPSP_ZetalmDeltaVl;
 
-      /* Storage for precomputed nonlocal pseudopotential quadrature data. This is to speedup the
-       * configurational stress computation. Data format: vector(numNonLocalAtomsCurrentProcess with
-       * non-zero compact support, vector(number pseudo wave functions,map<cellid,num_quad_points*3>)).
-       * Refer to (https://link.aps.org/doi/10.1103/PhysRevB.97.165132) for details of the expression of the configurational force terms
-       * for the norm-conserving Troullier-Martins pseudopotential in the Kleinman-Bylander form.
-       * The same expressions also extend to the Optimized Norm-Conserving Vanderbilt (ONCV) pseudopotentials.
+      /* Gradient of d_nonLocalPSP_ZetalmDeltaVl with the index
+       * (((cellInSupportId*numberPseudoWaveFunctions+iPseudoWave)*num_quad_points+q)*3+idim).
        */
-      std::vector<std::vector<std::map<dealii::CellId, std::vector<double > > > > d_nonLocalPSP_gradZetalmDeltaVl;
+      std::vector<std::vector<double> > d_nonLocalPSP_gradZetalmDeltaVl;
 #endif
 
+      /// Flag set once the nonlocal pseudopotential quadrature data above is built. The data is
+      /// built lazily on the first force or stress computation after initPseudoData.
+      bool d_isNonLocalPSPQuadDataComputed=false;
+
       /// Gaussian generator constant. Gaussian generator: Gamma(r)= exp(-d_gaussianConstant*r^2)
       /// FIXME: Until the hanging nodes surface integral issue is fixed use a value >=4.0
       double d_gaussianConstant;
@@ -567,6 +602,15 @@ namespace dftfe {
       /// Storage for configurational force on all global atoms.
       std::vector<double> d_globalAtomsGaussianForces;
 
+      /// Candidate atoms (including image atoms) of each active cell (indexed by active_cell_index) of
+      /// d_dofHandlerForce and d_dofHandlerForceElectro whose Gaussian generator support, truncated where the
+      /// Gaussian weight falls below a tolerance, intersects the cell
+      std::vector<std::vector<unsigned int> > d_gaussianGeneratorCellCandidateAtoms;
+      std::vector<std::vector<unsigned int> > d_gaussianGeneratorCellCandidateAtomsElectro;
+
+      /// Atom positions, Gaussian constant and exponent for which the above candidates were computed
+      std::vector<double> d_gaussianGeneratorCandidatesGeometry;
+
       /// Storage for configurational stress tensor
       Tensor<2,C_DIM,double> d_stress;
 
@@ -576,6 +620,12 @@ namespace dftfe {
        * when parallization over k points is on.
        */
       Tensor<2,C_DIM,double> d_stressKPoints;
+
+      /* True if the wavefunction dependent part of d_stressKPoints has already been accumulated
+       * in the same pass over the wavefunction blocks as the configurational force. This is the case
+       * when both ion force and cell stress are requested. Reset after the stress computation.
+       */
+      bool d_isStressKPointsComputedWithForce=false;
 #endif
       /* Dont use true except for debugging forces only without mesh movement, as gaussian ovelap
        * on atoms for move mesh is by default set to false
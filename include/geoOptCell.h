@@ -86,6 +86,13 @@ namespace dftfe {
       void update(const std::vector<double> & solution,
 		  const bool computeForces=true);
 
+    /**
+     * @brief Apply the strain increment to the domain and the fem mesh without solving the ground-state.
+     *
+     * @param solution delta(epsilon).
+     */
+      void updateStrain(const std::vector<double> & solution);
+
      /**
       * @brief create checkpoint file for current domain bounding vectors and atomic coordinates.
       *
@@ -99,7 +106,11 @@ namespace dftfe {
       void precondition(std::vector<double>  & s,
 			const std::vector<double> & gradient) const;
 
-      /// Not implemented
+      /**
+       * @brief Obtain the current strain components relative to the unstrained domain.
+       *
+       * @param solution Space for the strain components which are relaxed.
+       */
       void solution(std::vector<double> & solution);
 
       /// Not implemented
@@ -77,6 +77,18 @@ namespace dftfe {
       void update(const std::vector<double> & solution,
 		  const bool computeForces=true);
 
+    /**
+     * @brief Move the atoms and the fem mesh without solving the ground-state.
+     *
+     * @param solution displacement of the atoms with respect to their current position.
+     */
+      void updateAtomPositions(const std::vector<double> & solution);
+
+    /**
+     * @brief Obtain the relaxation flags of the three components of each global atom.
+     */
+      const std::vector<unsigned int> & getRelaxationFlags() const;
+
     /**
      * @brief create checkpoint file for current domain bounding vectors and atomic coordinates.
      *
@@ -0,0 +1,146 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018  The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef geoOptIonCell_H_
+#define geoOptIonCell_H_
+#include "nonlinearSolverProblem.h"
+#include "constants.h"
+
+namespace dftfe {
+
+    using namespace dealii;
+    template <unsigned int FEOrder> class dftClass;
+
+    /**
+     * @brief problem class for simultaneous atomic force and cell stress relaxation.
+     *
+     * The unknowns are the atomic displacements to be relaxed followed by the scaled strain
+     * components to be relaxed. The strain components are scaled by a length such that
+     * the FORCE TOL on the scaled strain gradient corresponds to the STRESS TOL on the stress.
+     * Both set of unknowns are updated at once, so that each nonlinear iteration requires
+     * a single ground-state solve. The relaxation flags are taken from geoOptIon and geoOptCell.
+     */
+    template <unsigned int FEOrder>
+    class geoOptIonCell : public nonlinearSolverProblem
+    {
+    public:
+    /** @brief Constructor.
+     *
+     *  @param _dftPtr pointer to dftClass
+     *  @param mpi_comm_replica mpi_communicator of the current pool
+     */
+      geoOptIonCell(dftClass<FEOrder>* _dftPtr,const  MPI_Comm &mpi_comm_replica);
+
+    /**
+     * @brief initializes the relaxation flags of atoms and cell, and the strain scaling.
+     *
+     */
+      void init();
+
+    /**
+     * @brief calls the preconditioned LBFGS solver for the simultaneous relaxation.
+     *
+     */
+      void run();
+
+    /**
+     * @brief Obtain number of unknowns (atomic force components plus strain components to be relaxed).
+     *
+     * @return int Number of unknowns.
+     */
+     unsigned int getNumberUnknowns() const;
+
+    /**
+     * @brief Compute function gradient (atomic forces and scaled stress).
+     *
+     * @param gradient STL vector for gradient values.
+     */
+      void gradient(std::vector<double> & gradient);
+
+    /**
+     * @brief Compute function value (ground-state energy relative to the starting configuration).
+     *
+     * @param functionValue STL vector for function value.
+     */
+      void value(std::vector<double> & functionValue);
+
+    /**
+     * @brief Apply the preconditioner, which scales the strain unknowns relative to the atomic
+     * displacement unknowns by the ratio of the estimated stiffnesses.
+     *
+     * @param s STL vector for s=-M^{-1} gradient.
+     * @param gradient STL vector for gradient values.
+     */
+      void precondition(std::vector<double>  & s,
+			const std::vector<double> & gradient) const;
+
+    /**
+     * @brief Update atomic positions and strain, and solve the ground-state.
+     *
+     * @param solution increment of the atomic displacements and the scaled strain.
+     */
+      void update(const std::vector<double> & solution,
+		  const bool computeForces=true);
+
+     /**
+      * @brief create checkpoint file for current domain bounding vectors and atomic coordinates.
+      *
+      */
+      void save();
+
+     /**
+      * @brief obtain the atomic displacements from the initial positions followed by the scaled strain.
+      *
+      */
+      void solution(std::vector<double> & solution);
+
+     /**
+      * @brief all unknowns are counted, as they are replicated on all processors.
+      *
+      */
+      std::vector<unsigned int> getUnknownCountFlag() const;
+
+    private:
+
+      /// number of atomic displacement unknowns
+      unsigned int d_numberIonUnknowns;
+
+      /// number of strain unknowns
+      unsigned int d_numberCellUnknowns;
+
+      /// length scale (in Bohr) which converts strain to the scaled strain unknowns
+      double d_strainScaling;
+
+      /// ratio of the estimated atomic and strain stiffnesses used in the preconditioner
+      double d_cellPreconditionerFactor;
+
+      /// total number of calls to update()
+      unsigned int d_totalUpdateCalls;
+
+      /// pointer to dft class
+      dftClass<FEOrder>* dftPtr;
+
+      /// parallel communication objects
+      const MPI_Comm mpi_communicator;
+      const unsigned int n_mpi_processes;
+      const unsigned int this_mpi_process;
+
+      /// conditional stream object
+      dealii::ConditionalOStream   pcout;
+    };
+
+}
+
+#endif
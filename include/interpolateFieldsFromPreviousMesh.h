@@ -38,6 +38,10 @@ namespace dftfe
  *   Further the two meshes can be arbitraririly refined. The only constraint is that they
  *   must discretize the same real-space domain.
  *
+ *   The point location is fully distributed: each processor only builds bounding boxes
+ *   of its locally owned cells of the previous mesh, and the support points of the current mesh
+ *   are routed to the candidate owning processors with a single all-to-all exchange.
+ *
  *  @author Sambit Das
  */
     class interpolateFieldsFromPreviousMesh
@@ -54,12 +58,13 @@ namespace dftfe
      * @brief Projects a vector of parallel distributed vectors
      * from previous to current mesh.
      *
-     * triangulationSerPrev and triangulationParPrev are serial and parallel versions of
-     * the previous mesh triangulation. Currently we need triangulationSerPrev for the algorithm to work,
-     * but the algorithm could be potentially improved to not need triangulationSerPrev. When
-     * that happens, we can directly pass previous and current dofHandlers as input arguments.
+     * Each processor builds a bounding box tree over its locally owned cells of triangulationParPrev,
+     * and a coarse set of bounding boxes (chunks of consecutive locally owned cells) is gathered on all
+     * processors. The support points of the locally owned dofs of the current mesh are sent to all
+     * processors whose boxes contain them, located and evaluated there, and the values are
+     * returned together with the distance to the reference cell to resolve points shared by
+     * several processors.
      *
-     * @param triangulationSerPrev  serial triangulation of previous mesh
      * @param triangulationParPrev  parallel distributed triangulation of previous mesh
      * @param triangulationParCurrent parallel distributed triangulation of current mesh
      * @param FEPrev FiniteElement object of the previous mesh
@@ -71,8 +76,7 @@ namespace dftfe
      * is NULL in which case the distribute operation doesn't happen inside interpolate. We have this
      * function so that outside interpolate function we can use the inhouse distribute function.
      */
-      void interpolate(const dealii::parallel::distributed::Triangulation<3> & triangulationSerPrev,
-		   const dealii::parallel::distributed::Triangulation<3> & triangulationParPrev,
+      void interpolate(const dealii::parallel::distributed::Triangulation<3> & triangulationParPrev,
 		   const dealii::parallel::distributed::Triangulation<3> & triangulationParCurrent,
 		   const dealii::FESystem<3> & FEPrev,
 		   const dealii::FESystem<3> & FECurrent,
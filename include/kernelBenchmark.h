@@ -0,0 +1,124 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018  The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef kernelBenchmark_H_
+#define kernelBenchmark_H_
+#include "headers.h"
+#include "constants.h"
+#include <functional>
+
+namespace dftfe {
+
+    using namespace dealii;
+    template <unsigned int FEOrder> class dftClass;
+    template <unsigned int FEOrder> class kohnShamDFTOperatorClass;
+
+    /**
+     * @brief Times the computational kernels of the ground-state solve in isolation: the local and
+     * nonlocal parts of the Hamiltonian times X (with and without batched GEMMs), the Chebyshev filter,
+     * the overlap matrix, the subspace rotation, the pseudo Gram-Schmidt orthogonalization, the
+     * electron-density computation from the wavefunctions, the effective potential and the total electrostatic
+     * potential Poisson solve.
+     *
+     * The mesh, the pseudopotential data and the starting guess wavefunctions and electron-density are setup by
+     * dftClass::set and dftClass::init from the usual input parameters, so the problem size is controlled by the
+     * POLYNOMIAL ORDER, the mesh parameters, the NUMBER OF KOHN-SHAM WAVEFUNCTIONS and the k-points (complex build).
+     * No SCF iteration is performed. Each kernel is called once as a warm up followed by REPETITIONS timed calls. The wall
+     * times (maximum across processors) and the GFLOP/s and GB/s estimated from the problem size are written as one JSON
+     * record per kernel to the RESULTS FILE, and optionally compared to the RESULTS FILE of a previous run.
+     */
+    template <unsigned int FEOrder>
+    class kernelBenchmark
+    {
+    public:
+    /** @brief Constructor.
+     *
+     *  @param _dftPtr pointer to dftClass
+     *  @param mpi_comm_replica mpi_communicator of the current pool
+     */
+      kernelBenchmark(dftClass<FEOrder>* _dftPtr,const  MPI_Comm &mpi_comm_replica);
+
+    /**
+     * @brief runs all the kernel benchmarks. Must be called after dftClass::init.
+     *
+     * @return number of kernels slower than in the REFERENCE FILE by more than REGRESSION TOLERANCE
+     */
+      unsigned int run();
+
+    private:
+
+      /// timing result of a single kernel
+      struct kernelResult
+      {
+	std::string name;
+	unsigned int numberVectors;
+	double minTime;
+	double avgTime;
+	double maxTime;
+	double flops;
+	double bytes;
+      };
+
+    /**
+     * @brief times a kernel. reset is called before each call of the kernel and is not timed.
+     *
+     * @param name name of the kernel
+     * @param numberVectors number of wavefunction vectors the kernel acts on
+     * @param flops estimated floating point operations of a single call (summed over all processors)
+     * @param bytes estimated bytes moved from/to the memory by a single call (summed over all processors)
+     */
+      void timeKernel(const std::string & name,
+		      const unsigned int numberVectors,
+		      const double flops,
+		      const double bytes,
+		      const std::function<void()> & kernel,
+		      const std::function<void()> & reset);
+
+    /**
+     * @brief benchmarks the Hamiltonian times X variants and the Chebyshev filter on a block of vectors
+     */
+      void benchmarkHX(kohnShamDFTOperatorClass<FEOrder> & kohnShamDFTEigenOperator);
+
+    /**
+     * @brief benchmarks the overlap matrix, subspace rotation and pseudo Gram-Schmidt orthogonalization
+     * on all the wavefunctions
+     */
+      void benchmarkSubspace(kohnShamDFTOperatorClass<FEOrder> & kohnShamDFTEigenOperator);
+
+    /**
+     * @brief writes the results to the RESULTS FILE and compares with the REFERENCE FILE
+     *
+     * @return number of kernels slower than in the REFERENCE FILE by more than REGRESSION TOLERANCE
+     */
+      unsigned int writeResults() const;
+
+      /// timing results of all the kernels in the order they were run
+      std::vector<kernelResult> d_results;
+
+      /// pointer to dft class
+      dftClass<FEOrder>* dftPtr;
+
+      /// parallel communication objects
+      const MPI_Comm mpi_communicator;
+      const unsigned int n_mpi_processes;
+      const unsigned int this_mpi_process;
+
+      /// conditional stream object
+      dealii::ConditionalOStream   pcout;
+    };
+
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include <headers.h>
 #include <constants.h>
 #include <constraintMatrixInfo.h>
+#include <flattenedArrayRegistry.h>
 #include <operator.h>
 
 namespace dftfe{
@@ -46,6 +47,9 @@ namespace dftfe{
       template <unsigned int T>
 	friend class symmetryClass;
 
+      template <unsigned int T>
+	friend class kernelBenchmark;
+
     public:
       kohnShamDFTOperatorClass(dftClass<FEOrder>* _dftPtr, const MPI_Comm &mpi_comm_replica);
 
@@ -319,10 +323,14 @@ namespace dftfe{
        * contiguously.
        * @param numberWaveFunctions Number of wavefunctions at a given node.
        * @param dst Vector containing matrix times given multi-vectors product
+       * @param macroCellStartId first macro cell of the range of macro cells
+       * @param macroCellEndId one past the last macro cell of the range of macro cells
        */
       void computeLocalHamiltonianTimesX(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
 					 const unsigned int numberWaveFunctions,
-					 dealii::parallel::distributed::Vector<dataTypes::number> & dst) const;
+					 dealii::parallel::distributed::Vector<dataTypes::number> & dst,
+					 const unsigned int macroCellStartId,
+					 const unsigned int macroCellEndId) const;
 
 
       void computeMassMatrixTimesX(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
@@ -339,45 +347,80 @@ namespace dftfe{
        * contiguously.
        * @param numberWaveFunctions Number of wavefunctions at a given node.
        * @param dst Vector containing matrix times given multi-vectors product
+       * @param macroCellStartId first macro cell of the range of macro cells
+       * @param macroCellEndId one past the last macro cell of the range of macro cells
        */
       void computeLocalHamiltonianTimesXBatchGEMM
 	           (const dealii::parallel::distributed::Vector<dataTypes::number> & src,
 		    const unsigned int numberWaveFunctions,
-		    dealii::parallel::distributed::Vector<dataTypes::number> & dst) const;
+		    dealii::parallel::distributed::Vector<dataTypes::number> & dst,
+		    const unsigned int macroCellStartId,
+		    const unsigned int macroCellEndId) const;
 
 
 #endif
       /**
-       * @brief implementation of non-local Hamiltonian matrix-vector product
-       * using non-local discretized projectors at cell-level.
+       * @brief first stage of the non-local Hamiltonian matrix-vector product: computes the
+       * non-local discretized projector kets times X (C^{T}*X) at cell-level and starts the
+       * non-blocking reduction of the ghost projector contributions.
        * works for both complex and real data type
        * @param src Vector containing current values of source array with multi-vector array stored
        * in a flattened format with all the wavefunction value corresponding to a given node is stored
        * contiguously.
        * @param numberWaveFunctions Number of wavefunctions at a given node.
+       */
+      void computeNonLocalProjectorKetTimesX(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
+					     const unsigned int numberWaveFunctions) const;
+
+      /**
+       * @brief second stage of the non-local Hamiltonian matrix-vector product: finishes the reduction
+       * started in computeNonLocalProjectorKetTimesX, scales the locally owned projector kets times X
+       * with the non-local pseudopotential constants (V*C^{T}*X) and starts the non-blocking ghost update.
+       * @param numberWaveFunctions Number of wavefunctions at a given node.
+       */
+      void scaleNonLocalProjectorKetTimesX(const unsigned int numberWaveFunctions) const;
+
+      /**
+       * @brief last stage of the non-local Hamiltonian matrix-vector product: finishes the ghost update
+       * started in scaleNonLocalProjectorKetTimesX and adds C*V*C^{T}*X to dst at cell-level.
+       * works for both complex and real data type
+       * @param numberWaveFunctions Number of wavefunctions at a given node.
        * @param dst Vector containing matrix times given multi-vectors product
        */
-      void computeNonLocalHamiltonianTimesX(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
-					    const unsigned int numberWaveFunctions,
+      void computeNonLocalHamiltonianTimesX(const unsigned int numberWaveFunctions,
 					    dealii::parallel::distributed::Vector<dataTypes::number> & dst) const;
 
 #ifdef WITH_MKL
       /**
-       * @brief implementation of non-local Hamiltonian matrix-vector product using
-       * non-local discretized projectors at cell-level. blas gemm_batch routines are used.
-       * works for both complex and real data type
+       * @brief same as computeNonLocalProjectorKetTimesX with the cell-level products
+       * batched using blas gemm_batch routines.
+       */
+      void computeNonLocalProjectorKetTimesXBatchGEMM(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
+						      const unsigned int numberWaveFunctions) const;
+
+      /**
+       * @brief same as computeNonLocalHamiltonianTimesX(numberWaveFunctions,dst) with the cell-level
+       * products batched using blas gemm_batch routines.
+       */
+      void computeNonLocalHamiltonianTimesXBatchGEMM(const unsigned int numberWaveFunctions,
+						     dealii::parallel::distributed::Vector<dataTypes::number> & dst) const;
+
+
+#endif
+
+      /**
+       * @brief local and non-local Hamiltonian matrix-vector product. The communication of the
+       * non-local projector kets times X between the processors sharing the compact support of the
+       * non-local atoms is overlapped with the cell-level local Hamiltonian matrix-vector products.
        * @param src Vector containing current values of source array with multi-vector array stored
        * in a flattened format with all the wavefunction value corresponding to a given node is stored
        * contiguously.
        * @param numberWaveFunctions Number of wavefunctions at a given node.
        * @param dst Vector containing matrix times given multi-vectors product
        */
-      void computeNonLocalHamiltonianTimesXBatchGEMM(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
-						     const unsigned int numberWaveFunctions,
-						     dealii::parallel::distributed::Vector<dataTypes::number> & dst) const;
-
-
-#endif
+      void computeHamiltonianTimesX(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
+				    const unsigned int numberWaveFunctions,
+				    dealii::parallel::distributed::Vector<dataTypes::number> & dst) const;
 
       ///pointer to dft class
       dftClass<FEOrder>* dftPtr;
@@ -421,8 +464,10 @@ namespace dftfe{
       //d_kpoint index for which Hamiltonian is computed
       unsigned int d_kPointIndex;
 
-      //storage for precomputing index maps
-      std::vector<std::vector<dealii::types::global_dof_index> > d_flattenedArrayMacroCellLocalProcIndexIdMap, d_flattenedArrayCellLocalProcIndexIdMap;
+      //precomputed index maps of the current block size owned by the flattened array registry of dftClass
+      std::shared_ptr<const vectorTools::flattenedArrayRegistry::flattenedArrayData> d_flattenedArrayData;
+      const unsigned int * d_flattenedArrayMacroCellLocalProcIndexIdMap;
+      const unsigned int * d_flattenedArrayCellLocalProcIndexIdMap;
     };
 }
 #endif
@@ -0,0 +1,169 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+
+#ifndef LBFGSNonLinearSolver_h
+#define LBFGSNonLinearSolver_h
+
+
+#include "nonLinearSolver.h"
+#include <deque>
+
+namespace dftfe {
+  /**
+   * @brief Concrete class implementing a preconditioned limited memory BFGS non-linear
+   * algebraic solver.
+   *
+   * Each iteration requires a single evaluation of the function value and gradient, as the
+   * quasi-Newton step is taken without a line search. The step is only limited in size and
+   * halved (with a reset of the history) if the function value increases.
+   * The inverse Hessian approximation is seeded by the preconditioner of the nonlinear problem,
+   * which allows to use unknowns of different physical nature (for example atomic positions
+   * and cell strains) in the same solve.
+   */
+  class lbfgsNonLinearSolver : public nonLinearSolver {
+
+  public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param usePreconditioner boolean specifying whether the precondition function of the
+     * nonlinear problem is used to seed the inverse Hessian approximation.
+     * @param maxUpdate maximum allowed increment (measured as L_{inf}(delta x)) in the solution vector.
+     * @param maxNumberIterations Maximum number of iterations.
+     * @param maxNumPastSteps Maximum number of past steps stored in the history.
+     * @param debugLevel Debug output level:
+     *                   0 - no debug output
+     *                   1 - limited debug output
+     *                   2 - all debug output.
+     * @param tolerance Tolerance on the maximum absolute value of the gradient.
+     */
+    lbfgsNonLinearSolver(const bool usePreconditioner,
+			 const double maxUpdate,
+			 const unsigned int maxNumberIterations,
+			 const unsigned int maxNumPastSteps,
+			 const unsigned int debugLevel,
+			 const double tolerance,
+			 const MPI_Comm &mpi_comm_replica);
+
+    /**
+     * @brief Destructor.
+     */
+    ~lbfgsNonLinearSolver();
+
+    /**
+     * @brief Solve non-linear problem using the limited memory BFGS method.
+     *
+     * @param problem[in] nonlinearSolverProblem object.
+     * @param checkpointFileName[in] if string is non-empty, creates checkpoint file
+     * named checkpointFileName for every nonlinear iteration. If restart is set to true,
+     * checkpointFileName must match the name of the checkpoint file. Empty string
+     * will throw an error.
+     * @param restart[in] boolean specifying whether this is a restart solve using the checkpoint file
+     * specified by checkpointFileName.
+     * @return Return value indicating success or failure.
+     */
+     nonLinearSolver::ReturnValueType
+     solve(nonlinearSolverProblem & problem,
+	   const std::string checkpointFileName="",
+	   const bool restart=false);
+
+  private:
+
+    /**
+     * @brief Compute the quasi-Newton step using the two-loop recursion.
+     *
+     * @param problem nonlinearSolverProblem object used to apply the preconditioner.
+     */
+    void computeStep(const nonlinearSolverProblem & problem);
+
+    /**
+     * @brief Apply the (scaled) initial inverse Hessian approximation i.e. s=H_0 q.
+     */
+    void applyInitialInverseHessian(const nonlinearSolverProblem & problem,
+				    const std::vector<double> & q,
+				    std::vector<double> & s) const;
+
+    /**
+     * @brief Add the last step and gradient difference to the history if the curvature
+     * condition is satisfied.
+     */
+    void updateHistory(const std::vector<double> & deltaX,
+		       const std::vector<double> & deltaGradient);
+
+    /**
+     * @brief Scale down the step if its L_{inf} norm exceeds the maximum update.
+     */
+    void limitStep();
+
+    /**
+     * @brief Compute L_{inf} norm of the gradient.
+     */
+    double computeGradientMax() const;
+
+    /**
+     * @brief Create checkpoint file for current state of the lbfgs solver.
+     *
+     */
+     void save(const std::string & checkpointFileName);
+
+    /**
+     * @brief Load lbfgs solver state from checkpoint file.
+     *
+     */
+     void load(const std::string & checkpointFileName);
+
+    /// storage for the gradient of the nonlinear problem in the current step
+    std::vector<double> d_gradient;
+
+    /// storage for the gradient of the nonlinear problem after the trial step
+    std::vector<double> d_gradientNew;
+
+    /// storage for the current step
+    std::vector<double> d_step;
+
+    /// history of the steps and gradient differences, and 1/(y^T s)
+    std::deque<std::vector<double> > d_deltaXHistory;
+    std::deque<std::vector<double> > d_deltaGradientHistory;
+    std::deque<double> d_rhoHistory;
+
+    /// function value at the current solution
+    double d_value;
+
+    /// storage for number of unknowns to be solved for in the nonlinear problem
+    unsigned int d_numberUnknowns;
+
+    /// storage for current nonlinear iteration count
+    unsigned int d_iter;
+
+    /// use preconditioner of the nonlinear problem
+    const bool d_usePreconditioner;
+
+    /// maximum allowed L_{inf} increment in solution vector
+    const double d_maxUpdate;
+
+    /// maximum number of past steps in the history
+    const unsigned int d_maxNumPastSteps;
+
+    //parallel objects
+    MPI_Comm mpi_communicator;
+    const unsigned int n_mpi_processes;
+    const unsigned int this_mpi_process;
+    dealii::ConditionalOStream   pcout;
+  };
+
+}
+#endif // LBFGSNonLinearSolver_h
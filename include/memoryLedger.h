@@ -0,0 +1,163 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018  The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+#ifndef memoryLedger_H_
+#define memoryLedger_H_
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+
+namespace dftfe {
+
+  /**
+   *  @brief Global ledger of the major allocations of the current processor grouped into
+   *  categories. Long lived allocations (for example the wavefunctions) are registered by name
+   *  and their size is updated whenever they are reallocated, while temporary allocations
+   *  (for example the ScaLAPACK matrices of the Rayleigh-Ritz step) are registered for the lifetime
+   *  of an Allocation object. The current and the peak bytes of each category are tracked
+   *  on each processor, and printSummary reports their statistics across all processors.
+   */
+  namespace memoryLedger
+    {
+
+      /// categories of the major allocations
+      enum category
+	{
+	  wavefunctions,
+	  rotatedFractionalWavefunctions,
+	  cellHamiltonians,
+	  projectorMatrices,
+	  quadratureFields,
+	  mixingHistory,
+	  scalapackBuffers,
+	  forceTables,
+	  numberCategories
+	};
+
+      /** @brief Initialize the ledger. Must be called on all processors of mpiComm
+       *  before any allocation is registered.
+       *
+       *  @param  mpiComm mpi communicator across which the statistics are reduced
+       */
+      void initialize(const MPI_Comm & mpiComm);
+
+      /** @brief Sets the size of a named long lived allocation, replacing the
+       *  previously registered size of the same name. A size of zero releases the allocation.
+       *
+       *  @param  allocationCategory category of the allocation
+       *  @param  name name of the allocation, unique within the category
+       *  @param  bytes current size of the allocation in bytes on the current processor
+       */
+      void setBytes(const category allocationCategory,
+		    const std::string & name,
+		    const double bytes);
+
+      /** @brief Adds to the temporary allocations of a category. Negative bytes release
+       *  a previously added allocation.
+       */
+      void addBytes(const category allocationCategory,
+		    const double bytes);
+
+      /** @brief Returns the current bytes of a category on the current processor
+       */
+      double getCurrentBytes(const category allocationCategory);
+
+      /** @brief Returns the peak bytes of a category on the current processor
+       */
+      double getPeakBytes(const category allocationCategory);
+
+      /** @brief Returns the name of a category
+       */
+      std::string getCategoryName(const category allocationCategory);
+
+      /** @brief Returns the current resident set size of the current process in bytes
+       */
+      double getResidentMemory();
+
+      /** @brief Returns the peak resident set size of the current process in bytes
+       */
+      double getPeakResidentMemory();
+
+      /** @brief Prints the current and peak bytes of each category (maximum and average across
+       *  processors) and the resident memory. Collective over the communicator passed to initialize.
+       *
+       *  @param  message name of the stage of the run printed in the header
+       */
+      void printSummary(const std::string & message);
+
+      /**
+       * @brief RAII helper which adds bytes to a category in the constructor and
+       * releases them in the destructor
+       */
+      class Allocation
+      {
+      public:
+	Allocation(const category allocationCategory,
+		   const double bytes);
+
+	~Allocation();
+
+      private:
+
+	const category d_category;
+	const double d_bytes;
+      };
+
+      /// bytes of an STL vector
+      template<typename T>
+      double getBytes(const std::vector<T> & vec)
+      {
+	return vec.capacity()*sizeof(T);
+      }
+
+      /// bytes of a vector of STL vectors
+      template<typename T>
+      double getBytes(const std::vector<std::vector<T> > & vec)
+      {
+	double bytes=vec.capacity()*sizeof(std::vector<T>);
+	for (unsigned int i=0; i<vec.size(); ++i)
+	  bytes+=vec[i].capacity()*sizeof(T);
+	return bytes;
+      }
+
+      /// bytes of the values of a cell quadrature data map
+      template<typename K, typename T>
+      double getBytes(const std::map<K,std::vector<T> > & quadData)
+      {
+	double bytes=0.0;
+	for (typename std::map<K,std::vector<T> >::const_iterator it=quadData.begin(); it!=quadData.end(); ++it)
+	  bytes+=it->second.capacity()*sizeof(T);
+	return bytes;
+      }
+
+      /// bytes of the values of a history of cell quadrature data maps
+      template<typename K, typename T>
+      double getBytes(const std::deque<std::map<K,std::vector<T> > > & quadDataHistory)
+      {
+	double bytes=0.0;
+	for (unsigned int i=0; i<quadDataHistory.size(); ++i)
+	  bytes+=getBytes(quadDataHistory[i]);
+	return bytes;
+      }
+
+    }
+
+}
+#endif
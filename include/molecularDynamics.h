@@ -0,0 +1,148 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018  The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef molecularDynamics_H_
+#define molecularDynamics_H_
+#include "headers.h"
+#include "constants.h"
+#include <deque>
+
+namespace dftfe {
+
+    using namespace dealii;
+    template <unsigned int FEOrder> class dftClass;
+
+    /**
+     * @brief Born-Oppenheimer molecular dynamics using the velocity-Verlet integrator.
+     *
+     * Supports the NVE ensemble and the NVT ensemble with a Berendsen thermostat. Optionally uses
+     * the extended Lagrangian Born-Oppenheimer (XL BOMD) scheme of Niklasson et al. (J. Chem. Phys. 130, 214109 (2009)),
+     * where an auxiliary electron-density is propagated by a time-reversible Verlet integrator with
+     * dissipation and used as the starting density of the SCF iterations in every step, so that only a
+     * few SCF iterations are required per step. The atoms and the fem mesh are moved using
+     * dftClass::updateAtomPositionsAndMoveMesh. For CHK TYPE=1 a checkpoint of the atomic positions, the Gaussian mesh
+     * movement displacements and the velocities is written every step. On restart the ground-state is recomputed at the
+     * checkpointed positions and the XL BOMD auxiliary density history starts from that ground-state.
+     */
+    template <unsigned int FEOrder>
+    class molecularDynamics
+    {
+    public:
+    /** @brief Constructor.
+     *
+     *  @param _dftPtr pointer to dftClass
+     *  @param mpi_comm_replica mpi_communicator of the current pool
+     */
+      molecularDynamics(dftClass<FEOrder>* _dftPtr,const  MPI_Comm &mpi_comm_replica);
+
+    /**
+     * @brief initializes the atomic masses, the starting velocities and the XL BOMD coefficients.
+     *
+     */
+      void init();
+
+    /**
+     * @brief runs the molecular dynamics starting from the current ground-state.
+     *
+     */
+      void run();
+
+    private:
+
+    /// map from CellId to quadrature point values of a density field
+    typedef std::map<dealii::CellId, std::vector<double> > quadDensityField;
+
+    /**
+     * @brief computes accelerations from the current atomic forces, and returns maximum force magnitude
+     */
+      double computeAccelerations();
+
+    /**
+     * @brief computes kinetic energy of the atoms
+     */
+      double computeKineticEnergy() const;
+
+    /**
+     * @brief pointers to the rho in (or rho out) density fields present in the current calculation
+     * i.e. rho, grad rho (GGA), and the spin-polarized rho and grad rho.
+     */
+      std::vector<quadDensityField *> getDensityFields(const bool rhoIn) const;
+
+    /**
+     * @brief resets the auxiliary density history to the current rho in
+     */
+      void resetAuxiliaryDensityHistory();
+
+    /**
+     * @brief propagates the auxiliary density by one step and sets it as the rho in of the next
+     * ground-state solve.
+     */
+      void propagateAuxiliaryDensity();
+
+    /**
+     * @brief writes the checkpoint of the given completed step
+     */
+      void save(const unsigned int step) const;
+
+    /**
+     * @brief prints the current step information and appends the current step to the trajectory file
+     */
+      void writeStep(const unsigned int step,
+		     const bool createFile) const;
+
+      /// atomic masses (electron mass units)
+      std::vector<double> d_atomicMasses;
+
+      /// atomic velocities (atomic units) stored as flattened 3*numberGlobalAtoms vector
+      std::vector<double> d_velocities;
+
+      /// atomic accelerations (atomic units) stored as flattened 3*numberGlobalAtoms vector
+      std::vector<double> d_accelerations;
+
+      /// time step (atomic units)
+      double d_timeStep;
+
+      /// last completed step read from the checkpoint (zero if not restarting)
+      unsigned int d_startingStep;
+
+      /// total energy (Ha) of the starting configuration, used for the energy drift
+      double d_totalEnergyStart;
+
+      /// XL BOMD integrator coefficients
+      double d_kappaXLBOMD;
+      double d_alphaXLBOMD;
+      std::vector<double> d_dissipationCoeffsXLBOMD;
+
+      /// history of the auxiliary densities (front is the latest)
+      std::deque<std::vector<quadDensityField> > d_auxiliaryDensityHistory;
+
+      /// output densities of the last ground-state solve
+      std::vector<quadDensityField> d_rhoOutLastStep;
+
+      /// pointer to dft class
+      dftClass<FEOrder>* dftPtr;
+
+      /// parallel communication objects
+      const MPI_Comm mpi_communicator;
+      const unsigned int n_mpi_processes;
+      const unsigned int this_mpi_process;
+
+      /// conditional stream object
+      dealii::ConditionalOStream   pcout;
+    };
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018  The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+
+
+#ifndef performanceTelemetry_H_
+#define performanceTelemetry_H_
+
+#include <mpi.h>
+#include <string>
+
+namespace dealii
+{
+  class TimerOutput;
+}
+
+namespace dftfe {
+
+  /**
+   *  @brief Collects the performance data of a run as JSON records. The wall times and the number
+   *  of calls are harvested from the sections of the registered dealii::TimerOutput objects, so the
+   *  existing timer sections are the instrumented regions. Each region is named by the timer name
+   *  followed by the section name (for example "dftClass/compute rho" or
+   *  "dftClass/Chebyshev solve/Chebyshev filtering opt"). Counters of the bytes communicated and
+   *  allocated which are not timed are added by name. The statistics across all processors
+   *  (min/max/avg wall time, total bytes, peak resident memory) are written as one JSON record
+   *  per line to the file set by the PERFORMANCE TELEMETRY FILE input parameter. All functions
+   *  are no-ops if the file name is empty.
+   */
+  namespace performanceTelemetry
+    {
+
+      /** @brief Initialize the registry. Must be called on all processors of mpiComm
+       *  before any timer is registered.
+       *
+       *  @param  mpiComm mpi communicator across which the statistics are reduced
+       *  @param  fileName name of the JSON lines output file. The telemetry is disabled if empty.
+       */
+      void initialize(const MPI_Comm & mpiComm,
+		      const std::string & fileName);
+
+      /** @brief Returns true if the telemetry is enabled
+       */
+      bool isEnabled();
+
+      /** @brief Registers a TimerOutput whose sections are harvested in each record. Only the
+       *  time spent in the sections after the registration is reported.
+       *
+       *  @param  timerName name prefixed to the section names of the timer
+       *  @param  timer TimerOutput which must be deregistered before it is destroyed
+       */
+      void registerTimer(const std::string & timerName,
+			 const dealii::TimerOutput & timer);
+
+      /** @brief Harvests the sections of a registered TimerOutput one last time and removes it
+       *  from the registry
+       *
+       *  @param  timer registered TimerOutput
+       */
+      void deregisterTimer(const dealii::TimerOutput & timer);
+
+      /** @brief Adds to the bytes communicated by the current processor and counts one call
+       *
+       *  @param  counterName name of the region the bytes are reported in
+       *  @param  bytes number of bytes sent by the current processor
+       */
+      void addCommunicatedBytes(const std::string & counterName,
+				const double bytes);
+
+      /** @brief Adds to the bytes allocated by the current processor
+       *
+       *  @param  counterName name of the region the bytes are reported in
+       *  @param  bytes number of bytes allocated by the current processor
+       *  @param  savedBytes number of bytes saved by the current processor compared to
+       *  a reference data layout, for example by a compact storage format
+       */
+      void addAllocatedBytes(const std::string & counterName,
+			     const double bytes,
+			     const double savedBytes=0.0);
+
+      /** @brief Harvests the registered timers, reduces the statistics accumulated since the last
+       *  record across all processors and writes them as one JSON record. The statistics are then
+       *  added to the summary and reset. Collective over the communicator passed to initialize.
+       *
+       *  @param  recordType name of the record, for example "scf iteration"
+       *  @param  recordIndex index of the record, for example the scf iteration number
+       */
+      void writeRecord(const std::string & recordType,
+		       const unsigned int recordIndex);
+
+      /** @brief Writes the statistics accumulated over the whole run as one JSON record.
+       *  Collective over the communicator passed to initialize.
+       */
+      void writeSummary();
+
+    }
+
+}
+#endif
@@ -0,0 +1,125 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018  The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#ifndef perturbedGeometryForces_H_
+#define perturbedGeometryForces_H_
+#include "headers.h"
+#include "constants.h"
+
+namespace dftfe {
+
+    using namespace dealii;
+    template <unsigned int FEOrder> class dftClass;
+
+    /**
+     * @brief Non self-consistent force evaluation on a batch of perturbed geometries, for example the
+     * displaced geometries of a finite-difference phonon calculation.
+     *
+     * Each perturbed geometry is given by the atomic displacements from the ground-state geometry. For each
+     * perturbed geometry the atoms and the mesh are moved from the reference geometry and the reference mesh
+     * using dftClass::updateAtomPositionsAndMoveMesh, the converged
+     * ground-state subspace (and the electron-density computed from it) is reused as the starting guess, and a fixed
+     * number of Chebyshev filtering and Rayleigh-Ritz passes are performed in a single SCF iteration without density mixing,
+     * followed by the force evaluation. The initialization, pseudopotential setup and mesh generation are
+     * done only once for all the perturbed geometries. If the mesh movement requires remeshing, a full ground-state solve is
+     * performed for that perturbed geometry, and the reference mesh is regenerated at the reference geometry before the
+     * next perturbed geometry.
+     */
+    template <unsigned int FEOrder>
+    class perturbedGeometryForces
+    {
+    public:
+    /** @brief Constructor.
+     *
+     *  @param _dftPtr pointer to dftClass
+     *  @param mpi_comm_replica mpi_communicator of the current pool
+     */
+      perturbedGeometryForces(dftClass<FEOrder>* _dftPtr,const  MPI_Comm &mpi_comm_replica);
+
+    /**
+     * @brief reads the atomic displacements of the perturbed geometries.
+     *
+     */
+      void init();
+
+    /**
+     * @brief computes the forces of all the perturbed geometries starting from the current ground-state.
+     *
+     */
+      void run();
+
+    private:
+
+    /**
+     * @brief stores the current ground-state subspace and electron-density as the reference for the
+     * non self-consistent solves
+     */
+      void storeReferenceGroundState();
+
+    /**
+     * @brief restores the reference ground-state subspace and electron-density before moving to the next perturbed geometry
+     */
+      void restoreReferenceGroundState();
+
+    /**
+     * @brief stores the current atomic positions and net Gaussian mesh movement displacements as the reference geometry
+     */
+      void storeReferenceGeometry();
+
+    /**
+     * @brief restores the reference atomic positions and net Gaussian mesh movement displacements
+     */
+      void restoreReferenceGeometry();
+
+    /**
+     * @brief prints the forces of the current perturbed geometry and appends them to the output file
+     */
+      void writeForces(const unsigned int geometryIndex,
+		       const bool isNonSelfConsistent,
+		       const bool createFile) const;
+
+      /// atomic displacements (atomic units) of each perturbed geometry from the ground-state geometry
+      std::vector<std::vector<Tensor<1,3,double> > > d_perturbedGeometriesDisplacements;
+
+      /// reference ground-state wavefunctions, eigenvalues and Fermi energies
+      std::vector<std::vector<dataTypes::number> > d_eigenVectorsReference;
+      std::vector<std::vector<double> > d_eigenValuesReference;
+      double d_fermiEnergyReference;
+      double d_fermiEnergyUpReference;
+      double d_fermiEnergyDownReference;
+
+      /// reference nodal electron-density (only used for ANDERSON_WITH_KERKER mixing)
+      vectorType d_rhoOutNodalValuesReference;
+
+      /// reference atomic positions and net displacements of the Gaussian mesh movement from the reference mesh generation
+      std::vector<std::vector<double> > d_atomLocationsReference;
+      std::vector<std::vector<double> > d_atomLocationsFractionalReference;
+      std::vector<Tensor<1,3,double> > d_gaussianMovementAtomsNetDisplacementsReference;
+
+      /// pointer to dft class
+      dftClass<FEOrder>* dftPtr;
+
+      /// parallel communication objects
+      const MPI_Comm mpi_communicator;
+      const unsigned int n_mpi_processes;
+      const unsigned int this_mpi_process;
+
+      /// conditional stream object
+      dealii::ConditionalOStream   pcout;
+    };
+
+}
+
+#endif
@@ -50,7 +50,7 @@ namespace dftfe {
        */
       symmetryClass(dftClass<FEOrder>* _dftPtr,const  MPI_Comm &mpi_comm_replica,const MPI_Comm &_interpoolcomm);
       /**
-       * Main driver routine to generate and communicate mapping tables
+       * Main driver routine to generate the persistent symmetrization plan
        */
       void initSymmetry();
       /**
@@ -58,8 +58,8 @@ namespace dftfe {
        */
       void computeAndSymmetrize_rhoOut();
       /**
-       * computes density at all the transformed points received from other processors
-       * and scatters the density back to the corresponding processors
+       * computes density at all the transformed points located in the locally owned cells
+       * and sends the density back to the requesting processors
        */
       void computeLocalrhoOut();
       /**
@@ -100,36 +100,46 @@ namespace dftfe {
       std::vector<std::vector<int>> symmUnderGroup ;
       std::vector<int> numSymmUnderGroup ;
       /**
-       * Data members required for storing mapping tables locally
+       * Persistent symmetrization plan built once per geometry in initSymmetry.
+       *
+       * Requesting side: locally owned cells of dofHandler (same ordering as used for the requests), and
+       * for each (locally owned cell, symmetry, quadrature point) the index of the point in the received
+       * values buffer
        */
-      std::map<CellId,std::vector<std::tuple<int, std::vector<double>, int> >>  cellMapTable ;
-      std::vector<std::vector<std::vector<std::tuple<int, int, int> >>> mappedGroup ;
-      std::map<int,typename DoFHandler<3>::active_cell_iterator> dealIICellId ;
-      std::map<CellId, int> globalCellId ;
-      std::vector<int> ownerProcGlobal;
+      std::vector<typename DoFHandler<3>::active_cell_iterator> locallyOwnedCells;
+      std::vector<unsigned int> symmRecvIndex;
       /**
-       * Data members required for communicating mapping tables
+       * Evaluation side: symmetry transformed points located in the locally owned cells, grouped per cell
+       * in a compressed row format. The points are ordered by the requesting processor which is also
+       * the order in the send buffer
        */
-      std::vector<std::vector<std::vector<std::vector<int> >>> mappedGroupSend0;
-      std::vector<std::vector<std::vector<std::vector<int> >>> mappedGroupSend2;
-      std::vector<std::vector<std::vector<std::vector<std::vector<double>>> >> mappedGroupSend1;
-      std::vector<std::vector<std::vector<int> >> mappedGroupRecvd0;
-      std::vector<std::vector<std::vector<int> >> mappedGroupRecvd2;
-      std::vector<std::vector<std::vector<std::vector<double>>> > mappedGroupRecvd1;
-      std::vector<std::vector<std::vector<std::vector<int>> >> send_buf_size;
-      std::vector<std::vector<std::vector<std::vector<int>> >> recv_buf_size;
-      std::vector<std::vector<std::vector<std::vector<double>>> > rhoRecvd, gradRhoRecvd;
-      std::vector<std::vector<std::vector<std::vector<int>> >> groupOffsets;
+      std::vector<unsigned int> evalCellIds;
+      std::vector<unsigned int> evalCellPointsOffsets;
+      std::vector<unsigned int> evalCellPoints;
+      std::vector<dealii::types::global_dof_index> evalCellGlobalDofIndices;
+      std::vector<double> evalPointsUnitCoords;
+      std::vector<unsigned int> evalPointsSymmId;
+      unsigned int numEvalPoints;
       /**
-       * Data sizes and offsets required for MPI scattering and gathering of mapping tables and symmetrized density 
-       * They have to be data members since the same sizes and offsets are used in both communication mapping tables and symmetrized density 
+       * shape function values and unit cell shape function gradients of the evaluation points tabulated once in
+       * initSymmetry, stored in the order of evalCellPoints as (point, node) and (point, direction, node).
+       * The gradients of the bilinear mapping shape functions (point, vertex, direction) are used to compute
+       * the Jacobians of the current (possibly moved) cells
        */
-      unsigned int totPoints ;
-      std::vector<int> mpi_scatter_offset, send_scatter_size, recv_size, mpi_scatterGrad_offset, send_scatterGrad_size;
-      std::vector<int> mpi_offsets0, mpi_offsets1, mpiGrad_offsets1 ;
-      std::vector<int> recvdData0, recvdData2, recvdData3;
-      std::vector<std::vector<double>> recvdData1;
-      std::vector<int> recv_size0, recv_size1, recvGrad_size1;
+      std::vector<double> evalPointsShapeValues;
+      std::vector<double> evalPointsUnitShapeGradients;
+      std::vector<double> evalPointsMappingShapeGradients;
+      /**
+       * point counts and offsets for the single MPI_Alltoallv of the symmetrized density
+       * in each SCF iteration
+       */
+      std::vector<int> evalPointsSendCount, evalPointsSendOffsets;
+      std::vector<int> requestPointsRecvCount, requestPointsRecvOffsets;
+      /**
+       * density (and gradient) values at the symmetry transformed points received from the
+       * evaluating processors
+       */
+      std::vector<double> symmRecvValues;
       //
     };
 }
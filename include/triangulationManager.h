@@ -79,9 +79,9 @@ namespace dftfe  {
 
 
 
-    /** @brief generates serial and parallel unmoved previous mesh.
+    /** @brief generates parallel unmoved previous mesh.
      *
-     *  The function is to be used a update call to update the serial and parallel unmoved previous
+     *  The function is to be used a update call to update the parallel unmoved previous
      *  mesh after we have used it for the field projection purposes in structure optimization.
      *
      *  @param atomLocations vector containing cartesian coordinates at atoms with
@@ -91,7 +91,7 @@ namespace dftfe  {
      *  @param domainBoundingVectors vector of domain bounding vectors (refer to
      *  description of input parameters.
      */
-    void generateSerialAndParallelUnmovedPreviousMesh
+    void generateParallelUnmovedPreviousMesh
       (const std::vector<std::vector<double> > & atomLocations,
        const std::vector<std::vector<double> > & imageAtomLocations,
        const std::vector<std::vector<double> > & domainBoundingVectors);
@@ -161,14 +161,6 @@ namespace dftfe  {
      */
     parallel::distributed::Triangulation<3> & getParallelMeshUnmovedPrevious();
 
-    /**
-     * @brief returns constant reference to serial unmoved previous triangulation
-     * (serial version of the triangulation used in the last ground state solve during
-     * structure optimization).
-     *
-     */
-    parallel::distributed::Triangulation<3> & getSerialMeshUnmovedPrevious();
-
 
     /**
      * @brief returns constant reference to triangulation to compute electrostatics
@@ -190,6 +182,13 @@ namespace dftfe  {
      */
     parallel::distributed::Triangulation<3> & getElectrostaticsMeshForce();
 
+    /**
+     * @brief returns reference to the once globally subdivided electrostatics triangulation,
+     * which is not regenerated by generateResetMeshes
+     *
+     */
+    parallel::distributed::Triangulation<3> & getElectrostaticsMeshSubdivided();
+
     /**
      * @brief resets the vertices of meshB moved to vertices of meshA.
      *
@@ -205,6 +204,37 @@ namespace dftfe  {
 			     const bool generateSerialTria,
 			     const bool generateElectrostaticsTria);
 
+    /**
+     * @brief generates the electrostatics triangulation having rho field again from the refinement flags
+     * of the last mesh generated by auto mesh approach. This is used to get back the unsubdivided
+     * electrostatics triangulation without regenerating the other meshes.
+     */
+    void generateResetElectrostaticsMeshRho();
+
+    /**
+     * @brief generates a once globally subdivided copy of the last mesh generated by auto mesh approach
+     * using the saved refinement flags. As p4est partitioning is deterministic, the subdivided triangulation
+     * has the same partitioning and cell ordering as the other electrostatics triangulations after their
+     * global subdivision. It is kept until this function is called again, so that the data structures
+     * built on it can be reused across ground-state solves.
+     */
+    void generateSubdividedElectrostaticsMesh();
+
+    /**
+     * @brief frees the subdivided electrostatics triangulation
+     */
+    void clearSubdividedElectrostaticsMesh();
+
+
+    /**
+     * @brief repartitions the parallel moved and unmoved meshes using cell weights, and resets the
+     * vertices of the parallel moved mesh to those of the parallel unmoved mesh. The cell weights are
+     * stored and reused when the meshes are regenerated in generateResetMeshes.
+     *
+     *  @param [input]cellWeights map from CellId of the locally owned cells to their additional
+     *  computational cost, relative to the default p4est cell weight of 1000
+     */
+    void repartitionParallelMeshes(const std::map<dealii::CellId,unsigned int> & cellWeights);
 
     /**
      * @brief serialize the triangulations and the associated solution vectors
@@ -344,6 +374,12 @@ namespace dftfe  {
 			  const parallel::distributed::Triangulation<3>& parallelTriangulation,
 			  std::vector<bool> & serialTriaCurrentRefinement);
 
+    /**
+     * @brief internal function which repartitions the parallel moved and unmoved meshes using the
+     * stored cell weights
+     */
+    void repartitionParallelMeshesWithStoredCellWeights();
+
     /**
      * @brief internal function to serialize support triangulations. No solution data is attached to them
      */
@@ -363,13 +399,16 @@ namespace dftfe  {
     parallel::distributed::Triangulation<3> d_triangulationElectrostaticsRho;
     parallel::distributed::Triangulation<3> d_triangulationElectrostaticsDisp;
     parallel::distributed::Triangulation<3> d_triangulationElectrostaticsForce;
+    parallel::distributed::Triangulation<3> d_triangulationElectrostaticsSubdivided;
     parallel::distributed::Triangulation<3> d_serialTriangulationUnmoved;
-    parallel::distributed::Triangulation<3> d_serialTriangulationUnmovedPrevious;
     parallel::distributed::Triangulation<3> d_serialTriangulationElectrostatics;
 
     std::vector<std::vector<bool> > d_parallelTriaCurrentRefinement;
     std::vector<std::vector<bool> > d_serialTriaCurrentRefinement;
 
+    /// additional computational cost of the locally owned cells used in repartitioning the parallel meshes
+    std::map<dealii::CellId,unsigned int> d_cellWeights;
+
 
     std::vector<std::vector<double> > d_atomPositions;
     std::vector<std::vector<double> > d_imageAtomPositions;
@@ -49,6 +49,19 @@ namespace dftfe{
 						   dealii::ConstraintMatrix & onlyHangingConstraints);
 
 
+    /** @brief Creates the partitioner of a custom partitioned flattened dealii vector
+     *  which stores multiple components asociated with a node sequentially.
+     *
+     *  @param partitioner associated with single component vector
+     *  @param blockSize number of components associated with each node
+     *
+     *  @return partitioner of the flattened vector
+     */
+    std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+    createFlattenedPartitioner(const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner,
+			       const unsigned int                                           blockSize);
+
+
     /** @brief Creates a custom partitioned flattened dealii vector.
      *  stores multiple components asociated with a node sequentially.
      *
@@ -64,7 +77,8 @@ namespace dftfe{
 
 
 
-    /** @brief Creates a cell local index set map for flattened array
+    /** @brief Creates a cell local index set map for flattened array. The local proc indices
+     *  of all cells are stored contiguously with dofs_per_cell entries per cell.
      *
      *  @param partitioner associated with the flattened array
      *  @param matrix_free_data object pointer associated with the matrix free data structure
@@ -76,8 +90,8 @@ namespace dftfe{
     void computeCellLocalIndexSetMap(const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner,
 				     const dealii::MatrixFree<3,double>                                 & matrix_free_data,
 				     const unsigned int                                                   blockSize,
-				     std::vector<std::vector<dealii::types::global_dof_index> >         & flattenedArrayMacroCellLocalProcIndexId,
-				     std::vector<std::vector<dealii::types::global_dof_index> >         & flattenedArrayCellLocalProcIndexId);
+				     std::vector<unsigned int>                                          & flattenedArrayMacroCellLocalProcIndexId,
+				     std::vector<unsigned int>                                          & flattenedArrayCellLocalProcIndexId);
 
 
 #ifdef USE_COMPLEX
@@ -0,0 +1,131 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+//
+//dft header
+//
+#include "constants.h"
+#include "dft.h"
+#include <kernelBenchmark.h>
+#include <dftUtils.h>
+#include <dftParameters.h>
+#include <performanceTelemetry.h>
+
+
+//
+//C++ headers
+//
+#include <iostream>
+
+
+using namespace dealii;
+
+//
+//sets up the mesh, the pseudopotential data and the starting guess wavefunctions and electron-density
+//for the given FE order and runs the kernel benchmarks
+//
+template<unsigned int FEOrder>
+unsigned int runKernelBenchmark(dftfe::dftUtils::Pool & kPointPool,
+				dftfe::dftUtils::Pool & spinGroupsPool,
+				dftfe::dftUtils::Pool & bandGroupsPool)
+{
+  dftfe::dftClass<FEOrder> problem(bandGroupsPool.get_intrapool_comm(),
+				   kPointPool.get_interpool_comm(),
+				   bandGroupsPool.get_interpool_comm(),
+				   spinGroupsPool.get_interpool_comm());
+  problem.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
+  problem.set();
+  problem.init();
+
+  dftfe::kernelBenchmark<FEOrder> benchmark(&problem,
+					    bandGroupsPool.get_intrapool_comm());
+  return benchmark.run();
+}
+
+int main (int argc, char *argv[])
+{
+  AssertThrow(argc > 1,
+              ExcMessage("Usage:\n"
+                         "mpirun -np nProcs dftfeBenchmark parameterfile.prm\n"
+                         "\n"));
+  //
+  Utilities::MPI::MPI_InitFinalize mpi_initialization (argc, argv);
+
+  //
+  ParameterHandler prm;
+  dftfe::dftParameters::declare_parameters (prm);
+  const std::string parameter_file = argv[1];
+  prm.parse_input(parameter_file);
+  dftfe::dftParameters::parse_parameters(prm);
+
+  deallog.depth_console(0);
+
+  dftfe::performanceTelemetry::initialize(MPI_COMM_WORLD,
+	                                  dftfe::dftParameters::performanceTelemetryFile);
+
+  dftfe::dftUtils::Pool kPointPool(MPI_COMM_WORLD, dftfe::dftParameters::npool);
+  dftfe::dftUtils::Pool spinGroupsPool(kPointPool.get_intrapool_comm(), dftfe::dftParameters::nspinGrps);
+  dftfe::dftUtils::Pool bandGroupsPool(spinGroupsPool.get_intrapool_comm(), dftfe::dftParameters::nbandGrps);
+
+  std::srand(dealii::Utilities::MPI::this_mpi_process(bandGroupsPool.get_intrapool_comm()));
+
+  unsigned int numberRegressions=0;
+  switch (dftfe::dftParameters::finiteElementPolynomialOrder)
+    {
+    case 1:
+      numberRegressions=runKernelBenchmark<1>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 2:
+      numberRegressions=runKernelBenchmark<2>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 3:
+      numberRegressions=runKernelBenchmark<3>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 4:
+      numberRegressions=runKernelBenchmark<4>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 5:
+      numberRegressions=runKernelBenchmark<5>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 6:
+      numberRegressions=runKernelBenchmark<6>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 7:
+      numberRegressions=runKernelBenchmark<7>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 8:
+      numberRegressions=runKernelBenchmark<8>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 9:
+      numberRegressions=runKernelBenchmark<9>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 10:
+      numberRegressions=runKernelBenchmark<10>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 11:
+      numberRegressions=runKernelBenchmark<11>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    case 12:
+      numberRegressions=runKernelBenchmark<12>(kPointPool,spinGroupsPool,bandGroupsPool);
+      break;
+    }
+
+  dftfe::performanceTelemetry::writeSummary();
+
+  if (numberRegressions>0 && dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
+    std::cout<<"DFT-FE Benchmark: "<<numberRegressions<<" kernel(s) slower than the reference beyond the REGRESSION TOLERANCE."<<std::endl;
+
+  return numberRegressions>0?1:0;
+}
@@ -0,0 +1,633 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <kernelBenchmark.h>
+#include <dft.h>
+#include <kohnShamDFTOperator.h>
+#include <poissonSolverProblem.h>
+#include <dealiiLinearSolver.h>
+#include <linearAlgebraOperations.h>
+#include <linearAlgebraOperationsInternal.h>
+#include <dftParameters.h>
+#include <dftUtils.h>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+
+namespace dftfe {
+
+  namespace internalKernelBenchmark
+  {
+#ifdef USE_COMPLEX
+    //floating point operations of a complex multiply-add
+    const double flopsPerMultiplyAdd=8.0;
+#else
+    const double flopsPerMultiplyAdd=2.0;
+#endif
+
+    //
+    //returns the value of the field fieldName (for example "minTime") of a JSON record written by
+    //kernelBenchmark::writeResults. Returns a negative value if the field is not found.
+    //
+    double getRecordField(const std::string & record,
+			  const std::string & fieldName)
+    {
+      const std::string key="\""+fieldName+"\":";
+      const std::size_t pos=record.find(key);
+      if (pos==std::string::npos)
+	return -1.0;
+
+      std::istringstream valueStream(record.substr(pos+key.size()));
+      double value=-1.0;
+      valueStream>>value;
+      return value;
+    }
+
+    std::string getRecordKernelName(const std::string & record)
+    {
+      const std::string key="\"kernel\":\"";
+      const std::size_t pos=record.find(key);
+      if (pos==std::string::npos)
+	return "";
+
+      const std::size_t end=record.find("\"",pos+key.size());
+      return record.substr(pos+key.size(),end-pos-key.size());
+    }
+  }
+
+  //
+  //constructor
+  //
+  template<unsigned int FEOrder>
+  kernelBenchmark<FEOrder>::kernelBenchmark(dftClass<FEOrder>* _dftPtr,const MPI_Comm &mpi_comm_replica):
+    dftPtr(_dftPtr),
+    mpi_communicator (mpi_comm_replica),
+    n_mpi_processes (Utilities::MPI::n_mpi_processes(mpi_comm_replica)),
+    this_mpi_process (Utilities::MPI::this_mpi_process(mpi_comm_replica)),
+    pcout(std::cout, (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0))
+  {
+
+  }
+
+  template<unsigned int FEOrder>
+  void kernelBenchmark<FEOrder>::timeKernel(const std::string & name,
+					    const unsigned int numberVectors,
+					    const double flops,
+					    const double bytes,
+					    const std::function<void()> & kernel,
+					    const std::function<void()> & reset)
+  {
+    //warm up
+    reset();
+    kernel();
+
+    const unsigned int numberRepetitions=dftParameters::benchmarkRepetitions;
+    double minTime=std::numeric_limits<double>::max();
+    double maxTime=0.0;
+    double sumTime=0.0;
+    for (unsigned int irep=0; irep<numberRepetitions; ++irep)
+      {
+	reset();
+	MPI_Barrier(mpi_communicator);
+	const double startTime=MPI_Wtime();
+	kernel();
+	const double time=Utilities::MPI::max(MPI_Wtime()-startTime,mpi_communicator);
+
+	minTime=std::min(minTime,time);
+	maxTime=std::max(maxTime,time);
+	sumTime+=time;
+      }
+
+    kernelResult result;
+    result.name=name;
+    result.numberVectors=numberVectors;
+    result.minTime=minTime;
+    result.avgTime=sumTime/numberRepetitions;
+    result.maxTime=maxTime;
+    result.flops=flops;
+    result.bytes=bytes;
+    d_results.push_back(result);
+
+    pcout<<std::left<<std::setw(40)<<name
+	 <<" min time (s): "<<std::scientific<<std::setprecision(4)<<minTime;
+    if (flops>0.0)
+      pcout<<", GFLOP/s: "<<std::fixed<<std::setprecision(2)<<flops/minTime*1e-9;
+    if (bytes>0.0)
+      pcout<<", GB/s: "<<std::fixed<<std::setprecision(2)<<bytes/minTime*1e-9;
+    pcout<<std::endl;
+  }
+
+  template<unsigned int FEOrder>
+  unsigned int kernelBenchmark<FEOrder>::run()
+  {
+    pcout<<std::endl<<"-----------------Kernel benchmark-----------------"<<std::endl;
+
+    const unsigned int numberGlobalDofs=dftPtr->dofHandler.n_dofs();
+    pcout<<"FE order: "<<FEOrder<<", number of DoFs: "<<numberGlobalDofs
+	 <<", number of wavefunctions: "<<dftPtr->d_numEigenValues
+	 <<", number of k-points: "<<dftPtr->d_kPointWeights.size()
+	 <<", number of MPI tasks: "<<n_mpi_processes<<std::endl;
+
+    //
+    //electrostatic potential of the nuclear charges, required by the effective potential
+    //
+    dftPtr->d_vselfBinsManager.solveVselfInBins(dftPtr->matrix_free_data,
+						2,
+						dftPtr->d_phiExt,
+						dftPtr->d_noConstraints,
+						dftPtr->d_imagePositions,
+						dftPtr->d_imageIds,
+						dftPtr->d_imageCharges,
+						dftPtr->d_localVselfs);
+
+    //
+    //total electrostatic potential Poisson solve with the starting guess electron-density
+    //
+    {
+      dealiiLinearSolver dealiiCGSolver(mpi_communicator, dealiiLinearSolver::CG);
+      poissonSolverProblem<FEOrder> phiTotalSolverProblem(mpi_communicator);
+      phiTotalSolverProblem.reinit(dftPtr->matrix_free_data,
+				   dftPtr->d_phiTotRhoIn,
+				   *dftPtr->d_constraintsVector[dftPtr->phiTotDofHandlerIndex],
+				   dftPtr->phiTotDofHandlerIndex,
+				   dftPtr->d_atomNodeIdToChargeMap,
+				   *dftPtr->rhoInValues,
+				   true,
+				   dftParameters::periodicX && dftParameters::periodicY && dftParameters::periodicZ && !dftParameters::pinnedNodeForPBC);
+
+      //each solve is started from zero, so all the solves take the same number of CG iterations
+      timeKernel("Poisson solve",
+		 1,
+		 0.0,
+		 0.0,
+		 [&](){dealiiCGSolver.solve(phiTotalSolverProblem,
+					    dftParameters::absLinearSolverTolerance,
+					    dftParameters::maxLinearSolverIterations,
+					    0);},
+		 [&](){dftPtr->d_phiTotRhoIn=0.0;});
+    }
+
+    kohnShamDFTOperatorClass<FEOrder> kohnShamDFTEigenOperator(dftPtr,mpi_communicator);
+    kohnShamDFTEigenOperator.init();
+
+#ifdef DEAL_II_WITH_SCALAPACK
+    kohnShamDFTEigenOperator.processGridOptionalELPASetup(dftPtr->d_numEigenValues,
+							  dftPtr->d_numEigenValuesRR);
+#endif
+
+    kohnShamDFTEigenOperator.preComputeShapeFunctionGradientIntegrals();
+
+    //
+    //effective potential
+    //
+    const unsigned int numberQuadraturePoints=std::pow(C_num1DQuad<FEOrder>(),3);
+    const double numberGlobalCells=dftPtr->dofHandler.get_triangulation().n_global_active_cells();
+    const double quadratureDataBytes=numberGlobalCells*numberQuadraturePoints*sizeof(double);
+    if (dftParameters::spinPolarized==1)
+      {
+	if (dftParameters::xc_id < 4)
+	  timeKernel("VEff",
+		     0,
+		     0.0,
+		     5.0*quadratureDataBytes,
+		     [&](){kohnShamDFTEigenOperator.computeVEffSpinPolarized(dftPtr->rhoInValuesSpinPolarized,
+									     dftPtr->d_phiTotRhoIn,
+									     dftPtr->d_phiExt,
+									     0,
+									     dftPtr->d_pseudoVLoc);},
+		     [](){});
+	else
+	  timeKernel("VEff",
+		     0,
+		     0.0,
+		     12.0*quadratureDataBytes,
+		     [&](){kohnShamDFTEigenOperator.computeVEffSpinPolarized(dftPtr->rhoInValuesSpinPolarized,
+									     dftPtr->gradRhoInValuesSpinPolarized,
+									     dftPtr->d_phiTotRhoIn,
+									     dftPtr->d_phiExt,
+									     0,
+									     dftPtr->d_pseudoVLoc);},
+		     [](){});
+      }
+    else
+      {
+	if (dftParameters::xc_id < 4)
+	  timeKernel("VEff",
+		     0,
+		     0.0,
+		     4.0*quadratureDataBytes,
+		     [&](){kohnShamDFTEigenOperator.computeVEff(dftPtr->rhoInValues,
+								dftPtr->d_phiTotRhoIn,
+								dftPtr->d_phiExt,
+								dftPtr->d_pseudoVLoc);},
+		     [](){});
+	else
+	  timeKernel("VEff",
+		     0,
+		     0.0,
+		     10.0*quadratureDataBytes,
+		     [&](){kohnShamDFTEigenOperator.computeVEff(dftPtr->rhoInValues,
+								dftPtr->gradRhoInValues,
+								dftPtr->d_phiTotRhoIn,
+								dftPtr->d_phiExt,
+								dftPtr->d_pseudoVLoc);},
+		     [](){});
+      }
+
+    unsigned int kPointIndex=0;
+    kohnShamDFTEigenOperator.reinitkPointIndex(kPointIndex);
+    kohnShamDFTEigenOperator.computeHamiltonianMatrix(kPointIndex);
+
+    benchmarkHX(kohnShamDFTEigenOperator);
+
+    benchmarkSubspace(kohnShamDFTEigenOperator);
+
+#ifdef DFTFE_WITH_ELPA
+    if (dftParameters::useELPA)
+      kohnShamDFTEigenOperator.elpaDeallocateHandles(dftPtr->d_numEigenValues,
+						     dftPtr->d_numEigenValuesRR);
+#endif
+
+    //
+    //electron-density from all the wavefunctions of all the k-points and spins. The occupancy cutoff
+    //is switched off as the starting guess eigenvalues are not meaningful
+    //
+    {
+      const double occupancyCutoff=dftParameters::occupancyCutoff;
+      dftParameters::occupancyCutoff=0.0;
+
+      const bool isEvaluateGradRho=dftParameters::xc_id == 4;
+      std::map<dealii::CellId, std::vector<double> > rhoValues, gradRhoValues, rhoValuesSpinPolarized, gradRhoValuesSpinPolarized;
+
+      const double numberVectorsTotal=(double)dftPtr->d_numEigenValues*dftPtr->d_kPointWeights.size()*(1+dftParameters::spinPolarized);
+      const double numberNodesPerElement=dftPtr->dofHandler.get_fe().dofs_per_cell;
+      timeKernel("computeRhoFromPSI",
+		 dftPtr->d_numEigenValues,
+		 internalKernelBenchmark::flopsPerMultiplyAdd*numberGlobalCells*numberNodesPerElement*numberQuadraturePoints
+		 *(isEvaluateGradRho?4.0:1.0)*numberVectorsTotal,
+		 numberGlobalCells*numberNodesPerElement*numberVectorsTotal*sizeof(dataTypes::number),
+		 [&](){dftPtr->computeRhoFromPSI(&rhoValues,
+						 &gradRhoValues,
+						 &rhoValuesSpinPolarized,
+						 &gradRhoValuesSpinPolarized,
+						 isEvaluateGradRho,
+						 false);},
+		 [](){});
+
+      dftParameters::occupancyCutoff=occupancyCutoff;
+    }
+
+    return writeResults();
+  }
+
+  template<unsigned int FEOrder>
+  void kernelBenchmark<FEOrder>::benchmarkHX(kohnShamDFTOperatorClass<FEOrder> & kohnShamDFTEigenOperator)
+  {
+    const unsigned int numberVectors=std::min(dftParameters::chebyWfcBlockSize,dftPtr->d_numEigenValues);
+    const unsigned int numberNodesPerElement=kohnShamDFTEigenOperator.d_numberNodesPerElement;
+    const double numberGlobalCells=dftPtr->dofHandler.get_triangulation().n_global_active_cells();
+    const double numberGlobalDofs=dftPtr->dofHandler.n_dofs();
+    const bool isNonLocalHamiltonian=dftParameters::isPseudopotential && dftPtr->d_nonLocalAtomGlobalChargeIds.size() > 0;
+
+    //
+    //flops and bytes of the cell-level local Hamiltonian times X: a dense numberNodesPerElement x numberNodesPerElement
+    //cell matrix times the numberNodesPerElement x numberVectors cell block of X, and the gather and scatter of the cell blocks
+    //
+    const double flopsLocal=internalKernelBenchmark::flopsPerMultiplyAdd*numberGlobalCells
+      *numberNodesPerElement*numberNodesPerElement*numberVectors;
+    const double bytesLocal=numberGlobalCells*(numberNodesPerElement*numberNodesPerElement+2.0*numberNodesPerElement*numberVectors)
+      *sizeof(dataTypes::number);
+
+    //
+    //flops and bytes of the nonlocal Hamiltonian times X: C^{T}*X and C*(V*C^{T}*X) for the cell projector
+    //matrices C of size numberNodesPerElement x number of projectors touching the cell
+    //
+    double numberCellProjectors=0.0;
+    if (isNonLocalHamiltonian)
+      numberCellProjectors=Utilities::MPI::sum((double)dftPtr->d_nonLocalProjectorCellStartIds.back(),mpi_communicator);
+    const double flopsNonLocal=2.0*internalKernelBenchmark::flopsPerMultiplyAdd*numberCellProjectors*numberNodesPerElement*numberVectors;
+    const double bytesNonLocal=2.0*numberCellProjectors*numberNodesPerElement*sizeof(dataTypes::number)
+      +(isNonLocalHamiltonian?2.0*numberGlobalCells*numberNodesPerElement*numberVectors*sizeof(dataTypes::number):0.0);
+
+    //the mass matrix scaling, constraints distribution and ghost communication of src and dst in HX
+    const double bytesVectors=4.0*numberGlobalDofs*numberVectors*sizeof(dataTypes::number);
+
+    dealii::parallel::distributed::Vector<dataTypes::number> X,Y;
+    kohnShamDFTEigenOperator.reinit(numberVectors,
+				    X,
+				    true);
+    Y.reinit(X);
+
+    for (unsigned int i=0; i<X.local_size(); ++i)
+      X.local_element(i)=dataTypes::number((double)std::rand()/RAND_MAX);
+    X.update_ghost_values();
+
+    const dealii::parallel::distributed::Vector<dataTypes::number> XCopy(X);
+
+    //
+    //full Hamiltonian times X
+    //
+#ifdef WITH_MKL
+    const bool useBatchGEMM=dftParameters::useBatchGEMM;
+    dftParameters::useBatchGEMM=false;
+#endif
+    timeKernel("HX",
+	       numberVectors,
+	       flopsLocal+flopsNonLocal,
+	       bytesLocal+bytesNonLocal+bytesVectors,
+	       [&](){kohnShamDFTEigenOperator.HX(X,numberVectors,false,1.0,Y);},
+	       [&](){Y=dataTypes::number(0.0);});
+#ifdef WITH_MKL
+    dftParameters::useBatchGEMM=true;
+    timeKernel("HX batch GEMM",
+	       numberVectors,
+	       flopsLocal+flopsNonLocal,
+	       bytesLocal+bytesNonLocal+bytesVectors,
+	       [&](){kohnShamDFTEigenOperator.HX(X,numberVectors,false,1.0,Y);},
+	       [&](){Y=dataTypes::number(0.0);});
+    dftParameters::useBatchGEMM=useBatchGEMM;
+#endif
+
+    //
+    //cell-level local Hamiltonian times X over all macro cells
+    //
+    dftPtr->constraintsNoneDataInfo.distribute(X,
+					       numberVectors);
+    X.update_ghost_values();
+    timeKernel("HX local",
+	       numberVectors,
+	       flopsLocal,
+	       bytesLocal,
+	       [&](){kohnShamDFTEigenOperator.computeLocalHamiltonianTimesX(X,
+									  numberVectors,
+									  Y,
+									  0,
+									  kohnShamDFTEigenOperator.d_numberMacroCells);},
+	       [&](){Y=dataTypes::number(0.0);});
+#ifdef WITH_MKL
+    timeKernel("HX local batch GEMM",
+	       numberVectors,
+	       flopsLocal,
+	       bytesLocal,
+	       [&](){kohnShamDFTEigenOperator.computeLocalHamiltonianTimesXBatchGEMM(X,
+										   numberVectors,
+										   Y,
+										   0,
+										   kohnShamDFTEigenOperator.d_numberMacroCells);},
+	       [&](){Y=dataTypes::number(0.0);});
+#endif
+
+    //
+    //nonlocal Hamiltonian times X including the reduction and ghost update of the projector kets times X
+    //
+    if (isNonLocalHamiltonian)
+      {
+	timeKernel("HX nonlocal",
+		   numberVectors,
+		   flopsNonLocal,
+		   bytesNonLocal,
+		   [&](){kohnShamDFTEigenOperator.computeNonLocalProjectorKetTimesX(X,
+										  numberVectors);
+			 kohnShamDFTEigenOperator.scaleNonLocalProjectorKetTimesX(numberVectors);
+			 kohnShamDFTEigenOperator.computeNonLocalHamiltonianTimesX(numberVectors,
+										   Y);},
+		   [&](){Y=dataTypes::number(0.0);});
+#ifdef WITH_MKL
+	timeKernel("HX nonlocal batch GEMM",
+		   numberVectors,
+		   flopsNonLocal,
+		   bytesNonLocal,
+		   [&](){kohnShamDFTEigenOperator.computeNonLocalProjectorKetTimesXBatchGEMM(X,
+											   numberVectors);
+			 kohnShamDFTEigenOperator.scaleNonLocalProjectorKetTimesX(numberVectors);
+			 kohnShamDFTEigenOperator.computeNonLocalHamiltonianTimesXBatchGEMM(numberVectors,
+											    Y);},
+		   [&](){Y=dataTypes::number(0.0);});
+#endif
+      }
+
+    //
+    //Chebyshev filter of the block of vectors. The spectrum bounds are computed as in the
+    //Chebyshev filtered subspace iteration solver
+    //
+    kohnShamDFTEigenOperator.reinit(1);
+    const double upperBoundUnwantedSpectrum=linearAlgebraOperations::lanczosUpperBoundEigenSpectrum(kohnShamDFTEigenOperator,
+												    dftPtr->d_tempEigenVec);
+    const double lowerBoundUnwantedSpectrum=(dftParameters::lowerBoundUnwantedFracUpper>1e-6?
+					     dftParameters::lowerBoundUnwantedFracUpper:0.1)*upperBoundUnwantedSpectrum;
+
+    //the Chebyshev order is automatically set from the upper bound only inside the solver, so a
+    //fixed order is used if CHEBYSHEV POLYNOMIAL DEGREE is zero
+    const unsigned int chebyshevOrder=dftParameters::chebyshevOrder==0?20:dftParameters::chebyshevOrder;
+
+    kohnShamDFTEigenOperator.reinit(numberVectors,
+				    X,
+				    false);
+    timeKernel("chebyshevFilter",
+	       numberVectors,
+	       chebyshevOrder*(flopsLocal+flopsNonLocal+3.0*internalKernelBenchmark::flopsPerMultiplyAdd*numberGlobalDofs*numberVectors),
+	       chebyshevOrder*(bytesLocal+bytesNonLocal+bytesVectors+3.0*numberGlobalDofs*numberVectors*sizeof(dataTypes::number)),
+	       [&](){linearAlgebraOperations::chebyshevFilter(kohnShamDFTEigenOperator,
+							      X,
+							      numberVectors,
+							      chebyshevOrder,
+							      lowerBoundUnwantedSpectrum,
+							      upperBoundUnwantedSpectrum,
+							      dftParameters::lowerEndWantedSpectrum);},
+	       [&](){X=XCopy;});
+  }
+
+  template<unsigned int FEOrder>
+  void kernelBenchmark<FEOrder>::benchmarkSubspace(kohnShamDFTOperatorClass<FEOrder> & kohnShamDFTEigenOperator)
+  {
+    const unsigned int numberWaveFunctions=dftPtr->d_numEigenValues;
+    const double numberGlobalDofs=dftPtr->dofHandler.n_dofs();
+    const double N=numberWaveFunctions;
+
+    std::vector<dataTypes::number> & X=dftPtr->d_eigenVectorsFlattenedSTL[0];
+    const std::vector<dataTypes::number> XCopy(X);
+
+#ifdef DEAL_II_WITH_SCALAPACK
+    const unsigned int rowsBlockSize=kohnShamDFTEigenOperator.getScalapackBlockSize();
+    std::shared_ptr< const dealii::Utilities::MPI::ProcessGrid>  processGrid;
+    linearAlgebraOperations::internal::createProcessGridSquareMatrix(mpi_communicator,
+								     numberWaveFunctions,
+								     processGrid);
+
+    //
+    //S=X^{T}*X, only the lower triangular blocks are computed
+    //
+    dealii::ScaLAPACKMatrix<dataTypes::number> overlapMatPar(numberWaveFunctions,
+							     processGrid,
+							     rowsBlockSize);
+    timeKernel("fillParallelOverlapMatrix",
+	       numberWaveFunctions,
+	       internalKernelBenchmark::flopsPerMultiplyAdd*0.5*N*(N+1.0)*numberGlobalDofs,
+	       (numberGlobalDofs*N+N*N)*sizeof(dataTypes::number),
+	       [&](){linearAlgebraOperations::internal::fillParallelOverlapMatrix(&X[0],
+										  X.size(),
+										  numberWaveFunctions,
+										  processGrid,
+										  dftPtr->interBandGroupComm,
+										  mpi_communicator,
+										  overlapMatPar);},
+	       [&](){if (processGrid->is_process_active())
+		       std::fill(&overlapMatPar.local_el(0,0),
+				 &overlapMatPar.local_el(0,0)+overlapMatPar.local_m()*overlapMatPar.local_n(),
+				 dataTypes::number(0.0));});
+
+    //
+    //X^{T}=Q*X^{T} with Q being the identity, which has the same cost as a general rotation
+    //
+    dealii::ScaLAPACKMatrix<dataTypes::number> rotationMatPar(numberWaveFunctions,
+							      processGrid,
+							      rowsBlockSize);
+    if (processGrid->is_process_active())
+      {
+	std::fill(&rotationMatPar.local_el(0,0),
+		  &rotationMatPar.local_el(0,0)+rotationMatPar.local_m()*rotationMatPar.local_n(),
+		  dataTypes::number(0.0));
+
+	std::map<unsigned int, unsigned int> globalToLocalRowIdMap;
+	std::map<unsigned int, unsigned int> globalToLocalColumnIdMap;
+	linearAlgebraOperations::internal::createGlobalToLocalIdMapsScaLAPACKMat(processGrid,
+										 rotationMatPar,
+										 globalToLocalRowIdMap,
+										 globalToLocalColumnIdMap);
+	for (unsigned int i=0; i<numberWaveFunctions; ++i)
+	  if (globalToLocalRowIdMap.find(i)!=globalToLocalRowIdMap.end()
+	      && globalToLocalColumnIdMap.find(i)!=globalToLocalColumnIdMap.end())
+	    rotationMatPar.local_el(globalToLocalRowIdMap[i],globalToLocalColumnIdMap[i])=dataTypes::number(1.0);
+      }
+
+    timeKernel("subspaceRotation",
+	       numberWaveFunctions,
+	       internalKernelBenchmark::flopsPerMultiplyAdd*N*N*numberGlobalDofs,
+	       (2.0*numberGlobalDofs*N+N*N)*sizeof(dataTypes::number),
+	       [&](){linearAlgebraOperations::internal::subspaceRotation(&X[0],
+									 X.size(),
+									 numberWaveFunctions,
+									 processGrid,
+									 dftPtr->interBandGroupComm,
+									 mpi_communicator,
+									 rotationMatPar);},
+	       [](){});
+#endif
+
+    //
+    //overlap matrix, Cholesky factorization and triangular subspace rotation
+    //
+    timeKernel("pseudoGramSchmidtOrthogonalization",
+	       numberWaveFunctions,
+	       internalKernelBenchmark::flopsPerMultiplyAdd*(N*N*numberGlobalDofs+N*N*N/6.0),
+	       (3.0*numberGlobalDofs*N+2.0*N*N)*sizeof(dataTypes::number),
+	       [&](){linearAlgebraOperations::pseudoGramSchmidtOrthogonalization(kohnShamDFTEigenOperator,
+										 X,
+										 numberWaveFunctions,
+										 dftPtr->interBandGroupComm,
+										 mpi_communicator,
+										 false);},
+	       [&](){X=XCopy;});
+
+    X=XCopy;
+  }
+
+  template<unsigned int FEOrder>
+  unsigned int kernelBenchmark<FEOrder>::writeResults() const
+  {
+#ifdef USE_COMPLEX
+    const bool isComplex=true;
+#else
+    const bool isComplex=false;
+#endif
+
+    unsigned int numberRegressions=0;
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
+      {
+	std::ofstream outFile(dftParameters::benchmarkResultsFile.c_str());
+	for (unsigned int i=0; i<d_results.size(); ++i)
+	  {
+	    const kernelResult & result=d_results[i];
+	    outFile<<std::scientific<<std::setprecision(6)
+		   <<"{\"kernel\":\""<<result.name<<"\""
+		   <<",\"FEOrder\":"<<FEOrder
+		   <<",\"dofs\":"<<dftPtr->dofHandler.n_dofs()
+		   <<",\"wavefunctions\":"<<dftPtr->d_numEigenValues
+		   <<",\"vectors\":"<<result.numberVectors
+		   <<",\"kpoints\":"<<dftPtr->d_kPointWeights.size()
+		   <<",\"complex\":"<<(isComplex?"true":"false")
+		   <<",\"mpiTasks\":"<<n_mpi_processes
+		   <<",\"repetitions\":"<<dftParameters::benchmarkRepetitions
+		   <<",\"minTime\":"<<result.minTime
+		   <<",\"avgTime\":"<<result.avgTime
+		   <<",\"maxTime\":"<<result.maxTime
+		   <<",\"gflops\":"<<result.flops/result.minTime*1e-9
+		   <<",\"gbs\":"<<result.bytes/result.minTime*1e-9
+		   <<"}"<<std::endl;
+	  }
+	outFile.close();
+
+	if (!dftParameters::benchmarkReferenceFile.empty())
+	  {
+	    std::ifstream referenceFile(dftParameters::benchmarkReferenceFile.c_str());
+	    AssertThrow(referenceFile.is_open(),ExcMessage("DFT-FE Error: could not open the benchmark REFERENCE FILE: "+dftParameters::benchmarkReferenceFile));
+
+	    std::map<std::string,double> referenceMinTimes;
+	    std::string record;
+	    while (std::getline(referenceFile,record))
+	      {
+		const std::string name=internalKernelBenchmark::getRecordKernelName(record);
+		if (!name.empty())
+		  referenceMinTimes[name]=internalKernelBenchmark::getRecordField(record,"minTime");
+	      }
+
+	    std::cout<<std::endl<<"Comparison with reference: "<<dftParameters::benchmarkReferenceFile<<std::endl;
+	    for (unsigned int i=0; i<d_results.size(); ++i)
+	      {
+		const std::map<std::string,double>::const_iterator it=referenceMinTimes.find(d_results[i].name);
+		if (it==referenceMinTimes.end() || it->second<=0.0)
+		  continue;
+
+		const double ratio=d_results[i].minTime/it->second;
+		const bool isRegression=ratio>1.0+dftParameters::benchmarkRegressionTolerance;
+		if (isRegression)
+		  numberRegressions++;
+
+		std::cout<<std::left<<std::setw(40)<<d_results[i].name
+			 <<" time/reference time: "<<std::fixed<<std::setprecision(3)<<ratio
+			 <<(isRegression?"  REGRESSION":"")<<std::endl;
+	      }
+	  }
+      }
+
+    return Utilities::MPI::max(numberRegressions,MPI_COMM_WORLD);
+  }
+
+
+  template class kernelBenchmark<1>;
+  template class kernelBenchmark<2>;
+  template class kernelBenchmark<3>;
+  template class kernelBenchmark<4>;
+  template class kernelBenchmark<5>;
+  template class kernelBenchmark<6>;
+  template class kernelBenchmark<7>;
+  template class kernelBenchmark<8>;
+  template class kernelBenchmark<9>;
+  template class kernelBenchmark<10>;
+  template class kernelBenchmark<11>;
+  template class kernelBenchmark<12>;
+
+}
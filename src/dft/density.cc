@@ -18,6 +18,122 @@
 
 //source file for electron density related computations
 
+namespace internal
+{
+  //
+  //Evaluates a block of wavefunctions, stored in the flattened [node][wave] format, at
+  //the quadrature points of a cell using a single GEMM each for the values and the reference cell
+  //gradients, and accumulates the weighted density \sum_j w_j psi_j^2 and its reference cell
+  //gradient 2\sum_j w_j psi_j \nabla psi_j. Complex wavefunctions are handled by viewing the
+  //flattened array as a real array with interleaved real and imaginary parts.
+  //
+  void accumulateCellDensityFromFlattenedBlock(const double * flattenedArrayBlock,
+					       const unsigned int * cellLocalProcIndexIdMap,
+					       const unsigned int numberRealComponents,
+					       const unsigned int numberColumns,
+					       const unsigned int numberNodesPerElement,
+					       const unsigned int numberQuadPoints,
+					       const std::vector<double> & shapeValueTable,
+					       const std::vector<double> & shapeGradRefTable,
+					       const double * weights,
+					       const bool isEvaluateGradRho,
+					       std::vector<double> & cellWaveFunctionMatrix,
+					       std::vector<double> & psiQuads,
+					       std::vector<double> & gradPsiRefQuads,
+					       double * rhoQuads,
+					       double * gradRhoRefQuads)
+  {
+    const char transA = 'N',transB = 'N';
+    const double scalarCoeffAlpha = 1.0,scalarCoeffBeta = 0.0;
+    const unsigned int inc = 1;
+    const unsigned int numberGradRows = 3*numberQuadPoints;
+
+    //gather the (nodes x block) cell wavefunction matrix
+    for(unsigned int iNode = 0; iNode < numberNodesPerElement; ++iNode)
+      dcopy_(&numberColumns,
+	     flattenedArrayBlock+numberRealComponents*cellLocalProcIndexIdMap[iNode],
+	     &inc,
+	     &cellWaveFunctionMatrix[numberColumns*iNode],
+	     &inc);
+
+    dgemm_(&transA,
+	   &transB,
+	   &numberColumns,
+	   &numberQuadPoints,
+	   &numberNodesPerElement,
+	   &scalarCoeffAlpha,
+	   &cellWaveFunctionMatrix[0],
+	   &numberColumns,
+	   &shapeValueTable[0],
+	   &numberNodesPerElement,
+	   &scalarCoeffBeta,
+	   &psiQuads[0],
+	   &numberColumns);
+
+    if(isEvaluateGradRho)
+      dgemm_(&transA,
+	     &transB,
+	     &numberColumns,
+	     &numberGradRows,
+	     &numberNodesPerElement,
+	     &scalarCoeffAlpha,
+	     &cellWaveFunctionMatrix[0],
+	     &numberColumns,
+	     &shapeGradRefTable[0],
+	     &numberNodesPerElement,
+	     &scalarCoeffBeta,
+	     &gradPsiRefQuads[0],
+	     &numberColumns);
+
+    const unsigned int vectorizationLength=VectorizedArray<double>::n_array_elements;
+    const unsigned int numberVectorizedColumns=numberColumns-numberColumns%vectorizationLength;
+
+    for(unsigned int q = 0; q < numberQuadPoints; ++q)
+      {
+	const double * psiQuad=&psiQuads[numberColumns*q];
+	VectorizedArray<double> rhoQuad=make_vectorized_array(0.0);
+	VectorizedArray<double> gradRhoRefQuad[3]={make_vectorized_array(0.0),
+						   make_vectorized_array(0.0),
+						   make_vectorized_array(0.0)};
+
+	for(unsigned int j = 0; j < numberVectorizedColumns; j+=vectorizationLength)
+	  {
+	    VectorizedArray<double> weight, psi;
+	    weight.load(weights+j);
+	    psi.load(psiQuad+j);
+	    const VectorizedArray<double> weightTimesPsi=weight*psi;
+	    rhoQuad+=weightTimesPsi*psi;
+
+	    if(isEvaluateGradRho)
+	      for(unsigned int idim = 0; idim < 3; ++idim)
+		{
+		  VectorizedArray<double> gradPsiRef;
+		  gradPsiRef.load(&gradPsiRefQuads[numberColumns*(3*q+idim)+j]);
+		  gradRhoRefQuad[idim]+=weightTimesPsi*gradPsiRef;
+		}
+	  }
+
+	for(unsigned int k = 0; k < vectorizationLength; ++k)
+	  {
+	    rhoQuads[q]+=rhoQuad[k];
+	    if(isEvaluateGradRho)
+	      for(unsigned int idim = 0; idim < 3; ++idim)
+		gradRhoRefQuads[3*q+idim]+=2.0*gradRhoRefQuad[idim][k];
+	  }
+
+	for(unsigned int j = numberVectorizedColumns; j < numberColumns; ++j)
+	  {
+	    const double weightTimesPsi=weights[j]*psiQuad[j];
+	    rhoQuads[q]+=weightTimesPsi*psiQuad[j];
+
+	    if(isEvaluateGradRho)
+	      for(unsigned int idim = 0; idim < 3; ++idim)
+		gradRhoRefQuads[3*q+idim]+=2.0*weightTimesPsi*gradPsiRefQuads[numberColumns*(3*q+idim)+j];
+	  }
+      }
+  }
+}
+
 //calculate electron density
 template<unsigned int FEOrder>
 void dftClass<FEOrder>::compute_rhoOut(const bool isConsiderSpectrumSplitting)
@@ -437,16 +553,41 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
   const unsigned int numEigenVectorsFrac=d_numEigenValuesRR;
   const unsigned int numEigenVectorsCore=d_numEigenValues-d_numEigenValuesRR;
   const unsigned int numKPoints=d_kPointWeights.size();
-
+  const unsigned int numSpinComponents=1+dftParameters::spinPolarized;
 #ifdef USE_COMPLEX
-  FEEvaluation<3,FEOrder,C_num1DQuad<FEOrder>(),2> psiEval(matrix_free_data,eigenDofHandlerIndex,0);
-  FEEvaluation<3,FEOrder,C_num1DKerkerPoly<FEOrder>()+1,2> psiEvalRefined(matrix_free_data,eigenDofHandlerIndex,3);
+  const unsigned int numberRealComponents=2;
 #else
-  FEEvaluation<3,FEOrder,C_num1DQuad<FEOrder>(),1> psiEval(matrix_free_data,eigenDofHandlerIndex,0);
-  FEEvaluation<3,FEOrder,C_num1DKerkerPoly<FEOrder>()+1,1> psiEvalRefined(matrix_free_data,eigenDofHandlerIndex,3);
+  const unsigned int numberRealComponents=1;
 #endif
 
-  const unsigned int numQuadPoints= lobattoNodesFlag?psiEvalRefined.n_q_points:psiEval.n_q_points;
+  //
+  //tabulate the shape function values and reference cell gradients at the quadrature points.
+  //The wavefunction values and gradients at the quadrature points of a cell are evaluated
+  //for a full block of wavefunctions at once by a GEMM with these tables
+  //
+  const Quadrature<3> quadrature=lobattoNodesFlag?
+    Quadrature<3>(QGaussLobatto<3>(C_num1DKerkerPoly<FEOrder>()+1))
+    :Quadrature<3>(QGauss<3>(C_num1DQuad<FEOrder>()));
+  const unsigned int numQuadPoints=quadrature.size();
+
+  const FiniteElement<3> & feScalar=dofHandler.get_fe();
+  const unsigned int numNodesPerElement=feScalar.dofs_per_cell;
+
+  std::vector<double> shapeValueTable(numNodesPerElement*numQuadPoints);
+  std::vector<double> shapeGradRefTable(isEvaluateGradRho?3*numNodesPerElement*numQuadPoints:0);
+  for (unsigned int q=0; q<numQuadPoints; ++q)
+    for (unsigned int iNode=0; iNode<numNodesPerElement; ++iNode)
+      {
+	shapeValueTable[numNodesPerElement*q+iNode]=feScalar.shape_value(iNode,quadrature.point(q));
+	if(isEvaluateGradRho)
+	  {
+	    const Tensor<1,3,double> shapeGradRef=feScalar.shape_grad(iNode,quadrature.point(q));
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      shapeGradRefTable[numNodesPerElement*(3*q+idim)+iNode]=shapeGradRef[idim];
+	  }
+      }
+
+  FEValues<3> feValuesInverseJacobians(feScalar,quadrature,update_inverse_jacobians);
 
   //initialization to zero
   typename DoFHandler<3>::active_cell_iterator cell = dofHandler.begin_active(), endc = dofHandler.end();
@@ -468,23 +609,12 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
 		= std::vector<double>(6*numQuadPoints,0.0);
 	  }
       }
-   } 
-
-  Tensor<1,2,VectorizedArray<double> > zeroTensor1;
-  zeroTensor1[0]=make_vectorized_array(0.0);
-  zeroTensor1[1]=make_vectorized_array(0.0);
-  Tensor<1,2, Tensor<1,3,VectorizedArray<double> > > zeroTensor2;
-  Tensor<1,3,VectorizedArray<double> > zeroTensor3;
-  for (unsigned int idim=0; idim<3; idim++)
-    {
-      zeroTensor2[0][idim]=make_vectorized_array(0.0);
-      zeroTensor2[1][idim]=make_vectorized_array(0.0);
-      zeroTensor3[idim]=make_vectorized_array(0.0);
-    }
+   }
 
-  //temp arrays
-  std::vector<double> rhoTemp(numQuadPoints), rhoTempSpinPolarized(2*numQuadPoints), rho(numQuadPoints), rhoSpinPolarized(2*numQuadPoints);
-  std::vector<double> gradRhoTemp(3*numQuadPoints), gradRhoTempSpinPolarized(6*numQuadPoints),gradRho(3*numQuadPoints), gradRhoSpinPolarized(6*numQuadPoints);
+  //temp arrays. The gradients are accumulated with respect to the reference cell coordinates
+  //and transformed to real space only once per cell
+  std::vector<double> rhoTemp(numSpinComponents*numQuadPoints);
+  std::vector<double> gradRhoRefTemp(3*numSpinComponents*numQuadPoints);
 
 
   //band group parallelization data structures
@@ -501,35 +631,36 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
 
   const unsigned int localVectorSize = d_eigenVectorsFlattenedSTL[0].size()/numEigenVectorsTotal;
 
-  std::vector<std::vector<vectorType>> eigenVectors((1+dftParameters::spinPolarized)*d_kPointWeights.size());
-  std::vector<dealii::parallel::distributed::Vector<dataTypes::number> > eigenVectorsFlattenedBlock((1+dftParameters::spinPolarized)*d_kPointWeights.size());
+  //the unoccupied tail of the states beyond the occupancy cutoff is skipped. No truncation is done
+  //with spectrum splitting as the fractionally occupied rotated states only contribute
+  //in a summed sense
+  const unsigned int numEigenVectorsOccupied=
+    (isConsiderSpectrumSplitting && numEigenVectorsFrac!=numEigenVectorsTotal)?
+    numEigenVectorsTotal:computeNumberStatesAboveOccupancyCutoff();
 
+  std::vector<dealii::parallel::distributed::Vector<dataTypes::number> > eigenVectorsFlattenedBlock(numSpinComponents*numKPoints);
+  std::vector<dealii::parallel::distributed::Vector<dataTypes::number> > eigenVectorsRotFracFlattenedBlock(numSpinComponents*numKPoints);
 
-  std::vector<std::vector<vectorType>> eigenVectorsRotFrac((1+dftParameters::spinPolarized)*d_kPointWeights.size());
-  std::vector<dealii::parallel::distributed::Vector<dataTypes::number> > eigenVectorsRotFracFlattenedBlock((1+dftParameters::spinPolarized)*d_kPointWeights.size());
+  std::shared_ptr<const vectorTools::flattenedArrayRegistry::flattenedArrayData> flattenedArrayData;
+  std::shared_ptr<const vectorTools::flattenedArrayRegistry::flattenedArrayData> flattenedArrayDataFrac;
+  unsigned int previousBlockSizeFrac=0;
 
-  for(unsigned int ivec = 0; ivec < numEigenVectorsTotal; ivec+=eigenVectorsBlockSize)
+  for(unsigned int ivec = 0; ivec < numEigenVectorsOccupied; ivec+=eigenVectorsBlockSize)
     {
-      const unsigned int currentBlockSize=std::min(eigenVectorsBlockSize,numEigenVectorsTotal-ivec);
+      const unsigned int currentBlockSize=std::min(eigenVectorsBlockSize,numEigenVectorsOccupied-ivec);
 
       if (currentBlockSize!=eigenVectorsBlockSize || ivec==0)
 	{
-	  for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
-	    {
-	      eigenVectors[kPoint].resize(currentBlockSize);
-	      for(unsigned int i= 0; i < currentBlockSize; ++i)
-		eigenVectors[kPoint][i].reinit(d_tempEigenVec);
-
+	  flattenedArrayData=d_flattenedArrayRegistry.getFlattenedArrayData(matrix_free_data,
+									    currentBlockSize);
 
-	      vectorTools::createDealiiVector<dataTypes::number>(matrix_free_data.get_vector_partitioner(),
-							         currentBlockSize,
-							         eigenVectorsFlattenedBlock[kPoint]);
+	  for(unsigned int kPoint = 0; kPoint < numSpinComponents*numKPoints; ++kPoint)
+	    {
+	      eigenVectorsFlattenedBlock[kPoint].reinit(flattenedArrayData->partitioner);
 	      eigenVectorsFlattenedBlock[kPoint] = dataTypes::number(0.0);
 	    }
 
-	  constraintsNoneDataInfo.precomputeMaps(matrix_free_data.get_vector_partitioner(),
-						 eigenVectorsFlattenedBlock[0].get_partitioner(),
-						 currentBlockSize);
+	  constraintsNoneDataInfo.precomputeMaps(flattenedArrayData->localIndexMapUnflattenedToFlattened);
 	}
 
       const bool isRotFracEigenVectorsInBlock=
@@ -555,34 +686,29 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
 	      startingIndexFrac=0;
 	    }
 
-	  if (currentBlockSizeFrac!=eigenVectorsRotFrac[0].size() || eigenVectorsRotFrac[0].size()==0)
+	  if (currentBlockSizeFrac!=previousBlockSizeFrac)
 	    {
-	      for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
-		{
-		  eigenVectorsRotFrac[kPoint].resize(currentBlockSizeFrac);
-		  for(unsigned int i= 0; i < currentBlockSizeFrac; ++i)
-		    eigenVectorsRotFrac[kPoint][i].reinit(d_tempEigenVec);
+	      flattenedArrayDataFrac=d_flattenedArrayRegistry.getFlattenedArrayData(matrix_free_data,
+										    currentBlockSizeFrac);
 
-
-		  vectorTools::createDealiiVector<dataTypes::number>
-		    (matrix_free_data.get_vector_partitioner(),
-		     currentBlockSizeFrac,
-		     eigenVectorsRotFracFlattenedBlock[kPoint]);
+	      for(unsigned int kPoint = 0; kPoint < numSpinComponents*numKPoints; ++kPoint)
+		{
+		  eigenVectorsRotFracFlattenedBlock[kPoint].reinit(flattenedArrayDataFrac->partitioner);
 		  eigenVectorsRotFracFlattenedBlock[kPoint] = dataTypes::number(0.0);
 		}
 
-	      constraintsNoneDataInfo2.precomputeMaps(matrix_free_data.get_vector_partitioner(),
-						      eigenVectorsRotFracFlattenedBlock[0].get_partitioner(),
-						      currentBlockSizeFrac);
+	      constraintsNoneDataInfo2.precomputeMaps(flattenedArrayDataFrac->localIndexMapUnflattenedToFlattened);
+	      previousBlockSizeFrac=currentBlockSizeFrac;
 	    }
 	}
 
       if((ivec+currentBlockSize)<=bandGroupLowHighPlusOneIndices[2*bandGroupTaskId+1] &&
 	 (ivec+currentBlockSize)>bandGroupLowHighPlusOneIndices[2*bandGroupTaskId])
 	{
-	  for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
+	  for(unsigned int kPoint = 0; kPoint < numSpinComponents*numKPoints; ++kPoint)
 	    {
-
+	      if (!isSpinChannelOwned(kPoint%numSpinComponents))
+		continue;
 
 	      for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
 		for(unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
@@ -593,35 +719,6 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
 						 currentBlockSize);
 	      eigenVectorsFlattenedBlock[kPoint].update_ghost_values();
 
-#ifdef USE_COMPLEX
-	      vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		(eigenVectorsFlattenedBlock[kPoint],
-		 currentBlockSize,
-		 std::make_pair(0,currentBlockSize),
-		 localProc_dof_indicesReal,
-		 localProc_dof_indicesImag,
-		 eigenVectors[kPoint],
-		 false);
-
-	      //FIXME: The underlying call to update_ghost_values
-	      //is required because currently localProc_dof_indicesReal
-	      //and localProc_dof_indicesImag are only available for
-	      //locally owned nodes. Once they are also made available
-	      //for ghost nodes- use true for the last argument in
-	      //copyFlattenedDealiiVecToSingleCompVec(..) above and supress
-	      //underlying call.
-	      for(unsigned int i= 0; i < currentBlockSize; ++i)
-		eigenVectors[kPoint][i].update_ghost_values();
-#else
-	      vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		(eigenVectorsFlattenedBlock[kPoint],
-		 currentBlockSize,
-		 std::make_pair(0,currentBlockSize),
-		 eigenVectors[kPoint],
-		 true);
-
-#endif
-
 	      if (isRotFracEigenVectorsInBlock)
 		{
 
@@ -635,472 +732,158 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
 		  constraintsNoneDataInfo2.distribute(eigenVectorsRotFracFlattenedBlock[kPoint],
 						      currentBlockSizeFrac);
 		  eigenVectorsRotFracFlattenedBlock[kPoint].update_ghost_values();
-
-#ifdef USE_COMPLEX
-		  vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		    (eigenVectorsRotFracFlattenedBlock[kPoint],
-		     currentBlockSizeFrac,
-		     std::make_pair(0,currentBlockSizeFrac),
-		     localProc_dof_indicesReal,
-		     localProc_dof_indicesImag,
-		     eigenVectorsRotFrac[kPoint],
-		     false);
-
-		  //FIXME: The underlying call to update_ghost_values
-		  //is required because currently localProc_dof_indicesReal
-		  //and localProc_dof_indicesImag are only available for
-		  //locally owned nodes. Once they are also made available
-		  //for ghost nodes- use true for the last argument in
-		  //copyFlattenedDealiiVecToSingleCompVec(..) above and supress
-		  //underlying call.
-		  for(unsigned int i= 0; i < currentBlockSizeFrac; ++i)
-		    eigenVectorsRotFrac[kPoint][i].update_ghost_values();
-#else
-		  vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		    (eigenVectorsRotFracFlattenedBlock[kPoint],
-		     currentBlockSizeFrac,
-		     std::make_pair(0,currentBlockSizeFrac),
-		     eigenVectorsRotFrac[kPoint],
-		     true);
-
-#endif
 		}
 	    }
 
+	  //
+	  //occupancy weights of the real and imaginary parts of each wavefunction in the block.
+	  //For the spectrum split case the density is computed as
+	  //\sum_{core} |psi|^2 + \sum_{frac} (f-1)|psiRotFrac|^2 + |psi|^2
+	  //
+	  const unsigned int numberColumns=numberRealComponents*currentBlockSize;
+	  const unsigned int numberColumnsFrac=numberRealComponents*currentBlockSizeFrac;
+	  std::vector<double> partialOccupancyWeights(numSpinComponents*numKPoints*numberColumns,0.0);
+	  std::vector<double> partialOccupancyWeightsFrac(isRotFracEigenVectorsInBlock?
+							  numSpinComponents*numKPoints*numberColumnsFrac:0,0.0);
+	  for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+	    for(unsigned int spinIndex = 0; spinIndex < numSpinComponents; ++spinIndex)
+	      for(unsigned int iEigenVec=0; iEigenVec<currentBlockSize; ++iEigenVec)
+		{
+		  const double eigenValue=eigenValues[kPoint][ivec+iEigenVec
+							      +spinIndex*numEigenVectorsTotal];
+		  double partialOccupancy=dftUtils::getPartialOccupancy
+		    (eigenValue,
+		     fermiEnergy,
+		     C_kb,
+		     dftParameters::TVal);
+
+		  if(dftParameters::constraintMagnetization)
+		    partialOccupancy=(eigenValue>(spinIndex==0?fermiEnergyUp:fermiEnergyDown))?0.0:1.0;
+
 #ifdef USE_COMPLEX
-	  std::vector<Tensor<1,2,VectorizedArray<double> > > psiQuads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor1);
-	  std::vector<Tensor<1,2,VectorizedArray<double> > > psiQuads2(numQuadPoints*currentBlockSize*numKPoints,zeroTensor1);
-	  std::vector<Tensor<1,2,Tensor<1,3,VectorizedArray<double> > > > gradPsiQuads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor2);
-	  std::vector<Tensor<1,2,Tensor<1,3,VectorizedArray<double> > > > gradPsiQuads2(numQuadPoints*currentBlockSize*numKPoints,zeroTensor2);
-
-	  std::vector<Tensor<1,2,VectorizedArray<double> > > psiRotFracQuads(numQuadPoints*currentBlockSizeFrac*numKPoints,zeroTensor1);
-	  std::vector<Tensor<1,2,VectorizedArray<double> > > psiRotFracQuads2(numQuadPoints*currentBlockSizeFrac*numKPoints,zeroTensor1);
-	  std::vector<Tensor<1,2,Tensor<1,3,VectorizedArray<double> > > > gradPsiRotFracQuads(numQuadPoints*currentBlockSizeFrac*numKPoints,zeroTensor2);
-	  std::vector<Tensor<1,2,Tensor<1,3,VectorizedArray<double> > > > gradPsiRotFracQuads2(numQuadPoints*currentBlockSizeFrac*numKPoints,zeroTensor2);
+		  const double scalingFactor=(dftParameters::spinPolarized==1?1.0:2.0)*d_kPointWeights[kPoint];
 #else
-	  std::vector< VectorizedArray<double> > psiQuads(numQuadPoints*currentBlockSize,make_vectorized_array(0.0));
-	  std::vector< VectorizedArray<double> > psiQuads2(numQuadPoints*currentBlockSize,make_vectorized_array(0.0));
-	  std::vector<Tensor<1,3,VectorizedArray<double> > > gradPsiQuads(numQuadPoints*currentBlockSize,zeroTensor3);
-	  std::vector<Tensor<1,3,VectorizedArray<double> > > gradPsiQuads2(numQuadPoints*currentBlockSize,zeroTensor3);
-
-	  std::vector< VectorizedArray<double> > psiRotFracQuads(numQuadPoints*currentBlockSizeFrac,make_vectorized_array(0.0));
-	  std::vector< VectorizedArray<double> > psiRotFracQuads2(numQuadPoints*currentBlockSizeFrac,make_vectorized_array(0.0));
-	  std::vector<Tensor<1,3,VectorizedArray<double> > > gradPsiRotFracQuads(numQuadPoints*currentBlockSizeFrac,zeroTensor3);
-	  std::vector<Tensor<1,3,VectorizedArray<double> > > gradPsiRotFracQuads2(numQuadPoints*currentBlockSizeFrac,zeroTensor3);
+		  const double scalingFactor=(dftParameters::spinPolarized==1?1.0:2.0);
 #endif
+		  const bool isRotFracEigenVector=isRotFracEigenVectorsInBlock && iEigenVec>=startingIndexFrac;
 
-	  for (unsigned int cell=0; cell<matrix_free_data.n_macro_cells(); ++cell)
-	    {
-
-              lobattoNodesFlag?psiEvalRefined.reinit(cell):psiEval.reinit(cell);
-
-	      const unsigned int numSubCells=matrix_free_data.n_components_filled(cell);
-
-	      for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
-		for(unsigned int iEigenVec=0; iEigenVec<currentBlockSize; ++iEigenVec)
-		  {
-
-                    lobattoNodesFlag?psiEvalRefined.read_dof_values_plain(eigenVectors[(1+dftParameters::spinPolarized)*kPoint][iEigenVec]):psiEval.read_dof_values_plain(eigenVectors[(1+dftParameters::spinPolarized)*kPoint][iEigenVec]);
+		  for(unsigned int icomp=0; icomp<numberRealComponents; ++icomp)
+		    {
+		      partialOccupancyWeights[(numSpinComponents*kPoint+spinIndex)*numberColumns
+					      +numberRealComponents*iEigenVec+icomp]
+			=isRotFracEigenVector?scalingFactor:scalingFactor*partialOccupancy;
+
+		      if(isRotFracEigenVector)
+			partialOccupancyWeightsFrac[(numSpinComponents*kPoint+spinIndex)*numberColumnsFrac
+						    +numberRealComponents*(iEigenVec-startingIndexFrac)+icomp]
+			  =scalingFactor*(partialOccupancy-1.0);
+		    }
+		}
 
-		    if(isEvaluateGradRho)
-		      lobattoNodesFlag?psiEvalRefined.evaluate(true,true):psiEval.evaluate(true,true);
-		    else
-		      lobattoNodesFlag?psiEvalRefined.evaluate(true,false):psiEval.evaluate(true,false);
+	  std::vector<double> cellWaveFunctionMatrix(numNodesPerElement*numberColumns);
+	  std::vector<double> psiQuads(numQuadPoints*numberColumns);
+	  std::vector<double> gradPsiRefQuads(isEvaluateGradRho?3*numQuadPoints*numberColumns:0);
 
-		    for (unsigned int q=0; q<numQuadPoints; ++q)
-		      {
-			psiQuads[q*currentBlockSize*numKPoints+currentBlockSize*kPoint+iEigenVec]=lobattoNodesFlag?psiEvalRefined.get_value(q):psiEval.get_value(q);
-			if(isEvaluateGradRho)
-			  gradPsiQuads[q*currentBlockSize*numKPoints+currentBlockSize*kPoint+iEigenVec]=lobattoNodesFlag?psiEvalRefined.get_gradient(q):psiEval.get_gradient(q);
-		      }
+	  std::vector<double> cellWaveFunctionMatrixFrac(isRotFracEigenVectorsInBlock?numNodesPerElement*numberColumnsFrac:0);
+	  std::vector<double> psiRotFracQuads(isRotFracEigenVectorsInBlock?numQuadPoints*numberColumnsFrac:0);
+	  std::vector<double> gradPsiRotFracRefQuads((isRotFracEigenVectorsInBlock && isEvaluateGradRho)?
+						     3*numQuadPoints*numberColumnsFrac:0);
 
-		    if(dftParameters::spinPolarized==1)
-		      {
+	  unsigned int iElem=0;
+	  for (unsigned int iMacroCell=0; iMacroCell<matrix_free_data.n_macro_cells(); ++iMacroCell)
+	    {
+	      const unsigned int numSubCells=matrix_free_data.n_components_filled(iMacroCell);
+	      for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell, ++iElem)
+		{
+		  const typename DoFHandler<3>::active_cell_iterator subCellPtr=matrix_free_data.get_cell_iterator(iMacroCell,iSubCell);
+		  const dealii::CellId subCellId=subCellPtr->id();
 
-                        lobattoNodesFlag?psiEvalRefined.read_dof_values_plain
-			  (eigenVectors[(1+dftParameters::spinPolarized)*kPoint+1][iEigenVec]):psiEval.read_dof_values_plain
-			  (eigenVectors[(1+dftParameters::spinPolarized)*kPoint+1][iEigenVec]);
-
-			if(isEvaluateGradRho)
-                          lobattoNodesFlag?psiEvalRefined.evaluate(true,true):psiEval.evaluate(true,true);
-			else
-                          lobattoNodesFlag?psiEvalRefined.evaluate(true,false):psiEval.evaluate(true,false);
-			 
-
-			for (unsigned int q=0; q<numQuadPoints; ++q)
-			  {
-			    psiQuads2[q*currentBlockSize*numKPoints+currentBlockSize*kPoint+iEigenVec]=lobattoNodesFlag?psiEvalRefined.get_value(q):psiEval.get_value(q);
-			    if(isEvaluateGradRho)
-			      gradPsiQuads2[q*currentBlockSize*numKPoints+currentBlockSize*kPoint+iEigenVec]= lobattoNodesFlag?psiEvalRefined.get_gradient(q):psiEval.get_gradient(q);
-			  }
-		      }
+		  std::fill(rhoTemp.begin(),rhoTemp.end(),0.0);
+		  if(isEvaluateGradRho)
+		    std::fill(gradRhoRefTemp.begin(),gradRhoRefTemp.end(),0.0);
 
-		    if (isRotFracEigenVectorsInBlock && iEigenVec>=startingIndexFrac)
+		  for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+		    for(unsigned int spinIndex = 0; spinIndex < numSpinComponents; ++spinIndex)
 		      {
-
-			const unsigned int vectorIndex=iEigenVec-startingIndexFrac;
-
-			lobattoNodesFlag?psiEvalRefined.read_dof_values_plain(eigenVectorsRotFrac[(1+dftParameters::spinPolarized)*kPoint][vectorIndex]):psiEval.read_dof_values_plain(eigenVectorsRotFrac[(1+dftParameters::spinPolarized)*kPoint][vectorIndex]);
-
-
-			if(isEvaluateGradRho)
-			  lobattoNodesFlag?psiEvalRefined.evaluate(true,true):psiEval.evaluate(true,true);
-			else
-			  lobattoNodesFlag?psiEvalRefined.evaluate(true,false):psiEval.evaluate(true,false);
-
-			for (unsigned int q=0; q<numQuadPoints; ++q)
-			  {
-			    psiRotFracQuads[q*currentBlockSizeFrac*numKPoints
-					    +currentBlockSizeFrac*kPoint+vectorIndex]=lobattoNodesFlag?psiEvalRefined.get_value(q):psiEval.get_value(q);
-			    if(isEvaluateGradRho)
-			      gradPsiRotFracQuads[q*currentBlockSizeFrac*numKPoints
-						  +currentBlockSizeFrac*kPoint+vectorIndex]=lobattoNodesFlag?psiEvalRefined.get_gradient(q):psiEval.get_gradient(q);
-			  }
-
-			if(dftParameters::spinPolarized==1)
-			  {
-
-			    lobattoNodesFlag?psiEvalRefined.read_dof_values_plain(eigenVectorsRotFrac[(1+dftParameters::spinPolarized)*kPoint+1][vectorIndex]):psiEval.read_dof_values_plain(eigenVectorsRotFrac[(1+dftParameters::spinPolarized)*kPoint+1][vectorIndex]);
-
-
-			    if(isEvaluateGradRho)
-			      lobattoNodesFlag?psiEvalRefined.evaluate(true,true):psiEval.evaluate(true,true);
-			    else
-			      lobattoNodesFlag?psiEvalRefined.evaluate(true,false):psiEval.evaluate(true,false);
-
-			    for (unsigned int q=0; q<numQuadPoints; ++q)
-			      {
-				psiRotFracQuads2[q*currentBlockSizeFrac*numKPoints
-						 +currentBlockSizeFrac*kPoint+vectorIndex]=lobattoNodesFlag?psiEvalRefined.get_value(q):psiEval.get_value(q);
-				if(isEvaluateGradRho)
-				  gradPsiRotFracQuads2[q*currentBlockSizeFrac*numKPoints
-						       +currentBlockSizeFrac*kPoint+vectorIndex]=lobattoNodesFlag?psiEvalRefined.get_gradient(q):psiEval.get_gradient(q);
-			      }
-			  }
+			//the density of the other spin channel is added by the spin group owning it
+			if (!isSpinChannelOwned(spinIndex))
+			  continue;
+
+			const unsigned int blockIndex=numSpinComponents*kPoint+spinIndex;
+
+			internal::accumulateCellDensityFromFlattenedBlock
+			  (reinterpret_cast<const double*>(eigenVectorsFlattenedBlock[blockIndex].begin()),
+			   &flattenedArrayData->macroCellLocalProcIndexIdMap[iElem*numNodesPerElement],
+			   numberRealComponents,
+			   numberColumns,
+			   numNodesPerElement,
+			   numQuadPoints,
+			   shapeValueTable,
+			   shapeGradRefTable,
+			   &partialOccupancyWeights[blockIndex*numberColumns],
+			   isEvaluateGradRho,
+			   cellWaveFunctionMatrix,
+			   psiQuads,
+			   gradPsiRefQuads,
+			   &rhoTemp[spinIndex*numQuadPoints],
+			   &gradRhoRefTemp[3*spinIndex*numQuadPoints]);
+
+			if (isRotFracEigenVectorsInBlock)
+			  internal::accumulateCellDensityFromFlattenedBlock
+			    (reinterpret_cast<const double*>(eigenVectorsRotFracFlattenedBlock[blockIndex].begin()),
+			     &flattenedArrayDataFrac->macroCellLocalProcIndexIdMap[iElem*numNodesPerElement],
+			     numberRealComponents,
+			     numberColumnsFrac,
+			     numNodesPerElement,
+			     numQuadPoints,
+			     shapeValueTable,
+			     shapeGradRefTable,
+			     &partialOccupancyWeightsFrac[blockIndex*numberColumnsFrac],
+			     isEvaluateGradRho,
+			     cellWaveFunctionMatrixFrac,
+			     psiRotFracQuads,
+			     gradPsiRotFracRefQuads,
+			     &rhoTemp[spinIndex*numQuadPoints],
+			     &gradRhoRefTemp[3*spinIndex*numQuadPoints]);
 		      }
 
-		  }//eigenvector per k point
-
-	      for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
-		{
-		  const dealii::CellId subCellId=matrix_free_data.get_cell_iterator(cell,iSubCell)->id();
-
-		  std::fill(rhoTemp.begin(),rhoTemp.end(),0.0); std::fill(rho.begin(),rho.end(),0.0);
-
-		  if (dftParameters::spinPolarized==1)
-		    std::fill(rhoTempSpinPolarized.begin(),rhoTempSpinPolarized.end(),0.0);
-
 		  if(isEvaluateGradRho)
-		    {
-		      std::fill(gradRhoTemp.begin(),gradRhoTemp.end(),0.0);
-		      if (dftParameters::spinPolarized==1)
-			std::fill(gradRhoTempSpinPolarized.begin(),gradRhoTempSpinPolarized.end(),0.0);
-		    }
+		    feValuesInverseJacobians.reinit(subCellPtr);
 
-		  for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+		  for (unsigned int q=0; q<numQuadPoints; ++q)
 		    {
-		      for(unsigned int iEigenVec=0; iEigenVec<currentBlockSize; ++iEigenVec)
+		      Tensor<1,3,double> gradRhoQuad[2];
+		      if(isEvaluateGradRho)
 			{
+			  const DerivativeForm<1,3,3> & inverseJacobian=feValuesInverseJacobians.inverse_jacobian(q);
+			  for(unsigned int spinIndex = 0; spinIndex < numSpinComponents; ++spinIndex)
+			    for (unsigned int jdim=0; jdim<3; ++jdim)
+			      for (unsigned int idim=0; idim<3; ++idim)
+				gradRhoQuad[spinIndex][jdim]+=inverseJacobian[idim][jdim]
+				  *gradRhoRefTemp[3*spinIndex*numQuadPoints+3*q+idim];
+			}
 
-			  double partialOccupancy=dftUtils::getPartialOccupancy
-			    (eigenValues[kPoint][ivec+iEigenVec],
-			     fermiEnergy,
-			     C_kb,
-			     dftParameters::TVal);
-
-			  double partialOccupancy2=dftUtils::getPartialOccupancy
-			    (eigenValues[kPoint][ivec+iEigenVec
-						 +dftParameters::spinPolarized*numEigenVectorsTotal],
-			     fermiEnergy,
-			     C_kb,
-			     dftParameters::TVal);
-			  if(dftParameters::constraintMagnetization)
-			    {
-			      partialOccupancy = 1.0 , partialOccupancy2 = 1.0 ;
-			      if (eigenValues[kPoint][ivec+iEigenVec
-						      +dftParameters::spinPolarized*numEigenVectorsTotal] > fermiEnergyDown)
-				partialOccupancy2 = 0.0 ;
-			      if (eigenValues[kPoint][ivec+iEigenVec] > fermiEnergyUp)
-				partialOccupancy = 0.0 ;
-
-			    }
-
-			  for(unsigned int q=0; q<numQuadPoints; ++q)
-			    {
-			      const unsigned int id=q*currentBlockSize*numKPoints+currentBlockSize*kPoint+iEigenVec;
-#ifdef USE_COMPLEX
-			      Vector<double> psi, psi2;
-			      psi.reinit(2); psi2.reinit(2);
-
-			      psi(0)= psiQuads[id][0][iSubCell];
-			      psi(1)=psiQuads[id][1][iSubCell];
-
-			      if(dftParameters::spinPolarized==1)
-				{
-				  psi2(0)=psiQuads2[id][0][iSubCell];
-				  psi2(1)=psiQuads2[id][1][iSubCell];
-				}
-
-			      std::vector<Tensor<1,3,double> > gradPsi(2),gradPsi2(2);
-
-			      if(isEvaluateGradRho)
-				for(unsigned int idim=0; idim<3; ++idim)
-				  {
-				    gradPsi[0][idim]=gradPsiQuads[id][0][idim][iSubCell];
-				    gradPsi[1][idim]=gradPsiQuads[id][1][idim][iSubCell];
-
-				    if(dftParameters::spinPolarized==1)
-				      {
-					gradPsi2[0][idim]=gradPsiQuads2[id][0][idim][iSubCell];
-					gradPsi2[1][idim]=gradPsiQuads2[id][1][idim][iSubCell];
-				      }
-				  }
-#else
-			      double psi, psi2;
-			      psi=psiQuads[id][iSubCell];
-			      if (dftParameters::spinPolarized==1)
-				psi2=psiQuads2[id][iSubCell];
-
-			      Tensor<1,3,double> gradPsi,gradPsi2;
-			      if(isEvaluateGradRho)
-				for(unsigned int idim=0; idim<3; ++idim)
-				  {
-				    gradPsi[idim]=gradPsiQuads[id][idim][iSubCell];
-				    if(dftParameters::spinPolarized==1)
-				      gradPsi2[idim]=gradPsiQuads2[id][idim][iSubCell];
-				  }
-
-#endif
-
-			      if (isRotFracEigenVectorsInBlock && iEigenVec>=startingIndexFrac)
-				{
-				  const unsigned int idFrac=q*currentBlockSizeFrac*numKPoints
-				    +currentBlockSizeFrac*kPoint
-				    +iEigenVec-startingIndexFrac;
-#ifdef USE_COMPLEX
-				  Vector<double> psiRotFrac, psiRotFrac2;
-				  psiRotFrac.reinit(2); psiRotFrac2.reinit(2);
-
-				  psiRotFrac(0)= psiRotFracQuads[idFrac][0][iSubCell];
-				  psiRotFrac(1)=psiRotFracQuads[idFrac][1][iSubCell];
-
-				  if(dftParameters::spinPolarized==1)
-				    {
-				      psiRotFrac2(0)=psiRotFracQuads2[idFrac][0][iSubCell];
-				      psiRotFrac2(1)=psiRotFracQuads2[idFrac][1][iSubCell];
-				    }
-
-				  std::vector<Tensor<1,3,double> > gradPsiRotFrac(2),gradPsiRotFrac2(2);
-
-				  if(isEvaluateGradRho)
-				    for(unsigned int idim=0; idim<3; ++idim)
-				      {
-					gradPsiRotFrac[0][idim]
-					  =gradPsiRotFracQuads[idFrac][0][idim][iSubCell];
-					gradPsiRotFrac[1][idim]
-					  =gradPsiRotFracQuads[idFrac][1][idim][iSubCell];
-
-					if(dftParameters::spinPolarized==1)
-					  {
-					    gradPsiRotFrac2[0][idim]
-					      =gradPsiRotFracQuads2[idFrac][0][idim][iSubCell];
-					    gradPsiRotFrac2[1][idim]
-					      =gradPsiRotFracQuads2[idFrac][1][idim][iSubCell];
-					  }
-				      }
-#else
-				  double psiRotFrac, psiRotFrac2;
-				  psiRotFrac=psiRotFracQuads[idFrac][iSubCell];
-				  if (dftParameters::spinPolarized==1)
-				    psiRotFrac2=psiRotFracQuads2[idFrac][iSubCell];
-
-				  Tensor<1,3,double> gradPsiRotFrac,gradPsiRotFrac2;
-				  if(isEvaluateGradRho)
-				    for(unsigned int idim=0; idim<3; ++idim)
-				      {
-					gradPsiRotFrac[idim]
-					  =gradPsiRotFracQuads[idFrac][idim][iSubCell];
-					if(dftParameters::spinPolarized==1)
-					  gradPsiRotFrac2[idim]
-					    =gradPsiRotFracQuads2[idFrac][idim][iSubCell];
-				      }
-
-#endif
-
-#ifdef USE_COMPLEX
-				  if(dftParameters::spinPolarized==1)
-				    {
-				      rhoTempSpinPolarized[2*q]
-					+=
-					d_kPointWeights[kPoint]
-					*(partialOccupancy*(psiRotFrac(0)*psiRotFrac(0)
-							    + psiRotFrac(1)*psiRotFrac(1))
-					  -(psiRotFrac(0)*psiRotFrac(0)
-					    + psiRotFrac(1)*psiRotFrac(1))
-					  +(psi(0)*psi(0) + psi(1)*psi(1)));
-
-				      rhoTempSpinPolarized[2*q+1]
-					+=
-					d_kPointWeights[kPoint]
-					*(partialOccupancy2*(psiRotFrac2(0)*psiRotFrac2(0)
-							     + psiRotFrac2(1)*psiRotFrac2(1))
-					  -(psiRotFrac2(0)*psiRotFrac2(0)
-					    + psiRotFrac2(1)*psiRotFrac2(1))
-					  +(psi2(0)*psi2(0)+ psi2(1)*psi2(1)));
-				      //
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  {
-					    gradRhoTempSpinPolarized[6*q + idim]
-					      += 2.0*d_kPointWeights[kPoint]
-					      *(partialOccupancy*(psiRotFrac(0)*gradPsiRotFrac[0][idim]
-								  + psiRotFrac(1)*gradPsiRotFrac[1][idim])
-						-(psiRotFrac(0)*gradPsiRotFrac[0][idim]
-						  + psiRotFrac(1)*gradPsiRotFrac[1][idim])
-						+(psi(0)*gradPsi[0][idim] + psi(1)*gradPsi[1][idim]));
-					    gradRhoTempSpinPolarized[6*q + 3+idim]
-					      += 2.0*d_kPointWeights[kPoint]
-					      *(partialOccupancy2*(psiRotFrac2(0)*gradPsiRotFrac2[0][idim]
-								   + psiRotFrac2(1)*gradPsiRotFrac2[1][idim])
-						-(psiRotFrac2(0)*gradPsiRotFrac2[0][idim]
-						  + psiRotFrac2(1)*gradPsiRotFrac2[1][idim])
-						+(psi2(0)*gradPsi2[0][idim] + psi2(1)*gradPsi2[1][idim]));
-					  }
-				    }
-				  else
-				    {
-				      rhoTemp[q] += 2.0*d_kPointWeights[kPoint]
-					*(partialOccupancy*(psiRotFrac(0)*psiRotFrac(0)
-							    + psiRotFrac(1)*psiRotFrac(1))
-					  -(psiRotFrac(0)*psiRotFrac(0)
-					    + psiRotFrac(1)*psiRotFrac(1))
-					  +(psi(0)*psi(0) + psi(1)*psi(1)));
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  gradRhoTemp[3*q + idim]
-					    += 2.0*2.0*d_kPointWeights[kPoint]
-					    *(partialOccupancy*(psiRotFrac(0)*gradPsiRotFrac[0][idim]
-								+ psiRotFrac(1)*gradPsiRotFrac[1][idim])
-					      -(psiRotFrac(0)*gradPsiRotFrac[0][idim]
-						+ psiRotFrac(1)*gradPsiRotFrac[1][idim])
-					      +(psi(0)*gradPsi[0][idim] + psi(1)*gradPsi[1][idim]));
-				    }
-#else
-				  if(dftParameters::spinPolarized==1)
-				    {
-				      rhoTempSpinPolarized[2*q] += (partialOccupancy*psiRotFrac*psiRotFrac
-								    -psiRotFrac*psiRotFrac
-								    +psi*psi);
-				      rhoTempSpinPolarized[2*q+1] +=(partialOccupancy2*psiRotFrac2*psiRotFrac2
-								     -psiRotFrac2*psiRotFrac2
-								     +psi2*psi2);
-
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  {
-					    gradRhoTempSpinPolarized[6*q + idim]
-					      += 2.0*(partialOccupancy*psiRotFrac*gradPsiRotFrac[idim]
-						      -psiRotFrac*gradPsiRotFrac[idim]
-						      +psi*gradPsi[idim]);
-					    gradRhoTempSpinPolarized[6*q + 3+idim]
-					      +=  2.0*(partialOccupancy2*psiRotFrac2*gradPsiRotFrac2[idim]
-						       -psiRotFrac2*gradPsiRotFrac2[idim]
-						       +psi2*gradPsi2[idim]);
-					  }
-				    }
-				  else
-				    {
-				      rhoTemp[q] += 2.0*(partialOccupancy*psiRotFrac*psiRotFrac
-							 -psiRotFrac*psiRotFrac
-							 +psi*psi);
-
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  gradRhoTemp[3*q + idim]
-					    += 2.0*2.0*(partialOccupancy*psiRotFrac*gradPsiRotFrac[idim]
-							-psiRotFrac*gradPsiRotFrac[idim]
-							+psi*gradPsi[idim]);
-				    }
-
-#endif
-
-				}
-			      else
-				{
-#ifdef USE_COMPLEX
-				  if(dftParameters::spinPolarized==1)
-				    {
-				      rhoTempSpinPolarized[2*q] += partialOccupancy*d_kPointWeights[kPoint]*(psi(0)*psi(0) + psi(1)*psi(1));
-				      rhoTempSpinPolarized[2*q+1] += partialOccupancy2*d_kPointWeights[kPoint]*(psi2(0)*psi2(0) + psi2(1)*psi2(1));
-				      //
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  {
-					    gradRhoTempSpinPolarized[6*q + idim] +=
-					      2.0*partialOccupancy*d_kPointWeights[kPoint]*(psi(0)*gradPsi[0][idim] + psi(1)*gradPsi[1][idim]);
-					    gradRhoTempSpinPolarized[6*q + 3+idim] +=
-					      2.0*partialOccupancy2*d_kPointWeights[kPoint]*(psi2(0)*gradPsi2[0][idim] + psi2(1)*gradPsi2[1][idim]);
-					  }
-				    }
-				  else
-				    {
-				      rhoTemp[q] += 2.0*partialOccupancy*d_kPointWeights[kPoint]*(psi(0)*psi(0) + psi(1)*psi(1));
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  gradRhoTemp[3*q + idim] += 2.0*2.0*partialOccupancy*d_kPointWeights[kPoint]*(psi(0)*gradPsi[0][idim] + psi(1)*gradPsi[1][idim]);
-				    }
-#else
-				  if(dftParameters::spinPolarized==1)
-				    {
-				      rhoTempSpinPolarized[2*q] += partialOccupancy*psi*psi;
-				      rhoTempSpinPolarized[2*q+1] += partialOccupancy2*psi2*psi2;
-
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  {
-					    gradRhoTempSpinPolarized[6*q + idim] += 2.0*partialOccupancy*(psi*gradPsi[idim]);
-					    gradRhoTempSpinPolarized[6*q + 3+idim] +=  2.0*partialOccupancy2*(psi2*gradPsi2[idim]);
-					  }
-				    }
-				  else
-				    {
-				      rhoTemp[q] += 2.0*partialOccupancy*psi*psi;
-
-				      if(isEvaluateGradRho)
-					for(unsigned int idim=0; idim<3; ++idim)
-					  gradRhoTemp[3*q + idim] += 2.0*2.0*partialOccupancy*psi*gradPsi[idim];
-				    }
-
-#endif
-				}
-
-			    }//quad point loop
-			}//block eigenvectors per k point
-		    }
-
-		  for (unsigned int q=0; q<numQuadPoints; ++q)
-		    {
 		      if(dftParameters::spinPolarized==1)
 			{
-			  (*_rhoValuesSpinPolarized)[subCellId][2*q]+=rhoTempSpinPolarized[2*q];
-			  (*_rhoValuesSpinPolarized)[subCellId][2*q+1]+=rhoTempSpinPolarized[2*q+1];
+			  (*_rhoValuesSpinPolarized)[subCellId][2*q]+=rhoTemp[q];
+			  (*_rhoValuesSpinPolarized)[subCellId][2*q+1]+=rhoTemp[numQuadPoints+q];
 
 			  if(isEvaluateGradRho)
 			    for(unsigned int idim=0; idim<3; ++idim)
 			      {
 				(*_gradRhoValuesSpinPolarized)[subCellId][6*q+idim]
-				  +=gradRhoTempSpinPolarized[6*q + idim];
+				  +=gradRhoQuad[0][idim];
 				(*_gradRhoValuesSpinPolarized)[subCellId][6*q+3+idim]
-				  +=gradRhoTempSpinPolarized[6*q + 3+idim];
+				  +=gradRhoQuad[1][idim];
 			      }
 
-			  (*_rhoValues)[subCellId][q]+= rhoTempSpinPolarized[2*q] + rhoTempSpinPolarized[2*q+1];
+			  (*_rhoValues)[subCellId][q]+= rhoTemp[q] + rhoTemp[numQuadPoints+q];
 
 			  if(isEvaluateGradRho)
 			    for(unsigned int idim=0; idim<3; ++idim)
 			      (*_gradRhoValues)[subCellId][3*q + idim]
-				+= gradRhoTempSpinPolarized[6*q + idim]
-				+ gradRhoTempSpinPolarized[6*q + 3+idim];
+				+= gradRhoQuad[0][idim]
+				+ gradRhoQuad[1][idim];
 			}
 		      else
 			{
@@ -1108,7 +891,7 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
 
 			  if(isEvaluateGradRho)
 			    for(unsigned int idim=0; idim<3; ++idim)
-			      (*_gradRhoValues)[subCellId][3*q+idim]+= gradRhoTemp[3*q+idim];
+			      (*_gradRhoValues)[subCellId][3*q+idim]+= gradRhoQuad[0][idim];
 			}
 		    }
 		}//subcell loop
@@ -1130,4 +913,11 @@ void dftClass<FEOrder>::computeRhoFromPSI(std::map<dealii::CellId, std::vector<d
 	     _gradRhoValuesSpinPolarized,
 	     isEvaluateGradRho,
 	     interpoolcomm);
+
+  sumRhoData(_rhoValues,
+	     _gradRhoValues,
+	     _rhoValuesSpinPolarized,
+	     _gradRhoValuesSpinPolarized,
+	     isEvaluateGradRho,
+	     interSpinGroupComm);
 }
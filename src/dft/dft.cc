@@ -26,11 +26,16 @@
 #include <symmetry.h>
 #include <geoOptIon.h>
 #include <geoOptCell.h>
+#include <geoOptIonCell.h>
+#include <molecularDynamics.h>
+#include <perturbedGeometryForces.h>
 #include <meshMovementGaussian.h>
 #include <meshMovementAffineTransform.h>
 #include <fileReaders.h>
 #include <dftParameters.h>
 #include <dftUtils.h>
+#include <performanceTelemetry.h>
+#include <memoryLedger.h>
 #include <chebyshevOrthogonalizedSubspaceIterationSolver.h>
 #include <complex>
 #include <cmath>
@@ -70,6 +75,9 @@ namespace dftfe {
 #include "initPseudo-OV.cc"
 #include "femUtilityFunctions.cc"
 #include "initRho.cc"
+#include "groundStateExtrapolation.cc"
+#include "kPointLoadBalancing.cc"
+#include "spinGroupParallelization.cc"
 #include "dos.cc"
 #include "localizationLength.cc"
 #include "publicMethods.cc"
@@ -85,6 +93,8 @@ namespace dftfe {
 #include "moveAtoms.cc"
 #include "restart.cc"
 #include "nscf.cc"
+#include "ensemble.cc"
+#include "memoryAccounting.cc"
 #include "electrostaticHRefinedEnergy.cc"
 #include "electrostaticPRefinedEnergy.cc"
 
@@ -94,7 +104,8 @@ namespace dftfe {
   template<unsigned int FEOrder>
   dftClass<FEOrder>::dftClass(const MPI_Comm & mpi_comm_replica,
 	                      const MPI_Comm &_interpoolcomm,
-			      const MPI_Comm & _interBandGroupComm):
+			      const MPI_Comm & _interBandGroupComm,
+			      const MPI_Comm & _interSpinGroupComm):
     FE (FE_Q<3>(QGaussLobatto<1>(FEOrder+1)), 1),
 #ifdef USE_COMPLEX
     FEEigen (FE_Q<3>(QGaussLobatto<1>(FEOrder+1)), 2),
@@ -104,15 +115,21 @@ namespace dftfe {
     mpi_communicator (mpi_comm_replica),
     interpoolcomm (_interpoolcomm),
     interBandGroupComm(_interBandGroupComm),
+    interSpinGroupComm(_interSpinGroupComm),
     n_mpi_processes (Utilities::MPI::n_mpi_processes(mpi_comm_replica)),
     this_mpi_process (Utilities::MPI::this_mpi_process(mpi_comm_replica)),
     numElectrons(0),
     numLevels(0),
     d_autoMesh(1),
+    d_maxChebyshevFilterPassesPerScfIter(100),
+    d_isGroundStateExtrapolationPending(false),
+    d_isGroundStateGuessExtrapolated(false),
     d_mesh(mpi_comm_replica,_interpoolcomm,_interBandGroupComm,FEOrder),
     d_affineTransformMesh(mpi_comm_replica),
     d_gaussianMovePar(mpi_comm_replica),
     d_vselfBinsManager(mpi_comm_replica),
+    d_vselfBinsManagerHRefined(mpi_comm_replica),
+    d_isHRefinedElectrostaticsMeshCached(false),
     pcout (std::cout, (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)),
     computing_timer (mpi_comm_replica,
 	             pcout,
@@ -128,9 +145,14 @@ namespace dftfe {
     forcePtr= new forceClass<FEOrder>(this, mpi_comm_replica);
     symmetryPtr= new symmetryClass<FEOrder>(this, mpi_comm_replica, _interpoolcomm);
     geoOptIonPtr= new geoOptIon<FEOrder>(this, mpi_comm_replica);
+    molecularDynamicsPtr= new molecularDynamics<FEOrder>(this, mpi_comm_replica);
+    perturbedGeometryForcesPtr= new perturbedGeometryForces<FEOrder>(this, mpi_comm_replica);
+    performanceTelemetry::registerTimer("dftClass",
+					computing_timer);
 
 #ifdef USE_COMPLEX
     geoOptCellPtr= new geoOptCell<FEOrder>(this, mpi_comm_replica);
+    geoOptIonCellPtr= new geoOptIonCell<FEOrder>(this, mpi_comm_replica);
 #endif
 
 #ifdef DFTFE_WITH_ELPA
@@ -146,12 +168,16 @@ namespace dftfe {
   template<unsigned int FEOrder>
   dftClass<FEOrder>::~dftClass()
   {
+    performanceTelemetry::deregisterTimer(computing_timer);
     delete symmetryPtr;
     matrix_free_data.clear();
     delete forcePtr;
     delete geoOptIonPtr;
+    delete molecularDynamicsPtr;
+    delete perturbedGeometryForcesPtr;
 #ifdef USE_COMPLEX
     delete geoOptCellPtr;
+    delete geoOptIonCellPtr;
 #endif
 
 #ifdef DFTFE_WITH_ELPA
@@ -224,6 +250,14 @@ namespace dftfe {
     if (dftParameters::verbosity>=4)
       dftUtils::printCurrentMemoryUsage(mpi_communicator,
 			      "Entered call to set");
+
+    //
+    //the single atom electron-density splines used in the ground-state extrapolation depend on the atom types,
+    //which can change if set is called again for a different atomic system
+    //
+    d_atomicRhoSplines.clear();
+    d_atomicRhoOuterMostPoint.clear();
+
     //
     //read coordinates
     //
@@ -433,8 +467,9 @@ namespace dftfe {
 	pcout<<std::endl<<"Reading Pseudo-potential data for each atom from the list given in : " <<dftParameters::pseudoPotentialFile<<std::endl;
       }
 
-    if(Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0 && dftParameters::isPseudopotential == true)
+    if(Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0 && dftParameters::isPseudopotential == true && !d_isPseudoPotentialFilesConverted)
       pseudoUtils::convert(dftParameters::pseudoPotentialFile);
+    d_isPseudoPotentialFilesConverted=true;
 
     MPI_Barrier(MPI_COMM_WORLD);
     computingTimerStandard.exit_section("Atomic system initialization");
@@ -468,6 +503,72 @@ namespace dftfe {
     //exit(0);
   }
 
+  //compute cell cost weights for repartitioning
+  template<unsigned int FEOrder>
+  double dftClass<FEOrder>::computeCellCostWeights(const parallel::distributed::Triangulation<3> & triangulation,
+						   std::map<dealii::CellId,unsigned int> & cellWeights) const
+  {
+    cellWeights.clear();
+
+    //
+    //The local part of HX is a dense cell matrix times wavefunctions block product costing
+    //nodesPerCell^2 flops per wavefunction, while the nonlocal part costs 2*nodesPerCell*numberProjectors
+    //flops per wavefunction for the projector kets of all the atoms in the cell compact support
+    //
+    const unsigned int nodesPerCell=FE.dofs_per_cell;
+    const double defaultCellWeight=1000.0;
+    const unsigned int numberGlobalCharges=atomLocations.size();
+    const unsigned int numberNonLocalAtoms=d_nonLocalAtomGlobalChargeIds.size();
+
+    //
+    //outermost projector radius of each nonlocal atom
+    //
+    std::vector<double> projectorCutOffRadii(numberNonLocalAtoms,0.0);
+    unsigned int cumulativeWaveFunctionId=0;
+    for (unsigned int iAtom=0; iAtom<numberNonLocalAtoms; ++iAtom)
+      for (unsigned int iPsp=0; iPsp<d_numberPseudoAtomicWaveFunctions[iAtom]; ++iPsp,++cumulativeWaveFunctionId)
+	projectorCutOffRadii[iAtom]=std::max(projectorCutOffRadii[iAtom],
+					     d_outerMostPointPseudoProjectorData[d_pseudoWaveFunctionIdToFunctionIdDetails[cumulativeWaveFunctionId][0]]);
+
+    double localCost=0.0;
+    typename parallel::distributed::Triangulation<3>::active_cell_iterator cell = triangulation.begin_active(), endc = triangulation.end();
+    for(; cell != endc; ++cell)
+      if(cell->is_locally_owned())
+	{
+	  const Point<3> cellCenter=cell->center();
+	  const double cellRadius=cell->diameter()/2.0;
+
+	  unsigned int numberProjectors=0;
+	  for (unsigned int iAtom=0; iAtom<numberNonLocalAtoms; ++iAtom)
+	    {
+	      const std::vector<int> & imageIdsList=d_globalChargeIdToImageIdMapTrunc[d_nonLocalAtomGlobalChargeIds[iAtom]];
+	      for (unsigned int iImage=0; iImage<imageIdsList.size(); ++iImage)
+		{
+		  const int chargeId=imageIdsList[iImage];
+		  const Point<3> chargePoint=chargeId<numberGlobalCharges?
+		    Point<3>(atomLocations[chargeId][2],atomLocations[chargeId][3],atomLocations[chargeId][4]):
+		    Point<3>(d_imagePositionsTrunc[chargeId-numberGlobalCharges][0],
+			     d_imagePositionsTrunc[chargeId-numberGlobalCharges][1],
+			     d_imagePositionsTrunc[chargeId-numberGlobalCharges][2]);
+
+		  if (cellCenter.distance(chargePoint)<=projectorCutOffRadii[iAtom]+cellRadius)
+		    {
+		      numberProjectors+=d_numberPseudoAtomicWaveFunctions[iAtom];
+		      break;
+		    }
+		}
+	    }
+
+	  const unsigned int weight=std::round(defaultCellWeight*2.0*numberProjectors/nodesPerCell);
+	  cellWeights[cell->id()]=weight;
+	  localCost+=defaultCellWeight+weight;
+	}
+
+    const double maxCost=Utilities::MPI::max(localCost,mpi_communicator);
+    const double averageCost=Utilities::MPI::sum(localCost,mpi_communicator)/n_mpi_processes;
+    return averageCost>0.0?maxCost/averageCost:1.0;
+  }
+
 
   // generate image charges and update k point cartesian coordinates based on current lattice vectors
   template<unsigned int FEOrder>
@@ -585,22 +686,24 @@ namespace dftfe {
 
     initImageChargesUpdateKPoints();
 
+    //previous ground-states are not used for extrapolation across remeshing
+    clearGroundStateExtrapolationHistory();
+
+    //h refined electrostatics data is not reused across remeshing
+    d_isHRefinedElectrostaticsMeshCached=false;
+
     computing_timer.enter_section("mesh generation");
     //
     //generate mesh (both parallel and serial)
     //while parallel meshes are always generated, serial meshes are only generated
-    //for following three cases: symmetrization is on, ionic optimization is on as well
-    //as reuse wfcs and density from previous ionic step is on, or if serial constraints
-    //generation is on.
+    //if serial constraints generation is on, which is not allowed with FULLY DISTRIBUTED MESH.
     //
     if (dftParameters::chkType==2 && dftParameters::restartFromChk)
       {
 	d_mesh.generateCoarseMeshesForRestart(atomLocations,
 					      d_imagePositions,
 					      d_domainBoundingVectors,
-					      dftParameters::useSymm
-					      || (dftParameters::isIonOpt && (dftParameters::reuseWfcGeoOpt || dftParameters::reuseDensityGeoOpt))
-					      || dftParameters::createConstraintsFromSerialDofhandler);
+					      dftParameters::createConstraintsFromSerialDofhandler);
 	loadTriaInfoAndRhoData();
       }
     else
@@ -608,9 +711,7 @@ namespace dftfe {
 	d_mesh.generateSerialUnmovedAndParallelMovedUnmovedMesh(atomLocations,
 								d_imagePositions,
 								d_domainBoundingVectors,
-								dftParameters::useSymm
-								|| (dftParameters::isIonOpt && (dftParameters::reuseWfcGeoOpt || dftParameters::reuseDensityGeoOpt))
-								|| dftParameters::createConstraintsFromSerialDofhandler,
+								dftParameters::createConstraintsFromSerialDofhandler,
 								dftParameters::electrostaticsHRefinement);
 
       }
@@ -624,6 +725,36 @@ namespace dftfe {
     //
     parallel::distributed::Triangulation<3> & triangulationPar = d_mesh.getParallelMeshMoved();
 
+    //
+    //repartition the mesh to balance the cost of the eigen solve, which is larger in the cells lying
+    //in the compact support of the nonlocal projectors. This is done before any mesh dependent data
+    //is initialized. The projector data read from the pseudopotential files does not depend on the mesh.
+    //
+    if (dftParameters::costWeightedPartitioning
+	&& dftParameters::isPseudopotential
+	&& n_mpi_processes>1
+	&& !(dftParameters::chkType==2 && dftParameters::restartFromChk))
+    {
+	initNonLocalPseudoPotential_OV();
+
+	std::map<dealii::CellId,unsigned int> cellWeights;
+	const double loadImbalance=computeCellCostWeights(triangulationPar,
+							  cellWeights);
+	if (dftParameters::verbosity>=1)
+	  pcout<<"Estimated load imbalance (maximum/average cell cost over MPI tasks) of the eigen solve: "<<loadImbalance<<std::endl;
+
+	if (loadImbalance>1.05)
+	{
+	   computing_timer.enter_section("cost weighted repartitioning");
+	   d_mesh.repartitionParallelMeshes(cellWeights);
+	   computing_timer.exit_section("cost weighted repartitioning");
+
+	   if (dftParameters::verbosity>=1)
+	     pcout<<"Estimated load imbalance of the eigen solve after cost weighted repartitioning: "
+		  <<computeCellCostWeights(triangulationPar,cellWeights)<<std::endl;
+	}
+    }
+
     //
     //initialize dofHandlers and hanging-node constraints and periodic constraints on the unmoved Mesh
     //
@@ -689,6 +820,10 @@ namespace dftfe {
 	d_isAtomsGaussianDisplacementsReadFromFile=false;
     }
 
+    updateMemoryLedgerDensityData();
+    if (dftParameters::memoryDryRun || dftParameters::memoryBudgetPerNode>0.0 || dftParameters::verbosity>=2)
+      estimateMemory();
+
     computingTimerStandard.exit_section("KSDFT problem initialization");
   }
 
@@ -714,9 +849,17 @@ namespace dftfe {
     {
 	 readPSI();
 	 initRho();
+	 d_eigenVectorsFlattenedSTLPrevious.clear();
     }
     else
     {
+       //
+       //extrapolate starting wavefunctions from previous ground states
+       //
+       bool isSubspaceExtrapolated=false;
+       if(d_isGroundStateExtrapolationPending && dftParameters::extrapolateWfcGeoOpt)
+	 isSubspaceExtrapolated=extrapolateSubspace();
+
        //
        //rho init (use previous ground state electron density)
        //
@@ -724,7 +867,19 @@ namespace dftfe {
        solveNoSCF();
 
        noRemeshRhoDataInit();
+
+       //
+       //extrapolate starting electron density from previous ground states
+       //
+       bool isRhoExtrapolated=false;
+       if(d_isGroundStateExtrapolationPending
+	  && dftParameters::groundStateExtrapolationOrder>0
+	  && dftParameters::mixingMethod != "ANDERSON_WITH_KERKER")
+	 isRhoExtrapolated=extrapolateRho();
+
+       d_isGroundStateGuessExtrapolated=isSubspaceExtrapolated || isRhoExtrapolated;
     }
+    d_isGroundStateExtrapolationPending=false;
 
     //
     //reinitialize pseudopotential related data structures
@@ -739,6 +894,8 @@ namespace dftfe {
   template<unsigned int FEOrder>
   void dftClass<FEOrder>::deformDomain(const Tensor<2,3,double> & deformationGradient)
   {
+    clearGroundStateExtrapolationHistory();
+
     d_affineTransformMesh.initMoved(d_domainBoundingVectors);
     d_affineTransformMesh.transform(deformationGradient);
 
@@ -847,6 +1004,11 @@ namespace dftfe {
   template<unsigned int FEOrder>
   void dftClass<FEOrder>::run()
   {
+    if (dftParameters::memoryDryRun)
+      {
+	pcout<<"MEMORY DRY RUN is set to true: exiting before the ground-state solve."<<std::endl;
+	return;
+      }
 
     if(dftParameters::meshAdaption)
       aposterioriMeshGenerate();
@@ -879,18 +1041,45 @@ namespace dftfe {
 	d_groundStateEnergyInitial = d_groundStateEnergy;
 
 #ifdef USE_COMPLEX
-	//first relax ion positions in the starting cell configuration
-	geoOptIonPtr->init();
-	geoOptIonPtr->run();
+	if (dftParameters::ionCellOptSolver=="LBFGS")
+	  {
+	    //simultaneously relax ion positions and cell
+	    geoOptIonCellPtr->init();
+	    geoOptIonCellPtr->run();
+	  }
+	else
+	  {
+	    //first relax ion positions in the starting cell configuration
+	    geoOptIonPtr->init();
+	    geoOptIonPtr->run();
 
-	//start cell relaxation, where for each cell relaxation update the ion positions are again relaxed
-	geoOptCellPtr->init();
-	geoOptCellPtr->run();
+	    //start cell relaxation, where for each cell relaxation update the ion positions are again relaxed
+	    geoOptCellPtr->init();
+	    geoOptCellPtr->run();
+	  }
 #else
 	AssertThrow(false,ExcMessage("CELL OPT cannot be set to true for fully non-periodic domain."));
 #endif
       }
 
+    if (dftParameters::isBOMD)
+      {
+	d_atomLocationsInitial = atomLocations;
+	d_groundStateEnergyInitial = d_groundStateEnergy;
+
+	molecularDynamicsPtr->init();
+	molecularDynamicsPtr->run();
+      }
+
+    if (!dftParameters::perturbedGeometriesFile.empty())
+      {
+	d_atomLocationsInitial = atomLocations;
+	d_groundStateEnergyInitial = d_groundStateEnergy;
+
+	perturbedGeometryForcesPtr->init();
+	perturbedGeometryForcesPtr->run();
+      }
+
     if(dftParameters::writeDosFile)
       compute_tdos(eigenValues,
 		   "dosData.out");
@@ -1001,6 +1190,13 @@ namespace dftfe {
     computing_timer.enter_section("scf solve");
 
     const double firstScfChebyTol=dftParameters::mixingMethod=="ANDERSON_WITH_KERKER"?1e-2:2e-2;
+
+    //the additional Chebyshev filtering of the first scf iteration is not required
+    //if the starting guess is extrapolated from previous ground-states
+    const bool isFirstScfFilteringBoost=!d_isGroundStateGuessExtrapolated;
+    d_isGroundStateGuessExtrapolated=false;
+
+    initKPointLoadBalancingData();
     //
     //Begin SCF iteration
     //
@@ -1163,6 +1359,10 @@ namespace dftfe {
 
 	    for(unsigned int s=0; s<2; ++s)
 	      {
+		//the other spin channel is solved concurrently by the other spin group
+		if (!isSpinChannelOwned(s))
+		  continue;
+
 		if(dftParameters::xc_id < 4)
 		  {
 		    computing_timer.enter_section("VEff Computation");
@@ -1200,12 +1400,14 @@ namespace dftfe {
 						  residualNormWaveFunctionsAllkPointsSpins[s][kPoint],
 						  (scfIter<dftParameters::spectrumSplitStartingScfIter || scfConverged)?false:true,
 						  scfConverged?false:true,
-                                                  scfIter==0,
+                                                  scfIter==0 && isFirstScfFilteringBoost,
 						  (scfConverged && dftParameters::rrGEPFullMassMatrix && dftParameters::rrGEP)?true:false);
 		      }
 		  }
 	      }
 
+	    exchangeSpinChannelEigenValues(residualNormWaveFunctionsAllkPointsSpins);
+
 	    for(unsigned int s=0; s<2; ++s)
 	      for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
 	      {
@@ -1253,11 +1455,14 @@ namespace dftfe {
 		const double filterPassTol=(scfIter==0
 					   && dftParameters::restartFromChk
 					   && dftParameters::chkType==2)? 1.0e-4
-					   :((scfIter==0 && adaptiveChebysevFilterPassesTol>firstScfChebyTol)?firstScfChebyTol:adaptiveChebysevFilterPassesTol);
-		while (maxRes>filterPassTol && count<100)
+					   :((scfIter==0 && isFirstScfFilteringBoost && adaptiveChebysevFilterPassesTol>firstScfChebyTol)?firstScfChebyTol:adaptiveChebysevFilterPassesTol);
+		while (maxRes>filterPassTol && count<d_maxChebyshevFilterPassesPerScfIter)
 		  {
 		    for(unsigned int s=0; s<2; ++s)
 		      {
+			if (!isSpinChannelOwned(s))
+			  continue;
+
 			if(dftParameters::xc_id < 4)
 			  {
 			    computing_timer.enter_section("VEff Computation");
@@ -1292,11 +1497,12 @@ namespace dftfe {
 						      residualNormWaveFunctionsAllkPointsSpins[s][kPoint],
 						      (scfIter<dftParameters::spectrumSplitStartingScfIter)?false:true,
 						      true,
-						      scfIter==0);
+						      scfIter==0 && isFirstScfFilteringBoost);
 
 			  }
 		      }
 		    count++;
+		    exchangeSpinChannelEigenValues(residualNormWaveFunctionsAllkPointsSpins);
 		    for(unsigned int s=0; s<2; ++s)
 		      for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
 		      {
@@ -1380,7 +1586,7 @@ namespace dftfe {
 					      residualNormWaveFunctionsAllkPoints[kPoint],
 					      (scfIter<dftParameters::spectrumSplitStartingScfIter || scfConverged)?false:true,
 					      scfConverged?false:true,
-                                              scfIter==0,
+                                              scfIter==0 && isFirstScfFilteringBoost,
 					      (scfConverged && dftParameters::rrGEPFullMassMatrix && dftParameters::rrGEP)?true:false);
 
 		  }
@@ -1416,8 +1622,8 @@ namespace dftfe {
 		const double filterPassTol=(scfIter==0
 					   && dftParameters::restartFromChk
 					   && dftParameters::chkType==2)? 1.0e-4
-					   :((scfIter==0 && adaptiveChebysevFilterPassesTol>firstScfChebyTol)?firstScfChebyTol:adaptiveChebysevFilterPassesTol);
-		while (maxRes>filterPassTol && count<100)
+					   :((scfIter==0 && isFirstScfFilteringBoost && adaptiveChebysevFilterPassesTol>firstScfChebyTol)?firstScfChebyTol:adaptiveChebysevFilterPassesTol);
+		while (maxRes>filterPassTol && count<d_maxChebyshevFilterPassesPerScfIter)
 		  {
 
 		    for (unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
@@ -1440,7 +1646,7 @@ namespace dftfe {
 						  residualNormWaveFunctionsAllkPoints[kPoint],
 						  (scfIter<dftParameters::spectrumSplitStartingScfIter)?false:true,
 						  true,
-						  scfIter==0);
+						  scfIter==0 && isFirstScfFilteringBoost);
 		      }
 		    count++;
 		    //
@@ -1478,6 +1684,20 @@ namespace dftfe {
 #endif
 	computing_timer.exit_section("compute rho");
 
+	updateMemoryLedgerDensityData();
+
+	if (dftParameters::verbosity>=2 && dftParameters::occupancyCutoff>0.0)
+	  {
+	    const bool isSpectrumSplit=!(scfIter<dftParameters::spectrumSplitStartingScfIter || scfConverged)
+	                               && d_numEigenValuesRR!=d_numEigenValues;
+	    const unsigned int numberStatesSkipped=isSpectrumSplit?
+	                                           0:(d_numEigenValues-computeNumberStatesAboveOccupancyCutoff());
+	    const unsigned int totalNumberKPoints=Utilities::MPI::sum(d_kPointWeights.size(),interpoolcomm);
+	    pcout<<"Number of state evaluations skipped in density computation due to OCCUPANCY CUTOFF: "
+		 <<numberStatesSkipped*(1+dftParameters::spinPolarized)*totalNumberKPoints
+		 <<" out of "<<d_numEigenValues*(1+dftParameters::spinPolarized)*totalNumberKPoints<<std::endl;
+	  }
+
 	//
 	//compute integral rhoOut
 	//
@@ -1602,6 +1822,19 @@ namespace dftfe {
 	if (dftParameters::verbosity>=1)
            pcout << "Wall time for the above scf iteration: " << local_timer.wall_time() << " seconds\n"<<
 	        "Number of Chebyshev filtered subspace iterations: "<< numberChebyshevSolvePasses<<std::endl<<std::endl;
+
+	//
+	//update the k-point costs and re-assign k-points across pools if required
+	//
+	updateKPointCostsAndRebalance(norm > dftParameters::selfConsistentSolverTolerance
+				      && scfIter+1 < dftParameters::numSCFIterations);
+
+	if (dftParameters::verbosity>=4 && !dftParameters::reproducible_output)
+	  memoryLedger::printSummary("scf iteration");
+
+	performanceTelemetry::writeRecord("scf iteration",
+		                          scfIter+1);
+
 	//
 	scfIter++;
 
@@ -1609,6 +1842,12 @@ namespace dftfe {
 	  saveTriaInfoAndRhoData();
       }
 
+    if (dftParameters::dynamicKPointScheduling || dftParameters::verbosity>=2)
+      printKPointPoolTimings();
+
+    if (dftParameters::verbosity>=2 && !dftParameters::reproducible_output)
+      memoryLedger::printSummary("ground-state solve");
+
     if(scfIter==dftParameters::numSCFIterations)
       pcout<<"DFT-FE Warning: SCF iterations did not converge to the specified tolerance after: "<<scfIter<<" iterations."<<std::endl;
     else
@@ -1733,6 +1972,17 @@ namespace dftfe {
 		               interBandGroupComm);
 #endif
 
+    //
+    //the wavefunctions of each spin channel stay on the spin group owning them. The forces
+    //and the stress sum the wavefunction contributions over the spin groups, so both channels
+    //are gathered on each spin group only for the post-processing of the wavefunctions
+    //
+    if (dftParameters::writeWfcSolutionFields
+	|| dftParameters::writeLdosFile
+	|| dftParameters::writeLocalizationLengths
+	|| dftParameters::electrostaticsPRefinement)
+      exchangeSpinChannelWaveFunctions();
+
     //
     //move this to a common routine
     //
@@ -1776,56 +2026,6 @@ namespace dftfe {
 	}
     }
 
-    if(dftParameters::isCellStress)
-    {
-	//
-	//Create the full dealii partitioned array
-	//
-	d_eigenVectorsFlattened.resize((1+dftParameters::spinPolarized)*d_kPointWeights.size());
-
-	for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
-	  {
-	    vectorTools::createDealiiVector<dataTypes::number>(matrix_free_data.get_vector_partitioner(),
-							       d_numEigenValues,
-							       d_eigenVectorsFlattened[kPoint]);
-
-
-	    d_eigenVectorsFlattened[kPoint] = dataTypes::number(0.0);
-
-	  }
-
-
-	Assert(d_eigenVectorsFlattened[0].local_size()==d_eigenVectorsFlattenedSTL[0].size(),
-		  dealii::ExcMessage("Incorrect local sizes of STL and dealii arrays"));
-
-	constraintsNoneDataInfo.precomputeMaps(matrix_free_data.get_vector_partitioner(),
-					       d_eigenVectorsFlattened[0].get_partitioner(),
-					       d_numEigenValues);
-
-	for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
-	  {
-	    for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
-	      {
-		for(unsigned int iWave = 0; iWave < d_numEigenValues; ++iWave)
-		  {
-		    d_eigenVectorsFlattened[kPoint].local_element(iNode*d_numEigenValues+iWave)
-		      = d_eigenVectorsFlattenedSTL[kPoint][iNode*d_numEigenValues+iWave];
-		  }
-	      }
-
-	    constraintsNoneDataInfo.distribute(d_eigenVectorsFlattened[kPoint],
-					       d_numEigenValues);
-
-	  }
-
-        /*
-	for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
-	  {
-	    d_eigenVectorsFlattenedSTL[kPoint].clear();
-	    std::vector<dataTypes::number>().swap(d_eigenVectorsFlattenedSTL[kPoint]);
-	  }
-        */
-      }
 
     if (dftParameters::isIonForce && (!dftParameters::electrostaticsHRefinement || dftParameters::verbosity>=4 || dftParameters::reproducible_output))
       {
@@ -173,12 +173,29 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
    //
    //subdivide the existing mesh and project electron-density onto the new mesh
    //
+   const bool reuseHRefinedData = dftParameters::reuseElectrostaticsHRefinement;
+   if (!reuseHRefinedData)
+     d_isHRefinedElectrostaticsMeshCached=false;
 
    //
-   //initialize the new dofHandler to refine and do a solution transfer
+   //the vself bins on the h refined mesh are kept in dftClass only if they are reused in the next call
    //
+   vselfBinsManager<FEOrder> vselfBinsManagerHRefinedLocal(mpi_communicator);
+   vselfBinsManager<FEOrder> & vselfBinsManagerHRefined = reuseHRefinedData?d_vselfBinsManagerHRefined:vselfBinsManagerHRefinedLocal;
+
    dealii::parallel::distributed::Triangulation<3> & electrostaticsTriaRho = d_mesh.getElectrostaticsMeshRho();
 
+   //
+   //get back the unsubdivided electrostatics triangulation having rho field, if it was
+   //already subdivided in a previous call on the same mesh
+   //
+   if (reuseHRefinedData
+       && electrostaticsTriaRho.n_global_active_cells()!=dofHandler.get_triangulation().n_global_active_cells())
+     d_mesh.generateResetElectrostaticsMeshRho();
+
+   //
+   //initialize the new dofHandler to refine and do a solution transfer
+   //
    dealii::DoFHandler<3> dofHandlerHRefined;
    dofHandlerHRefined.initialize(electrostaticsTriaRho,dealii::FE_Q<3>(dealii::QGaussLobatto<1>(FEOrder+1)));
    dofHandlerHRefined.distribute_dofs(dofHandlerHRefined.get_fe());
@@ -225,55 +242,89 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 	     << std::endl;
      }
 
-   dealii::IndexSet locallyRelevantDofs;
-   dealii::DoFTools::extract_locally_relevant_dofs(dofHandlerHRefined, locallyRelevantDofs);
+   //
+   //initialize the data structures depending only on the topology of the subdivided mesh. If they are reused,
+   //they are built on the subdivided electrostatics triangulation, which has the same partitioning and
+   //dof numbering as the electrostatics triangulation having rho field after its subdivision
+   //
+   if (!d_isHRefinedElectrostaticsMeshCached)
+   {
+       d_matrixFreeDataHRefined.clear();
+       d_dofHandlerHRefined.clear();
+       if (reuseHRefinedData)
+	 {
+	   if (dftParameters::verbosity>=2)
+	     pcout<<std::endl<<"Generating subdivided electrostatics mesh to be reused across ground-state solves"<<std::endl;
+	   d_mesh.generateSubdividedElectrostaticsMesh();
+	 }
 
-   IndexSet ghost_indices = locallyRelevantDofs;
-   ghost_indices.subtract_set(dofHandlerHRefined.locally_owned_dofs());
+       d_dofHandlerHRefined.initialize(reuseHRefinedData?d_mesh.getElectrostaticsMeshSubdivided():electrostaticsTriaRho,
+				       dealii::FE_Q<3>(dealii::QGaussLobatto<1>(FEOrder+1)));
+       d_dofHandlerHRefined.distribute_dofs(d_dofHandlerHRefined.get_fe());
 
+       dealii::IndexSet locallyRelevantDofs;
+       dealii::DoFTools::extract_locally_relevant_dofs(d_dofHandlerHRefined, locallyRelevantDofs);
 
-   dealii::ConstraintMatrix onlyHangingNodeConstraints;
-   onlyHangingNodeConstraints.reinit(locallyRelevantDofs);
-   dealii::DoFTools::make_hanging_node_constraints(dofHandlerHRefined, onlyHangingNodeConstraints);
-   onlyHangingNodeConstraints.close();
+       d_onlyHangingNodeConstraintsHRefined.clear();
+       d_onlyHangingNodeConstraintsHRefined.reinit(locallyRelevantDofs);
+       dealii::DoFTools::make_hanging_node_constraints(d_dofHandlerHRefined, d_onlyHangingNodeConstraintsHRefined);
+       d_onlyHangingNodeConstraintsHRefined.close();
 
-   dealii::ConstraintMatrix constraintsHRefined;
-   constraintsHRefined.reinit(locallyRelevantDofs);
-   dealii::DoFTools::make_hanging_node_constraints(dofHandlerHRefined, constraintsHRefined);
-   std::vector<std::vector<double> > unitVectorsXYZ;
-   unitVectorsXYZ.resize(3);
+       d_constraintsHRefined.clear();
+       d_constraintsHRefined.reinit(locallyRelevantDofs);
+       dealii::DoFTools::make_hanging_node_constraints(d_dofHandlerHRefined, d_constraintsHRefined);
+       std::vector<std::vector<double> > unitVectorsXYZ;
+       unitVectorsXYZ.resize(3);
 
-   for(unsigned int i = 0; i < 3; ++i)
-    {
-      unitVectorsXYZ[i].resize(3,0.0);
-      unitVectorsXYZ[i][i] = 0.0;
-    }
+       for(unsigned int i = 0; i < 3; ++i)
+	{
+	  unitVectorsXYZ[i].resize(3,0.0);
+	  unitVectorsXYZ[i][i] = 0.0;
+	}
 
-   std::vector<Tensor<1,3> > offsetVectors;
-   //resize offset vectors
-   offsetVectors.resize(3);
+       std::vector<Tensor<1,3> > offsetVectors;
+       //resize offset vectors
+       offsetVectors.resize(3);
 
-   for(unsigned int i = 0; i < 3; ++i)
-     for(unsigned int j = 0; j < 3; ++j)
-	  offsetVectors[i][j] = unitVectorsXYZ[i][j] - d_domainBoundingVectors[i][j];
+       for(unsigned int i = 0; i < 3; ++i)
+	 for(unsigned int j = 0; j < 3; ++j)
+	      offsetVectors[i][j] = unitVectorsXYZ[i][j] - d_domainBoundingVectors[i][j];
 
-   std::vector<dealii::GridTools::PeriodicFacePair<typename dealii::DoFHandler<3>::cell_iterator> > periodicity_vector2;
-   const std::array<unsigned int,3> periodic = {dftParameters::periodicX, dftParameters::periodicY, dftParameters::periodicZ};
+       std::vector<dealii::GridTools::PeriodicFacePair<typename dealii::DoFHandler<3>::cell_iterator> > periodicity_vector2;
+       const std::array<unsigned int,3> periodic = {dftParameters::periodicX, dftParameters::periodicY, dftParameters::periodicZ};
 
-   std::vector<int> periodicDirectionVector;
-   for (unsigned int  d= 0; d < 3; ++d)
-     {
-       if (periodic[d]==1)
+       std::vector<int> periodicDirectionVector;
+       for (unsigned int  d= 0; d < 3; ++d)
 	 {
-	   periodicDirectionVector.push_back(d);
+	   if (periodic[d]==1)
+	     {
+	       periodicDirectionVector.push_back(d);
+	     }
 	 }
-     }
 
-   for (unsigned int i = 0; i < std::accumulate(periodic.begin(),periodic.end(),0); ++i)
-         GridTools::collect_periodic_faces(dofHandlerHRefined, /*b_id1*/ 2*i+1, /*b_id2*/ 2*i+2,/*direction*/ periodicDirectionVector[i], periodicity_vector2,offsetVectors[periodicDirectionVector[i]]);
+       for (unsigned int i = 0; i < std::accumulate(periodic.begin(),periodic.end(),0); ++i)
+	     GridTools::collect_periodic_faces(d_dofHandlerHRefined, /*b_id1*/ 2*i+1, /*b_id2*/ 2*i+2,/*direction*/ periodicDirectionVector[i], periodicity_vector2,offsetVectors[periodicDirectionVector[i]]);
 
-   dealii::DoFTools::make_periodicity_constraints<dealii::DoFHandler<3> >(periodicity_vector2, constraintsHRefined);
-   constraintsHRefined.close();
+       dealii::DoFTools::make_periodicity_constraints<dealii::DoFHandler<3> >(periodicity_vector2, d_constraintsHRefined);
+       d_constraintsHRefined.close();
+
+       //
+       //force recomputation of the geometry dependent data
+       //
+       d_atomLocationsHRefined.clear();
+       d_domainBoundingVectorsHRefined.clear();
+       d_isHRefinedElectrostaticsMeshCached=reuseHRefinedData;
+   }
+
+   AssertThrow(d_dofHandlerHRefined.n_dofs()==dofHandlerHRefined.n_dofs()
+	       && d_dofHandlerHRefined.locally_owned_dofs()==dofHandlerHRefined.locally_owned_dofs(),
+	       ExcMessage("DFT-FE Error: Subdivided electrostatics mesh is not consistent with the h refined mesh used for the solution transfer. Please set REUSE H REFINED ELECTROSTATICS to false."));
+
+   dealii::IndexSet locallyRelevantDofs;
+   dealii::DoFTools::extract_locally_relevant_dofs(d_dofHandlerHRefined, locallyRelevantDofs);
+
+   IndexSet ghost_indices = locallyRelevantDofs;
+   ghost_indices.subtract_set(d_dofHandlerHRefined.locally_owned_dofs());
 
 
    //
@@ -315,51 +366,60 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
        solTrans.interpolate(rhoNodalFieldRefined);
 
    rhoNodalFieldRefined.update_ghost_values();
-   constraintsHRefined.distribute(rhoNodalFieldRefined);
+   d_constraintsHRefined.distribute(rhoNodalFieldRefined);
    rhoNodalFieldRefined.update_ghost_values();
 
    if (dftParameters::isCellStress || dftParameters::isIonForce)
    {
        delxRhoNodalFieldRefined.update_ghost_values();
-       constraintsHRefined.distribute(delxRhoNodalFieldRefined);
+       d_constraintsHRefined.distribute(delxRhoNodalFieldRefined);
        delxRhoNodalFieldRefined.update_ghost_values();
 
        delyRhoNodalFieldRefined.update_ghost_values();
-       constraintsHRefined.distribute(delyRhoNodalFieldRefined);
+       d_constraintsHRefined.distribute(delyRhoNodalFieldRefined);
        delyRhoNodalFieldRefined.update_ghost_values();
 
        delzRhoNodalFieldRefined.update_ghost_values();
-       constraintsHRefined.distribute(delzRhoNodalFieldRefined);
+       d_constraintsHRefined.distribute(delzRhoNodalFieldRefined);
        delzRhoNodalFieldRefined.update_ghost_values();
    }
 
-
    //
-   //move the refined mesh so that it forms exact subdivison of coarse moved mesh
+   //the geometry dependent data is recomputed only if the atoms have moved since the last call
    //
+   const bool isGeometryChanged = !d_isHRefinedElectrostaticsMeshCached
+				  || atomLocations!=d_atomLocationsHRefined
+				  || d_domainBoundingVectors!=d_domainBoundingVectorsHRefined;
+
    dealii::parallel::distributed::Triangulation<3> & electrostaticsTriaDisp = d_mesh.getElectrostaticsMeshDisp();
 
    //
-   //create guassian Move object
+   //move the refined mesh so that it forms exact subdivison of coarse moved mesh
    //
-   if(d_autoMesh == 1)
-     moveMeshToAtoms(electrostaticsTriaDisp,
-		     d_mesh.getSerialMeshElectrostatics(),
-		     true,
-		     true);
-   else
+   if (isGeometryChanged)
      {
-
        //
-       //move electrostatics mesh
+       //create guassian Move object
        //
+       if(d_autoMesh == 1)
+	 moveMeshToAtoms(electrostaticsTriaDisp,
+			 d_mesh.getSerialMeshElectrostatics(),
+			 true,
+			 true);
+       else
+	 {
+
+	   //
+	   //move electrostatics mesh
+	   //
 
-       d_gaussianMovePar.init(electrostaticsTriaDisp,
-			      d_mesh.getSerialMeshElectrostatics(),
-			      d_domainBoundingVectors);
+	   d_gaussianMovePar.init(electrostaticsTriaDisp,
+				  d_mesh.getSerialMeshElectrostatics(),
+				  d_domainBoundingVectors);
 
-       d_gaussianMovePar.moveMeshTwoLevelElectro();
+	   d_gaussianMovePar.moveMeshTwoLevelElectro();
 
+	 }
      }
 
 
@@ -374,8 +434,22 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 			 true,
 			 d_gaussianConstantForce);
 
-   d_mesh.resetMesh(electrostaticsTriaDisp,
-		    electrostaticsTriaRho);
+   //
+   //the subdivided electrostatics triangulation is moved by copying the vertices of the moved refined mesh,
+   //and holds the moved vertices as long as the atoms do not move
+   //
+   if (isGeometryChanged)
+     {
+       d_mesh.resetMesh(electrostaticsTriaDisp,
+			electrostaticsTriaRho);
+
+       if (reuseHRefinedData)
+	 d_mesh.resetMesh(electrostaticsTriaDisp,
+			  d_mesh.getElectrostaticsMeshSubdivided());
+     }
+   else
+     d_mesh.resetMesh(d_mesh.getElectrostaticsMeshSubdivided(),
+		      electrostaticsTriaRho);
 
    dofHandlerHRefined.distribute_dofs(dofHandlerHRefined.get_fe());
 
@@ -427,134 +501,152 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
        pcout<<"Value of total charge computed on moved subdivided mesh after solution transfer: "<< integralRhoValue<<std::endl;
      }
 
+   const unsigned int phiTotDofHandlerIndexHRefined = 1;
 
-   //matrix free data structure
-   typename dealii::MatrixFree<3>::AdditionalData additional_data;
-   additional_data.tasks_parallel_scheme = dealii::MatrixFree<3>::AdditionalData::partition_partition;
-
-   //Zero Dirichlet BC constraints on the boundary of the domain
-   //used for computing total electrostatic potential using Poisson problem
-   //with (rho+b) as the rhs
-   dealii::ConstraintMatrix constraintsForTotalPotential;
-   constraintsForTotalPotential.reinit(locallyRelevantDofs);
-
-   if (dftParameters::pinnedNodeForPBC)
-      locatePeriodicPinnedNodes(dofHandlerHRefined,
-	                        constraintsHRefined,
-	                        constraintsForTotalPotential);
-   applyHomogeneousDirichletBC(dofHandlerHRefined,constraintsForTotalPotential);
-   constraintsForTotalPotential.close();
-
-   constraintsForTotalPotential.merge(constraintsHRefined,ConstraintMatrix::MergeConflictBehavior::right_object_wins);
-   constraintsForTotalPotential.close();
-
-   //clear existing constraints matrix vector
-   std::vector<const dealii::ConstraintMatrix*> matrixFreeConstraintsInputVector;
-
-   matrixFreeConstraintsInputVector.push_back(&constraintsHRefined);
-
-   matrixFreeConstraintsInputVector.push_back(&constraintsForTotalPotential);
-
-   //Dirichlet BC constraints on the boundary of fictitious ball
-   //used for computing self-potential (Vself) using Poisson problem
-   //with atoms belonging to a given bin
-
-   vselfBinsManager<FEOrder> vselfBinsManagerHRefined(mpi_communicator);
-   vselfBinsManagerHRefined.createAtomBins(matrixFreeConstraintsInputVector,
-		                           onlyHangingNodeConstraints,
-					   dofHandlerHRefined,
-					   constraintsHRefined,
-					   atomLocations,
-					   d_imagePositionsTrunc,
-					   d_imageIdsTrunc,
-					   d_imageChargesTrunc,
-					   d_vselfBinsManager.getStoredAdaptiveBallRadius());
-
-   if (dftParameters::constraintsParallelCheck)
+   if (isGeometryChanged)
    {
-     IndexSet locally_active_dofs_debug;
-     DoFTools::extract_locally_active_dofs(dofHandlerHRefined, locally_active_dofs_debug);
-
-     const std::vector<IndexSet>& locally_owned_dofs_debug= dofHandlerHRefined.locally_owned_dofs_per_processor();
-
-     AssertThrow(constraintsHRefined.is_consistent_in_parallel(locally_owned_dofs_debug,
-                                               locally_active_dofs_debug,
-                                               mpi_communicator),ExcMessage("DFT-FE Error: Constraints are not consistent in parallel. This is because of a known issue in the deal.ii library, which will be fixed soon. Currently, please set H REFINED ELECTROSTATICS to false."));
-
-     AssertThrow(constraintsForTotalPotential.is_consistent_in_parallel(locally_owned_dofs_debug,
-                                               locally_active_dofs_debug,
-                                               mpi_communicator),ExcMessage("DFT-FE Error: Constraints are not consistent in parallel. This is because of a known issue in the deal.ii library, which will be fixed soon. Currently, please set H REFINED ELECTROSTATICS to false."));
-
-     for (unsigned int i=2; i<matrixFreeConstraintsInputVector.size();i++)
-	 AssertThrow(matrixFreeConstraintsInputVector[i]->is_consistent_in_parallel(locally_owned_dofs_debug,
+       //matrix free data structure
+       typename dealii::MatrixFree<3>::AdditionalData additional_data;
+       additional_data.tasks_parallel_scheme = dealii::MatrixFree<3>::AdditionalData::partition_partition;
+
+       //Zero Dirichlet BC constraints on the boundary of the domain
+       //used for computing total electrostatic potential using Poisson problem
+       //with (rho+b) as the rhs
+       d_constraintsForTotalPotentialHRefined.clear();
+       d_constraintsForTotalPotentialHRefined.reinit(locallyRelevantDofs);
+
+       if (dftParameters::pinnedNodeForPBC)
+	  locatePeriodicPinnedNodes(d_dofHandlerHRefined,
+				    d_constraintsHRefined,
+				    d_constraintsForTotalPotentialHRefined);
+       applyHomogeneousDirichletBC(d_dofHandlerHRefined,d_constraintsForTotalPotentialHRefined);
+       d_constraintsForTotalPotentialHRefined.close();
+
+       d_constraintsForTotalPotentialHRefined.merge(d_constraintsHRefined,ConstraintMatrix::MergeConflictBehavior::right_object_wins);
+       d_constraintsForTotalPotentialHRefined.close();
+
+       //clear existing constraints matrix vector
+       d_constraintsVectorHRefined.clear();
+
+       d_constraintsVectorHRefined.push_back(&d_constraintsHRefined);
+
+       d_constraintsVectorHRefined.push_back(&d_constraintsForTotalPotentialHRefined);
+
+       //Dirichlet BC constraints on the boundary of fictitious ball
+       //used for computing self-potential (Vself) using Poisson problem
+       //with atoms belonging to a given bin
+
+       vselfBinsManagerHRefined.createAtomBins(d_constraintsVectorHRefined,
+					       d_onlyHangingNodeConstraintsHRefined,
+					       d_dofHandlerHRefined,
+					       d_constraintsHRefined,
+					       atomLocations,
+					       d_imagePositionsTrunc,
+					       d_imageIdsTrunc,
+					       d_imageChargesTrunc,
+					       d_vselfBinsManager.getStoredAdaptiveBallRadius());
+
+       if (dftParameters::constraintsParallelCheck)
+       {
+	 IndexSet locally_active_dofs_debug;
+	 DoFTools::extract_locally_active_dofs(d_dofHandlerHRefined, locally_active_dofs_debug);
+
+	 const std::vector<IndexSet>& locally_owned_dofs_debug= d_dofHandlerHRefined.locally_owned_dofs_per_processor();
+
+	 AssertThrow(d_constraintsHRefined.is_consistent_in_parallel(locally_owned_dofs_debug,
 						   locally_active_dofs_debug,
 						   mpi_communicator),ExcMessage("DFT-FE Error: Constraints are not consistent in parallel. This is because of a known issue in the deal.ii library, which will be fixed soon. Currently, please set H REFINED ELECTROSTATICS to false."));
-   }
 
-   std::vector<const dealii::DoFHandler<3> *> matrixFreeDofHandlerVectorInput;
-
-   for(unsigned int i = 0; i < matrixFreeConstraintsInputVector.size(); ++i)
-     matrixFreeDofHandlerVectorInput.push_back(&dofHandlerHRefined);
-
-   const unsigned int phiTotDofHandlerIndexHRefined = 1;
+	 AssertThrow(d_constraintsForTotalPotentialHRefined.is_consistent_in_parallel(locally_owned_dofs_debug,
+						   locally_active_dofs_debug,
+						   mpi_communicator),ExcMessage("DFT-FE Error: Constraints are not consistent in parallel. This is because of a known issue in the deal.ii library, which will be fixed soon. Currently, please set H REFINED ELECTROSTATICS to false."));
 
-   matrixFreeDofHandlerVectorInput.push_back(&dofHandlerHRefined);
-   const unsigned phiExtDofHandlerIndexHRefined = matrixFreeDofHandlerVectorInput.size()-1;
-   matrixFreeConstraintsInputVector.push_back(&onlyHangingNodeConstraints);
+	 for (unsigned int i=2; i<d_constraintsVectorHRefined.size();i++)
+	     AssertThrow(d_constraintsVectorHRefined[i]->is_consistent_in_parallel(locally_owned_dofs_debug,
+							   locally_active_dofs_debug,
+							   mpi_communicator),ExcMessage("DFT-FE Error: Constraints are not consistent in parallel. This is because of a known issue in the deal.ii library, which will be fixed soon. Currently, please set H REFINED ELECTROSTATICS to false."));
+       }
+
+       d_dofHandlerVectorHRefined.clear();
+
+       for(unsigned int i = 0; i < d_constraintsVectorHRefined.size(); ++i)
+	 d_dofHandlerVectorHRefined.push_back(&d_dofHandlerHRefined);
+
+       d_dofHandlerVectorHRefined.push_back(&d_dofHandlerHRefined);
+       d_constraintsVectorHRefined.push_back(&d_onlyHangingNodeConstraintsHRefined);
+
+       std::vector<Quadrature<1> > quadratureVector;
+       quadratureVector.push_back(QGauss<1>(C_num1DQuad<FEOrder>()));
+
+       d_matrixFreeDataHRefined.reinit(d_dofHandlerVectorHRefined,
+				       d_constraintsVectorHRefined,
+				       quadratureVector,
+				       additional_data);
+
+       locateAtomCoreNodes(d_dofHandlerHRefined,d_atomHRefinedNodeIdToChargeMap);
+
+       //solve vself in bins on h refined mesh
+       d_localVselfsHRefined.clear();
+       d_matrixFreeDataHRefined.initialize_dof_vector(d_phiExtHRefined,d_dofHandlerVectorHRefined.size()-1);
+       if (dftParameters::verbosity==2)
+	    pcout<< std::endl<<"Solving for nuclear charge self potential in bins on h refined mesh: ";
+       vselfBinsManagerHRefined.solveVselfInBins(d_matrixFreeDataHRefined,
+						 2,
+						 d_phiExtHRefined,
+						 d_onlyHangingNodeConstraintsHRefined,
+						 d_imagePositions,
+						 d_imageIds,
+						   d_imageCharges,
+						   d_localVselfsHRefined);
+
+       d_pseudoVLocHRefined.clear();
+       d_gradPseudoVLocHRefined.clear();
+       d_gradPseudoVLocAtomsHRefined.clear();
+       if(dftParameters::isPseudopotential)
+	   initLocalPseudoPotential(d_dofHandlerHRefined,
+				    quadrature,
+				    d_pseudoVLocHRefined,
+				    d_gradPseudoVLocHRefined,
+				    d_gradPseudoVLocAtomsHRefined);
 
+       //
+       //the previous total electrostatic potential is kept as the initial guess, as the
+       //dof numbering does not change with the mesh movement
+       //
+       vectorType phiTotRhoOutHRefinedPrevious;
+       if (reuseHRefinedData)
+	 phiTotRhoOutHRefinedPrevious=d_phiTotRhoOutHRefined;
+
+       d_matrixFreeDataHRefined.initialize_dof_vector(d_phiTotRhoOutHRefined,phiTotDofHandlerIndexHRefined);
+       if (phiTotRhoOutHRefinedPrevious.size()==d_phiTotRhoOutHRefined.size()
+	   && phiTotRhoOutHRefinedPrevious.local_size()==d_phiTotRhoOutHRefined.local_size())
+	 for (unsigned int i=0; i<d_phiTotRhoOutHRefined.local_size(); ++i)
+	    d_phiTotRhoOutHRefined.local_element(i)=phiTotRhoOutHRefinedPrevious.local_element(i);
+
+       d_atomLocationsHRefined=atomLocations;
+       d_domainBoundingVectorsHRefined=d_domainBoundingVectors;
+   }
+   else if (dftParameters::verbosity>=2)
+     pcout<<std::endl<<"Reusing h refined electrostatics data structures from the previous call"<<std::endl;
 
+   const unsigned int phiExtDofHandlerIndexHRefined = d_dofHandlerVectorHRefined.size()-1;
 
-   forcePtr->initMoved(matrixFreeDofHandlerVectorInput,
-	               matrixFreeConstraintsInputVector,
+   forcePtr->initMoved(d_dofHandlerVectorHRefined,
+	               d_constraintsVectorHRefined,
 	               true,
 		       true);
 
-
-   std::vector<Quadrature<1> > quadratureVector;
-   quadratureVector.push_back(QGauss<1>(C_num1DQuad<FEOrder>()));
-
-   dealii::MatrixFree<3,double> matrixFreeDataHRefined;
-
-   matrixFreeDataHRefined.reinit(matrixFreeDofHandlerVectorInput,
-	                         matrixFreeConstraintsInputVector,
-			         quadratureVector,
-			         additional_data);
-
-
-
-   std::map<dealii::types::global_dof_index, double> atomHRefinedNodeIdToChargeMap;
-   locateAtomCoreNodes(dofHandlerHRefined,atomHRefinedNodeIdToChargeMap);
-
-
-   //solve vself in bins on h refined mesh
-   std::vector<std::vector<double> > localVselfsHRefined;
-   vectorType phiExtHRefined;
-   matrixFreeDataHRefined.initialize_dof_vector(phiExtHRefined,phiExtDofHandlerIndexHRefined);
-   if (dftParameters::verbosity==2)
-        pcout<< std::endl<<"Solving for nuclear charge self potential in bins on h refined mesh: ";
-   vselfBinsManagerHRefined.solveVselfInBins(matrixFreeDataHRefined,
-		                             2,
-	                                     phiExtHRefined,
-				             onlyHangingNodeConstraints,
-					     d_imagePositions,
-					     d_imageIds,
-					     d_imageCharges,
-	                                     localVselfsHRefined);
-
    //
    //solve the Poisson problem for total rho
    //
-   vectorType phiTotRhoOutHRefined;
-   matrixFreeDataHRefined.initialize_dof_vector(phiTotRhoOutHRefined,phiTotDofHandlerIndexHRefined);
-
    dealiiLinearSolver dealiiCGSolver(mpi_communicator, dealiiLinearSolver::CG);
    poissonSolverProblem<FEOrder> phiTotalSolverProblem(mpi_communicator);
 
-   phiTotalSolverProblem.reinit(matrixFreeDataHRefined,
-	                        phiTotRhoOutHRefined,
-				*matrixFreeConstraintsInputVector[phiTotDofHandlerIndexHRefined],
+   phiTotalSolverProblem.reinit(d_matrixFreeDataHRefined,
+	                        d_phiTotRhoOutHRefined,
+				*d_constraintsVectorHRefined[phiTotDofHandlerIndexHRefined],
                                 phiTotDofHandlerIndexHRefined,
-	                        atomHRefinedNodeIdToChargeMap,
+	                        d_atomHRefinedNodeIdToChargeMap,
 				rhoOutHRefinedQuadValues,
                                 true,
                                 dftParameters::periodicX && dftParameters::periodicY && dftParameters::periodicZ && !dftParameters::pinnedNodeForPBC);
@@ -566,22 +658,11 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 			dftParameters::maxLinearSolverIterations,
 			dftParameters::verbosity);
 
-   std::map<dealii::CellId, std::vector<double> > pseudoVLocHRefined;
-   std::map<dealii::CellId, std::vector<double> > gradPseudoVLocHRefined;
-   std::map<unsigned int,std::map<dealii::CellId, std::vector<double> > > gradPseudoVLocAtomsHRefined;
-
-   if(dftParameters::isPseudopotential)
-       initLocalPseudoPotential(dofHandlerHRefined,
-				quadrature,
-				pseudoVLocHRefined,
-				gradPseudoVLocHRefined,
-				gradPseudoVLocAtomsHRefined);
-
    energyCalculator energyCalcHRefined(mpi_communicator, interpoolcomm, interBandGroupComm);
 
 
   const double totalEnergy = dftParameters::spinPolarized==0 ?
-    energyCalcHRefined.computeEnergy(dofHandlerHRefined,
+    energyCalcHRefined.computeEnergy(d_dofHandlerHRefined,
 				     dofHandler,
 				     quadrature,
 				     quadrature,
@@ -591,23 +672,23 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 				     funcX,
 				     funcC,
 				     d_phiTotRhoIn,
-				     phiTotRhoOutHRefined,
+				     d_phiTotRhoOutHRefined,
 				     d_phiExt,
-				     phiExtHRefined,
+				     d_phiExtHRefined,
 				     *rhoInValues,
 				     *rhoOutValues,
 				     rhoOutHRefinedQuadValues,
 				     *gradRhoInValues,
 				     *gradRhoOutValues,
-				     localVselfsHRefined,
+				     d_localVselfsHRefined,
 				     d_pseudoVLoc,
-				     pseudoVLocHRefined,
-				     atomHRefinedNodeIdToChargeMap,
+				     d_pseudoVLocHRefined,
+				     d_atomHRefinedNodeIdToChargeMap,
 				     atomLocations.size(),
 				     lowerBoundKindex,
 				     1,
 				     true) :
-    energyCalcHRefined.computeEnergySpinPolarized(dofHandlerHRefined,
+    energyCalcHRefined.computeEnergySpinPolarized(d_dofHandlerHRefined,
 						  dofHandler,
 						  quadrature,
 						  quadrature,
@@ -619,9 +700,9 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 						  funcX,
 						  funcC,
 						  d_phiTotRhoIn,
-						  phiTotRhoOutHRefined,
+						  d_phiTotRhoOutHRefined,
 						  d_phiExt,
-						  phiExtHRefined,
+						  d_phiExtHRefined,
 						  *rhoInValues,
 						  *rhoOutValues,
 						  rhoOutHRefinedQuadValues,
@@ -631,10 +712,10 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 						  *rhoOutValuesSpinPolarized,
 						  *gradRhoInValuesSpinPolarized,
 						  *gradRhoOutValuesSpinPolarized,
-						  localVselfsHRefined,
+						  d_localVselfsHRefined,
 						  d_pseudoVLoc,
-						  pseudoVLocHRefined,
-						  atomHRefinedNodeIdToChargeMap,
+						  d_pseudoVLocHRefined,
+						  d_atomHRefinedNodeIdToChargeMap,
 						  atomLocations.size(),
 						  lowerBoundKindex,
 						  1,
@@ -644,50 +725,7 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 
 
 
-    if(dftParameters::isCellStress)
-      {
-	//
-	//Create the full dealii partitioned array
-	//
-	d_eigenVectorsFlattened.resize((1+dftParameters::spinPolarized)*d_kPointWeights.size());
-
-	for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
-	  {
-	    vectorTools::createDealiiVector<dataTypes::number>(matrix_free_data.get_vector_partitioner(),
-							       d_numEigenValues,
-							       d_eigenVectorsFlattened[kPoint]);
-
-
-	    d_eigenVectorsFlattened[kPoint] = dataTypes::number(0.0);
-
-	  }
-
-
-	Assert(d_eigenVectorsFlattened[0].local_size()==d_eigenVectorsFlattenedSTL[0].size(),
-		  dealii::ExcMessage("Incorrect local sizes of STL and dealii arrays"));
-
-	constraintsNoneDataInfo.precomputeMaps(matrix_free_data.get_vector_partitioner(),
-					       d_eigenVectorsFlattened[0].get_partitioner(),
-					       d_numEigenValues);
-
-	const unsigned int localVectorSize = d_eigenVectorsFlattenedSTL[0].size()/d_numEigenValues;
-
-	for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*d_kPointWeights.size(); ++kPoint)
-	  {
-	    for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
-	      {
-		for(unsigned int iWave = 0; iWave < d_numEigenValues; ++iWave)
-		  {
-		    d_eigenVectorsFlattened[kPoint].local_element(iNode*d_numEigenValues+iWave)
-		      = d_eigenVectorsFlattenedSTL[kPoint][iNode*d_numEigenValues+iWave];
-		  }
-	      }
-
-	    constraintsNoneDataInfo.distribute(d_eigenVectorsFlattened[kPoint],
-					       d_numEigenValues);
 
-	  }
-      }
 
     computing_timer.exit_section("h refinement electrostatics");
     computingTimerStandard.exit_section("h refinement electrostatics");
@@ -711,17 +749,17 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 					 d_gradPseudoVLocAtoms,
 					 d_noConstraints,
 					 d_vselfBinsManager,
-					 matrixFreeDataHRefined,
+					 d_matrixFreeDataHRefined,
 					 phiTotDofHandlerIndexHRefined,
 					 phiExtDofHandlerIndexHRefined,
-					 phiTotRhoOutHRefined,
-					 phiExtHRefined,
+					 d_phiTotRhoOutHRefined,
+					 d_phiExtHRefined,
 					 rhoOutHRefinedQuadValues,
 					 gradRhoOutHRefinedQuadValues,
-					 pseudoVLocHRefined,
-					 gradPseudoVLocHRefined,
-					 gradPseudoVLocAtomsHRefined,
-					 onlyHangingNodeConstraints,
+					 d_pseudoVLocHRefined,
+					 d_gradPseudoVLocHRefined,
+					 d_gradPseudoVLocAtomsHRefined,
+					 d_onlyHangingNodeConstraintsHRefined,
 					 vselfBinsManagerHRefined);
 	    forcePtr->printAtomsForces();
 	}
@@ -748,17 +786,17 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 				    d_gradPseudoVLocAtoms,
 				    d_noConstraints,
 				    d_vselfBinsManager,
-				    matrixFreeDataHRefined,
+				    d_matrixFreeDataHRefined,
 				    phiTotDofHandlerIndexHRefined,
 				    phiExtDofHandlerIndexHRefined,
-				    phiTotRhoOutHRefined,
-				    phiExtHRefined,
+				    d_phiTotRhoOutHRefined,
+				    d_phiExtHRefined,
 				    rhoOutHRefinedQuadValues,
 				    gradRhoOutHRefinedQuadValues,
-				    pseudoVLocHRefined,
-				    gradPseudoVLocHRefined,
-				    gradPseudoVLocAtomsHRefined,
-				    onlyHangingNodeConstraints,
+				    d_pseudoVLocHRefined,
+				    d_gradPseudoVLocHRefined,
+				    d_gradPseudoVLocAtomsHRefined,
+				    d_onlyHangingNodeConstraintsHRefined,
 				    vselfBinsManagerHRefined);
 	    forcePtr->printStress();
 	}
@@ -766,4 +804,26 @@ void dftClass<FEOrder>::computeElectrostaticEnergyHRefined(const bool computeFor
 	computing_timer.exit_section("Cell stress computation");
       }
 #endif
+
+    //
+    //free the h refined data structures if they are not reused in the next call
+    //
+    if (!reuseHRefinedData)
+      {
+	d_matrixFreeDataHRefined.clear();
+	d_phiTotRhoOutHRefined.reinit(0);
+	d_phiExtHRefined.reinit(0);
+	d_localVselfsHRefined.clear();
+	d_atomHRefinedNodeIdToChargeMap.clear();
+	d_pseudoVLocHRefined.clear();
+	d_gradPseudoVLocHRefined.clear();
+	d_gradPseudoVLocAtomsHRefined.clear();
+	d_constraintsVectorHRefined.clear();
+	d_dofHandlerVectorHRefined.clear();
+	d_constraintsForTotalPotentialHRefined.clear();
+	d_constraintsHRefined.clear();
+	d_onlyHangingNodeConstraintsHRefined.clear();
+	d_dofHandlerHRefined.clear();
+	d_mesh.clearSubdividedElectrostaticsMesh();
+      }
 }
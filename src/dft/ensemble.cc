@@ -0,0 +1,261 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+//
+//Ensemble of structures sharing the same input parameters, solved one after the other in a single launch
+//
+
+namespace internalEnsemble
+{
+  //
+  //reads the rows (atomic coordinates file name, domain vectors file name) of the ensemble structures file.
+  //Relative file names are taken with respect to the directory of the ensemble structures file.
+  //
+  void readStructuresList(const std::string & fileName,
+			  std::vector<std::pair<std::string,std::string> > & structures)
+  {
+    structures.clear();
+    std::ifstream inputFile(fileName.c_str());
+    AssertThrow(inputFile.is_open(),ExcMessage("DFT-FE Error: could not open the ENSEMBLE STRUCTURES FILE: "+fileName));
+
+    const std::string::size_type lastSlashPosition=fileName.find_last_of('/');
+    const std::string directory=lastSlashPosition==std::string::npos?"":fileName.substr(0,lastSlashPosition+1);
+
+    std::string line;
+    while (std::getline(inputFile,line))
+      {
+	std::istringstream lineStream(line);
+	std::string coordinatesFile, domainVectorsFile;
+	if (!(lineStream>>coordinatesFile))
+	  continue;
+
+	AssertThrow(static_cast<bool>(lineStream>>domainVectorsFile),
+		    ExcMessage("DFT-FE Error: each row of the ENSEMBLE STRUCTURES FILE must contain an atomic coordinates file name and a domain vectors file name."));
+	if (coordinatesFile[0]!='/')
+	  coordinatesFile=directory+coordinatesFile;
+	if (domainVectorsFile[0]!='/')
+	  domainVectorsFile=directory+domainVectorsFile;
+	structures.push_back(std::make_pair(coordinatesFile,domainVectorsFile));
+      }
+
+    AssertThrow(!structures.empty(),ExcMessage("DFT-FE Error: ENSEMBLE STRUCTURES FILE is empty."));
+  }
+
+  //
+  //The ground-state of one structure can be used as the starting guess of another structure only if both
+  //have the same atoms (atomic and valence charges in the same order) and the same domain vectors, as
+  //the ground-state fields are interpolated from the mesh of one structure to the mesh of the other
+  //
+  bool isCompatible(const std::vector<std::vector<double> > & atomLocations1,
+		    const std::vector<std::vector<double> > & domainVectors1,
+		    const std::vector<std::vector<double> > & atomLocations2,
+		    const std::vector<std::vector<double> > & domainVectors2)
+  {
+    if (atomLocations1.size()!=atomLocations2.size())
+      return false;
+
+    for (unsigned int iAtom=0; iAtom<atomLocations1.size(); ++iAtom)
+      if (std::abs(atomLocations1[iAtom][0]-atomLocations2[iAtom][0])>1e-8
+	  || std::abs(atomLocations1[iAtom][1]-atomLocations2[iAtom][1])>1e-8)
+	return false;
+
+    for (unsigned int i=0; i<3; ++i)
+      for (unsigned int j=0; j<3; ++j)
+	if (std::abs(domainVectors1[i][j]-domainVectors2[i][j])>1e-8)
+	  return false;
+
+    return true;
+  }
+
+  //
+  //maximum atomic displacement magnitude between two compatible structures. In the periodic case the
+  //fractional coordinate differences are wrapped to the nearest periodic image.
+  //
+  double maximumDisplacement(const std::vector<std::vector<double> > & atomLocations1,
+			     const std::vector<std::vector<double> > & atomLocations2,
+			     const std::vector<std::vector<double> > & domainVectors)
+  {
+    const bool periodicBc[3]={dftParameters::periodicX,dftParameters::periodicY,dftParameters::periodicZ};
+    const bool isPeriodic=periodicBc[0] || periodicBc[1] || periodicBc[2];
+
+    double maxDisplacement=0.0;
+    for (unsigned int iAtom=0; iAtom<atomLocations1.size(); ++iAtom)
+      {
+	double displacement[3];
+	for (unsigned int idim=0; idim<3; ++idim)
+	  displacement[idim]=atomLocations2[iAtom][2+idim]-atomLocations1[iAtom][2+idim];
+
+	if (isPeriodic)
+	  {
+	    double fractionalDisplacement[3];
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      fractionalDisplacement[idim]=periodicBc[idim]?
+		                           displacement[idim]-std::round(displacement[idim])
+					   :displacement[idim];
+
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      {
+		displacement[idim]=0.0;
+		for (unsigned int jdim=0; jdim<3; ++jdim)
+		  displacement[idim]+=fractionalDisplacement[jdim]*domainVectors[jdim][idim];
+	      }
+	  }
+
+	maxDisplacement=std::max(maxDisplacement,
+				 std::sqrt(displacement[0]*displacement[0]
+					   +displacement[1]*displacement[1]
+					   +displacement[2]*displacement[2]));
+      }
+
+    return maxDisplacement;
+  }
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::runEnsemble()
+{
+  std::vector<std::pair<std::string,std::string> > structures;
+  internalEnsemble::readStructuresList(dftParameters::ensembleStructuresFile,
+				       structures);
+  const unsigned int numberStructures=structures.size();
+
+  std::vector<std::vector<std::vector<double> > > structuresAtomLocations(numberStructures);
+  std::vector<std::vector<std::vector<double> > > structuresDomainVectors(numberStructures);
+  for (unsigned int istruct=0; istruct<numberStructures; ++istruct)
+    {
+      dftUtils::readFile(5,
+			 structuresAtomLocations[istruct],
+			 structures[istruct].first);
+      dftUtils::readFile(3,
+			 structuresDomainVectors[istruct],
+			 structures[istruct].second);
+      AssertThrow(structuresDomainVectors[istruct].size()==3,
+		  ExcMessage("DFT-FE Error: The number of domain bounding vectors read from "+structures[istruct].second+" should be 3."));
+    }
+
+  //
+  //order the structures such that each structure is preceded by the most similar (smallest maximum atomic
+  //displacement) compatible structure among the remaining ones, starting from the first structure in the list.
+  //The ground-state of the preceding structure is used as the starting guess.
+  //
+  std::vector<unsigned int> structuresOrder(1,0);
+  std::vector<bool> isStructureOrdered(numberStructures,false);
+  isStructureOrdered[0]=true;
+  while (structuresOrder.size()<numberStructures)
+    {
+      const unsigned int lastStructure=structuresOrder.back();
+      int nextStructure=-1;
+      double minDisplacement=std::numeric_limits<double>::max();
+      for (unsigned int istruct=0; istruct<numberStructures; ++istruct)
+	if (!isStructureOrdered[istruct]
+	    && internalEnsemble::isCompatible(structuresAtomLocations[lastStructure],
+					      structuresDomainVectors[lastStructure],
+					      structuresAtomLocations[istruct],
+					      structuresDomainVectors[istruct]))
+	  {
+	    const double displacement=internalEnsemble::maximumDisplacement(structuresAtomLocations[lastStructure],
+									    structuresAtomLocations[istruct],
+									    structuresDomainVectors[istruct]);
+	    if (displacement<minDisplacement)
+	      {
+		minDisplacement=displacement;
+		nextStructure=istruct;
+	      }
+	  }
+
+      if (nextStructure==-1)
+	nextStructure=std::find(isStructureOrdered.begin(),isStructureOrdered.end(),false)-isStructureOrdered.begin();
+
+      structuresOrder.push_back(nextStructure);
+      isStructureOrdered[nextStructure]=true;
+    }
+
+  pcout<<std::endl<<"Starting ensemble of "<<numberStructures<<" structures..."<<std::endl;
+  for (unsigned int istep=0; istep<numberStructures; ++istep)
+    {
+      const unsigned int istruct=structuresOrder[istep];
+
+      //
+      //the previous ground-state density (and also the wavefunctions for small atomic displacements) is
+      //interpolated to the mesh of the current structure. Similar to the remeshing during geometry
+      //optimization, this is only done for pseudopotential calculations.
+      //
+      unsigned int usePreviousGroundStateFields=0;
+      if (istep>0
+	  && dftParameters::isPseudopotential
+	  && internalEnsemble::isCompatible(structuresAtomLocations[structuresOrder[istep-1]],
+					    structuresDomainVectors[structuresOrder[istep-1]],
+					    structuresAtomLocations[istruct],
+					    structuresDomainVectors[istruct]))
+	{
+	  const double maxDisplacement=internalEnsemble::maximumDisplacement(structuresAtomLocations[structuresOrder[istep-1]],
+									     structuresAtomLocations[istruct],
+									     structuresDomainVectors[istruct]);
+	  usePreviousGroundStateFields=maxDisplacement<0.1?2:1;
+
+	  //the previous mesh is generated from the atomic positions of the previous structure, so this
+	  //must be done before they are overwritten by set
+	  updatePrevMeshDataStructures();
+	}
+
+      pcout<<std::endl<<"-----------------Ensemble structure: "<<istruct+1<<" ("<<istep+1<<" of "<<numberStructures<<")";
+      if (!dftParameters::reproducible_output)
+	pcout<<", atomic coordinates file: "<<structures[istruct].first<<", domain vectors file: "<<structures[istruct].second;
+      pcout<<"-----------------"<<std::endl;
+      if (dftParameters::verbosity>=1)
+	pcout<<(usePreviousGroundStateFields==0?"Starting from single atom wavefunctions and electron-density":
+		(usePreviousGroundStateFields==1?"Starting from the ground-state electron-density of the previous structure":
+		 "Starting from the ground-state wavefunctions and electron-density of the previous structure"))<<std::endl;
+
+      dftParameters::coordinatesFile=structures[istruct].first;
+      dftParameters::domainBoundingVectorsFile=structures[istruct].second;
+      dftParameters::natoms=structuresAtomLocations[istruct].size();
+
+      //reset the atomic system data accumulated in set. dftUtils::readFile appends to its output, so the
+      //geometry of the previous structure must be cleared before it is read again
+      numElectrons=0;
+      atomTypes.clear();
+      waveFunctionsVector.clear();
+      d_numEigenValues=dftParameters::numberEigenValues;
+      atomLocations.clear();
+      atomLocationsFractional.clear();
+      d_domainBoundingVectors.clear();
+      d_atomsDisplacementsGaussianRead.clear();
+      d_gaussianMovementAtomsNetDisplacements.clear();
+      d_isAtomsGaussianDisplacementsReadFromFile=false;
+      d_imageIds.clear();
+      d_imageCharges.clear();
+      d_imagePositions.clear();
+      d_globalChargeIdToImageIdMap.clear();
+      d_imageIdsTrunc.clear();
+      d_imageChargesTrunc.clear();
+      d_imagePositionsTrunc.clear();
+      d_globalChargeIdToImageIdMapTrunc.clear();
+
+      set();
+      init(usePreviousGroundStateFields);
+      run();
+
+      if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
+	{
+	  std::ofstream outFile(dftParameters::ensembleEnergiesFile.c_str(),istep==0?std::ios::out:std::ios::app);
+	  outFile<<istruct+1<<" "<<structures[istruct].first<<" "<<structures[istruct].second<<" "
+		 <<std::setprecision(12)<<d_groundStateEnergy<<" "<<usePreviousGroundStateFields<<std::endl;
+	  outFile.close();
+	}
+    }
+
+  pcout<<std::endl<<"...Ensemble of "<<numberStructures<<" structures completed"<<std::endl;
+}
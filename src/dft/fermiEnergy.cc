@@ -268,3 +268,31 @@ void dftClass<FEOrder>::compute_fermienergy_constraintMagnetization(const std::v
      pcout<< "Fermi energy for spin down                                    : "<< fermiEnergyDown<<std::endl;	
     }
 }
+
+//compute number of states above the occupancy cutoff
+template<unsigned int FEOrder>
+unsigned int dftClass<FEOrder>::computeNumberStatesAboveOccupancyCutoff() const
+{
+  if (dftParameters::occupancyCutoff<=0.0)
+    return d_numEigenValues;
+
+  unsigned int numberStatesAboveCutoff=0;
+  for(unsigned int kPoint = 0; kPoint < d_kPointWeights.size(); ++kPoint)
+    for(unsigned int spinIndex = 0; spinIndex < (1+dftParameters::spinPolarized); ++spinIndex)
+      for(unsigned int iWave = numberStatesAboveCutoff; iWave < d_numEigenValues; ++iWave)
+	{
+	  const double eigenValue=eigenValues[kPoint][spinIndex*d_numEigenValues+iWave];
+	  double partialOccupancy=dftUtils::getPartialOccupancy(eigenValue,
+								fermiEnergy,
+								C_kb,
+								dftParameters::TVal);
+	  if (dftParameters::constraintMagnetization)
+	    partialOccupancy=(eigenValue>(spinIndex==0?fermiEnergyUp:fermiEnergyDown))?0.0:1.0;
+
+	  if (partialOccupancy>=dftParameters::occupancyCutoff)
+	    numberStatesAboveCutoff=iWave+1;
+	}
+
+  //same truncation on all k point pools
+  return Utilities::MPI::max(numberStatesAboveCutoff, interpoolcomm);
+}
@@ -0,0 +1,405 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+//
+//Extrapolation of the starting electron-density and wavefunctions from the previous
+//ground-states after an atomic position update without remeshing
+//
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::computeAtomicRhoSuperposition(std::map<dealii::CellId, std::vector<double> > & rhoAtomic,
+						      std::map<dealii::CellId, std::vector<double> > & gradRhoAtomic)
+{
+  if (d_atomicRhoSplines.empty())
+    readSingleAtomRhoSplines(d_atomicRhoSplines,
+			     d_atomicRhoOuterMostPoint);
+
+  QGauss<3>  quadrature_formula(C_num1DQuad<FEOrder>());
+  FEValues<3> fe_values (FE, quadrature_formula, update_quadrature_points);
+  const unsigned int n_q_points    = quadrature_formula.size();
+  const bool isGradientRequired=dftParameters::xc_id == 4;
+
+  //
+  //collect atoms and truncated image charges along with their atom types
+  //
+  std::vector<Point<3> > atomPoints;
+  std::vector<unsigned int> atomTypes;
+  for (unsigned int iAtom = 0; iAtom < atomLocations.size(); ++iAtom)
+    {
+      atomPoints.push_back(Point<3>(atomLocations[iAtom][2],atomLocations[iAtom][3],atomLocations[iAtom][4]));
+      atomTypes.push_back(atomLocations[iAtom][0]);
+    }
+
+  for (unsigned int iImageCharge = 0; iImageCharge < d_imageIdsTrunc.size(); ++iImageCharge)
+    {
+      atomPoints.push_back(Point<3>(d_imagePositionsTrunc[iImageCharge][0],
+				    d_imagePositionsTrunc[iImageCharge][1],
+				    d_imagePositionsTrunc[iImageCharge][2]));
+      atomTypes.push_back(atomLocations[d_imageIdsTrunc[iImageCharge]][0]);
+    }
+
+  rhoAtomic.clear();
+  gradRhoAtomic.clear();
+
+  typename DoFHandler<3>::active_cell_iterator cell = dofHandler.begin_active(), endc = dofHandler.end();
+  for (; cell!=endc; ++cell)
+    if (cell->is_locally_owned())
+      {
+	fe_values.reinit(cell);
+	std::vector<double> & rhoAtomicCell=rhoAtomic[cell->id()];
+	rhoAtomicCell.resize(n_q_points,0.0);
+
+	std::vector<double> dummy;
+	std::vector<double> & gradRhoAtomicCell=isGradientRequired?gradRhoAtomic[cell->id()]:dummy;
+	if (isGradientRequired)
+	  gradRhoAtomicCell.resize(3*n_q_points,0.0);
+
+	for (unsigned int q = 0; q < n_q_points; ++q)
+	  {
+	    const Point<3> & quadPoint=fe_values.quadrature_point(q);
+	    for (unsigned int iAtom = 0; iAtom < atomPoints.size(); ++iAtom)
+	      {
+		const double distanceToAtom = quadPoint.distance(atomPoints[iAtom]);
+		if (distanceToAtom > d_atomicRhoOuterMostPoint[atomTypes[iAtom]])
+		  continue;
+
+		double value,radialDensityFirstDerivative,radialDensitySecondDerivative;
+		alglib::spline1ddiff(d_atomicRhoSplines[atomTypes[iAtom]],
+				     distanceToAtom,
+				     value,
+				     radialDensityFirstDerivative,
+				     radialDensitySecondDerivative);
+		rhoAtomicCell[q]+=value;
+
+		if (isGradientRequired && distanceToAtom > 1e-08)
+		  for (unsigned int idim = 0; idim < 3; ++idim)
+		    gradRhoAtomicCell[3*q+idim]+=radialDensityFirstDerivative
+						  *(quadPoint[idim]-atomPoints[iAtom][idim])/distanceToAtom;
+	      }
+	  }
+      }
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::addAtomicRhoSuperposition(std::vector<std::map<dealii::CellId, std::vector<double> > > & rhoFields,
+						  const std::map<dealii::CellId, std::vector<double> > & rhoAtomic,
+						  const std::map<dealii::CellId, std::vector<double> > & gradRhoAtomic,
+						  const double scalingFactor)
+{
+  const bool isGradientRequired=dftParameters::xc_id == 4;
+  const bool isSpinPolarized=dftParameters::spinPolarized==1;
+  const unsigned int n_q_points = QGauss<3>(C_num1DQuad<FEOrder>()).size();
+
+  unsigned int fieldIndex=0;
+  for (auto & cellEntry : rhoFields[fieldIndex])
+    {
+      const std::vector<double> & rhoAtomicCell=rhoAtomic.find(cellEntry.first)->second;
+      for (unsigned int q = 0; q < n_q_points; ++q)
+	cellEntry.second[q]+=scalingFactor*rhoAtomicCell[q];
+    }
+  fieldIndex++;
+
+  if (isGradientRequired)
+    {
+      for (auto & cellEntry : rhoFields[fieldIndex])
+	{
+	  const std::vector<double> & gradRhoAtomicCell=gradRhoAtomic.find(cellEntry.first)->second;
+	  for (unsigned int i = 0; i < 3*n_q_points; ++i)
+	    cellEntry.second[i]+=scalingFactor*gradRhoAtomicCell[i];
+	}
+      fieldIndex++;
+    }
+
+  //the superposition of single atom electron-densities is spin unpolarized
+  if (isSpinPolarized)
+    {
+      for (auto & cellEntry : rhoFields[fieldIndex])
+	{
+	  const std::vector<double> & rhoAtomicCell=rhoAtomic.find(cellEntry.first)->second;
+	  for (unsigned int q = 0; q < n_q_points; ++q)
+	    {
+	      cellEntry.second[2*q]+=0.5*scalingFactor*rhoAtomicCell[q];
+	      cellEntry.second[2*q+1]+=0.5*scalingFactor*rhoAtomicCell[q];
+	    }
+	}
+      fieldIndex++;
+    }
+
+  if (isSpinPolarized && isGradientRequired)
+    {
+      for (auto & cellEntry : rhoFields[fieldIndex])
+	{
+	  const std::vector<double> & gradRhoAtomicCell=gradRhoAtomic.find(cellEntry.first)->second;
+	  for (unsigned int q = 0; q < n_q_points; ++q)
+	    for (unsigned int idim = 0; idim < 3; ++idim)
+	      {
+		cellEntry.second[6*q+idim]+=0.5*scalingFactor*gradRhoAtomicCell[3*q+idim];
+		cellEntry.second[6*q+3+idim]+=0.5*scalingFactor*gradRhoAtomicCell[3*q+idim];
+	      }
+	}
+      fieldIndex++;
+    }
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::storeGroundStateForExtrapolation()
+{
+  if (dftParameters::groundStateExtrapolationOrder>0
+      && dftParameters::mixingMethod != "ANDERSON_WITH_KERKER")
+    {
+      computing_timer.enter_section("ground-state extrapolation");
+
+      std::map<dealii::CellId, std::vector<double> > rhoAtomic, gradRhoAtomic;
+      computeAtomicRhoSuperposition(rhoAtomic,
+				    gradRhoAtomic);
+
+      std::vector<std::map<dealii::CellId, std::vector<double> > > rhoDiff;
+      rhoDiff.push_back(*rhoOutValues);
+      if (dftParameters::xc_id == 4)
+	rhoDiff.push_back(*gradRhoOutValues);
+      if (dftParameters::spinPolarized==1)
+	rhoDiff.push_back(*rhoOutValuesSpinPolarized);
+      if (dftParameters::spinPolarized==1 && dftParameters::xc_id == 4)
+	rhoDiff.push_back(*gradRhoOutValuesSpinPolarized);
+
+      addAtomicRhoSuperposition(rhoDiff,
+				rhoAtomic,
+				gradRhoAtomic,
+				-1.0);
+
+      d_groundStateRhoDiffHistory.push_front(rhoDiff);
+      if (d_groundStateRhoDiffHistory.size()>dftParameters::groundStateExtrapolationOrder+1)
+	d_groundStateRhoDiffHistory.pop_back();
+
+      computing_timer.exit_section("ground-state extrapolation");
+    }
+
+  d_isGroundStateExtrapolationPending=true;
+}
+
+template<unsigned int FEOrder>
+bool dftClass<FEOrder>::extrapolateRho()
+{
+  const unsigned int historySize=d_groundStateRhoDiffHistory.size();
+  if (historySize==0)
+    return false;
+
+  computing_timer.enter_section("ground-state extrapolation");
+
+  //
+  //polynomial extrapolation coefficients of the previous ground-states (latest first)
+  //
+  std::vector<double> coeffs;
+  if (historySize==1)
+    coeffs={1.0};
+  else if (historySize==2)
+    coeffs={2.0,-1.0};
+  else
+    coeffs={3.0,-3.0,1.0};
+
+  std::vector<std::map<dealii::CellId, std::vector<double> > > rhoFields=d_groundStateRhoDiffHistory[0];
+  for (unsigned int ifield = 0; ifield < rhoFields.size(); ++ifield)
+    for (auto & cellEntry : rhoFields[ifield])
+      {
+	for (unsigned int i = 0; i < cellEntry.second.size(); ++i)
+	  cellEntry.second[i]*=coeffs[0];
+
+	for (unsigned int ihistory = 1; ihistory < coeffs.size(); ++ihistory)
+	  {
+	    const std::vector<double> & rhoDiffCell
+	      =d_groundStateRhoDiffHistory[ihistory][ifield].find(cellEntry.first)->second;
+	    for (unsigned int i = 0; i < cellEntry.second.size(); ++i)
+	      cellEntry.second[i]+=coeffs[ihistory]*rhoDiffCell[i];
+	  }
+      }
+
+  std::map<dealii::CellId, std::vector<double> > rhoAtomic, gradRhoAtomic;
+  computeAtomicRhoSuperposition(rhoAtomic,
+				gradRhoAtomic);
+
+  addAtomicRhoSuperposition(rhoFields,
+			    rhoAtomic,
+			    gradRhoAtomic,
+			    1.0);
+
+  //
+  //copy to rho in after removing negative electron-density values which can arise from the extrapolation
+  //
+  unsigned int fieldIndex=0;
+  *rhoInValues=rhoFields[fieldIndex++];
+  for (auto & cellEntry : *rhoInValues)
+    for (unsigned int i = 0; i < cellEntry.second.size(); ++i)
+      cellEntry.second[i]=std::max(cellEntry.second[i],0.0);
+
+  if (dftParameters::xc_id == 4)
+    *gradRhoInValues=rhoFields[fieldIndex++];
+
+  if (dftParameters::spinPolarized==1)
+    {
+      *rhoInValuesSpinPolarized=rhoFields[fieldIndex++];
+      for (auto & cellEntry : *rhoInValuesSpinPolarized)
+	for (unsigned int i = 0; i < cellEntry.second.size(); ++i)
+	  cellEntry.second[i]=std::max(cellEntry.second[i],0.0);
+    }
+
+  if (dftParameters::spinPolarized==1 && dftParameters::xc_id == 4)
+    *gradRhoInValuesSpinPolarized=rhoFields[fieldIndex++];
+
+  computing_timer.exit_section("ground-state extrapolation");
+
+  if (dftParameters::verbosity>=1)
+    pcout<<"Extrapolated starting electron-density using "<<historySize<<" previous ground-state(s)"<<std::endl;
+
+  normalizeRho();
+
+  return historySize>1;
+}
+
+template<unsigned int FEOrder>
+bool dftClass<FEOrder>::extrapolateSubspace()
+{
+  bool isPreviousSubspaceValid=d_eigenVectorsFlattenedSTLPrevious.size()==d_eigenVectorsFlattenedSTL.size();
+  for (unsigned int i = 0; i < d_eigenVectorsFlattenedSTLPrevious.size() && isPreviousSubspaceValid; ++i)
+    if (d_eigenVectorsFlattenedSTLPrevious[i].size()!=d_eigenVectorsFlattenedSTL[i].size())
+      isPreviousSubspaceValid=false;
+
+  if (!isPreviousSubspaceValid)
+    {
+      d_eigenVectorsFlattenedSTLPrevious=d_eigenVectorsFlattenedSTL;
+      return false;
+    }
+
+  computing_timer.enter_section("ground-state extrapolation");
+
+  //
+  //The wavefunctions of a kPoint and spin are stored as a numberEigenValues x numberLocalDofs
+  //column major matrix X. The previous subspace Xp is aligned to the current subspace by the
+  //unitary rotation U=(M M^H)^{-1/2} M minimizing ||X-U Xp||, with the overlap M=X Xp^H
+  //approximated by the Euclidean inner product of the FE nodal coefficients. The extrapolated
+  //subspace 2X-U Xp is orthonormalized in the subsequent solveNoSCF call.
+  //
+  const unsigned int N=d_numEigenValues;
+  const char transA = 'N';
+#ifdef USE_COMPLEX
+  const char transB = 'C';
+  const dataTypes::number one(1.0,0.0), zero(0.0,0.0), negOne(-1.0,0.0), two(2.0,0.0);
+#else
+  const char transB = 'T';
+  const dataTypes::number one=1.0, zero=0.0, negOne=-1.0, two=2.0;
+#endif
+
+  const unsigned int lwork = 1 + 6*N + 2*N*N, liwork = 3 + 5*N;
+  std::vector<int> iwork(liwork,0);
+  const char jobz='V', uplo='U';
+  int info;
+#ifdef USE_COMPLEX
+  const unsigned int lrwork = 1 + 5*N + 2*N*N;
+  std::vector<double> rwork(lrwork,0.0);
+#endif
+  std::vector<dataTypes::number> work(lwork);
+
+  for (unsigned int kPointSpin = 0; kPointSpin < d_eigenVectorsFlattenedSTL.size(); ++kPointSpin)
+    {
+      std::vector<dataTypes::number> & X=d_eigenVectorsFlattenedSTL[kPointSpin];
+      std::vector<dataTypes::number> & Xp=d_eigenVectorsFlattenedSTLPrevious[kPointSpin];
+      const unsigned int numberLocalDofs=X.size()/N;
+
+      //M=X Xp^H
+      std::vector<dataTypes::number> overlap(N*N,zero);
+      if (numberLocalDofs>0)
+#ifdef USE_COMPLEX
+	zgemm_(&transA,&transB,&N,&N,&numberLocalDofs,&one,&X[0],&N,&Xp[0],&N,&zero,&overlap[0],&N);
+#else
+	dgemm_(&transA,&transB,&N,&N,&numberLocalDofs,&one,&X[0],&N,&Xp[0],&N,&zero,&overlap[0],&N);
+#endif
+
+      MPI_Allreduce(MPI_IN_PLACE,
+		    &overlap[0],
+		    N*N,
+		    dataTypes::mpi_type_id(&overlap[0]),
+		    MPI_SUM,
+		    mpi_communicator);
+
+      //eigen decomposition of M M^H
+      std::vector<dataTypes::number> overlapSquare(N*N,zero);
+      std::vector<double> eigenValuesOverlapSquare(N,0.0);
+#ifdef USE_COMPLEX
+      zgemm_(&transA,&transB,&N,&N,&N,&one,&overlap[0],&N,&overlap[0],&N,&zero,&overlapSquare[0],&N);
+      zheevd_(&jobz, &uplo, &N, &overlapSquare[0], &N, &eigenValuesOverlapSquare[0], &work[0], &lwork, &rwork[0], &lrwork, &iwork[0], &liwork, &info);
+#else
+      dgemm_(&transA,&transB,&N,&N,&N,&one,&overlap[0],&N,&overlap[0],&N,&zero,&overlapSquare[0],&N);
+      dsyevd_(&jobz, &uplo, &N, &overlapSquare[0], &N, &eigenValuesOverlapSquare[0], &work[0], &lwork, &iwork[0], &liwork, &info);
+#endif
+      AssertThrow(info==0,ExcMessage("DFT-FE Error: eigen decomposition failed in the subspace alignment of the wavefunction extrapolation."));
+
+      //(M M^H)^{-1/2}=V D^{-1/2} V^H, with the directions of vanishing overlap discarded
+      const double eigenValueTol=1e-12*std::max(eigenValuesOverlapSquare[N-1],1e-300);
+      std::vector<dataTypes::number> scaledEigenVectors=overlapSquare;
+      for (unsigned int j = 0; j < N; ++j)
+	{
+	  const double scaling=eigenValuesOverlapSquare[j]>eigenValueTol?1.0/std::sqrt(eigenValuesOverlapSquare[j]):0.0;
+	  for (unsigned int i = 0; i < N; ++i)
+	    scaledEigenVectors[j*N+i]*=scaling;
+	}
+
+      std::vector<dataTypes::number> invSqrtOverlapSquare(N*N,zero);
+      std::vector<dataTypes::number> rotation(N*N,zero);
+#ifdef USE_COMPLEX
+      zgemm_(&transA,&transB,&N,&N,&N,&one,&scaledEigenVectors[0],&N,&overlapSquare[0],&N,&zero,&invSqrtOverlapSquare[0],&N);
+      zgemm_(&transA,&transA,&N,&N,&N,&one,&invSqrtOverlapSquare[0],&N,&overlap[0],&N,&zero,&rotation[0],&N);
+#else
+      dgemm_(&transA,&transB,&N,&N,&N,&one,&scaledEigenVectors[0],&N,&overlapSquare[0],&N,&zero,&invSqrtOverlapSquare[0],&N);
+      dgemm_(&transA,&transA,&N,&N,&N,&one,&invSqrtOverlapSquare[0],&N,&overlap[0],&N,&zero,&rotation[0],&N);
+#endif
+
+      //X=2X-U Xp, and the current X becomes the previous subspace
+      std::vector<dataTypes::number> Xcurrent=X;
+      if (numberLocalDofs>0)
+#ifdef USE_COMPLEX
+	zgemm_(&transA,&transA,&N,&numberLocalDofs,&N,&negOne,&rotation[0],&N,&Xp[0],&N,&two,&X[0],&N);
+#else
+	dgemm_(&transA,&transA,&N,&numberLocalDofs,&N,&negOne,&rotation[0],&N,&Xp[0],&N,&two,&X[0],&N);
+#endif
+      Xp.swap(Xcurrent);
+    }
+
+  computing_timer.exit_section("ground-state extrapolation");
+
+  if (dftParameters::verbosity>=1)
+    pcout<<"Extrapolated starting wavefunctions from the previous two ground-states"<<std::endl;
+
+  return true;
+}
+
+template<unsigned int FEOrder>
+bool dftClass<FEOrder>::isGroundStateExtrapolationDataAvailable() const
+{
+  const bool isRhoHistoryAvailable=dftParameters::groundStateExtrapolationOrder>0
+				   && dftParameters::mixingMethod != "ANDERSON_WITH_KERKER"
+				   && !d_groundStateRhoDiffHistory.empty();
+
+  const bool isSubspaceHistoryAvailable=dftParameters::extrapolateWfcGeoOpt
+					&& !d_eigenVectorsFlattenedSTLPrevious.empty();
+
+  return d_isGroundStateExtrapolationPending && (isRhoHistoryAvailable || isSubspaceHistoryAvailable);
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::clearGroundStateExtrapolationHistory()
+{
+  d_groundStateRhoDiffHistory.clear();
+  d_eigenVectorsFlattenedSTLPrevious.clear();
+  d_isGroundStateExtrapolationPending=false;
+}
@@ -211,6 +211,8 @@ void dftClass<FEOrder>::initBoundaryConditions(){
       dftUtils::printCurrentMemoryUsage(mpi_communicator,
 	                      "Called force init moved");
 
+  //the flattened partitioners and index maps of the previous matrix free data are invalid
+  d_flattenedArrayRegistry.clear();
   matrix_free_data.reinit(dofHandlerVector, d_constraintsVector, quadratureVector, additional_data);
 
   if (dftParameters::verbosity>=4)
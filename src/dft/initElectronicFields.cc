@@ -40,8 +40,7 @@ void dftClass<FEOrder>::initPsiAndRhoFromPreviousGroundStatePsi(std::vector<std:
 
      pcout <<std::endl<< "Interpolating previous groundstate PSI into the new finite element mesh...."<<std::endl;
      vectorTools::interpolateFieldsFromPreviousMesh interpolateEigenVecPrev(mpi_communicator);
-     interpolateEigenVecPrev.interpolate(d_mesh.getSerialMeshUnmovedPrevious(),
-	                         d_mesh.getParallelMeshUnmovedPrevious(),
+     interpolateEigenVecPrev.interpolate(d_mesh.getParallelMeshUnmovedPrevious(),
 				 d_mesh.getParallelMeshUnmoved(),
 				 FEEigen,
 				 FEEigen,
@@ -234,6 +233,19 @@ void dftClass<FEOrder>::initElectronicFields(const unsigned int usePreviousGroun
       }
   }
 
+  double wavefunctionsBytes=0.0, rotatedFractionalWavefunctionsBytes=0.0;
+  for(unsigned int kPoint = 0; kPoint < d_eigenVectorsFlattenedSTL.size(); ++kPoint)
+    wavefunctionsBytes+=memoryLedger::getBytes(d_eigenVectorsFlattenedSTL[kPoint]);
+  for(unsigned int kPoint = 0; kPoint < d_eigenVectorsRotFracDensityFlattenedSTL.size(); ++kPoint)
+    rotatedFractionalWavefunctionsBytes+=memoryLedger::getBytes(d_eigenVectorsRotFracDensityFlattenedSTL[kPoint]);
+
+  memoryLedger::setBytes(memoryLedger::wavefunctions,
+			 "flattened wavefunctions",
+			 wavefunctionsBytes);
+  memoryLedger::setBytes(memoryLedger::rotatedFractionalWavefunctions,
+			 "flattened rotated fractional wavefunctions",
+			 rotatedFractionalWavefunctionsBytes);
+
   if  (dftParameters::isIonOpt && (dftParameters::reuseWfcGeoOpt || dftParameters::reuseDensityGeoOpt))
     updatePrevMeshDataStructures();
 
@@ -252,12 +264,12 @@ void dftClass<FEOrder>::updatePrevMeshDataStructures()
 					      constraintsNoneEigen);
 
   //
-  //update serial and parallel unmoved previous mesh
+  //update parallel unmoved previous mesh
   //
-  d_mesh.generateSerialAndParallelUnmovedPreviousMesh(atomLocations,
-						      d_imagePositions,
-						      d_domainBoundingVectors);
+  d_mesh.generateParallelUnmovedPreviousMesh(atomLocations,
+					     d_imagePositions,
+					     d_domainBoundingVectors);
  if (dftParameters::verbosity>=4)
    dftUtils::printCurrentMemoryUsage(mpi_communicator,
-			  "Serial and parallel prev mesh generated");
+			  "Parallel prev mesh generated");
 }
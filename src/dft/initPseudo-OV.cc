@@ -57,15 +57,13 @@ void dftClass<FEOrder>::computeElementalOVProjectorKets()
 
 
   //
-  //preallocate element Matrices
+  //preallocate element Matrices, which are only kept until they are flattened into the cell slab
   //
-  d_nonLocalProjectorElementMatrices.clear();
-  d_nonLocalProjectorElementMatricesConjugate.clear();
-  d_nonLocalProjectorElementMatricesTranspose.clear();
-
-  d_nonLocalProjectorElementMatrices.resize(numberNonLocalAtoms);
-  d_nonLocalProjectorElementMatricesConjugate.resize(numberNonLocalAtoms);
-  d_nonLocalProjectorElementMatricesTranspose.resize(numberNonLocalAtoms);
+#ifdef USE_COMPLEX
+  std::vector<std::vector<std::vector<std::vector<std::complex<double> > > > > nonLocalProjectorElementMatrices(numberNonLocalAtoms);
+#else
+  std::vector<std::vector<std::vector<double> > > nonLocalProjectorElementMatrices(numberNonLocalAtoms);
+#endif
 
   std::vector<double> nonLocalProjectorBasisReal(maxkPoints*numberQuadraturePoints,0.0);
   std::vector<double> nonLocalProjectorBasisImag(maxkPoints*numberQuadraturePoints,0.0);
@@ -105,9 +103,7 @@ void dftClass<FEOrder>::computeElementalOVProjectorKets()
       //
       //allocate element Matrices
       //
-      d_nonLocalProjectorElementMatrices[iAtom].resize(numberElementsInAtomCompactSupport);
-      d_nonLocalProjectorElementMatricesConjugate[iAtom].resize(numberElementsInAtomCompactSupport);
-      d_nonLocalProjectorElementMatricesTranspose[iAtom].resize(numberElementsInAtomCompactSupport);
+      nonLocalProjectorElementMatrices[iAtom].resize(numberElementsInAtomCompactSupport);
 
 
       for(int iElemComp = 0; iElemComp < numberElementsInAtomCompactSupport; ++iElemComp)
@@ -119,29 +115,16 @@ void dftClass<FEOrder>::computeElementalOVProjectorKets()
 	  fe_values.reinit(cell);
 
 #ifdef USE_COMPLEX
-	  d_nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(maxkPoints,
-								      std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
-	  d_nonLocalProjectorElementMatricesConjugate[iAtom][iElemComp].resize(maxkPoints,
-									       std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
-	  d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp].resize(maxkPoints,
-									       std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
-
-          std::vector<std::vector<std::complex<double> > > & nonLocalProjectorElementMatricesAtomElem=d_nonLocalProjectorElementMatrices[iAtom][iElemComp];
+	  nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(maxkPoints,
+								    std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
 
-	  std::vector<std::vector<std::complex<double> > > & nonLocalProjectorElementMatricesConjugateAtomElem=d_nonLocalProjectorElementMatricesConjugate[iAtom][iElemComp];
-
-	  std::vector<std::vector<std::complex<double> > > & nonLocalProjectorElementMatricesTransposeAtomElem=d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp];
+          std::vector<std::vector<std::complex<double> > > & nonLocalProjectorElementMatricesAtomElem=nonLocalProjectorElementMatrices[iAtom][iElemComp];
 
 #else
-	  d_nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(numberNodesPerElement*numberPseudoWaveFunctions,0.0);
-	  d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp].resize(numberNodesPerElement*numberPseudoWaveFunctions,0.0);
+	  nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(numberNodesPerElement*numberPseudoWaveFunctions,0.0);
 
           std::vector<double> & nonLocalProjectorElementMatricesAtomElem
-	    =d_nonLocalProjectorElementMatrices[iAtom][iElemComp];
-
-
-          std::vector<double> & nonLocalProjectorElementMatricesTransposeAtomElem
-	    =d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp];
+	    =nonLocalProjectorElementMatrices[iAtom][iElemComp];
 
 
 #endif
@@ -288,24 +271,11 @@ void dftClass<FEOrder>::computeElementalOVProjectorKets()
 			    [numberNodesPerElement*iPseudoWave + iNode]
 			    += nonLocalProjectorBasisReal[maxkPoints*iQuadPoint]*shapeval*jxw;
 
-			  nonLocalProjectorElementMatricesTransposeAtomElem
-			    [numberPseudoWaveFunctions*iNode+iPseudoWave]
-			    += nonLocalProjectorBasisReal[maxkPoints*iQuadPoint]*shapeval*jxw;
-
 #endif
 			}
 #ifdef USE_COMPLEX
 		      nonLocalProjectorElementMatricesAtomElem[kPoint][numberNodesPerElement*iPseudoWave + iNode].real(tempReal);
 		      nonLocalProjectorElementMatricesAtomElem[kPoint][numberNodesPerElement*iPseudoWave + iNode].imag(tempImag);
-
-		      nonLocalProjectorElementMatricesConjugateAtomElem[kPoint][numberNodesPerElement*iPseudoWave + iNode].real(tempReal);
-		      nonLocalProjectorElementMatricesConjugateAtomElem[kPoint][numberNodesPerElement*iPseudoWave + iNode].imag(-tempImag);
-
-		      nonLocalProjectorElementMatricesTransposeAtomElem[kPoint]
-			[numberPseudoWaveFunctions*iNode+iPseudoWave].real(tempReal);
-		      nonLocalProjectorElementMatricesTransposeAtomElem[kPoint]
-			[numberPseudoWaveFunctions*iNode+iPseudoWave].imag(tempImag);
-
 #endif
 		    }
 
@@ -324,7 +294,132 @@ void dftClass<FEOrder>::computeElementalOVProjectorKets()
   //Add mpi accumulation
   //
 
+  flattenElementalProjectorKets(nonLocalProjectorElementMatrices);
+
+}
+
+template<unsigned int FEOrder>
+#ifdef USE_COMPLEX
+void dftClass<FEOrder>::flattenElementalProjectorKets(const std::vector<std::vector<std::vector<std::vector<std::complex<double> > > > > & nonLocalProjectorElementMatrices)
+#else
+void dftClass<FEOrder>::flattenElementalProjectorKets(const std::vector<std::vector<std::vector<double> > > & nonLocalProjectorElementMatrices)
+#endif
+{
+  const unsigned int numberNodesPerElement  = FE.dofs_per_cell;
+  const unsigned int numberLocallyOwnedCells = d_nonLocalAtomIdsInElement.size();
+#ifdef USE_COMPLEX
+  const unsigned int maxkPoints = d_kPointWeights.size();
+#else
+  const unsigned int maxkPoints = 1;
+#endif
+
+  const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & projectorPartitioner
+    =d_projectorKetTimesVectorPar[0].get_partitioner();
+
+  //
+  //CSR offsets of the projectors touching each locally owned cell
+  //
+  d_nonLocalProjectorCellStartIds.assign(numberLocallyOwnedCells+1,0);
+  for(unsigned int iElem = 0; iElem < numberLocallyOwnedCells; ++iElem)
+    {
+      unsigned int numberCellProjectors=0;
+      for(unsigned int iAtom = 0; iAtom < d_nonLocalAtomIdsInElement[iElem].size(); ++iAtom)
+	numberCellProjectors+=d_numberPseudoAtomicWaveFunctions[d_nonLocalAtomIdsInElement[iElem][iAtom]];
+
+      d_nonLocalProjectorCellStartIds[iElem+1]=d_nonLocalProjectorCellStartIds[iElem]+numberCellProjectors;
+    }
+
+  const unsigned int numberCellProjectorsTotal=d_nonLocalProjectorCellStartIds[numberLocallyOwnedCells];
+  const dealii::types::global_dof_index slabSizePerkPoint
+    =(dealii::types::global_dof_index)numberCellProjectorsTotal*numberNodesPerElement;
+
+  d_nonLocalProjectorCellLocalIds.resize(numberCellProjectorsTotal);
+  d_nonLocalProjectorAtomElemCellIds.resize(d_sparsityPattern.size());
+  for(unsigned int iAtom = 0; iAtom < d_sparsityPattern.size(); ++iAtom)
+    d_nonLocalProjectorAtomElemCellIds[iAtom].resize(nonLocalProjectorElementMatrices[iAtom].size());
+  d_nonLocalProjectorElementMatricesCellFlattened.resize(maxkPoints*slabSizePerkPoint);
+#ifdef USE_COMPLEX
+  d_nonLocalProjectorElementMatricesConjugateCellFlattened.resize(maxkPoints*slabSizePerkPoint);
+#endif
+
+  for(unsigned int iElem = 0; iElem < numberLocallyOwnedCells; ++iElem)
+    {
+      unsigned int cellProjectorId=d_nonLocalProjectorCellStartIds[iElem];
+      for(unsigned int iAtom = 0; iAtom < d_nonLocalAtomIdsInElement[iElem].size(); ++iAtom)
+	{
+	  const unsigned int atomId=d_nonLocalAtomIdsInElement[iElem][iAtom];
+	  const unsigned int numberPseudoWaveFunctions=d_numberPseudoAtomicWaveFunctions[atomId];
+	  const int nonZeroElementMatrixId=d_sparsityPattern[atomId][iElem];
+	  d_nonLocalProjectorAtomElemCellIds[atomId][nonZeroElementMatrixId]=cellProjectorId;
+
+	  for(unsigned int iPseudoWave = 0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+	    {
+	      d_nonLocalProjectorCellLocalIds[cellProjectorId]
+		=projectorPartitioner->global_to_local(d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoWave)]);
+
+	      for(unsigned int kPoint = 0; kPoint < maxkPoints; ++kPoint)
+		for(unsigned int iNode = 0; iNode < numberNodesPerElement; ++iNode)
+		  {
+		    const dealii::types::global_dof_index slabId
+		      =kPoint*slabSizePerkPoint+(dealii::types::global_dof_index)cellProjectorId*numberNodesPerElement+iNode;
+#ifdef USE_COMPLEX
+		    const std::complex<double> value
+		      =nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][kPoint][numberNodesPerElement*iPseudoWave+iNode];
+		    d_nonLocalProjectorElementMatricesCellFlattened[slabId]=value;
+		    d_nonLocalProjectorElementMatricesConjugateCellFlattened[slabId]=std::conj(value);
+#else
+		    d_nonLocalProjectorElementMatricesCellFlattened[slabId]
+		      =nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][numberNodesPerElement*iPseudoWave+iNode];
+#endif
+		  }
+
+	      cellProjectorId++;
+	    }
+	}
+    }
+
+  memoryLedger::setBytes(memoryLedger::projectorMatrices,
+			 "flattened cell projector matrices",
+#ifdef USE_COMPLEX
+			 memoryLedger::getBytes(d_nonLocalProjectorElementMatricesConjugateCellFlattened)+
+#endif
+			 memoryLedger::getBytes(d_nonLocalProjectorElementMatricesCellFlattened));
+
+  //
+  //local indices and constants of the projectors of the nonlocal atoms in the current processor
+  //
+  d_nonLocalProjectorLocalIdsCurrentProcess.clear();
+  d_nonLocalProjectorConstantsCurrentProcess.clear();
+  for(unsigned int iAtom = 0; iAtom < d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
+    {
+      const unsigned int atomId=d_nonLocalAtomIdsInCurrentProcess[iAtom];
+      for(unsigned int iPseudoWave = 0; iPseudoWave < d_numberPseudoAtomicWaveFunctions[atomId]; ++iPseudoWave)
+	{
+	  d_nonLocalProjectorLocalIdsCurrentProcess.push_back
+	    (projectorPartitioner->global_to_local(d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoWave)]));
+	  d_nonLocalProjectorConstantsCurrentProcess.push_back(d_nonLocalPseudoPotentialConstants[atomId][iPseudoWave]);
+	}
+    }
+}
+
+template<unsigned int FEOrder>
+const dataTypes::number * dftClass<FEOrder>::getNonLocalProjectorElementMatrix(const unsigned int atomId,
+									     const unsigned int nonZeroElementMatrixId,
+									     const unsigned int kPointIndex) const
+{
+  const unsigned int numberNodesPerElement  = FE.dofs_per_cell;
+  const dealii::types::global_dof_index slabSizePerkPoint
+    =(dealii::types::global_dof_index)d_nonLocalProjectorCellStartIds.back()*numberNodesPerElement;
+#ifdef USE_COMPLEX
+  const dealii::types::global_dof_index kPointOffset=kPointIndex*slabSizePerkPoint;
+#else
+  const dealii::types::global_dof_index kPointOffset=0;
+#endif
+
+  return d_nonLocalProjectorElementMatricesCellFlattened.begin()+kPointOffset
+         +(dealii::types::global_dof_index)d_nonLocalProjectorAtomElemCellIds[atomId][nonZeroElementMatrixId]*numberNodesPerElement;
 }
+
 template<unsigned int FEOrder>
 void dftClass<FEOrder>::initNonLocalPseudoPotential_OV()
 {
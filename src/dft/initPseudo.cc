@@ -1168,15 +1168,14 @@ void dftClass<FEOrder>::computeElementalProjectorKets()
 
 
   //
-  //preallocate element Matrices
+  //preallocate element Matrices, which are only kept until they are flattened into the cell slab
   //
-  d_nonLocalProjectorElementMatrices.clear();
-  d_nonLocalProjectorElementMatricesConjugate.clear();
-  d_nonLocalProjectorElementMatricesTranspose.clear();
+#ifdef USE_COMPLEX
+  std::vector<std::vector<std::vector<std::vector<std::complex<double> > > > > nonLocalProjectorElementMatrices(numberNonLocalAtoms);
+#else
+  std::vector<std::vector<std::vector<double> > > nonLocalProjectorElementMatrices(numberNonLocalAtoms);
+#endif
   d_nonLocalPseudoPotentialConstants.clear();
-  d_nonLocalProjectorElementMatrices.resize(numberNonLocalAtoms);
-  d_nonLocalProjectorElementMatricesConjugate.resize(numberNonLocalAtoms);
-  d_nonLocalProjectorElementMatricesTranspose.resize(numberNonLocalAtoms);
   d_nonLocalPseudoPotentialConstants.resize(numberNonLocalAtoms);
   int cumulativePotSplineId = 0;
   int cumulativeWaveSplineId = 0;
@@ -1220,9 +1219,7 @@ void dftClass<FEOrder>::computeElementalProjectorKets()
       //
       //allocate element Matrices
       //
-      d_nonLocalProjectorElementMatrices[iAtom].resize(numberElementsInAtomCompactSupport);
-      d_nonLocalProjectorElementMatricesConjugate[iAtom].resize(numberElementsInAtomCompactSupport);
-      d_nonLocalProjectorElementMatricesTranspose[iAtom].resize(numberElementsInAtomCompactSupport);
+      nonLocalProjectorElementMatrices[iAtom].resize(numberElementsInAtomCompactSupport);
       d_nonLocalPseudoPotentialConstants[iAtom].resize(numberPseudoWaveFunctions,0.0);
 
       for(int iElemComp = 0; iElemComp < numberElementsInAtomCompactSupport; ++iElemComp)
@@ -1234,15 +1231,10 @@ void dftClass<FEOrder>::computeElementalProjectorKets()
 	  fe_values.reinit(cell);
 
 #ifdef USE_COMPLEX
-	  d_nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(maxkPoints,
-								      std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
-	  d_nonLocalProjectorElementMatricesConjugate[iAtom][iElemComp].resize(maxkPoints,
-									       std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
-	  d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp].resize(maxkPoints,
-									       std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
+	  nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(maxkPoints,
+								    std::vector<std::complex<double> > (numberNodesPerElement*numberPseudoWaveFunctions,0.0));
 #else
-	  d_nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(numberNodesPerElement*numberPseudoWaveFunctions,0.0);
-	  d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp].resize(numberNodesPerElement*numberPseudoWaveFunctions,0.0);
+	  nonLocalProjectorElementMatrices[iAtom][iElemComp].resize(numberNodesPerElement*numberPseudoWaveFunctions,0.0);
 #endif
 
 	  int iPsp = -1;
@@ -1401,19 +1393,12 @@ void dftClass<FEOrder>::computeElementalProjectorKets()
 			  tempReal += nonLocalProjectorBasisReal[maxkPoints*iQuadPoint+kPoint]*fe_values.shape_value(iNode,iQuadPoint)*fe_values.JxW(iQuadPoint);
 			  tempImag += nonLocalProjectorBasisImag[maxkPoints*iQuadPoint+kPoint]*fe_values.shape_value(iNode,iQuadPoint)*fe_values.JxW(iQuadPoint);
 #else
-			  d_nonLocalProjectorElementMatrices[iAtom][iElemComp][numberNodesPerElement*iPseudoWave + iNode] += nonLocalProjectorBasisReal[maxkPoints*iQuadPoint+kPoint]*fe_values.shape_value(iNode,iQuadPoint)*fe_values.JxW(iQuadPoint);
-
-			d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp][numberPseudoWaveFunctions*iNode+iPseudoWave ] += nonLocalProjectorBasisReal[maxkPoints*iQuadPoint+kPoint]*fe_values.shape_value(iNode,iQuadPoint)*fe_values.JxW(iQuadPoint);
+			  nonLocalProjectorElementMatrices[iAtom][iElemComp][numberNodesPerElement*iPseudoWave + iNode] += nonLocalProjectorBasisReal[maxkPoints*iQuadPoint+kPoint]*fe_values.shape_value(iNode,iQuadPoint)*fe_values.JxW(iQuadPoint);
 #endif
 			}
 #ifdef USE_COMPLEX
-		      d_nonLocalProjectorElementMatrices[iAtom][iElemComp][kPoint][numberNodesPerElement*iPseudoWave + iNode].real(tempReal);
-		      d_nonLocalProjectorElementMatrices[iAtom][iElemComp][kPoint][numberNodesPerElement*iPseudoWave + iNode].imag(tempImag);
-
-		      d_nonLocalProjectorElementMatricesConjugate[iAtom][iElemComp][kPoint][numberNodesPerElement*iPseudoWave + iNode].real(tempReal);
-		      d_nonLocalProjectorElementMatricesConjugate[iAtom][iElemComp][kPoint][numberNodesPerElement*iPseudoWave + iNode].imag(-tempImag);
-			  d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp][kPoint][numberPseudoWaveFunctions*iNode+iPseudoWave].real(tempReal);
-		     d_nonLocalProjectorElementMatricesTranspose[iAtom][iElemComp][kPoint][numberPseudoWaveFunctions*iNode+iPseudoWave].imag(tempImag);
+		      nonLocalProjectorElementMatrices[iAtom][iElemComp][kPoint][numberNodesPerElement*iPseudoWave + iNode].real(tempReal);
+		      nonLocalProjectorElementMatrices[iAtom][iElemComp][kPoint][numberNodesPerElement*iPseudoWave + iNode].imag(tempImag);
 #endif
 		    }
 
@@ -1451,6 +1436,7 @@ void dftClass<FEOrder>::computeElementalProjectorKets()
 
     }
 
+  flattenElementalProjectorKets(nonLocalProjectorElementMatrices);
 
 }
 
@@ -41,18 +41,10 @@ void dftClass<FEOrder>::clearRhoData()
 }
 
 template<unsigned int FEOrder>
-void dftClass<FEOrder>::initRho()
+void dftClass<FEOrder>::readSingleAtomRhoSplines(std::map<unsigned int, alglib::spline1dinterpolant> & denSpline,
+						 std::map<unsigned int, double> & outerMostPointDen)
 {
-  computing_timer.enter_section("initialize density");
-
-  //clear existing data
-  clearRhoData();
-
-  //Reading single atom rho initial guess
-  pcout <<std::endl<< "Reading initial guess for electron-density....."<<std::endl;
-  std::map<unsigned int, alglib::spline1dinterpolant> denSpline;
   std::map<unsigned int, std::vector<std::vector<double> > > singleAtomElectronDensity;
-  std::map<unsigned int, double> outerMostPointDen;
   const double truncationTol=1e-8;
 
   //loop over atom types
@@ -92,6 +84,22 @@ void dftClass<FEOrder>::initRho()
       spline1dbuildcubic(x, y, numRows, natural_bound_type_L, 0.0, natural_bound_type_R, 0.0, denSpline[*it]);
       outerMostPointDen[*it]= xData[maxRowId];
     }
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::initRho()
+{
+  computing_timer.enter_section("initialize density");
+
+  //clear existing data
+  clearRhoData();
+
+  //Reading single atom rho initial guess
+  pcout <<std::endl<< "Reading initial guess for electron-density....."<<std::endl;
+  std::map<unsigned int, alglib::spline1dinterpolant> denSpline;
+  std::map<unsigned int, double> outerMostPointDen;
+  readSingleAtomRhoSplines(denSpline,
+			   outerMostPointDen);
 
 
   //Initialize rho
@@ -815,8 +823,7 @@ void dftClass<FEOrder>::initRhoFromPreviousGroundStateRho()
     }
 
   vectorTools::interpolateFieldsFromPreviousMesh interpolateRhoVecsPrev(mpi_communicator);
-  interpolateRhoVecsPrev.interpolate(d_mesh.getSerialMeshUnmovedPrevious(),
-				     d_mesh.getParallelMeshUnmovedPrevious(),
+  interpolateRhoVecsPrev.interpolate(d_mesh.getParallelMeshUnmovedPrevious(),
 				     d_mesh.getParallelMeshUnmoved(),
 				     FE,
 				     FE,
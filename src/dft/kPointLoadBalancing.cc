@@ -0,0 +1,488 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+//
+//Dynamic scheduling of the irreducible k-points across the k-point pools (interpoolcomm)
+//based on the measured Chebyshev filtering cost of each k-point
+//
+
+namespace internalKPointLoadBalancing
+{
+  //
+  //optimal partition of the ordered k-point costs into numberPools contiguous non-empty blocks
+  //minimizing the maximum block cost (linear partition problem solved by dynamic programming).
+  //Returns the maximum block cost.
+  //
+  double computeOptimalContiguousPartition(const std::vector<double> & costs,
+					   const unsigned int numberPools,
+					   std::vector<unsigned int> & numberKPointsPerPool)
+  {
+    const unsigned int numberKPoints=costs.size();
+    std::vector<double> costsPrefixSum(numberKPoints+1,0.0);
+    for (unsigned int i = 0; i < numberKPoints; ++i)
+      costsPrefixSum[i+1]=costsPrefixSum[i]+costs[i];
+
+    //maxCost[j][i]: minimum of the maximum block cost when partitioning the first i k-points into j+1 blocks
+    std::vector<std::vector<double> > maxCost(numberPools,std::vector<double>(numberKPoints+1,std::numeric_limits<double>::max()));
+    std::vector<std::vector<unsigned int> > lastBlockStart(numberPools,std::vector<unsigned int>(numberKPoints+1,0));
+    for (unsigned int i = 1; i <= numberKPoints; ++i)
+      maxCost[0][i]=costsPrefixSum[i];
+
+    for (unsigned int j = 1; j < numberPools; ++j)
+      for (unsigned int i = j+1; i <= numberKPoints; ++i)
+	for (unsigned int m = j; m < i; ++m)
+	  {
+	    const double cost=std::max(maxCost[j-1][m],costsPrefixSum[i]-costsPrefixSum[m]);
+	    if (cost<maxCost[j][i])
+	      {
+		maxCost[j][i]=cost;
+		lastBlockStart[j][i]=m;
+	      }
+	  }
+
+    numberKPointsPerPool.resize(numberPools);
+    unsigned int blockEnd=numberKPoints;
+    for (int j = numberPools-1; j >= 0; --j)
+      {
+	const unsigned int blockStart=j>0?lastBlockStart[j][blockEnd]:0;
+	numberKPointsPerPool[j]=blockEnd-blockStart;
+	blockEnd=blockStart;
+      }
+
+    return maxCost[numberPools-1][numberKPoints];
+  }
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::initKPointLoadBalancingData()
+{
+  const unsigned int numberKPoints=d_kPointWeights.size();
+  d_kPointEigenSolveTimes.assign(numberKPoints,0.0);
+  d_kPointChebyshevPassCounts.assign(numberKPoints,0);
+
+  //the cost history is retained across ground-state solves with the same k-point distribution
+  if (d_kPointCosts.size()!=numberKPoints)
+    d_kPointCosts.assign(numberKPoints,0.0);
+
+  d_kPointPoolEigenSolveTime=0.0;
+  d_kPointPoolIdleTime=0.0;
+  d_kPointPoolChebyshevPassCount=0;
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::updateKPointCostsAndRebalance(const bool isRebalancingAllowed)
+{
+  const unsigned int numberPools=dealii::Utilities::MPI::n_mpi_processes(interpoolcomm);
+  const unsigned int numberKPoints=d_kPointWeights.size();
+
+  //
+  //the costs must be identical on all tasks of a pool (including the spin groups) for the k-point
+  //assignment to be consistent
+  //
+  std::vector<double> kPointTimes=d_kPointEigenSolveTimes;
+  MPI_Allreduce(MPI_IN_PLACE,
+		&kPointTimes[0],
+		numberKPoints,
+		MPI_DOUBLE,
+		MPI_MAX,
+		mpi_communicator);
+
+  MPI_Allreduce(MPI_IN_PLACE,
+		&kPointTimes[0],
+		numberKPoints,
+		MPI_DOUBLE,
+		MPI_MAX,
+		interBandGroupComm);
+
+  MPI_Allreduce(MPI_IN_PLACE,
+		&kPointTimes[0],
+		numberKPoints,
+		MPI_DOUBLE,
+		MPI_MAX,
+		interSpinGroupComm);
+
+  double poolTime=0.0;
+  for (unsigned int kPoint = 0; kPoint < numberKPoints; ++kPoint)
+    {
+      d_kPointCosts[kPoint]=d_kPointCosts[kPoint]>0.0?0.5*(d_kPointCosts[kPoint]+kPointTimes[kPoint])
+						      :kPointTimes[kPoint];
+      poolTime+=kPointTimes[kPoint];
+      d_kPointPoolChebyshevPassCount+=d_kPointChebyshevPassCounts[kPoint];
+      d_kPointEigenSolveTimes[kPoint]=0.0;
+      d_kPointChebyshevPassCounts[kPoint]=0;
+    }
+
+  //
+  //time spent by the current pool waiting for the slowest pool in the density and energy reductions
+  //
+  d_kPointPoolEigenSolveTime+=poolTime;
+  d_kPointPoolIdleTime+=dealii::Utilities::MPI::max(poolTime,interpoolcomm)-poolTime;
+
+  if (!dftParameters::dynamicKPointScheduling
+      || numberPools==1
+      || dftParameters::useSymm
+      || !isRebalancingAllowed)
+    return;
+
+  //
+  //gather the k-point costs of all pools ordered by the global k-point index
+  //
+  std::vector<int> numberKPointsPerPoolOld(numberPools,0);
+  int numberKPointsInt=numberKPoints;
+  MPI_Allgather(&numberKPointsInt,
+		1,
+		MPI_INT,
+		&numberKPointsPerPoolOld[0],
+		1,
+		MPI_INT,
+		interpoolcomm);
+
+  std::vector<int> mpiOffsets(numberPools,0);
+  for (unsigned int i = 1; i < numberPools; ++i)
+    mpiOffsets[i]=mpiOffsets[i-1]+numberKPointsPerPoolOld[i-1];
+
+  const unsigned int totalNumberKPoints=mpiOffsets[numberPools-1]+numberKPointsPerPoolOld[numberPools-1];
+  std::vector<double> kPointCostsGlobal(totalNumberKPoints,0.0);
+  MPI_Allgatherv(&d_kPointCosts[0],
+		 numberKPoints,
+		 MPI_DOUBLE,
+		 &kPointCostsGlobal[0],
+		 &numberKPointsPerPoolOld[0],
+		 &mpiOffsets[0],
+		 MPI_DOUBLE,
+		 interpoolcomm);
+
+  double maxPoolCost=0.0;
+  double totalCost=0.0;
+  for (unsigned int i = 0; i < numberPools; ++i)
+    {
+      double poolCost=0.0;
+      for (int kPoint = 0; kPoint < numberKPointsPerPoolOld[i]; ++kPoint)
+	poolCost+=kPointCostsGlobal[mpiOffsets[i]+kPoint];
+      maxPoolCost=std::max(maxPoolCost,poolCost);
+      totalCost+=poolCost;
+    }
+
+  if (totalCost<=0.0)
+    return;
+
+  const double loadImbalance=maxPoolCost*numberPools/totalCost;
+  if (loadImbalance<=dftParameters::kPointLoadImbalanceTol)
+    return;
+
+  std::vector<unsigned int> numberKPointsPerPoolNew;
+  const double maxPoolCostNew=internalKPointLoadBalancing::computeOptimalContiguousPartition(kPointCostsGlobal,
+											      numberPools,
+											      numberKPointsPerPoolNew);
+
+  //avoid moving the wavefunctions for a marginal gain
+  if (maxPoolCostNew>0.98*maxPoolCost)
+    return;
+
+  if (dftParameters::verbosity>=1)
+    pcout<<"K-point load imbalance across pools: "<<loadImbalance
+	 <<", re-assigning k-points across pools (expected load imbalance after re-assignment: "
+	 <<maxPoolCostNew*numberPools/totalCost<<")"<<std::endl;
+
+  redistributeKPoints(numberKPointsPerPoolNew);
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::redistributeKPoints(const std::vector<unsigned int> & numberKPointsPerPool)
+{
+  computing_timer.enter_section("k-point redistribution");
+
+  const unsigned int numberPools=dealii::Utilities::MPI::n_mpi_processes(interpoolcomm);
+  const unsigned int poolId=dealii::Utilities::MPI::this_mpi_process(interpoolcomm);
+  const unsigned int numberSpins=1+dftParameters::spinPolarized;
+  const unsigned int numberKPointsOld=d_kPointWeights.size();
+  const unsigned int lowerBoundKindexOld=lowerBoundKindex;
+
+  AssertThrow(numberKPointsPerPool.size()==numberPools,
+	      ExcMessage("DFT-FE Error: k-point assignment size does not match the number of pools."));
+
+  std::vector<unsigned int> numberKPointsPerPoolOld(numberPools,0);
+  unsigned int numberKPointsLocal=numberKPointsOld;
+  MPI_Allgather(&numberKPointsLocal,
+		1,
+		MPI_UNSIGNED,
+		&numberKPointsPerPoolOld[0],
+		1,
+		MPI_UNSIGNED,
+		interpoolcomm);
+
+  std::vector<unsigned int> lowerBoundKindexPerPoolOld(numberPools+1,0);
+  std::vector<unsigned int> lowerBoundKindexPerPool(numberPools+1,0);
+  for (unsigned int i = 0; i < numberPools; ++i)
+    {
+      lowerBoundKindexPerPoolOld[i+1]=lowerBoundKindexPerPoolOld[i]+numberKPointsPerPoolOld[i];
+      lowerBoundKindexPerPool[i+1]=lowerBoundKindexPerPool[i]+numberKPointsPerPool[i];
+    }
+
+  const unsigned int numberKPointsNew=numberKPointsPerPool[poolId];
+  const unsigned int lowerBoundKindexNew=lowerBoundKindexPerPool[poolId];
+
+  //
+  //all local k-points share the same sizes of the eigenvalues and wavefunctions data
+  //
+  const unsigned int eigenValuesSize=eigenValues[0].size();
+  const unsigned int eigenValuesRRSplitSize=eigenValuesRRSplit[0].size();
+  const unsigned int eigenVectorsSize=d_eigenVectorsFlattenedSTL[0].size();
+  const bool isRotFracDensityStored=d_eigenVectorsRotFracDensityFlattenedSTL.size()==numberSpins*numberKPointsOld;
+  const unsigned int eigenVectorsRotFracDensitySize=isRotFracDensityStored?
+                                                    d_eigenVectorsRotFracDensityFlattenedSTL[0].size():0;
+
+  //k-point coordinates, reduced coordinates, weight, eigenvalues, spectrum bounds and cost
+  const unsigned int scalarDataSize=7+eigenValuesSize+eigenValuesRRSplitSize+2*numberSpins+1;
+
+  const int scalarDataTag=0;
+  const int eigenVectorsTag=1;
+  const int eigenVectorsRotFracDensityTag=2;
+
+  //
+  //send the k-point data to the new owner pools. The corresponding tasks across the pools
+  //own the same part of the finite element mesh.
+  //
+  std::vector<MPI_Request> sendRequests;
+  std::vector<std::vector<double> > sendScalarData;
+  sendScalarData.reserve(numberKPointsOld);
+  for (unsigned int kPoint = 0; kPoint < numberKPointsOld; ++kPoint)
+    {
+      const unsigned int kPointGlobal=lowerBoundKindexOld+kPoint;
+      const unsigned int newPoolId=std::upper_bound(lowerBoundKindexPerPool.begin(),
+						    lowerBoundKindexPerPool.end(),
+						    kPointGlobal)-lowerBoundKindexPerPool.begin()-1;
+      if (newPoolId==poolId)
+	continue;
+
+      sendScalarData.push_back(std::vector<double>());
+      std::vector<double> & scalarData=sendScalarData.back();
+      scalarData.reserve(scalarDataSize);
+      for (unsigned int i = 0; i < 3; ++i)
+	scalarData.push_back(d_kPointCoordinates[3*kPoint+i]);
+      for (unsigned int i = 0; i < 3; ++i)
+	scalarData.push_back(kPointReducedCoordinates[3*kPoint+i]);
+      scalarData.push_back(d_kPointWeights[kPoint]);
+      scalarData.insert(scalarData.end(),eigenValues[kPoint].begin(),eigenValues[kPoint].end());
+      scalarData.insert(scalarData.end(),eigenValuesRRSplit[kPoint].begin(),eigenValuesRRSplit[kPoint].end());
+      for (unsigned int s = 0; s < numberSpins; ++s)
+	{
+	  scalarData.push_back(a0[numberSpins*kPoint+s]);
+	  scalarData.push_back(bLow[numberSpins*kPoint+s]);
+	}
+      scalarData.push_back(d_kPointCosts[kPoint]);
+
+      sendRequests.push_back(MPI_Request());
+      MPI_Isend(&scalarData[0],
+		scalarDataSize,
+		MPI_DOUBLE,
+		newPoolId,
+		scalarDataTag,
+		interpoolcomm,
+		&sendRequests.back());
+
+      for (unsigned int s = 0; s < numberSpins; ++s)
+	{
+	  std::vector<dataTypes::number> & eigenVectors=d_eigenVectorsFlattenedSTL[numberSpins*kPoint+s];
+	  sendRequests.push_back(MPI_Request());
+	  MPI_Isend(&eigenVectors[0],
+		    eigenVectorsSize,
+		    dataTypes::mpi_type_id(&eigenVectors[0]),
+		    newPoolId,
+		    eigenVectorsTag,
+		    interpoolcomm,
+		    &sendRequests.back());
+
+	  if (eigenVectorsRotFracDensitySize>0)
+	    {
+	      std::vector<dataTypes::number> & eigenVectorsRotFrac=d_eigenVectorsRotFracDensityFlattenedSTL[numberSpins*kPoint+s];
+	      sendRequests.push_back(MPI_Request());
+	      MPI_Isend(&eigenVectorsRotFrac[0],
+			eigenVectorsRotFracDensitySize,
+			dataTypes::mpi_type_id(&eigenVectorsRotFrac[0]),
+			newPoolId,
+			eigenVectorsRotFracDensityTag,
+			interpoolcomm,
+			&sendRequests.back());
+	    }
+	}
+    }
+
+  //
+  //fill the new k-point data either locally or from the previous owner pools. The messages
+  //between two pools are received in the same global k-point order in which they were sent.
+  //
+  std::vector<double> kPointCoordinatesNew(3*numberKPointsNew,0.0);
+  std::vector<double> kPointReducedCoordinatesNew(3*numberKPointsNew,0.0);
+  std::vector<double> kPointWeightsNew(numberKPointsNew,0.0);
+  std::vector<std::vector<double> > eigenValuesNew(numberKPointsNew);
+  std::vector<std::vector<double> > eigenValuesRRSplitNew(numberKPointsNew);
+  std::vector<double> a0New(numberSpins*numberKPointsNew,0.0);
+  std::vector<double> bLowNew(numberSpins*numberKPointsNew,0.0);
+  std::vector<double> kPointCostsNew(numberKPointsNew,0.0);
+  std::vector<std::vector<dataTypes::number> > eigenVectorsNew(numberSpins*numberKPointsNew);
+  std::vector<std::vector<dataTypes::number> > eigenVectorsRotFracDensityNew(isRotFracDensityStored?
+									     numberSpins*numberKPointsNew:0);
+
+  std::vector<double> scalarData(scalarDataSize,0.0);
+  for (unsigned int kPoint = 0; kPoint < numberKPointsNew; ++kPoint)
+    {
+      const unsigned int kPointGlobal=lowerBoundKindexNew+kPoint;
+      if (kPointGlobal>=lowerBoundKindexOld && kPointGlobal<lowerBoundKindexOld+numberKPointsOld)
+	{
+	  const unsigned int kPointOld=kPointGlobal-lowerBoundKindexOld;
+	  for (unsigned int i = 0; i < 3; ++i)
+	    {
+	      kPointCoordinatesNew[3*kPoint+i]=d_kPointCoordinates[3*kPointOld+i];
+	      kPointReducedCoordinatesNew[3*kPoint+i]=kPointReducedCoordinates[3*kPointOld+i];
+	    }
+	  kPointWeightsNew[kPoint]=d_kPointWeights[kPointOld];
+	  eigenValuesNew[kPoint]=eigenValues[kPointOld];
+	  eigenValuesRRSplitNew[kPoint]=eigenValuesRRSplit[kPointOld];
+	  for (unsigned int s = 0; s < numberSpins; ++s)
+	    {
+	      a0New[numberSpins*kPoint+s]=a0[numberSpins*kPointOld+s];
+	      bLowNew[numberSpins*kPoint+s]=bLow[numberSpins*kPointOld+s];
+	      //k-points retained by the pool are not sent, hence their wavefunctions can be moved
+	      eigenVectorsNew[numberSpins*kPoint+s].swap(d_eigenVectorsFlattenedSTL[numberSpins*kPointOld+s]);
+	      if (isRotFracDensityStored)
+		eigenVectorsRotFracDensityNew[numberSpins*kPoint+s]
+		    .swap(d_eigenVectorsRotFracDensityFlattenedSTL[numberSpins*kPointOld+s]);
+	    }
+	  kPointCostsNew[kPoint]=d_kPointCosts[kPointOld];
+	  continue;
+	}
+
+      const unsigned int oldPoolId=std::upper_bound(lowerBoundKindexPerPoolOld.begin(),
+						    lowerBoundKindexPerPoolOld.end(),
+						    kPointGlobal)-lowerBoundKindexPerPoolOld.begin()-1;
+
+      MPI_Recv(&scalarData[0],
+	       scalarDataSize,
+	       MPI_DOUBLE,
+	       oldPoolId,
+	       scalarDataTag,
+	       interpoolcomm,
+	       MPI_STATUS_IGNORE);
+
+      unsigned int count=0;
+      for (unsigned int i = 0; i < 3; ++i)
+	kPointCoordinatesNew[3*kPoint+i]=scalarData[count++];
+      for (unsigned int i = 0; i < 3; ++i)
+	kPointReducedCoordinatesNew[3*kPoint+i]=scalarData[count++];
+      kPointWeightsNew[kPoint]=scalarData[count++];
+      eigenValuesNew[kPoint].assign(scalarData.begin()+count,scalarData.begin()+count+eigenValuesSize);
+      count+=eigenValuesSize;
+      eigenValuesRRSplitNew[kPoint].assign(scalarData.begin()+count,scalarData.begin()+count+eigenValuesRRSplitSize);
+      count+=eigenValuesRRSplitSize;
+      for (unsigned int s = 0; s < numberSpins; ++s)
+	{
+	  a0New[numberSpins*kPoint+s]=scalarData[count++];
+	  bLowNew[numberSpins*kPoint+s]=scalarData[count++];
+	}
+      kPointCostsNew[kPoint]=scalarData[count++];
+
+      for (unsigned int s = 0; s < numberSpins; ++s)
+	{
+	  std::vector<dataTypes::number> & eigenVectors=eigenVectorsNew[numberSpins*kPoint+s];
+	  eigenVectors.resize(eigenVectorsSize);
+	  MPI_Recv(&eigenVectors[0],
+		   eigenVectorsSize,
+		   dataTypes::mpi_type_id(&eigenVectors[0]),
+		   oldPoolId,
+		   eigenVectorsTag,
+		   interpoolcomm,
+		   MPI_STATUS_IGNORE);
+
+	  if (isRotFracDensityStored)
+	    {
+	      std::vector<dataTypes::number> & eigenVectorsRotFrac=eigenVectorsRotFracDensityNew[numberSpins*kPoint+s];
+	      eigenVectorsRotFrac.resize(eigenVectorsRotFracDensitySize);
+	      if (eigenVectorsRotFracDensitySize>0)
+		MPI_Recv(&eigenVectorsRotFrac[0],
+			 eigenVectorsRotFracDensitySize,
+			 dataTypes::mpi_type_id(&eigenVectorsRotFrac[0]),
+			 oldPoolId,
+			 eigenVectorsRotFracDensityTag,
+			 interpoolcomm,
+			 MPI_STATUS_IGNORE);
+	    }
+	}
+    }
+
+  if (!sendRequests.empty())
+    MPI_Waitall(sendRequests.size(),
+		&sendRequests[0],
+		MPI_STATUSES_IGNORE);
+
+  d_kPointCoordinates.swap(kPointCoordinatesNew);
+  kPointReducedCoordinates.swap(kPointReducedCoordinatesNew);
+  d_kPointWeights.swap(kPointWeightsNew);
+  eigenValues.swap(eigenValuesNew);
+  eigenValuesRRSplit.swap(eigenValuesRRSplitNew);
+  a0.swap(a0New);
+  bLow.swap(bLowNew);
+  d_kPointCosts.swap(kPointCostsNew);
+  d_eigenVectorsFlattenedSTL.swap(eigenVectorsNew);
+  if (isRotFracDensityStored)
+    d_eigenVectorsRotFracDensityFlattenedSTL.swap(eigenVectorsRotFracDensityNew);
+  lowerBoundKindex=lowerBoundKindexNew;
+
+  d_kPointEigenSolveTimes.assign(numberKPointsNew,0.0);
+  d_kPointChebyshevPassCounts.assign(numberKPointsNew,0);
+
+  //the previous ground-state wavefunctions belong to the old k-point assignment
+  d_eigenVectorsFlattenedSTLPrevious.clear();
+
+  //
+  //recompute the k-point dependent nonlocal pseudopotential data
+  //
+  if (dftParameters::isPseudopotential)
+    {
+      computeElementalOVProjectorKets();
+      forcePtr->initPseudoData();
+    }
+
+  computing_timer.exit_section("k-point redistribution");
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::printKPointPoolTimings()
+{
+  const unsigned int numberPools=dealii::Utilities::MPI::n_mpi_processes(interpoolcomm);
+  if (numberPools==1 || dftParameters::reproducible_output)
+    return;
+
+  unsigned int numberKPoints=d_kPointWeights.size();
+
+  std::vector<double> poolEigenSolveTimes(numberPools,0.0);
+  std::vector<double> poolIdleTimes(numberPools,0.0);
+  std::vector<unsigned int> poolNumberKPoints(numberPools,0);
+  std::vector<unsigned int> poolNumberChebyshevPasses(numberPools,0);
+  MPI_Gather(&d_kPointPoolEigenSolveTime,1,MPI_DOUBLE,&poolEigenSolveTimes[0],1,MPI_DOUBLE,0,interpoolcomm);
+  MPI_Gather(&d_kPointPoolIdleTime,1,MPI_DOUBLE,&poolIdleTimes[0],1,MPI_DOUBLE,0,interpoolcomm);
+  MPI_Gather(&numberKPoints,1,MPI_UNSIGNED,&poolNumberKPoints[0],1,MPI_UNSIGNED,0,interpoolcomm);
+  MPI_Gather(&d_kPointPoolChebyshevPassCount,1,MPI_UNSIGNED,&poolNumberChebyshevPasses[0],1,MPI_UNSIGNED,0,interpoolcomm);
+
+  pcout<<std::endl<<"K-point pool timings in the above scf solve (wall times in seconds):"<<std::endl;
+  pcout<<"  pool   k-points   Chebyshev filtering passes   eigen solve time   idle time"<<std::endl;
+  for (unsigned int i = 0; i < numberPools; ++i)
+    pcout<<"  "<<std::setw(4)<<i
+	 <<"   "<<std::setw(8)<<poolNumberKPoints[i]
+	 <<"   "<<std::setw(26)<<poolNumberChebyshevPasses[i]
+	 <<"   "<<std::setw(16)<<poolEigenSolveTimes[i]
+	 <<"   "<<std::setw(9)<<poolIdleTimes[i]<<std::endl;
+  pcout<<std::endl;
+}
@@ -332,6 +332,7 @@ void dftClass<FEOrder>::kohnShamEigenSpaceCompute(const unsigned int spinType,
 						  const bool useFullMassMatrixGEP)
 {
   computing_timer.enter_section("Chebyshev solve");
+  const double chebyshevSolveStartTime=MPI_Wtime();
 
   if (dftParameters::verbosity>=2)
     {
@@ -439,6 +440,13 @@ void dftClass<FEOrder>::kohnShamEigenSpaceCompute(const unsigned int spinType,
       a0[(1+dftParameters::spinPolarized)*kPointIndex+spinType] = eigenValuesTemp[0];
     }
 
+  //record the cost of the k point for the dynamic k point scheduling across pools
+  if (kPointIndex<d_kPointEigenSolveTimes.size())
+    {
+      d_kPointEigenSolveTimes[kPointIndex]+=MPI_Wtime()-chebyshevSolveStartTime;
+      d_kPointChebyshevPassCounts[kPointIndex]+=1;
+    }
+
   computing_timer.exit_section("Chebyshev solve");
 }
 
@@ -0,0 +1,191 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+//
+//Memory ledger updates of the electron-density data and the pre-flight memory estimate
+//
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::updateMemoryLedgerDensityData()
+{
+  memoryLedger::setBytes(memoryLedger::mixingHistory,
+			 "electron-density history",
+			 memoryLedger::getBytes(rhoInVals)
+			 +memoryLedger::getBytes(rhoOutVals)
+			 +memoryLedger::getBytes(rhoInValsSpinPolarized)
+			 +memoryLedger::getBytes(rhoOutValsSpinPolarized)
+			 +memoryLedger::getBytes(gradRhoInVals)
+			 +memoryLedger::getBytes(gradRhoOutVals)
+			 +memoryLedger::getBytes(gradRhoInValsSpinPolarized)
+			 +memoryLedger::getBytes(gradRhoOutValsSpinPolarized));
+
+  memoryLedger::setBytes(memoryLedger::mixingHistory,
+			 "Broyden history",
+			 memoryLedger::getBytes(dFBroyden)
+			 +memoryLedger::getBytes(graddFBroyden)
+			 +memoryLedger::getBytes(uBroyden)
+			 +memoryLedger::getBytes(gradUBroyden));
+
+  double nodalHistoryBytes=0.0;
+  for (unsigned int i=0; i<d_rhoInNodalVals.size(); ++i)
+    nodalHistoryBytes+=d_rhoInNodalVals[i].local_size()*sizeof(double);
+  for (unsigned int i=0; i<d_rhoOutNodalVals.size(); ++i)
+    nodalHistoryBytes+=d_rhoOutNodalVals[i].local_size()*sizeof(double);
+
+  memoryLedger::setBytes(memoryLedger::mixingHistory,
+			 "nodal electron-density history",
+			 nodalHistoryBytes);
+
+  double pseudoValuesBytes=memoryLedger::getBytes(d_pseudoVLoc)
+                           +memoryLedger::getBytes(d_gradPseudoVLoc);
+  for (std::map<unsigned int,std::map<dealii::CellId, std::vector<double> > >::const_iterator it=d_gradPseudoVLocAtoms.begin();
+       it!=d_gradPseudoVLocAtoms.end(); ++it)
+    pseudoValuesBytes+=memoryLedger::getBytes(it->second);
+
+  memoryLedger::setBytes(memoryLedger::quadratureFields,
+			 "local pseudopotential",
+			 pseudoValuesBytes);
+}
+
+//
+//The estimate uses the sizes of the mesh dependent data known at the end of init (number of locally owned
+//and ghost degrees of freedom, number of locally owned cells and number of cell projectors) together with the
+//input parameters (number of wavefunctions, k-points, spin, mixing history and Chebyshev filter block size).
+//The memory already in use (mesh, constraints, matrix free data) is taken as the current resident memory
+//minus the allocations already registered in the memory ledger.
+//
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::estimateMemory()
+{
+  const double numberLocalDofs=matrix_free_data.get_vector_partitioner()->local_size();
+  const double numberGhostDofs=matrix_free_data.get_vector_partitioner()->n_ghost_indices();
+  const double numberLocalCells=matrix_free_data.n_physical_cells();
+  const double numberNodesPerElement=FE.dofs_per_cell;
+  const double numberQuadraturePoints=std::pow(C_num1DQuad<FEOrder>(),3);
+  const double numberKPoints=d_kPointWeights.size();
+  const double numberSpins=1+dftParameters::spinPolarized;
+  const double numberWaveFunctions=d_numEigenValues;
+  const double numberWaveFunctionsRR=d_numEigenValuesRR;
+  const double blockSize=std::min(dftParameters::chebyWfcBlockSize,d_numEigenValues);
+  const double numberCellProjectors=d_nonLocalProjectorCellStartIds.empty()?0.0:d_nonLocalProjectorCellStartIds.back();
+  const double numberProcs=n_mpi_processes;
+  const double bytesPerEntry=sizeof(dataTypes::number);
+  const bool isGGA=dftParameters::xc_id == 4;
+  const bool isForceComputed=dftParameters::isIonForce || dftParameters::isIonOpt
+                             || dftParameters::isCellStress || dftParameters::isCellOpt;
+
+  //number of quadrature point values of an electron-density field
+  const double densityQuadValues=numberLocalCells*numberQuadraturePoints
+                                 *(isGGA?4.0:1.0)*(dftParameters::spinPolarized==1?3.0:1.0);
+
+  std::vector<double> estimatedBytes(memoryLedger::numberCategories,0.0);
+
+  //wavefunctions of all k-points and spins, and the flattened source, destination and temporary
+  //blocks (including ghost entries) of the Chebyshev filter
+  estimatedBytes[memoryLedger::wavefunctions]=numberSpins*numberKPoints*numberWaveFunctions*numberLocalDofs*bytesPerEntry
+                                              +3.0*blockSize*(numberLocalDofs+numberGhostDofs)*bytesPerEntry;
+
+  if (d_numEigenValuesRR!=d_numEigenValues)
+    estimatedBytes[memoryLedger::rotatedFractionalWavefunctions]=numberSpins*numberKPoints*numberWaveFunctionsRR*numberLocalDofs*bytesPerEntry;
+
+  //cell Hamiltonian matrices of one k-point and the shape function gradient integrals
+  estimatedBytes[memoryLedger::cellHamiltonians]=numberLocalCells*numberNodesPerElement*numberNodesPerElement*(bytesPerEntry+sizeof(double));
+
+  estimatedBytes[memoryLedger::projectorMatrices]=memoryLedger::getCurrentBytes(memoryLedger::projectorMatrices);
+
+  //local pseudopotential, effective potential and the current input and output electron-densities
+  estimatedBytes[memoryLedger::quadratureFields]=(numberLocalCells*numberQuadraturePoints*(isGGA?8.0:2.0)
+						  +2.0*densityQuadValues)*sizeof(double);
+
+  if (dftParameters::mixingMethod=="ANDERSON_WITH_KERKER")
+    estimatedBytes[memoryLedger::mixingHistory]=2.0*dftParameters::mixingHistory*d_rhoInNodalValues.local_size()*sizeof(double);
+  else
+    estimatedBytes[memoryLedger::mixingHistory]=(dftParameters::mixingMethod=="BROYDEN"?4.0:2.0)
+                                                *dftParameters::mixingHistory*densityQuadValues*sizeof(double);
+
+  //at most four simultaneous block cyclic matrices of size number of wavefunctions in the Rayleigh-Ritz step
+  estimatedBytes[memoryLedger::scalapackBuffers]=4.0*numberWaveFunctions*numberWaveFunctions*bytesPerEntry/numberProcs;
+
+  //nonlocal pseudopotential force quadrature data and its gradient, and the wavefunction values and gradients
+  //at the quadrature points of a block of wavefunctions
+  if (isForceComputed)
+    estimatedBytes[memoryLedger::forceTables]=numberCellProjectors*numberQuadraturePoints*4.0*sizeof(double)
+                                              +numberLocalCells*numberQuadraturePoints*blockSize*4.0*bytesPerEntry;
+
+  double registeredBytes=0.0;
+  double estimatedTotalBytes=0.0;
+  for (unsigned int i=0; i<memoryLedger::numberCategories; ++i)
+    {
+      registeredBytes+=memoryLedger::getCurrentBytes((memoryLedger::category)i);
+      estimatedTotalBytes+=estimatedBytes[i];
+    }
+
+  const double baselineBytes=std::max(memoryLedger::getResidentMemory()-registeredBytes,0.0);
+  estimatedTotalBytes+=baselineBytes;
+
+  //
+  //sum of the estimates of the processors sharing a compute node
+  //
+  MPI_Comm nodeComm;
+  MPI_Comm_split_type(MPI_COMM_WORLD,
+		      MPI_COMM_TYPE_SHARED,
+		      0,
+		      MPI_INFO_NULL,
+		      &nodeComm);
+  const double nodeEstimatedBytes=Utilities::MPI::sum(estimatedTotalBytes,nodeComm);
+  const unsigned int numberProcsNode=Utilities::MPI::n_mpi_processes(nodeComm);
+  MPI_Comm_free(&nodeComm);
+
+  const double nodeEstimatedBytesMax=Utilities::MPI::max(nodeEstimatedBytes,MPI_COMM_WORLD);
+  const double estimatedTotalBytesMax=Utilities::MPI::max(estimatedTotalBytes,MPI_COMM_WORLD);
+  const double baselineBytesMax=Utilities::MPI::max(baselineBytes,MPI_COMM_WORLD);
+
+  std::vector<double> estimatedBytesMax(memoryLedger::numberCategories,0.0);
+  for (unsigned int i=0; i<memoryLedger::numberCategories; ++i)
+    estimatedBytesMax[i]=Utilities::MPI::max(estimatedBytes[i],MPI_COMM_WORLD);
+
+  //the estimate depends on the number of MPI tasks and on the compute nodes, so it is not printed for reproducible output
+  if (!dftParameters::reproducible_output)
+    {
+      const std::ios_base::fmtflags coutFlags=std::cout.flags();
+      const std::streamsize coutPrecision=std::cout.precision();
+      pcout<<std::endl<<"Estimated peak memory of the ground-state solve"<<(isForceComputed?" and force computation":"")
+	   <<" (maximum across processors):"<<std::endl;
+      for (unsigned int i=0; i<memoryLedger::numberCategories; ++i)
+	pcout<<"  "<<std::left<<std::setw(36)<<memoryLedger::getCategoryName((memoryLedger::category)i)
+	     <<std::right<<std::fixed<<std::setprecision(2)<<std::setw(12)<<estimatedBytesMax[i]/1.0e+6<<" MB"<<std::endl;
+      pcout<<"  "<<std::left<<std::setw(36)<<"mesh and other data"
+	   <<std::right<<std::setw(12)<<baselineBytesMax/1.0e+6<<" MB"<<std::endl;
+      pcout<<"  "<<std::left<<std::setw(36)<<"total per processor"
+	   <<std::right<<std::setw(12)<<estimatedTotalBytesMax/1.0e+6<<" MB"<<std::endl;
+      pcout<<"  "<<std::left<<std::setw(36)<<"total per compute node"
+	   <<std::right<<std::setw(12)<<nodeEstimatedBytesMax/1.0e+9<<" GB"
+	   <<" ("<<numberProcsNode<<" MPI tasks on the compute node of the root processor)"<<std::endl<<std::endl;
+      std::cout.flags(coutFlags);
+      std::cout.precision(coutPrecision);
+    }
+
+  if (dftParameters::memoryBudgetPerNode>0.0 && nodeEstimatedBytesMax>dftParameters::memoryBudgetPerNode*1.0e+9)
+    {
+      std::ostringstream message;
+      message<<"the estimated memory per compute node ("<<nodeEstimatedBytesMax/1.0e+9
+	     <<" GB) exceeds MEMORY BUDGET PER NODE ("<<dftParameters::memoryBudgetPerNode
+	     <<" GB). Consider using more compute nodes, fewer MPI tasks per compute node, a smaller CHEBY WFC BLOCK SIZE or a smaller MIXING HISTORY.";
+      if (dftParameters::memoryDryRun)
+	pcout<<"DFT-FE Warning: "<<message.str()<<std::endl;
+      else
+	AssertThrow(false,ExcMessage("DFT-FE Error: "+message.str()));
+    }
+}
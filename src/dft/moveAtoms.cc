@@ -103,6 +103,12 @@ void dftClass<FEOrder>::updateAtomPositionsAndMoveMesh(const std::vector<Tensor<
 						       const bool useSingleAtomSolutions)
 
 {
+  //store the current ground-state before the atoms are moved for extrapolating the
+  //starting guess of the next ground-state solve
+  if (!useSingleAtomSolutions
+      && (dftParameters::groundStateExtrapolationOrder>0 || dftParameters::extrapolateWfcGeoOpt))
+    storeGroundStateForExtrapolation();
+
   const int numberGlobalAtoms = atomLocations.size();
   int numberImageCharges = d_imageIds.size();
   int totalNumberAtoms = numberGlobalAtoms + numberImageCharges;
@@ -308,13 +314,9 @@ void dftClass<FEOrder>::updateAtomPositionsAndMoveMesh(const std::vector<Tensor<
       // to get back the unmoved meshes as Gaussian movement can only be done starting from
       // the unmoved meshes.
       // While parallel meshes are always generated, serial meshes are only generated
-      // for following three cases: symmetrization is on, ionic optimization is on as well
-      // as reuse wfcs and density from previous ionic step is on, or if serial constraints
-      // generation is on.
+      // if serial constraints generation is on.
       d_mesh.generateResetMeshes(d_domainBoundingVectors,
-				 dftParameters::useSymm
-				 || (dftParameters::isIonOpt && (dftParameters::reuseWfcGeoOpt || dftParameters::reuseDensityGeoOpt))
-				 || dftParameters::createConstraintsFromSerialDofhandler,
+				 dftParameters::createConstraintsFromSerialDofhandler,
 				 dftParameters::electrostaticsHRefinement);
 
       //initUnmovedTriangulation(d_mesh.getParallelMeshMoved());
@@ -451,7 +453,11 @@ void dftClass<FEOrder>::updateAtomPositionsAndMoveMesh(const std::vector<Tensor<
 	      if (!dftParameters::reproducible_output)
 	         pcout << "Now Reinitializing all moved triangulation dependent objects..." << std::endl;
 
-	      initNoRemesh(false,(!dftParameters::reproducible_output && maxCurrentDispAtom>0.06) || useSingleAtomSolutions?true:false);
+	      //single atom solutions are not used if the starting guess is extrapolated from the stored ground-states,
+	      //or for the perturbed geometries which are always moved from the restored ground-state subspace of the reference geometry
+	      const bool isGroundStateExtrapolated=isGroundStateExtrapolationDataAvailable()
+		                                   || !dftParameters::perturbedGeometriesFile.empty();
+	      initNoRemesh(false,(!dftParameters::reproducible_output && !isGroundStateExtrapolated && maxCurrentDispAtom>0.06) || useSingleAtomSolutions?true:false);
 	      if (!dftParameters::reproducible_output)
 	         pcout << "...Reinitialization end" << std::endl;
 	    }
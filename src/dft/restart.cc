@@ -62,9 +62,11 @@ void dftClass<FEOrder>::saveTriaInfoAndRhoData()
 
      }
 
-     d_mesh.saveTriangulationsCellQuadData(cellQuadDataContainerIn,
-	                                   interpoolcomm,
-					   interBandGroupComm);
+     //the rho data is identical across the spin groups
+     if (Utilities::MPI::this_mpi_process(interSpinGroupComm)==0)
+       d_mesh.saveTriangulationsCellQuadData(cellQuadDataContainerIn,
+	                                     interpoolcomm,
+					     interBandGroupComm);
 
      //write size of current mixing history into an additional .txt file
      const std::string extraInfoFileName="rhoDataExtraInfo.chk";
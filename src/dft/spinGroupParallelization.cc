@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+//
+//Parallelization of the two spin channels of a spin polarized calculation across
+//two groups of MPI tasks (interSpinGroupComm). The spin group with id s solves
+//the Kohn-Sham eigen problem of spin channel s. The corresponding tasks across
+//the spin groups own the same part of the finite element mesh and the same k points.
+//The wavefunctions of a spin channel are only kept up to date on the spin group owning
+//it; the density, the forces and the stress are summed over the spin groups.
+//
+
+template<unsigned int FEOrder>
+bool dftClass<FEOrder>::isSpinChannelOwned(const unsigned int spinIndex) const
+{
+  return dealii::Utilities::MPI::n_mpi_processes(interSpinGroupComm)==1
+         || spinIndex==dealii::Utilities::MPI::this_mpi_process(interSpinGroupComm);
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::exchangeSpinChannelEigenValues(std::vector<std::vector<std::vector<double> > > & residualNormWaveFunctionsSpins)
+{
+  if (dealii::Utilities::MPI::n_mpi_processes(interSpinGroupComm)==1)
+    return;
+
+  const unsigned int numKPoints=d_kPointWeights.size();
+
+  for (unsigned int s = 0; s < 2; ++s)
+    {
+      //
+      //pack the eigenvalues and residual norms of spin channel s of all k points
+      //
+      const unsigned int numResidualNorms=residualNormWaveFunctionsSpins[s][0].size();
+      const unsigned int sizePerKPoint=d_numEigenValues+d_numEigenValuesRR+numResidualNorms;
+      std::vector<double> spinChannelData(numKPoints*sizePerKPoint,0.0);
+
+      if (isSpinChannelOwned(s))
+	for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+	  {
+	    double * data=&spinChannelData[kPoint*sizePerKPoint];
+	    std::copy(eigenValues[kPoint].begin()+s*d_numEigenValues,
+		      eigenValues[kPoint].begin()+(s+1)*d_numEigenValues,
+		      data);
+	    std::copy(eigenValuesRRSplit[kPoint].begin()+s*d_numEigenValuesRR,
+		      eigenValuesRRSplit[kPoint].begin()+(s+1)*d_numEigenValuesRR,
+		      data+d_numEigenValues);
+	    std::copy(residualNormWaveFunctionsSpins[s][kPoint].begin(),
+		      residualNormWaveFunctionsSpins[s][kPoint].end(),
+		      data+d_numEigenValues+d_numEigenValuesRR);
+	  }
+
+      MPI_Bcast(&spinChannelData[0],
+		numKPoints*sizePerKPoint,
+		MPI_DOUBLE,
+		s,
+		interSpinGroupComm);
+
+      if (!isSpinChannelOwned(s))
+	for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+	  {
+	    const double * data=&spinChannelData[kPoint*sizePerKPoint];
+	    std::copy(data,
+		      data+d_numEigenValues,
+		      eigenValues[kPoint].begin()+s*d_numEigenValues);
+	    std::copy(data+d_numEigenValues,
+		      data+d_numEigenValues+d_numEigenValuesRR,
+		      eigenValuesRRSplit[kPoint].begin()+s*d_numEigenValuesRR);
+	    std::copy(data+d_numEigenValues+d_numEigenValuesRR,
+		      data+sizePerKPoint,
+		      residualNormWaveFunctionsSpins[s][kPoint].begin());
+	  }
+    }
+}
+
+template<unsigned int FEOrder>
+void dftClass<FEOrder>::exchangeSpinChannelWaveFunctions()
+{
+  if (dealii::Utilities::MPI::n_mpi_processes(interSpinGroupComm)==1)
+    return;
+
+  const unsigned int numKPoints=d_kPointWeights.size();
+  const bool isRotFracDensityStored=d_eigenVectorsRotFracDensityFlattenedSTL.size()==2*numKPoints;
+
+  for (unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+    for (unsigned int s = 0; s < 2; ++s)
+      {
+	std::vector<dataTypes::number> & eigenVectors=d_eigenVectorsFlattenedSTL[2*kPoint+s];
+	MPI_Bcast(&eigenVectors[0],
+		  eigenVectors.size(),
+		  dataTypes::mpi_type_id(&eigenVectors[0]),
+		  s,
+		  interSpinGroupComm);
+
+	if (isRotFracDensityStored && d_eigenVectorsRotFracDensityFlattenedSTL[2*kPoint+s].size()>0)
+	  {
+	    std::vector<dataTypes::number> & eigenVectorsRotFrac=d_eigenVectorsRotFracDensityFlattenedSTL[2*kPoint+s];
+	    MPI_Bcast(&eigenVectorsRotFrac[0],
+		      eigenVectorsRotFrac.size(),
+		      dataTypes::mpi_type_id(&eigenVectorsRotFrac[0]),
+		      s,
+		      interSpinGroupComm);
+	  }
+
+	bLow[2*kPoint+s]=dealii::Utilities::MPI::sum(isSpinChannelOwned(s)?bLow[2*kPoint+s]:0.0,
+						       interSpinGroupComm);
+	a0[2*kPoint+s]=dealii::Utilities::MPI::sum(isSpinChannelOwned(s)?a0[2*kPoint+s]:0.0,
+						     interSpinGroupComm);
+      }
+}
@@ -18,6 +18,8 @@
 
 #include <vselfBinsManager.h>
 #include <dftParameters.h>
+#include <array>
+#include <tuple>
 
 #include "solveVselfInBins.cc"
 #include "createBinsSanityCheck.cc"
@@ -104,68 +106,142 @@ namespace dftfe
 			             const MPI_Comm & mpi_communicator)
 
 	{
+	  //
+	  //pack the local interaction map as (atom id, number of interacting atoms, interacting atoms)
+	  //and exchange it across all procs in a single collective
+	  //
+	  std::vector<int> localInteractionMapList;
 	  std::map<int,std::set<int> >::iterator iter;
-
-	  for(unsigned int iGlobal = 0; iGlobal < totalNumberAtoms; ++iGlobal)
+	  for(iter = interactionMap.begin(); iter != interactionMap.end(); ++iter)
 	  {
+	    localInteractionMapList.push_back(iter->first);
+	    localInteractionMapList.push_back(iter->second.size());
+	    std::copy(iter->second.begin(),
+		      iter->second.end(),
+		      std::back_inserter(localInteractionMapList));
+	  }
 
-	    //
-	    // for each charge, exchange its global list across all procs
-	    //
-	    iter = interactionMap.find(iGlobal);
+	  const int sizeOnLocalProc = localInteractionMapList.size();
 
-	    std::vector<int> localAtomToInteractingAtomsList;
+	  std::vector<int> interactionMapListSizes(numMeshPartitions);
 
-	    if(iter != interactionMap.end())
-	    {
-	      std::set<int>  & localInteractingAtomsSet = iter->second;
-	      std::copy(localInteractingAtomsSet.begin(),
-			localInteractingAtomsSet.end(),
-			std::back_inserter(localAtomToInteractingAtomsList));
+	  MPI_Allgather(&sizeOnLocalProc,
+			1,
+			MPI_INT,
+			&(interactionMapListSizes[0]),
+			1,
+			MPI_INT,
+			mpi_communicator);
 
-	    }
+	  const int newListSize =
+	  std::accumulate(&(interactionMapListSizes[0]),
+			    &(interactionMapListSizes[numMeshPartitions]),
+			    0);
 
-	    const int sizeOnLocalProc = localAtomToInteractingAtomsList.size();
+	  std::vector<int> globalInteractionMapList(newListSize);
 
-            std::vector<int> interactionMapListSizes(numMeshPartitions);
+	  std::vector<int> mpiOffsets(numMeshPartitions);
 
-	    MPI_Allgather(&sizeOnLocalProc,
-			  1,
-			  MPI_INT,
-			  &(interactionMapListSizes[0]),
-			  1,
-			  MPI_INT,
-			  mpi_communicator);
+	  mpiOffsets[0] = 0;
 
-	    const int newListSize =
-	    std::accumulate(&(interactionMapListSizes[0]),
-			      &(interactionMapListSizes[numMeshPartitions]),
-			      0);
+	  for(unsigned int i = 1; i < numMeshPartitions; ++i)
+	    mpiOffsets[i] = interactionMapListSizes[i-1]+ mpiOffsets[i-1];
 
-	    std::vector<int> globalInteractionMapList(newListSize);
+	  MPI_Allgatherv(localInteractionMapList.data(),
+			 sizeOnLocalProc,
+			 MPI_INT,
+			 globalInteractionMapList.data(),
+			 &(interactionMapListSizes[0]),
+			 &(mpiOffsets[0]),
+			 MPI_INT,
+			 mpi_communicator);
 
-	    std::vector<int> mpiOffsets(numMeshPartitions);
+	  //
+	  // over-write local interaction with items of globalInteractionList
+	  //
+	  unsigned int index=0;
+	  while(index < globalInteractionMapList.size())
+	  {
+	    const int iGlobal=globalInteractionMapList[index];
+	    const int numberInteractingAtoms=globalInteractionMapList[index+1];
+	    std::set<int> & interactingAtoms=interactionMap[iGlobal];
+	    interactingAtoms.insert(globalInteractionMapList.begin()+index+2,
+		                    globalInteractionMapList.begin()+index+2+numberInteractingAtoms);
+	    index+=2+numberInteractingAtoms;
+	  }
+	}
 
-	    mpiOffsets[0] = 0;
 
-	    for(unsigned int i = 1; i < numMeshPartitions; ++i)
-	      mpiOffsets[i] = interactionMapListSizes[i-1]+ mpiOffsets[i-1];
+	//
+	//Assign the atoms to bins by coloring the graph whose edges are the interactions of the
+	//atoms, such that no two interacting atoms are in the same bin. The DSatur heuristic is used,
+	//which colors next the uncolored atom with the largest number of distinct bins among its
+	//interacting atoms (ties broken by the number of interacting atoms, and then by the atom id).
+	//An atom is put in the bin with the least number of atoms among the feasible bins, and a new
+	//bin is only created if there is no feasible bin. The coloring only depends on the interaction
+	//map, which is the same on all procs.
+	//
+	void createBinsByGraphColoring(const std::map<int,std::set<int> > & interactionMap,
+		                       const unsigned int numberGlobalAtoms,
+				       std::map<int,std::set<int> > & bins)
+	{
+	  bins.clear();
 
-	    MPI_Allgatherv(&(localAtomToInteractingAtomsList[0]),
-			   sizeOnLocalProc,
-			   MPI_INT,
-			   &(globalInteractionMapList[0]),
-			   &(interactionMapListSizes[0]),
-			   &(mpiOffsets[0]),
-			   MPI_INT,
-			   mpi_communicator);
+	  std::vector<std::vector<int> > interactingAtoms(numberGlobalAtoms);
+	  std::map<int,std::set<int> >::const_iterator iter;
+	  for(iter = interactionMap.begin(); iter != interactionMap.end(); ++iter)
+	    if (iter->first < (int)numberGlobalAtoms)
+	      for(std::set<int>::const_iterator iter2 = iter->second.begin(); iter2!= iter->second.end();++iter2)
+		if (*iter2!=iter->first && *iter2 < (int)numberGlobalAtoms)
+		  interactingAtoms[iter->first].push_back(*iter2);
+
+	  //
+	  //queue of uncolored atoms ordered by (-saturation,-degree,atom id)
+	  //
+	  std::vector<int> saturation(numberGlobalAtoms,0);
+	  std::vector<int> atomBin(numberGlobalAtoms,-1);
+	  std::vector<std::set<int> > interactingBins(numberGlobalAtoms);
+	  std::set<std::tuple<int,int,int> > uncoloredAtomsQueue;
+	  for(unsigned int iAtom = 0; iAtom < numberGlobalAtoms; ++iAtom)
+	    uncoloredAtomsQueue.insert(std::make_tuple(0,-(int)interactingAtoms[iAtom].size(),(int)iAtom));
+
+	  std::vector<unsigned int> binSizes;
+	  while(!uncoloredAtomsQueue.empty())
+	  {
+	    const int iAtom=std::get<2>(*uncoloredAtomsQueue.begin());
+	    uncoloredAtomsQueue.erase(uncoloredAtomsQueue.begin());
+
+	    int binId=-1;
+	    for(unsigned int iBin = 0; iBin < binSizes.size(); ++iBin)
+	      if (interactingBins[iAtom].find(iBin)==interactingBins[iAtom].end())
+		if (binId==-1 || binSizes[iBin]<binSizes[binId])
+		  binId=iBin;
+
+	    if (binId==-1)
+	    {
+	      binId=binSizes.size();
+	      binSizes.push_back(0);
+	    }
+
+	    atomBin[iAtom]=binId;
+	    binSizes[binId]++;
+	    bins[binId].insert(iAtom);
 
 	    //
-	    // over-write local interaction with items of globalInteractionList
+	    //update the saturation of the uncolored interacting atoms
 	    //
-	    for(unsigned int i = 0 ; i < globalInteractionMapList.size(); ++i)
-	      (interactionMap[iGlobal]).insert(globalInteractionMapList[i]);
-
+	    for(unsigned int j = 0; j < interactingAtoms[iAtom].size(); ++j)
+	    {
+	      const int jAtom=interactingAtoms[iAtom][j];
+	      if (atomBin[jAtom]!=-1 || interactingBins[jAtom].find(binId)!=interactingBins[jAtom].end())
+		continue;
+
+	      const int degree=-(int)interactingAtoms[jAtom].size();
+	      uncoloredAtomsQueue.erase(std::make_tuple(-saturation[jAtom],degree,jAtom));
+	      interactingBins[jAtom].insert(binId);
+	      saturation[jAtom]++;
+	      uncoloredAtomsQueue.insert(std::make_tuple(-saturation[jAtom],degree,jAtom));
+	    }
 	  }
 	}
 
@@ -193,10 +269,11 @@ namespace dftfe
           const unsigned int vertices_per_cell=dealii::GeometryInfo<3>::vertices_per_cell;
 
           std::map<int,std::set<dealii::types::global_dof_index> > atomToGlobalNodeIdMap;
+	  std::vector<dealii::Point<3> > atomCoordinates(totalNumberAtoms);
 	  for(unsigned int iAtom = 0; iAtom < totalNumberAtoms  ; ++iAtom)
 	    {
 	      std::set<dealii::types::global_dof_index> tempNodalSet;
-	      dealii::Point<3> atomCoor;
+	      dealii::Point<3> & atomCoor=atomCoordinates[iAtom];
 
 	      if(iAtom < numberGlobalAtoms)
 		{
@@ -277,6 +354,32 @@ namespace dftfe
 	  //					   mpi_communicator);
 
 	  computing_timer.enter_section("create bins: local interaction maps");
+
+	  //
+	  //hash the atoms having nodes on this processor into a uniform grid of buckets. The nodes
+	  //of an atom lie within a distance of radiusAtomBall plus the largest cell diameter from the atom,
+	  //so atoms with common nodes lie in the same or adjacent buckets
+	  //
+	  double maxCellDiameter=0.0;
+	  dealii::DoFHandler<3>::active_cell_iterator cell = dofHandler.begin_active(),endc = dofHandler.end();
+	  for(; cell!= endc; ++cell)
+	      if(cell->is_locally_owned() || cell->is_ghost())
+		  maxCellDiameter=std::max(maxCellDiameter,cell->diameter());
+
+	  const double bucketSize=2.0*(radiusAtomBall+maxCellDiameter)+1e-8;
+	  std::map<std::array<int,3>,std::vector<int> > bucketToAtomsMap;
+	  std::map<int,std::array<int,3> > atomToBucketMap;
+	  std::map<int,std::set<dealii::types::global_dof_index> >::iterator iterAtom;
+	  for(iterAtom = atomToGlobalNodeIdMap.begin(); iterAtom != atomToGlobalNodeIdMap.end(); ++iterAtom)
+	    {
+	      std::array<int,3> bucketId;
+	      for (unsigned int idim=0; idim<3; ++idim)
+		  bucketId[idim]=std::floor(atomCoordinates[iterAtom->first][idim]/bucketSize);
+
+	      bucketToAtomsMap[bucketId].push_back(iterAtom->first);
+	      atomToBucketMap[iterAtom->first]=bucketId;
+	    }
+
 	  unsigned int ilegalInteraction=0;
 
 	  for(unsigned int iAtom = 0; iAtom < totalNumberAtoms; ++iAtom)
@@ -292,11 +395,31 @@ namespace dftfe
 
 	      //std::cout<<"IAtom: "<<iAtom<<std::endl;
 
-	      for(int jAtom = iAtom - 1; jAtom > -1; jAtom--)
+	      //
+	      //atoms with lower ids in the same and adjacent buckets are the only candidates for interaction
+	      //
+	      std::vector<int> candidateAtoms;
+	      const std::array<int,3> & bucketId=atomToBucketMap[iAtom];
+	      for (int i=-1; i<=1; ++i)
+		for (int j=-1; j<=1; ++j)
+		  for (int k=-1; k<=1; ++k)
+		    {
+		      const std::array<int,3> neighborBucketId={{bucketId[0]+i,bucketId[1]+j,bucketId[2]+k}};
+		      std::map<std::array<int,3>,std::vector<int> >::const_iterator iterBucket
+			  =bucketToAtomsMap.find(neighborBucketId);
+		      if (iterBucket==bucketToAtomsMap.end())
+			  continue;
+
+		      for (unsigned int l=0; l<iterBucket->second.size(); ++l)
+			  if (iterBucket->second[l]<(int)iAtom)
+			      candidateAtoms.push_back(iterBucket->second[l]);
+		    }
+	      std::sort(candidateAtoms.begin(),candidateAtoms.end(),std::greater<int>());
+
+	      for(unsigned int jCandidate = 0; jCandidate < candidateAtoms.size(); ++jCandidate)
 		{
+		  const int jAtom=candidateAtoms[jCandidate];
 		  //std::cout<<"JAtom: "<<jAtom<<std::endl;
-		  if (atomToGlobalNodeIdMap.find(jAtom)==atomToGlobalNodeIdMap.end())
-		      continue;
 		  //
 		  //compute intersection between the atomGlobalNodeIdMap of iAtom and jAtom
 		  //
@@ -455,6 +578,7 @@ namespace dftfe
 
       //create interaction maps by finding the intersection of global NodeIds of each atom
       std::map<int,std::set<int> > interactionMap;
+      const double interactionMapTimeStart=MPI_Wtime();
 
       double radiusAtomBallAdaptive=(d_storedAdaptiveBallRadius>1e-6)?
 	                             d_storedAdaptiveBallRadius:(dftParameters::meshSizeOuterBall>0.5?6.0:4.0);
@@ -534,65 +658,27 @@ namespace dftfe
       }
 
       computing_timer.enter_section("create bins: put in bins");
-      std::map<int,std::set<int> >::iterator iter;
+      const double binsTimeStart=MPI_Wtime();
 
-      //
-      // start by adding atom 0 to bin 0
-      //
-      (d_bins[0]).insert(0);
-      int binCount = 0;
-      // iterate from atom 1 onwards
-      for(int i = 1; i < numberGlobalAtoms; ++i){
+      internal::createBinsByGraphColoring(interactionMap,
+	                                  numberGlobalAtoms,
+					  d_bins);
 
-	const std::set<int> & interactingAtoms = interactionMap[i];
-	//
-	//treat spl case when no atom intersects with another. e.g. simple cubic
-	//
-	if(interactingAtoms.size() == 0){
-	  (d_bins[binCount]).insert(i);
-	  continue;
-	}
-
-	bool isBinFound;
-	// iterate over each existing bin and see if atom i fits into the bin
-	for(iter = d_bins.begin();iter!= d_bins.end();++iter){
-
-	  // pick out atoms in this bin
-	  std::set<int>& atomsInThisBin = iter->second;
-	  int index = std::distance(d_bins.begin(),iter);
-
-	  isBinFound = true;
-
-	  // to belong to this bin, this atom must not overlap with any other
-	  // atom already present in this bin
-	  for(std::set<int>::iterator iter2 = interactingAtoms.begin(); iter2!= interactingAtoms.end();++iter2){
-
-	    int atom = *iter2;
-
-	    if(atomsInThisBin.find(atom) != atomsInThisBin.end()){
-	      isBinFound = false;
-	      break;
-	    }
-	  }
-
-	  if(isBinFound == true){
-	    (d_bins[index]).insert(i);
-	    break;
-	  }
-	}
-	// if all current bins have been iterated over w/o a match then
-	// create a new bin for this atom
-	if(isBinFound == false){
-	  binCount++;
-	  (d_bins[binCount]).insert(i);
+      const int numberBins = d_bins.size();
+      if (dftParameters::verbosity>=2)
+      {
+	unsigned int minAtomsInBin=numberGlobalAtoms, maxAtomsInBin=0;
+	for(int iBin = 0; iBin < numberBins; ++iBin)
+	{
+	  minAtomsInBin=std::min(minAtomsInBin,(unsigned int)d_bins[iBin].size());
+	  maxAtomsInBin=std::max(maxAtomsInBin,(unsigned int)d_bins[iBin].size());
 	}
+	pcout<<"number bins: "<<numberBins<<", min and max number of atoms in a bin: "<<minAtomsInBin<<", "<<maxAtomsInBin<<std::endl;
+	if (!dftParameters::reproducible_output)
+	  pcout<<"Time taken for creating interaction maps: "<<binsTimeStart-interactionMapTimeStart
+	       <<" seconds, and for coloring the interaction graph: "<<MPI_Wtime()-binsTimeStart<<" seconds"<<std::endl;
       }
 
-
-      const int numberBins = binCount + 1;
-      if (dftParameters::verbosity>=2)
-	pcout<<"number bins: "<<numberBins<<std::endl;
-
       computing_timer.exit_section("create bins: put in bins");
 
       computing_timer.enter_section("create bins: set boundary conditions");
@@ -129,7 +129,7 @@ void eigenClass<FEOrder>::computeNonLocalHamiltonianTimesX(const std::vector<vec
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][kPointIndex][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,kPointIndex),
 		     &numberNodesPerElement,
 		     &inputVectors[0],
 		     &numberNodesPerElement,
@@ -147,7 +147,7 @@ void eigenClass<FEOrder>::computeNonLocalHamiltonianTimesX(const std::vector<vec
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,0),
 		     &numberNodesPerElement,
 		     &inputVectors[0],
 		     &numberNodesPerElement,
@@ -266,7 +266,7 @@ void eigenClass<FEOrder>::computeNonLocalHamiltonianTimesX(const std::vector<vec
 		 &numberWaveFunctions,
 		 &numberPseudoWaveFunctions,
 		 &alpha1,
-		 &dftPtr->d_nonLocalProjectorElementMatrices[iAtom][iElemComp][kPointIndex][0],
+		 dftPtr->getNonLocalProjectorElementMatrix(iAtom,iElemComp,kPointIndex),
 		 &numberNodesPerElement,
 		 &projectorKetTimesVector[iAtom][0],
 		 &numberPseudoWaveFunctions,
@@ -283,7 +283,7 @@ void eigenClass<FEOrder>::computeNonLocalHamiltonianTimesX(const std::vector<vec
 		 &numberWaveFunctions,
 		 &numberPseudoWaveFunctions,
 		 &alpha1,
-		 &dftPtr->d_nonLocalProjectorElementMatrices[iAtom][iElemComp][0],
+		 dftPtr->getNonLocalProjectorElementMatrix(iAtom,iElemComp,0),
 		 &numberNodesPerElement,
 		 &projectorKetTimesVector[iAtom][0],
 		 &numberPseudoWaveFunctions,
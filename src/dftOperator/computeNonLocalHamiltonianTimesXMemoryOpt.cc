@@ -125,7 +125,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const s
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][kPointIndex][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,kPointIndex),
 		     &numberNodesPerElement,
 		     &inputVectors[0],
 		     &numberNodesPerElement,
@@ -143,7 +143,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const s
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,0),
 		     &numberNodesPerElement,
 		     &inputVectors[0],
 		     &numberNodesPerElement,
@@ -244,7 +244,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const s
 		 &numberWaveFunctions,
 		 &numberPseudoWaveFunctions,
 		 &alpha1,
-		 &dftPtr->d_nonLocalProjectorElementMatrices[atomId][iElemComp][kPointIndex][0],
+		 dftPtr->getNonLocalProjectorElementMatrix(atomId,iElemComp,kPointIndex),
 		 &numberNodesPerElement,
 		 &projectorKetTimesVector[atomId][0],
 		 &numberPseudoWaveFunctions,
@@ -261,7 +261,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const s
 		 &numberWaveFunctions,
 		 &numberPseudoWaveFunctions,
 		 &alpha1,
-		 &dftPtr->d_nonLocalProjectorElementMatrices[atomId][iElemComp][0],
+		 dftPtr->getNonLocalProjectorElementMatrix(atomId,iElemComp,0),
 		 &numberNodesPerElement,
 		 &projectorKetTimesVector[atomId][0],
 		 &numberPseudoWaveFunctions,
@@ -308,25 +308,24 @@ void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const s
 
 #ifdef USE_COMPLEX
 template<unsigned int FEOrder>
-void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const dealii::parallel::distributed::Vector<std::complex<double> > & src,
-							   const unsigned int numberWaveFunctions,
-							   dealii::parallel::distributed::Vector<std::complex<double> >       & dst) const
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalProjectorKetTimesX(const dealii::parallel::distributed::Vector<std::complex<double> > & src,
+							    const unsigned int numberWaveFunctions) const
 {
 
-  std::map<unsigned int, std::vector<std::complex<double> > > projectorKetTimesVector;
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const dealii::types::global_dof_index slabSizePerkPoint
+    =(dealii::types::global_dof_index)dftPtr->d_nonLocalProjectorCellStartIds[numberCells]*d_numberNodesPerElement;
 
   //
-  //allocate memory for matrix-vector product
+  //flattened element matrices of the current k point
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const int numberSingleAtomPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      projectorKetTimesVector[atomId].resize(numberWaveFunctions*numberSingleAtomPseudoWaveFunctions,0.0);
-    }
+  const std::complex<double> * cellProjectorMatricesConjugate
+    =dftPtr->d_nonLocalProjectorElementMatricesConjugateCellFlattened.begin()+d_kPointIndex*slabSizePerkPoint;
 
+  std::complex<double> * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
 
   std::vector<std::complex<double> > cellWaveFunctionMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
+  std::vector<std::complex<double> > cellProjectorKetTimesVector;
 
   //
   //blas required settings
@@ -334,183 +333,193 @@ void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const d
   const char transA = 'N';
   const char transB = 'N';
   const std::complex<double> alpha = 1.0;
-  const std::complex<double> beta = 1.0;
+  const std::complex<double> beta = 0.0;
   const unsigned int inc = 1;
 
+  dftPtr->d_projectorKetTimesVectorParFlattened=std::complex<double>(0.0,0.0);
 
-  typename DoFHandler<3>::active_cell_iterator cell = dftPtr->dofHandler.begin_active(), endc = dftPtr->dofHandler.end();
-  int iElem = -1;
-  for(; cell!=endc; ++cell)
+  //
+  //compute C^{T}*X with one gemm per cell over all the projectors touching the cell and
+  //accumulate directly into the local entries of the parallel projector vector
+  //
+  for(unsigned int iElem = 0; iElem < numberCells; ++iElem)
     {
-      if(cell->is_locally_owned())
-	{
-	  iElem++;
-	  if (dftPtr->d_nonLocalAtomIdsInElement[iElem].size()>0)
-	  {
-	    for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
-	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem][iNode];
-	      zcopy_(&numberWaveFunctions,
-		     src.begin()+localNodeId,
-		     &inc,
-		     &cellWaveFunctionMatrix[numberWaveFunctions*iNode],
-		     &inc);
-	    }
-	  }
-
-	  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInElement[iElem].size();++iAtom)
-	    {
-	      const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInElement[iElem][iAtom];
-	      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-	      const int nonZeroElementMatrixId = dftPtr->d_sparsityPattern[atomId][iElem];
-
-	      zgemm_(&transA,
-		     &transB,
-		     &numberWaveFunctions,
-		     &numberPseudoWaveFunctions,
-		     &d_numberNodesPerElement,
-		     &alpha,
-		     &cellWaveFunctionMatrix[0],
-		     &numberWaveFunctions,
-		     &dftPtr->d_nonLocalProjectorElementMatricesConjugate[atomId][nonZeroElementMatrixId][d_kPointIndex][0],
-		     &d_numberNodesPerElement,
-		     &beta,
-		     &projectorKetTimesVector[atomId][0],
-		     &numberWaveFunctions);
-	    }
+      const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+      const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+      if (numberCellProjectors==0)
+	continue;
 
+      for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	{
+	  const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
+	  zcopy_(&numberWaveFunctions,
+		 src.begin()+localNodeId,
+		 &inc,
+		 &cellWaveFunctionMatrix[numberWaveFunctions*iNode],
+		 &inc);
+	}
 
+      if (cellProjectorKetTimesVector.size()<numberWaveFunctions*numberCellProjectors)
+	cellProjectorKetTimesVector.resize(numberWaveFunctions*numberCellProjectors);
+
+      zgemm_(&transA,
+	     &transB,
+	     &numberWaveFunctions,
+	     &numberCellProjectors,
+	     &d_numberNodesPerElement,
+	     &alpha,
+	     &cellWaveFunctionMatrix[0],
+	     &numberWaveFunctions,
+	     cellProjectorMatricesConjugate+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement,
+	     &d_numberNodesPerElement,
+	     &beta,
+	     &cellProjectorKetTimesVector[0],
+	     &numberWaveFunctions);
+
+      for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectors; ++iCellProjector)
+	{
+	  const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	  zaxpy_(&numberWaveFunctions,
+		 &alpha,
+		 &cellProjectorKetTimesVector[numberWaveFunctions*iCellProjector],
+		 &inc,
+		 projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		 &inc);
 	}
 
     }//cell loop
 
-  dftPtr->d_projectorKetTimesVectorParFlattened=std::complex<double>(0.0,0.0);
-
-
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
+  //
+  //start the non-blocking accumulation of the ghost contributions on the owning processors
+  //
+  dftPtr->d_projectorKetTimesVectorParFlattened.compress_start(0,VectorOperation::add);
 
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-      {
-        const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
-	zcopy_(&numberWaveFunctions,
-                &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-                &inc,
-                &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-                &inc);
-      }
-    }
+}
 
 
-  dftPtr->d_projectorKetTimesVectorParFlattened.compress(VectorOperation::add);
-  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values();
+template<unsigned int FEOrder>
+void kohnShamDFTOperatorClass<FEOrder>::scaleNonLocalProjectorKetTimesX(const unsigned int numberWaveFunctions) const
+{
+  dftPtr->d_projectorKetTimesVectorParFlattened.compress_finish(VectorOperation::add);
 
   //
-  //compute V*C^{T}*X
+  //compute V*C^{T}*X on the locally owned projectors, the ghost projectors
+  //receive the scaled values in the ghost update
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
+  std::complex<double> * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
+  const unsigned int numberLocallyOwnedProjectors=dftPtr->d_projectorKetTimesVectorParFlattened.local_size()/numberWaveFunctions;
+  const unsigned int inc = 1;
+
+  for(unsigned int iProjector = 0; iProjector < dftPtr->d_nonLocalProjectorLocalIdsCurrentProcess.size(); ++iProjector)
     {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-      {
-	  std::complex<double> nonlocalConstantV;
-	  nonlocalConstantV.real(dftPtr->d_nonLocalPseudoPotentialConstants[atomId][iPseudoAtomicWave]);
-	  nonlocalConstantV.imag(0);
+      const unsigned int localId=dftPtr->d_nonLocalProjectorLocalIdsCurrentProcess[iProjector];
+      if (localId>=numberLocallyOwnedProjectors)
+	continue;
+
+      const double nonlocalConstantV=dftPtr->d_nonLocalProjectorConstantsCurrentProcess[iProjector];
+      zdscal_(&numberWaveFunctions,
+	     &nonlocalConstantV,
+	     projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+	     &inc);
+    }
 
-          const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
+  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values_start(0);
+}
 
-	  zscal_(&numberWaveFunctions,
-		 &nonlocalConstantV,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc);
 
-	  zcopy_(&numberWaveFunctions,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc,
-		 &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-		 &inc);
-      }
+template<unsigned int FEOrder>
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const unsigned int numberWaveFunctions,
+							   dealii::parallel::distributed::Vector<std::complex<double> > & dst) const
+{
 
-    }
+  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values_finish();
+
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const dealii::types::global_dof_index slabSizePerkPoint
+    =(dealii::types::global_dof_index)dftPtr->d_nonLocalProjectorCellStartIds[numberCells]*d_numberNodesPerElement;
+
+  //
+  //flattened element matrices of the current k point
+  //
+  const std::complex<double> * cellProjectorMatrices
+    =dftPtr->d_nonLocalProjectorElementMatricesCellFlattened.begin()+d_kPointIndex*slabSizePerkPoint;
 
+  const std::complex<double> * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
 
+  std::vector<std::complex<double> > cellProjectorKetTimesVector;
   std::vector<std::complex<double> > cellNonLocalHamTimesWaveMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
 
   //blas required settings
   const char transA1 = 'N';
-  const char transB1 = 'N';
+  const char transB1 = 'T';
   const std::complex<double> alpha1 = 1.0;
   const std::complex<double> beta1 = 0.0;
   const unsigned int inc1 = 1;
 
   //
-  //compute C*V*C^{T}*x
+  //compute C*V*C^{T}*x with one gemm per cell over all the projectors touching the cell
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
+  for(unsigned int iElem = 0; iElem < numberCells; ++iElem)
     {
-      const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-       for(unsigned int iElemComp = 0; iElemComp < dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size(); ++iElemComp)
-	{
+      const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+      const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+      if (numberCellProjectors==0)
+	continue;
 
-	  zgemm_(&transA1,
-	         &transB1,
-                 &numberWaveFunctions,
-                 &d_numberNodesPerElement,
-		 &numberPseudoWaveFunctions,
-		 &alpha1,
-		 &projectorKetTimesVector[atomId][0],
-		 &numberWaveFunctions,
-		 &dftPtr->d_nonLocalProjectorElementMatricesTranspose[atomId][iElemComp][d_kPointIndex][0],
-		 &numberPseudoWaveFunctions,
-		 &beta1,
-		 &cellNonLocalHamTimesWaveMatrix[0],
-		 &numberWaveFunctions);
-
-        unsigned int elementId =  dftPtr->d_elementIdsInAtomCompactSupport[atomId][iElemComp];
-
-	for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
-	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[elementId][iNode];
-	      zaxpy_(&numberWaveFunctions,
-		     &alpha1,
-		     &cellNonLocalHamTimesWaveMatrix[numberWaveFunctions*iNode],
-		     &inc1,
-		     dst.begin()+localNodeId,
-		     &inc1);
-	    }
+      if (cellProjectorKetTimesVector.size()<numberWaveFunctions*numberCellProjectors)
+	cellProjectorKetTimesVector.resize(numberWaveFunctions*numberCellProjectors);
 
+      for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectors; ++iCellProjector)
+	{
+	  const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	  zcopy_(&numberWaveFunctions,
+		 projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		 &inc1,
+		 &cellProjectorKetTimesVector[numberWaveFunctions*iCellProjector],
+		 &inc1);
+	}
 
+      zgemm_(&transA1,
+	     &transB1,
+	     &numberWaveFunctions,
+	     &d_numberNodesPerElement,
+	     &numberCellProjectors,
+	     &alpha1,
+	     &cellProjectorKetTimesVector[0],
+	     &numberWaveFunctions,
+	     cellProjectorMatrices+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement,
+	     &d_numberNodesPerElement,
+	     &beta1,
+	     &cellNonLocalHamTimesWaveMatrix[0],
+	     &numberWaveFunctions);
+
+      for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	{
+	  const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
+	  zaxpy_(&numberWaveFunctions,
+		 &alpha1,
+		 &cellNonLocalHamTimesWaveMatrix[numberWaveFunctions*iNode],
+		 &inc1,
+		 dst.begin()+localNodeId,
+		 &inc1);
 	}
 
-    }
+    }//cell loop
 
 }
 #else
 template<unsigned int FEOrder>
-void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const dealii::parallel::distributed::Vector<double> & src,
-							   const unsigned int numberWaveFunctions,
-							   dealii::parallel::distributed::Vector<double>       & dst) const
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalProjectorKetTimesX(const dealii::parallel::distributed::Vector<double > & src,
+							    const unsigned int numberWaveFunctions) const
 {
 
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const double * cellProjectorMatrices=dftPtr->d_nonLocalProjectorElementMatricesCellFlattened.begin();
 
-  std::map<unsigned int, std::vector<double> > projectorKetTimesVector;
-
-  //
-  //allocate memory for matrix-vector product
-  //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const int numberSingleAtomPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      projectorKetTimesVector[atomId].resize(numberWaveFunctions*numberSingleAtomPseudoWaveFunctions,0.0);
-    }
-
+  double * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
 
-  std::vector<double> cellWaveFunctionMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
+  std::vector<double > cellWaveFunctionMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
+  std::vector<double > cellProjectorKetTimesVector;
 
   //
   //blas required settings
@@ -518,158 +527,171 @@ void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const d
   const char transA = 'N';
   const char transB = 'N';
   const double alpha = 1.0;
-  const double beta = 1.0;
+  const double beta = 0.0;
   const unsigned int inc = 1;
 
+  dftPtr->d_projectorKetTimesVectorParFlattened=0.0;
 
-  typename DoFHandler<3>::active_cell_iterator cell = dftPtr->dofHandler.begin_active(), endc = dftPtr->dofHandler.end();
-  int iElem = -1;
-  for(; cell!=endc; ++cell)
+  //
+  //compute C^{T}*X with one gemm per cell over all the projectors touching the cell and
+  //accumulate directly into the local entries of the parallel projector vector
+  //
+  for(unsigned int iElem = 0; iElem < numberCells; ++iElem)
     {
-      if(cell->is_locally_owned())
-	{
-	  iElem++;
-	  if (dftPtr->d_nonLocalAtomIdsInElement[iElem].size()>0)
-	  {
-	    for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
-	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem][iNode];
-	      dcopy_(&numberWaveFunctions,
-		     src.begin()+localNodeId,
-		     &inc,
-		     &cellWaveFunctionMatrix[numberWaveFunctions*iNode],
-		     &inc);
-	    }
-	  }
-
-	  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInElement[iElem].size();++iAtom)
-	    {
-	      const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInElement[iElem][iAtom];
-	      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-	      const int nonZeroElementMatrixId = dftPtr->d_sparsityPattern[atomId][iElem];
-
-	      dgemm_(&transA,
-		     &transB,
-		     &numberWaveFunctions,
-		     &numberPseudoWaveFunctions,
-		     &d_numberNodesPerElement,
-		     &alpha,
-		     &cellWaveFunctionMatrix[0],
-		     &numberWaveFunctions,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][0],
-		     &d_numberNodesPerElement,
-		     &beta,
-		     &projectorKetTimesVector[atomId][0],
-		     &numberWaveFunctions);
-	    }
+      const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+      const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+      if (numberCellProjectors==0)
+	continue;
 
+      for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	{
+	  const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
+	  dcopy_(&numberWaveFunctions,
+		 src.begin()+localNodeId,
+		 &inc,
+		 &cellWaveFunctionMatrix[numberWaveFunctions*iNode],
+		 &inc);
+	}
 
+      if (cellProjectorKetTimesVector.size()<numberWaveFunctions*numberCellProjectors)
+	cellProjectorKetTimesVector.resize(numberWaveFunctions*numberCellProjectors);
+
+      dgemm_(&transA,
+	     &transB,
+	     &numberWaveFunctions,
+	     &numberCellProjectors,
+	     &d_numberNodesPerElement,
+	     &alpha,
+	     &cellWaveFunctionMatrix[0],
+	     &numberWaveFunctions,
+	     cellProjectorMatrices+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement,
+	     &d_numberNodesPerElement,
+	     &beta,
+	     &cellProjectorKetTimesVector[0],
+	     &numberWaveFunctions);
+
+      for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectors; ++iCellProjector)
+	{
+	  const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	  daxpy_(&numberWaveFunctions,
+		 &alpha,
+		 &cellProjectorKetTimesVector[numberWaveFunctions*iCellProjector],
+		 &inc,
+		 projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		 &inc);
 	}
 
     }//cell loop
 
-  dftPtr->d_projectorKetTimesVectorParFlattened=0.0;
-
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-      {
-          const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
+  //
+  //start the non-blocking accumulation of the ghost contributions on the owning processors
+  //
+  dftPtr->d_projectorKetTimesVectorParFlattened.compress_start(0,VectorOperation::add);
 
-          dcopy_(&numberWaveFunctions,
-                &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-                &inc,
-                &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-                &inc);
+}
 
-      }
-    }
 
-  dftPtr->d_projectorKetTimesVectorParFlattened.compress(VectorOperation::add);
-  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values();
+template<unsigned int FEOrder>
+void kohnShamDFTOperatorClass<FEOrder>::scaleNonLocalProjectorKetTimesX(const unsigned int numberWaveFunctions) const
+{
+  dftPtr->d_projectorKetTimesVectorParFlattened.compress_finish(VectorOperation::add);
 
   //
-  //compute V*C^{T}*X
+  //compute V*C^{T}*X on the locally owned projectors, the ghost projectors
+  //receive the scaled values in the ghost update
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
+  double * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
+  const unsigned int numberLocallyOwnedProjectors=dftPtr->d_projectorKetTimesVectorParFlattened.local_size()/numberWaveFunctions;
+  const unsigned int inc = 1;
+
+  for(unsigned int iProjector = 0; iProjector < dftPtr->d_nonLocalProjectorLocalIdsCurrentProcess.size(); ++iProjector)
     {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-	{
-	  double nonlocalConstantV=dftPtr->d_nonLocalPseudoPotentialConstants[atomId][iPseudoAtomicWave];
+      const unsigned int localId=dftPtr->d_nonLocalProjectorLocalIdsCurrentProcess[iProjector];
+      if (localId>=numberLocallyOwnedProjectors)
+	continue;
+
+      const double nonlocalConstantV=dftPtr->d_nonLocalProjectorConstantsCurrentProcess[iProjector];
+      dscal_(&numberWaveFunctions,
+	     &nonlocalConstantV,
+	     projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+	     &inc);
+    }
 
-          const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
+  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values_start(0);
+}
 
-	  dscal_(&numberWaveFunctions,
-		 &nonlocalConstantV,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc);
 
-	  dcopy_(&numberWaveFunctions,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc,
-		 &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-		 &inc);
+template<unsigned int FEOrder>
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesX(const unsigned int numberWaveFunctions,
+							   dealii::parallel::distributed::Vector<double > & dst) const
+{
 
-	}
+  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values_finish();
 
-    }
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const double * cellProjectorMatrices=dftPtr->d_nonLocalProjectorElementMatricesCellFlattened.begin();
 
+  const double * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
 
-  std::vector<double> cellNonLocalHamTimesWaveMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
+  std::vector<double > cellProjectorKetTimesVector;
+  std::vector<double > cellNonLocalHamTimesWaveMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
 
   //blas required settings
   const char transA1 = 'N';
-  const char transB1 = 'N';
+  const char transB1 = 'T';
   const double alpha1 = 1.0;
   const double beta1 = 0.0;
   const unsigned int inc1 = 1;
 
   //
-  //compute C*V*C^{T}*x
+  //compute C*V*C^{T}*x with one gemm per cell over all the projectors touching the cell
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
+  for(unsigned int iElem = 0; iElem < numberCells; ++iElem)
     {
-      const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-       for(unsigned int iElemComp = 0; iElemComp < dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size(); ++iElemComp)
-	{
+      const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+      const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+      if (numberCellProjectors==0)
+	continue;
 
-	  dgemm_(&transA1,
-	         &transB1,
-                 &numberWaveFunctions,
-                 &d_numberNodesPerElement,
-		 &numberPseudoWaveFunctions,
-		 &alpha1,
-		 &projectorKetTimesVector[atomId][0],
-		 &numberWaveFunctions,
-		 &dftPtr->d_nonLocalProjectorElementMatricesTranspose[atomId][iElemComp][0],
-		 &numberPseudoWaveFunctions,
-		 &beta1,
-		 &cellNonLocalHamTimesWaveMatrix[0],
-		 &numberWaveFunctions);
-
-        unsigned int elementId =  dftPtr->d_elementIdsInAtomCompactSupport[atomId][iElemComp];
-
-	for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
-	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[elementId][iNode];
-	      daxpy_(&numberWaveFunctions,
-		     &alpha1,
-		     &cellNonLocalHamTimesWaveMatrix[numberWaveFunctions*iNode],
-		     &inc1,
-		     dst.begin()+localNodeId,
-		     &inc1);
-	    }
+      if (cellProjectorKetTimesVector.size()<numberWaveFunctions*numberCellProjectors)
+	cellProjectorKetTimesVector.resize(numberWaveFunctions*numberCellProjectors);
 
+      for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectors; ++iCellProjector)
+	{
+	  const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	  dcopy_(&numberWaveFunctions,
+		 projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		 &inc1,
+		 &cellProjectorKetTimesVector[numberWaveFunctions*iCellProjector],
+		 &inc1);
+	}
 
+      dgemm_(&transA1,
+	     &transB1,
+	     &numberWaveFunctions,
+	     &d_numberNodesPerElement,
+	     &numberCellProjectors,
+	     &alpha1,
+	     &cellProjectorKetTimesVector[0],
+	     &numberWaveFunctions,
+	     cellProjectorMatrices+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement,
+	     &d_numberNodesPerElement,
+	     &beta1,
+	     &cellNonLocalHamTimesWaveMatrix[0],
+	     &numberWaveFunctions);
+
+      for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	{
+	  const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
+	  daxpy_(&numberWaveFunctions,
+		 &alpha1,
+		 &cellNonLocalHamTimesWaveMatrix[numberWaveFunctions*iNode],
+		 &inc1,
+		 dst.begin()+localNodeId,
+		 &inc1);
 	}
 
-    }
+    }//cell loop
 
 }
 #endif
@@ -20,398 +20,470 @@
 #ifdef WITH_MKL
 #ifdef USE_COMPLEX
 template<unsigned int FEOrder>
-void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesXBatchGEMM(const dealii::parallel::distributed::Vector<std::complex<double> > & src,
-								    const unsigned int numberWaveFunctions,
-								    dealii::parallel::distributed::Vector<std::complex<double> >       & dst) const
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalProjectorKetTimesXBatchGEMM(const dealii::parallel::distributed::Vector<std::complex<double> > & src,
+								     const unsigned int numberWaveFunctions) const
 {
 
-  std::map<unsigned int, std::vector<std::complex<double> > > projectorKetTimesVector;
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const dealii::types::global_dof_index slabSizePerkPoint
+    =(dealii::types::global_dof_index)dftPtr->d_nonLocalProjectorCellStartIds[numberCells]*d_numberNodesPerElement;
 
   //
-  //allocate memory for matrix-vector product
+  //flattened element matrices of the current k point
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const int numberSingleAtomPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      projectorKetTimesVector[atomId].resize(numberWaveFunctions*numberSingleAtomPseudoWaveFunctions,0.0);
-    }
+  const std::complex<double> * cellProjectorMatricesConjugate
+    =dftPtr->d_nonLocalProjectorElementMatricesConjugateCellFlattened.begin()+d_kPointIndex*slabSizePerkPoint;
+
+  std::complex<double> * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
+
+  //
+  //cells touched by the projectors are processed in batches, each cell being one gemm group
+  //as the number of projectors differs between the cells
+  //
+  const unsigned int batchSize=VectorizedArray<double>::n_array_elements;
+
+  std::vector<std::vector<std::complex<double> > > cellWaveFunctionMatrix(batchSize,std::vector<std::complex<double> >(d_numberNodesPerElement*numberWaveFunctions,0.0));
+  std::vector<std::vector<std::complex<double> > > cellProjectorKetTimesVector(batchSize);
+  std::vector<unsigned int> batchCellIds(batchSize);
 
+  std::vector<std::complex<double> *> aBatch(batchSize);
+  std::vector<const std::complex<double> *> bBatch(batchSize);
+  std::vector<std::complex<double> *> cBatch(batchSize);
 
   //
   //blas required settings
   //
-  const char transA = 'N';
-  const char transB = 'N';
-  const std::complex<double> alpha = 1.0;
-  const std::complex<double> beta = 1.0;
+  const std::vector<char> transA(batchSize,'N');
+  const std::vector<char> transB(batchSize,'N');
+  const std::vector<unsigned int> numberWaveFunctionsBatch(batchSize,numberWaveFunctions);
+  const std::vector<unsigned int> numberNodesPerElementBatch(batchSize,d_numberNodesPerElement);
+  std::vector<unsigned int> numberCellProjectorsBatch(batchSize);
+  const std::vector<std::complex<double> > alpha(batchSize,1.0);
+  const std::vector<std::complex<double> > beta(batchSize,0.0);
+  const std::vector<unsigned int> groupSize(batchSize,1);
+  const std::complex<double> scalarCoeffAlpha = 1.0;
   const unsigned int inc = 1;
 
-  std::vector<std::complex<double> > cellWaveFunctionMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
-  typename DoFHandler<3>::active_cell_iterator cell = dftPtr->dofHandler.begin_active(), endc = dftPtr->dofHandler.end();
-  int iElem = -1;
-  for(; cell!=endc; ++cell)
-      if(cell->is_locally_owned())
+  dftPtr->d_projectorKetTimesVectorParFlattened=std::complex<double>(0.0,0.0);
+
+  //
+  //compute C^{T}*X
+  //
+  unsigned int iElem=0;
+  while (iElem<numberCells)
+    {
+      unsigned int groupCount=0;
+      for(; iElem < numberCells && groupCount<batchSize; ++iElem)
 	{
-	  iElem++;
-	  if (dftPtr->d_nonLocalAtomIdsInElement[iElem].size()>0)
-	    for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	  const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+	  const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+	  if (numberCellProjectors==0)
+	    continue;
+
+	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      zcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
 		     &inc,
-		     &cellWaveFunctionMatrix[numberWaveFunctions*iNode],
+		     &cellWaveFunctionMatrix[groupCount][numberWaveFunctions*iNode],
 		     &inc);
 	    }
 
-	  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInElement[iElem].size();++iAtom)
+	  if (cellProjectorKetTimesVector[groupCount].size()<numberWaveFunctions*numberCellProjectors)
+	    cellProjectorKetTimesVector[groupCount].resize(numberWaveFunctions*numberCellProjectors);
+
+	  batchCellIds[groupCount]=iElem;
+	  numberCellProjectorsBatch[groupCount]=numberCellProjectors;
+	  aBatch[groupCount]=&cellWaveFunctionMatrix[groupCount][0];
+	  bBatch[groupCount]=cellProjectorMatricesConjugate+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement;
+	  cBatch[groupCount]=&cellProjectorKetTimesVector[groupCount][0];
+	  groupCount++;
+	}
+
+      if (groupCount==0)
+	continue;
+
+      zgemm_batch_(&transA[0],
+		   &transB[0],
+		   &numberWaveFunctionsBatch[0],
+		   &numberCellProjectorsBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &alpha[0],
+		   &aBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &bBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &beta[0],
+		   &cBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &groupCount,
+		   &groupSize[0]);
+
+      for(unsigned int iGroup = 0; iGroup < groupCount; ++iGroup)
+	{
+	  const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[batchCellIds[iGroup]];
+	  for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectorsBatch[iGroup]; ++iCellProjector)
 	    {
-	      const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInElement[iElem][iAtom];
-	      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-	      const int nonZeroElementMatrixId = dftPtr->d_sparsityPattern[atomId][iElem];
-
-	      zgemm_(&transA,
-		     &transB,
-		     &numberWaveFunctions,
-		     &numberPseudoWaveFunctions,
-		     &d_numberNodesPerElement,
-		     &alpha,
-		     &cellWaveFunctionMatrix[0],
-		     &numberWaveFunctions,
-		     &dftPtr->d_nonLocalProjectorElementMatricesConjugate[atomId][nonZeroElementMatrixId][d_kPointIndex][0],
-		     &d_numberNodesPerElement,
-		     &beta,
-		     &projectorKetTimesVector[atomId][0],
-		     &numberWaveFunctions);
+	      const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	      zaxpy_(&numberWaveFunctions,
+		     &scalarCoeffAlpha,
+		     &cellProjectorKetTimesVector[iGroup][numberWaveFunctions*iCellProjector],
+		     &inc,
+		     projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		     &inc);
 	    }
 	}
+    }//cell batch loop
 
+  //
+  //start the non-blocking accumulation of the ghost contributions on the owning processors
+  //
+  dftPtr->d_projectorKetTimesVectorParFlattened.compress_start(0,VectorOperation::add);
 
+}
 
 
-  dftPtr->d_projectorKetTimesVectorParFlattened=std::complex<double>(0.0,0.0);
-
-
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-      {
-        const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
-	zcopy_(&numberWaveFunctions,
-                &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-                &inc,
-                &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-                &inc);
-      }
-    }
+template<unsigned int FEOrder>
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesXBatchGEMM(const unsigned int numberWaveFunctions,
+								    dealii::parallel::distributed::Vector<std::complex<double> > & dst) const
+{
 
+  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values_finish();
 
-  dftPtr->d_projectorKetTimesVectorParFlattened.compress(VectorOperation::add);
-  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values();
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const dealii::types::global_dof_index slabSizePerkPoint
+    =(dealii::types::global_dof_index)dftPtr->d_nonLocalProjectorCellStartIds[numberCells]*d_numberNodesPerElement;
 
   //
-  //compute V*C^{T}*X
+  //flattened element matrices of the current k point
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-      {
-	  std::complex<double> nonlocalConstantV;
-	  nonlocalConstantV.real(dftPtr->d_nonLocalPseudoPotentialConstants[atomId][iPseudoAtomicWave]);
-	  nonlocalConstantV.imag(0);
-
-          const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
-
-	  zscal_(&numberWaveFunctions,
-		 &nonlocalConstantV,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc);
+  const std::complex<double> * cellProjectorMatrices
+    =dftPtr->d_nonLocalProjectorElementMatricesCellFlattened.begin()+d_kPointIndex*slabSizePerkPoint;
 
-	  zcopy_(&numberWaveFunctions,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc,
-		 &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-		 &inc);
-      }
+  const std::complex<double> * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
 
-    }
+  //
+  //cells touched by the projectors are processed in batches, each cell being one gemm group
+  //as the number of projectors differs between the cells
+  //
+  const unsigned int batchSize=VectorizedArray<double>::n_array_elements;
 
+  std::vector<std::vector<std::complex<double> > > cellWaveFunctionMatrix(batchSize,std::vector<std::complex<double> >(d_numberNodesPerElement*numberWaveFunctions,0.0));
+  std::vector<std::vector<std::complex<double> > > cellProjectorKetTimesVector(batchSize);
+  std::vector<unsigned int> batchCellIds(batchSize);
 
-  std::vector<std::complex<double> > cellNonLocalHamTimesWaveMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
+  std::vector<std::complex<double> *> aBatch(batchSize);
+  std::vector<const std::complex<double> *> bBatch(batchSize);
+  std::vector<std::complex<double> *> cBatch(batchSize);
 
+  //
   //blas required settings
-  const char transA1 = 'N';
-  const char transB1 = 'N';
-  const std::complex<double> alpha1 = 1.0;
-  const std::complex<double> beta1 = 0.0;
-  const unsigned int inc1 = 1;
+  //
+  const std::vector<char> transA(batchSize,'N');
+  const std::vector<char> transB(batchSize,'T');
+  const std::vector<unsigned int> numberWaveFunctionsBatch(batchSize,numberWaveFunctions);
+  const std::vector<unsigned int> numberNodesPerElementBatch(batchSize,d_numberNodesPerElement);
+  std::vector<unsigned int> numberCellProjectorsBatch(batchSize);
+  const std::vector<std::complex<double> > alpha(batchSize,1.0);
+  const std::vector<std::complex<double> > beta(batchSize,0.0);
+  const std::vector<unsigned int> groupSize(batchSize,1);
+  const std::complex<double> scalarCoeffAlpha = 1.0;
+  const unsigned int inc = 1;
 
   //
-  //compute C*V*C^{T}*x
+  //compute C*V*C^{T}*x, the cell wavefunction matrices are reused as the output of the gemms
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
+  unsigned int iElem=0;
+  while (iElem<numberCells)
     {
-       const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-       const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-
-       const unsigned int groupCount=1;
-       const unsigned int groupSize=dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size();
-       std::complex<double> ** cellProjectorKetTimesVectorMatrixBatch = new std::complex<double>*[groupSize];
-       std::complex<double> ** cellNonLocalHamTimesWaveMatrixBatch = new std::complex<double>*[groupSize];
-       const std::complex<double> ** cellNonLocalProjectorKetBatch = new std::complex<double>*[groupSize];
-       for(unsigned int i = 0; i < groupSize; i++)
-	    cellNonLocalHamTimesWaveMatrixBatch[i] = new std::complex<double>[d_numberNodesPerElement*numberWaveFunctions];
-
-       for(unsigned int iElemComp = 0; iElemComp < dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size(); ++iElemComp)
+      unsigned int groupCount=0;
+      for(; iElem < numberCells && groupCount<batchSize; ++iElem)
 	{
-	    cellProjectorKetTimesVectorMatrixBatch[iElemComp]
-		=&projectorKetTimesVector[atomId][0];
-	    cellNonLocalProjectorKetBatch[iElemComp]
-		=&dftPtr->d_nonLocalProjectorElementMatricesTranspose[atomId][iElemComp][d_kPointIndex][0];
-	}
+	  const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+	  const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+	  if (numberCellProjectors==0)
+	    continue;
 
-        zgemm_batch_(&transA1,
-		     &transB1,
-		     &numberWaveFunctions,
-		     &d_numberNodesPerElement,
-		     &numberPseudoWaveFunctions,
-		     &alpha1,
-		     cellProjectorKetTimesVectorMatrixBatch,
-		     &numberWaveFunctions,
-		     cellNonLocalProjectorKetBatch,
-		     &numberPseudoWaveFunctions,
-		     &beta1,
-		     cellNonLocalHamTimesWaveMatrixBatch,
-		     &numberWaveFunctions,
-		     &groupCount,
-		     &groupSize);
-
-        for(unsigned int iElemComp = 0; iElemComp < dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size(); ++iElemComp)
-	{
-	    const unsigned int elementId =  dftPtr->d_elementIdsInAtomCompactSupport[atomId][iElemComp];
-	    for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	  if (cellProjectorKetTimesVector[groupCount].size()<numberWaveFunctions*numberCellProjectors)
+	    cellProjectorKetTimesVector[groupCount].resize(numberWaveFunctions*numberCellProjectors);
+
+	  for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectors; ++iCellProjector)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[elementId][iNode];
-	      zaxpy_(&numberWaveFunctions,
-		     &alpha1,
-		     &cellNonLocalHamTimesWaveMatrixBatch[iElemComp][numberWaveFunctions*iNode],
-		     &inc1,
-		     dst.begin()+localNodeId,
-		     &inc1);
+	      const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	      zcopy_(&numberWaveFunctions,
+		     projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		     &inc,
+		     &cellProjectorKetTimesVector[groupCount][numberWaveFunctions*iCellProjector],
+		     &inc);
 	    }
-	}
-
-	for(unsigned int i = 0; i < groupSize; i++)
-	   delete [] cellNonLocalHamTimesWaveMatrixBatch[i];
 
-	delete [] cellNonLocalHamTimesWaveMatrixBatch;
-        delete [] cellNonLocalProjectorKetBatch;
-        delete [] cellProjectorKetTimesVectorMatrixBatch;
+	  batchCellIds[groupCount]=iElem;
+	  numberCellProjectorsBatch[groupCount]=numberCellProjectors;
+	  aBatch[groupCount]=&cellProjectorKetTimesVector[groupCount][0];
+	  bBatch[groupCount]=cellProjectorMatrices+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement;
+	  cBatch[groupCount]=&cellWaveFunctionMatrix[groupCount][0];
+	  groupCount++;
+	}
 
-    }//non local atomid loop
+      if (groupCount==0)
+	continue;
+
+      zgemm_batch_(&transA[0],
+		   &transB[0],
+		   &numberWaveFunctionsBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &numberCellProjectorsBatch[0],
+		   &alpha[0],
+		   &aBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &bBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &beta[0],
+		   &cBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &groupCount,
+		   &groupSize[0]);
+
+      for(unsigned int iGroup = 0; iGroup < groupCount; ++iGroup)
+	for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	  {
+	    const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[batchCellIds[iGroup]*d_numberNodesPerElement+iNode];
+	    zaxpy_(&numberWaveFunctions,
+		   &scalarCoeffAlpha,
+		   &cellWaveFunctionMatrix[iGroup][numberWaveFunctions*iNode],
+		   &inc,
+		   dst.begin()+localNodeId,
+		   &inc);
+	  }
+    }//cell batch loop
 
 }
-
 #else
 template<unsigned int FEOrder>
-void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesXBatchGEMM(const dealii::parallel::distributed::Vector<double> & src,
-								    const unsigned int numberWaveFunctions,
-								    dealii::parallel::distributed::Vector<double>       & dst) const
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalProjectorKetTimesXBatchGEMM(const dealii::parallel::distributed::Vector<double > & src,
+								     const unsigned int numberWaveFunctions) const
 {
 
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const double * cellProjectorMatrices=dftPtr->d_nonLocalProjectorElementMatricesCellFlattened.begin();
 
-  std::map<unsigned int, std::vector<double> > projectorKetTimesVector;
+  double * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
 
   //
-  //allocate memory for matrix-vector product
+  //cells touched by the projectors are processed in batches, each cell being one gemm group
+  //as the number of projectors differs between the cells
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const int numberSingleAtomPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      projectorKetTimesVector[atomId].resize(numberWaveFunctions*numberSingleAtomPseudoWaveFunctions,0.0);
-    }
+  const unsigned int batchSize=VectorizedArray<double>::n_array_elements;
 
+  std::vector<std::vector<double > > cellWaveFunctionMatrix(batchSize,std::vector<double >(d_numberNodesPerElement*numberWaveFunctions,0.0));
+  std::vector<std::vector<double > > cellProjectorKetTimesVector(batchSize);
+  std::vector<unsigned int> batchCellIds(batchSize);
+
+  std::vector<double *> aBatch(batchSize);
+  std::vector<const double *> bBatch(batchSize);
+  std::vector<double *> cBatch(batchSize);
 
   //
   //blas required settings
   //
-  const char transA = 'N';
-  const char transB = 'N';
-  const double alpha = 1.0;
-  const double beta = 1.0;
+  const std::vector<char> transA(batchSize,'N');
+  const std::vector<char> transB(batchSize,'N');
+  const std::vector<unsigned int> numberWaveFunctionsBatch(batchSize,numberWaveFunctions);
+  const std::vector<unsigned int> numberNodesPerElementBatch(batchSize,d_numberNodesPerElement);
+  std::vector<unsigned int> numberCellProjectorsBatch(batchSize);
+  const std::vector<double > alpha(batchSize,1.0);
+  const std::vector<double > beta(batchSize,0.0);
+  const std::vector<unsigned int> groupSize(batchSize,1);
+  const double scalarCoeffAlpha = 1.0;
   const unsigned int inc = 1;
 
-  std::vector<double> cellWaveFunctionMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
-  typename DoFHandler<3>::active_cell_iterator cell = dftPtr->dofHandler.begin_active(), endc = dftPtr->dofHandler.end();
-  int iElem = -1;
-  for(; cell!=endc; ++cell)
-      if(cell->is_locally_owned())
+  dftPtr->d_projectorKetTimesVectorParFlattened=0.0;
+
+  //
+  //compute C^{T}*X
+  //
+  unsigned int iElem=0;
+  while (iElem<numberCells)
+    {
+      unsigned int groupCount=0;
+      for(; iElem < numberCells && groupCount<batchSize; ++iElem)
 	{
-	  iElem++;
-	  if (dftPtr->d_nonLocalAtomIdsInElement[iElem].size()>0)
-	    for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	  const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+	  const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+	  if (numberCellProjectors==0)
+	    continue;
+
+	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      dcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
 		     &inc,
-		     &cellWaveFunctionMatrix[numberWaveFunctions*iNode],
+		     &cellWaveFunctionMatrix[groupCount][numberWaveFunctions*iNode],
 		     &inc);
 	    }
 
-	  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInElement[iElem].size();++iAtom)
+	  if (cellProjectorKetTimesVector[groupCount].size()<numberWaveFunctions*numberCellProjectors)
+	    cellProjectorKetTimesVector[groupCount].resize(numberWaveFunctions*numberCellProjectors);
+
+	  batchCellIds[groupCount]=iElem;
+	  numberCellProjectorsBatch[groupCount]=numberCellProjectors;
+	  aBatch[groupCount]=&cellWaveFunctionMatrix[groupCount][0];
+	  bBatch[groupCount]=cellProjectorMatrices+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement;
+	  cBatch[groupCount]=&cellProjectorKetTimesVector[groupCount][0];
+	  groupCount++;
+	}
+
+      if (groupCount==0)
+	continue;
+
+      dgemm_batch_(&transA[0],
+		   &transB[0],
+		   &numberWaveFunctionsBatch[0],
+		   &numberCellProjectorsBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &alpha[0],
+		   &aBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &bBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &beta[0],
+		   &cBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &groupCount,
+		   &groupSize[0]);
+
+      for(unsigned int iGroup = 0; iGroup < groupCount; ++iGroup)
+	{
+	  const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[batchCellIds[iGroup]];
+	  for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectorsBatch[iGroup]; ++iCellProjector)
 	    {
-	      const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInElement[iElem][iAtom];
-	      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-	      const int nonZeroElementMatrixId = dftPtr->d_sparsityPattern[atomId][iElem];
-
-	      dgemm_(&transA,
-		     &transB,
-		     &numberWaveFunctions,
-		     &numberPseudoWaveFunctions,
-		     &d_numberNodesPerElement,
-		     &alpha,
-		     &cellWaveFunctionMatrix[0],
-		     &numberWaveFunctions,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][0],
-		     &d_numberNodesPerElement,
-		     &beta,
-		     &projectorKetTimesVector[atomId][0],
-		     &numberWaveFunctions);
+	      const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	      daxpy_(&numberWaveFunctions,
+		     &scalarCoeffAlpha,
+		     &cellProjectorKetTimesVector[iGroup][numberWaveFunctions*iCellProjector],
+		     &inc,
+		     projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		     &inc);
 	    }
 	}
+    }//cell batch loop
 
+  //
+  //start the non-blocking accumulation of the ghost contributions on the owning processors
+  //
+  dftPtr->d_projectorKetTimesVectorParFlattened.compress_start(0,VectorOperation::add);
 
+}
 
-  dftPtr->d_projectorKetTimesVectorParFlattened=0.0;
-
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
 
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-      {
-          const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
+template<unsigned int FEOrder>
+void kohnShamDFTOperatorClass<FEOrder>::computeNonLocalHamiltonianTimesXBatchGEMM(const unsigned int numberWaveFunctions,
+								    dealii::parallel::distributed::Vector<double > & dst) const
+{
 
-          dcopy_(&numberWaveFunctions,
-                &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-                &inc,
-                &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-                &inc);
+  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values_finish();
 
-      }
-    }
+  const unsigned int numberCells=dftPtr->d_nonLocalProjectorCellStartIds.size()-1;
+  const double * cellProjectorMatrices=dftPtr->d_nonLocalProjectorElementMatricesCellFlattened.begin();
 
-  dftPtr->d_projectorKetTimesVectorParFlattened.compress(VectorOperation::add);
-  dftPtr->d_projectorKetTimesVectorParFlattened.update_ghost_values();
+  const double * projectorKetTimesVector=dftPtr->d_projectorKetTimesVectorParFlattened.begin();
 
   //
-  //compute V*C^{T}*X
+  //cells touched by the projectors are processed in batches, each cell being one gemm group
+  //as the number of projectors differs between the cells
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
-    {
-      const unsigned int atomId=dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-      const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-      for(unsigned int iPseudoAtomicWave = 0; iPseudoAtomicWave < numberPseudoWaveFunctions; ++iPseudoAtomicWave)
-	{
-	  double nonlocalConstantV=dftPtr->d_nonLocalPseudoPotentialConstants[atomId][iPseudoAtomicWave];
-
-          const unsigned int id=dftPtr->d_projectorIdsNumberingMapCurrentProcess[std::make_pair(atomId,iPseudoAtomicWave)];
+  const unsigned int batchSize=VectorizedArray<double>::n_array_elements;
 
-	  dscal_(&numberWaveFunctions,
-		 &nonlocalConstantV,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc);
-
-	  dcopy_(&numberWaveFunctions,
-		 &dftPtr->d_projectorKetTimesVectorParFlattened[id*numberWaveFunctions],
-		 &inc,
-		 &projectorKetTimesVector[atomId][numberWaveFunctions*iPseudoAtomicWave],
-		 &inc);
-
-	}
-
-    }
+  std::vector<std::vector<double > > cellWaveFunctionMatrix(batchSize,std::vector<double >(d_numberNodesPerElement*numberWaveFunctions,0.0));
+  std::vector<std::vector<double > > cellProjectorKetTimesVector(batchSize);
+  std::vector<unsigned int> batchCellIds(batchSize);
 
+  std::vector<double *> aBatch(batchSize);
+  std::vector<const double *> bBatch(batchSize);
+  std::vector<double *> cBatch(batchSize);
 
+  //
   //blas required settings
-  const char transA1 = 'N';
-  const char transB1 = 'N';
-  const double alpha1 = 1.0;
-  const double beta1 = 0.0;
-  const unsigned int inc1 = 1;
+  //
+  const std::vector<char> transA(batchSize,'N');
+  const std::vector<char> transB(batchSize,'T');
+  const std::vector<unsigned int> numberWaveFunctionsBatch(batchSize,numberWaveFunctions);
+  const std::vector<unsigned int> numberNodesPerElementBatch(batchSize,d_numberNodesPerElement);
+  std::vector<unsigned int> numberCellProjectorsBatch(batchSize);
+  const std::vector<double > alpha(batchSize,1.0);
+  const std::vector<double > beta(batchSize,0.0);
+  const std::vector<unsigned int> groupSize(batchSize,1);
+  const double scalarCoeffAlpha = 1.0;
+  const unsigned int inc = 1;
 
   //
-  //compute C*V*C^{T}*x
+  //compute C*V*C^{T}*x, the cell wavefunction matrices are reused as the output of the gemms
   //
-  for(unsigned int iAtom = 0; iAtom < dftPtr->d_nonLocalAtomIdsInCurrentProcess.size(); ++iAtom)
+  unsigned int iElem=0;
+  while (iElem<numberCells)
     {
-       const unsigned int atomId = dftPtr->d_nonLocalAtomIdsInCurrentProcess[iAtom];
-       const unsigned int numberPseudoWaveFunctions = dftPtr->d_numberPseudoAtomicWaveFunctions[atomId];
-
-       const unsigned int groupCount=1;
-       const unsigned int groupSize=dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size();
-       double ** cellProjectorKetTimesVectorMatrixBatch = new double*[groupSize];
-       double ** cellNonLocalHamTimesWaveMatrixBatch = new double*[groupSize];
-       const double ** cellNonLocalProjectorKetBatch = new double*[groupSize];
-       for(unsigned int i = 0; i < groupSize; i++)
-	    cellNonLocalHamTimesWaveMatrixBatch[i] = new double[d_numberNodesPerElement*numberWaveFunctions];
-
-       for(unsigned int iElemComp = 0; iElemComp < dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size(); ++iElemComp)
+      unsigned int groupCount=0;
+      for(; iElem < numberCells && groupCount<batchSize; ++iElem)
 	{
-	    cellProjectorKetTimesVectorMatrixBatch[iElemComp]
-		=&projectorKetTimesVector[atomId][0];
-	    cellNonLocalProjectorKetBatch[iElemComp]
-		=&dftPtr->d_nonLocalProjectorElementMatricesTranspose[atomId][iElemComp][0];
-	}
+	  const unsigned int cellStartId=dftPtr->d_nonLocalProjectorCellStartIds[iElem];
+	  const unsigned int numberCellProjectors=dftPtr->d_nonLocalProjectorCellStartIds[iElem+1]-cellStartId;
+	  if (numberCellProjectors==0)
+	    continue;
 
-        dgemm_batch_(&transA1,
-		     &transB1,
-		     &numberWaveFunctions,
-		     &d_numberNodesPerElement,
-		     &numberPseudoWaveFunctions,
-		     &alpha1,
-		     cellProjectorKetTimesVectorMatrixBatch,
-		     &numberWaveFunctions,
-		     cellNonLocalProjectorKetBatch,
-		     &numberPseudoWaveFunctions,
-		     &beta1,
-		     cellNonLocalHamTimesWaveMatrixBatch,
-		     &numberWaveFunctions,
-		     &groupCount,
-		     &groupSize);
-
-        for(unsigned int iElemComp = 0; iElemComp < dftPtr->d_elementIteratorsInAtomCompactSupport[atomId].size(); ++iElemComp)
-	{
-	    const unsigned int elementId =  dftPtr->d_elementIdsInAtomCompactSupport[atomId][iElemComp];
-	    for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	  if (cellProjectorKetTimesVector[groupCount].size()<numberWaveFunctions*numberCellProjectors)
+	    cellProjectorKetTimesVector[groupCount].resize(numberWaveFunctions*numberCellProjectors);
+
+	  for(unsigned int iCellProjector = 0; iCellProjector < numberCellProjectors; ++iCellProjector)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[elementId][iNode];
-	      daxpy_(&numberWaveFunctions,
-		     &alpha1,
-		     &cellNonLocalHamTimesWaveMatrixBatch[iElemComp][numberWaveFunctions*iNode],
-		     &inc1,
-		     dst.begin()+localNodeId,
-		     &inc1);
+	      const unsigned int localId=dftPtr->d_nonLocalProjectorCellLocalIds[cellStartId+iCellProjector];
+	      dcopy_(&numberWaveFunctions,
+		     projectorKetTimesVector+(dealii::types::global_dof_index)localId*numberWaveFunctions,
+		     &inc,
+		     &cellProjectorKetTimesVector[groupCount][numberWaveFunctions*iCellProjector],
+		     &inc);
 	    }
-	}
 
-	for(unsigned int i = 0; i < groupSize; i++)
-	   delete [] cellNonLocalHamTimesWaveMatrixBatch[i];
-
-	delete [] cellNonLocalHamTimesWaveMatrixBatch;
-        delete [] cellNonLocalProjectorKetBatch;
-        delete [] cellProjectorKetTimesVectorMatrixBatch;
+	  batchCellIds[groupCount]=iElem;
+	  numberCellProjectorsBatch[groupCount]=numberCellProjectors;
+	  aBatch[groupCount]=&cellProjectorKetTimesVector[groupCount][0];
+	  bBatch[groupCount]=cellProjectorMatrices+(dealii::types::global_dof_index)cellStartId*d_numberNodesPerElement;
+	  cBatch[groupCount]=&cellWaveFunctionMatrix[groupCount][0];
+	  groupCount++;
+	}
 
-    }//non local atomid loop
+      if (groupCount==0)
+	continue;
+
+      dgemm_batch_(&transA[0],
+		   &transB[0],
+		   &numberWaveFunctionsBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &numberCellProjectorsBatch[0],
+		   &alpha[0],
+		   &aBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &bBatch[0],
+		   &numberNodesPerElementBatch[0],
+		   &beta[0],
+		   &cBatch[0],
+		   &numberWaveFunctionsBatch[0],
+		   &groupCount,
+		   &groupSize[0]);
+
+      for(unsigned int iGroup = 0; iGroup < groupCount; ++iGroup)
+	for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
+	  {
+	    const unsigned int localNodeId = d_flattenedArrayCellLocalProcIndexIdMap[batchCellIds[iGroup]*d_numberNodesPerElement+iNode];
+	    daxpy_(&numberWaveFunctions,
+		   &scalarCoeffAlpha,
+		   &cellWaveFunctionMatrix[iGroup][numberWaveFunctions*iNode],
+		   &inc,
+		   dst.begin()+localNodeId,
+		   &inc);
+	  }
+    }//cell batch loop
 
 }
 #endif
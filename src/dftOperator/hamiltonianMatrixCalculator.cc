@@ -178,6 +178,9 @@ void kohnShamDFTOperatorClass<FEOrder>::computeHamiltonianMatrix(unsigned int kP
 
     }//macrocell loop
 
+  memoryLedger::setBytes(memoryLedger::cellHamiltonians,
+			 "cell Hamiltonian matrices",
+			 memoryLedger::getBytes(d_cellHamiltonianMatrix));
 }
 
 
@@ -249,4 +252,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeKineticMatrix()
 
     }//macrocell loop
 
+  memoryLedger::setBytes(memoryLedger::cellHamiltonians,
+			 "cell Hamiltonian matrices",
+			 memoryLedger::getBytes(d_cellHamiltonianMatrix));
 }
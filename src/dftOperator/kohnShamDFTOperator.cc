@@ -23,6 +23,8 @@
 #include <linearAlgebraOperationsInternal.h>
 #include <vectorUtilities.h>
 #include <dftUtils.h>
+#include <performanceTelemetry.h>
+#include <memoryLedger.h>
 
 
 namespace dftfe {
@@ -44,6 +46,8 @@ namespace dftfe {
     d_kPointIndex(0),
     d_numberNodesPerElement(_dftPtr->matrix_free_data.get_dofs_per_cell()),
     d_numberMacroCells(_dftPtr->matrix_free_data.n_macro_cells()),
+    d_flattenedArrayMacroCellLocalProcIndexIdMap(NULL),
+    d_flattenedArrayCellLocalProcIndexIdMap(NULL),
     mpi_communicator (mpi_comm_replica),
     n_mpi_processes (Utilities::MPI::n_mpi_processes(mpi_comm_replica)),
     this_mpi_process (Utilities::MPI::this_mpi_process(mpi_comm_replica)),
@@ -104,30 +108,31 @@ namespace dftfe {
 				   bool flag)
   {
 
+    //
+    //the flattened partitioner and the index maps are created only on the first request
+    //of a given block size and are reused afterwards
+    //
+    d_flattenedArrayData=dftPtr->d_flattenedArrayRegistry.getFlattenedArrayData(dftPtr->matrix_free_data,
+										 numberWaveFunctions);
+
     if(flag)
-	vectorTools::createDealiiVector<dataTypes::number>(dftPtr->matrix_free_data.get_vector_partitioner(),
-							   numberWaveFunctions,
-							   flattenedArray);
+	flattenedArray.reinit(d_flattenedArrayData->partitioner);
+
+    AssertThrow(flattenedArray.local_size()==d_flattenedArrayData->partitioner->local_size(),
+		dealii::ExcMessage("DFT-FE Error: flattened array is incompatible with the number of wavefunctions"));
 
     if(dftParameters::isPseudopotential)
     {
-      vectorTools::createDealiiVector<dataTypes::number>(dftPtr->d_projectorKetTimesVectorPar[0].get_partitioner(),
-							 numberWaveFunctions,
-							 dftPtr->d_projectorKetTimesVectorParFlattened);
+      dftPtr->d_projectorKetTimesVectorParFlattened.reinit
+	(dftPtr->d_flattenedArrayRegistry.getFlattenedPartitioner(dftPtr->d_projectorKetTimesVectorPar[0].get_partitioner(),
+								   numberWaveFunctions));
 
     }
 
+    d_flattenedArrayMacroCellLocalProcIndexIdMap=d_flattenedArrayData->macroCellLocalProcIndexIdMap.data();
+    d_flattenedArrayCellLocalProcIndexIdMap=d_flattenedArrayData->cellLocalProcIndexIdMap.data();
 
-
-    vectorTools::computeCellLocalIndexSetMap(flattenedArray.get_partitioner(),
-					     dftPtr->matrix_free_data,
-					     numberWaveFunctions,
-					     d_flattenedArrayMacroCellLocalProcIndexIdMap,
-					     d_flattenedArrayCellLocalProcIndexIdMap);
-
-    getOverloadedConstraintMatrix()->precomputeMaps(dftPtr->matrix_free_data.get_vector_partitioner(),
-						    flattenedArray.get_partitioner(),
-						    numberWaveFunctions);
+    getOverloadedConstraintMatrix()->precomputeMaps(d_flattenedArrayData->localIndexMapUnflattenedToFlattened);
   }
 
 template<unsigned int FEOrder>
@@ -136,9 +141,9 @@ void kohnShamDFTOperatorClass<FEOrder>::reinit(const unsigned int numberWaveFunc
 
   if(dftParameters::isPseudopotential)
   {
-    vectorTools::createDealiiVector<dataTypes::number>(dftPtr->d_projectorKetTimesVectorPar[0].get_partitioner(),
-						       numberWaveFunctions,
-						       dftPtr->d_projectorKetTimesVectorParFlattened);
+    dftPtr->d_projectorKetTimesVectorParFlattened.reinit
+      (dftPtr->d_flattenedArrayRegistry.getFlattenedPartitioner(dftPtr->d_projectorKetTimesVectorPar[0].get_partitioner(),
+								 numberWaveFunctions));
   }
 
 }
@@ -410,6 +415,103 @@ void kohnShamDFTOperatorClass<FEOrder>::computeVEff(const std::map<dealii::CellI
 }
 
 
+template<unsigned int FEOrder>
+void kohnShamDFTOperatorClass<FEOrder>::computeHamiltonianTimesX(const dealii::parallel::distributed::Vector<dataTypes::number> & src,
+								 const unsigned int numberWaveFunctions,
+								 dealii::parallel::distributed::Vector<dataTypes::number> & dst) const
+{
+  const bool isNonLocalHamiltonian=dftParameters::isPseudopotential && dftPtr->d_nonLocalAtomGlobalChargeIds.size() > 0;
+#ifdef WITH_MKL
+  const bool useBatchGEMM=dftParameters::useBatchGEMM && numberWaveFunctions<1000;
+#endif
+
+  //
+  //the local Hamiltonian times X over the macro cells is split into two halves, the first
+  //overlapping with the reduction of the nonlocal projector kets times X and the second
+  //with their ghost update
+  //
+  const unsigned int macroCellMidId=isNonLocalHamiltonian?d_numberMacroCells/2:d_numberMacroCells;
+
+  if (isNonLocalHamiltonian)
+    {
+      //reduction and ghost update of the projector kets times X
+      performanceTelemetry::addCommunicatedBytes("HX nonlocal",
+						 2.0*dftPtr->d_projectorKetTimesVectorParFlattened.get_partitioner()->n_ghost_indices()*sizeof(dataTypes::number));
+#ifdef WITH_MKL
+      if (useBatchGEMM)
+	computeNonLocalProjectorKetTimesXBatchGEMM(src,
+						   numberWaveFunctions);
+      else
+	computeNonLocalProjectorKetTimesX(src,
+					  numberWaveFunctions);
+#else
+      computeNonLocalProjectorKetTimesX(src,
+					numberWaveFunctions);
+#endif
+    }
+
+#ifdef WITH_MKL
+  if (useBatchGEMM)
+    computeLocalHamiltonianTimesXBatchGEMM(src,
+					   numberWaveFunctions,
+					   dst,
+					   0,
+					   macroCellMidId);
+  else
+    computeLocalHamiltonianTimesX(src,
+				  numberWaveFunctions,
+				  dst,
+				  0,
+				  macroCellMidId);
+#else
+  computeLocalHamiltonianTimesX(src,
+				numberWaveFunctions,
+				dst,
+				0,
+				macroCellMidId);
+#endif
+
+  if (isNonLocalHamiltonian)
+    scaleNonLocalProjectorKetTimesX(numberWaveFunctions);
+
+#ifdef WITH_MKL
+  if (useBatchGEMM)
+    computeLocalHamiltonianTimesXBatchGEMM(src,
+					   numberWaveFunctions,
+					   dst,
+					   macroCellMidId,
+					   d_numberMacroCells);
+  else
+    computeLocalHamiltonianTimesX(src,
+				  numberWaveFunctions,
+				  dst,
+				  macroCellMidId,
+				  d_numberMacroCells);
+#else
+  computeLocalHamiltonianTimesX(src,
+				numberWaveFunctions,
+				dst,
+				macroCellMidId,
+				d_numberMacroCells);
+#endif
+
+  if (isNonLocalHamiltonian)
+    {
+#ifdef WITH_MKL
+      if (useBatchGEMM)
+	computeNonLocalHamiltonianTimesXBatchGEMM(numberWaveFunctions,
+						  dst);
+      else
+	computeNonLocalHamiltonianTimesX(numberWaveFunctions,
+					 dst);
+#else
+      computeNonLocalHamiltonianTimesX(numberWaveFunctions,
+				       dst);
+#endif
+    }
+}
+
+
 #ifdef USE_COMPLEX
   template<unsigned int FEOrder>
   void kohnShamDFTOperatorClass<FEOrder>::HX(dealii::parallel::distributed::Vector<std::complex<double> > & src,
@@ -420,6 +522,10 @@ void kohnShamDFTOperatorClass<FEOrder>::computeVEff(const std::map<dealii::CellI
 
 
   {
+    //ghost values update of src and compress of dst
+    performanceTelemetry::addCommunicatedBytes("HX",
+					       2.0*src.get_partitioner()->n_ghost_indices()*sizeof(dataTypes::number));
+
     const unsigned int numberDofs = src.local_size()/numberWaveFunctions;
     const unsigned int inc = 1;
 
@@ -462,43 +568,12 @@ void kohnShamDFTOperatorClass<FEOrder>::computeVEff(const std::map<dealii::CellI
 
 
     //
-    //Hloc*M^{-1/2}*X
+    //Hloc*M^{-1/2}*X and if its a pseudopotential calculation and number of nonlocal atoms are greater
+    //than zero H^{nloc}*M^{-1/2}*X
     //
-#ifdef WITH_MKL
-    if (dftParameters::useBatchGEMM && numberWaveFunctions<1000)
-       computeLocalHamiltonianTimesXBatchGEMM(src,
-				              numberWaveFunctions,
-				              dst);
-    else
-       computeLocalHamiltonianTimesX(src,
-				     numberWaveFunctions,
- 				     dst);
-#else
-       computeLocalHamiltonianTimesX(src,
-				     numberWaveFunctions,
- 				     dst);
-#endif
-
-    //
-    //required if its a pseudopotential calculation and number of nonlocal atoms are greater than zero
-    //H^{nloc}*M^{-1/2}*X
-    if(dftParameters::isPseudopotential && dftPtr->d_nonLocalAtomGlobalChargeIds.size() > 0)
-    {
-#ifdef WITH_MKL
-      if (dftParameters::useBatchGEMM && numberWaveFunctions<1000)
-        computeNonLocalHamiltonianTimesXBatchGEMM(src,
-				                  numberWaveFunctions,
-				                  dst);
-      else
-        computeNonLocalHamiltonianTimesX(src,
-				         numberWaveFunctions,
-				         dst);
-#else
-        computeNonLocalHamiltonianTimesX(src,
-				         numberWaveFunctions,
-				         dst);
-#endif
-    }
+    computeHamiltonianTimesX(src,
+			     numberWaveFunctions,
+			     dst);
 
 
     //
@@ -565,6 +640,10 @@ void kohnShamDFTOperatorClass<FEOrder>::MX(dealii::parallel::distributed::Vector
 
 
   {
+    //ghost values update of src and compress of dst
+    performanceTelemetry::addCommunicatedBytes("HX",
+					       2.0*src.get_partitioner()->n_ghost_indices()*sizeof(dataTypes::number));
+
     const unsigned int numberDofs = src.local_size()/numberWaveFunctions;
     const unsigned int inc = 1;
 
@@ -604,47 +683,12 @@ void kohnShamDFTOperatorClass<FEOrder>::MX(dealii::parallel::distributed::Vector
     //src.update_ghost_values();
 
     //
-    //Hloc*M^{-1/2}*X
+    //Hloc*M^{-1/2}*X and if its a pseudopotential calculation and number of nonlocal atoms are greater
+    //than zero H^{nloc}*M^{-1/2}*X
     //
-#ifdef WITH_MKL
-    if (dftParameters::useBatchGEMM && numberWaveFunctions<1000)
-    {
-	  computeLocalHamiltonianTimesXBatchGEMM(src,
-				  numberWaveFunctions,
-				  dst);
-    }
-    else
-       computeLocalHamiltonianTimesX(src,
-				     numberWaveFunctions,
- 				     dst);
-#else
-       computeLocalHamiltonianTimesX(src,
-				     numberWaveFunctions,
- 				     dst);
-#endif
-
-    //
-    //required if its a pseudopotential calculation and number of nonlocal atoms are greater than zero
-    //H^{nloc}*M^{-1/2}*X
-    if(dftParameters::isPseudopotential && dftPtr->d_nonLocalAtomGlobalChargeIds.size() > 0)
-    {
-#ifdef WITH_MKL
-      if (dftParameters::useBatchGEMM && numberWaveFunctions<1000)
-      {
-            computeNonLocalHamiltonianTimesXBatchGEMM(src,
-				                  numberWaveFunctions,
-				                  dst);
-      }
-      else
-        computeNonLocalHamiltonianTimesX(src,
-				         numberWaveFunctions,
-				         dst);
-#else
-        computeNonLocalHamiltonianTimesX(src,
-				         numberWaveFunctions,
-				         dst);
-#endif
-    }
+    computeHamiltonianTimesX(src,
+			     numberWaveFunctions,
+			     dst);
 
 
 
@@ -692,6 +736,10 @@ void kohnShamDFTOperatorClass<FEOrder>::MX(dealii::parallel::distributed::Vector
 
 
   {
+    //ghost values update of src and compress of dst
+    performanceTelemetry::addCommunicatedBytes("HX",
+					       2.0*src.get_partitioner()->n_ghost_indices()*sizeof(dataTypes::number));
+
     const unsigned int numberDofs = src.local_size()/numberWaveFunctions;
     const unsigned int inc = 1;
    
@@ -705,47 +753,12 @@ void kohnShamDFTOperatorClass<FEOrder>::MX(dealii::parallel::distributed::Vector
     //src.update_ghost_values();
 
     //
-    //Hloc*X
+    //Hloc*X and if its a pseudopotential calculation and number of nonlocal atoms are greater
+    //than zero H^{nloc}*X
     //
-#ifdef WITH_MKL
-    if (dftParameters::useBatchGEMM && numberWaveFunctions<1000)
-    {
-	  computeLocalHamiltonianTimesXBatchGEMM(src,
-				  numberWaveFunctions,
-				  dst);
-    }
-    else
-       computeLocalHamiltonianTimesX(src,
-				     numberWaveFunctions,
- 				     dst);
-#else
-       computeLocalHamiltonianTimesX(src,
-				     numberWaveFunctions,
- 				     dst);
-#endif
-
-    //
-    //required if its a pseudopotential calculation and number of nonlocal atoms are greater than zero
-    //H^{nloc}*X
-    if(dftParameters::isPseudopotential && dftPtr->d_nonLocalAtomGlobalChargeIds.size() > 0)
-    {
-#ifdef WITH_MKL
-      if (dftParameters::useBatchGEMM && numberWaveFunctions<1000)
-      {
-            computeNonLocalHamiltonianTimesXBatchGEMM(src,
-				                  numberWaveFunctions,
-				                  dst);
-      }
-      else
-        computeNonLocalHamiltonianTimesX(src,
-				         numberWaveFunctions,
-				         dst);
-#else
-        computeNonLocalHamiltonianTimesX(src,
-				         numberWaveFunctions,
-				         dst);
-#endif
-    }
+    computeHamiltonianTimesX(src,
+			     numberWaveFunctions,
+			     dst);
 
 
 
@@ -241,7 +241,9 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXMF (const d
 template<unsigned int FEOrder>
 void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesX(const dealii::parallel::distributed::Vector<std::complex<double> > & src,
 							const unsigned int numberWaveFunctions,
-							dealii::parallel::distributed::Vector<std::complex<double> > & dst) const
+							dealii::parallel::distributed::Vector<std::complex<double> > & dst,
+							const unsigned int macroCellStartId,
+							const unsigned int macroCellEndId) const
 {
 
   //
@@ -255,13 +257,16 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesX(const deal
   std::vector<std::complex<double> > cellHamMatrixTimesWaveMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
 
   unsigned int iElem = 0;
-  for(unsigned int iMacroCell = 0; iMacroCell < d_numberMacroCells; ++iMacroCell)
+  for(unsigned int iMacroCell = 0; iMacroCell < macroCellStartId; ++iMacroCell)
+    iElem+=d_macroCellSubCellMap[iMacroCell];
+
+  for(unsigned int iMacroCell = macroCellStartId; iMacroCell < macroCellEndId; ++iMacroCell)
     {
       for(unsigned int iCell = 0; iCell < d_macroCellSubCellMap[iMacroCell]; ++iCell)
 	{
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      zcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
 		     &inc,
@@ -285,7 +290,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesX(const deal
 
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      zaxpy_(&numberWaveFunctions,
 		     &scalarCoeffAlpha,
 		     &cellHamMatrixTimesWaveMatrix[numberWaveFunctions*iNode],
@@ -304,7 +309,9 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesX(const deal
 template<unsigned int FEOrder>
 void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXBatchGEMM (const dealii::parallel::distributed::Vector<std::complex<double> > & src,
 										const unsigned int numberWaveFunctions,
-										dealii::parallel::distributed::Vector<std::complex<double> > & dst) const
+										dealii::parallel::distributed::Vector<std::complex<double> > & dst,
+										const unsigned int macroCellStartId,
+										const unsigned int macroCellEndId) const
 
 {
 
@@ -328,14 +335,17 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXBatchGEMM (
     }
 
   unsigned int iElem= 0;
-  for(unsigned int iMacroCell = 0; iMacroCell < d_numberMacroCells; ++iMacroCell)
+  for(unsigned int iMacroCell = 0; iMacroCell < macroCellStartId; ++iMacroCell)
+    iElem+=d_macroCellSubCellMap[iMacroCell];
+
+  for(unsigned int iMacroCell = macroCellStartId; iMacroCell < macroCellEndId; ++iMacroCell)
     {
 
       for(unsigned int isubcell = 0; isubcell < d_macroCellSubCellMap[iMacroCell]; isubcell++)
 	{
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem+isubcell][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[(iElem+isubcell)*d_numberNodesPerElement+iNode];
 	      zcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
 		     &inc,
@@ -365,7 +375,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXBatchGEMM (
       for(unsigned int isubcell = 0; isubcell < d_macroCellSubCellMap[iMacroCell]; isubcell++)
 	for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	  {
-	    dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem+isubcell][iNode];
+	    const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[(iElem+isubcell)*d_numberNodesPerElement+iNode];
 	    zaxpy_(&numberWaveFunctions,
 		   &scalarCoeffAlpha,
 		   &cellHamMatrixTimesWaveMatrixBatch[isubcell][numberWaveFunctions*iNode],
@@ -393,7 +403,9 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXBatchGEMM (
 template<unsigned int FEOrder>
 void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesX(const dealii::parallel::distributed::Vector<double> & src,
 								      const unsigned int numberWaveFunctions,
-								      dealii::parallel::distributed::Vector<double> & dst) const
+								      dealii::parallel::distributed::Vector<double> & dst,
+								      const unsigned int macroCellStartId,
+								      const unsigned int macroCellEndId) const
 {
 
 
@@ -408,13 +420,16 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesX(const deal
   std::vector<double> cellHamMatrixTimesWaveMatrix(d_numberNodesPerElement*numberWaveFunctions,0.0);
 
   unsigned int iElem = 0;
-  for(unsigned int iMacroCell = 0; iMacroCell < d_numberMacroCells; ++iMacroCell)
+  for(unsigned int iMacroCell = 0; iMacroCell < macroCellStartId; ++iMacroCell)
+    iElem+=d_macroCellSubCellMap[iMacroCell];
+
+  for(unsigned int iMacroCell = macroCellStartId; iMacroCell < macroCellEndId; ++iMacroCell)
     {
       for(unsigned int iCell = 0; iCell < d_macroCellSubCellMap[iMacroCell]; ++iCell)
 	{
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      dcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
 		     &inc,
@@ -438,7 +453,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesX(const deal
 
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      daxpy_(&numberWaveFunctions,
 		     &scalarCoeffAlpha,
 		     &cellHamMatrixTimesWaveMatrix[numberWaveFunctions*iNode],
@@ -476,7 +491,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeMassMatrixTimesX(const dealii::pa
 	{
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      dcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
 		     &inc,
@@ -500,7 +515,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeMassMatrixTimesX(const dealii::pa
 
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem*d_numberNodesPerElement+iNode];
 	      daxpy_(&numberWaveFunctions,
 		     &scalarCoeffAlpha,
 		     &cellMassMatrixTimesWaveMatrix[numberWaveFunctions*iNode],
@@ -519,7 +534,9 @@ void kohnShamDFTOperatorClass<FEOrder>::computeMassMatrixTimesX(const dealii::pa
 template<unsigned int FEOrder>
 void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXBatchGEMM (const dealii::parallel::distributed::Vector<double> & src,
 								  const unsigned int numberWaveFunctions,
-								  dealii::parallel::distributed::Vector<double> & dst) const
+								  dealii::parallel::distributed::Vector<double> & dst,
+								  const unsigned int macroCellStartId,
+								  const unsigned int macroCellEndId) const
 {
 
   //
@@ -542,14 +559,17 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXBatchGEMM (
     }
 
   unsigned int iElem= 0;
-  for(unsigned int iMacroCell = 0; iMacroCell < d_numberMacroCells; ++iMacroCell)
+  for(unsigned int iMacroCell = 0; iMacroCell < macroCellStartId; ++iMacroCell)
+    iElem+=d_macroCellSubCellMap[iMacroCell];
+
+  for(unsigned int iMacroCell = macroCellStartId; iMacroCell < macroCellEndId; ++iMacroCell)
     {
 
       for(unsigned int isubcell = 0; isubcell < d_macroCellSubCellMap[iMacroCell]; isubcell++)
 	{
 	  for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem+isubcell][iNode];
+	      const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[(iElem+isubcell)*d_numberNodesPerElement+iNode];
 	      dcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
 		     &inc,
@@ -579,7 +599,7 @@ void kohnShamDFTOperatorClass<FEOrder>::computeLocalHamiltonianTimesXBatchGEMM (
       for(unsigned int isubcell = 0; isubcell < d_macroCellSubCellMap[iMacroCell]; isubcell++)
 	for(unsigned int iNode = 0; iNode < d_numberNodesPerElement; ++iNode)
 	  {
-	    dealii::types::global_dof_index localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[iElem+isubcell][iNode];
+	    const unsigned int localNodeId = d_flattenedArrayMacroCellLocalProcIndexIdMap[(iElem+isubcell)*d_numberNodesPerElement+iNode];
 	    daxpy_(&numberWaveFunctions,
 		   &scalarCoeffAlpha,
 		   &cellHamMatrixTimesWaveMatrixBatch[isubcell][numberWaveFunctions*iNode],
@@ -84,4 +84,7 @@ void kohnShamDFTOperatorClass<FEOrder>::preComputeShapeFunctionGradientIntegrals
 
     }//macrocell loop
 
+  memoryLedger::setBytes(memoryLedger::cellHamiltonians,
+			 "shape function gradient integrals",
+			 memoryLedger::getBytes(d_cellShapeFunctionGradientIntegral));
 }
@@ -126,6 +126,11 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 	zeroTensor4[idim][jdim]=make_vectorized_array(0.0);
     }
   }
+#ifdef USE_COMPLEX
+  Tensor<1,2, Tensor<2,C_DIM,VectorizedArray<double> > > zeroTensor5;
+  zeroTensor5[0]=zeroTensor4;
+  zeroTensor5[1]=zeroTensor4;
+#endif
   VectorizedArray<double> phiExtFactor=isPseudopotential?make_vectorized_array(1.0):make_vectorized_array(0.0);
 
   std::map<unsigned int,std::vector<unsigned int>> macroIdToNonlocalAtomsSetMap;
@@ -160,12 +165,14 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 	                                bandGroupLowHighPlusOneIndices[1]);
 
   const unsigned int localVectorSize = dftPtr->d_eigenVectorsFlattenedSTL[0].size()/numEigenVectors;
+  //states in the unoccupied tail beyond the occupancy cutoff do not contribute
+  const unsigned int numEigenVectorsOccupied=dftPtr->computeNumberStatesAboveOccupancyCutoff();
   std::vector<std::vector<vectorType>> eigenVectors((1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size());
   std::vector<dealii::parallel::distributed::Vector<dataTypes::number> > eigenVectorsFlattenedBlock((1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size());
 
-   for(unsigned int ivec = 0; ivec < numEigenVectors; ivec+=blockSize)
+   for(unsigned int ivec = 0; ivec < numEigenVectorsOccupied; ivec+=blockSize)
    {
-      const unsigned int currentBlockSize=std::min(blockSize,numEigenVectors-ivec);
+      const unsigned int currentBlockSize=std::min(blockSize,numEigenVectorsOccupied-ivec);
 
       if (currentBlockSize!=blockSize || ivec==0)
       {
@@ -176,15 +183,15 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 		  eigenVectors[kPoint][i].reinit(dftPtr->d_tempEigenVec);
 
 
-	      vectorTools::createDealiiVector<dataTypes::number>(dftPtr->matrix_free_data.get_vector_partitioner(),
-							         currentBlockSize,
-							         eigenVectorsFlattenedBlock[kPoint]);
+	      eigenVectorsFlattenedBlock[kPoint].reinit
+	        (dftPtr->d_flattenedArrayRegistry.getFlattenedPartitioner(dftPtr->matrix_free_data.get_vector_partitioner(),
+									  currentBlockSize));
 	      eigenVectorsFlattenedBlock[kPoint] = dataTypes::number(0.0);
 	   }
 
-	   dftPtr->constraintsNoneDataInfo.precomputeMaps(dftPtr->matrix_free_data.get_vector_partitioner(),
-					          eigenVectorsFlattenedBlock[0].get_partitioner(),
-					          currentBlockSize);
+	   dftPtr->constraintsNoneDataInfo.precomputeMaps
+	     (dftPtr->d_flattenedArrayRegistry.getFlattenedArrayData(dftPtr->matrix_free_data,
+								     currentBlockSize)->localIndexMapUnflattenedToFlattened);
       }
 
       if((ivec+currentBlockSize)<=bandGroupLowHighPlusOneIndices[2*bandGroupTaskId+1] &&
@@ -225,6 +232,11 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 
 	  for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size(); ++kPoint)
 	  {
+		 //the block of the spin channel owned by the other spin group is left at zero, so that
+		 //its contribution is added by the other spin group
+		 if (!dftPtr->isSpinChannelOwned(kPoint%2))
+		   continue;
+
 		 for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
 		    for(unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
 			eigenVectorsFlattenedBlock[kPoint].local_element(iNode*currentBlockSize+iWave)
@@ -322,6 +334,7 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 	    std::vector<std::vector<std::vector<std::vector<Tensor<1,2,VectorizedArray<double> > > > > >ZetaDeltaVQuads;
 	    std::vector<std::vector<std::vector<std::vector<Tensor<1,2, Tensor<1,C_DIM,VectorizedArray<double> > > > > > >gradZetaDeltaVQuads;
 	    std::vector<std::vector<std::vector<std::vector<Tensor<1,2, Tensor<1,C_DIM,VectorizedArray<double> > > > > > >pspnlGammaAtomsQuads;
+	    std::vector<std::vector<std::vector<std::vector<Tensor<1,2, Tensor<2,C_DIM,VectorizedArray<double> > > > > > >gradZetalmDeltaVlDyadicDistImageAtomsQuads;
 #else
 	    //FIXME: flatten nonlocal atom id and pseudo wave
 	    //vector of quadPoints, nonlocal atom id, pseudo wave
@@ -334,27 +347,35 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 		gradZetaDeltaVQuads.resize(numQuadPointsNLP);
 #ifdef USE_COMPLEX
 		pspnlGammaAtomsQuads.resize(numQuadPointsNLP);
+		if (d_isStressKPointsComputedWithForce)
+		    gradZetalmDeltaVlDyadicDistImageAtomsQuads.resize(numQuadPointsNLP);
 #endif
 
 		for (unsigned int q=0; q<numQuadPointsNLP; ++q)
 		{
-		  ZetaDeltaVQuads[q].resize(d_nonLocalPSP_ZetalmDeltaVl.size());
-		  gradZetaDeltaVQuads[q].resize(d_nonLocalPSP_ZetalmDeltaVl.size());
+		  ZetaDeltaVQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
+		  gradZetaDeltaVQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
 #ifdef USE_COMPLEX
-		  pspnlGammaAtomsQuads[q].resize(d_nonLocalPSP_ZetalmDeltaVl.size());
+		  pspnlGammaAtomsQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
+		  if (d_isStressKPointsComputedWithForce)
+		      gradZetalmDeltaVlDyadicDistImageAtomsQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
 #endif
-		  for (unsigned int i=0; i < d_nonLocalPSP_ZetalmDeltaVl.size(); ++i)
+		  for (unsigned int i=0; i < d_nonLocalPSP_numberPseudoWaveFunctions.size(); ++i)
 		  {
-		    const int numberPseudoWaveFunctions = d_nonLocalPSP_ZetalmDeltaVl[i].size();
+		    const int numberPseudoWaveFunctions = d_nonLocalPSP_numberPseudoWaveFunctions[i];
 #ifdef USE_COMPLEX
 		    ZetaDeltaVQuads[q][i].resize(numberPseudoWaveFunctions);
 		    gradZetaDeltaVQuads[q][i].resize(numberPseudoWaveFunctions);
 		    pspnlGammaAtomsQuads[q][i].resize(numberPseudoWaveFunctions);
+		    if (d_isStressKPointsComputedWithForce)
+			gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i].resize(numberPseudoWaveFunctions);
 		    for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
 		    {
 			ZetaDeltaVQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor1);
 			gradZetaDeltaVQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor2);
 			pspnlGammaAtomsQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor2);
+			if (d_isStressKPointsComputedWithForce)
+			    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor5);
 		    }
 #else
 		    ZetaDeltaVQuads[q][i].resize(numberPseudoWaveFunctions,make_vectorized_array(0.0));
@@ -434,46 +455,75 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 
 	    if(isPseudopotential)
 	    {
+#ifdef USE_COMPLEX
+	       std::vector<double> zetalmDeltaVlKPoint;
+	       std::vector<double> gradZetalmDeltaVlKPoint;
+	       std::vector<double> gradZetalmDeltaVlMinusZetalmDeltaVlKPoint;
+	       std::vector<double> gradZetalmDeltaVlDyadicDistImageAtomsKPoint;
+#endif
+
 	       for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
 	       {
 		  subCellPtr= matrixFreeData.get_cell_iterator(cell,iSubCell);
 		  dealii::CellId subCellId=subCellPtr->id();
 
-		  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+		  for (unsigned int i=0; i < d_nonLocalPSP_numberPseudoWaveFunctions.size(); ++i)
 		  {
-		    for (unsigned int i=0; i < d_nonLocalPSP_ZetalmDeltaVl.size(); ++i)
-		    {
-		      const int numberPseudoWaveFunctions = d_nonLocalPSP_ZetalmDeltaVl[i].size();
-		      for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
-		      {
-			if (d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave].find(subCellId)!=d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave].end())
-			{
+		    const std::map<dealii::CellId,unsigned int>::const_iterator cellInSupportIdIter
+			=d_nonLocalPSP_cellIdToCellInSupportIdMap[i].find(subCellId);
+		    if (cellInSupportIdIter==d_nonLocalPSP_cellIdToCellInSupportIdMap[i].end())
+			continue;
+
+		    const int numberPseudoWaveFunctions = d_nonLocalPSP_numberPseudoWaveFunctions[i];
 #ifdef USE_COMPLEX
-			   for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-			   {
-			      ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][iSubCell]=d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*2+q*2+0];
-			      ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][iSubCell]=d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*2+q*2+1];
-			      for (unsigned int idim=0; idim<C_DIM; idim++)
-			      {
-				 gradZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][idim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*2+q*C_DIM*2+idim*2+0];
-				 gradZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][idim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*2+q*C_DIM*2+idim*2+1];
-				 pspnlGammaAtomsQuads[q][i][iPseudoWave][ikPoint][0][idim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVl_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*2+q*C_DIM*2+idim*2+0];
-				 pspnlGammaAtomsQuads[q][i][iPseudoWave][ikPoint][1][idim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVl_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*2+q*C_DIM*2+idim*2+1];
-			      }
-			   }
+		    for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		    {
+		       computeNonLocalPSPQuadDataKPoint(i,
+							cellInSupportIdIter->second,
+							ikPoint,
+							d_isStressKPointsComputedWithForce,
+							zetalmDeltaVlKPoint,
+							gradZetalmDeltaVlKPoint,
+							gradZetalmDeltaVlMinusZetalmDeltaVlKPoint,
+							gradZetalmDeltaVlDyadicDistImageAtomsKPoint);
+
+		       for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+			  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+			  {
+			     const unsigned int id=iPseudoWave*numQuadPointsNLP+q;
+			     ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][iSubCell]=zetalmDeltaVlKPoint[id*2+0];
+			     ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][iSubCell]=zetalmDeltaVlKPoint[id*2+1];
+			     for (unsigned int idim=0; idim<C_DIM; idim++)
+			     {
+				gradZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][idim][iSubCell]=gradZetalmDeltaVlMinusZetalmDeltaVlKPoint[(id*C_DIM+idim)*2+0];
+				gradZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][idim][iSubCell]=gradZetalmDeltaVlMinusZetalmDeltaVlKPoint[(id*C_DIM+idim)*2+1];
+				pspnlGammaAtomsQuads[q][i][iPseudoWave][ikPoint][0][idim][iSubCell]=gradZetalmDeltaVlKPoint[(id*C_DIM+idim)*2+0];
+				pspnlGammaAtomsQuads[q][i][iPseudoWave][ikPoint][1][idim][iSubCell]=gradZetalmDeltaVlKPoint[(id*C_DIM+idim)*2+1];
+			     }
+
+			     if (d_isStressKPointsComputedWithForce)
+			       for (unsigned int idim=0; idim<C_DIM; idim++)
+				 for (unsigned int jdim=0; jdim<C_DIM; jdim++)
+				 {
+				    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][0][idim][jdim][iSubCell]=gradZetalmDeltaVlDyadicDistImageAtomsKPoint[((id*C_DIM+idim)*C_DIM+jdim)*2+0];
+				    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][1][idim][jdim][iSubCell]=gradZetalmDeltaVlDyadicDistImageAtomsKPoint[((id*C_DIM+idim)*C_DIM+jdim)*2+1];
+				 }
+			  }
+		    }
 #else
-
-			      ZetaDeltaVQuads[q][i][iPseudoWave][iSubCell]=
-			       d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave][subCellId][q];
-
-			   for (unsigned int idim=0; idim<C_DIM; idim++)
-			       gradZetaDeltaVQuads[q][i][iPseudoWave][idim][iSubCell]=
-					   d_nonLocalPSP_gradZetalmDeltaVl[i][iPseudoWave][subCellId][q*C_DIM+idim];
+		    const unsigned int startId=cellInSupportIdIter->second*numberPseudoWaveFunctions*numQuadPointsNLP;
+		    for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+		       for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+		       {
+			  const unsigned int id=startId+iPseudoWave*numQuadPointsNLP+q;
+			  ZetaDeltaVQuads[q][i][iPseudoWave][iSubCell]=d_nonLocalPSP_ZetalmDeltaVl[i][id];
+
+			  for (unsigned int idim=0; idim<C_DIM; idim++)
+			      gradZetaDeltaVQuads[q][i][iPseudoWave][idim][iSubCell]=
+				  d_nonLocalPSP_gradZetalmDeltaVl[i][id*C_DIM+idim];
+		       }
 #endif
-			}//non-trivial cellId check
-		      }//iPseudoWave loop
-		    }//i loop
-		  }//q loop
+		  }//i loop
 	       }//subcell loop
 	       //compute FPSPLocalGammaAtoms  (contibution due to Gamma(Rj))
 
@@ -514,6 +564,9 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 #endif
 	    }//is pseudopotential check
 
+#ifdef USE_COMPLEX
+	    Tensor<2,C_DIM,VectorizedArray<double> > EKPointsStressQuadSum=zeroTensor4;
+#endif
 	    for (unsigned int q=0; q<numQuadPoints; ++q)
 	    {
 	       Tensor<2,C_DIM,VectorizedArray<double> > E=zeroTensor4;
@@ -592,6 +645,35 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 	       forceEval.submit_gradient(E,q);
 #ifdef USE_COMPLEX
 	       forceEvalKPoints.submit_gradient(EKPoints,q);
+
+	       if (d_isStressKPointsComputedWithForce)
+	       {
+		   Tensor<2,C_DIM,VectorizedArray<double> > EKPointsStress=EKPoints;
+		   EKPointsStress+=eshelbyTensorSP::getEKStress
+						 (psiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+						  psiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+						  gradPsiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+						  gradPsiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+						  dftPtr->d_kPointCoordinates,
+						  dftPtr->d_kPointWeights,
+						  blockedEigenValues,
+						  dftPtr->fermiEnergy,
+						  dftPtr->fermiEnergyUp,
+						  dftPtr->fermiEnergyDown,
+						  dftParameters::TVal);
+
+		   if(isPseudopotential && !dftParameters::useHigherQuadNLP)
+		       EKPointsStress+=eshelbyTensorSP::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
+							 projectorKetTimesPsiSpin0TimesVTimesPartOcc,
+							 projectorKetTimesPsiSpin1TimesVTimesPartOcc,
+							 psiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+							 psiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+							 dftPtr->d_kPointWeights,
+							 macroIdToNonlocalAtomsSetMap[cell],
+							 currentBlockSize);
+
+		   EKPointsStressQuadSum+=EKPointsStress*forceEval.JxW(q);
+	       }
 #endif
 	    }//quad point loop
 
@@ -616,6 +698,21 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 							      EKPoints);
 		       forceEvalKPointsNLP.submit_value(FKPoints,q);
 		       forceEvalKPointsNLP.submit_gradient(EKPoints,q);
+
+		       if (d_isStressKPointsComputedWithForce)
+		       {
+			   Tensor<2,C_DIM,VectorizedArray<double> > EKPointsStress=EKPoints;
+			   EKPointsStress+=eshelbyTensorSP::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
+							 projectorKetTimesPsiSpin0TimesVTimesPartOcc,
+							 projectorKetTimesPsiSpin1TimesVTimesPartOcc,
+							 psiSpin0QuadsNLP.begin()+q*currentBlockSize*numKPoints,
+							 psiSpin1QuadsNLP.begin()+q*currentBlockSize*numKPoints,
+							 dftPtr->d_kPointWeights,
+							 macroIdToNonlocalAtomsSetMap[cell],
+							 currentBlockSize);
+
+			   EKPointsStressQuadSum+=EKPointsStress*forceEvalKPointsNLP.JxW(q);
+		       }
 #else
 		       Tensor<1,C_DIM,VectorizedArray<double> > F;
 		       Tensor<2,C_DIM,VectorizedArray<double> >	E;
@@ -674,6 +771,14 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
 		forceEvalNLP.distribute_local_to_global(d_configForceVectorLinFE);
 #endif
 	    }
+
+#ifdef USE_COMPLEX
+	    if (d_isStressKPointsComputedWithForce)
+		for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
+		    for (unsigned int idim=0; idim<C_DIM; ++idim)
+			for (unsigned int jdim=0; jdim<C_DIM; ++jdim)
+			    d_stressKPoints[idim][jdim]+=EKPointsStressQuadSum[idim][jdim][iSubCell];
+#endif
 	  }//macro cell loop
       }//band parallelization loop
   }//wavefunction block loop
@@ -685,7 +790,9 @@ void forceClass<FEOrder>::computeConfigurationalForceSpinPolarizedEEshelbyTensor
   }
 
   /////////// Compute contribution independent of wavefunctions /////////////////
-  if (bandGroupTaskId==0)
+  //computed only once across the band groups and the spin groups as the configurational
+  //force is summed over both
+  if (bandGroupTaskId==0 && dealii::Utilities::MPI::this_mpi_process(dftPtr->interSpinGroupComm)==0)
   {
       std::vector<VectorizedArray<double> > rhoQuads(numQuadPoints,make_vectorized_array(0.0));
       std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > gradRhoSpin0Quads(numQuadPoints,zeroTensor3);
@@ -351,6 +351,70 @@ namespace atomsForcesUtils{
 
     }
 }
+//Compute the candidate atoms (including image atoms) of each locally owned cell of the force dofHandlers,
+//whose pruned Gaussian generator support intersects the cell. The candidates are cached and only recomputed
+//if the atom positions or the Gaussian constant change, or after the mesh is updated (initMoved).
+template<unsigned int FEOrder>
+void forceClass<FEOrder>::computeGaussianGeneratorCellCandidates()
+{
+  const std::vector<std::vector<double> > & atomLocations=dftPtr->atomLocations;
+  const std::vector<std::vector<double> > & imagePositions=dftPtr->d_imagePositionsTrunc;
+  const unsigned int numberGlobalAtoms = atomLocations.size();
+  const unsigned int totalNumberAtoms = numberGlobalAtoms + imagePositions.size();
+  const unsigned int exponent=dftParameters::reproducible_output?2:4;
+
+  std::vector<Point<C_DIM> > atomPoints(totalNumberAtoms);
+  std::vector<double> geometry(totalNumberAtoms*C_DIM+2);
+  for (unsigned int iAtom=0;iAtom <totalNumberAtoms; iAtom++)
+  {
+     for (unsigned int idim=0; idim < C_DIM ; idim++)
+     {
+        atomPoints[iAtom][idim]=iAtom < numberGlobalAtoms?atomLocations[iAtom][2+idim]
+	                                                 :imagePositions[iAtom-numberGlobalAtoms][idim];
+	geometry[iAtom*C_DIM+idim]=atomPoints[iAtom][idim];
+     }
+  }
+  geometry[totalNumberAtoms*C_DIM]=d_gaussianConstant;
+  geometry[totalNumberAtoms*C_DIM+1]=exponent;
+
+  if (geometry==d_gaussianGeneratorCandidatesGeometry)
+      return;
+
+  const double supportRadius=vectorTools::gaussianGeneratorSupportRadius(d_gaussianConstant,
+	                                                                 exponent);
+  vectorTools::boundingBoxTree atomsSupportTree;
+  vectorTools::buildControlPointsSupportTree(atomPoints,
+	                                     supportRadius,
+					     atomsSupportTree);
+
+  d_gaussianGeneratorCellCandidateAtoms.clear();
+  d_gaussianGeneratorCellCandidateAtoms.resize(d_dofHandlerForce.get_triangulation().n_active_cells());
+  DoFHandler<3>::active_cell_iterator
+  cell = d_dofHandlerForce.begin_active(),
+  endc = d_dofHandlerForce.end();
+  for (; cell!=endc; ++cell)
+     if (cell->is_locally_owned())
+	 vectorTools::findCellControlPointCandidates(*cell,
+		                                     atomsSupportTree,
+						     0.0,
+						     d_gaussianGeneratorCellCandidateAtoms[cell->active_cell_index()]);
+
+  //On the subdivided electrostatics mesh the Gaussian weights are interpolated from the parent
+  //mesh, so the cell bounding box is padded by the parent cell diameter
+  d_gaussianGeneratorCellCandidateAtomsElectro.clear();
+  d_gaussianGeneratorCellCandidateAtomsElectro.resize(d_dofHandlerForceElectro.get_triangulation().n_active_cells());
+  cell = d_dofHandlerForceElectro.begin_active();
+  endc = d_dofHandlerForceElectro.end();
+  for (; cell!=endc; ++cell)
+     if (cell->is_locally_owned())
+	 vectorTools::findCellControlPointCandidates(*cell,
+		                                     atomsSupportTree,
+						     d_isElectrostaticsMeshSubdivided?2.0*cell->diameter():0.0,
+						     d_gaussianGeneratorCellCandidateAtomsElectro[cell->active_cell_index()]);
+
+  d_gaussianGeneratorCandidatesGeometry=geometry;
+}
+
 //Configurational force on atoms corresponding to Gaussian generator. Generator is discretized using linear FE shape functions. Configurational force on nodes due to linear FE shape functions precomputed
 template<unsigned int FEOrder>
 void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussianOverlapOnAtoms)
@@ -366,6 +430,8 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
   d_globalAtomsGaussianForces.clear();
   d_globalAtomsGaussianForces.resize(numberGlobalAtoms*C_DIM,0.0);
 
+  computeGaussianGeneratorCellCandidates();
+
 
   if (d_isElectrostaticsMeshSubdivided)
   {
@@ -402,6 +468,7 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
   {
    if (cell->is_locally_owned())
    {
+    const std::vector<unsigned int> & cellCandidateAtoms=d_gaussianGeneratorCellCandidateAtoms[cell->active_cell_index()];
     for (unsigned int i=0; i<vertices_per_cell; ++i)
     {
 	const unsigned global_vertex_no = cell->vertex_index(i);
@@ -412,8 +479,9 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
 	Point<C_DIM> nodalCoor = cell->vertex(i);
 
 	int overlappedAtomId=-1;
-	for (unsigned int jAtom=0;jAtom <totalNumberAtoms; jAtom++)
+	for (unsigned int jCandidate=0;jCandidate <cellCandidateAtoms.size(); jCandidate++)
 	{
+           const unsigned int jAtom=cellCandidateAtoms[jCandidate];
            Point<C_DIM> jAtomCoor;
            if(jAtom < numberGlobalAtoms)
            {
@@ -434,8 +502,9 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
 	    }
 	}//j atom loop
 
-        for (unsigned int iAtom=0;iAtom <totalNumberAtoms; iAtom++)
+        for (unsigned int iCandidate=0;iCandidate <cellCandidateAtoms.size(); iCandidate++)
 	{
+             const unsigned int iAtom=cellCandidateAtoms[iCandidate];
              if (overlappedAtomId!=iAtom && overlappedAtomId!=-1 && !allowGaussianOverlapOnAtoms)
 		 continue;
              Point<C_DIM> atomCoor;
@@ -540,6 +609,7 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
   for (; cell!=endc; ++cell)
    if (cell->is_locally_owned())
    {
+    const std::vector<unsigned int> & cellCandidateAtoms=d_gaussianGeneratorCellCandidateAtomsElectro[cell->active_cell_index()];
     for (unsigned int i=0; i<vertices_per_cell; ++i)
     {
 	const unsigned global_vertex_no = cell->vertex_index(i);
@@ -550,8 +620,9 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
 	Point<C_DIM> nodalCoor = cell->vertex(i);
 
 	int overlappedAtomId=-1;
-	for (unsigned int jAtom=0;jAtom <totalNumberAtoms; jAtom++)
+	for (unsigned int jCandidate=0;jCandidate <cellCandidateAtoms.size(); jCandidate++)
 	{
+           const unsigned int jAtom=cellCandidateAtoms[jCandidate];
            Point<C_DIM> jAtomCoor;
            if(jAtom < numberGlobalAtoms)
            {
@@ -572,8 +643,9 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
 	    }
 	}//j atom loop
 
-        for (unsigned int iAtom=0;iAtom <totalNumberAtoms; iAtom++)
+        for (unsigned int iCandidate=0;iCandidate <cellCandidateAtoms.size(); iCandidate++)
 	{
+             const unsigned int iAtom=cellCandidateAtoms[iCandidate];
              if (overlappedAtomId!=iAtom && overlappedAtomId!=-1 && !allowGaussianOverlapOnAtoms)
 		 continue;
              Point<C_DIM> atomCoor;
@@ -629,6 +701,14 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
 		MPI_SUM,
                 dftPtr->interBandGroupComm);
 
+  //Sum over spin groups
+  MPI_Allreduce(MPI_IN_PLACE,
+		&(d_globalAtomsGaussianForces[0]),
+		numberGlobalAtoms*C_DIM,
+		MPI_DOUBLE,
+		MPI_SUM,
+                dftPtr->interSpinGroupComm);
+
 #ifdef USE_COMPLEX
   //Sum all processor contributions and distribute to all processors
   MPI_Allreduce(&(globalAtomsGaussianForcesKPointsLocalPart[0]),
@@ -637,7 +717,7 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
 		MPI_DOUBLE,
 		MPI_SUM,
                 mpi_communicator);
-  //Sum over band parallelization and k point pools
+  //Sum over band parallelization, spin groups and k point pools
   MPI_Allreduce(MPI_IN_PLACE,
 		&(globalAtomsGaussianForcesKPoints[0]),
 		numberGlobalAtoms*C_DIM,
@@ -645,6 +725,13 @@ void forceClass<FEOrder>::computeAtomsForcesGaussianGenerator(bool allowGaussian
 		MPI_SUM,
                 dftPtr->interBandGroupComm);
 
+  MPI_Allreduce(MPI_IN_PLACE,
+		&(globalAtomsGaussianForcesKPoints[0]),
+		numberGlobalAtoms*C_DIM,
+		MPI_DOUBLE,
+		MPI_SUM,
+                dftPtr->interSpinGroupComm);
+
   MPI_Allreduce(MPI_IN_PLACE,
 		&(globalAtomsGaussianForcesKPoints[0]),
 		numberGlobalAtoms*C_DIM,
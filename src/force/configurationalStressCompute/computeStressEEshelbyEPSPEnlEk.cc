@@ -41,30 +41,6 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
 		              const std::map<unsigned int,std::map<dealii::CellId, std::vector<double> > > & gradPseudoVLocAtomsElectro,
 			      const vselfBinsManager<FEOrder> & vselfBinsManagerElectro)
 {
-  std::vector<std::vector<vectorType>> eigenVectors((1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size());
-  for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size(); ++kPoint)
-  {
-        eigenVectors[kPoint].resize(dftPtr->d_numEigenValues);
-        for(unsigned int i = 0; i < dftPtr->d_numEigenValues; ++i)
-          eigenVectors[kPoint][i].reinit(dftPtr->d_tempEigenVec);
-
-#ifdef USE_COMPLEX
-	vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		 (dftPtr->d_eigenVectorsFlattened[kPoint],
-		  dftPtr->d_numEigenValues,
-		  std::make_pair(0,dftPtr->d_numEigenValues),
-		  dftPtr->localProc_dof_indicesReal,
-		  dftPtr->localProc_dof_indicesImag,
-		  eigenVectors[kPoint]);
-#else
-	vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		 (dftPtr->d_eigenVectorsFlattened[kPoint],
-		  dftPtr->d_numEigenValues,
-		  std::make_pair(0,dftPtr->d_numEigenValues),
-		  eigenVectors[kPoint]);
-#endif
-  }
-
   const unsigned int numberGlobalAtoms = dftPtr->atomLocations.size();
   const unsigned int numberImageCharges = dftPtr->d_imageIds.size();
   const unsigned int totalNumberAtoms = numberGlobalAtoms + numberImageCharges;
@@ -102,6 +78,8 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
   const unsigned int numQuadPointsNLP=dftParameters::useHigherQuadNLP?
                                       forceEvalNLP.n_q_points:numQuadPoints;
   const unsigned int numEigenVectors=dftPtr->d_numEigenValues;
+  //states in the unoccupied tail beyond the occupancy cutoff do not contribute
+  const unsigned int numEigenVectorsOccupied=dftPtr->computeNumberStatesAboveOccupancyCutoff();
   const unsigned int numKPoints=dftPtr->d_kPointWeights.size();
 
   DoFHandler<C_DIM>::active_cell_iterator subCellPtr;
@@ -125,41 +103,6 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
   zeroTensor5[0]=zeroTensor4;
   zeroTensor5[1]=zeroTensor4;
 
-  std::vector<std::vector<double>> partialOccupancies(dftPtr->d_kPointWeights.size(),std::vector<double>(numEigenVectors,0.0));
-  for(unsigned int kPoint = 0; kPoint < dftPtr->d_kPointWeights.size(); ++kPoint)
-     for (unsigned int iWave=0; iWave<numEigenVectors;++iWave)
-     {
-	 partialOccupancies[kPoint][iWave]
-	     =dftUtils::getPartialOccupancy(dftPtr->eigenValues[kPoint][iWave],
-					    dftPtr->fermiEnergy,
-					    C_kb,
-					    dftParameters::TVal);
-
-     }
-
-  VectorizedArray<double> phiExtFactor=make_vectorized_array(0.0);
-  std::vector<std::vector<std::vector<dataTypes::number > > > projectorKetTimesPsiTimesVTimesPartOcc(numKPoints);
-  if (isPseudopotential){
-    phiExtFactor=make_vectorized_array(1.0);
-    for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-         computeNonLocalProjectorKetTimesPsiTimesVFlattened
-	                (dftPtr->d_eigenVectorsFlattened[ikPoint],
-			 numEigenVectors,
-                         projectorKetTimesPsiTimesVTimesPartOcc[ikPoint],
-			 ikPoint,
-			 partialOccupancies[ikPoint]);
-  }
-
-  std::vector<VectorizedArray<double> > rhoQuads(numQuadPoints,make_vectorized_array(0.0));
-  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > gradRhoQuads(numQuadPoints,zeroTensor3);
-  std::vector<VectorizedArray<double> > excQuads(numQuadPoints,make_vectorized_array(0.0));
-  std::vector<VectorizedArray<double> > pseudoVLocQuads(numQuadPoints,make_vectorized_array(0.0));
-  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > gradPseudoVLocQuads(numQuadPoints,zeroTensor3);
-  std::vector<VectorizedArray<double> > vEffRhoInQuads(numQuadPoints,make_vectorized_array(0.0));
-  std::vector<VectorizedArray<double> > vEffRhoOutQuads(numQuadPoints,make_vectorized_array(0.0));
-  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > derExchCorrEnergyWithGradRhoInQuads(numQuadPoints,zeroTensor3);
-  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > derExchCorrEnergyWithGradRhoOutQuads(numQuadPoints,zeroTensor3);
-
   std::map<unsigned int,std::vector<unsigned int>> macroIdToNonlocalAtomsSetMap;
   for (unsigned int cell=0; cell<matrixFreeData.n_macro_cells(); ++cell)
   {
@@ -179,17 +122,318 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
        macroIdToNonlocalAtomsSetMap[cell]=std::vector<unsigned int>(mergedSet.begin(),mergedSet.end());
   }
 
+  //the wavefunction dependent contributions are already accumulated in d_stressKPoints
+  //if they were computed in the same pass as the configurational force
+  if (!d_isStressKPointsComputedWithForce)
+  {
+    //band group parallelization data structures
+    const unsigned int numberBandGroups=
+	  dealii::Utilities::MPI::n_mpi_processes(dftPtr->interBandGroupComm);
+    const unsigned int bandGroupTaskId = dealii::Utilities::MPI::this_mpi_process(dftPtr->interBandGroupComm);
+    std::vector<unsigned int> bandGroupLowHighPlusOneIndices;
+    dftUtils::createBandParallelizationIndices(dftPtr->interBandGroupComm,
+					       numEigenVectors,
+					       bandGroupLowHighPlusOneIndices);
+
+    const unsigned int blockSize=std::min(dftParameters::wfcBlockSize,
+					  bandGroupLowHighPlusOneIndices[1]);
+
+    //
+    //stream over blocks of wavefunctions read from the flattened storage, so that only
+    //blockSize wavefunctions are duplicated at any time
+    //
+    const unsigned int localVectorSize = dftPtr->d_eigenVectorsFlattenedSTL[0].size()/numEigenVectors;
+    std::vector<std::vector<vectorType>> eigenVectors(numKPoints);
+    std::vector<dealii::parallel::distributed::Vector<dataTypes::number> > eigenVectorsFlattenedBlock(numKPoints);
+
+    for(unsigned int ivec = 0; ivec < numEigenVectorsOccupied; ivec+=blockSize)
+    {
+        const unsigned int currentBlockSize=std::min(blockSize,numEigenVectorsOccupied-ivec);
+
+        if (currentBlockSize!=blockSize || ivec==0)
+        {
+	     for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+	     {
+		eigenVectors[kPoint].resize(currentBlockSize);
+		for(unsigned int i= 0; i < currentBlockSize; ++i)
+		    eigenVectors[kPoint][i].reinit(dftPtr->d_tempEigenVec);
+
+
+		eigenVectorsFlattenedBlock[kPoint].reinit
+		  (dftPtr->d_flattenedArrayRegistry.getFlattenedPartitioner(dftPtr->matrix_free_data.get_vector_partitioner(),
+									    currentBlockSize));
+		eigenVectorsFlattenedBlock[kPoint] = dataTypes::number(0.0);
+	     }
+
+	     dftPtr->constraintsNoneDataInfo.precomputeMaps
+	       (dftPtr->d_flattenedArrayRegistry.getFlattenedArrayData(dftPtr->matrix_free_data,
+								       currentBlockSize)->localIndexMapUnflattenedToFlattened);
+        }
+
+        if((ivec+currentBlockSize)<=bandGroupLowHighPlusOneIndices[2*bandGroupTaskId+1] &&
+	    (ivec+currentBlockSize)>bandGroupLowHighPlusOneIndices[2*bandGroupTaskId])
+        {
+            std::vector<std::vector<double>> blockedEigenValues(numKPoints,std::vector<double>(currentBlockSize,0.0));
+	    std::vector<std::vector<double>> blockedPartialOccupancies(numKPoints,std::vector<double>(currentBlockSize,0.0));
+	    for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+	       for (unsigned int iWave=0; iWave<currentBlockSize;++iWave)
+	       {
+		   blockedEigenValues[kPoint][iWave]=dftPtr->eigenValues[kPoint][ivec+iWave];
+		   blockedPartialOccupancies[kPoint][iWave]
+		       =dftUtils::getPartialOccupancy(blockedEigenValues[kPoint][iWave],
+						      dftPtr->fermiEnergy,
+						      C_kb,
+						      dftParameters::TVal);
+
+	       }
+
+	    for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+	    {
+		   for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
+		      for(unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
+			  eigenVectorsFlattenedBlock[kPoint].local_element(iNode*currentBlockSize+iWave)
+			    = dftPtr->d_eigenVectorsFlattenedSTL[kPoint][iNode*numEigenVectors+ivec+iWave];
+
+		   dftPtr->constraintsNoneDataInfo.distribute(eigenVectorsFlattenedBlock[kPoint],
+						      currentBlockSize);
+		   eigenVectorsFlattenedBlock[kPoint].update_ghost_values();
+
+		   vectorTools::copyFlattenedDealiiVecToSingleCompVec
+			   (eigenVectorsFlattenedBlock[kPoint],
+			    currentBlockSize,
+			    std::make_pair(0,currentBlockSize),
+			    dftPtr->localProc_dof_indicesReal,
+			    dftPtr->localProc_dof_indicesImag,
+			    eigenVectors[kPoint],
+			    false);
+
+		   //FIXME: The underlying call to update_ghost_values
+		   //is required because currently localProc_dof_indicesReal
+		   //and localProc_dof_indicesImag are only available for
+		   //locally owned nodes.
+		   for(unsigned int i= 0; i < currentBlockSize; ++i)
+		       eigenVectors[kPoint][i].update_ghost_values();
+	    }
+
+	    std::vector<std::vector<std::vector<dataTypes::number > > > projectorKetTimesPsiTimesVTimesPartOcc(numKPoints);
+	    if (isPseudopotential)
+	      for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		   computeNonLocalProjectorKetTimesPsiTimesVFlattened
+				  (eigenVectorsFlattenedBlock[ikPoint],
+				   currentBlockSize,
+				   projectorKetTimesPsiTimesVTimesPartOcc[ikPoint],
+				   ikPoint,
+				   blockedPartialOccupancies[ikPoint]);
+
+	    for (unsigned int cell=0; cell<matrixFreeData.n_macro_cells(); ++cell)
+	    {
+	      forceEval.reinit(cell);
+	      psiEval.reinit(cell);
+
+	      if (isPseudopotential && dftParameters::useHigherQuadNLP)
+	      {
+		forceEvalNLP.reinit(cell);
+		psiEvalNLP.reinit(cell);
+	      }
+
+	      //allocate storage for vector of quadPoints, nonlocal atom id, pseudo wave, k point
+	      //FIXME: flatten nonlocal atomid id and pseudo wave and k point
+	      std::vector<std::vector<std::vector<std::vector<Tensor<1,2,VectorizedArray<double> > > > > >ZetaDeltaVQuads;
+	      std::vector<std::vector<std::vector<std::vector<Tensor<1,2, Tensor<2,C_DIM,VectorizedArray<double> > > > > > >gradZetalmDeltaVlDyadicDistImageAtomsQuads;
+	      if(isPseudopotential)
+	      {
+		  ZetaDeltaVQuads.resize(numQuadPointsNLP);
+		  gradZetalmDeltaVlDyadicDistImageAtomsQuads.resize(numQuadPointsNLP);
+		  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+		  {
+		    ZetaDeltaVQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
+		    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
+		    for (unsigned int i=0; i < d_nonLocalPSP_numberPseudoWaveFunctions.size(); ++i)
+		    {
+		      const int numberPseudoWaveFunctions = d_nonLocalPSP_numberPseudoWaveFunctions[i];
+		      ZetaDeltaVQuads[q][i].resize(numberPseudoWaveFunctions);
+		      gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i].resize(numberPseudoWaveFunctions);
+		      for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+		      {
+			  ZetaDeltaVQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor1);
+			  gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor5);
+		      }
+		    }
+		  }
+	      }
+
+	      const unsigned int numSubCells=matrixFreeData.n_components_filled(cell);
+
+	      std::vector<Tensor<1,2,VectorizedArray<double> > > psiQuads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor1);
+	      std::vector<Tensor<1,2,Tensor<1,C_DIM,VectorizedArray<double> > > > gradPsiQuads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor2);
+
+	      for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		  for (unsigned int iEigenVec=0; iEigenVec<currentBlockSize; ++iEigenVec)
+		  {
+		    psiEval.read_dof_values_plain(eigenVectors[ikPoint][iEigenVec]);
+		    psiEval.evaluate(true,true);
+
+		    for (unsigned int q=0; q<numQuadPoints; ++q)
+		    {
+		       const unsigned int id=q*currentBlockSize*numKPoints+currentBlockSize*ikPoint+iEigenVec;
+		       psiQuads[id]=psiEval.get_value(q);
+		       gradPsiQuads[id]=psiEval.get_gradient(q);
+		    }//quad point loop
+		  } //eigenvector loop
+
+	      std::vector<Tensor<1,2,VectorizedArray<double> > > psiQuadsNLP;
+	      if (isPseudopotential && dftParameters::useHigherQuadNLP)
+	      {
+		  psiQuadsNLP.resize(numQuadPointsNLP*currentBlockSize*numKPoints,zeroTensor1);
+		  for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		      for (unsigned int iEigenVec=0; iEigenVec<currentBlockSize; ++iEigenVec)
+		      {
+			psiEvalNLP.read_dof_values_plain(eigenVectors[ikPoint][iEigenVec]);
+			psiEvalNLP.evaluate(true,false);
+
+			for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+			{
+			   const unsigned int id=q*currentBlockSize*numKPoints+currentBlockSize*ikPoint+iEigenVec;
+			   psiQuadsNLP[id]=psiEvalNLP.get_value(q);
+			}//quad point loop
+		      } //eigenvector loop
+	      }
+
+	      if(isPseudopotential)
+	      {
+		 std::vector<double> zetalmDeltaVlKPoint;
+		 std::vector<double> gradZetalmDeltaVlKPoint;
+		 std::vector<double> gradZetalmDeltaVlMinusZetalmDeltaVlKPoint;
+		 std::vector<double> gradZetalmDeltaVlDyadicDistImageAtomsKPoint;
+
+		 for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
+		 {
+		    subCellPtr= matrixFreeData.get_cell_iterator(cell,iSubCell);
+		    dealii::CellId subCellId=subCellPtr->id();
+
+		    for (unsigned int i=0; i < d_nonLocalPSP_numberPseudoWaveFunctions.size(); ++i)
+		    {
+		      const std::map<dealii::CellId,unsigned int>::const_iterator cellInSupportIdIter
+			  =d_nonLocalPSP_cellIdToCellInSupportIdMap[i].find(subCellId);
+		      if (cellInSupportIdIter==d_nonLocalPSP_cellIdToCellInSupportIdMap[i].end())
+			  continue;
+
+		      const int numberPseudoWaveFunctions = d_nonLocalPSP_numberPseudoWaveFunctions[i];
+		      for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		      {
+			 computeNonLocalPSPQuadDataKPoint(i,
+							  cellInSupportIdIter->second,
+							  ikPoint,
+							  true,
+							  zetalmDeltaVlKPoint,
+							  gradZetalmDeltaVlKPoint,
+							  gradZetalmDeltaVlMinusZetalmDeltaVlKPoint,
+							  gradZetalmDeltaVlDyadicDistImageAtomsKPoint);
+
+			 for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+			    for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+			    {
+			       const unsigned int id=iPseudoWave*numQuadPointsNLP+q;
+			       ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][iSubCell]=zetalmDeltaVlKPoint[id*2+0];
+			       ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][iSubCell]=zetalmDeltaVlKPoint[id*2+1];
+			       for (unsigned int idim=0; idim<C_DIM; idim++)
+				 for (unsigned int jdim=0; jdim<C_DIM; jdim++)
+				 {
+				    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][0][idim][jdim][iSubCell]=gradZetalmDeltaVlDyadicDistImageAtomsKPoint[((id*C_DIM+idim)*C_DIM+jdim)*2+0];
+				    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][1][idim][jdim][iSubCell]=gradZetalmDeltaVlDyadicDistImageAtomsKPoint[((id*C_DIM+idim)*C_DIM+jdim)*2+1];
+				 }
+			    }
+		      }
+		    }//i loop
+		 }//subcell loop
+	      }//is pseudopotential check
+
+	      Tensor<2,C_DIM,VectorizedArray<double> > EKPointsQuadSum=zeroTensor4;
+	      for (unsigned int q=0; q<numQuadPoints; ++q)
+	      {
+		 Tensor<2,C_DIM,VectorizedArray<double> > EKPoints=eshelbyTensor::getELocWfcEshelbyTensorPeriodicKPoints
+								       (psiQuads.begin()+q*currentBlockSize*numKPoints,
+									gradPsiQuads.begin()+q*currentBlockSize*numKPoints,
+									dftPtr->d_kPointCoordinates,
+									dftPtr->d_kPointWeights,
+									blockedEigenValues,
+									dftPtr->fermiEnergy,
+									dftParameters::TVal);
+
+		 EKPoints+=eshelbyTensor::getEKStress
+					  (psiQuads.begin()+q*currentBlockSize*numKPoints,
+					   gradPsiQuads.begin()+q*currentBlockSize*numKPoints,
+					   dftPtr->d_kPointCoordinates,
+					   dftPtr->d_kPointWeights,
+					   blockedEigenValues,
+					   dftPtr->fermiEnergy,
+					   dftParameters::TVal);
+
+		 if(isPseudopotential && !dftParameters::useHigherQuadNLP)
+		 {
+		    EKPoints+=eshelbyTensor::getEnlEshelbyTensorPeriodic(ZetaDeltaVQuads[q],
+								   projectorKetTimesPsiTimesVTimesPartOcc,
+								   psiQuads.begin()+q*currentBlockSize*numKPoints,
+								   dftPtr->d_kPointWeights,
+								   macroIdToNonlocalAtomsSetMap[cell],
+								   currentBlockSize);
+
+		    EKPoints+=eshelbyTensor::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
+							   projectorKetTimesPsiTimesVTimesPartOcc,
+							   psiQuads.begin()+q*currentBlockSize*numKPoints,
+							   dftPtr->d_kPointWeights,
+							   macroIdToNonlocalAtomsSetMap[cell],
+							   currentBlockSize);
+
+		 }//is pseudopotential check
+
+		 EKPointsQuadSum+=EKPoints*forceEval.JxW(q);
+	      }//quad point loop
+
+	      if (isPseudopotential && dftParameters::useHigherQuadNLP)
+		  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+		  {
+		    Tensor<2,C_DIM,VectorizedArray<double> > EKPoints
+			=eshelbyTensor::getEnlEshelbyTensorPeriodic(ZetaDeltaVQuads[q],
+								   projectorKetTimesPsiTimesVTimesPartOcc,
+								   psiQuadsNLP.begin()+q*currentBlockSize*numKPoints,
+								   dftPtr->d_kPointWeights,
+								   macroIdToNonlocalAtomsSetMap[cell],
+								   currentBlockSize);
+
+		    EKPoints+=eshelbyTensor::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
+							   projectorKetTimesPsiTimesVTimesPartOcc,
+							   psiQuadsNLP.begin()+q*currentBlockSize*numKPoints,
+							   dftPtr->d_kPointWeights,
+							   macroIdToNonlocalAtomsSetMap[cell],
+							   currentBlockSize);
+
+		    EKPointsQuadSum+=EKPoints*forceEvalNLP.JxW(q);
+		  }
+
+	      for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
+		  for (unsigned int idim=0; idim<C_DIM; ++idim)
+		      for (unsigned int jdim=0; jdim<C_DIM; ++jdim)
+			  d_stressKPoints[idim][jdim]+=EKPointsQuadSum[idim][jdim][iSubCell];
+	    }//macro cell loop
+        }//band parallelization loop
+    }//wavefunction block loop
+  }
+
+  /////////// Compute contribution independent of wavefunctions /////////////////
+  std::vector<VectorizedArray<double> > rhoQuads(numQuadPoints,make_vectorized_array(0.0));
+  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > gradRhoQuads(numQuadPoints,zeroTensor3);
+  std::vector<VectorizedArray<double> > excQuads(numQuadPoints,make_vectorized_array(0.0));
+  std::vector<VectorizedArray<double> > pseudoVLocQuads(numQuadPoints,make_vectorized_array(0.0));
+  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > gradPseudoVLocQuads(numQuadPoints,zeroTensor3);
+  std::vector<VectorizedArray<double> > vEffRhoInQuads(numQuadPoints,make_vectorized_array(0.0));
+  std::vector<VectorizedArray<double> > vEffRhoOutQuads(numQuadPoints,make_vectorized_array(0.0));
+  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > derExchCorrEnergyWithGradRhoInQuads(numQuadPoints,zeroTensor3);
+  std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > derExchCorrEnergyWithGradRhoOutQuads(numQuadPoints,zeroTensor3);
 
   for (unsigned int cell=0; cell<matrixFreeData.n_macro_cells(); ++cell)
   {
     forceEval.reinit(cell);
-    psiEval.reinit(cell);
-
-    if (isPseudopotential && dftParameters::useHigherQuadNLP)
-    {
-      forceEvalNLP.reinit(cell);
-      psiEvalNLP.reinit(cell);
-    }
 
     if (d_isElectrostaticsMeshSubdivided || dftParameters::nonSelfConsistentForce)
     {
@@ -228,31 +472,6 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
 	     vEffRhoInQuads[q]=phiTotInEval.get_value(q);
 	     vEffRhoOutQuads[q]=phiTotOutEval.get_value(q);
 	}
-    //allocate storage for vector of quadPoints, nonlocal atom id, pseudo wave, k point
-    //FIXME: flatten nonlocal atomid id and pseudo wave and k point
-    std::vector<std::vector<std::vector<std::vector<Tensor<1,2,VectorizedArray<double> > > > > >ZetaDeltaVQuads;
-    std::vector<std::vector<std::vector<std::vector<Tensor<1,2, Tensor<2,C_DIM,VectorizedArray<double> > > > > > >gradZetalmDeltaVlDyadicDistImageAtomsQuads;
-    if(isPseudopotential)
-    {
-        ZetaDeltaVQuads.resize(numQuadPointsNLP);
-	gradZetalmDeltaVlDyadicDistImageAtomsQuads.resize(numQuadPointsNLP);
-	for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	{
-	  ZetaDeltaVQuads[q].resize(d_nonLocalPSP_ZetalmDeltaVl.size());
-	  gradZetalmDeltaVlDyadicDistImageAtomsQuads[q].resize(d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.size());
-	  for (unsigned int i=0; i < d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.size(); ++i)
-	  {
-	    const int numberPseudoWaveFunctions = d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i].size();
-	    ZetaDeltaVQuads[q][i].resize(numberPseudoWaveFunctions);
-	    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i].resize(numberPseudoWaveFunctions);
-	    for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
-	    {
-		ZetaDeltaVQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor1);
-		gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor5);
-	    }
-	  }
-	}
-    }
 
     const unsigned int numSubCells=matrixFreeData.n_components_filled(cell);
     //For LDA
@@ -298,6 +517,8 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
           for (unsigned int q=0; q<numQuadPoints; ++q)
 	  {
 	     excQuads[q][iSubCell]=exchValRhoOut[q]+corrValRhoOut[q];
+	     for (unsigned int idim=0; idim<C_DIM; idim++)
+		gradRhoQuads[q][idim][iSubCell]=gradRhoOut[q][idim];
 	     const double temp = derExchEnergyWithSigmaRhoOut[q]+derCorrEnergyWithSigmaRhoOut[q];
 	     vEffRhoInQuads[q][iSubCell]+= derExchEnergyWithDensityValRhoIn[q]+derCorrEnergyWithDensityValRhoIn[q];
              vEffRhoOutQuads[q][iSubCell]+= derExchEnergyWithDensityValRhoOut[q]+derCorrEnergyWithDensityValRhoOut[q];
@@ -331,56 +552,6 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
        }
     }
 
-    std::vector<Tensor<1,2,VectorizedArray<double> > > psiQuads(numQuadPoints*numEigenVectors*numKPoints,zeroTensor1);
-    std::vector<Tensor<1,2,Tensor<1,C_DIM,VectorizedArray<double> > > > gradPsiQuads(numQuadPoints*numEigenVectors*numKPoints,zeroTensor2);
-
-    for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-        for (unsigned int iEigenVec=0; iEigenVec<numEigenVectors; ++iEigenVec)
-        {
-	  psiEval.read_dof_values_plain(eigenVectors[ikPoint][iEigenVec]);
-          psiEval.evaluate(true,true);
-
-          for (unsigned int q=0; q<numQuadPoints; ++q)
-          {
-	     const unsigned int id=q*numEigenVectors*numKPoints+numEigenVectors*ikPoint+iEigenVec;
-             psiQuads[id]=psiEval.get_value(q);
-             gradPsiQuads[id]=psiEval.get_gradient(q);
-
-	     const double partOcc =dftUtils::getPartialOccupancy(dftPtr->eigenValues[ikPoint][iEigenVec],
-		                                                 dftPtr->fermiEnergy,
-							         C_kb,
-							         dftParameters::TVal);
-	     const VectorizedArray<double> factor=make_vectorized_array(2.0*dftPtr->d_kPointWeights[ikPoint]*partOcc);
-	     gradRhoQuads[q]+=factor*internalforce::computeGradRhoContribution(psiQuads[id],gradPsiQuads[id]);
-
-          }//quad point loop
-        } //eigenvector loop
-
-    //accumulate gradRho quad point contribution from all pools
-    for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
-        for (unsigned int q=0; q<numQuadPoints; ++q)
-	   for (unsigned int idim=0; idim<C_DIM; idim++)
-	      gradRhoQuads[q][idim][iSubCell]=
-		  Utilities::MPI::sum(gradRhoQuads[q][idim][iSubCell],dftPtr->interpoolcomm);
-
-    std::vector<Tensor<1,2,VectorizedArray<double> > > psiQuadsNLP;
-    if (isPseudopotential && dftParameters::useHigherQuadNLP)
-    {
-	psiQuadsNLP.resize(numQuadPointsNLP*numEigenVectors*numKPoints,zeroTensor1);
-	for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-	    for (unsigned int iEigenVec=0; iEigenVec<numEigenVectors; ++iEigenVec)
-	    {
-	      psiEvalNLP.read_dof_values_plain(eigenVectors[ikPoint][iEigenVec]);
-	      psiEvalNLP.evaluate(true,false);
-
-	      for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	      {
-		 const unsigned int id=q*numEigenVectors*numKPoints+numEigenVectors*ikPoint+iEigenVec;
-		 psiQuadsNLP[id]=psiEvalNLP.get_value(q);
-	      }//quad point loop
-	    } //eigenvector loop
-    }
-
     if(isPseudopotential)
     {
        for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
@@ -394,39 +565,10 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
              gradPseudoVLocQuads[q][1][iSubCell]=gradPseudoVLoc.find(subCellId)->second[C_DIM*q+1];
 	     gradPseudoVLocQuads[q][2][iSubCell]=gradPseudoVLoc.find(subCellId)->second[C_DIM*q+2];
 	  }
-
-	  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	  {
-            for (unsigned int i=0; i < d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.size(); ++i)
-	    {
-	      const int numberPseudoWaveFunctions = d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i].size();
-	      for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
-	      {
-		if (d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave].find(subCellId)!=d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave].end())
-		{
-                   for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-		   {
-                      ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][iSubCell]=d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*2+q*2+0];
-                      ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][iSubCell]=d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*2+q*2+1];
-		      for (unsigned int idim=0; idim<C_DIM; idim++)
-		      {
-		        for (unsigned int jdim=0; jdim<C_DIM; jdim++)
-		        {
-                           gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][0][idim][jdim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*C_DIM*2+q*C_DIM*C_DIM*2+idim*C_DIM*2+jdim*2+0];
-                           gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][1][idim][jdim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*C_DIM*2+q*C_DIM*C_DIM*2+idim*C_DIM*2+jdim*2+1];
-			}
-		      }
-		   }
-		}//non-trivial cellId check
-	      }//iPseudoWave loop
-	    }//i loop
-	  }//q loop
        }//subcell loop
-
     }//is pseudopotential check
 
     Tensor<2,C_DIM,VectorizedArray<double> > EQuadSum=zeroTensor4;
-    Tensor<2,C_DIM,VectorizedArray<double> > EKPointsQuadSum=zeroTensor4;
     for (unsigned int q=0; q<numQuadPoints; ++q)
     {
 
@@ -462,77 +604,14 @@ void forceClass<FEOrder>::computeStressEEshelbyEPSPEnlEk(const MatrixFree<3,doub
 	   }
        }
 
-       Tensor<2,C_DIM,VectorizedArray<double> > EKPoints=eshelbyTensor::getELocWfcEshelbyTensorPeriodicKPoints
-						             (psiQuads.begin()+q*numEigenVectors*numKPoints,
-						              gradPsiQuads.begin()+q*numEigenVectors*numKPoints,
-							      dftPtr->d_kPointCoordinates,
-							      dftPtr->d_kPointWeights,
-							      dftPtr->eigenValues,
-							      dftPtr->fermiEnergy,
-							      dftParameters::TVal);
-
-       EKPoints+=eshelbyTensor::getEKStress
-				(psiQuads.begin()+q*numEigenVectors*numKPoints,
-				 gradPsiQuads.begin()+q*numEigenVectors*numKPoints,
-			         dftPtr->d_kPointCoordinates,
-				 dftPtr->d_kPointWeights,
-				 dftPtr->eigenValues,
-			         dftPtr->fermiEnergy,
-				 dftParameters::TVal);
-
-       if(isPseudopotential && !dftParameters::useHigherQuadNLP)
-       {
-          EKPoints+=eshelbyTensor::getEnlEshelbyTensorPeriodic(ZetaDeltaVQuads[q],
-		                                         projectorKetTimesPsiTimesVTimesPartOcc,
-						         psiQuads.begin()+q*numEigenVectors*numKPoints,
-							 dftPtr->d_kPointWeights,
-							 macroIdToNonlocalAtomsSetMap[cell],
-                                                         numEigenVectors);
-
-          EKPoints+=eshelbyTensor::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
-		                                 projectorKetTimesPsiTimesVTimesPartOcc,
-						 psiQuads.begin()+q*numEigenVectors*numKPoints,
-					         dftPtr->d_kPointWeights,
-						 macroIdToNonlocalAtomsSetMap[cell],
-                                                 numEigenVectors);
-
-       }//is pseudopotential check
-
        EQuadSum+=E*forceEval.JxW(q);
-       EKPointsQuadSum+=EKPoints*forceEval.JxW(q);
     }//quad point loop
 
-    if (isPseudopotential && dftParameters::useHigherQuadNLP)
-	for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	{
-	  Tensor<2,C_DIM,VectorizedArray<double> > EKPoints
-              =eshelbyTensor::getEnlEshelbyTensorPeriodic(ZetaDeltaVQuads[q],
-		                                         projectorKetTimesPsiTimesVTimesPartOcc,
-						         psiQuadsNLP.begin()+q*numEigenVectors*numKPoints,
-							 dftPtr->d_kPointWeights,
-							 macroIdToNonlocalAtomsSetMap[cell],
-                                                         numEigenVectors);
-
-          EKPoints+=eshelbyTensor::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
-		                                 projectorKetTimesPsiTimesVTimesPartOcc,
-						 psiQuadsNLP.begin()+q*numEigenVectors*numKPoints,
-					         dftPtr->d_kPointWeights,
-						 macroIdToNonlocalAtomsSetMap[cell],
-                                                 numEigenVectors);
-
-
-	   EKPointsQuadSum+=EKPoints*forceEvalNLP.JxW(q);
-
-	}
-
    for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
 	for (unsigned int idim=0; idim<C_DIM; ++idim)
 	    for (unsigned int jdim=0; jdim<C_DIM; ++jdim)
-	    {
 		d_stress[idim][jdim]+=EQuadSum[idim][jdim][iSubCell];
-		d_stressKPoints[idim][jdim]+=EKPointsQuadSum[idim][jdim][iSubCell];
-	    }
-  }
+  }//macro cell loop
 
   ////Add electrostatic configurational force contribution////////////////
   computeStressEEshelbyEElectroPhiTot
@@ -42,30 +42,6 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
 		              const std::map<unsigned int,std::map<dealii::CellId, std::vector<double> > > & gradPseudoVLocAtomsElectro,
 			      const vselfBinsManager<FEOrder> & vselfBinsManagerElectro)
 {
-  std::vector<std::vector<vectorType>> eigenVectors((1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size());
-  for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size(); ++kPoint)
-  {
-        eigenVectors[kPoint].resize(dftPtr->d_numEigenValues);
-        for(unsigned int i = 0; i < dftPtr->d_numEigenValues; ++i)
-          eigenVectors[kPoint][i].reinit(dftPtr->d_tempEigenVec);
-
-#ifdef USE_COMPLEX
-	vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		 (dftPtr->d_eigenVectorsFlattened[kPoint],
-		  dftPtr->d_numEigenValues,
-		  std::make_pair(0,dftPtr->d_numEigenValues),
-		  dftPtr->localProc_dof_indicesReal,
-		  dftPtr->localProc_dof_indicesImag,
-		  eigenVectors[kPoint]);
-#else
-	vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		 (dftPtr->d_eigenVectorsFlattened[kPoint],
-		  dftPtr->d_numEigenValues,
-		  std::make_pair(0,dftPtr->d_numEigenValues),
-		  eigenVectors[kPoint]);
-#endif
-  }
-
   const unsigned int numberGlobalAtoms = dftPtr->atomLocations.size();
   const unsigned int numberImageCharges = dftPtr->d_imageIds.size();
   const unsigned int totalNumberAtoms = numberGlobalAtoms + numberImageCharges;
@@ -108,6 +84,9 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
   const unsigned int numQuadPointsNLP=dftParameters::useHigherQuadNLP?
                                       forceEvalNLP.n_q_points:numQuadPoints;
   const unsigned int numEigenVectors=dftPtr->d_numEigenValues;
+  //states in the unoccupied tail beyond the occupancy cutoff are not evaluated and are
+  //assigned zero occupancy
+  const unsigned int numEigenVectorsOccupied=dftPtr->computeNumberStatesAboveOccupancyCutoff();
   const unsigned int numKPoints=dftPtr->d_kPointWeights.size();
 
   DoFHandler<C_DIM>::active_cell_iterator subCellPtr;
@@ -150,59 +129,370 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
        macroIdToNonlocalAtomsSetMap[cell]=std::vector<unsigned int>(mergedSet.begin(),mergedSet.end());
   }
 
-  std::vector<std::vector<double>> partialOccupanciesSpin0(dftPtr->d_kPointWeights.size(),
-								  std::vector<double>(numEigenVectors,0.0));
-  std::vector<std::vector<double>> partialOccupanciesSpin1(dftPtr->d_kPointWeights.size(),
-								  std::vector<double>(numEigenVectors,0.0));
-  for(unsigned int kPoint = 0; kPoint < dftPtr->d_kPointWeights.size(); ++kPoint)
-     for (unsigned int iWave=0; iWave<numEigenVectors;++iWave)
-     {
-
-	   partialOccupanciesSpin0[kPoint][iWave]
-		 =dftUtils::getPartialOccupancy(dftPtr->eigenValues[kPoint][iWave],
-						dftPtr->fermiEnergy,
-						C_kb,
-						dftParameters::TVal);
-	   partialOccupanciesSpin1[kPoint][iWave]
-		 =dftUtils::getPartialOccupancy(dftPtr->eigenValues[kPoint][numEigenVectors+iWave],
-						dftPtr->fermiEnergy,
-						C_kb,
-						dftParameters::TVal);
-	  if(dftParameters::constraintMagnetization)
-	  {
-	     partialOccupanciesSpin0[kPoint][iWave] = 1.0;
-	     partialOccupanciesSpin1[kPoint][iWave] = 1.0 ;
-	     if (dftPtr->eigenValues[kPoint][iWave]> dftPtr->fermiEnergyUp)
-		    partialOccupanciesSpin0[kPoint][iWave] = 0.0 ;
-	     if (dftPtr->eigenValues[kPoint][numEigenVectors+iWave] > dftPtr->fermiEnergyDown)
-		    partialOccupanciesSpin1[kPoint][iWave] = 0.0 ;
-	  }
-     }
-
-  VectorizedArray<double> phiExtFactor=make_vectorized_array(0.0);
-  std::vector<std::vector<std::vector<dataTypes::number > > > projectorKetTimesPsiSpin0TimesVTimesPartOcc(numKPoints);
-  std::vector<std::vector<std::vector<dataTypes::number > > > projectorKetTimesPsiSpin1TimesVTimesPartOcc(numKPoints);
-  if (isPseudopotential)
+  //the wavefunction dependent contributions are already accumulated in d_stressKPoints
+  //if they were computed in the same pass as the configurational force
+  if (!d_isStressKPointsComputedWithForce)
   {
-    phiExtFactor=make_vectorized_array(1.0);
-    for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-    {
-         computeNonLocalProjectorKetTimesPsiTimesVFlattened(dftPtr->d_eigenVectorsFlattened[2*ikPoint],
-		                                   numEigenVectors,
-                                                   projectorKetTimesPsiSpin0TimesVTimesPartOcc[ikPoint],
-						   ikPoint,
-						   partialOccupanciesSpin0[ikPoint]);
-    }
-    for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+    //band group parallelization data structures
+    const unsigned int numberBandGroups=
+	  dealii::Utilities::MPI::n_mpi_processes(dftPtr->interBandGroupComm);
+    const unsigned int bandGroupTaskId = dealii::Utilities::MPI::this_mpi_process(dftPtr->interBandGroupComm);
+    std::vector<unsigned int> bandGroupLowHighPlusOneIndices;
+    dftUtils::createBandParallelizationIndices(dftPtr->interBandGroupComm,
+					       numEigenVectors,
+					       bandGroupLowHighPlusOneIndices);
+
+    const unsigned int blockSize=std::min(dftParameters::wfcBlockSize,
+					  bandGroupLowHighPlusOneIndices[1]);
+
+    //
+    //stream over blocks of wavefunctions read from the flattened storage, so that only
+    //blockSize wavefunctions per spin are duplicated at any time
+    //
+    const unsigned int localVectorSize = dftPtr->d_eigenVectorsFlattenedSTL[0].size()/numEigenVectors;
+    std::vector<std::vector<vectorType>> eigenVectors(2*numKPoints);
+    std::vector<dealii::parallel::distributed::Vector<dataTypes::number> > eigenVectorsFlattenedBlock(2*numKPoints);
+
+    for(unsigned int ivec = 0; ivec < numEigenVectorsOccupied; ivec+=blockSize)
     {
-         computeNonLocalProjectorKetTimesPsiTimesVFlattened(dftPtr->d_eigenVectorsFlattened[2*ikPoint+1],
-		                                   numEigenVectors,
-                                                   projectorKetTimesPsiSpin1TimesVTimesPartOcc[ikPoint],
-						   ikPoint,
-						   partialOccupanciesSpin1[ikPoint]);
-    }
+        const unsigned int currentBlockSize=std::min(blockSize,numEigenVectorsOccupied-ivec);
+
+        if (currentBlockSize!=blockSize || ivec==0)
+        {
+	     for(unsigned int kPoint = 0; kPoint < 2*numKPoints; ++kPoint)
+	     {
+		eigenVectors[kPoint].resize(currentBlockSize);
+		for(unsigned int i= 0; i < currentBlockSize; ++i)
+		    eigenVectors[kPoint][i].reinit(dftPtr->d_tempEigenVec);
+
+
+		eigenVectorsFlattenedBlock[kPoint].reinit
+		  (dftPtr->d_flattenedArrayRegistry.getFlattenedPartitioner(dftPtr->matrix_free_data.get_vector_partitioner(),
+									    currentBlockSize));
+		eigenVectorsFlattenedBlock[kPoint] = dataTypes::number(0.0);
+	     }
+
+	     dftPtr->constraintsNoneDataInfo.precomputeMaps
+	       (dftPtr->d_flattenedArrayRegistry.getFlattenedArrayData(dftPtr->matrix_free_data,
+								       currentBlockSize)->localIndexMapUnflattenedToFlattened);
+        }
+
+        if((ivec+currentBlockSize)<=bandGroupLowHighPlusOneIndices[2*bandGroupTaskId+1] &&
+	    (ivec+currentBlockSize)>bandGroupLowHighPlusOneIndices[2*bandGroupTaskId])
+        {
+            std::vector<std::vector<double>> blockedEigenValues(numKPoints,std::vector<double>(2*currentBlockSize,0.0));
+            std::vector<std::vector<double>> blockedPartialOccupanciesSpin0(numKPoints,
+									    std::vector<double>(currentBlockSize,0.0));
+            std::vector<std::vector<double>> blockedPartialOccupanciesSpin1(numKPoints,
+									    std::vector<double>(currentBlockSize,0.0));
+	    for(unsigned int kPoint = 0; kPoint < numKPoints; ++kPoint)
+	       for (unsigned int iWave=0; iWave<currentBlockSize;++iWave)
+	       {
+		   blockedEigenValues[kPoint][iWave]=dftPtr->eigenValues[kPoint][ivec+iWave];
+		   blockedEigenValues[kPoint][currentBlockSize+iWave]
+		       =dftPtr->eigenValues[kPoint][numEigenVectors+ivec+iWave];
+
+		   blockedPartialOccupanciesSpin0[kPoint][iWave]
+			   =dftUtils::getPartialOccupancy(blockedEigenValues[kPoint][iWave],
+							  dftPtr->fermiEnergy,
+							  C_kb,
+							  dftParameters::TVal);
+		   blockedPartialOccupanciesSpin1[kPoint][iWave]
+			   =dftUtils::getPartialOccupancy(blockedEigenValues[kPoint][iWave+currentBlockSize],
+							  dftPtr->fermiEnergy,
+							  C_kb,
+							  dftParameters::TVal);
+		   if(dftParameters::constraintMagnetization)
+		   {
+		       blockedPartialOccupanciesSpin0[kPoint][iWave] = 1.0;
+		       blockedPartialOccupanciesSpin1[kPoint][iWave] = 1.0 ;
+		       if (blockedEigenValues[kPoint][iWave]> dftPtr->fermiEnergyUp)
+			      blockedPartialOccupanciesSpin0[kPoint][iWave] = 0.0 ;
+		       if (blockedEigenValues[kPoint][iWave+currentBlockSize] > dftPtr->fermiEnergyDown)
+			      blockedPartialOccupanciesSpin1[kPoint][iWave] = 0.0 ;
+		   }
+	       }
+
+	    for(unsigned int kPoint = 0; kPoint < 2*numKPoints; ++kPoint)
+	    {
+		   //the block of the spin channel owned by the other spin group is left at zero, so that
+		   //its contribution is added by the other spin group
+		   if (!dftPtr->isSpinChannelOwned(kPoint%2))
+		     continue;
+
+		   for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
+		      for(unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
+			  eigenVectorsFlattenedBlock[kPoint].local_element(iNode*currentBlockSize+iWave)
+			    = dftPtr->d_eigenVectorsFlattenedSTL[kPoint][iNode*numEigenVectors+ivec+iWave];
+
+		   dftPtr->constraintsNoneDataInfo.distribute(eigenVectorsFlattenedBlock[kPoint],
+						      currentBlockSize);
+		   eigenVectorsFlattenedBlock[kPoint].update_ghost_values();
+
+		   vectorTools::copyFlattenedDealiiVecToSingleCompVec
+			   (eigenVectorsFlattenedBlock[kPoint],
+			    currentBlockSize,
+			    std::make_pair(0,currentBlockSize),
+			    dftPtr->localProc_dof_indicesReal,
+			    dftPtr->localProc_dof_indicesImag,
+			    eigenVectors[kPoint],
+			    false);
+
+		   //FIXME: The underlying call to update_ghost_values
+		   //is required because currently localProc_dof_indicesReal
+		   //and localProc_dof_indicesImag are only available for
+		   //locally owned nodes.
+		   for(unsigned int i= 0; i < currentBlockSize; ++i)
+		       eigenVectors[kPoint][i].update_ghost_values();
+	    }
+
+	    std::vector<std::vector<std::vector<dataTypes::number > > > projectorKetTimesPsiSpin0TimesVTimesPartOcc(numKPoints);
+	    std::vector<std::vector<std::vector<dataTypes::number > > > projectorKetTimesPsiSpin1TimesVTimesPartOcc(numKPoints);
+	    if (isPseudopotential)
+	      for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+	      {
+		   computeNonLocalProjectorKetTimesPsiTimesVFlattened(eigenVectorsFlattenedBlock[2*ikPoint],
+							     currentBlockSize,
+							     projectorKetTimesPsiSpin0TimesVTimesPartOcc[ikPoint],
+							     ikPoint,
+							     blockedPartialOccupanciesSpin0[ikPoint]);
+
+		   computeNonLocalProjectorKetTimesPsiTimesVFlattened(eigenVectorsFlattenedBlock[2*ikPoint+1],
+							     currentBlockSize,
+							     projectorKetTimesPsiSpin1TimesVTimesPartOcc[ikPoint],
+							     ikPoint,
+							     blockedPartialOccupanciesSpin1[ikPoint]);
+	      }
+
+	    for (unsigned int cell=0; cell<matrixFreeData.n_macro_cells(); ++cell)
+	    {
+	      forceEval.reinit(cell);
+	      psiEvalSpin0.reinit(cell);
+	      psiEvalSpin1.reinit(cell);
+
+	      if (isPseudopotential && dftParameters::useHigherQuadNLP)
+	      {
+		forceEvalNLP.reinit(cell);
+		psiEvalSpin0NLP.reinit(cell);
+		psiEvalSpin1NLP.reinit(cell);
+	      }
+
+	      //allocate storage for vector of quadPoints, nonlocal atom id, pseudo wave, k point
+	      //FIXME: flatten nonlocal atomid id and pseudo wave and k point
+	      std::vector<std::vector<std::vector<std::vector<Tensor<1,2,VectorizedArray<double> > > > > >ZetaDeltaVQuads;
+	      std::vector<std::vector<std::vector<std::vector<Tensor<1,2, Tensor<2,C_DIM,VectorizedArray<double> > > > > > >gradZetalmDeltaVlDyadicDistImageAtomsQuads;
+	      if(isPseudopotential)
+	      {
+		  ZetaDeltaVQuads.resize(numQuadPointsNLP);
+		  gradZetalmDeltaVlDyadicDistImageAtomsQuads.resize(numQuadPointsNLP);
+		  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+		  {
+		    ZetaDeltaVQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
+		    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q].resize(d_nonLocalPSP_numberPseudoWaveFunctions.size());
+		    for (unsigned int i=0; i < d_nonLocalPSP_numberPseudoWaveFunctions.size(); ++i)
+		    {
+		      const int numberPseudoWaveFunctions = d_nonLocalPSP_numberPseudoWaveFunctions[i];
+		      ZetaDeltaVQuads[q][i].resize(numberPseudoWaveFunctions);
+		      gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i].resize(numberPseudoWaveFunctions);
+		      for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+		      {
+			  ZetaDeltaVQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor1);
+			  gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor5);
+		      }
+		    }
+		  }
+	      }
+
+	      const unsigned int numSubCells=matrixFreeData.n_components_filled(cell);
+
+	      std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin0Quads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor1);
+	      std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin1Quads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor1);
+	      std::vector<Tensor<1,2,Tensor<1,C_DIM,VectorizedArray<double> > > > gradPsiSpin0Quads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor2);
+	      std::vector<Tensor<1,2,Tensor<1,C_DIM,VectorizedArray<double> > > > gradPsiSpin1Quads(numQuadPoints*currentBlockSize*numKPoints,zeroTensor2);
+
+	      for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		  for (unsigned int iEigenVec=0; iEigenVec<currentBlockSize; ++iEigenVec)
+		  {
+		    psiEvalSpin0.read_dof_values_plain(eigenVectors[2*ikPoint][iEigenVec]);
+		    psiEvalSpin0.evaluate(true,true);
+		    psiEvalSpin1.read_dof_values_plain(eigenVectors[2*ikPoint+1][iEigenVec]);
+		    psiEvalSpin1.evaluate(true,true);
+
+		    for (unsigned int q=0; q<numQuadPoints; ++q)
+		    {
+		       const int id=q*currentBlockSize*numKPoints+currentBlockSize*ikPoint+iEigenVec;
+		       psiSpin0Quads[id]=psiEvalSpin0.get_value(q);
+		       psiSpin1Quads[id]=psiEvalSpin1.get_value(q);
+		       gradPsiSpin0Quads[id]=psiEvalSpin0.get_gradient(q);
+		       gradPsiSpin1Quads[id]=psiEvalSpin1.get_gradient(q);
+		    }//quad point loop
+		  } //eigenvector loop
+
+	      std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin0QuadsNLP;
+	      std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin1QuadsNLP;
+	      if (isPseudopotential && dftParameters::useHigherQuadNLP)
+	      {
+		  psiSpin0QuadsNLP.resize(numQuadPointsNLP*currentBlockSize*numKPoints,zeroTensor1);
+		  psiSpin1QuadsNLP.resize(numQuadPointsNLP*currentBlockSize*numKPoints,zeroTensor1);
+		  for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		      for (unsigned int iEigenVec=0; iEigenVec<currentBlockSize; ++iEigenVec)
+		      {
+			psiEvalSpin0NLP.read_dof_values_plain(eigenVectors[2*ikPoint][iEigenVec]);
+			psiEvalSpin0NLP.evaluate(true,false);
+
+			psiEvalSpin1NLP.read_dof_values_plain(eigenVectors[2*ikPoint+1][iEigenVec]);
+			psiEvalSpin1NLP.evaluate(true,false);
+
+			for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+			{
+			   const int id=q*currentBlockSize*numKPoints+currentBlockSize*ikPoint+iEigenVec;
+			   psiSpin0QuadsNLP[id]=psiEvalSpin0NLP.get_value(q);
+			   psiSpin1QuadsNLP[id]=psiEvalSpin1NLP.get_value(q);
+			}//quad point loop
+		      } //eigenvector loop
+	      }
+
+	      if(isPseudopotential)
+	      {
+		 std::vector<double> zetalmDeltaVlKPoint;
+		 std::vector<double> gradZetalmDeltaVlKPoint;
+		 std::vector<double> gradZetalmDeltaVlMinusZetalmDeltaVlKPoint;
+		 std::vector<double> gradZetalmDeltaVlDyadicDistImageAtomsKPoint;
+
+		 for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
+		 {
+		    subCellPtr= matrixFreeData.get_cell_iterator(cell,iSubCell);
+		    dealii::CellId subCellId=subCellPtr->id();
+
+		    for (unsigned int i=0; i < d_nonLocalPSP_numberPseudoWaveFunctions.size(); ++i)
+		    {
+		      const std::map<dealii::CellId,unsigned int>::const_iterator cellInSupportIdIter
+			  =d_nonLocalPSP_cellIdToCellInSupportIdMap[i].find(subCellId);
+		      if (cellInSupportIdIter==d_nonLocalPSP_cellIdToCellInSupportIdMap[i].end())
+			  continue;
+
+		      const int numberPseudoWaveFunctions = d_nonLocalPSP_numberPseudoWaveFunctions[i];
+		      for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
+		      {
+			 computeNonLocalPSPQuadDataKPoint(i,
+							  cellInSupportIdIter->second,
+							  ikPoint,
+							  true,
+							  zetalmDeltaVlKPoint,
+							  gradZetalmDeltaVlKPoint,
+							  gradZetalmDeltaVlMinusZetalmDeltaVlKPoint,
+							  gradZetalmDeltaVlDyadicDistImageAtomsKPoint);
+
+			 for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+			    for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+			    {
+			       const unsigned int id=iPseudoWave*numQuadPointsNLP+q;
+			       ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][iSubCell]=zetalmDeltaVlKPoint[id*2+0];
+			       ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][iSubCell]=zetalmDeltaVlKPoint[id*2+1];
+			       for (unsigned int idim=0; idim<C_DIM; idim++)
+				 for (unsigned int jdim=0; jdim<C_DIM; jdim++)
+				 {
+				    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][0][idim][jdim][iSubCell]=gradZetalmDeltaVlDyadicDistImageAtomsKPoint[((id*C_DIM+idim)*C_DIM+jdim)*2+0];
+				    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][1][idim][jdim][iSubCell]=gradZetalmDeltaVlDyadicDistImageAtomsKPoint[((id*C_DIM+idim)*C_DIM+jdim)*2+1];
+				 }
+			    }
+		      }
+		    }//i loop
+		 }//subcell loop
+	      }//is pseudopotential check
+
+	      Tensor<2,C_DIM,VectorizedArray<double> > EKPointsQuadSum=zeroTensor4;
+	      for (unsigned int q=0; q<numQuadPoints; ++q)
+	      {
+		 Tensor<2,C_DIM,VectorizedArray<double> > EKPoints=eshelbyTensorSP::getELocWfcEshelbyTensorPeriodicKPoints
+								   (psiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+								    psiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+								    gradPsiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+								    gradPsiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+								    dftPtr->d_kPointCoordinates,
+								    dftPtr->d_kPointWeights,
+								    blockedEigenValues,
+								    dftPtr->fermiEnergy,
+								    dftPtr->fermiEnergyUp,
+								    dftPtr->fermiEnergyDown,
+								    dftParameters::TVal);
+
+		 EKPoints+=eshelbyTensorSP::getEKStress
+						   (psiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+						    psiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+						    gradPsiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+						    gradPsiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+						    dftPtr->d_kPointCoordinates,
+						    dftPtr->d_kPointWeights,
+						    blockedEigenValues,
+						    dftPtr->fermiEnergy,
+						    dftPtr->fermiEnergyUp,
+						    dftPtr->fermiEnergyDown,
+						    dftParameters::TVal);
+
+		 if(isPseudopotential && !dftParameters::useHigherQuadNLP)
+		 {
+		     EKPoints+=eshelbyTensorSP::getEnlEshelbyTensorPeriodic
+								  (ZetaDeltaVQuads[q],
+								   projectorKetTimesPsiSpin0TimesVTimesPartOcc,
+								   projectorKetTimesPsiSpin1TimesVTimesPartOcc,
+								   psiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+								   psiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+								   dftPtr->d_kPointWeights,
+								   macroIdToNonlocalAtomsSetMap[cell],
+								   currentBlockSize);
+
+		     EKPoints+=eshelbyTensorSP::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
+							   projectorKetTimesPsiSpin0TimesVTimesPartOcc,
+							   projectorKetTimesPsiSpin1TimesVTimesPartOcc,
+							   psiSpin0Quads.begin()+q*currentBlockSize*numKPoints,
+							   psiSpin1Quads.begin()+q*currentBlockSize*numKPoints,
+							   dftPtr->d_kPointWeights,
+							   macroIdToNonlocalAtomsSetMap[cell],
+							   currentBlockSize);
+
+		 }//is pseudopotential check
+
+		 EKPointsQuadSum+=EKPoints*forceEval.JxW(q);
+
+	      }//quad point loop
+
+	      if (isPseudopotential && dftParameters::useHigherQuadNLP)
+		  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
+		  {
+		     Tensor<2,C_DIM,VectorizedArray<double> > EKPoints
+			   =eshelbyTensorSP::getEnlEshelbyTensorPeriodic
+								  (ZetaDeltaVQuads[q],
+								   projectorKetTimesPsiSpin0TimesVTimesPartOcc,
+								   projectorKetTimesPsiSpin1TimesVTimesPartOcc,
+								   psiSpin0QuadsNLP.begin()+q*currentBlockSize*numKPoints,
+								   psiSpin1QuadsNLP.begin()+q*currentBlockSize*numKPoints,
+								   dftPtr->d_kPointWeights,
+								   macroIdToNonlocalAtomsSetMap[cell],
+								   currentBlockSize);
+
+		     EKPoints+=eshelbyTensorSP::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
+							   projectorKetTimesPsiSpin0TimesVTimesPartOcc,
+							   projectorKetTimesPsiSpin1TimesVTimesPartOcc,
+							   psiSpin0QuadsNLP.begin()+q*currentBlockSize*numKPoints,
+							   psiSpin1QuadsNLP.begin()+q*currentBlockSize*numKPoints,
+							   dftPtr->d_kPointWeights,
+							   macroIdToNonlocalAtomsSetMap[cell],
+							   currentBlockSize);
+
+		     EKPointsQuadSum+=EKPoints*forceEvalNLP.JxW(q);
+		  }
+
+	      for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
+		  for (unsigned int idim=0; idim<C_DIM; ++idim)
+		      for (unsigned int jdim=0; jdim<C_DIM; ++jdim)
+			  d_stressKPoints[idim][jdim]+=EKPointsQuadSum[idim][jdim][iSubCell];
+	    }//macro cell loop
+        }//band parallelization loop
+    }//wavefunction block loop
   }
 
+  /////////// Compute contribution independent of wavefunctions /////////////////
   std::vector<VectorizedArray<double> > rhoQuads(numQuadPoints,make_vectorized_array(0.0));
   std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > gradRhoSpin0Quads(numQuadPoints,zeroTensor3);
   std::vector<Tensor<1,C_DIM,VectorizedArray<double> > > gradRhoSpin1Quads(numQuadPoints,zeroTensor3);
@@ -221,15 +511,6 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
   for (unsigned int cell=0; cell<matrixFreeData.n_macro_cells(); ++cell)
   {
     forceEval.reinit(cell);
-    psiEvalSpin0.reinit(cell);
-    psiEvalSpin1.reinit(cell);
-
-    if (isPseudopotential && dftParameters::useHigherQuadNLP)
-    {
-      forceEvalNLP.reinit(cell);
-      psiEvalSpin0NLP.reinit(cell);
-      psiEvalSpin1NLP.reinit(cell);
-    }
 
     if (d_isElectrostaticsMeshSubdivided || dftParameters::nonSelfConsistentForce)
     {
@@ -276,32 +557,6 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
 	     vEffRhoOutSpin1Quads[q]=phiTotOutEval.get_value(q);
 	}
 
-    //allocate storage for vector of quadPoints, nonlocal atom id, pseudo wave, k point
-    //FIXME: flatten nonlocal atomid id and pseudo wave and k point
-    std::vector<std::vector<std::vector<std::vector<Tensor<1,2,VectorizedArray<double> > > > > >ZetaDeltaVQuads;
-    std::vector<std::vector<std::vector<std::vector<Tensor<1,2, Tensor<2,C_DIM,VectorizedArray<double> > > > > > >gradZetalmDeltaVlDyadicDistImageAtomsQuads;
-    if(isPseudopotential)
-    {
-	ZetaDeltaVQuads.resize(numQuadPointsNLP);
-	gradZetalmDeltaVlDyadicDistImageAtomsQuads.resize(numQuadPointsNLP);
-	for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	{
-	  ZetaDeltaVQuads[q].resize(d_nonLocalPSP_ZetalmDeltaVl.size());
-	  gradZetalmDeltaVlDyadicDistImageAtomsQuads[q].resize(d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.size());
-	  for (unsigned int i=0; i < d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.size(); ++i)
-	  {
-	    const int numberPseudoWaveFunctions = d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i].size();
-	    ZetaDeltaVQuads[q][i].resize(numberPseudoWaveFunctions);
-	    gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i].resize(numberPseudoWaveFunctions);
-	    for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
-	    {
-	        ZetaDeltaVQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor1);
-		gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave].resize(numKPoints,zeroTensor5);
-	    }
-	  }
-	}
-    }
-
     const unsigned int numSubCells=matrixFreeData.n_components_filled(cell);
     //For LDA
     std::vector<double> exchValRhoOut(numQuadPoints);
@@ -356,6 +611,11 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
           for (unsigned int q=0; q<numQuadPoints; ++q)
 	  {
 	     excQuads[q][iSubCell]=exchValRhoOut[q]+corrValRhoOut[q];
+	     for (unsigned int idim=0; idim<C_DIM; idim++)
+	     {
+		gradRhoSpin0Quads[q][idim][iSubCell]=gradRhoOutSpin0[q][idim];
+		gradRhoSpin1Quads[q][idim][iSubCell]=gradRhoOutSpin1[q][idim];
+	     }
 	     vEffRhoInSpin0Quads[q][iSubCell]+= derExchEnergyWithDensityValRhoIn[2*q]+derCorrEnergyWithDensityValRhoIn[2*q];
 	     vEffRhoInSpin1Quads[q][iSubCell]+= derExchEnergyWithDensityValRhoIn[2*q+1]+derCorrEnergyWithDensityValRhoIn[2*q+1];
              vEffRhoOutSpin0Quads[q][iSubCell]+= derExchEnergyWithDensityValRhoOut[2*q]+derCorrEnergyWithDensityValRhoOut[2*q];
@@ -402,89 +662,6 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
        }
     }
 
-    std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin0Quads(numQuadPoints*numEigenVectors*numKPoints,zeroTensor1);
-    std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin1Quads(numQuadPoints*numEigenVectors*numKPoints,zeroTensor1);
-    std::vector<Tensor<1,2,Tensor<1,C_DIM,VectorizedArray<double> > > > gradPsiSpin0Quads(numQuadPoints*numEigenVectors*numKPoints,zeroTensor2);
-    std::vector<Tensor<1,2,Tensor<1,C_DIM,VectorizedArray<double> > > > gradPsiSpin1Quads(numQuadPoints*numEigenVectors*numKPoints,zeroTensor2);
-
-    for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-        for (unsigned int iEigenVec=0; iEigenVec<numEigenVectors; ++iEigenVec)
-        {
-          psiEvalSpin0.read_dof_values_plain(eigenVectors[2*ikPoint][iEigenVec]);
-          psiEvalSpin0.evaluate(true,true);
-          psiEvalSpin1.read_dof_values_plain(eigenVectors[2*ikPoint+1][iEigenVec]);
-          psiEvalSpin1.evaluate(true,true);
-
-          for (unsigned int q=0; q<numQuadPoints; ++q)
-          {
-	     const int id=q*numEigenVectors*numKPoints+numEigenVectors*ikPoint+iEigenVec;
-             psiSpin0Quads[id]=psiEvalSpin0.get_value(q);
-	     psiSpin1Quads[id]=psiEvalSpin1.get_value(q);
-             gradPsiSpin0Quads[id]=psiEvalSpin0.get_gradient(q);
-	     gradPsiSpin1Quads[id]=psiEvalSpin1.get_gradient(q);
-
-             double partOccSpin0 =dftUtils::getPartialOccupancy
-		                                                     (dftPtr->eigenValues[ikPoint][iEigenVec],
-		                                                      dftPtr->fermiEnergy,
-								      C_kb,
-								      dftParameters::TVal);
-             double partOccSpin1 =dftUtils::getPartialOccupancy
-		                                                     (dftPtr->eigenValues[ikPoint][iEigenVec+numEigenVectors],
-		                                                      dftPtr->fermiEnergy,
-								      C_kb,
-								      dftParameters::TVal);
-
-	     if(dftParameters::constraintMagnetization)
-	     {
-		 partOccSpin0 = 1.0 , partOccSpin1 = 1.0 ;
-		 if ( dftPtr->eigenValues[ikPoint][iEigenVec+numEigenVectors]> dftPtr->fermiEnergyDown)
-			partOccSpin1 = 0.0 ;
-		 if (dftPtr->eigenValues[ikPoint][iEigenVec] > dftPtr->fermiEnergyUp)
-			partOccSpin0 = 0.0 ;
-	     }
-
-	     const VectorizedArray<double> factor0=make_vectorized_array(dftPtr->d_kPointWeights[ikPoint]*partOccSpin0);
-	     const VectorizedArray<double> factor1=make_vectorized_array(dftPtr->d_kPointWeights[ikPoint]*partOccSpin1);
-
-	     gradRhoSpin0Quads[q]+=factor0*internalforce::computeGradRhoContribution(psiSpin0Quads[id],gradPsiSpin0Quads[id]);
-	     gradRhoSpin1Quads[q]+=factor1*internalforce::computeGradRhoContribution(psiSpin1Quads[id],gradPsiSpin1Quads[id]);
-
-          }//quad point loop
-        } //eigenvector loop
-
-    //accumulate grad rho quad point contribution from all pools
-    for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
-      for (unsigned int q=0; q<numQuadPoints; ++q)
-	for (unsigned int idim=0; idim<C_DIM; idim++)
-	{
-	  gradRhoSpin0Quads[q][idim][iSubCell]=Utilities::MPI::sum(gradRhoSpin0Quads[q][idim][iSubCell],dftPtr->interpoolcomm);
-	  gradRhoSpin1Quads[q][idim][iSubCell]=Utilities::MPI::sum(gradRhoSpin1Quads[q][idim][iSubCell],dftPtr->interpoolcomm);
-	}
-
-    std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin0QuadsNLP;
-    std::vector<Tensor<1,2,VectorizedArray<double> > > psiSpin1QuadsNLP;
-    if (isPseudopotential && dftParameters::useHigherQuadNLP)
-    {
-	psiSpin0QuadsNLP.resize(numQuadPointsNLP*numEigenVectors*numKPoints,zeroTensor1);
-	psiSpin1QuadsNLP.resize(numQuadPointsNLP*numEigenVectors*numKPoints,zeroTensor1);
-	for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-	    for (unsigned int iEigenVec=0; iEigenVec<numEigenVectors; ++iEigenVec)
-	    {
-	      psiEvalSpin0NLP.read_dof_values_plain(eigenVectors[2*ikPoint][iEigenVec]);
-	      psiEvalSpin0NLP.evaluate(true,false);
-
-	      psiEvalSpin1NLP.read_dof_values_plain(eigenVectors[2*ikPoint+1][iEigenVec]);
-	      psiEvalSpin1NLP.evaluate(true,false);
-
-	      for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	      {
-		 const int id=q*numEigenVectors*numKPoints+numEigenVectors*ikPoint+iEigenVec;
-		 psiSpin0QuadsNLP[id]=psiEvalSpin0NLP.get_value(q);
-		 psiSpin1QuadsNLP[id]=psiEvalSpin1NLP.get_value(q);
-	      }//quad point loop
-	    } //eigenvector loop
-    }
-
     if(isPseudopotential)
     {
        for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
@@ -498,38 +675,10 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
              gradPseudoVLocQuads[q][1][iSubCell]=gradPseudoVLoc.find(subCellId)->second[C_DIM*q+1];
 	     gradPseudoVLocQuads[q][2][iSubCell]=gradPseudoVLoc.find(subCellId)->second[C_DIM*q+2];
 	  }
-
-	  for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	  {
-            for (unsigned int i=0; i < d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.size(); ++i)
-	    {
-	      const int numberPseudoWaveFunctions = d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i].size();
-	      for (unsigned int iPseudoWave=0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
-	      {
-		if (d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave].find(subCellId)!=d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave].end())
-		{
-                   for (unsigned int ikPoint=0; ikPoint<numKPoints; ++ikPoint)
-		   {
-                      ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][0][iSubCell]=d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*2+q*2+0];
-                      ZetaDeltaVQuads[q][i][iPseudoWave][ikPoint][1][iSubCell]=d_nonLocalPSP_ZetalmDeltaVl[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*2+q*2+1];
-		      for (unsigned int idim=0; idim<C_DIM; idim++)
-		      {
-		        for (unsigned int jdim=0; jdim<C_DIM; jdim++)
-		        {
-                           gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][0][idim][jdim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*C_DIM*2+q*C_DIM*C_DIM*2+idim*C_DIM*2+jdim*2+0];
-                           gradZetalmDeltaVlDyadicDistImageAtomsQuads[q][i][iPseudoWave][ikPoint][1][idim][jdim][iSubCell]=d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[i][iPseudoWave][subCellId][ikPoint*numQuadPointsNLP*C_DIM*C_DIM*2+q*C_DIM*C_DIM*2+idim*C_DIM*2+jdim*2+1];
-			}
-		      }
-		   }
-		}//non-trivial cellId check
-	      }//iPseudoWave loop
-	    }//i loop
-	  }//q loop
        }//subcell loop
     }//is pseudopotential check
 
     Tensor<2,C_DIM,VectorizedArray<double> > EQuadSum=zeroTensor4;
-    Tensor<2,C_DIM,VectorizedArray<double> > EKPointsQuadSum=zeroTensor4;
     for (unsigned int q=0; q<numQuadPoints; ++q)
     {
        const VectorizedArray<double> phiTot_q =d_isElectrostaticsMeshSubdivided?
@@ -567,95 +716,14 @@ void forceClass<FEOrder>::computeStressSpinPolarizedEEshelbyEPSPEnlEk
        }
 
 
-       Tensor<2,C_DIM,VectorizedArray<double> > EKPoints=eshelbyTensorSP::getELocWfcEshelbyTensorPeriodicKPoints
-							 (psiSpin0Quads.begin()+q*numEigenVectors*numKPoints,
-                                                          psiSpin1Quads.begin()+q*numEigenVectors*numKPoints,
-							  gradPsiSpin0Quads.begin()+q*numEigenVectors*numKPoints,
-							  gradPsiSpin1Quads.begin()+q*numEigenVectors*numKPoints,
-							  dftPtr->d_kPointCoordinates,
-							  dftPtr->d_kPointWeights,
-							  dftPtr->eigenValues,
-					                  dftPtr->fermiEnergy,
-				                          dftPtr->fermiEnergyUp,
-					                  dftPtr->fermiEnergyDown,
-							  dftParameters::TVal);
-
-       EKPoints+=eshelbyTensorSP::getEKStress
-					 (psiSpin0Quads.begin()+q*numEigenVectors*numKPoints,
-					  psiSpin1Quads.begin()+q*numEigenVectors*numKPoints,
-					  gradPsiSpin0Quads.begin()+q*numEigenVectors*numKPoints,
-					  gradPsiSpin1Quads.begin()+q*numEigenVectors*numKPoints,
-					  dftPtr->d_kPointCoordinates,
-					  dftPtr->d_kPointWeights,
-					  dftPtr->eigenValues,
-					  dftPtr->fermiEnergy,
-				          dftPtr->fermiEnergyUp,
-					  dftPtr->fermiEnergyDown,
-					  dftParameters::TVal);
-
-       if(isPseudopotential && !dftParameters::useHigherQuadNLP)
-       {
-           EKPoints+=eshelbyTensorSP::getEnlEshelbyTensorPeriodic
-	                                                (ZetaDeltaVQuads[q],
-		                                         projectorKetTimesPsiSpin0TimesVTimesPartOcc,
-		                                         projectorKetTimesPsiSpin1TimesVTimesPartOcc,
-						         psiSpin0Quads.begin()+q*numEigenVectors*numKPoints,
-						         psiSpin1Quads.begin()+q*numEigenVectors*numKPoints,
-							 dftPtr->d_kPointWeights,
-                                                         macroIdToNonlocalAtomsSetMap[cell],
-							 numEigenVectors);
-
-           EKPoints+=eshelbyTensorSP::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
-		                                 projectorKetTimesPsiSpin0TimesVTimesPartOcc,
-						 projectorKetTimesPsiSpin1TimesVTimesPartOcc,
-					         psiSpin0Quads.begin()+q*numEigenVectors*numKPoints,
-					         psiSpin1Quads.begin()+q*numEigenVectors*numKPoints,
-					         dftPtr->d_kPointWeights,
-                                                 macroIdToNonlocalAtomsSetMap[cell],
-                                                 numEigenVectors);
-
-       }//is pseudopotential check
-
        EQuadSum+=E*forceEval.JxW(q);
-       EKPointsQuadSum+=EKPoints*forceEval.JxW(q);
-
     }//quad point loop
 
-    if (isPseudopotential && dftParameters::useHigherQuadNLP)
-	for (unsigned int q=0; q<numQuadPointsNLP; ++q)
-	{
-	   Tensor<2,C_DIM,VectorizedArray<double> > EKPoints
-                 =eshelbyTensorSP::getEnlEshelbyTensorPeriodic
-	                                                (ZetaDeltaVQuads[q],
-		                                         projectorKetTimesPsiSpin0TimesVTimesPartOcc,
-		                                         projectorKetTimesPsiSpin1TimesVTimesPartOcc,
-						         psiSpin0QuadsNLP.begin()+q*numEigenVectors*numKPoints,
-						         psiSpin1QuadsNLP.begin()+q*numEigenVectors*numKPoints,
-							 dftPtr->d_kPointWeights,
-                                                         macroIdToNonlocalAtomsSetMap[cell],
-                                                         numEigenVectors);
-
-           EKPoints+=eshelbyTensorSP::getEnlStress(gradZetalmDeltaVlDyadicDistImageAtomsQuads[q],
-		                                 projectorKetTimesPsiSpin0TimesVTimesPartOcc,
-						 projectorKetTimesPsiSpin1TimesVTimesPartOcc,
-					         psiSpin0QuadsNLP.begin()+q*numEigenVectors*numKPoints,
-					         psiSpin1QuadsNLP.begin()+q*numEigenVectors*numKPoints,
-					         dftPtr->d_kPointWeights,
-                                                 macroIdToNonlocalAtomsSetMap[cell],
-                                                 numEigenVectors);
-
-
-	   EKPointsQuadSum+=EKPoints*forceEvalNLP.JxW(q);
-	}
-
    for (unsigned int iSubCell=0; iSubCell<numSubCells; ++iSubCell)
 	for (unsigned int idim=0; idim<C_DIM; ++idim)
 	    for (unsigned int jdim=0; jdim<C_DIM; ++jdim)
-	    {
 		d_stress[idim][jdim]+=EQuadSum[idim][jdim][iSubCell];
-		d_stressKPoints[idim][jdim]+=EKPointsQuadSum[idim][jdim][iSubCell];
-	    }
-  }
+  }//macro cell loop
 
   ////Add electrostatic configurational force contribution////////////////
   computeStressEEshelbyEElectroPhiTot
@@ -44,6 +44,9 @@ void forceClass<FEOrder>::computeStress
 	         const ConstraintMatrix  & noConstraintsElectro,
 		 const vselfBinsManager<FEOrder> & vselfBinsManagerElectro)
 {
+  if(dftParameters::isPseudopotential && !d_isNonLocalPSPQuadDataComputed)
+        computeElementalNonLocalPseudoOVDataForce();
+
   /*
   createBinObjectsForce(matrixFreeData.get_dof_handler(phiTotDofHandlerIndex),
 	                d_dofHandlerForce,
@@ -74,7 +77,8 @@ void forceClass<FEOrder>::computeStress
     for (unsigned int jdim=0; jdim<C_DIM; jdim++)
     {
 	d_stress[idim][jdim]=0.0;
-	d_stressKPoints[idim][jdim]=0.0;
+	if (!d_isStressKPointsComputedWithForce)
+	  d_stressKPoints[idim][jdim]=0.0;
     }
   }
 
@@ -134,11 +138,14 @@ void forceClass<FEOrder>::computeStress
   //Sum all processor contributions and distribute to all processors
   d_stress=Utilities::MPI::sum(d_stress,mpi_communicator);
 
-  //Sum k point stress contribution over all processors
-  //and k point pools and add to total stress
+  //Sum k point stress contribution over all processors,
+  //k point pools, band groups and spin groups and add to total stress
   d_stressKPoints=Utilities::MPI::sum(d_stressKPoints,mpi_communicator);
   d_stressKPoints=Utilities::MPI::sum(d_stressKPoints,dftPtr->interpoolcomm);
+  d_stressKPoints=Utilities::MPI::sum(d_stressKPoints,dftPtr->interBandGroupComm);
+  d_stressKPoints=Utilities::MPI::sum(d_stressKPoints,dftPtr->interSpinGroupComm);
   d_stress+=d_stressKPoints;
+  d_isStressKPointsComputedWithForce=false;
 
   //Scale by inverse of domain volume
   d_stress=d_stress*(1.0/dftPtr->d_domainVolume);
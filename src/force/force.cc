@@ -26,6 +26,9 @@
 #include <fileReaders.h>
 #include <linearAlgebraOperations.h>
 #include <vectorUtilities.h>
+#include <boundingBoxTree.h>
+#include <performanceTelemetry.h>
+#include <memoryLedger.h>
 #include <boost/math/special_functions/spherical_harmonic.hpp>
 
 
@@ -192,6 +195,7 @@ void forceClass<FEOrder>::initMoved
 	             const bool isElectrostaticsMesh,
 		     const bool isElectrostaticsEigenMeshDifferent)
 {
+  d_gaussianGeneratorCandidatesGeometry.clear();
   if (isElectrostaticsMesh)
   {
      d_dofHandlerForceElectro.distribute_dofs(FEForce);
@@ -252,14 +256,28 @@ void forceClass<FEOrder>::initMoved
 }
 
 //
-//initialize pseudopotential data for force computation
+//initialize pseudopotential data for force computation. The nonlocal pseudopotential
+//quadrature data is built lazily on the first force or stress computation
 //
 template<unsigned int FEOrder>
 void forceClass<FEOrder>::initPseudoData()
 {
+  d_isNonLocalPSPQuadDataComputed=false;
 
-  if(dftParameters::isPseudopotential)
-        computeElementalNonLocalPseudoOVDataForce();
+  d_nonLocalPSP_numberPseudoWaveFunctions.clear();
+  d_nonLocalPSP_cellIdToCellInSupportIdMap.clear();
+  std::vector<std::vector<double> >().swap(d_nonLocalPSP_ZetalmDeltaVl);
+  std::vector<std::vector<double> >().swap(d_nonLocalPSP_gradZetalmDeltaVl);
+#ifdef USE_COMPLEX
+  d_nonLocalPSP_cellImageStartIds.clear();
+  d_nonLocalPSP_cellImageChargePoints.clear();
+  d_nonLocalPSP_cellQuadPoints.clear();
+  d_nonLocalPSP_nuclearCoordinates.clear();
+#endif
+  memoryLedger::setBytes(memoryLedger::forceTables,
+			 "nonlocal pseudopotential quadrature data",
+			 0.0);
+  d_cellIdToNonlocalAtomIdsLocalCompactSupportMap.clear();
 }
 
 //compute forces on atoms corresponding to a Gaussian generator
@@ -290,6 +308,9 @@ void forceClass<FEOrder>::computeAtomsForces
 	         const ConstraintMatrix  & noConstraintsElectro,
 		 const vselfBinsManager<FEOrder> & vselfBinsManagerElectro)
 {
+  if(dftParameters::isPseudopotential && !d_isNonLocalPSPQuadDataComputed)
+        computeElementalNonLocalPseudoOVDataForce();
+
   /*
   createBinObjectsForce(matrixFreeData.get_dof_handler(phiTotDofHandlerIndex),
 	                d_dofHandlerForce,
@@ -338,6 +359,9 @@ void forceClass<FEOrder>::computeAtomsForces
 		                        vselfBinsManagerElectro);
 
   computeAtomsForcesGaussianGenerator(d_allowGaussianOverlapOnAtoms);
+
+  if (dftParameters::verbosity>=2 && !dftParameters::reproducible_output)
+    memoryLedger::printSummary("force computation");
 }
 
 
@@ -417,6 +441,15 @@ void forceClass<FEOrder>::computeConfigurationalForceTotalLinFE
   configForceLinFEInit(matrixFreeData,
 	               matrixFreeDataElectro);
 
+#ifdef USE_COMPLEX
+  //accumulate the wavefunction dependent stress contributions in the same pass over the
+  //wavefunction blocks if the cell stress is also requested
+  d_isStressKPointsComputedWithForce=dftParameters::isCellStress;
+  for (unsigned int idim=0; idim<C_DIM; idim++)
+    for (unsigned int jdim=0; jdim<C_DIM; jdim++)
+	d_stressKPoints[idim][jdim]=0.0;
+#endif
+
   //configurational force contribution from all terms except those from nuclear self energy
   if (dftParameters::spinPolarized)
      computeConfigurationalForceSpinPolarizedEEshelbyTensorFPSPFnlLinFE
@@ -469,7 +502,8 @@ void forceClass<FEOrder>::computeConfigurationalForceTotalLinFE
 
   //configurational force contribution from nuclear self energy. This is handled separately as it involves
   // a surface integral over the vself ball surface
-  if (dealii::Utilities::MPI::this_mpi_process(dftPtr->interBandGroupComm)==0)
+  if (dealii::Utilities::MPI::this_mpi_process(dftPtr->interBandGroupComm)==0
+      && dealii::Utilities::MPI::this_mpi_process(dftPtr->interSpinGroupComm)==0)
     computeConfigurationalForceEselfLinFE(matrixFreeDataElectro.get_dof_handler(phiTotDofHandlerIndexElectro),
 				        vselfBinsManagerElectro);
   configForceLinFEFinalize();
@@ -39,26 +39,28 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoDataForce()
   //
   QGauss<3>  quadrature(C_num1DQuad<FEOrder>());
   FEValues<3> fe_values(dftPtr->FE, quadrature, update_quadrature_points);
-  const unsigned int numberNodesPerElement  = dftPtr->FE.dofs_per_cell;
   const unsigned int numberQuadraturePoints = quadrature.size();
-  const unsigned int numKPoints=dftPtr->d_kPointWeights.size();
 
   //
   //get number of kPoints
   //
   const unsigned int numkPoints = dftPtr->d_kPointWeights.size();
 
+
   //
   //clear existing data
   //
+  d_nonLocalPSP_numberPseudoWaveFunctions.clear();
+  d_nonLocalPSP_cellIdToCellInSupportIdMap.clear();
   d_nonLocalPSP_ZetalmDeltaVl.clear();
-#ifdef USE_COMPLEX
-  d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint.clear();
-  d_nonLocalPSP_gradZetalmDeltaVl_KPoint.clear();
-  d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.clear();
-#else
   d_nonLocalPSP_gradZetalmDeltaVl.clear();
+#ifdef USE_COMPLEX
+  d_nonLocalPSP_cellImageStartIds.clear();
+  d_nonLocalPSP_cellImageChargePoints.clear();
+  d_nonLocalPSP_cellQuadPoints.clear();
+  d_nonLocalPSP_nuclearCoordinates.clear();
 #endif
+  d_cellIdToNonlocalAtomIdsLocalCompactSupportMap.clear();
   //
   //
   int cumulativePotSplineId = 0;
@@ -67,16 +69,21 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoDataForce()
   int pseudoPotentialId;
   unsigned int count=0;
   const unsigned int numNonLocalAtomsCurrentProcess= dftPtr->d_nonLocalAtomIdsInCurrentProcess.size();
+  d_nonLocalPSP_numberPseudoWaveFunctions.resize(numNonLocalAtomsCurrentProcess,0);
+  d_nonLocalPSP_cellIdToCellInSupportIdMap.resize(numNonLocalAtomsCurrentProcess);
   d_nonLocalPSP_ZetalmDeltaVl.resize(numNonLocalAtomsCurrentProcess);
-#ifdef USE_COMPLEX
-  d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint.resize(numNonLocalAtomsCurrentProcess);
-  d_nonLocalPSP_gradZetalmDeltaVl_KPoint.resize(numNonLocalAtomsCurrentProcess);
-  d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.resize(numNonLocalAtomsCurrentProcess);
-#else
   d_nonLocalPSP_gradZetalmDeltaVl.resize(numNonLocalAtomsCurrentProcess);
+#ifdef USE_COMPLEX
+  d_nonLocalPSP_cellImageStartIds.resize(numNonLocalAtomsCurrentProcess);
+  d_nonLocalPSP_cellImageChargePoints.resize(numNonLocalAtomsCurrentProcess);
+  d_nonLocalPSP_cellQuadPoints.resize(numNonLocalAtomsCurrentProcess);
+  d_nonLocalPSP_nuclearCoordinates.resize(numNonLocalAtomsCurrentProcess*C_DIM,0.0);
 #endif
 
-  for(int iAtom = 0; iAtom < numberNonLocalAtoms; ++iAtom)
+  //storage which would be required by per k point copies of the quadrature data
+  double perKPointStorageBytes=0.0;
+
+  for(unsigned int iAtom = 0; iAtom < numberNonLocalAtoms; ++iAtom)
     {
       //
       //get the global charge Id of the current nonlocal atom
@@ -104,13 +111,21 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoDataForce()
       //
       if (numberElementsInAtomCompactSupport !=0)
       {
-            d_nonLocalPSP_ZetalmDeltaVl[count].resize(numberPseudoWaveFunctions);
+	    d_nonLocalPSP_numberPseudoWaveFunctions[count]=numberPseudoWaveFunctions;
 #ifdef USE_COMPLEX
-            d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[count].resize(numberPseudoWaveFunctions);
-            d_nonLocalPSP_gradZetalmDeltaVl_KPoint[count].resize(numberPseudoWaveFunctions);
-	    d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[count].resize(numberPseudoWaveFunctions);
+	    d_nonLocalPSP_cellImageStartIds[count].resize(numberElementsInAtomCompactSupport+1,0);
+	    d_nonLocalPSP_cellQuadPoints[count].resize(numberElementsInAtomCompactSupport*numberQuadraturePoints*C_DIM);
+	    for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+	      d_nonLocalPSP_nuclearCoordinates[count*C_DIM+iDim]=nuclearCoordinates[iDim];
+
+	    perKPointStorageBytes+=numberElementsInAtomCompactSupport*numberPseudoWaveFunctions
+		                   *numkPoints*numberQuadraturePoints*(2+2*C_DIM+2*C_DIM+2*C_DIM*C_DIM)*sizeof(double);
 #else
-            d_nonLocalPSP_gradZetalmDeltaVl[count].resize(numberPseudoWaveFunctions);
+	    d_nonLocalPSP_ZetalmDeltaVl[count].resize(numberElementsInAtomCompactSupport*numberPseudoWaveFunctions*numberQuadraturePoints,0.0);
+	    d_nonLocalPSP_gradZetalmDeltaVl[count].resize(numberElementsInAtomCompactSupport*numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM,0.0);
+
+	    perKPointStorageBytes+=numberElementsInAtomCompactSupport*numberPseudoWaveFunctions
+		                   *numberQuadraturePoints*(1+C_DIM)*sizeof(double);
 #endif
       }
 
@@ -119,83 +134,90 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoDataForce()
 
 	  DoFHandler<3>::active_cell_iterator cell = dftPtr->d_elementOneFieldIteratorsInAtomCompactSupport[iAtom][iElemComp];
 
+	  //
+	  //
+	  //
+	  d_cellIdToNonlocalAtomIdsLocalCompactSupportMap[cell->id()].insert(count);
+	  d_nonLocalPSP_cellIdToCellInSupportIdMap[count][cell->id()]=iElemComp;
+
 	  //compute values for the current elements
 	  fe_values.reinit(cell);
 
-	  int iPsp = -1;
-	  int lTemp = 1e5;
-
-	  for(unsigned int iPseudoWave = 0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
-	    {
 #ifdef USE_COMPLEX
-	      d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*2);
-	      d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*C_DIM*2);
-	      d_nonLocalPSP_gradZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*C_DIM*2);
-              d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*C_DIM*C_DIM*2);
-#else
-	      d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=std::vector<double>(numberQuadraturePoints);
-	      d_nonLocalPSP_gradZetalmDeltaVl[count][iPseudoWave][cell->id()]=std::vector<double>(numberQuadraturePoints*C_DIM);
+	  for(unsigned int iQuadPoint = 0; iQuadPoint < numberQuadraturePoints; ++iQuadPoint)
+	     for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+		d_nonLocalPSP_cellQuadPoints[count][(iElemComp*numberQuadraturePoints+iQuadPoint)*C_DIM+iDim]
+		    =fe_values.quadrature_point(iQuadPoint)[iDim];
+
+	  d_nonLocalPSP_cellImageStartIds[count][iElemComp+1]=d_nonLocalPSP_cellImageStartIds[count][iElemComp];
 #endif
 
-	      waveFunctionId = iPseudoWave + cumulativeWaveSplineId;
-	      const int globalWaveSplineId = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][0];
-	      const int lQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][1];
-	      const int mQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][2];
+	  for(unsigned int iImageAtomCount = 0; iImageAtomCount < imageIdsList.size(); ++iImageAtomCount)
+	    {
 
-	      //
-	      //access pseudoPotential Ids
-	      //
-	      if(lQuantumNumber != lTemp)
-		iPsp += 1;
-	      pseudoPotentialId = iPsp + cumulativePotSplineId;
-	      lTemp = lQuantumNumber;
+	      int chargeId = imageIdsList[iImageAtomCount];
+
+	      Point<3> chargePoint(0.0,0.0,0.0);
+
+	      if(chargeId < numberGlobalCharges)
+		{
+		  chargePoint[0] = dftPtr->atomLocations[chargeId][2];
+		  chargePoint[1] = dftPtr->atomLocations[chargeId][3];
+		  chargePoint[2] = dftPtr->atomLocations[chargeId][4];
+		}
+	      else
+		{
+		  chargePoint[0] = dftPtr->d_imagePositions[chargeId-numberGlobalCharges][0];
+		  chargePoint[1] = dftPtr->d_imagePositions[chargeId-numberGlobalCharges][1];
+		  chargePoint[2] = dftPtr->d_imagePositions[chargeId-numberGlobalCharges][2];
+		}
 
-	      const int globalPotSplineId = dftPtr->d_deltaVlIdToFunctionIdDetails[pseudoPotentialId][0];
-	      assert(lQuantumNumber == dftPtr->d_deltaVlIdToFunctionIdDetails[pseudoPotentialId][1]);
 #ifdef USE_COMPLEX
-	      std::vector<double>  ZetalmDeltaVl_KPoint(numkPoints*numberQuadraturePoints*2,0.0);
-	      std::vector<double> gradZetalmDeltaVl_KPoint(numkPoints*numberQuadraturePoints*C_DIM*2,0.0);
-	      std::vector<double> gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint(numkPoints*numberQuadraturePoints*C_DIM*2,0.0);
-	      std::vector<double> gradZetalmDeltaVlDyadicDistImageAtoms_KPoint(numkPoints*numberQuadraturePoints*C_DIM*C_DIM*2,0.0);
+	      //
+	      //real space contribution of the current image atom. The k point phase factors are applied
+	      //on the fly in computeNonLocalPSPQuadDataKPoint
+	      //
+	      std::vector<double> ZetalmDeltaVl(numberPseudoWaveFunctions*numberQuadraturePoints,0.0);
+	      std::vector<double> gradZetalmDeltaVl(numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM,0.0);
+	      bool isImageContributing=false;
+	      double * ZetalmDeltaVlPtr=&ZetalmDeltaVl[0];
+	      double * gradZetalmDeltaVlPtr=&gradZetalmDeltaVl[0];
 #else
-	      std::vector<double> ZetalmDeltaVl(numberQuadraturePoints,0.0);
-	      std::vector<double> gradZetalmDeltaVl(numberQuadraturePoints*C_DIM,0.0);
+	      double * ZetalmDeltaVlPtr=&d_nonLocalPSP_ZetalmDeltaVl[count][iElemComp*numberPseudoWaveFunctions*numberQuadraturePoints];
+	      double * gradZetalmDeltaVlPtr=&d_nonLocalPSP_gradZetalmDeltaVl[count][iElemComp*numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM];
 #endif
 
-	      double nlpValue = 0.0;
-	      for(unsigned int iQuadPoint = 0; iQuadPoint < numberQuadraturePoints; ++iQuadPoint)
-		{
+	      int iPsp = -1;
+	      int lTemp = 1e5;
 
-		  Point<3> quadPoint=fe_values.quadrature_point(iQuadPoint);
+	      for(unsigned int iPseudoWave = 0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+		{
+		  waveFunctionId = iPseudoWave + cumulativeWaveSplineId;
+		  const int globalWaveSplineId = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][0];
+		  const int lQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][1];
+		  const int mQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][2];
 
-		  for(unsigned int iImageAtomCount = 0; iImageAtomCount < imageIdsList.size(); ++iImageAtomCount)
-		    {
+		  //
+		  //access pseudoPotential Ids
+		  //
+		  if(lQuantumNumber != lTemp)
+		    iPsp += 1;
+		  pseudoPotentialId = iPsp + cumulativePotSplineId;
+		  lTemp = lQuantumNumber;
 
-		      int chargeId = imageIdsList[iImageAtomCount];
+		  const int globalPotSplineId = dftPtr->d_deltaVlIdToFunctionIdDetails[pseudoPotentialId][0];
+		  assert(lQuantumNumber == dftPtr->d_deltaVlIdToFunctionIdDetails[pseudoPotentialId][1]);
 
-		      Point<3> chargePoint(0.0,0.0,0.0);
+		  for(unsigned int iQuadPoint = 0; iQuadPoint < numberQuadraturePoints; ++iQuadPoint)
+		    {
 
-		      if(chargeId < numberGlobalCharges)
-			{
-			  chargePoint[0] = dftPtr->atomLocations[chargeId][2];
-			  chargePoint[1] = dftPtr->atomLocations[chargeId][3];
-			  chargePoint[2] = dftPtr->atomLocations[chargeId][4];
-			}
-		      else
-			{
-			  chargePoint[0] = dftPtr->d_imagePositions[chargeId-numberGlobalCharges][0];
-			  chargePoint[1] = dftPtr->d_imagePositions[chargeId-numberGlobalCharges][1];
-			  chargePoint[2] = dftPtr->d_imagePositions[chargeId-numberGlobalCharges][2];
-			}
+		      Point<3> quadPoint=fe_values.quadrature_point(iQuadPoint);
 
-		      double x[3],qMinusLr[3];
+		      double x[3];
 
 		      x[0] = quadPoint[0] - chargePoint[0];
 		      x[1] = quadPoint[1] - chargePoint[1];
 		      x[2] = quadPoint[2] - chargePoint[2];
-		      qMinusLr[0] =x[0] +nuclearCoordinates[0];
-		      qMinusLr[1] =x[1] +nuclearCoordinates[1];
-		      qMinusLr[2] =x[2] +nuclearCoordinates[2];
 
 		      //
 		      // get the spherical coordinates from cartesian
@@ -204,90 +226,67 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoDataForce()
 		      pseudoForceUtils::convertCartesianToSpherical(x,r,theta,phi);
 
 		      double radialWaveFunVal, sphericalHarmonicVal, radialPotFunVal, pseudoWaveFunctionValue, deltaVlValue;
-	              std::vector<double> pseudoWaveFunctionDerivatives(3,0.0);
+		      std::vector<double> pseudoWaveFunctionDerivatives(3,0.0);
 		      std::vector<double> deltaVlDerivatives(3,0.0);
-		      if(r <= dftPtr->d_pspTail)//d_outerMostPointPseudoWaveFunctionsData[globalWaveSplineId])
+		      if(r <= dftPtr->d_pspTail)
 			{
 			  pseudoForceUtils::getRadialFunctionVal(r,
-					                         radialWaveFunVal,
-					                         &dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
+								 radialWaveFunVal,
+								 &dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
 
 			  pseudoForceUtils::getSphericalHarmonicVal(theta,phi,lQuantumNumber,mQuantumNumber,sphericalHarmonicVal);
 
 			  pseudoWaveFunctionValue = radialWaveFunVal*sphericalHarmonicVal;
 
 			  pseudoForceUtils::getRadialFunctionVal(r,
-					                         radialPotFunVal,
-					                         &dftPtr->d_deltaVlSplines[globalPotSplineId]);
+								 radialPotFunVal,
+								 &dftPtr->d_deltaVlSplines[globalPotSplineId]);
 
 			  deltaVlValue = radialPotFunVal;
 
 			  pseudoForceUtils::getPseudoWaveFunctionDerivatives(r,
-							                     theta,
-							                     phi,
-							                     lQuantumNumber,
-							                     mQuantumNumber,
-							                     pseudoWaveFunctionDerivatives,
-							                     dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
+									     theta,
+									     phi,
+									     lQuantumNumber,
+									     mQuantumNumber,
+									     pseudoWaveFunctionDerivatives,
+									     dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
 
 			  pseudoForceUtils::getDeltaVlDerivatives(r,
-						                  x,
-						                  deltaVlDerivatives,
-						                  dftPtr->d_deltaVlSplines[globalPotSplineId]);
-			  std::vector<double> tempDer(3);
-			  for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
-			  {
-				tempDer[iDim]=pseudoWaveFunctionDerivatives[iDim]*radialPotFunVal + pseudoWaveFunctionValue*deltaVlDerivatives[iDim];
-			  }
-#ifdef USE_COMPLEX
-                          for (unsigned int ik=0; ik < numkPoints; ++ik)
-			  {
-
-			     const double kDotqMinusLr= dftPtr->d_kPointCoordinates[ik*C_DIM+0]*qMinusLr[0]+ dftPtr->d_kPointCoordinates[ik*C_DIM+1]*qMinusLr[1]+dftPtr->d_kPointCoordinates[ik*C_DIM+2]*qMinusLr[2];
-			     const double tempReal=std::cos(-kDotqMinusLr);
-			     const double tempImag=std::sin(-kDotqMinusLr);
-		             ZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*2+2*iQuadPoint+0] += tempReal*deltaVlValue*pseudoWaveFunctionValue;
-		             ZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*2+2*iQuadPoint+1] += tempImag*deltaVlValue*pseudoWaveFunctionValue;
-			     for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
-			     {
-			         gradZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+0]+= tempReal*tempDer[iDim];
-				 gradZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+1]+= tempImag*tempDer[iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+0]+= tempReal*tempDer[iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+1]+= tempImag*tempDer[iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+0]+= tempImag*deltaVlValue*pseudoWaveFunctionValue*dftPtr->d_kPointCoordinates[ik*C_DIM+iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+1]-= tempReal*deltaVlValue*pseudoWaveFunctionValue*dftPtr->d_kPointCoordinates[ik*C_DIM+iDim];
-				 for(unsigned int jDim=0; jDim < C_DIM; ++jDim)
-				 {
-				     gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[ik*numberQuadraturePoints*C_DIM*C_DIM*2+iQuadPoint*C_DIM*C_DIM*2+iDim*C_DIM*2+jDim*2+0]+= tempReal*tempDer[iDim]*x[jDim];
-				     gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[ik*numberQuadraturePoints*C_DIM*C_DIM*2+iQuadPoint*C_DIM*C_DIM*2+iDim*C_DIM*2+jDim*2+1]+= tempImag*tempDer[iDim]*x[jDim];
-				 }
-			     }
-			  }
-#else
+								  x,
+								  deltaVlDerivatives,
+								  dftPtr->d_deltaVlSplines[globalPotSplineId]);
 
-		          ZetalmDeltaVl[iQuadPoint] += deltaVlValue*pseudoWaveFunctionValue;
+			  ZetalmDeltaVlPtr[iPseudoWave*numberQuadraturePoints+iQuadPoint] += deltaVlValue*pseudoWaveFunctionValue;
 
 			  for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
-			      gradZetalmDeltaVl[iQuadPoint*C_DIM+iDim]+= tempDer[iDim];
-
+			      gradZetalmDeltaVlPtr[(iPseudoWave*numberQuadraturePoints+iQuadPoint)*C_DIM+iDim]+=
+				  pseudoWaveFunctionDerivatives[iDim]*radialPotFunVal + pseudoWaveFunctionValue*deltaVlDerivatives[iDim];
+#ifdef USE_COMPLEX
+			  isImageContributing=true;
 #endif
 			}// within psp tail check
 
-		    }//image atom loop (contribution added)
+		    }//end of quad loop
+
+		}//end of iPseudoWave loop
 
-		}//end of quad loop
 #ifdef USE_COMPLEX
-	        d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=ZetalmDeltaVl_KPoint;
-		d_nonLocalPSP_gradZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=gradZetalmDeltaVl_KPoint;
-		d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint;
-		d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[count][iPseudoWave][cell->id()]=gradZetalmDeltaVlDyadicDistImageAtoms_KPoint;
-#else
-	        d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=ZetalmDeltaVl;
-		d_nonLocalPSP_gradZetalmDeltaVl[count][iPseudoWave][cell->id()]=gradZetalmDeltaVl;
+	      if (isImageContributing)
+		{
+		  for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+		      d_nonLocalPSP_cellImageChargePoints[count].push_back(chargePoint[iDim]);
+
+		  d_nonLocalPSP_ZetalmDeltaVl[count].insert(d_nonLocalPSP_ZetalmDeltaVl[count].end(),
+							    ZetalmDeltaVl.begin(),
+							    ZetalmDeltaVl.end());
+		  d_nonLocalPSP_gradZetalmDeltaVl[count].insert(d_nonLocalPSP_gradZetalmDeltaVl[count].end(),
+								gradZetalmDeltaVl.begin(),
+								gradZetalmDeltaVl.end());
+		  d_nonLocalPSP_cellImageStartIds[count][iElemComp+1]++;
+		}
 #endif
-
-	    }//end of iPseudoWave loop
-
+	    }//image atom loop (contribution added)
 
 	}//element loop
 
@@ -298,6 +297,9 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoDataForce()
 
     }//atom loop
 
+  d_isNonLocalPSPQuadDataComputed=true;
+
+  reportNonLocalPSPQuadDataMemory(perKPointStorageBytes);
 }
 
 
@@ -414,7 +416,7 @@ void forceClass<FEOrder>::computeNonLocalProjectorKetTimesPsiTimesV(const std::v
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][kPointIndex][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,kPointIndex),
 		     &numberNodesPerElement,
 		     &inputVectors[0],
 		     &numberNodesPerElement,
@@ -432,7 +434,7 @@ void forceClass<FEOrder>::computeNonLocalProjectorKetTimesPsiTimesV(const std::v
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,0),
 		     &numberNodesPerElement,
 		     &inputVectors[0],
 		     &numberNodesPerElement,
@@ -36,10 +36,8 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoOVDataForce()
   QGauss<3>  quadrature(C_num1DQuad<FEOrder>());
   QGauss<3>  quadratureHigh(C_num1DQuadPSP<FEOrder>());
   FEValues<3> fe_values(dftPtr->FE, dftParameters::useHigherQuadNLP?quadratureHigh:quadrature, update_quadrature_points);
-  const unsigned int numberNodesPerElement  = dftPtr->FE.dofs_per_cell;
   const unsigned int numberQuadraturePoints = dftParameters::useHigherQuadNLP?quadratureHigh.size()
                                                              :quadrature.size();
-  const unsigned int numKPoints=dftPtr->d_kPointWeights.size();
 
   //
   //get number of kPoints
@@ -50,29 +48,36 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoOVDataForce()
   //
   //clear existing data
   //
+  d_nonLocalPSP_numberPseudoWaveFunctions.clear();
+  d_nonLocalPSP_cellIdToCellInSupportIdMap.clear();
   d_nonLocalPSP_ZetalmDeltaVl.clear();
-#ifdef USE_COMPLEX
-  d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint.clear();
-  d_nonLocalPSP_gradZetalmDeltaVl_KPoint.clear();
-  d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.clear();
-#else
   d_nonLocalPSP_gradZetalmDeltaVl.clear();
+#ifdef USE_COMPLEX
+  d_nonLocalPSP_cellImageStartIds.clear();
+  d_nonLocalPSP_cellImageChargePoints.clear();
+  d_nonLocalPSP_cellQuadPoints.clear();
+  d_nonLocalPSP_nuclearCoordinates.clear();
 #endif
+  d_cellIdToNonlocalAtomIdsLocalCompactSupportMap.clear();
   //
   //
   int cumulativeWaveSplineId = 0;
   int waveFunctionId;
   unsigned int count=0;
   const unsigned int numNonLocalAtomsCurrentProcess= dftPtr->d_nonLocalAtomIdsInCurrentProcess.size();
+  d_nonLocalPSP_numberPseudoWaveFunctions.resize(numNonLocalAtomsCurrentProcess,0);
+  d_nonLocalPSP_cellIdToCellInSupportIdMap.resize(numNonLocalAtomsCurrentProcess);
   d_nonLocalPSP_ZetalmDeltaVl.resize(numNonLocalAtomsCurrentProcess);
-#ifdef USE_COMPLEX
-  d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint.resize(numNonLocalAtomsCurrentProcess);
-  d_nonLocalPSP_gradZetalmDeltaVl_KPoint.resize(numNonLocalAtomsCurrentProcess);
-  d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint.resize(numNonLocalAtomsCurrentProcess);
-#else
   d_nonLocalPSP_gradZetalmDeltaVl.resize(numNonLocalAtomsCurrentProcess);
+#ifdef USE_COMPLEX
+  d_nonLocalPSP_cellImageStartIds.resize(numNonLocalAtomsCurrentProcess);
+  d_nonLocalPSP_cellImageChargePoints.resize(numNonLocalAtomsCurrentProcess);
+  d_nonLocalPSP_cellQuadPoints.resize(numNonLocalAtomsCurrentProcess);
+  d_nonLocalPSP_nuclearCoordinates.resize(numNonLocalAtomsCurrentProcess*C_DIM,0.0);
 #endif
-  //MappingQ1<3,3> test;
+
+  //storage which would be required by per k point copies of the quadrature data
+  double perKPointStorageBytes=0.0;
 
   for(unsigned int iAtom = 0; iAtom < numberNonLocalAtoms; ++iAtom)
     {
@@ -101,13 +106,21 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoOVDataForce()
       //
       if (numberElementsInAtomCompactSupport !=0)
       {
-            d_nonLocalPSP_ZetalmDeltaVl[count].resize(numberPseudoWaveFunctions);
+	    d_nonLocalPSP_numberPseudoWaveFunctions[count]=numberPseudoWaveFunctions;
 #ifdef USE_COMPLEX
-            d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[count].resize(numberPseudoWaveFunctions);
-            d_nonLocalPSP_gradZetalmDeltaVl_KPoint[count].resize(numberPseudoWaveFunctions);
-	    d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[count].resize(numberPseudoWaveFunctions);
+	    d_nonLocalPSP_cellImageStartIds[count].resize(numberElementsInAtomCompactSupport+1,0);
+	    d_nonLocalPSP_cellQuadPoints[count].resize(numberElementsInAtomCompactSupport*numberQuadraturePoints*C_DIM);
+	    for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+	      d_nonLocalPSP_nuclearCoordinates[count*C_DIM+iDim]=nuclearCoordinates[iDim];
+
+	    perKPointStorageBytes+=numberElementsInAtomCompactSupport*numberPseudoWaveFunctions
+		                   *numkPoints*numberQuadraturePoints*(2+2*C_DIM+2*C_DIM+2*C_DIM*C_DIM)*sizeof(double);
 #else
-            d_nonLocalPSP_gradZetalmDeltaVl[count].resize(numberPseudoWaveFunctions);
+	    d_nonLocalPSP_ZetalmDeltaVl[count].resize(numberElementsInAtomCompactSupport*numberPseudoWaveFunctions*numberQuadraturePoints,0.0);
+	    d_nonLocalPSP_gradZetalmDeltaVl[count].resize(numberElementsInAtomCompactSupport*numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM,0.0);
+
+	    perKPointStorageBytes+=numberElementsInAtomCompactSupport*numberPseudoWaveFunctions
+		                   *numberQuadraturePoints*(1+C_DIM)*sizeof(double);
 #endif
       }
 
@@ -120,101 +133,84 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoOVDataForce()
 	  //
 	  //
 	  d_cellIdToNonlocalAtomIdsLocalCompactSupportMap[cell->id()].insert(count);
+	  d_nonLocalPSP_cellIdToCellInSupportIdMap[count][cell->id()]=iElemComp;
 
 	  //compute values for the current elements
 	  fe_values.reinit(cell);
 
-	  int iPsp = -1;
-	  int lTemp = 1e5;
-
-	  for(unsigned int iPseudoWave = 0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
-	    {
 #ifdef USE_COMPLEX
-	      d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*2);
-	      d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*C_DIM*2);
-	      d_nonLocalPSP_gradZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*C_DIM*2);
-              d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[count][iPseudoWave][cell->id()]=std::vector<double>(numkPoints*numberQuadraturePoints*C_DIM*C_DIM*2);
-#else
-	      d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=std::vector<double>(numberQuadraturePoints);
-	      d_nonLocalPSP_gradZetalmDeltaVl[count][iPseudoWave][cell->id()]=std::vector<double>(numberQuadraturePoints*C_DIM);
+	  for(unsigned int iQuadPoint = 0; iQuadPoint < numberQuadraturePoints; ++iQuadPoint)
+	     for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+		d_nonLocalPSP_cellQuadPoints[count][(iElemComp*numberQuadraturePoints+iQuadPoint)*C_DIM+iDim]
+		    =fe_values.quadrature_point(iQuadPoint)[iDim];
+
+	  d_nonLocalPSP_cellImageStartIds[count][iElemComp+1]=d_nonLocalPSP_cellImageStartIds[count][iElemComp];
 #endif
 
-	      waveFunctionId = iPseudoWave + cumulativeWaveSplineId;
-	      const int globalWaveSplineId = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][0];
-	      const int lQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][1];
-	      const int mQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][2];
+	  for(unsigned int iImageAtomCount = 0; iImageAtomCount < imageIdsList.size(); ++iImageAtomCount)
+	    {
 
-	      //
-	      //access pseudoPotential Ids
-	      //
-	      if(lQuantumNumber != lTemp)
-		iPsp += 1;
-	      lTemp = lQuantumNumber;
+	      int chargeId = imageIdsList[iImageAtomCount];
+
+	      Point<3> chargePoint(0.0,0.0,0.0);
+
+	      if(chargeId < numberGlobalCharges)
+		{
+		  chargePoint[0] = dftPtr->atomLocations[chargeId][2];
+		  chargePoint[1] = dftPtr->atomLocations[chargeId][3];
+		  chargePoint[2] = dftPtr->atomLocations[chargeId][4];
+		}
+	      else
+		{
+		  chargePoint[0] = dftPtr->d_imagePositionsTrunc[chargeId-numberGlobalCharges][0];
+		  chargePoint[1] = dftPtr->d_imagePositionsTrunc[chargeId-numberGlobalCharges][1];
+		  chargePoint[2] = dftPtr->d_imagePositionsTrunc[chargeId-numberGlobalCharges][2];
+		}
 
 #ifdef USE_COMPLEX
-	      std::vector<double>  ZetalmDeltaVl_KPoint(numkPoints*numberQuadraturePoints*2,0.0);
-	      std::vector<double> gradZetalmDeltaVl_KPoint(numkPoints*numberQuadraturePoints*C_DIM*2,0.0);
-	      std::vector<double> gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint(numkPoints*numberQuadraturePoints*C_DIM*2,0.0);
-	      std::vector<double> gradZetalmDeltaVlDyadicDistImageAtoms_KPoint(numkPoints*numberQuadraturePoints*C_DIM*C_DIM*2,0.0);
+	      //
+	      //real space contribution of the current image atom. The k point phase factors are applied
+	      //on the fly in computeNonLocalPSPQuadDataKPoint
+	      //
+	      std::vector<double> ZetalmDeltaVl(numberPseudoWaveFunctions*numberQuadraturePoints,0.0);
+	      std::vector<double> gradZetalmDeltaVl(numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM,0.0);
+	      bool isImageContributing=false;
+	      double * ZetalmDeltaVlPtr=&ZetalmDeltaVl[0];
+	      double * gradZetalmDeltaVlPtr=&gradZetalmDeltaVl[0];
 #else
-	      std::vector<double> ZetalmDeltaVl(numberQuadraturePoints,0.0);
-	      std::vector<double> gradZetalmDeltaVl(numberQuadraturePoints*C_DIM,0.0);
+	      double * ZetalmDeltaVlPtr=&d_nonLocalPSP_ZetalmDeltaVl[count][iElemComp*numberPseudoWaveFunctions*numberQuadraturePoints];
+	      double * gradZetalmDeltaVlPtr=&d_nonLocalPSP_gradZetalmDeltaVl[count][iElemComp*numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM];
 #endif
 
-	      double nlpValue = 0.0;
-	      for(unsigned int iQuadPoint = 0; iQuadPoint < numberQuadraturePoints; ++iQuadPoint)
+	      for(unsigned int iPseudoWave = 0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
 		{
+		  waveFunctionId = iPseudoWave + cumulativeWaveSplineId;
+		  const int globalWaveSplineId = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][0];
+		  const int lQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][1];
+		  const int mQuantumNumber = dftPtr->d_pseudoWaveFunctionIdToFunctionIdDetails[waveFunctionId][2];
 
-		  Point<3> quadPoint=fe_values.quadrature_point(iQuadPoint);
-
-		  for(unsigned int iImageAtomCount = 0; iImageAtomCount < imageIdsList.size(); ++iImageAtomCount)
+		  for(unsigned int iQuadPoint = 0; iQuadPoint < numberQuadraturePoints; ++iQuadPoint)
 		    {
 
-		      int chargeId = imageIdsList[iImageAtomCount];
-
-		      Point<3> chargePoint(0.0,0.0,0.0);
-
-		      if(chargeId < numberGlobalCharges)
-			{
-			  chargePoint[0] = dftPtr->atomLocations[chargeId][2];
-			  chargePoint[1] = dftPtr->atomLocations[chargeId][3];
-			  chargePoint[2] = dftPtr->atomLocations[chargeId][4];
-			}
-		      else
-			{
-			  chargePoint[0] = dftPtr->d_imagePositionsTrunc[chargeId-numberGlobalCharges][0];
-			  chargePoint[1] = dftPtr->d_imagePositionsTrunc[chargeId-numberGlobalCharges][1];
-			  chargePoint[2] = dftPtr->d_imagePositionsTrunc[chargeId-numberGlobalCharges][2];
-			}
-
+		      Point<3> quadPoint=fe_values.quadrature_point(iQuadPoint);
 
-
-		      double x[3],qMinusLr[3];
+		      double x[3];
 
 		      x[0] = quadPoint[0] - chargePoint[0];
 		      x[1] = quadPoint[1] - chargePoint[1];
 		      x[2] = quadPoint[2] - chargePoint[2];
-		      qMinusLr[0] =x[0] +nuclearCoordinates[0];
-		      qMinusLr[1] =x[1] +nuclearCoordinates[1];
-		      qMinusLr[2] =x[2] +nuclearCoordinates[2];
-
-		      //
-		      // get the spherical coordinates from cartesian
-		      //
-		      //double r,theta,phi;
-		      //pseudoForceUtils::convertCartesianToSpherical(x,r,theta,phi);
 
 		      double radialProjVal, sphericalHarmonicVal, projectorFunctionValue;
-	              std::vector<double> projectorFunctionDerivatives(3,0.0);
-		      if(std::sqrt(x[0]*x[0]+x[1]*x[1]+x[2]*x[2]) <=dftPtr->d_outerMostPointPseudoProjectorData[globalWaveSplineId]) //dftPtr->d_pspTail)//d_outerMostPointPseudoWaveFunctionsData[globalWaveSplineId])
+		      std::vector<double> projectorFunctionDerivatives(3,0.0);
+		      if(std::sqrt(x[0]*x[0]+x[1]*x[1]+x[2]*x[2]) <=dftPtr->d_outerMostPointPseudoProjectorData[globalWaveSplineId])
 			{
-                          double r,theta,phi;
-		          pseudoForceUtils::convertCartesianToSpherical(x,r,theta,phi);
+			  double r,theta,phi;
+			  pseudoForceUtils::convertCartesianToSpherical(x,r,theta,phi);
 
 
 			  pseudoForceUtils::getRadialFunctionVal(r,
-					                         radialProjVal,
-					                         &dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
+								 radialProjVal,
+								 &dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
 
 			  pseudoForceUtils::getSphericalHarmonicVal(theta,phi,lQuantumNumber,mQuantumNumber,sphericalHarmonicVal);
 
@@ -223,67 +219,42 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoOVDataForce()
 
 
 			  pseudoForceUtils::getPseudoWaveFunctionDerivatives(r,
-							                     theta,
-							                     phi,
-							                     lQuantumNumber,
-							                     mQuantumNumber,
-							                     projectorFunctionDerivatives,
-							                     dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
-
-			  std::vector<double> tempDer(3);
-			  for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
-			  {
-				tempDer[iDim]=projectorFunctionDerivatives[iDim];
-			  }
-#ifdef USE_COMPLEX
-                          for (unsigned int ik=0; ik < numkPoints; ++ik)
-			  {
-
-			     const double kDotqMinusLr= dftPtr->d_kPointCoordinates[ik*C_DIM+0]*qMinusLr[0]+ dftPtr->d_kPointCoordinates[ik*C_DIM+1]*qMinusLr[1]+dftPtr->d_kPointCoordinates[ik*C_DIM+2]*qMinusLr[2];
-			     const double tempReal=std::cos(-kDotqMinusLr);
-			     const double tempImag=std::sin(-kDotqMinusLr);
-		             ZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*2+2*iQuadPoint+0] += tempReal*projectorFunctionValue;
-		             ZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*2+2*iQuadPoint+1] += tempImag*projectorFunctionValue;
-			     for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
-			     {
-			         gradZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+0]+= tempReal*tempDer[iDim];
-				 gradZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+1]+= tempImag*tempDer[iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+0]+= tempReal*tempDer[iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+1]+= tempImag*tempDer[iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+0]+= tempImag*projectorFunctionValue*dftPtr->d_kPointCoordinates[ik*C_DIM+iDim];
-			         gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[ik*numberQuadraturePoints*C_DIM*2+iQuadPoint*C_DIM*2+iDim*2+1]-= tempReal*projectorFunctionValue*dftPtr->d_kPointCoordinates[ik*C_DIM+iDim];
-				 for(unsigned int jDim=0; jDim < C_DIM; ++jDim)
-				 {
-				     gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[ik*numberQuadraturePoints*C_DIM*C_DIM*2+iQuadPoint*C_DIM*C_DIM*2+iDim*C_DIM*2+jDim*2+0]+= tempReal*tempDer[iDim]*x[jDim];
-				     gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[ik*numberQuadraturePoints*C_DIM*C_DIM*2+iQuadPoint*C_DIM*C_DIM*2+iDim*C_DIM*2+jDim*2+1]+= tempImag*tempDer[iDim]*x[jDim];
-				 }
-			     }
-			  }
-#else
+									     theta,
+									     phi,
+									     lQuantumNumber,
+									     mQuantumNumber,
+									     projectorFunctionDerivatives,
+									     dftPtr->d_pseudoWaveFunctionSplines[globalWaveSplineId]);
 
-		          ZetalmDeltaVl[iQuadPoint] += projectorFunctionValue;
+			  ZetalmDeltaVlPtr[iPseudoWave*numberQuadraturePoints+iQuadPoint] += projectorFunctionValue;
 
 			  for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
-			      gradZetalmDeltaVl[iQuadPoint*C_DIM+iDim]+= tempDer[iDim];
-
+			      gradZetalmDeltaVlPtr[(iPseudoWave*numberQuadraturePoints+iQuadPoint)*C_DIM+iDim]+= projectorFunctionDerivatives[iDim];
+#ifdef USE_COMPLEX
+			  isImageContributing=true;
 #endif
 			}// within psp tail check
 
-		    }//image atom loop (contribution added)
+		    }//end of quad loop
+
+		}//end of iPseudoWave loop
 
-		}//end of quad loop
 #ifdef USE_COMPLEX
-	        d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=ZetalmDeltaVl_KPoint;
-		d_nonLocalPSP_gradZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=gradZetalmDeltaVl_KPoint;
-		d_nonLocalPSP_gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint[count][iPseudoWave][cell->id()]=gradZetalmDeltaVl_minusZetalmDeltaVl_KPoint;
-		d_nonLocalPSP_gradZetalmDeltaVlDyadicDistImageAtoms_KPoint[count][iPseudoWave][cell->id()]=gradZetalmDeltaVlDyadicDistImageAtoms_KPoint;
-#else
-	        d_nonLocalPSP_ZetalmDeltaVl[count][iPseudoWave][cell->id()]=ZetalmDeltaVl;
-		d_nonLocalPSP_gradZetalmDeltaVl[count][iPseudoWave][cell->id()]=gradZetalmDeltaVl;
+	      if (isImageContributing)
+		{
+		  for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+		      d_nonLocalPSP_cellImageChargePoints[count].push_back(chargePoint[iDim]);
+
+		  d_nonLocalPSP_ZetalmDeltaVl[count].insert(d_nonLocalPSP_ZetalmDeltaVl[count].end(),
+							    ZetalmDeltaVl.begin(),
+							    ZetalmDeltaVl.end());
+		  d_nonLocalPSP_gradZetalmDeltaVl[count].insert(d_nonLocalPSP_gradZetalmDeltaVl[count].end(),
+								gradZetalmDeltaVl.begin(),
+								gradZetalmDeltaVl.end());
+		  d_nonLocalPSP_cellImageStartIds[count][iElemComp+1]++;
+		}
 #endif
-
-	    }//end of iPseudoWave loop
-
+	    }//image atom loop (contribution added)
 
 	}//element loop
 
@@ -293,4 +264,111 @@ void forceClass<FEOrder>::computeElementalNonLocalPseudoOVDataForce()
 
     }//atom loop
 
+  d_isNonLocalPSPQuadDataComputed=true;
+
+  reportNonLocalPSPQuadDataMemory(perKPointStorageBytes);
+}
+
+#ifdef USE_COMPLEX
+template<unsigned int FEOrder>
+void forceClass<FEOrder>::computeNonLocalPSPQuadDataKPoint(const unsigned int nonLocalAtomId,
+							   const unsigned int cellInSupportId,
+							   const unsigned int kPointIndex,
+							   const bool computeDyadic,
+							   std::vector<double> & zetalmDeltaVl,
+							   std::vector<double> & gradZetalmDeltaVl,
+							   std::vector<double> & gradZetalmDeltaVl_minusZetalmDeltaVl,
+							   std::vector<double> & gradZetalmDeltaVlDyadicDistImageAtoms) const
+{
+  const unsigned int numberPseudoWaveFunctions=d_nonLocalPSP_numberPseudoWaveFunctions[nonLocalAtomId];
+  const std::vector<unsigned int> & cellImageStartIds=d_nonLocalPSP_cellImageStartIds[nonLocalAtomId];
+  const std::vector<double> & cellQuadPoints=d_nonLocalPSP_cellQuadPoints[nonLocalAtomId];
+  const std::vector<double> & cellImageChargePoints=d_nonLocalPSP_cellImageChargePoints[nonLocalAtomId];
+  const std::vector<double> & ZetalmDeltaVl=d_nonLocalPSP_ZetalmDeltaVl[nonLocalAtomId];
+  const std::vector<double> & gradZetalmDeltaVlRealSpace=d_nonLocalPSP_gradZetalmDeltaVl[nonLocalAtomId];
+  const unsigned int numberQuadraturePoints=cellQuadPoints.size()/((cellImageStartIds.size()-1)*C_DIM);
+
+  const double * kPointCoordinates=&dftPtr->d_kPointCoordinates[kPointIndex*C_DIM];
+  const double * nuclearCoordinates=&d_nonLocalPSP_nuclearCoordinates[nonLocalAtomId*C_DIM];
+
+  zetalmDeltaVl.assign(numberPseudoWaveFunctions*numberQuadraturePoints*2,0.0);
+  gradZetalmDeltaVl.assign(numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM*2,0.0);
+  gradZetalmDeltaVl_minusZetalmDeltaVl.assign(numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM*2,0.0);
+  if (computeDyadic)
+    gradZetalmDeltaVlDyadicDistImageAtoms.assign(numberPseudoWaveFunctions*numberQuadraturePoints*C_DIM*C_DIM*2,0.0);
+
+  for (unsigned int pairId=cellImageStartIds[cellInSupportId]; pairId<cellImageStartIds[cellInSupportId+1]; ++pairId)
+    {
+      const double * chargePoint=&cellImageChargePoints[pairId*C_DIM];
+      for(unsigned int iQuadPoint = 0; iQuadPoint < numberQuadraturePoints; ++iQuadPoint)
+	{
+	  const double * quadPoint=&cellQuadPoints[(cellInSupportId*numberQuadraturePoints+iQuadPoint)*C_DIM];
+
+	  double x[3];
+	  double kDotqMinusLr=0.0;
+	  for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+	    {
+	      x[iDim]=quadPoint[iDim]-chargePoint[iDim];
+	      kDotqMinusLr+=kPointCoordinates[iDim]*(x[iDim]+nuclearCoordinates[iDim]);
+	    }
+	  const double tempReal=std::cos(-kDotqMinusLr);
+	  const double tempImag=std::sin(-kDotqMinusLr);
+
+	  for(unsigned int iPseudoWave = 0; iPseudoWave < numberPseudoWaveFunctions; ++iPseudoWave)
+	    {
+	      const unsigned int id=iPseudoWave*numberQuadraturePoints+iQuadPoint;
+	      const unsigned int realSpaceId=(pairId*numberPseudoWaveFunctions+iPseudoWave)*numberQuadraturePoints+iQuadPoint;
+	      const double projectorFunctionValue=ZetalmDeltaVl[realSpaceId];
+	      const double * tempDer=&gradZetalmDeltaVlRealSpace[realSpaceId*C_DIM];
+
+	      zetalmDeltaVl[id*2+0]+=tempReal*projectorFunctionValue;
+	      zetalmDeltaVl[id*2+1]+=tempImag*projectorFunctionValue;
+	      for(unsigned int iDim = 0; iDim < C_DIM; ++iDim)
+		{
+		  gradZetalmDeltaVl[(id*C_DIM+iDim)*2+0]+=tempReal*tempDer[iDim];
+		  gradZetalmDeltaVl[(id*C_DIM+iDim)*2+1]+=tempImag*tempDer[iDim];
+		  gradZetalmDeltaVl_minusZetalmDeltaVl[(id*C_DIM+iDim)*2+0]+=tempReal*tempDer[iDim]
+		                                                            +tempImag*projectorFunctionValue*kPointCoordinates[iDim];
+		  gradZetalmDeltaVl_minusZetalmDeltaVl[(id*C_DIM+iDim)*2+1]+=tempImag*tempDer[iDim]
+		                                                            -tempReal*projectorFunctionValue*kPointCoordinates[iDim];
+		  if (computeDyadic)
+		    for(unsigned int jDim=0; jDim < C_DIM; ++jDim)
+		      {
+			gradZetalmDeltaVlDyadicDistImageAtoms[((id*C_DIM+iDim)*C_DIM+jDim)*2+0]+=tempReal*tempDer[iDim]*x[jDim];
+			gradZetalmDeltaVlDyadicDistImageAtoms[((id*C_DIM+iDim)*C_DIM+jDim)*2+1]+=tempImag*tempDer[iDim]*x[jDim];
+		      }
+		}
+	    }
+	}
+    }
+}
+#endif
+
+template<unsigned int FEOrder>
+void forceClass<FEOrder>::reportNonLocalPSPQuadDataMemory(const double perKPointStorageBytes)
+{
+  double compactStorageBytes=0.0;
+  for (unsigned int i=0; i<d_nonLocalPSP_ZetalmDeltaVl.size(); ++i)
+    {
+      compactStorageBytes+=(d_nonLocalPSP_ZetalmDeltaVl[i].size()+d_nonLocalPSP_gradZetalmDeltaVl[i].size())*sizeof(double);
+#ifdef USE_COMPLEX
+      compactStorageBytes+=(d_nonLocalPSP_cellQuadPoints[i].size()+d_nonLocalPSP_cellImageChargePoints[i].size())*sizeof(double)
+	                   +d_nonLocalPSP_cellImageStartIds[i].size()*sizeof(unsigned int);
+#endif
+    }
+
+  performanceTelemetry::addAllocatedBytes("nonlocal psp force data",
+					  compactStorageBytes,
+					  std::max(perKPointStorageBytes-compactStorageBytes,0.0));
+  memoryLedger::setBytes(memoryLedger::forceTables,
+			 "nonlocal pseudopotential quadrature data",
+			 compactStorageBytes);
+
+  if (dftParameters::verbosity>=2)
+    {
+      const double compactStorageBytesTotal=Utilities::MPI::sum(compactStorageBytes,mpi_communicator);
+      const double perKPointStorageBytesTotal=Utilities::MPI::sum(perKPointStorageBytes,mpi_communicator);
+      pcout<<"Nonlocal pseudopotential force data: "<<compactStorageBytesTotal/1.0e+6
+	   <<" MB (per k point quadrature storage would require "<<perKPointStorageBytesTotal/1.0e+6<<" MB)"<<std::endl;
+    }
 }
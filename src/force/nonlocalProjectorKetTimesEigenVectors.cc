@@ -26,17 +26,14 @@ void forceClass<FEOrder>::computeNonLocalProjectorKetTimesPsiTimesVFlattened
 			    const std::vector<double> & partialOccupancies)
 {
 
-  vectorTools::createDealiiVector<dataTypes::number>(dftPtr->d_projectorKetTimesVectorPar[0].get_partitioner(),
-                                                     numberWaveFunctions,
-                                                     dftPtr->d_projectorKetTimesVectorParFlattened);
-
-  std::vector<std::vector<dealii::types::global_dof_index> > flattenedArrayMacroCellLocalProcIndexIdMap;
-  std::vector<std::vector<dealii::types::global_dof_index> > flattenedArrayCellLocalProcIndexIdMap;
-  vectorTools::computeCellLocalIndexSetMap(src.get_partitioner(),
-					   dftPtr->matrix_free_data,
-					   numberWaveFunctions,
-					   flattenedArrayMacroCellLocalProcIndexIdMap,
-					   flattenedArrayCellLocalProcIndexIdMap);
+  dftPtr->d_projectorKetTimesVectorParFlattened.reinit
+    (dftPtr->d_flattenedArrayRegistry.getFlattenedPartitioner(dftPtr->d_projectorKetTimesVectorPar[0].get_partitioner(),
+							       numberWaveFunctions));
+
+  const std::shared_ptr<const vectorTools::flattenedArrayRegistry::flattenedArrayData> flattenedArrayData
+    =dftPtr->d_flattenedArrayRegistry.getFlattenedArrayData(dftPtr->matrix_free_data,
+							    numberWaveFunctions);
+  const std::vector<unsigned int> & flattenedArrayCellLocalProcIndexIdMap=flattenedArrayData->cellLocalProcIndexIdMap;
 
 #ifdef USE_COMPLEX
   const unsigned int numberNodesPerElement = dftPtr->FEEigen.dofs_per_cell/2;
@@ -76,7 +73,7 @@ void forceClass<FEOrder>::computeNonLocalProjectorKetTimesPsiTimesVFlattened
 	  {
 	    for(unsigned int iNode = 0; iNode <numberNodesPerElement; ++iNode)
 	    {
-	      dealii::types::global_dof_index localNodeId = flattenedArrayCellLocalProcIndexIdMap[iElem][iNode];
+	      const unsigned int localNodeId = flattenedArrayCellLocalProcIndexIdMap[iElem*numberNodesPerElement+iNode];
 #ifdef USE_COMPLEX
 	      zcopy_(&numberWaveFunctions,
 		     src.begin()+localNodeId,
@@ -110,7 +107,7 @@ void forceClass<FEOrder>::computeNonLocalProjectorKetTimesPsiTimesVFlattened
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][kPointIndex][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,kPointIndex),
 		     &numberNodesPerElement,
 		     &cellWaveFunctionMatrix[0],
 		     &numberWaveFunctions,
@@ -126,7 +123,7 @@ void forceClass<FEOrder>::computeNonLocalProjectorKetTimesPsiTimesVFlattened
 		     &numberWaveFunctions,
 		     &numberNodesPerElement,
 		     &alpha,
-		     &dftPtr->d_nonLocalProjectorElementMatrices[atomId][nonZeroElementMatrixId][0],
+		     dftPtr->getNonLocalProjectorElementMatrix(atomId,nonZeroElementMatrixId,0),
 		     &numberNodesPerElement,
 		     &cellWaveFunctionMatrix[0],
 		     &numberWaveFunctions,
@@ -311,8 +311,20 @@ void geoOptCell<FEOrder>::precondition(std::vector<double>       & s,
 template<unsigned int FEOrder>
 void geoOptCell<FEOrder>::update(const std::vector<double> & solution, const bool computeForces)
 {
+   updateStrain(solution);
 
+   dftPtr->solve(computeForces);
+   // if ion optimization is on, then for every cell relaxation also relax the atomic forces
+   if (dftParameters::isIonOpt)
+   {
+      dftPtr->geoOptIonPtr->init();
+      dftPtr->geoOptIonPtr->run();
+   }
+}
 
+template<unsigned int FEOrder>
+void geoOptCell<FEOrder>::updateStrain(const std::vector<double> & solution)
+{
    std::vector<double> bcastSolution(solution.size());
    for (unsigned int i=0; i< solution.size(); ++i)
    {
@@ -378,14 +390,6 @@ void geoOptCell<FEOrder>::update(const std::vector<double> & solution, const boo
    //deform fem mesh and reinit
    d_totalUpdateCalls+=1;
    dftPtr->deformDomain(deformationGradient);
-
-   dftPtr->solve(computeForces);
-   // if ion optimization is on, then for every cell relaxation also relax the atomic forces
-   if (dftParameters::isIonOpt)
-   {
-      dftPtr->geoOptIonPtr->init();
-      dftPtr->geoOptIonPtr->run();
-   }
 }
 
 template<unsigned int FEOrder>
@@ -397,7 +401,20 @@ void geoOptCell<FEOrder>::save()
 template<unsigned int FEOrder>
 void geoOptCell<FEOrder>::solution(std::vector<double> & solution)
 {
-   AssertThrow(false,dftUtils::ExcNotImplementedYet());
+   //strain components relative to the unstrained domain, in the same order as the update
+   solution.clear();
+   if (d_relaxationFlags[0]==1)
+     solution.push_back(d_strainEpsilon[0][0]-1.0);
+   if (d_relaxationFlags[1]==1)
+     solution.push_back(d_strainEpsilon[0][1]);
+   if (d_relaxationFlags[2]==1)
+     solution.push_back(d_strainEpsilon[0][2]);
+   if (d_relaxationFlags[3]==1)
+     solution.push_back(d_strainEpsilon[1][1]-1.0);
+   if (d_relaxationFlags[4]==1)
+     solution.push_back(d_strainEpsilon[1][2]);
+   if (d_relaxationFlags[5]==1)
+     solution.push_back(d_strainEpsilon[2][2]-1.0);
 }
 
 template<unsigned int FEOrder>
@@ -278,6 +278,25 @@ namespace dftfe {
 
   template<unsigned int FEOrder>
   void geoOptIon<FEOrder>::update(const std::vector<double> & solution, const bool computeForces)
+  {
+    updateAtomPositions(solution);
+
+    /*if(d_maximumAtomForceToBeRelaxed >= 1e-02)
+      dftParameters::selfConsistentSolverTolerance = 1e-03;
+    else if(d_maximumAtomForceToBeRelaxed >= 1e-03)
+      dftParameters::selfConsistentSolverTolerance = 1e-04;
+    else if(d_maximumAtomForceToBeRelaxed >= 1e-04)
+      dftParameters::selfConsistentSolverTolerance = 1e-05;
+    else if(d_maximumAtomForceToBeRelaxed >= 1e-05)
+      dftParameters::selfConsistentSolverTolerance = 5e-06;*/
+
+
+    dftPtr->solve(computeForces);
+
+  }
+
+  template<unsigned int FEOrder>
+  void geoOptIon<FEOrder>::updateAtomPositions(const std::vector<double> & solution)
   {
     const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
     std::vector<Tensor<1,3,double> > globalAtomsDisplacements(numberGlobalAtoms);
@@ -308,20 +327,6 @@ namespace dftfe {
       pcout<< "  Maximum force component to be relaxed: "<<  d_maximumAtomForceToBeRelaxed <<std::endl;
     dftPtr->updateAtomPositionsAndMoveMesh(globalAtomsDisplacements,d_maximumAtomForceToBeRelaxed);
     d_totalUpdateCalls+=1;
-
-
-    /*if(d_maximumAtomForceToBeRelaxed >= 1e-02)
-      dftParameters::selfConsistentSolverTolerance = 1e-03;
-    else if(d_maximumAtomForceToBeRelaxed >= 1e-03)
-      dftParameters::selfConsistentSolverTolerance = 1e-04;
-    else if(d_maximumAtomForceToBeRelaxed >= 1e-04)
-      dftParameters::selfConsistentSolverTolerance = 1e-05;
-    else if(d_maximumAtomForceToBeRelaxed >= 1e-05)
-      dftParameters::selfConsistentSolverTolerance = 5e-06;*/
-
-
-    dftPtr->solve(computeForces);
-
   }
 
   template<unsigned int FEOrder>
@@ -348,6 +353,12 @@ namespace dftfe {
        }
   }
 
+  template<unsigned int FEOrder>
+  const std::vector<unsigned int> & geoOptIon<FEOrder>::getRelaxationFlags() const
+  {
+    return d_relaxationFlags;
+  }
+
   template<unsigned int FEOrder>
   std::vector<unsigned int>  geoOptIon<FEOrder>::getUnknownCountFlag() const
   {
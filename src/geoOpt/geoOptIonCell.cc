@@ -0,0 +1,264 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <geoOptIonCell.h>
+#include <lbfgsNonLinearSolver.h>
+#include <force.h>
+#include <dft.h>
+#include <geoOptIon.h>
+#include <geoOptCell.h>
+#include <dftParameters.h>
+#include <dftUtils.h>
+
+namespace dftfe {
+
+  namespace internalGeoOptIonCell
+  {
+    // estimate of the bulk modulus (in Hartree/Bohr^3, approximately 100 GPa) used to
+    // scale the strain unknowns relative to the atomic displacement unknowns in the preconditioner
+    const double bulkModulusEstimate=3.4e-3;
+  }
+
+  //
+  //constructor
+  //
+  template<unsigned int FEOrder>
+  geoOptIonCell<FEOrder>::geoOptIonCell(dftClass<FEOrder>* _dftPtr,const MPI_Comm &mpi_comm_replica):
+    dftPtr(_dftPtr),
+    mpi_communicator (mpi_comm_replica),
+    n_mpi_processes (Utilities::MPI::n_mpi_processes(mpi_comm_replica)),
+    this_mpi_process (Utilities::MPI::this_mpi_process(mpi_comm_replica)),
+    pcout(std::cout, (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0 && !dftParameters::reproducible_output))
+  {
+
+  }
+
+  //
+  //
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::init()
+  {
+    dftPtr->geoOptIonPtr->init();
+    dftPtr->geoOptCellPtr->init();
+
+    d_numberIonUnknowns=dftPtr->geoOptIonPtr->getNumberUnknowns();
+    d_numberCellUnknowns=dftPtr->geoOptCellPtr->getNumberUnknowns();
+
+    // The gradient with respect to the strain is stress*volume. Scaling the strain unknowns by
+    // volume*STRESS TOL/FORCE TOL makes FORCE TOL on the scaled gradient equivalent to STRESS TOL on the stress.
+    d_strainScaling=dftPtr->d_domainVolume*dftParameters::stressRelaxTol/dftParameters::forceRelaxTol;
+
+    // energy Hessian with respect to the scaled strain is approximately volume*bulkModulus/d_strainScaling^2,
+    // while the atomic displacement unknowns are preconditioned with unit stiffness (Hartree/Bohr^2)
+    d_cellPreconditionerFactor=d_strainScaling*d_strainScaling
+                               /(dftPtr->d_domainVolume*internalGeoOptIonCell::bulkModulusEstimate);
+
+    if (dftParameters::verbosity>=2)
+    {
+      pcout<<" --------------Ion cell relaxation------------------"<<std::endl;
+      pcout<<" Number of atomic displacement unknowns: "<<d_numberIonUnknowns<<std::endl;
+      pcout<<" Number of strain unknowns: "<<d_numberCellUnknowns<<std::endl;
+      pcout<<" Strain scaling length: "<<d_strainScaling<<std::endl;
+      pcout<<" --------------------------------------------------"<<std::endl;
+    }
+  }
+
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::run()
+  {
+    const double tol=dftParameters::forceRelaxTol;
+    const unsigned int  maxIter=100;
+    const unsigned int maxNumPastSteps=20;
+    const double maxUpdate=0.5;//Bohr
+    const unsigned int debugLevel=Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) ==0?dftParameters::verbosity:0;
+
+    d_totalUpdateCalls=0;
+    lbfgsNonLinearSolver lbfgsSolver(true,
+				     maxUpdate,
+				     maxIter,
+				     maxNumPastSteps,
+				     debugLevel,
+				     tol,
+				     mpi_communicator);
+
+    if (dftParameters::chkType>=1 && dftParameters::restartFromChk)
+      pcout<<" Re starting simultaneous Ion force and Cell stress relaxation using LBFGS solver... "<<std::endl;
+    else
+      pcout<<" Starting simultaneous Ion force and Cell stress relaxation using LBFGS solver... "<<std::endl;
+    if (dftParameters::verbosity>=2)
+      {
+	pcout<<"   ---LBFGS Parameters--------------  "<<std::endl;
+	pcout<<"      stopping tol: "<< tol<<std::endl;
+	pcout<<"      maxIter: "<< maxIter<<std::endl;
+	pcout<<"      history size: "<< maxNumPastSteps<<std::endl;
+	pcout<<"      max update: "<< maxUpdate<<std::endl;
+	pcout<<"   ------------------------------  "<<std::endl;
+      }
+
+    if (getNumberUnknowns()>0)
+      {
+	nonLinearSolver::ReturnValueType lbfgsReturn=nonLinearSolver::FAILURE;
+
+	if (dftParameters::chkType>=1 && dftParameters::restartFromChk)
+	  lbfgsReturn=lbfgsSolver.solve(*this,std::string("ionCellRelaxLBFGS.chk"),true);
+	else if (dftParameters::chkType>=1 && !dftParameters::restartFromChk)
+	  lbfgsReturn=lbfgsSolver.solve(*this,std::string("ionCellRelaxLBFGS.chk"));
+	else
+	  lbfgsReturn=lbfgsSolver.solve(*this);
+
+	if (lbfgsReturn == nonLinearSolver::SUCCESS )
+	  {
+	    pcout<< " ...Ion force and Cell stress relaxation completed as maximum force magnitude is less than FORCE TOL: "<< dftParameters::forceRelaxTol<<" and maximum stress magnitude is less than STRESS TOL: "<< dftParameters::stressRelaxTol<<", total number of geometry updates: "<<d_totalUpdateCalls<<std::endl;
+
+	    pcout<<"-------------------------------Final Relaxed structure-----------------------------"<<std::endl;
+	    pcout<<"-----------------------------------------------------------------------------------"<<std::endl;
+	    pcout<<"-----------Simulation Domain bounding vectors (lattice vectors in fully periodic case)-------------"<<std::endl;
+	    for(int i = 0; i < dftPtr->d_domainBoundingVectors.size(); ++i)
+	      {
+		pcout<<"v"<< i+1<<" : "<< dftPtr->d_domainBoundingVectors[i][0]<<" "<<dftPtr->d_domainBoundingVectors[i][1]<<" "<<dftPtr->d_domainBoundingVectors[i][2]<<std::endl;
+	      }
+	    pcout<<"-----------------------------------------------------------------------------------------"<<std::endl;
+
+	    if (dftParameters::periodicX || dftParameters::periodicY || dftParameters::periodicZ)
+	      {
+		pcout<<"------------------Fractional coordinates of atoms--------------------"<<std::endl;
+		for(unsigned int i = 0; i < dftPtr->atomLocations.size(); ++i)
+		    pcout<<"AtomId "<<i <<":  "<<dftPtr->atomLocationsFractional[i][2]<<" "<<dftPtr->atomLocationsFractional[i][3]<<" "<<dftPtr->atomLocationsFractional[i][4]<<"\n";
+		pcout<<"-----------------------------------------------------------------------------------------"<<std::endl;
+	      }
+	    else
+	      {
+		//
+		//print cartesian coordinates
+		//
+		pcout<<"------------Cartesian coordinates of atoms (origin at center of domain)------------------"<<std::endl;
+		for(unsigned int i = 0; i < dftPtr->atomLocations.size(); ++i)
+		  {
+		    pcout<<"AtomId "<<i <<":  "<<dftPtr->atomLocations[i][2]<<" "<<dftPtr->atomLocations[i][3]<<" "<<dftPtr->atomLocations[i][4]<<"\n";
+		  }
+		pcout<<"-----------------------------------------------------------------------------------------"<<std::endl;
+	      }
+	    pcout<<"-----------------------------------------------------------------------------------"<<std::endl;
+	  }
+	else if (lbfgsReturn == nonLinearSolver::MAX_ITER_REACHED)
+	  {
+	    pcout<< " ...Maximum iterations reached "<<std::endl;
+
+	  }
+	else if(lbfgsReturn == nonLinearSolver::FAILURE)
+	  {
+	    pcout<< " ...Ion force and Cell stress relaxation failed "<<std::endl;
+
+	  }
+      }
+  }
+
+
+  template<unsigned int FEOrder>
+  unsigned int geoOptIonCell<FEOrder>::getNumberUnknowns() const
+  {
+    return d_numberIonUnknowns+d_numberCellUnknowns;
+  }
+
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::value(std::vector<double> & functionValue)
+  {
+    functionValue.clear();
+    functionValue.push_back(dftPtr->d_groundStateEnergy-dftPtr->d_groundStateEnergyInitial);
+  }
+
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::gradient(std::vector<double> & gradient)
+  {
+    std::vector<double> cellGradient;
+    dftPtr->geoOptIonPtr->gradient(gradient);
+    dftPtr->geoOptCellPtr->gradient(cellGradient);
+
+    AssertThrow(gradient.size()==d_numberIonUnknowns && cellGradient.size()==d_numberCellUnknowns,
+		ExcMessage("DFT-FE Error: size of ion cell relaxation gradient doesn't match with the number of unknowns."));
+
+    for (unsigned int i=0; i<cellGradient.size(); ++i)
+      gradient.push_back(cellGradient[i]/d_strainScaling);
+  }
+
+
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::precondition(std::vector<double>       & s,
+					    const std::vector<double> & gradient) const
+  {
+    s.resize(gradient.size());
+    for (unsigned int i=0; i<d_numberIonUnknowns; ++i)
+      s[i]=-gradient[i];
+
+    for (unsigned int i=d_numberIonUnknowns; i<gradient.size(); ++i)
+      s[i]=-gradient[i]*d_cellPreconditionerFactor;
+  }
+
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::update(const std::vector<double> & solution, const bool computeForces)
+  {
+    const std::vector<double> ionSolution(solution.begin(),solution.begin()+d_numberIonUnknowns);
+    std::vector<double> cellSolution(solution.begin()+d_numberIonUnknowns,solution.end());
+    for (unsigned int i=0; i<cellSolution.size(); ++i)
+      cellSolution[i]/=d_strainScaling;
+
+    if (d_numberIonUnknowns>0)
+      dftPtr->geoOptIonPtr->updateAtomPositions(ionSolution);
+
+    if (d_numberCellUnknowns>0)
+      dftPtr->geoOptCellPtr->updateStrain(cellSolution);
+
+    d_totalUpdateCalls+=1;
+    dftPtr->solve(computeForces);
+  }
+
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::save()
+  {
+    dftPtr->writeDomainAndAtomCoordinates();
+  }
+
+  template<unsigned int FEOrder>
+  void geoOptIonCell<FEOrder>::solution(std::vector<double> & solution)
+  {
+    std::vector<double> cellSolution;
+    dftPtr->geoOptIonPtr->solution(solution);
+    dftPtr->geoOptCellPtr->solution(cellSolution);
+
+    for (unsigned int i=0; i<cellSolution.size(); ++i)
+      solution.push_back(cellSolution[i]*d_strainScaling);
+  }
+
+  template<unsigned int FEOrder>
+  std::vector<unsigned int>  geoOptIonCell<FEOrder>::getUnknownCountFlag() const
+  {
+    //the unknowns are replicated on all processors
+    return std::vector<unsigned int>(d_numberIonUnknowns+d_numberCellUnknowns,1);
+  }
+
+
+  template class geoOptIonCell<1>;
+  template class geoOptIonCell<2>;
+  template class geoOptIonCell<3>;
+  template class geoOptIonCell<4>;
+  template class geoOptIonCell<5>;
+  template class geoOptIonCell<6>;
+  template class geoOptIonCell<7>;
+  template class geoOptIonCell<8>;
+  template class geoOptIonCell<9>;
+  template class geoOptIonCell<10>;
+  template class geoOptIonCell<11>;
+  template class geoOptIonCell<12>;
+}
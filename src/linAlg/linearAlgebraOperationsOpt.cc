@@ -26,6 +26,7 @@
 #include <linearAlgebraOperationsInternal.h>
 #include <dftParameters.h>
 #include <dftUtils.h>
+#include <memoryLedger.h>
 #ifdef DFTFE_WITH_ELPA
 extern "C"
 {
@@ -467,6 +468,18 @@ namespace dftfe{
     }
 
 
+#ifdef DEAL_II_WITH_SCALAPACK
+    //
+    //bytes of the block of a ScaLAPACK matrix owned by the current processor
+    //
+    template<typename T>
+    double getLocalBytes(const std::shared_ptr< const dealii::Utilities::MPI::ProcessGrid> & processGrid,
+			 const dealii::ScaLAPACKMatrix<T> & mat)
+    {
+      return processGrid->is_process_active()?(double)mat.local_m()*mat.local_n()*sizeof(T):0.0;
+    }
+#endif
+
 #if(defined DEAL_II_WITH_SCALAPACK && !USE_COMPLEX)
     template<typename T>
     void rayleighRitzGEP(operatorDFTClass & operatorMatrix,
@@ -497,6 +510,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> overlapMatPar(numberWaveFunctions,
                                                processGrid,
                                                rowsBlockSize);
+      const memoryLedger::Allocation overlapMatParAllocation(memoryLedger::scalapackBuffers,
+                                                             getLocalBytes(processGrid,overlapMatPar));
 
       if (processGrid->is_process_active())
          std::fill(&overlapMatPar.local_el(0,0),
@@ -543,6 +558,8 @@ namespace dftfe{
 	  dealii::ScaLAPACKMatrix<T> overlapMatParTrans(numberWaveFunctions,
 						processGrid,
 						rowsBlockSize);
+	  const memoryLedger::Allocation overlapMatParTransAllocation(memoryLedger::scalapackBuffers,
+	                                                              getLocalBytes(processGrid,overlapMatParTrans));
 
           if (processGrid->is_process_active())
 	      std::fill(&overlapMatParTrans.local_el(0,0),
@@ -581,6 +598,8 @@ namespace dftfe{
                                          processGrid,
                                          rowsBlockSize,
 					 overlapMatPropertyPostCholesky);
+      const memoryLedger::Allocation LMatParAllocation(memoryLedger::scalapackBuffers,
+                                                       getLocalBytes(processGrid,LMatPar));
 
       //copy triangular part of projHamPar into LMatPar
       if (processGrid->is_process_active())
@@ -639,6 +658,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamPar(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+      const memoryLedger::Allocation projHamParAllocation(memoryLedger::scalapackBuffers,
+                                                          getLocalBytes(processGrid,projHamPar));
       if (processGrid->is_process_active())
 	  std::fill(&projHamPar.local_el(0,0),
 		    &projHamPar.local_el(0,0)+projHamPar.local_m()*projHamPar.local_n(),
@@ -656,6 +677,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamParTrans(numberWaveFunctions,
 					    processGrid,
 					    rowsBlockSize);
+      const memoryLedger::Allocation projHamParTransAllocation(memoryLedger::scalapackBuffers,
+                                                               getLocalBytes(processGrid,projHamParTrans));
 
       if (processGrid->is_process_active())
 	  std::fill(&projHamParTrans.local_el(0,0),
@@ -681,6 +704,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamParCopy(numberWaveFunctions,
 					    processGrid,
 					    rowsBlockSize);
+      const memoryLedger::Allocation projHamParCopyAllocation(memoryLedger::scalapackBuffers,
+                                                              getLocalBytes(processGrid,projHamParCopy));
 
       if (overlapMatPropertyPostCholesky==dealii::LAPACKSupport::Property::lower_triangular)
       {
@@ -705,6 +730,8 @@ namespace dftfe{
           dealii::ScaLAPACKMatrix<T> eigenVectors(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+          const memoryLedger::Allocation eigenVectorsAllocation(memoryLedger::scalapackBuffers,
+                                                                getLocalBytes(processGrid,eigenVectors));
 
 	  if (processGrid->is_process_active())
 	      std::fill(&eigenVectors.local_el(0,0),
@@ -848,6 +875,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> overlapMatPar(numberWaveFunctions,
                                                processGrid,
                                                rowsBlockSize);
+      const memoryLedger::Allocation overlapMatParAllocation(memoryLedger::scalapackBuffers,
+                                                             getLocalBytes(processGrid,overlapMatPar));
 
       if (processGrid->is_process_active())
          std::fill(&overlapMatPar.local_el(0,0),
@@ -877,6 +906,8 @@ namespace dftfe{
 	  dealii::ScaLAPACKMatrix<T> overlapMatParTrans(numberWaveFunctions,
 						processGrid,
 						rowsBlockSize);
+	  const memoryLedger::Allocation overlapMatParTransAllocation(memoryLedger::scalapackBuffers,
+	                                                              getLocalBytes(processGrid,overlapMatParTrans));
 
           if (processGrid->is_process_active())
 	      std::fill(&overlapMatParTrans.local_el(0,0),
@@ -915,6 +946,8 @@ namespace dftfe{
                                          processGrid,
                                          rowsBlockSize,
 					 overlapMatPropertyPostCholesky);
+      const memoryLedger::Allocation LMatParAllocation(memoryLedger::scalapackBuffers,
+                                                       getLocalBytes(processGrid,LMatPar));
 
       //copy triangular part of projHamPar into LMatPar
       if (processGrid->is_process_active())
@@ -973,6 +1006,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamPar(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+      const memoryLedger::Allocation projHamParAllocation(memoryLedger::scalapackBuffers,
+                                                          getLocalBytes(processGrid,projHamPar));
       if (processGrid->is_process_active())
 	  std::fill(&projHamPar.local_el(0,0),
 		    &projHamPar.local_el(0,0)+projHamPar.local_m()*projHamPar.local_n(),
@@ -993,6 +1028,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamParTrans(numberWaveFunctions,
 					    processGrid,
 					    rowsBlockSize);
+      const memoryLedger::Allocation projHamParTransAllocation(memoryLedger::scalapackBuffers,
+                                                               getLocalBytes(processGrid,projHamParTrans));
 
       if (processGrid->is_process_active())
 	  std::fill(&projHamParTrans.local_el(0,0),
@@ -1018,6 +1055,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamParCopy(numberWaveFunctions,
 					    processGrid,
 					    rowsBlockSize);
+      const memoryLedger::Allocation projHamParCopyAllocation(memoryLedger::scalapackBuffers,
+                                                              getLocalBytes(processGrid,projHamParCopy));
 
       if (overlapMatPropertyPostCholesky==dealii::LAPACKSupport::Property::lower_triangular)
       {
@@ -1042,6 +1081,8 @@ namespace dftfe{
           dealii::ScaLAPACKMatrix<T> eigenVectors(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+          const memoryLedger::Allocation eigenVectorsAllocation(memoryLedger::scalapackBuffers,
+                                                                getLocalBytes(processGrid,eigenVectors));
 
 	  if (processGrid->is_process_active())
 	      std::fill(&eigenVectors.local_el(0,0),
@@ -1193,6 +1234,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamPar(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+      const memoryLedger::Allocation projHamParAllocation(memoryLedger::scalapackBuffers,
+                                                          getLocalBytes(processGrid,projHamPar));
       if (processGrid->is_process_active())
 	  std::fill(&projHamPar.local_el(0,0),
 		    &projHamPar.local_el(0,0)+projHamPar.local_m()*projHamPar.local_n(),
@@ -1217,6 +1260,8 @@ namespace dftfe{
           dealii::ScaLAPACKMatrix<T> eigenVectors(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+          const memoryLedger::Allocation eigenVectorsAllocation(memoryLedger::scalapackBuffers,
+                                                                getLocalBytes(processGrid,eigenVectors));
 
 	  if (processGrid->is_process_active())
 	      std::fill(&eigenVectors.local_el(0,0),
@@ -1228,6 +1273,8 @@ namespace dftfe{
 	  dealii::ScaLAPACKMatrix<T> projHamParTrans(numberWaveFunctions,
 						processGrid,
 						rowsBlockSize);
+	  const memoryLedger::Allocation projHamParTransAllocation(memoryLedger::scalapackBuffers,
+	                                                           getLocalBytes(processGrid,projHamParTrans));
 
           if (processGrid->is_process_active())
 	      std::fill(&projHamParTrans.local_el(0,0),
@@ -1435,6 +1482,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> overlapMatPar(numberWaveFunctions,
                                                processGrid,
                                                rowsBlockSize);
+      const memoryLedger::Allocation overlapMatParAllocation(memoryLedger::scalapackBuffers,
+                                                             getLocalBytes(processGrid,overlapMatPar));
 
       if (processGrid->is_process_active())
          std::fill(&overlapMatPar.local_el(0,0),
@@ -1481,6 +1530,8 @@ namespace dftfe{
 	  dealii::ScaLAPACKMatrix<T> overlapMatParTrans(numberWaveFunctions,
 						processGrid,
 						rowsBlockSize);
+	  const memoryLedger::Allocation overlapMatParTransAllocation(memoryLedger::scalapackBuffers,
+	                                                              getLocalBytes(processGrid,overlapMatParTrans));
 
           if (processGrid->is_process_active())
 	      std::fill(&overlapMatParTrans.local_el(0,0),
@@ -1519,6 +1570,8 @@ namespace dftfe{
                                          processGrid,
                                          rowsBlockSize,
 					 overlapMatPropertyPostCholesky);
+      const memoryLedger::Allocation LMatParAllocation(memoryLedger::scalapackBuffers,
+                                                       getLocalBytes(processGrid,LMatPar));
 
       //copy triangular part of projHamPar into LMatPar
       if (processGrid->is_process_active())
@@ -1577,6 +1630,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamPar(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+      const memoryLedger::Allocation projHamParAllocation(memoryLedger::scalapackBuffers,
+                                                          getLocalBytes(processGrid,projHamPar));
       if (processGrid->is_process_active())
 	  std::fill(&projHamPar.local_el(0,0),
 		    &projHamPar.local_el(0,0)+projHamPar.local_m()*projHamPar.local_n(),
@@ -1607,6 +1662,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamParTrans(numberWaveFunctions,
 					    processGrid,
 					    rowsBlockSize);
+      const memoryLedger::Allocation projHamParTransAllocation(memoryLedger::scalapackBuffers,
+                                                               getLocalBytes(processGrid,projHamParTrans));
 
       if (processGrid->is_process_active())
 	  std::fill(&projHamParTrans.local_el(0,0),
@@ -1639,6 +1696,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamParCopy(numberWaveFunctions,
 					    processGrid,
 					    rowsBlockSize);
+      const memoryLedger::Allocation projHamParCopyAllocation(memoryLedger::scalapackBuffers,
+                                                              getLocalBytes(processGrid,projHamParCopy));
 
       if (overlapMatPropertyPostCholesky==dealii::LAPACKSupport::Property::lower_triangular)
       {
@@ -1664,6 +1723,8 @@ namespace dftfe{
           dealii::ScaLAPACKMatrix<T> eigenVectors(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+          const memoryLedger::Allocation eigenVectorsAllocation(memoryLedger::scalapackBuffers,
+                                                                getLocalBytes(processGrid,eigenVectors));
 
 	  if (processGrid->is_process_active())
 	      std::fill(&eigenVectors.local_el(0,0),
@@ -1695,6 +1756,8 @@ namespace dftfe{
 	  dealii::ScaLAPACKMatrix<T> permutedIdentityMat(numberWaveFunctions,
 						    processGrid,
 						    rowsBlockSize);
+	  const memoryLedger::Allocation permutedIdentityMatAllocation(memoryLedger::scalapackBuffers,
+	                                                               getLocalBytes(processGrid,permutedIdentityMat));
           if (processGrid->is_process_active())
 	      std::fill(&permutedIdentityMat.local_el(0,0),
 		        &permutedIdentityMat.local_el(0,0)
@@ -1883,6 +1946,8 @@ namespace dftfe{
       dealii::ScaLAPACKMatrix<T> projHamPar(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+      const memoryLedger::Allocation projHamParAllocation(memoryLedger::scalapackBuffers,
+                                                          getLocalBytes(processGrid,projHamPar));
       if (processGrid->is_process_active())
 	  std::fill(&projHamPar.local_el(0,0),
 		    &projHamPar.local_el(0,0)+projHamPar.local_m()*projHamPar.local_n(),
@@ -1920,6 +1985,8 @@ namespace dftfe{
           dealii::ScaLAPACKMatrix<T> eigenVectors(numberWaveFunctions,
                                             processGrid,
                                             rowsBlockSize);
+          const memoryLedger::Allocation eigenVectorsAllocation(memoryLedger::scalapackBuffers,
+                                                                getLocalBytes(processGrid,eigenVectors));
 
 	  if (processGrid->is_process_active())
 	      std::fill(&eigenVectors.local_el(0,0),
@@ -1931,6 +1998,8 @@ namespace dftfe{
 	  dealii::ScaLAPACKMatrix<T> projHamParTrans(numberWaveFunctions,
 						processGrid,
 						rowsBlockSize);
+	  const memoryLedger::Allocation projHamParTransAllocation(memoryLedger::scalapackBuffers,
+	                                                           getLocalBytes(processGrid,projHamParTrans));
           if (processGrid->is_process_active())
 	      std::fill(&projHamParTrans.local_el(0,0),
 		        &projHamParTrans.local_el(0,0)+projHamParTrans.local_m()*projHamParTrans.local_n(),
@@ -1976,6 +2045,8 @@ namespace dftfe{
 	  dealii::ScaLAPACKMatrix<T> permutedIdentityMat(numberWaveFunctions,
 						    processGrid,
 						    rowsBlockSize);
+	  const memoryLedger::Allocation permutedIdentityMatAllocation(memoryLedger::scalapackBuffers,
+	                                                               getLocalBytes(processGrid,permutedIdentityMat));
           if (processGrid->is_process_active())
 	      std::fill(&permutedIdentityMat.local_el(0,0),
 		        &permutedIdentityMat.local_el(0,0)
@@ -28,6 +28,8 @@
 #include "dft.h"
 #include <dftUtils.h>
 #include <dftParameters.h>
+#include <performanceTelemetry.h>
+#include <memoryLedger.h>
 
 
 //
@@ -60,8 +62,13 @@ int main (int argc, char *argv[])
 
   deallog.depth_console(0);
 
+  dftfe::performanceTelemetry::initialize(MPI_COMM_WORLD,
+	                                  dftfe::dftParameters::performanceTelemetryFile);
+  dftfe::memoryLedger::initialize(MPI_COMM_WORLD);
+
   dftfe::dftUtils::Pool kPointPool(MPI_COMM_WORLD, dftfe::dftParameters::npool);
-  dftfe::dftUtils::Pool bandGroupsPool(kPointPool.get_intrapool_comm(), dftfe::dftParameters::nbandGrps);
+  dftfe::dftUtils::Pool spinGroupsPool(kPointPool.get_intrapool_comm(), dftfe::dftParameters::nspinGrps);
+  dftfe::dftUtils::Pool bandGroupsPool(spinGroupsPool.get_intrapool_comm(), dftfe::dftParameters::nbandGrps);
 
   std::srand(dealii::Utilities::MPI::this_mpi_process(bandGroupsPool.get_intrapool_comm()));
   if (dftfe::dftParameters::verbosity>=1)
@@ -74,6 +81,9 @@ int main (int argc, char *argv[])
       pcout << "k-point parallelization processor groups: "
 	    << Utilities::MPI::n_mpi_processes(kPointPool.get_interpool_comm())
 	    << std::endl;
+      pcout << "Spin parallelization processor groups: "
+	    << Utilities::MPI::n_mpi_processes(spinGroupsPool.get_interpool_comm())
+	    << std::endl;
       pcout << "Band parallelization processor groups: "
 	    << Utilities::MPI::n_mpi_processes(bandGroupsPool.get_interpool_comm())
 	    << std::endl;
@@ -94,11 +104,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<1> problemFEOrder1(bandGroupsPool.get_intrapool_comm(),
 	                                 kPointPool.get_interpool_comm(),
-					 bandGroupsPool.get_interpool_comm());
+					 bandGroupsPool.get_interpool_comm(),
+					 spinGroupsPool.get_interpool_comm());
       problemFEOrder1.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder1.set();
-      problemFEOrder1.init();
-      problemFEOrder1.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder1.set();
+	  problemFEOrder1.init();
+	  problemFEOrder1.run();
+	}
+      else
+	problemFEOrder1.runEnsemble();
       break;
     }
 
@@ -106,11 +122,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<2> problemFEOrder2(bandGroupsPool.get_intrapool_comm(),
 	                                 kPointPool.get_interpool_comm(),
-					 bandGroupsPool.get_interpool_comm());
+					 bandGroupsPool.get_interpool_comm(),
+					 spinGroupsPool.get_interpool_comm());
       problemFEOrder2.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder2.set();
-      problemFEOrder2.init();
-      problemFEOrder2.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder2.set();
+	  problemFEOrder2.init();
+	  problemFEOrder2.run();
+	}
+      else
+	problemFEOrder2.runEnsemble();
       break;
     }
 
@@ -118,11 +140,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<3> problemFEOrder3(bandGroupsPool.get_intrapool_comm(),
 	                                 kPointPool.get_interpool_comm(),
-					 bandGroupsPool.get_interpool_comm());
+					 bandGroupsPool.get_interpool_comm(),
+					 spinGroupsPool.get_interpool_comm());
       problemFEOrder3.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder3.set();
-      problemFEOrder3.init();
-      problemFEOrder3.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder3.set();
+	  problemFEOrder3.init();
+	  problemFEOrder3.run();
+	}
+      else
+	problemFEOrder3.runEnsemble();
       break;
     }
 
@@ -130,11 +158,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<4> problemFEOrder4(bandGroupsPool.get_intrapool_comm(),
 	                                 kPointPool.get_interpool_comm(),
-					 bandGroupsPool.get_interpool_comm());
+					 bandGroupsPool.get_interpool_comm(),
+					 spinGroupsPool.get_interpool_comm());
       problemFEOrder4.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder4.set();
-      problemFEOrder4.init();
-      problemFEOrder4.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder4.set();
+	  problemFEOrder4.init();
+	  problemFEOrder4.run();
+	}
+      else
+	problemFEOrder4.runEnsemble();
       break;
     }
 
@@ -142,11 +176,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<5> problemFEOrder5(bandGroupsPool.get_intrapool_comm(),
 	                                kPointPool.get_interpool_comm(),
-					bandGroupsPool.get_interpool_comm());
+					bandGroupsPool.get_interpool_comm(),
+					spinGroupsPool.get_interpool_comm());
       problemFEOrder5.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder5.set();
-      problemFEOrder5.init();
-      problemFEOrder5.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder5.set();
+	  problemFEOrder5.init();
+	  problemFEOrder5.run();
+	}
+      else
+	problemFEOrder5.runEnsemble();
       break;
     }
 
@@ -154,11 +194,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<6> problemFEOrder6(bandGroupsPool.get_intrapool_comm(),
 	                                kPointPool.get_interpool_comm(),
-					bandGroupsPool.get_interpool_comm());
+					bandGroupsPool.get_interpool_comm(),
+					spinGroupsPool.get_interpool_comm());
       problemFEOrder6.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder6.set();
-      problemFEOrder6.init();
-      problemFEOrder6.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder6.set();
+	  problemFEOrder6.init();
+	  problemFEOrder6.run();
+	}
+      else
+	problemFEOrder6.runEnsemble();
       break;
     }
 
@@ -166,11 +212,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<7> problemFEOrder7(bandGroupsPool.get_intrapool_comm(),
 	                                 kPointPool.get_interpool_comm(),
-					 bandGroupsPool.get_interpool_comm());
+					 bandGroupsPool.get_interpool_comm(),
+					 spinGroupsPool.get_interpool_comm());
       problemFEOrder7.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder7.set();
-      problemFEOrder7.init();
-      problemFEOrder7.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder7.set();
+	  problemFEOrder7.init();
+	  problemFEOrder7.run();
+	}
+      else
+	problemFEOrder7.runEnsemble();
       break;
     }
 
@@ -178,11 +230,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<8> problemFEOrder8(bandGroupsPool.get_intrapool_comm(),
 	                                 kPointPool.get_interpool_comm(),
-					 bandGroupsPool.get_interpool_comm());
+					 bandGroupsPool.get_interpool_comm(),
+					 spinGroupsPool.get_interpool_comm());
       problemFEOrder8.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder8.set();
-      problemFEOrder8.init();
-      problemFEOrder8.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder8.set();
+	  problemFEOrder8.init();
+	  problemFEOrder8.run();
+	}
+      else
+	problemFEOrder8.runEnsemble();
       break;
     }
 
@@ -190,11 +248,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<9> problemFEOrder9(bandGroupsPool.get_intrapool_comm(),
 	                                 kPointPool.get_interpool_comm(),
-					 bandGroupsPool.get_interpool_comm());
+					 bandGroupsPool.get_interpool_comm(),
+					 spinGroupsPool.get_interpool_comm());
       problemFEOrder9.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder9.set();
-      problemFEOrder9.init();
-      problemFEOrder9.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder9.set();
+	  problemFEOrder9.init();
+	  problemFEOrder9.run();
+	}
+      else
+	problemFEOrder9.runEnsemble();
       break;
     }
 
@@ -202,11 +266,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<10> problemFEOrder10(bandGroupsPool.get_intrapool_comm(),
 	                                   kPointPool.get_interpool_comm(),
-					   bandGroupsPool.get_interpool_comm());
+					   bandGroupsPool.get_interpool_comm(),
+					   spinGroupsPool.get_interpool_comm());
       problemFEOrder10.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder10.set();
-      problemFEOrder10.init();
-      problemFEOrder10.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder10.set();
+	  problemFEOrder10.init();
+	  problemFEOrder10.run();
+	}
+      else
+	problemFEOrder10.runEnsemble();
       break;
     }
 
@@ -214,11 +284,17 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<11> problemFEOrder11(bandGroupsPool.get_intrapool_comm(),
 	                                   kPointPool.get_interpool_comm(),
-					   bandGroupsPool.get_interpool_comm());
+					   bandGroupsPool.get_interpool_comm(),
+					   spinGroupsPool.get_interpool_comm());
       problemFEOrder11.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder11.set();
-      problemFEOrder11.init();
-      problemFEOrder11.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder11.set();
+	  problemFEOrder11.init();
+	  problemFEOrder11.run();
+	}
+      else
+	problemFEOrder11.runEnsemble();
       break;
     }
 
@@ -226,16 +302,24 @@ int main (int argc, char *argv[])
     {
       dftfe::dftClass<12> problemFEOrder12(bandGroupsPool.get_intrapool_comm(),
 	                                   kPointPool.get_interpool_comm(),
-					   bandGroupsPool.get_interpool_comm());
+					   bandGroupsPool.get_interpool_comm(),
+					   spinGroupsPool.get_interpool_comm());
       problemFEOrder12.d_numEigenValues = dftfe::dftParameters::numberEigenValues;
-      problemFEOrder12.set();
-      problemFEOrder12.init();
-      problemFEOrder12.run();
+      if (dftfe::dftParameters::ensembleStructuresFile.empty())
+	{
+	  problemFEOrder12.set();
+	  problemFEOrder12.init();
+	  problemFEOrder12.run();
+	}
+      else
+	problemFEOrder12.runEnsemble();
       break;
     }
 
     }
 
+  dftfe::performanceTelemetry::writeSummary();
+
   const double end = MPI_Wtime();
   if (dftfe::dftParameters::verbosity>=1 && dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
   {
@@ -0,0 +1,514 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <molecularDynamics.h>
+#include <force.h>
+#include <dft.h>
+#include <dftParameters.h>
+#include <dftUtils.h>
+#include <fileReaders.h>
+#include <random>
+
+namespace dftfe {
+
+  namespace internalMD
+  {
+    //standard atomic weights (in atomic mass units) of elements with atomic number 1 to 86
+    const double atomicWeights[86]={1.008, 4.0026, 6.94, 9.0122, 10.81, 12.011, 14.007, 15.999, 18.998, 20.180,
+				    22.990, 24.305, 26.982, 28.085, 30.974, 32.06, 35.45, 39.948, 39.098, 40.078,
+				    44.956, 47.867, 50.942, 51.996, 54.938, 55.845, 58.933, 58.693, 63.546, 65.38,
+				    69.723, 72.630, 74.922, 78.971, 79.904, 83.798, 85.468, 87.62, 88.906, 91.224,
+				    92.906, 95.95, 98.0, 101.07, 102.91, 106.42, 107.87, 112.41, 114.82, 118.71,
+				    121.76, 127.60, 126.90, 131.29, 132.91, 137.33, 138.91, 140.12, 140.91, 144.24,
+				    145.0, 150.36, 151.96, 157.25, 158.93, 162.50, 164.93, 167.26, 168.93, 173.05,
+				    174.97, 178.49, 180.95, 183.84, 186.21, 190.23, 192.22, 195.08, 196.97, 200.59,
+				    204.38, 207.2, 208.98, 209.0, 210.0, 222.0};
+
+    //XL BOMD coefficients kappa, alpha and c_0,...,c_K for dissipation orders K=3 to 7
+    //(Table I of Niklasson et al., J. Chem. Phys. 130, 214109 (2009))
+    void getXLBOMDCoefficients(const unsigned int K,
+			       double & kappa,
+			       double & alpha,
+			       std::vector<double> & coeffs)
+    {
+      if (K==3)
+      {
+	kappa=1.69; alpha=150e-3;
+	coeffs={-2.0,3.0,0.0,-1.0};
+      }
+      else if (K==4)
+      {
+	kappa=1.75; alpha=57e-3;
+	coeffs={-3.0,6.0,-2.0,-2.0,1.0};
+      }
+      else if (K==5)
+      {
+	kappa=1.82; alpha=18e-3;
+	coeffs={-6.0,14.0,-8.0,-3.0,4.0,-1.0};
+      }
+      else if (K==6)
+      {
+	kappa=1.84; alpha=5.5e-3;
+	coeffs={-14.0,36.0,-27.0,-2.0,12.0,-6.0,1.0};
+      }
+      else if (K==7)
+      {
+	kappa=1.86; alpha=1.6e-3;
+	coeffs={-36.0,99.0,-88.0,11.0,32.0,-25.0,8.0,-1.0};
+      }
+      else
+	AssertThrow(false,ExcMessage("DFT-FE Error: XL BOMD DISSIPATION ORDER must be between 3 and 7."));
+    }
+  }
+
+  //
+  //constructor
+  //
+  template<unsigned int FEOrder>
+  molecularDynamics<FEOrder>::molecularDynamics(dftClass<FEOrder>* _dftPtr,const MPI_Comm &mpi_comm_replica):
+    dftPtr(_dftPtr),
+    mpi_communicator (mpi_comm_replica),
+    n_mpi_processes (Utilities::MPI::n_mpi_processes(mpi_comm_replica)),
+    this_mpi_process (Utilities::MPI::this_mpi_process(mpi_comm_replica)),
+    pcout(std::cout, (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0 && !dftParameters::reproducible_output))
+  {
+
+  }
+
+  //
+  //
+  template<unsigned int FEOrder>
+  void molecularDynamics<FEOrder>::init()
+  {
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+
+    d_timeStep=dftParameters::timeStepBOMD/C_AtomicUnitOfTimeFs;
+
+    d_atomicMasses.resize(numberGlobalAtoms);
+    for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+    {
+	const unsigned int atomicNumber=std::round(dftPtr->atomLocations[iAtom][0]);
+	AssertThrow(atomicNumber>=1 && atomicNumber<=86,ExcMessage("DFT-FE Error: atomic mass not available for the given atomic number in BOMD."));
+	d_atomicMasses[iAtom]=internalMD::atomicWeights[atomicNumber-1]*C_AMUToElectronMass;
+    }
+
+    d_velocities.clear();
+    d_velocities.resize(3*numberGlobalAtoms,0.0);
+    d_startingStep=0;
+    d_totalEnergyStart=0.0;
+
+    //
+    //read the last completed step, the total energy of the starting configuration and the velocities
+    //from the checkpoint. The atomic positions are read by dftClass from the geometry checkpoint files.
+    //
+    if (dftParameters::chkType==1 && dftParameters::restartFromChk)
+      {
+	std::vector<std::vector<double> > checkpointData;
+	dftUtils::readFile(3,
+			   checkpointData,
+			   "bomd.chk");
+	AssertThrow(checkpointData.size()==numberGlobalAtoms+1,
+		    ExcMessage("DFT-FE Error: data size of BOMD checkpoint file doesn't match with number of atoms in the problem."));
+
+	d_startingStep=std::round(checkpointData[0][0]);
+	d_totalEnergyStart=checkpointData[0][1];
+	for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	  for (unsigned int idim=0; idim<3; ++idim)
+	    d_velocities[3*iAtom+idim]=checkpointData[iAtom+1][idim];
+      }
+    //
+    //draw the starting velocities from the Maxwell-Boltzmann distribution on the root processor,
+    //remove the center of mass velocity and rescale to the exact starting temperature
+    //
+    else if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0 && dftParameters::startingTempBOMD>0.0)
+    {
+	std::mt19937 randomGenerator(5489u);
+	std::normal_distribution<double> normalDistribution(0.0,1.0);
+
+	double totalMass=0.0;
+	std::vector<double> centerOfMassMomentum(3,0.0);
+	for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	{
+	    const double stdDev=std::sqrt(C_kb*dftParameters::startingTempBOMD/d_atomicMasses[iAtom]);
+	    for (unsigned int idim=0; idim<3; ++idim)
+	    {
+		d_velocities[3*iAtom+idim]=stdDev*normalDistribution(randomGenerator);
+		centerOfMassMomentum[idim]+=d_atomicMasses[iAtom]*d_velocities[3*iAtom+idim];
+	    }
+	    totalMass+=d_atomicMasses[iAtom];
+	}
+
+	for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	    for (unsigned int idim=0; idim<3; ++idim)
+		d_velocities[3*iAtom+idim]-=centerOfMassMomentum[idim]/totalMass;
+
+	const double kineticEnergy=computeKineticEnergy();
+	if (kineticEnergy>0.0)
+	{
+	    const double scalingFactor=std::sqrt(1.5*numberGlobalAtoms*C_kb*dftParameters::startingTempBOMD/kineticEnergy);
+	    for (unsigned int i=0; i<d_velocities.size(); ++i)
+		d_velocities[i]*=scalingFactor;
+	}
+    }
+
+    //for synchronization
+    MPI_Bcast(&(d_velocities[0]),
+	      d_velocities.size(),
+	      MPI_DOUBLE,
+	      0,
+	      MPI_COMM_WORLD);
+    MPI_Bcast(&(d_startingStep),
+	      1,
+	      MPI_UNSIGNED,
+	      0,
+	      MPI_COMM_WORLD);
+    MPI_Bcast(&(d_totalEnergyStart),
+	      1,
+	      MPI_DOUBLE,
+	      0,
+	      MPI_COMM_WORLD);
+
+    d_accelerations.clear();
+    d_accelerations.resize(3*numberGlobalAtoms,0.0);
+
+    if (dftParameters::isXLBOMD)
+      internalMD::getXLBOMDCoefficients(dftParameters::dissipationOrderXLBOMD,
+					d_kappaXLBOMD,
+					d_alphaXLBOMD,
+					d_dissipationCoeffsXLBOMD);
+
+    d_auxiliaryDensityHistory.clear();
+    d_rhoOutLastStep.clear();
+  }
+
+  template<unsigned int FEOrder>
+  void molecularDynamics<FEOrder>::run()
+  {
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+
+    const bool isRestart=dftParameters::chkType==1 && dftParameters::restartFromChk;
+    if (isRestart)
+      pcout<<" Re starting Born-Oppenheimer molecular dynamics"<<(dftParameters::isXLBOMD?" using XL BOMD":"")<<" from step: "<<d_startingStep<<"... "<<std::endl;
+    else
+      pcout<<" Starting Born-Oppenheimer molecular dynamics"<<(dftParameters::isXLBOMD?" using XL BOMD":"")<<"... "<<std::endl;
+    if (dftParameters::verbosity>=2)
+      {
+	pcout<<"   ---BOMD Parameters--------------  "<<std::endl;
+	pcout<<"      time step (fs): "<< dftParameters::timeStepBOMD<<std::endl;
+	pcout<<"      number of steps: "<< dftParameters::numberStepsBOMD<<std::endl;
+	pcout<<"      starting temperature (K): "<< dftParameters::startingTempBOMD<<std::endl;
+	pcout<<"      thermostat: "<< dftParameters::thermostatTypeBOMD<<std::endl;
+	pcout<<"      SCF iterations per step: "<< dftParameters::numSCFIterationsBOMD<<std::endl;
+	pcout<<"      Chebyshev filter passes per SCF iteration: "<< dftParameters::chebyshevPassesBOMD<<std::endl;
+	if (dftParameters::isXLBOMD)
+	  pcout<<"      XL BOMD dissipation order: "<< dftParameters::dissipationOrderXLBOMD<<std::endl;
+	pcout<<"   ------------------------------  "<<std::endl;
+      }
+
+    double maxForce=computeAccelerations();
+
+    //the restarted step is already in the trajectory file
+    if (!isRestart)
+      {
+	d_totalEnergyStart=computeKineticEnergy()+dftPtr->d_groundStateEnergy;
+	writeStep(0,true);
+	if (dftParameters::chkType==1)
+	  save(0);
+      }
+
+    if (dftParameters::isXLBOMD)
+      {
+        d_rhoOutLastStep.clear();
+	const std::vector<quadDensityField *> rhoOutFields=getDensityFields(false);
+	for (unsigned int ifield=0; ifield<rhoOutFields.size(); ++ifield)
+	  d_rhoOutLastStep.push_back(*rhoOutFields[ifield]);
+
+	//the auxiliary density of the starting (or restarted) configuration is the ground-state density
+	d_auxiliaryDensityHistory.assign(dftParameters::dissipationOrderXLBOMD+1,d_rhoOutLastStep);
+      }
+
+    //fix the SCF cost per step after the ground-state solve of the starting configuration
+    const unsigned int numSCFIterationsGroundState=dftParameters::numSCFIterations;
+    const unsigned int maxChebyshevFilterPassesGroundState=dftPtr->d_maxChebyshevFilterPassesPerScfIter;
+    dftParameters::numSCFIterations=dftParameters::numSCFIterationsBOMD;
+    dftPtr->d_maxChebyshevFilterPassesPerScfIter=dftParameters::chebyshevPassesBOMD;
+
+    for (unsigned int step=d_startingStep+1; step<=dftParameters::numberStepsBOMD; ++step)
+      {
+	//
+	//velocity-Verlet: half step velocity update and full step position update
+	//
+	std::vector<Tensor<1,3,double> > globalAtomsDisplacements(numberGlobalAtoms);
+	for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	  {
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      {
+		d_velocities[3*iAtom+idim]+=0.5*d_timeStep*d_accelerations[3*iAtom+idim];
+		globalAtomsDisplacements[iAtom][idim]=d_timeStep*d_velocities[3*iAtom+idim];
+	      }
+
+	    //for synchronization
+	    MPI_Bcast(&(globalAtomsDisplacements[iAtom][0]),
+		      3,
+		      MPI_DOUBLE,
+		      0,
+		      MPI_COMM_WORLD);
+	  }
+
+	dftPtr->updateAtomPositionsAndMoveMesh(globalAtomsDisplacements,maxForce);
+
+	if (dftParameters::isXLBOMD)
+	  {
+	    //auxiliary density history is not valid on a new mesh
+	    if (dftPtr->d_autoMesh==1)
+	      {
+		if (dftParameters::verbosity>=1)
+		  pcout<<" Resetting XL BOMD auxiliary density history after remeshing"<<std::endl;
+		resetAuxiliaryDensityHistory();
+	      }
+	    else
+	      propagateAuxiliaryDensity();
+	  }
+
+	dftPtr->solve();
+
+	if (dftParameters::isXLBOMD)
+	  {
+	    const std::vector<quadDensityField *> rhoOutFields=getDensityFields(false);
+	    for (unsigned int ifield=0; ifield<rhoOutFields.size(); ++ifield)
+	      d_rhoOutLastStep[ifield]=*rhoOutFields[ifield];
+	  }
+
+	//
+	//velocity-Verlet: second half step velocity update using the new accelerations
+	//
+	maxForce=computeAccelerations();
+	for (unsigned int i=0; i<d_velocities.size(); ++i)
+	  d_velocities[i]+=0.5*d_timeStep*d_accelerations[i];
+
+	if (dftParameters::thermostatTypeBOMD=="BERENDSEN")
+	  {
+	    const double temperature=2.0*computeKineticEnergy()/(3.0*numberGlobalAtoms*C_kb);
+	    if (temperature>0.0)
+	      {
+		const double scalingFactor=std::sqrt(1.0+dftParameters::timeStepBOMD/dftParameters::thermostatTimeConstantBOMD
+						     *(dftParameters::startingTempBOMD/temperature-1.0));
+		for (unsigned int i=0; i<d_velocities.size(); ++i)
+		  d_velocities[i]*=scalingFactor;
+	      }
+	  }
+
+	writeStep(step,false);
+	if (dftParameters::chkType==1)
+	  save(step);
+      }
+
+    dftParameters::numSCFIterations=numSCFIterationsGroundState;
+    dftPtr->d_maxChebyshevFilterPassesPerScfIter=maxChebyshevFilterPassesGroundState;
+
+    //total energy drift of the NVE ensemble is also printed in the reproducible output for the regression tests
+    if (dftParameters::thermostatTypeBOMD=="NONE" && Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
+      {
+	const double totalEnergyDrift=std::fabs(computeKineticEnergy()+dftPtr->d_groundStateEnergy-d_totalEnergyStart)/numberGlobalAtoms;
+	if (dftParameters::reproducible_output)
+	  std::cout<<" BOMD total energy drift per atom (Ha): "<<std::fixed<<std::setprecision(6)<<std::floor(1000000*totalEnergyDrift)/1000000.0<<std::endl;
+	else
+	  std::cout<<" BOMD total energy drift per atom (Ha): "<<totalEnergyDrift<<std::endl;
+      }
+
+    pcout<<" ...Born-Oppenheimer molecular dynamics completed after "<<dftParameters::numberStepsBOMD<<" steps"<<std::endl;
+  }
+
+  template<unsigned int FEOrder>
+  double molecularDynamics<FEOrder>::computeAccelerations()
+  {
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+    //getAtomsForces returns the configurational force which is the negative of the atomic force
+    const std::vector<double> configurationalForces=dftPtr->forcePtr->getAtomsForces();
+    AssertThrow(configurationalForces.size()==numberGlobalAtoms*3,ExcMessage("Atom forces have wrong size"));
+
+    double maxForce=0.0;
+    for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+      {
+	double forceMagnitude=0.0;
+	for (unsigned int idim=0; idim<3; ++idim)
+	  {
+	    d_accelerations[3*iAtom+idim]=-configurationalForces[3*iAtom+idim]/d_atomicMasses[iAtom];
+	    forceMagnitude+=configurationalForces[3*iAtom+idim]*configurationalForces[3*iAtom+idim];
+	  }
+	maxForce=std::max(maxForce,std::sqrt(forceMagnitude));
+      }
+
+    return maxForce;
+  }
+
+  template<unsigned int FEOrder>
+  double molecularDynamics<FEOrder>::computeKineticEnergy() const
+  {
+    double kineticEnergy=0.0;
+    for (unsigned int iAtom=0; iAtom<d_atomicMasses.size(); ++iAtom)
+      for (unsigned int idim=0; idim<3; ++idim)
+	kineticEnergy+=0.5*d_atomicMasses[iAtom]*d_velocities[3*iAtom+idim]*d_velocities[3*iAtom+idim];
+
+    return kineticEnergy;
+  }
+
+  template<unsigned int FEOrder>
+  std::vector<std::map<dealii::CellId, std::vector<double> > *>
+  molecularDynamics<FEOrder>::getDensityFields(const bool rhoIn) const
+  {
+    std::vector<quadDensityField *> fields;
+    fields.push_back(rhoIn?dftPtr->rhoInValues:dftPtr->rhoOutValues);
+    if (dftParameters::xc_id==4)
+      fields.push_back(rhoIn?dftPtr->gradRhoInValues:dftPtr->gradRhoOutValues);
+    if (dftParameters::spinPolarized==1)
+      fields.push_back(rhoIn?dftPtr->rhoInValuesSpinPolarized:dftPtr->rhoOutValuesSpinPolarized);
+    if (dftParameters::spinPolarized==1 && dftParameters::xc_id==4)
+      fields.push_back(rhoIn?dftPtr->gradRhoInValuesSpinPolarized:dftPtr->gradRhoOutValuesSpinPolarized);
+
+    return fields;
+  }
+
+  template<unsigned int FEOrder>
+  void molecularDynamics<FEOrder>::resetAuxiliaryDensityHistory()
+  {
+    const std::vector<quadDensityField *> rhoInFields=getDensityFields(true);
+    std::vector<quadDensityField> auxiliaryDensity;
+    for (unsigned int ifield=0; ifield<rhoInFields.size(); ++ifield)
+      auxiliaryDensity.push_back(*rhoInFields[ifield]);
+
+    d_auxiliaryDensityHistory.assign(dftParameters::dissipationOrderXLBOMD+1,auxiliaryDensity);
+  }
+
+  //
+  //n_{k+1}=2n_k-n_{k-1}+kappa*(rho_k-n_k)+alpha*sum_{m=0}^{K} c_m n_{k-m},
+  //where rho_k is the output density of the ground-state solve at step k using n_k as the starting density
+  //
+  template<unsigned int FEOrder>
+  void molecularDynamics<FEOrder>::propagateAuxiliaryDensity()
+  {
+    const unsigned int numberFields=d_rhoOutLastStep.size();
+    const std::vector<quadDensityField *> rhoInFields=getDensityFields(true);
+    AssertThrow(rhoInFields.size()==numberFields,ExcMessage("DFT-FE Error: mismatch in number of density fields in XL BOMD."));
+
+    std::vector<quadDensityField> auxiliaryDensityNew(numberFields);
+    for (unsigned int ifield=0; ifield<numberFields; ++ifield)
+      {
+	const quadDensityField & auxiliaryDensityCurrent=d_auxiliaryDensityHistory[0][ifield];
+	const quadDensityField & auxiliaryDensityPrevious=d_auxiliaryDensityHistory[1][ifield];
+	const quadDensityField & rhoOut=d_rhoOutLastStep[ifield];
+
+	for (quadDensityField::const_iterator it=auxiliaryDensityCurrent.begin(); it!=auxiliaryDensityCurrent.end(); ++it)
+	  {
+	    const dealii::CellId cellId=it->first;
+	    const std::vector<double> & nCurrent=it->second;
+	    const std::vector<double> & nPrevious=auxiliaryDensityPrevious.find(cellId)->second;
+	    const std::vector<double> & rhoOutCell=rhoOut.find(cellId)->second;
+
+	    std::vector<double> & nNew=auxiliaryDensityNew[ifield][cellId];
+	    nNew.resize(nCurrent.size());
+	    for (unsigned int q=0; q<nCurrent.size(); ++q)
+	      nNew[q]=2.0*nCurrent[q]-nPrevious[q]+d_kappaXLBOMD*(rhoOutCell[q]-nCurrent[q]);
+
+	    for (unsigned int m=0; m<d_dissipationCoeffsXLBOMD.size(); ++m)
+	      {
+		if (d_dissipationCoeffsXLBOMD[m]==0.0)
+		  continue;
+		const std::vector<double> & nPast=d_auxiliaryDensityHistory[m][ifield].find(cellId)->second;
+		const double coeff=d_alphaXLBOMD*d_dissipationCoeffsXLBOMD[m];
+		for (unsigned int q=0; q<nCurrent.size(); ++q)
+		  nNew[q]+=coeff*nPast[q];
+	      }
+	  }
+
+	//set as the starting density for the next ground-state solve
+	*rhoInFields[ifield]=auxiliaryDensityNew[ifield];
+      }
+
+    d_auxiliaryDensityHistory.push_front(auxiliaryDensityNew);
+    d_auxiliaryDensityHistory.pop_back();
+  }
+
+  template<unsigned int FEOrder>
+  void molecularDynamics<FEOrder>::save(const unsigned int step) const
+  {
+    dftPtr->writeDomainAndAtomCoordinates();
+
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+    std::vector<std::vector<double> > checkpointData(numberGlobalAtoms+1,std::vector<double>(3,0.0));
+    checkpointData[0][0]=step;
+    checkpointData[0][1]=d_totalEnergyStart;
+    for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+      for (unsigned int idim=0; idim<3; ++idim)
+	checkpointData[iAtom+1][idim]=d_velocities[3*iAtom+idim];
+
+    dftUtils::writeDataIntoFile(checkpointData,
+				"bomd.chk");
+  }
+
+  template<unsigned int FEOrder>
+  void molecularDynamics<FEOrder>::writeStep(const unsigned int step,
+					     const bool createFile) const
+  {
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+    const double kineticEnergy=computeKineticEnergy();
+    const double temperature=2.0*kineticEnergy/(3.0*numberGlobalAtoms*C_kb);
+    const double potentialEnergy=dftPtr->d_groundStateEnergy;
+
+    pcout<<" BOMD step: "<<step<<", time (fs): "<<step*dftParameters::timeStepBOMD
+         <<", kinetic energy (Ha): "<<kineticEnergy
+	 <<", potential energy (Ha): "<<potentialEnergy
+	 <<", total energy (Ha): "<<kineticEnergy+potentialEnergy
+	 <<", temperature (K): "<<temperature<<std::endl;
+
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
+      {
+	std::ofstream outFile(dftParameters::trajectoryFileBOMD.c_str(),createFile?std::ios::out:std::ios::app);
+	outFile<<numberGlobalAtoms<<std::endl;
+	outFile<<"Step: "<<step<<" Time(fs): "<<step*dftParameters::timeStepBOMD
+	       <<" KineticEnergy(Ha): "<<std::setprecision(12)<<kineticEnergy
+	       <<" PotentialEnergy(Ha): "<<potentialEnergy
+	       <<" Temperature(K): "<<temperature<<std::endl;
+
+	const std::vector<double> configurationalForces=dftPtr->forcePtr->getAtomsForces();
+	for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	  {
+	    outFile<<(unsigned int)dftPtr->atomLocations[iAtom][0];
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      outFile<<" "<<dftPtr->atomLocations[iAtom][2+idim];
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      outFile<<" "<<d_velocities[3*iAtom+idim];
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      outFile<<" "<<-configurationalForces[3*iAtom+idim];
+	    outFile<<std::endl;
+	  }
+	outFile.close();
+      }
+  }
+
+
+  template class molecularDynamics<1>;
+  template class molecularDynamics<2>;
+  template class molecularDynamics<3>;
+  template class molecularDynamics<4>;
+  template class molecularDynamics<5>;
+  template class molecularDynamics<6>;
+  template class molecularDynamics<7>;
+  template class molecularDynamics<8>;
+  template class molecularDynamics<9>;
+  template class molecularDynamics<10>;
+  template class molecularDynamics<11>;
+  template class molecularDynamics<12>;
+}
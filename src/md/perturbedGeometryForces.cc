@@ -0,0 +1,260 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <perturbedGeometryForces.h>
+#include <force.h>
+#include <dft.h>
+#include <dftParameters.h>
+#include <dftUtils.h>
+#include <fileReaders.h>
+
+namespace dftfe {
+
+  //
+  //constructor
+  //
+  template<unsigned int FEOrder>
+  perturbedGeometryForces<FEOrder>::perturbedGeometryForces(dftClass<FEOrder>* _dftPtr,const MPI_Comm &mpi_comm_replica):
+    dftPtr(_dftPtr),
+    mpi_communicator (mpi_comm_replica),
+    n_mpi_processes (Utilities::MPI::n_mpi_processes(mpi_comm_replica)),
+    this_mpi_process (Utilities::MPI::this_mpi_process(mpi_comm_replica)),
+    pcout(std::cout, (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0 && !dftParameters::reproducible_output))
+  {
+
+  }
+
+  //
+  //
+  template<unsigned int FEOrder>
+  void perturbedGeometryForces<FEOrder>::init()
+  {
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+
+    std::vector<std::vector<double> > displacementsData;
+    dftUtils::readFile(3,
+		       displacementsData,
+		       dftParameters::perturbedGeometriesFile);
+
+    AssertThrow(displacementsData.size()>0 && displacementsData.size()%numberGlobalAtoms==0,
+	        ExcMessage("DFT-FE Error: number of rows in PERTURBED GEOMETRIES FILE must be a non-zero multiple of NATOMS."));
+
+    const unsigned int numberGeometries=displacementsData.size()/numberGlobalAtoms;
+    d_perturbedGeometriesDisplacements.clear();
+    d_perturbedGeometriesDisplacements.resize(numberGeometries,
+	                                      std::vector<Tensor<1,3,double> >(numberGlobalAtoms));
+    for (unsigned int igeo=0; igeo<numberGeometries; ++igeo)
+      for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	{
+	  for (unsigned int idim=0; idim<3; ++idim)
+	    d_perturbedGeometriesDisplacements[igeo][iAtom][idim]=displacementsData[igeo*numberGlobalAtoms+iAtom][idim];
+
+	  //for synchronization
+	  MPI_Bcast(&(d_perturbedGeometriesDisplacements[igeo][iAtom][0]),
+		    3,
+		    MPI_DOUBLE,
+		    0,
+		    MPI_COMM_WORLD);
+	}
+  }
+
+  template<unsigned int FEOrder>
+  void perturbedGeometryForces<FEOrder>::run()
+  {
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+    const unsigned int numberGeometries=d_perturbedGeometriesDisplacements.size();
+
+    pcout<<" Starting non self-consistent force evaluation on "<<numberGeometries<<" perturbed geometries... "<<std::endl;
+    if (dftParameters::verbosity>=2)
+      pcout<<"      Chebyshev filter passes per perturbed geometry: "<< dftParameters::chebyshevPassesPerturbedGeometry<<std::endl;
+
+    //maximum force magnitude of the ground-state, used for the mesh quality bound in the mesh movement
+    double maxForce=0.0;
+    {
+      const std::vector<double> configurationalForces=dftPtr->forcePtr->getAtomsForces();
+      for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	{
+	  double forceMagnitude=0.0;
+	  for (unsigned int idim=0; idim<3; ++idim)
+	    forceMagnitude+=configurationalForces[3*iAtom+idim]*configurationalForces[3*iAtom+idim];
+	  maxForce=std::max(maxForce,std::sqrt(forceMagnitude));
+	}
+    }
+
+    storeReferenceGroundState();
+    storeReferenceGeometry();
+
+    //
+    //fix the eigensolver cost of the non self-consistent solves: a single SCF iteration (no density mixing) with
+    //exactly chebyshevPassesPerturbedGeometry Chebyshev filter passes, as the zero tolerance is never reached
+    //
+    const unsigned int numSCFIterationsGroundState=dftParameters::numSCFIterations;
+    const double chebyshevToleranceGroundState=dftParameters::chebyshevTolerance;
+    const unsigned int maxChebyshevFilterPassesGroundState=dftPtr->d_maxChebyshevFilterPassesPerScfIter;
+
+    //the reference mesh is regenerated exactly by remeshing at the reference geometry only if it was not
+    //moved after its generation
+    bool isReferenceMeshRegenerated=true;
+    for (unsigned int iAtom=0; iAtom<d_gaussianMovementAtomsNetDisplacementsReference.size(); ++iAtom)
+      if (d_gaussianMovementAtomsNetDisplacementsReference[iAtom].norm()>1e-12)
+	isReferenceMeshRegenerated=false;
+
+    bool isMeshRemeshed=false;
+    for (unsigned int igeo=0; igeo<numberGeometries; ++igeo)
+      {
+	//return to the reference mesh after a remesh in the previous perturbed geometry
+	if (isMeshRemeshed)
+	  {
+	    restoreReferenceGeometry();
+	    dftPtr->init(0);
+
+	    //the reference subspace is not valid on the new mesh, so the reference ground-state is recomputed
+	    if (!isReferenceMeshRegenerated)
+	      {
+		if (dftParameters::verbosity>=1)
+		  pcout<<" Full ground-state solve for the reference geometry as the reference mesh could not be regenerated"<<std::endl;
+		dftPtr->solve();
+		storeReferenceGroundState();
+		storeReferenceGeometry();
+		isReferenceMeshRegenerated=true;
+	      }
+	    isMeshRemeshed=false;
+	  }
+
+	//each perturbed geometry is moved from the reference geometry and the reference mesh, so that the
+	//non self-consistent solves do not depend on the order of the perturbed geometries
+	restoreReferenceGroundState();
+	restoreReferenceGeometry();
+	dftPtr->updateAtomPositionsAndMoveMesh(d_perturbedGeometriesDisplacements[igeo],maxForce);
+
+	//the reference subspace is not valid on a new mesh
+	const bool isNonSelfConsistent=dftPtr->d_autoMesh!=1;
+	if (isNonSelfConsistent)
+	  {
+	    dftParameters::numSCFIterations=1;
+	    dftParameters::chebyshevTolerance=0.0;
+	    dftPtr->d_maxChebyshevFilterPassesPerScfIter=dftParameters::chebyshevPassesPerturbedGeometry;
+
+	    //the reused subspace does not require the additional Chebyshev filtering of the first SCF iteration
+	    dftPtr->d_isGroundStateGuessExtrapolated=true;
+	  }
+	else
+	  {
+	    if (dftParameters::verbosity>=1)
+	      pcout<<" Full ground-state solve for perturbed geometry: "<<igeo+1<<" as the mesh movement required remeshing"<<std::endl;
+	    isMeshRemeshed=true;
+	  }
+
+	dftPtr->solve();
+
+	dftParameters::numSCFIterations=numSCFIterationsGroundState;
+	dftParameters::chebyshevTolerance=chebyshevToleranceGroundState;
+	dftPtr->d_maxChebyshevFilterPassesPerScfIter=maxChebyshevFilterPassesGroundState;
+
+	writeForces(igeo,
+		    isNonSelfConsistent,
+		    igeo==0);
+      }
+
+    pcout<<" ...Non self-consistent force evaluation on perturbed geometries completed"<<std::endl;
+  }
+
+  template<unsigned int FEOrder>
+  void perturbedGeometryForces<FEOrder>::storeReferenceGroundState()
+  {
+    d_eigenVectorsReference=dftPtr->d_eigenVectorsFlattenedSTL;
+    d_eigenValuesReference=dftPtr->eigenValues;
+    d_fermiEnergyReference=dftPtr->fermiEnergy;
+    d_fermiEnergyUpReference=dftPtr->fermiEnergyUp;
+    d_fermiEnergyDownReference=dftPtr->fermiEnergyDown;
+    if (dftParameters::mixingMethod=="ANDERSON_WITH_KERKER")
+      d_rhoOutNodalValuesReference=dftPtr->d_rhoOutNodalValues;
+  }
+
+  template<unsigned int FEOrder>
+  void perturbedGeometryForces<FEOrder>::restoreReferenceGroundState()
+  {
+    dftPtr->d_eigenVectorsFlattenedSTL=d_eigenVectorsReference;
+    dftPtr->eigenValues=d_eigenValuesReference;
+    dftPtr->fermiEnergy=d_fermiEnergyReference;
+    dftPtr->fermiEnergyUp=d_fermiEnergyUpReference;
+    dftPtr->fermiEnergyDown=d_fermiEnergyDownReference;
+    if (dftParameters::mixingMethod=="ANDERSON_WITH_KERKER")
+      dftPtr->d_rhoOutNodalValues=d_rhoOutNodalValuesReference;
+  }
+
+  template<unsigned int FEOrder>
+  void perturbedGeometryForces<FEOrder>::storeReferenceGeometry()
+  {
+    d_atomLocationsReference=dftPtr->atomLocations;
+    d_atomLocationsFractionalReference=dftPtr->atomLocationsFractional;
+    d_gaussianMovementAtomsNetDisplacementsReference=dftPtr->d_gaussianMovementAtomsNetDisplacements;
+  }
+
+  template<unsigned int FEOrder>
+  void perturbedGeometryForces<FEOrder>::restoreReferenceGeometry()
+  {
+    dftPtr->atomLocations=d_atomLocationsReference;
+    dftPtr->atomLocationsFractional=d_atomLocationsFractionalReference;
+    dftPtr->d_gaussianMovementAtomsNetDisplacements=d_gaussianMovementAtomsNetDisplacementsReference;
+  }
+
+  template<unsigned int FEOrder>
+  void perturbedGeometryForces<FEOrder>::writeForces(const unsigned int geometryIndex,
+						     const bool isNonSelfConsistent,
+						     const bool createFile) const
+  {
+    const unsigned int numberGlobalAtoms=dftPtr->atomLocations.size();
+
+    pcout<<" Perturbed geometry: "<<geometryIndex+1<<(isNonSelfConsistent?" (non self-consistent)":" (self-consistent)")
+         <<", energy (Ha): "<<dftPtr->d_groundStateEnergy<<std::endl;
+
+    if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
+      {
+	std::ofstream outFile(dftParameters::forcesFilePerturbedGeometry.c_str(),createFile?std::ios::out:std::ios::app);
+	outFile<<numberGlobalAtoms<<std::endl;
+	outFile<<"Geometry: "<<geometryIndex+1
+	       <<" NonSelfConsistent: "<<isNonSelfConsistent
+	       <<" Energy(Ha): "<<std::setprecision(12)<<dftPtr->d_groundStateEnergy<<std::endl;
+
+	const std::vector<double> configurationalForces=dftPtr->forcePtr->getAtomsForces();
+	for (unsigned int iAtom=0; iAtom<numberGlobalAtoms; ++iAtom)
+	  {
+	    outFile<<(unsigned int)dftPtr->atomLocations[iAtom][0];
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      outFile<<" "<<dftPtr->atomLocations[iAtom][2+idim];
+	    for (unsigned int idim=0; idim<3; ++idim)
+	      outFile<<" "<<-configurationalForces[3*iAtom+idim];
+	    outFile<<std::endl;
+	  }
+	outFile.close();
+      }
+  }
+
+
+  template class perturbedGeometryForces<1>;
+  template class perturbedGeometryForces<2>;
+  template class perturbedGeometryForces<3>;
+  template class perturbedGeometryForces<4>;
+  template class perturbedGeometryForces<5>;
+  template class perturbedGeometryForces<6>;
+  template class perturbedGeometryForces<7>;
+  template class perturbedGeometryForces<8>;
+  template class perturbedGeometryForces<9>;
+  template class perturbedGeometryForces<10>;
+  template class perturbedGeometryForces<11>;
+  template class perturbedGeometryForces<12>;
+
+}
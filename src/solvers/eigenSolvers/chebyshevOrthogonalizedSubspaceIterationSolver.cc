@@ -19,6 +19,7 @@
 #include <linearAlgebraOperations.h>
 #include <vectorUtilities.h>
 #include <dftUtils.h>
+#include <performanceTelemetry.h>
 
 
 namespace dftfe{
@@ -85,7 +86,8 @@ namespace dftfe{
 		    dftParameters::verbosity<4? dealii::TimerOutput::never : dealii::TimerOutput::summary,
 		    dealii::TimerOutput::wall_times)
   {
-
+    performanceTelemetry::registerTimer("dftClass/Chebyshev solve",
+					computing_timer);
   }
 
   //
@@ -93,6 +95,7 @@ namespace dftfe{
   //
   chebyshevOrthogonalizedSubspaceIterationSolver::~chebyshevOrthogonalizedSubspaceIterationSolver()
   {
+    performanceTelemetry::deregisterTimer(computing_timer);
 
     //
     //
@@ -292,6 +295,8 @@ namespace dftfe{
 	if (!dftParameters::bandParalOpt)
 	{
 	    computing_timer.enter_section("MPI All Reduce wavefunctions across all band groups");
+	    performanceTelemetry::addCommunicatedBytes("band groups communication",
+						       totalNumberWaveFunctions*localVectorSize*sizeof(dataTypes::number));
 	    MPI_Barrier(interBandGroupComm);
 	    const unsigned int blockSize=dftParameters::mpiAllReduceMessageBlockSizeMB*1e+6/sizeof(dataTypes::number);
 	    for (unsigned int i=0; i<totalNumberWaveFunctions*localVectorSize;i+=blockSize)
@@ -309,6 +314,8 @@ namespace dftfe{
 	else
 	{
 	    computing_timer.enter_section("MPI_Allgatherv across band groups");
+	    performanceTelemetry::addCommunicatedBytes("band groups communication",
+						       (numberBandGroups-1)*numVectorsBandParal*localVectorSize*sizeof(dataTypes::number));
 	    MPI_Barrier(interBandGroupComm);
 	    std::vector<dataTypes::number> eigenVectorsBandGroup(numVectorsBandParal*localVectorSize,0);
 	    std::vector<dataTypes::number> eigenVectorsBandGroupTransposed(numVectorsBandParal*localVectorSize,0);
@@ -0,0 +1,444 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <lbfgsNonLinearSolver.h>
+#include <nonlinearSolverProblem.h>
+#include <fileReaders.h>
+
+namespace dftfe {
+
+  namespace internalLBFGS
+  {
+    double dot(const std::vector<double> & a,
+	       const std::vector<double> & b)
+    {
+      double value=0.0;
+      for (unsigned int i=0; i<a.size(); ++i)
+	value+=a[i]*b[i];
+      return value;
+    }
+  }
+
+  //
+  // Constructor.
+  //
+  lbfgsNonLinearSolver::lbfgsNonLinearSolver(const bool usePreconditioner,
+					     const double maxUpdate,
+					     const unsigned int maxNumberIterations,
+					     const unsigned int maxNumPastSteps,
+					     const unsigned int debugLevel,
+					     const double tolerance,
+					     const MPI_Comm &mpi_comm_replica):
+    nonLinearSolver(debugLevel,maxNumberIterations,tolerance),
+    d_usePreconditioner(usePreconditioner),
+    d_maxUpdate(maxUpdate),
+    d_maxNumPastSteps(maxNumPastSteps),
+    mpi_communicator (mpi_comm_replica),
+    n_mpi_processes (dealii::Utilities::MPI::n_mpi_processes(mpi_comm_replica)),
+    this_mpi_process (dealii::Utilities::MPI::this_mpi_process(mpi_comm_replica)),
+    pcout(std::cout, (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0))
+  {
+
+  }
+
+  //
+  // Destructor.
+  //
+  lbfgsNonLinearSolver::~lbfgsNonLinearSolver()
+  {
+
+    //
+    //
+    //
+    return;
+
+  }
+
+  //
+  // s=H_0 q, where H_0=gamma*M^{-1} with M^{-1} given by the problem preconditioner
+  // and gamma=(s^T y)/(y^T M^{-1} y) from the most recent history pair
+  //
+  void
+  lbfgsNonLinearSolver::applyInitialInverseHessian(const nonlinearSolverProblem & problem,
+						   const std::vector<double> & q,
+						   std::vector<double> & s) const
+  {
+    if (d_usePreconditioner)
+      {
+	problem.precondition(s,q);
+	for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	  s[i]=-s[i];
+      }
+    else
+      s=q;
+
+    double gamma=1.0;
+    if (!d_deltaXHistory.empty())
+      {
+	const std::vector<double> & y=d_deltaGradientHistory.back();
+	std::vector<double> preconditionedY(d_numberUnknowns);
+	if (d_usePreconditioner)
+	  {
+	    problem.precondition(preconditionedY,y);
+	    for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	      preconditionedY[i]=-preconditionedY[i];
+	  }
+	else
+	  preconditionedY=y;
+
+	gamma=1.0/(d_rhoHistory.back()*internalLBFGS::dot(y,preconditionedY));
+      }
+
+    for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+      s[i]*=gamma;
+  }
+
+  //
+  // two-loop recursion for the quasi-Newton step
+  //
+  void
+  lbfgsNonLinearSolver::computeStep(const nonlinearSolverProblem & problem)
+  {
+    const unsigned int numPastSteps=d_deltaXHistory.size();
+    std::vector<double> q=d_gradient;
+    std::vector<double> alpha(numPastSteps,0.0);
+
+    for (int k = numPastSteps-1; k >= 0; --k)
+      {
+	alpha[k]=d_rhoHistory[k]*internalLBFGS::dot(d_deltaXHistory[k],q);
+	for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	  q[i]-=alpha[k]*d_deltaGradientHistory[k][i];
+      }
+
+    std::vector<double> r(d_numberUnknowns);
+    applyInitialInverseHessian(problem,q,r);
+
+    for (unsigned int k = 0; k < numPastSteps; ++k)
+      {
+	const double beta=d_rhoHistory[k]*internalLBFGS::dot(d_deltaGradientHistory[k],r);
+	for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	  r[i]+=d_deltaXHistory[k][i]*(alpha[k]-beta);
+      }
+
+    for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+      d_step[i]=-r[i];
+
+    //
+    // fall back to the preconditioned steepest descent direction if the
+    // quasi-Newton step is not a descent direction
+    //
+    unsigned int isNotDescent=internalLBFGS::dot(d_step,d_gradient)>=0.0?1:0;
+    MPI_Bcast(&(isNotDescent),
+	      1,
+	      MPI_INT,
+	      0,
+	      MPI_COMM_WORLD);
+    if (isNotDescent==1)
+      {
+	if (d_debugLevel >= 1)
+	  pcout << "LBFGS step is not a descent direction- resetting history" << std::endl;
+	d_deltaXHistory.clear();
+	d_deltaGradientHistory.clear();
+	d_rhoHistory.clear();
+
+	applyInitialInverseHessian(problem,d_gradient,r);
+	for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	  d_step[i]=-r[i];
+      }
+  }
+
+  //
+  // add the step to the history
+  //
+  void
+  lbfgsNonLinearSolver::updateHistory(const std::vector<double> & deltaX,
+				      const std::vector<double> & deltaGradient)
+  {
+    const double curvature=internalLBFGS::dot(deltaX,deltaGradient);
+
+    //
+    //skip the pair if the curvature condition is not satisfied, which keeps
+    //the inverse Hessian approximation positive definite
+    //
+    unsigned int isCurvatureSatisfied=curvature>1e-12*std::sqrt(internalLBFGS::dot(deltaX,deltaX)*internalLBFGS::dot(deltaGradient,deltaGradient))?1:0;
+    MPI_Bcast(&(isCurvatureSatisfied),
+	      1,
+	      MPI_INT,
+	      0,
+	      MPI_COMM_WORLD);
+    if (isCurvatureSatisfied==0)
+      {
+	if (d_debugLevel >= 2)
+	  pcout << "LBFGS curvature condition not satisfied- step not added to history" << std::endl;
+	return;
+      }
+
+    d_deltaXHistory.push_back(deltaX);
+    d_deltaGradientHistory.push_back(deltaGradient);
+    d_rhoHistory.push_back(1.0/curvature);
+
+    if (d_deltaXHistory.size()>d_maxNumPastSteps)
+      {
+	d_deltaXHistory.pop_front();
+	d_deltaGradientHistory.pop_front();
+	d_rhoHistory.pop_front();
+      }
+  }
+
+  //
+  // limit the step size
+  //
+  void
+  lbfgsNonLinearSolver::limitStep()
+  {
+    double stepMax=0.0;
+    for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+      stepMax=std::max(stepMax,std::abs(d_step[i]));
+
+    if (stepMax>d_maxUpdate)
+      {
+	if (d_debugLevel >= 2)
+	  pcout << "LBFGS step scaled down as maximum update: "<<stepMax<<" exceeds: "<<d_maxUpdate << std::endl;
+
+	for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	  d_step[i]*=d_maxUpdate/stepMax;
+      }
+  }
+
+  //
+  // Compute L_{inf} norm of the gradient
+  //
+  double
+  lbfgsNonLinearSolver::computeGradientMax() const
+  {
+    double gradMax=0.0;
+    for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+      if (std::abs(d_gradient[i])>gradMax)
+	gradMax=std::abs(d_gradient[i]);
+
+    return gradMax;
+  }
+
+  //
+  // save checkpoint files. The first row stores the number of history pairs followed by
+  // the step and gradient difference of each history pair in two columns.
+  //
+  void
+  lbfgsNonLinearSolver::save(const std::string & checkpointFileName)
+  {
+      std::vector<std::vector<double>> data;
+      std::vector<double> row(2,0.0);
+      row[0]=d_deltaXHistory.size();
+      data.push_back(row);
+      for (unsigned int k=0; k< d_deltaXHistory.size();++k)
+	for (unsigned int i=0; i< d_numberUnknowns;++i)
+	  {
+	    row[0]=d_deltaXHistory[k][i];
+	    row[1]=d_deltaGradientHistory[k][i];
+	    data.push_back(row);
+	  }
+
+      dftUtils::writeDataIntoFile(data,
+                                  checkpointFileName);
+  }
+
+  //
+  // load from checkpoint files.
+  //
+  void
+  lbfgsNonLinearSolver::load(const std::string & checkpointFileName)
+  {
+      std::vector<std::vector<double>> data;
+      dftUtils::readFile(2,data,checkpointFileName);
+
+      const unsigned int numPastSteps=data[0][0];
+      AssertThrow (data.size()== numPastSteps*d_numberUnknowns+1,
+	    dealii::ExcMessage (std::string("DFT-FE Error: data size of lbfgs solver checkpoint file doesn't match with number of unknowns in the problem.")));
+
+      d_deltaXHistory.clear();
+      d_deltaGradientHistory.clear();
+      d_rhoHistory.clear();
+      std::vector<double> deltaX(d_numberUnknowns), deltaGradient(d_numberUnknowns);
+      for (unsigned int k=0; k< numPastSteps;++k)
+	{
+	  for (unsigned int i=0; i< d_numberUnknowns;++i)
+	    {
+	      deltaX[i]=data[1+k*d_numberUnknowns+i][0];
+	      deltaGradient[i]=data[1+k*d_numberUnknowns+i][1];
+	    }
+	  updateHistory(deltaX,deltaGradient);
+	}
+  }
+
+  //
+  // Perform problem minimization.
+  //
+  nonLinearSolver::ReturnValueType
+  lbfgsNonLinearSolver::solve(nonlinearSolverProblem & problem,
+			      const std::string checkpointFileName,
+			      const bool restart)
+  {
+    std::vector<double> tempFuncValueVector;
+
+    //
+    // get total number of unknowns in the problem.
+    //
+    d_numberUnknowns = problem.getNumberUnknowns();
+
+    d_gradient.resize(d_numberUnknowns);
+    d_gradientNew.resize(d_numberUnknowns);
+    d_step.resize(d_numberUnknowns);
+    d_deltaXHistory.clear();
+    d_deltaGradientHistory.clear();
+    d_rhoHistory.clear();
+
+    //
+    // compute initial values of problem and problem gradient
+    //
+    problem.gradient(d_gradient);
+    problem.value(tempFuncValueVector);
+    d_value=tempFuncValueVector[0];
+
+    if (restart)
+      load(checkpointFileName);
+
+    //
+    // check for convergence
+    //
+    unsigned int isSuccess=0;
+    if (computeGradientMax() < d_tolerance)
+        isSuccess=1;
+
+    MPI_Bcast(&(isSuccess),
+	       1,
+	       MPI_INT,
+	       0,
+	       MPI_COMM_WORLD);
+    if (isSuccess==1)
+       return SUCCESS;
+
+    std::vector<double> deltaGradient(d_numberUnknowns);
+    for (d_iter = 0; d_iter < d_maxNumberIterations; ++d_iter) {
+
+      if (d_debugLevel >= 2)
+        for(unsigned int i = 0; i < d_gradient.size(); ++i)
+	  pcout<<"d_gradient: "<<d_gradient[i]<<std::endl;
+
+      if (d_debugLevel >= 1)
+	pcout << "LBFGS Iter. no. "<<d_iter+1<<", function value: "<<d_value<<", gradient max: "<<computeGradientMax()<<", history size: "<<d_deltaXHistory.size()<<std::endl;
+
+      //
+      // compute and take the quasi-Newton step
+      //
+      computeStep(problem);
+      limitStep();
+      problem.update(d_step);
+
+      problem.gradient(d_gradientNew);
+      problem.value(tempFuncValueVector);
+
+      //
+      // the step overshoots if the function value increases and the directional derivative
+      // at the new solution is positive. In that case go back half the step and reset the history
+      //
+      unsigned int isOvershoot=(tempFuncValueVector[0]>d_value && internalLBFGS::dot(d_gradientNew,d_step)>0.0)?1:0;
+      MPI_Bcast(&(isOvershoot),
+		1,
+		MPI_INT,
+		0,
+		MPI_COMM_WORLD);
+
+      if (isOvershoot==1)
+	{
+	  if (d_debugLevel >= 1)
+	    pcout << "LBFGS step overshoots- taking half step and resetting history" << std::endl;
+
+	  for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	    d_step[i]*=-0.5;
+	  problem.update(d_step);
+
+	  d_deltaXHistory.clear();
+	  d_deltaGradientHistory.clear();
+	  d_rhoHistory.clear();
+
+	  problem.gradient(d_gradient);
+	  problem.value(tempFuncValueVector);
+	  d_value=tempFuncValueVector[0];
+	}
+      else
+	{
+	  for (unsigned int i = 0; i < d_numberUnknowns; ++i)
+	    deltaGradient[i]=d_gradientNew[i]-d_gradient[i];
+	  updateHistory(d_step,deltaGradient);
+
+	  d_gradient=d_gradientNew;
+	  d_value=tempFuncValueVector[0];
+	}
+
+      if (!checkpointFileName.empty())
+      {
+           save(checkpointFileName);
+           problem.save();
+      }
+
+      //
+      // check for convergence
+      //
+      unsigned int isBreak=0;
+      if (computeGradientMax() < d_tolerance)
+	isBreak=1;
+      MPI_Bcast(&(isBreak),
+		   1,
+		   MPI_INT,
+		   0,
+		   MPI_COMM_WORLD);
+      if (isBreak==1)
+	  break;
+
+    }
+
+    //
+    // set error condition
+    //
+    ReturnValueType returnValue = SUCCESS;
+
+    if(d_iter == d_maxNumberIterations)
+      returnValue = MAX_ITER_REACHED;
+
+    //
+    // final output
+    //
+    if (d_debugLevel >= 1)
+    {
+
+      if (returnValue == SUCCESS)
+      {
+        pcout << "LBFGS solver converged after "
+		<< d_iter+1 << " iterations." << std::endl;
+      } else
+      {
+        pcout << "LBFGS solver failed to converge after "
+		<< d_iter << " iterations." << std::endl;
+      }
+
+    }
+
+    //
+    //
+    //
+    return returnValue;
+
+  }
+}
@@ -24,6 +24,7 @@
 #include "../../include/dftParameters.h"
 #include "../../include/symmetry.h"
 #include "../../include/dft.h"
+#include <boundingBoxTree.h>
 #include "symmetrizeRho.cc"
 //
 namespace dftfe {
@@ -49,23 +50,27 @@ symmetryClass<FEOrder>::symmetryClass(dftClass<FEOrder>* _dftPtr,const MPI_Comm
 template<unsigned int FEOrder>
 void symmetryClass<FEOrder>::clearMaps()
 {
- mappedGroup.clear() ;
- mappedGroupSend0.clear() ;
- mappedGroupSend1.clear() ;
- mappedGroupSend2.clear() ;
- mappedGroupRecvd0.clear() ;
- mappedGroupRecvd2.clear() ;
- mappedGroupRecvd1.clear() ;
- send_buf_size.clear() ;
- recv_buf_size.clear() ;
- rhoRecvd.clear() ;
- groupOffsets.clear() ;
- if (dftParameters::xc_id==4)
- gradRhoRecvd.clear() ;
+ locallyOwnedCells.clear() ;
+ symmRecvIndex.clear() ;
+ evalCellIds.clear() ;
+ evalCellPointsOffsets.clear() ;
+ evalCellPoints.clear() ;
+ evalCellGlobalDofIndices.clear() ;
+ evalPointsUnitCoords.clear() ;
+ evalPointsSymmId.clear() ;
+ evalPointsShapeValues.clear() ;
+ evalPointsUnitShapeGradients.clear() ;
+ evalPointsMappingShapeGradients.clear() ;
+ numEvalPoints = 0 ;
+ evalPointsSendCount.clear() ;
+ evalPointsSendOffsets.clear() ;
+ requestPointsRecvCount.clear() ;
+ requestPointsRecvOffsets.clear() ;
+ symmRecvValues.clear() ;
 }
 //================================================================================================================================================
 //================================================================================================================================================
-//			     The following is the main driver routine to generate and communicate mapping tables
+//			     The following is the main driver routine to generate the persistent symmetrization plan
 //================================================================================================================================================
 //================================================================================================================================================
 template<unsigned int FEOrder>
@@ -73,373 +78,305 @@ void symmetryClass<FEOrder>::initSymmetry()
 {
   //
   QGauss<3>  quadrature(C_num1DQuad<FEOrder>());
-  FEValues<3> fe_values (dftPtr->FEEigen, quadrature, update_values | update_gradients| update_JxW_values | update_quadrature_points);
+  FEValues<3> fe_values (dftPtr->FE, quadrature, update_quadrature_points);
   const unsigned int num_quad_points = quadrature.size();
+  const unsigned int numberNodesPerElement = dftPtr->FE.dofs_per_cell;
   Point<3> p, ptemp, p0 ;
   MappingQ1<3> mapping;
-  char buffer[100];
-  //
-  std::pair<typename parallel::distributed::Triangulation<3>::active_cell_iterator, Point<3> > mapped_cell;
-  std::tuple<int, std::vector<double>, int> tupleTemp ;
-  std::tuple< int, int, int> tupleTemp2 ;
-  std::map<CellId,int> groupId  ;
-  std::vector<double> mappedPoint(3) ;
-  std::vector<int> countGroupPerProc(dftPtr->n_mpi_processes), countPointPerProc(dftPtr->n_mpi_processes)  ;
-  std::vector<std::vector<int>> countPointsPerGroupPerProc(dftPtr->n_mpi_processes) ;
-  std::vector<std::vector<int>> tailofGroup(dftPtr->n_mpi_processes);
-  //
-  unsigned int count = 0, cell_id=0, ownerProcId ;
-  unsigned int mappedPointId ;
-  std::map<CellId, int> globalCellId_parallel ;
   //
   clearMaps() ;
 //================================================================================================================================================
-//							Allocate memory for the mapping tables
-//================================================================================================================================================
-  mappedGroup.resize(numSymm) ;
-  mappedGroupSend0.resize(numSymm) ;
-  mappedGroupSend1.resize(numSymm) ;
-  mappedGroupSend2.resize(numSymm) ;
-  mappedGroupRecvd0.resize(numSymm) ;
-  mappedGroupRecvd2.resize(numSymm) ;
-  mappedGroupRecvd1.resize(numSymm) ;
-  send_buf_size.resize(numSymm) ;
-  recv_buf_size.resize(numSymm) ;
-  rhoRecvd.resize(numSymm) ;
-  groupOffsets.resize(numSymm) ;
-  if (dftParameters::xc_id==4)
-    gradRhoRecvd.resize(numSymm) ;
-  //
-  const parallel::distributed::Triangulation<3> & triangulationSer = (dftPtr->d_mesh).getSerialMeshUnmoved();
-  typename parallel::distributed::Triangulation<3>::active_cell_iterator cellTemp = triangulationSer.begin_active(), endcTemp = triangulationSer.end();
-  for (; cellTemp!=endcTemp; ++cellTemp)
-    {
-      globalCellId[cellTemp->id()] = cell_id;
-      cell_id++ ;
-    }
-  //
-  ownerProcGlobal.resize(cell_id) ;
-  std::vector<int> ownerProc(cell_id,0);
-  for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
-  {
-    mappedGroup[iSymm] = std::vector<std::vector<std::tuple<int, int, int> >>(cell_id);
-    mappedGroupSend0[iSymm]=std::vector<std::vector<std::vector<int> >>(cell_id);
-    mappedGroupSend2[iSymm]=std::vector<std::vector<std::vector<int> >>(cell_id);
-    mappedGroupSend1[iSymm]=std::vector<std::vector<std::vector<std::vector<double>>> >(cell_id);
-    mappedGroupRecvd0[iSymm]=std::vector<std::vector<int> >(cell_id);
-    mappedGroupRecvd2[iSymm]=std::vector<std::vector<int> >(cell_id);
-    mappedGroupRecvd1[iSymm]=std::vector<std::vector<std::vector<double>> >(cell_id);
-    send_buf_size[iSymm]=std::vector<std::vector<std::vector<int>> >(cell_id);
-    recv_buf_size[iSymm]=std::vector<std::vector<std::vector<int>> >(cell_id);
-    rhoRecvd[iSymm]=std::vector<std::vector<std::vector<double>> >(cell_id);
-    groupOffsets[iSymm]=std::vector<std::vector<std::vector<int>> >(cell_id);
-    if (dftParameters::xc_id==4)
-    gradRhoRecvd[iSymm]=std::vector<std::vector<std::vector<double>> >(cell_id);
-  }
+//		Bounding box trees of the locally owned cells and of the partitions of all processors. These replace the point location
+//				on the serial triangulation, so that no data structure scales with the global number of cells
 //================================================================================================================================================
-//					     Create local and global maps to locate cells on their hosting processors
-//================================================================================================================================================
-  typename DoFHandler<3>::active_cell_iterator cell = (dftPtr->dofHandlerEigen).begin_active(), endc = (dftPtr->dofHandlerEigen).end();
-  dealii::Tensor<1, 3, double> center_diff ;
+  std::vector<vectorTools::boundingBox> locallyOwnedCellBoxes;
+  typename DoFHandler<3>::active_cell_iterator cell = (dftPtr->dofHandler).begin_active(), endc = (dftPtr->dofHandler).end();
   for(; cell!=endc; ++cell)
-  {
      if (cell->is_locally_owned())
-     {
-
-	 cellTemp = triangulationSer.begin_active(), endcTemp = triangulationSer.end();
-	 for(; cellTemp!=endcTemp; ++cellTemp) {
-	    center_diff = cellTemp->center() - cell->center() ;
-	    double pnorm = center_diff[0]*center_diff[0] + center_diff[1]*center_diff[1] + center_diff[2]*center_diff[2] ;
-	    if (pnorm < 1.0E-5 ) {
-		globalCellId_parallel[cell->id()] = globalCellId[cellTemp->id()] ;
-		break;
-	     }
+        {
+	locallyOwnedCells.push_back(cell) ;
+	locallyOwnedCellBoxes.push_back(vectorTools::cellBoundingBox(*cell)) ;
 	}
-         dealIICellId [globalCellId_parallel[cell->id()]] = cell;
-         ownerProc[globalCellId_parallel[cell->id()]] = this_mpi_process ;
-      }
-  }
   //
-  MPI_Allreduce(&ownerProc[0],
-		&ownerProcGlobal[0],
-		cell_id,
-		MPI_INT,
-		MPI_SUM,
-		mpi_communicator) ;
+  const unsigned int numLocallyOwnedCells = locallyOwnedCells.size() ;
+  std::vector<unsigned int> localCellIds(numLocallyOwnedCells) ;
+  std::iota(localCellIds.begin(),localCellIds.end(),0) ;
+  vectorTools::boundingBoxTree localCellsTree ;
+  localCellsTree.build(locallyOwnedCellBoxes,localCellIds) ;
+  //
+  vectorTools::boundingBoxTree partitionBoxesTree ;
+  vectorTools::buildPartitionBoundingBoxTree(locallyOwnedCellBoxes,
+					     32,
+					     mpi_communicator,
+					     partitionBoxesTree) ;
 //================================================================================================================================================
 //			Now enter each local cell to apply each of the symmetry operations on the quad points relevant to the cell.
-//			Then find out which cell and processor the transformed point belongs to.
-//			Next create maps of points based on symmetry operation, cell address, and processor id.  
-//================================================================================================================================================ 
-  cell = (dftPtr->dofHandlerEigen).begin_active(); endc = (dftPtr->dofHandlerEigen).end();
-  for (; cell!=endc; ++cell)
-    {
-    if (cell->is_locally_owned()) 
-      {
-        for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm) 
-          {
-	   mappedGroup[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::tuple<int, int, int> >(num_quad_points);
-	   mappedGroupRecvd1[iSymm][globalCellId_parallel[cell->id()]]=std::vector<std::vector<double>>(3);
-	   rhoRecvd[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<double>>(dftPtr->n_mpi_processes) ;
-	  }
-	  for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm) 
-              {
-	      count = 0;
-	      std::fill(countGroupPerProc.begin(),countGroupPerProc.end(),0);
-	      //
-	      send_buf_size[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<int>>(dftPtr->n_mpi_processes);
-	      //
-	      mappedGroupSend0[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<int> >(dftPtr->n_mpi_processes);
-	      mappedGroupSend2[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<int> >(dftPtr->n_mpi_processes);
-	      mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<std::vector<double>> >(dftPtr->n_mpi_processes);
-	      //
-	      for(int i = 0; i < dftPtr->n_mpi_processes; ++i) 
-		{
-		 send_buf_size[iSymm][globalCellId_parallel[cell->id()]][i] = std::vector<int>(3, 0);
-		 mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]][i] = std::vector<std::vector<double>>(3);
-		}
-              recv_buf_size[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<int>>(3);
-              recv_buf_size[iSymm][globalCellId_parallel[cell->id()]][0] = std::vector<int>(dftPtr->n_mpi_processes);
-	      recv_buf_size[iSymm][globalCellId_parallel[cell->id()]][1] = std::vector<int>(dftPtr->n_mpi_processes);
-	      recv_buf_size[iSymm][globalCellId_parallel[cell->id()]][2] = std::vector<int>(dftPtr->n_mpi_processes);
-	      //
-	      groupOffsets[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<int>>(3);
-	      groupOffsets[iSymm][globalCellId_parallel[cell->id()]][0] = std::vector<int>(dftPtr->n_mpi_processes);
-	      groupOffsets[iSymm][globalCellId_parallel[cell->id()]][1] = std::vector<int>(dftPtr->n_mpi_processes);
-	      groupOffsets[iSymm][globalCellId_parallel[cell->id()]][2] = std::vector<int>(dftPtr->n_mpi_processes);
-              //
-	      fe_values.reinit (cell);
-              for(unsigned int q_point=0; q_point<num_quad_points; ++q_point) 
-		 {
-                 p = fe_values.quadrature_point(q_point) ;
-	         p0 = crys2cart(p,-1) ;
-	         //
-                 ptemp[0] = p0[0]*symmMat[iSymm][0][0] + p0[1]*symmMat[iSymm][0][1] + p0[2]*symmMat[iSymm][0][2] ;
-                 ptemp[1] = p0[0]*symmMat[iSymm][1][0] + p0[1]*symmMat[iSymm][1][1] + p0[2]*symmMat[iSymm][1][2] ;
-                 ptemp[2] = p0[0]*symmMat[iSymm][2][0] + p0[1]*symmMat[iSymm][2][1] + p0[2]*symmMat[iSymm][2][2] ;
-		 //
-		 ptemp[0] = ptemp[0] + translation[iSymm][0] ;
-		 ptemp[1] = ptemp[1] + translation[iSymm][1] ;
-		 ptemp[2] = ptemp[2] + translation[iSymm][2] ;
-		 //
-		 for (unsigned int i=0; i<3; ++i)
-		 {
-		    while (ptemp[i] > 0.5)
-			ptemp[i] = ptemp[i] - 1.0 ;
-		    while (ptemp[i] < -0.5)
-			ptemp[i] = ptemp[i] + 1.0 ;
-		 }
-                 p = crys2cart(ptemp,1) ;
-		 //
-		 if (q_point==0)
-		     mapped_cell = GridTools::find_active_cell_around_point ( mapping, triangulationSer, p ) ;
-		 else 
-		    {
-		     double dist = 1.0E+06 ;
-		     try 
-		       {
-		       Point<3> p_cell =  mapping.transform_real_to_unit_cell( mapped_cell.first, p ) ;
-		       dist = GeometryInfo<3>::distance_to_unit_cell(p_cell);
-		       if (dist < 1.0E-10)
-			  mapped_cell.second = p_cell ;
-		       }
-		    catch (MappingQ1<3>::ExcTransformationFailed)
-		       {
-
-		       } 
-		    if (dist > 1.0E-10)
-		       mapped_cell = GridTools::find_active_cell_around_point ( mapping, triangulationSer, p ) ;
-		     }
-		 Point<3> pointTemp = mapped_cell.second;
-		 //
-		 mappedPoint[0] = pointTemp.operator()(0);
-		 mappedPoint[1] = pointTemp.operator()(1);
-		 mappedPoint[2] = pointTemp.operator()(2);
-		 //
-		 ownerProcId = ownerProcGlobal[globalCellId[mapped_cell.first->id()]] ;
-		 //
-		 tupleTemp = std::make_tuple(ownerProcId,mappedPoint,q_point);
-		 cellMapTable[mapped_cell.first->id()].push_back(tupleTemp) ;
-		 //
-		 //
-		 send_buf_size[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][1] = send_buf_size[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][1] + 1;
-		 send_buf_size[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][2] = send_buf_size[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][2] + 1;
-		 //
-	     }
-	     std::fill(countPointPerProc.begin(),countPointPerProc.end(),0);
-	     for(std::map<CellId,std::vector<std::tuple<int, std::vector<double>, int> >>::iterator iter = cellMapTable.begin(); iter != cellMapTable.end(); ++iter) 
-		 {
-		 std::vector<std::tuple<int, std::vector<double>, int> > value = iter->second;
-		 CellId key = iter->first;
-		 ownerProcId = ownerProcGlobal[globalCellId[key]] ;
-		 mappedGroupSend0[iSymm][globalCellId_parallel[cell->id()]][ownerProcId].push_back(globalCellId[key]) ;
-		 mappedGroupSend2[iSymm][globalCellId_parallel[cell->id()]][ownerProcId].push_back(value.size()) ;
-		 send_buf_size[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][0] = send_buf_size[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][0] + 1;
-		 //
-		 for (unsigned int i=0; i<value.size(); ++i) 
-		    {
-		    mappedPoint = std::get<1>(value[i]) ;
-                    int q_point = std::get<2>(value[i]) ;
-		    //
-                    tupleTemp2 = std::make_tuple(ownerProcId, 0,countPointPerProc[ownerProcId]);
-		    mappedGroup[iSymm][globalCellId_parallel[cell->id()]][q_point] = tupleTemp2 ;
-		    countPointPerProc[ownerProcId] += 1 ;
-		    //
-		    mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][0].push_back(mappedPoint[0]) ;
-		    mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][1].push_back(mappedPoint[1]) ;
-		    mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]][ownerProcId][2].push_back(mappedPoint[2]) ;
-		    }
-              }
-	      cellMapTable.clear() ;
-           }  // symmetry loop
-        }  // is cell locally owned condition
-     }  // cell loop
-  //
-  MPI_Barrier(mpi_communicator) ;
+//			Then find out the candidate processors whose partitions contain the transformed point, and create the
+//						   requests (transformed point and symmetry id) for each of them
 //================================================================================================================================================
-//			      Now first prepare the flattened sending and receiving vectors and then MPI gather.
-//		     The essential idea here is that each processor collects the transformed points from all other processors.
-//			 In symmetrizeRho.cc each processor locally computes density on its transformed points and 
-//			     then scatters them back to the processors from which the points came from. 
-//================================================================================================================================================ 
-  int recvDataSize0=0, recvDataSize1=0, send_size0, send_size1, send_size2 ;
-  std::vector<int> send_data0, send_data2, send_data3;
-  std::vector<std::vector<double>> send_data1;
-  std::vector<double>  send_data, recvdData ;
-  mpi_offsets0.resize(dftPtr->n_mpi_processes, 0) ;
-  mpi_offsets1.resize(dftPtr->n_mpi_processes, 0) ;
-  mpiGrad_offsets1.resize(dftPtr->n_mpi_processes, 0) ;
-  recv_size0.resize(dftPtr->n_mpi_processes, 0) ;
-  recv_size1.resize(dftPtr->n_mpi_processes, 0) ;
-  recvGrad_size1.resize(dftPtr->n_mpi_processes, 0) ;
-  recvdData1.resize(3);
-  send_data1.resize(3);
-  //
-  for ( unsigned int proc = 0; proc < dftPtr->n_mpi_processes; ++proc) 
+  const unsigned int numRequests = numLocallyOwnedCells*numSymm*num_quad_points ;
+  std::vector<std::vector<double> > sendPointsData(n_mpi_processes) ;
+  std::vector<std::vector<unsigned int> > sendRequestIds(n_mpi_processes) ;
+  std::vector<unsigned int> candidateProcs ;
+  for (unsigned int iLocalCell = 0; iLocalCell < numLocallyOwnedCells; ++iLocalCell)
      {
-     send_size1 = 0 ; send_size0 = 0 ;
-     cell = (dftPtr->dofHandlerEigen).begin_active();
-     for (; cell!=endc; ++cell)
-    	{
-        if (cell->is_locally_owned()) 
+     fe_values.reinit (locallyOwnedCells[iLocalCell]);
+     for (unsigned int iSymm = 0; iSymm < numSymm; ++iSymm)
+        {
+        for(unsigned int q_point=0; q_point<num_quad_points; ++q_point)
 	   {
-	   for (unsigned int iSymm = 0; iSymm < numSymm; iSymm++)
+           p = fe_values.quadrature_point(q_point) ;
+	   p0 = crys2cart(p,-1) ;
+	   //
+           ptemp[0] = p0[0]*symmMat[iSymm][0][0] + p0[1]*symmMat[iSymm][0][1] + p0[2]*symmMat[iSymm][0][2] ;
+           ptemp[1] = p0[0]*symmMat[iSymm][1][0] + p0[1]*symmMat[iSymm][1][1] + p0[2]*symmMat[iSymm][1][2] ;
+           ptemp[2] = p0[0]*symmMat[iSymm][2][0] + p0[1]*symmMat[iSymm][2][1] + p0[2]*symmMat[iSymm][2][2] ;
+	   //
+	   ptemp[0] = ptemp[0] + translation[iSymm][0] ;
+	   ptemp[1] = ptemp[1] + translation[iSymm][1] ;
+	   ptemp[2] = ptemp[2] + translation[iSymm][2] ;
+	   //
+	   for (unsigned int i=0; i<3; ++i)
+	      {
+	      while (ptemp[i] > 0.5)
+		  ptemp[i] = ptemp[i] - 1.0 ;
+	      while (ptemp[i] < -0.5)
+		  ptemp[i] = ptemp[i] + 1.0 ;
+	      }
+           p = crys2cart(ptemp,1) ;
+	   //
+	   candidateProcs.clear() ;
+	   partitionBoxesTree.findBoxesContainingPoint(p,candidateProcs) ;
+	   std::sort(candidateProcs.begin(),candidateProcs.end()) ;
+	   candidateProcs.erase(std::unique(candidateProcs.begin(),candidateProcs.end()),candidateProcs.end()) ;
+	   AssertThrow(candidateProcs.size()>0,ExcMessage("DFT-FE Error: symmetry transformed quadrature point lies outside the domain."));
+	   //
+	   const unsigned int requestId = (iLocalCell*numSymm+iSymm)*num_quad_points+q_point ;
+	   for (unsigned int i=0; i<candidateProcs.size(); ++i)
 	      {
-	      for (unsigned int iPoint = 0; iPoint < send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][1]; ++iPoint) 
-		 {
-		 //
-	         send_data1[0].push_back(mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]][proc][0][iPoint])  ;
-		 send_data1[1].push_back(mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]][proc][1][iPoint])  ;
-		 send_data1[2].push_back(mappedGroupSend1[iSymm][globalCellId_parallel[cell->id()]][proc][2][iPoint])  ;
-		 }
-	      send_size1 += send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][1] ;
-	      //
-	      for (unsigned int i = 0; i < send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][0]; ++i) 
-		 {
-	         send_data0.push_back(mappedGroupSend0[iSymm][globalCellId_parallel[cell->id()]][proc][i])  ;
-		 send_data2.push_back(mappedGroupSend2[iSymm][globalCellId_parallel[cell->id()]][proc][i])  ;
-		 send_data3.push_back(iSymm)  ;
-		 }
-	      send_size0 += send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][0] ;
-	      //
-	      rhoRecvd[iSymm][globalCellId_parallel[cell->id()]][proc].resize((1+dftParameters::spinPolarized)*send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][1]) ; // to be used later to recv symmetrized rho
+	      sendRequestIds[candidateProcs[i]].push_back(requestId) ;
+	      sendPointsData[candidateProcs[i]].push_back(p[0]) ;
+	      sendPointsData[candidateProcs[i]].push_back(p[1]) ;
+	      sendPointsData[candidateProcs[i]].push_back(p[2]) ;
+	      sendPointsData[candidateProcs[i]].push_back(iSymm) ;
 	      }
 	   }
-	}
-     //
+        }  // symmetry loop
+     }  // cell loop
+//================================================================================================================================================
+//				Exchange the requests with the candidate processors using a single all-to-all communication
+//================================================================================================================================================
+  std::vector<int> sendPointsCount(n_mpi_processes,0), recvPointsCount(n_mpi_processes,0) ;
+  for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
+     sendPointsCount[proc] = sendRequestIds[proc].size() ;
+  MPI_Alltoall(&sendPointsCount[0], 1, MPI_INT, &recvPointsCount[0], 1, MPI_INT, mpi_communicator) ;
+  //
+  std::vector<int> sendPointsOffsets(n_mpi_processes,0), recvPointsOffsets(n_mpi_processes,0) ;
+  for (unsigned int proc = 1; proc < n_mpi_processes; ++proc)
+     {
+     sendPointsOffsets[proc] = sendPointsOffsets[proc-1] + sendPointsCount[proc-1] ;
+     recvPointsOffsets[proc] = recvPointsOffsets[proc-1] + recvPointsCount[proc-1] ;
+     }
+  const unsigned int totSendPoints = std::accumulate(sendPointsCount.begin(),sendPointsCount.end(),0) ;
+  const unsigned int totRecvPoints = std::accumulate(recvPointsCount.begin(),recvPointsCount.end(),0) ;
+  //
+  std::vector<double> sendPointsDataFlattened(4*totSendPoints+1) ;
+  std::vector<int> sendCount(n_mpi_processes), sendOffsets(n_mpi_processes), recvCount(n_mpi_processes), recvOffsets(n_mpi_processes) ;
+  for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
+     {
+     std::copy(sendPointsData[proc].begin(),sendPointsData[proc].end(),sendPointsDataFlattened.begin()+4*sendPointsOffsets[proc]) ;
+     sendCount[proc] = 4*sendPointsCount[proc] ; sendOffsets[proc] = 4*sendPointsOffsets[proc] ;
+     recvCount[proc] = 4*recvPointsCount[proc] ; recvOffsets[proc] = 4*recvPointsOffsets[proc] ;
+     }
+  sendPointsData.clear() ;
+  //
+  std::vector<double> recvPointsData(4*totRecvPoints+1) ;
+  MPI_Alltoallv(&sendPointsDataFlattened[0], &sendCount[0], &sendOffsets[0], MPI_DOUBLE,
+		&recvPointsData[0], &recvCount[0], &recvOffsets[0], MPI_DOUBLE,
+		mpi_communicator) ;
+  sendPointsDataFlattened.clear() ;
+//================================================================================================================================================
+//				   Locate the received points in the locally owned cells and return the distance to the
+//				        reference cell, which is used to resolve points shared by several processors
+//================================================================================================================================================
+  std::vector<double> recvPointsDistance(totRecvPoints+1, std::numeric_limits<double>::max()) ;
+  std::vector<unsigned int> recvPointsCell(totRecvPoints, numLocallyOwnedCells) ;
+  std::vector<Point<3> > recvPointsUnitCoords(totRecvPoints) ;
+  std::vector<unsigned int> candidateCells ;
+  unsigned int previousCellId = numLocallyOwnedCells ;
+  for (unsigned int iPoint = 0; iPoint < totRecvPoints; ++iPoint)
+     {
+     const Point<3> pointTemp(recvPointsData[4*iPoint], recvPointsData[4*iPoint+1], recvPointsData[4*iPoint+2]) ;
      //
-     MPI_Gather(&send_size0,1,MPI_INT, &(recv_size0[0]),1, MPI_INT,proc,mpi_communicator);
-     MPI_Gather(&send_size1,1,MPI_INT, &(recv_size1[0]),1, MPI_INT,proc,mpi_communicator);
+     candidateCells.clear() ;
+     if (previousCellId < numLocallyOwnedCells)
+        candidateCells.push_back(previousCellId) ;
+     localCellsTree.findBoxesContainingPoint(pointTemp,candidateCells) ;
      //
-     if (proc==this_mpi_process)
-	{
-	for(int i = 1; i < dftPtr->n_mpi_processes; i++) 
+     for (unsigned int i = 0; i < candidateCells.size(); ++i)
+        {
+	try
 	   {
-           mpi_offsets0[i] = recv_size0[i-1]+ mpi_offsets0[i-1];
-	   mpi_offsets1[i] = recv_size1[i-1]+ mpi_offsets1[i-1];
+	   const Point<3> p_cell = mapping.transform_real_to_unit_cell(locallyOwnedCells[candidateCells[i]], pointTemp) ;
+	   const double dist = GeometryInfo<3>::distance_to_unit_cell(p_cell) ;
+	   if (dist < recvPointsDistance[iPoint])
+	      {
+	      recvPointsDistance[iPoint] = dist ;
+	      recvPointsCell[iPoint] = candidateCells[i] ;
+	      recvPointsUnitCoords[iPoint] = GeometryInfo<3>::project_to_unit_cell(p_cell) ;
+	      }
+	   }
+	catch (MappingQ1<3>::ExcTransformationFailed)
+	   {
+
 	   }
 	//
-        recvDataSize0 = std::accumulate(&recv_size0[0], &recv_size0[dftPtr->n_mpi_processes], 0);
-        recvdData0.resize(recvDataSize0,0);
-	recvdData2.resize(recvDataSize0,0);
-	recvdData3.resize(recvDataSize0,0);
-        //
-        recvDataSize1 = std::accumulate(&recv_size1[0], &recv_size1[dftPtr->n_mpi_processes], 0);
-	recvdData.resize(recvDataSize1,0.0) ;
-	for (unsigned int ipol=0; ipol<3; ++ipol)
-           recvdData1[ipol].resize(recvDataSize1,0.0) ;
-	}
-	//
-     MPI_Gatherv(&(send_data0[0]),send_size0,MPI_INT, &(recvdData0[0]),&(recv_size0[0]), &(mpi_offsets0[0]), MPI_INT,proc,mpi_communicator);
-     MPI_Gatherv(&(send_data2[0]),send_size0,MPI_INT, &(recvdData2[0]),&(recv_size0[0]), &(mpi_offsets0[0]), MPI_INT,proc,mpi_communicator);
-     MPI_Gatherv(&(send_data3[0]),send_size0,MPI_INT, &(recvdData3[0]),&(recv_size0[0]), &(mpi_offsets0[0]), MPI_INT,proc,mpi_communicator);
-     for (unsigned int ipol=0; ipol<3; ++ipol) 
-	{
-	send_data = send_data1[ipol] ;
-	MPI_Gatherv(&(send_data[0]),send_size1,MPI_DOUBLE, &(recvdData[0]),&(recv_size1[0]), &(mpi_offsets1[0]),  MPI_DOUBLE,proc,mpi_communicator);
-	if (proc==this_mpi_process)
-	   recvdData1[ipol] = recvdData ;
-	}
-     send_data0.clear() ; send_data.clear() ; recvdData.clear() ;
-     send_data1[0].clear(); send_data1[1].clear(); send_data1[2].clear();
-     send_data2.clear() ;
-     send_data3.clear();
+	//consecutive points mostly lie in the same cell
+	if (i==0 && recvPointsDistance[iPoint] < 1.0E-10)
+	   break ;
+        }
+     //
+     if (recvPointsCell[iPoint] < numLocallyOwnedCells)
+        previousCellId = recvPointsCell[iPoint] ;
      }
   //
-  MPI_Barrier(mpi_communicator) ;
-//================================================================================================================================================
-//			     Prepare the receiving vectors on which computed density is to be received in symmetrizeRho.cc
-//		We do this here instead of doing in symmetrizeRho.cc, because symmetrizeRho.cc is to be called during each SCF iteration
-//							So this better be a one time cost
-//================================================================================================================================================ 
-  cell = (dftPtr->dofHandlerEigen).begin_active();
-  totPoints = 0;
-  recv_size.resize(dftPtr->n_mpi_processes,0) ;
+  std::vector<unsigned int> recvPointsSymmId(totRecvPoints) ;
+  for (unsigned int iPoint = 0; iPoint < totRecvPoints; ++iPoint)
+     recvPointsSymmId[iPoint] = (unsigned int) recvPointsData[4*iPoint+3] ;
+  recvPointsData.clear() ;
   //
-  for (; cell!=endc; ++cell)
-     {
-     if (cell->is_locally_owned()) 
-	{
-        for (unsigned int iSymm=0; iSymm<numSymm; ++iSymm)
+  std::vector<double> sendPointsDistance(totSendPoints+1) ;
+  MPI_Alltoallv(&recvPointsDistance[0], &recvPointsCount[0], &recvPointsOffsets[0], MPI_DOUBLE,
+		&sendPointsDistance[0], &sendPointsCount[0], &sendPointsOffsets[0], MPI_DOUBLE,
+		mpi_communicator) ;
+//================================================================================================================================================
+//			  Each request is assigned to the processor with the closest located cell. The assignment is communicated back
+//					     so that each transformed point is evaluated by exactly one processor
+//================================================================================================================================================
+  std::vector<double> bestDistance(numRequests, std::numeric_limits<double>::max()) ;
+  std::vector<unsigned int> bestProc(numRequests, n_mpi_processes) ;
+  for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
+     for (int i = 0; i < sendPointsCount[proc]; ++i)
+        {
+	const unsigned int requestId = sendRequestIds[proc][i] ;
+	if (sendPointsDistance[sendPointsOffsets[proc]+i] < bestDistance[requestId])
 	   {
-	   rhoRecvd[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<double>>(dftPtr->n_mpi_processes) ;
-	   for (unsigned int proc=0; proc<dftPtr->n_mpi_processes; ++proc)
-	      {
-	      recv_size[proc] = recv_size[proc] + (1+dftParameters::spinPolarized)*send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][1] ;
-	      rhoRecvd[iSymm][globalCellId_parallel[cell->id()]][proc].resize((1+dftParameters::spinPolarized)*send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][1]) ;
-	      }
+	   bestDistance[requestId] = sendPointsDistance[sendPointsOffsets[proc]+i] ;
+	   bestProc[requestId] = proc ;
 	   }
         }
-     }
   //
-  for(int i = 0; i < dftPtr->n_mpi_processes; i++) 
+  symmRecvIndex.resize(numRequests) ;
+  requestPointsRecvCount.resize(n_mpi_processes,0) ;
+  requestPointsRecvOffsets.resize(n_mpi_processes,0) ;
+  std::vector<int> sendAccepted(totSendPoints+1,0) ;
+  for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
+     for (int i = 0; i < sendPointsCount[proc]; ++i)
+        if (bestProc[sendRequestIds[proc][i]] == proc)
+	   {
+	   sendAccepted[sendPointsOffsets[proc]+i] = 1 ;
+	   requestPointsRecvCount[proc] += 1 ;
+	   }
+  //
+  for (unsigned int proc = 1; proc < n_mpi_processes; ++proc)
+     requestPointsRecvOffsets[proc] = requestPointsRecvOffsets[proc-1] + requestPointsRecvCount[proc-1] ;
+  //
+  for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
      {
-     recv_size1[i] = (1 + dftParameters::spinPolarized)*recv_size1[i] ;
-     mpi_offsets1[i] = (1 + dftParameters::spinPolarized)*mpi_offsets1[i] ;
+     unsigned int count = 0 ;
+     for (int i = 0; i < sendPointsCount[proc]; ++i)
+        if (sendAccepted[sendPointsOffsets[proc]+i] == 1)
+	   {
+	   symmRecvIndex[sendRequestIds[proc][i]] = requestPointsRecvOffsets[proc] + count ;
+	   count++ ;
+	   }
      }
   //
-  if (dftParameters::xc_id==4)
-     {
-     cell = (dftPtr->dofHandlerEigen).begin_active();
-     for(int i = 0; i < dftPtr->n_mpi_processes; i++) 
+  for (unsigned int requestId = 0; requestId < numRequests; ++requestId)
+     AssertThrow(bestProc[requestId] < n_mpi_processes,ExcMessage("DFT-FE Error: could not locate symmetry transformed quadrature point."));
+  //
+  std::vector<int> recvAccepted(totRecvPoints+1,0) ;
+  MPI_Alltoallv(&sendAccepted[0], &sendPointsCount[0], &sendPointsOffsets[0], MPI_INT,
+		&recvAccepted[0], &recvPointsCount[0], &recvPointsOffsets[0], MPI_INT,
+		mpi_communicator) ;
+//================================================================================================================================================
+//			   Finally create the flat evaluation arrays. The accepted points are numbered in the order of the requesting
+//			      processors, which is the order of the send buffer. The points are then grouped by their host cell
+//================================================================================================================================================
+  evalPointsSendCount.resize(n_mpi_processes,0) ;
+  evalPointsSendOffsets.resize(n_mpi_processes,0) ;
+  std::map<unsigned int, std::vector<unsigned int> > cellToEvalPoints ;
+  for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
+     for (int i = 0; i < recvPointsCount[proc]; ++i)
         {
-        recvGrad_size1[i] = 3*recv_size1[i] ;
-        mpiGrad_offsets1[i] = 3*mpi_offsets1[i] ;
+	const unsigned int iPoint = recvPointsOffsets[proc] + i ;
+	if (recvAccepted[iPoint] == 1)
+	   {
+	   AssertThrow(recvPointsCell[iPoint] < numLocallyOwnedCells,ExcMessage("DFT-FE Error: accepted symmetry transformed point is not located on this processor."));
+	   cellToEvalPoints[recvPointsCell[iPoint]].push_back(numEvalPoints) ;
+	   evalPointsUnitCoords.push_back(recvPointsUnitCoords[iPoint][0]) ;
+	   evalPointsUnitCoords.push_back(recvPointsUnitCoords[iPoint][1]) ;
+	   evalPointsUnitCoords.push_back(recvPointsUnitCoords[iPoint][2]) ;
+	   evalPointsSymmId.push_back(recvPointsSymmId[iPoint]) ;
+	   evalPointsSendCount[proc] += 1 ;
+	   numEvalPoints++ ;
+	   }
         }
+  //
+  for (unsigned int proc = 1; proc < n_mpi_processes; ++proc)
+     evalPointsSendOffsets[proc] = evalPointsSendOffsets[proc-1] + evalPointsSendCount[proc-1] ;
+  //
+  std::vector<dealii::types::global_dof_index> cell_dof_indices(numberNodesPerElement) ;
+  evalCellPointsOffsets.push_back(0) ;
+  for (std::map<unsigned int, std::vector<unsigned int> >::const_iterator iter = cellToEvalPoints.begin(); iter != cellToEvalPoints.end(); ++iter)
+     {
+     evalCellIds.push_back(iter->first) ;
+     evalCellPoints.insert(evalCellPoints.end(),iter->second.begin(),iter->second.end()) ;
+     evalCellPointsOffsets.push_back(evalCellPoints.size()) ;
      //
-     for (; cell!=endc; ++cell)
+     locallyOwnedCells[iter->first]->get_dof_indices(cell_dof_indices) ;
+     for (unsigned int iNode = 0; iNode < numberNodesPerElement; ++iNode)
+        evalCellGlobalDofIndices.push_back(cell_dof_indices[iNode]) ;
+     }
+//================================================================================================================================================
+//		    Tabulate the shape function values and the unit cell shape function gradients at the evaluation points, in the order of
+//		    the points grouped per cell. These do not depend on the cell geometry, so only the Jacobians of the bilinear mapping
+//			        are computed from the current cell vertices in each SCF iteration to get the real space gradients
+//================================================================================================================================================
+  const bool isEvaluateGradRho = (dftParameters::xc_id == 4) ;
+  const unsigned int numberMappingNodes = GeometryInfo<3>::vertices_per_cell ;
+  FE_Q<3> feMapping(1) ;
+  evalPointsShapeValues.resize(numberNodesPerElement*numEvalPoints) ;
+  if (isEvaluateGradRho)
+     {
+     evalPointsUnitShapeGradients.resize(3*numberNodesPerElement*numEvalPoints) ;
+     evalPointsMappingShapeGradients.resize(3*numberMappingNodes*numEvalPoints) ;
+     }
+  for (unsigned int iCell = 0; iCell < evalCellIds.size(); ++iCell)
+     for (unsigned int iList = evalCellPointsOffsets[iCell]; iList < evalCellPointsOffsets[iCell+1]; ++iList)
         {
-        if (cell->is_locally_owned()) 
-           {
-           for (unsigned int iSymm=0; iSymm<numSymm; ++iSymm)
+	const unsigned int iPoint = evalCellPoints[iList] ;
+	const Point<3> unitPoint(evalPointsUnitCoords[3*iPoint], evalPointsUnitCoords[3*iPoint+1], evalPointsUnitCoords[3*iPoint+2]) ;
+	for (unsigned int iNode = 0; iNode < numberNodesPerElement; ++iNode)
+	   evalPointsShapeValues[numberNodesPerElement*iList+iNode] = dftPtr->FE.shape_value(iNode,unitPoint) ;
+	//
+	if (isEvaluateGradRho)
+	   {
+	   for (unsigned int iNode = 0; iNode < numberNodesPerElement; ++iNode)
+	      {
+	      const Tensor<1,3,double> shapeGrad = dftPtr->FE.shape_grad(iNode,unitPoint) ;
+	      for (unsigned int idim = 0; idim < 3; ++idim)
+		 evalPointsUnitShapeGradients[numberNodesPerElement*(3*iList+idim)+iNode] = shapeGrad[idim] ;
+	      }
+	   //
+	   for (unsigned int iVertex = 0; iVertex < numberMappingNodes; ++iVertex)
 	      {
-	      gradRhoRecvd[iSymm][globalCellId_parallel[cell->id()]] = std::vector<std::vector<double>>(dftPtr->n_mpi_processes) ;
-	      for (unsigned int proc=0; proc<dftPtr->n_mpi_processes; ++proc)
-	         gradRhoRecvd[iSymm][globalCellId_parallel[cell->id()]][proc].resize((1+dftParameters::spinPolarized)*3*send_buf_size[iSymm][globalCellId_parallel[cell->id()]][proc][1]) ;
+	      const Tensor<1,3,double> shapeGrad = feMapping.shape_grad(iVertex,unitPoint) ;
+	      for (unsigned int idim = 0; idim < 3; ++idim)
+		 evalPointsMappingShapeGradients[3*(numberMappingNodes*iList+iVertex)+idim] = shapeGrad[idim] ;
 	      }
-           }
+	   }
         }
-     }
   //
 }
 //============================================================================================================================================
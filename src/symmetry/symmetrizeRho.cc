@@ -26,6 +26,7 @@
 #include "../../include/symmetry.h"
 #include "../../include/dft.h"
 #include <vectorUtilities.h>
+#include <linearAlgebraOperations.h>
 //
 namespace dftfe
 {
@@ -66,26 +67,26 @@ void symmetryClass<FEOrder>::computeAndSymmetrize_rhoOut()
 //=============================================================================================================================================
 //				Loop over cell and quad point and compute density by summing over all the used symmetries
 //=============================================================================================================================================
-  typename DoFHandler<3>::active_cell_iterator cell = (dftPtr->dofHandlerEigen).begin_active(), endc = (dftPtr->dofHandlerEigen).end();
-  for (; cell!=endc; ++cell)
+  const unsigned int numSpinComponents = 1+dftParameters::spinPolarized ;
+  const unsigned int numValuesPerPoint = numSpinComponents*(dftParameters::xc_id == 4 ? 4 : 1) ;
+  for (unsigned int iLocalCell = 0; iLocalCell < locallyOwnedCells.size(); ++iLocalCell)
      {
-     if (cell->is_locally_owned())
-	{
-	(*(dftPtr->rhoOutValues))[cell->id()] = std::vector<double>(num_quad_points);
+	const dealii::CellId cellId = locallyOwnedCells[iLocalCell]->id() ;
+	(*(dftPtr->rhoOutValues))[cellId] = std::vector<double>(num_quad_points);
 	std::fill(rhoOut.begin(),rhoOut.end(),0.0);
         if(dftParameters::spinPolarized==1)
     	   {
-	      (*(dftPtr->rhoOutValuesSpinPolarized))[cell->id()] = std::vector<double>(2*num_quad_points);
+	      (*(dftPtr->rhoOutValuesSpinPolarized))[cellId] = std::vector<double>(2*num_quad_points);
               std::fill(rhoOutSpinPolarized.begin(),rhoOutSpinPolarized.end(),0.0);
 	   }
 	  //
 	if(dftParameters::xc_id == 4)
            {
-	   (*(dftPtr->gradRhoOutValues))[cell->id()] = std::vector<double>(3*num_quad_points);
+	   (*(dftPtr->gradRhoOutValues))[cellId] = std::vector<double>(3*num_quad_points);
 	   std::fill(gradRhoOut.begin(),gradRhoOut.end(),0.0);
 	   if(dftParameters::spinPolarized==1)
               {
-	      (*(dftPtr->gradRhoOutValuesSpinPolarized))[cell->id()] = std::vector<double>(6*num_quad_points);
+	      (*(dftPtr->gradRhoOutValuesSpinPolarized))[cellId] = std::vector<double>(6*num_quad_points);
 	      std::fill(gradRhoOutSpinPolarized.begin(),gradRhoOutSpinPolarized.end(),0.0);
 	      }
 	   }
@@ -94,58 +95,55 @@ void symmetryClass<FEOrder>::computeAndSymmetrize_rhoOut()
            {
 	   for(unsigned int iSymm=0; iSymm<numSymm; ++iSymm)
               {
-	      const unsigned int proc = std::get<0>(mappedGroup[iSymm][globalCellId[cell->id()]][q_point]) ;
-	      const unsigned int group = std::get<1>(mappedGroup[iSymm][globalCellId[cell->id()]][q_point]) ;
-	      const unsigned int point = std::get<2>(mappedGroup[iSymm][globalCellId[cell->id()]][q_point]) ;
+	      const double * values = &symmRecvValues[numValuesPerPoint*symmRecvIndex[(iLocalCell*numSymm+iSymm)*num_quad_points+q_point]] ;
 	      //
 	      if(dftParameters::spinPolarized==1)
                  {
-		 rhoOutSpinPolarized[2*q_point] += rhoRecvd[iSymm][globalCellId[cell->id()]][proc][2*point];
-		 rhoOutSpinPolarized[2*q_point+1] += rhoRecvd[iSymm][globalCellId[cell->id()]][proc][2*point+1];
+		 rhoOutSpinPolarized[2*q_point] += values[0];
+		 rhoOutSpinPolarized[2*q_point+1] += values[1];
 		 }
 	      else
-		 rhoOut[q_point] += rhoRecvd[iSymm][globalCellId[cell->id()]][proc][point];
+		 rhoOut[q_point] += values[0];
 		 if(dftParameters::xc_id==4)
 		    {
 		    if(dftParameters::spinPolarized==1)
                        {
                        for (unsigned int j = 0; j < 6; ++j)
-			  gradRhoOutSpinPolarized[6*q_point+j] += gradRhoRecvd[iSymm][globalCellId[cell->id()]][proc][6*point+j];
+			  gradRhoOutSpinPolarized[6*q_point+j] += values[2+j];
 		       }
 		    else
                        {
 		       for (unsigned int j = 0; j < 3; ++j)
-		           gradRhoOut[3*q_point+j] += gradRhoRecvd[iSymm][globalCellId[cell->id()]][proc][3*point+j];
+		           gradRhoOut[3*q_point+j] += values[1+j];
 		       }
                     }
 	      }
 	   if(dftParameters::spinPolarized==1)
 	      {
-	      (*(dftPtr->rhoOutValuesSpinPolarized))[cell->id()][2*q_point]=rhoOutSpinPolarized[2*q_point] ;
-	      (*(dftPtr->rhoOutValuesSpinPolarized))[cell->id()][2*q_point+1]=rhoOutSpinPolarized[2*q_point+1] ;
-	      (*(dftPtr->rhoOutValues))[cell->id()][q_point]= rhoOutSpinPolarized[2*q_point] + rhoOutSpinPolarized[2*q_point+1];
+	      (*(dftPtr->rhoOutValuesSpinPolarized))[cellId][2*q_point]=rhoOutSpinPolarized[2*q_point] ;
+	      (*(dftPtr->rhoOutValuesSpinPolarized))[cellId][2*q_point+1]=rhoOutSpinPolarized[2*q_point+1] ;
+	      (*(dftPtr->rhoOutValues))[cellId][q_point]= rhoOutSpinPolarized[2*q_point] + rhoOutSpinPolarized[2*q_point+1];
               }
 	   else
-	      (*(dftPtr->rhoOutValues))[cell->id()][q_point]  = rhoOut[q_point];
+	      (*(dftPtr->rhoOutValues))[cellId][q_point]  = rhoOut[q_point];
 	   //
 	   if(dftParameters::xc_id==4)
               {
 	      if(dftParameters::spinPolarized==1)
 		 {
 		 for (unsigned int j = 0; j < 6; ++j)
-		    (*dftPtr->gradRhoOutValuesSpinPolarized)[cell->id()][6*q_point + j] = gradRhoOutSpinPolarized[6*q_point + j];
+		    (*dftPtr->gradRhoOutValuesSpinPolarized)[cellId][6*q_point + j] = gradRhoOutSpinPolarized[6*q_point + j];
 		    //
 		    for (unsigned int j = 0; j < 3; ++j)
-		       (*dftPtr->gradRhoOutValues)[cell->id()][3*q_point + j] = gradRhoOutSpinPolarized[6*q_point + j] + gradRhoOutSpinPolarized[6*q_point + j + 3];
+		       (*dftPtr->gradRhoOutValues)[cellId][3*q_point + j] = gradRhoOutSpinPolarized[6*q_point + j] + gradRhoOutSpinPolarized[6*q_point + j + 3];
                  }
 		 else
 		    {
 		    for (unsigned int j = 0; j < 3; ++j)
-		          (*dftPtr->gradRhoOutValues)[cell->id()][3*q_point + j] = gradRhoOut[3*q_point + j];
+		          (*dftPtr->gradRhoOutValues)[cellId][3*q_point + j] = gradRhoOut[3*q_point + j];
 		    }
 	      }
 	   }
-	}
      }
 //=============================================================================================================================================
 //			Free up some memory by getting rid of density history beyond what is required by mixing scheme
@@ -188,320 +186,218 @@ void symmetryClass<FEOrder>::computeAndSymmetrize_rhoOut()
 }
 //=============================================================================================================================================
 //=============================================================================================================================================
-//				Following routine computes density at all the transformed points received from other processors
-//				        and scatters the density back to the corresponding processors
+//				Following routine computes density at all the transformed points located in the locally owned cells
+//				        and sends the density back to the requesting processors
 //=============================================================================================================================================
 //=============================================================================================================================================
 template<unsigned int FEOrder>
 void symmetryClass<FEOrder>::computeLocalrhoOut()
 {
-  std::vector<std::vector<vectorType>> eigenVectors((1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size());
-
-  const unsigned int localVectorSize = dftPtr->d_eigenVectorsFlattenedSTL[0].size()/dftPtr->d_numEigenValues;
-
-  dealii::parallel::distributed::Vector<dataTypes::number> eigenVectorsFlattenedArrayFullBlock;
-  vectorTools::createDealiiVector<dataTypes::number>(dftPtr->matrix_free_data.get_vector_partitioner(),
-						     dftPtr->d_numEigenValues,
-						     eigenVectorsFlattenedArrayFullBlock);
-
-  dftPtr->constraintsNoneDataInfo.precomputeMaps(dftPtr->matrix_free_data.get_vector_partitioner(),
-						 eigenVectorsFlattenedArrayFullBlock.get_partitioner(),
-						 dftPtr->d_numEigenValues);
-
-  for(unsigned int kPoint = 0; kPoint < (1+dftParameters::spinPolarized)*dftPtr->d_kPointWeights.size(); ++kPoint)
-     {
-     eigenVectors[kPoint].resize(dftPtr->d_numEigenValues);
-     for(unsigned int i = 0; i < dftPtr->d_numEigenValues; ++i)
-        eigenVectors[kPoint][i].reinit(dftPtr->d_tempEigenVec);
-
-     for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
-       for(unsigned int iWave = 0; iWave < dftPtr->d_numEigenValues; ++iWave)
-	 eigenVectorsFlattenedArrayFullBlock.local_element(iNode*dftPtr->d_numEigenValues+iWave)
-	   = dftPtr->d_eigenVectorsFlattenedSTL[kPoint][iNode*dftPtr->d_numEigenValues+iWave];
-
-     dftPtr->constraintsNoneDataInfo.distribute(eigenVectorsFlattenedArrayFullBlock,
-						dftPtr->d_numEigenValues);
-
-
 #ifdef USE_COMPLEX
-     vectorTools::copyFlattenedDealiiVecToSingleCompVec
-		 (eigenVectorsFlattenedArrayFullBlock,
-		  dftPtr->d_numEigenValues,
-		  std::make_pair(0,dftPtr->d_numEigenValues),
-		  dftPtr->localProc_dof_indicesReal,
-		  dftPtr->localProc_dof_indicesImag,
-		  eigenVectors[kPoint]);
+  const unsigned int numberRealComponents = 2 ;
+#else
+  const unsigned int numberRealComponents = 1 ;
 #endif
-     }
+  const unsigned int numSpinComponents = 1+dftParameters::spinPolarized ;
+  const bool isEvaluateGradRho = (dftParameters::xc_id == 4) ;
+  const unsigned int numValuesPerPoint = numSpinComponents*(isEvaluateGradRho ? 4 : 1) ;
+  const unsigned int numberNodesPerElement = dftPtr->FE.dofs_per_cell ;
+  const unsigned int numberMappingNodes = GeometryInfo<3>::vertices_per_cell ;
+  const unsigned int localVectorSize = dftPtr->d_eigenVectorsFlattenedSTL[0].size()/dftPtr->d_numEigenValues;
   //
-  QGauss<3>  quadrature(C_num1DQuad<FEOrder>());
-  const unsigned int num_quad_points = quadrature.size();
-  totPoints = recvdData1[0].size() ;
-  double px, py, pz;
-  std::vector<Vector<double> > tempPsiAlpha, tempPsiBeta ;
-  std::vector<std::vector<Tensor<1,3,double> > > tempGradPsi, tempGradPsiTempAlpha, tempGradPsiTempBeta  ;
-  std::vector<Point<3>> quadPointList ;
-  std::vector<double>  sendData, recvdData;
+  //the unoccupied tail of the states beyond the occupancy cutoff does not contribute
   //
-  std::vector<double> rhoLocal, gradRhoLocal, rhoLocalSpinPolarized, gradRhoLocalSpinPolarized ;
-  std::vector<double> rhoTemp, gradRhoTemp, rhoTempSpinPolarized, gradRhoTempSpinPolarized ;
-  rhoLocal.resize(totPoints, 0.0);
-  rhoTemp.resize(totPoints, 0.0);
+  const unsigned int numEigenVectors = dftPtr->computeNumberStatesAboveOccupancyCutoff() ;
+  const unsigned int eigenVectorsBlockSize = std::min(dftParameters::wfcBlockSize,
+						      numEigenVectors) ;
   //
-  if(dftParameters::spinPolarized==1)
-     {
-     rhoLocalSpinPolarized.resize(2*totPoints, 0.0);
-     rhoTempSpinPolarized.resize(2*totPoints, 0.0);
-     }
+  //the dof indices of the evaluation cells are stored as global indices in the plan, as the
+  //plan is created before the MatrixFree object
   //
-  if(dftParameters::xc_id == 4)
-     {
-     gradRhoLocal.resize(3*totPoints, 0.0);
-     gradRhoTemp.resize(3*totPoints, 0.0);
-     if(dftParameters::spinPolarized)
-	{
-	gradRhoLocalSpinPolarized.resize(6*totPoints, 0.0);
-	gradRhoTempSpinPolarized.resize(6*totPoints, 0.0);
-	}
-    }
-  unsigned int numPointsDone = 0, numGroupsDone = 0 ;
-  for ( unsigned int proc = 0; proc < n_mpi_processes; ++proc)
-     {
-     //
-     for ( unsigned int iGroup = 0; iGroup < recv_size0[proc] ; ++iGroup )
-        {
-        //
-	const unsigned int numPoint = recvdData2[ numGroupsDone + iGroup];
-        const unsigned int cellId =   recvdData0[ numGroupsDone + iGroup];
-        //
-        tempPsiAlpha.resize(numPoint);
-        tempPsiBeta.resize(numPoint);
-        quadPointList.resize(numPoint);
-        //
-        if(dftParameters::xc_id == 4)
-           {
-           tempGradPsi.resize(numPoint);
-	   tempGradPsiTempAlpha.resize(numPoint);
-	   tempGradPsiTempBeta.resize(numPoint);
-           }
-	for (unsigned int iList=0; iList<numPoint; ++iList)
-           {
-           //
-           px = recvdData1[0][numPointsDone+iList] ;
-           py = recvdData1[1][numPointsDone+iList] ;
-           pz = recvdData1[2][numPointsDone+iList] ;
-	   //
-           const Point<3> pointTemp(px, py, pz) ;
-           quadPointList[iList] = pointTemp;
-           tempPsiAlpha[iList].reinit(2);
-           tempPsiBeta[iList].reinit(2);
-           //
-           if(dftParameters::xc_id == 4)
-              {
-	      tempGradPsi[iList].resize(2);
-	      tempGradPsiTempAlpha[iList].resize(2);
-	      tempGradPsiTempBeta[iList].resize(2);
+  const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & partitioner = dftPtr->matrix_free_data.get_vector_partitioner() ;
+  std::vector<unsigned int> evalCellLocalProcDofIndices(evalCellGlobalDofIndices.size()) ;
+  for (unsigned int i = 0; i < evalCellGlobalDofIndices.size(); ++i)
+     evalCellLocalProcDofIndices[i] = partitioner->global_to_local(evalCellGlobalDofIndices[i]) ;
+  //
+  //inverse Jacobians of the bilinear mapping at the evaluation points on the current (possibly moved) cells,
+  //stored in the order of evalCellPoints
+  //
+  std::vector<Tensor<2,3,double> > evalPointsInverseJacobians(isEvaluateGradRho ? evalCellPoints.size() : 0) ;
+  if (isEvaluateGradRho)
+     for (unsigned int iCell = 0; iCell < evalCellIds.size(); ++iCell)
+        for (unsigned int iList = evalCellPointsOffsets[iCell]; iList < evalCellPointsOffsets[iCell+1]; ++iList)
+	   {
+	   Tensor<2,3,double> jacobian ;
+	   for (unsigned int iVertex = 0; iVertex < numberMappingNodes; ++iVertex)
+	      {
+	      const Point<3> & vertex = locallyOwnedCells[evalCellIds[iCell]]->vertex(iVertex) ;
+	      for (unsigned int i = 0; i < 3; ++i)
+		 for (unsigned int j = 0; j < 3; ++j)
+		    jacobian[i][j] += vertex[i]*evalPointsMappingShapeGradients[3*(numberMappingNodes*iList+iVertex)+j] ;
 	      }
-	   } // loop on points
-        //
-        //
-        Quadrature<3> quadRule (quadPointList) ;
-        FEValues<3> fe_values (dftPtr->FEEigen, quadRule, update_values | update_gradients| update_JxW_values | update_quadrature_points);
-        fe_values.reinit(dealIICellId[cellId]) ;
-        const unsigned int iSymm = recvdData3[numGroupsDone + iGroup] ;
-        //
-        //
+	   evalPointsInverseJacobians[iList] = invert(jacobian) ;
+	   }
+  //
+  std::vector<double> localValues(numValuesPerPoint*numEvalPoints+1, 0.0) ;
+  std::vector<double> weights, cellWaveFunctionMatrix, psiQuads, gradPsiQuads ;
+  dealii::parallel::distributed::Vector<dataTypes::number> eigenVectorsFlattenedBlock ;
+  std::shared_ptr<const vectorTools::flattenedArrayRegistry::flattenedArrayData> flattenedArrayData ;
+  const char transA = 'N', transB = 'N';
+  const double scalarCoeffAlpha = 1.0, scalarCoeffBeta = 0.0;
+  const unsigned int inc = 1;
 //=============================================================================================================================================
 //				             Sum over the star of the k point and the bands
 //				  	     Rho(r) = \sum_(n, Sk) | Psi (n, Sr + tau ) |^2
+//		     The wavefunctions are streamed in blocks of wfcBlockSize, and in each block the wavefunctions of all the points
+//					            in a cell are evaluated by one GEMM using the tabulated shape functions
 //=============================================================================================================================================
-        for(unsigned int kPoint = 0; kPoint < (dftPtr->d_kPointWeights.size()); ++kPoint)
+  for(unsigned int ivec = 0; ivec < numEigenVectors; ivec+=eigenVectorsBlockSize)
+     {
+     const unsigned int currentBlockSize = std::min(eigenVectorsBlockSize,numEigenVectors-ivec) ;
+     const unsigned int numberColumns = numberRealComponents*currentBlockSize ;
+     //
+     if (currentBlockSize!=eigenVectorsBlockSize || ivec==0)
+        {
+	flattenedArrayData = dftPtr->d_flattenedArrayRegistry.getFlattenedArrayData(dftPtr->matrix_free_data,
+										   currentBlockSize) ;
+	eigenVectorsFlattenedBlock.reinit(flattenedArrayData->partitioner) ;
+	eigenVectorsFlattenedBlock = dataTypes::number(0.0) ;
+	dftPtr->constraintsNoneDataInfo.precomputeMaps(flattenedArrayData->localIndexMapUnflattenedToFlattened) ;
+	//
+	weights.resize(numberColumns) ;
+	cellWaveFunctionMatrix.resize(numberColumns*numberNodesPerElement) ;
+        }
+     const std::vector<unsigned int> & localIndexMapUnflattenedToFlattened = *(flattenedArrayData->localIndexMapUnflattenedToFlattened) ;
+     //
+     for(unsigned int kPoint = 0; kPoint < (dftPtr->d_kPointWeights.size()); ++kPoint)
+        for(unsigned int spinIndex = 0; spinIndex < numSpinComponents; ++spinIndex)
            {
-           if (symmUnderGroup[kPoint][iSymm] ==1)
-              {
-	      for(unsigned int i=0; i<(dftPtr->d_numEigenValues); ++i)
+	   for(unsigned int iNode = 0; iNode < localVectorSize; ++iNode)
+	     for(unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
+	       eigenVectorsFlattenedBlock.local_element(iNode*currentBlockSize+iWave)
+		 = dftPtr->d_eigenVectorsFlattenedSTL[numSpinComponents*kPoint+spinIndex][iNode*dftPtr->d_numEigenValues+ivec+iWave];
+
+	   dftPtr->constraintsNoneDataInfo.distribute(eigenVectorsFlattenedBlock,
+						      currentBlockSize);
+	   eigenVectorsFlattenedBlock.update_ghost_values();
+	   //
+	   for(unsigned int iWave = 0; iWave < currentBlockSize; ++iWave)
+	      {
+	      const double eigenValue = (dftPtr->eigenValues)[kPoint][ivec+iWave+spinIndex*(dftPtr->d_numEigenValues)] ;
+	      const double factor=(eigenValue-(dftPtr->fermiEnergy))/(C_kb*dftParameters::TVal);
+	      double partialOccupancy = getOccupancy(factor) ;
+	      if(dftParameters::constraintMagnetization)
+		 partialOccupancy = (eigenValue > (spinIndex==0 ? dftPtr->fermiEnergyUp : dftPtr->fermiEnergyDown)) ? 0.0 : 1.0 ;
+	      //
+	      for (unsigned int icomp = 0; icomp < numberRealComponents; ++icomp)
+		 weights[numberRealComponents*iWave+icomp] = 1.0 / (double(numSymmUnderGroup[kPoint])) *
+							      (dftParameters::spinPolarized==1 ? 1.0 : 2.0)*partialOccupancy*(dftPtr->d_kPointWeights)[kPoint] ;
+	      }
+	   //
+	   const double * flattenedArray = reinterpret_cast<const double *>(eigenVectorsFlattenedBlock.begin()) ;
+	   for (unsigned int iCell = 0; iCell < evalCellIds.size(); ++iCell)
+	      {
+	      const unsigned int numPoint = evalCellPointsOffsets[iCell+1]-evalCellPointsOffsets[iCell] ;
+	      const unsigned int * cellPoints = &evalCellPoints[evalCellPointsOffsets[iCell]] ;
+	      //
+	      //gather the (nodes x block) cell wavefunction matrix
+	      for(unsigned int iNode = 0; iNode < numberNodesPerElement; ++iNode)
+		 dcopy_(&numberColumns,
+			flattenedArray+numberRealComponents*localIndexMapUnflattenedToFlattened[evalCellLocalProcDofIndices[numberNodesPerElement*iCell+iNode]],
+			&inc,
+			&cellWaveFunctionMatrix[numberColumns*iNode],
+			&inc);
+	      //
+	      psiQuads.resize(numberColumns*numPoint) ;
+	      dgemm_(&transA,
+		     &transB,
+		     &numberColumns,
+		     &numPoint,
+		     &numberNodesPerElement,
+		     &scalarCoeffAlpha,
+		     &cellWaveFunctionMatrix[0],
+		     &numberColumns,
+		     &evalPointsShapeValues[numberNodesPerElement*evalCellPointsOffsets[iCell]],
+		     &numberNodesPerElement,
+		     &scalarCoeffBeta,
+		     &psiQuads[0],
+		     &numberColumns);
+	      //
+	      //gradients with respect to the unit cell coordinates
+	      if (isEvaluateGradRho)
 		 {
-		 double factor=((dftPtr->eigenValues)[kPoint][i]-(dftPtr->fermiEnergy))/(C_kb*dftParameters::TVal);
-		 double partialOccupancyAlpha = getOccupancy(factor) ;
-		 //
-		 factor=((dftPtr->eigenValues)[kPoint][i+dftParameters::spinPolarized*(dftPtr->d_numEigenValues)]-(dftPtr->fermiEnergy))/(C_kb*dftParameters::TVal);
-		 double partialOccupancyBeta = getOccupancy(factor) ;
-		 //
-		 if(dftParameters::constraintMagnetization)
-			{
-			partialOccupancyAlpha = 1.0 , partialOccupancyBeta = 1.0 ;
-			if ((dftPtr->eigenValues)[kPoint][i+dftParameters::spinPolarized*(dftPtr->d_numEigenValues)] > (dftPtr->fermiEnergyDown))
-				partialOccupancyBeta = 0.0 ;
-			if ((dftPtr->eigenValues)[kPoint][i] > (dftPtr->fermiEnergyUp))
-				partialOccupancyAlpha = 0.0 ;
-			}
-		 //
-		 fe_values.get_function_values((eigenVectors[(1+dftParameters::spinPolarized)*kPoint][i]), tempPsiAlpha);
-		 if (dftParameters::spinPolarized==1)
-		     fe_values.get_function_values((eigenVectors[(1+dftParameters::spinPolarized)*kPoint+1][i]), tempPsiBeta);
+		 const unsigned int numberGradRows = 3*numPoint ;
+		 gradPsiQuads.resize(numberColumns*numberGradRows) ;
+		 dgemm_(&transA,
+			&transB,
+			&numberColumns,
+			&numberGradRows,
+			&numberNodesPerElement,
+			&scalarCoeffAlpha,
+			&cellWaveFunctionMatrix[0],
+			&numberColumns,
+			&evalPointsUnitShapeGradients[3*numberNodesPerElement*evalCellPointsOffsets[iCell]],
+			&numberNodesPerElement,
+			&scalarCoeffBeta,
+			&gradPsiQuads[0],
+			&numberColumns);
+		 }
+	      //
+	      for (unsigned int iList=0; iList<numPoint; ++iList)
+		 {
+		 const unsigned int iSymm = evalPointsSymmId[cellPoints[iList]] ;
+		 if (symmUnderGroup[kPoint][iSymm] !=1)
+		    continue ;
 		 //
-		 if(dftParameters::xc_id == 4)
-                    {
-			   fe_values.get_function_gradients((eigenVectors[(1+dftParameters::spinPolarized)*kPoint][i]),tempGradPsiTempAlpha);
-			   if (dftParameters::spinPolarized==1)
-			   fe_values.get_function_gradients((eigenVectors[(1+dftParameters::spinPolarized)*kPoint+1][i]),tempGradPsiTempBeta);
+		 double * values = &localValues[numValuesPerPoint*cellPoints[iList]] ;
+		 const double * psiQuad = &psiQuads[numberColumns*iList] ;
+		 double rho = 0.0, gradRhoUnit[3] = {0.0, 0.0, 0.0} ;
+		 for (unsigned int j = 0; j < numberColumns; ++j)
+		    {
+		    const double weightTimesPsi = weights[j]*psiQuad[j] ;
+		    rho += weightTimesPsi*psiQuad[j] ;
+		    if (isEvaluateGradRho)
+		       for (unsigned int idim = 0; idim < 3; ++idim)
+			  gradRhoUnit[idim] += weightTimesPsi*gradPsiQuads[numberColumns*(3*iList+idim)+j] ;
 		    }
 		 //
-		 for (unsigned int iList=0; iList<numPoint; ++iList)
-                    {
-		    //
-		    if (dftParameters::spinPolarized==1)
-                       {
-		       rhoTempSpinPolarized[2*(numPointsDone+iList)] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-							                partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempPsiAlpha[iList](0) +
-							                tempPsiAlpha[iList](1)*tempPsiAlpha[iList](1));
-		       rhoTempSpinPolarized[2*(numPointsDone+iList)+1] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-							                  partialOccupancyBeta*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiBeta[iList](0)*tempPsiBeta[iList](0) +
-                                                                          tempPsiBeta[iList](1)*tempPsiBeta[iList](1));
-		       }
-		    else
-		       rhoTemp[numPointsDone+iList] += 1.0 / (double(numSymmUnderGroup[kPoint]))  *
-					               2.0*partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempPsiAlpha[iList](0) +
-					               tempPsiAlpha[iList](1)*tempPsiAlpha[iList](1));
-		    if(dftParameters::xc_id == 4)
-                       {
+		 values[spinIndex] += rho ;
+		 //
+		 //real space gradient of the density at the symmetry transformed point rotated back by the symmetry operation
+		 if (isEvaluateGradRho)
+		    {
+		    const Tensor<2,3,double> & inverseJacobian = evalPointsInverseJacobians[evalCellPointsOffsets[iCell]+iList] ;
+		    double gradRho[3] = {0.0, 0.0, 0.0} ;
+		    for (unsigned int i = 0; i < 3; ++i)
 		       for (unsigned int j = 0; j < 3; ++j)
-                          {
-			  tempGradPsi[iList][0][j]= tempGradPsiTempAlpha[iList][0][0]*symmMat[iSymm][0][j] + tempGradPsiTempAlpha[iList][0][1]*symmMat[iSymm][1][j] +
-						   tempGradPsiTempAlpha[iList][0][2]*symmMat[iSymm][2][j] ;
-			  tempGradPsi[iList][1][j]= tempGradPsiTempAlpha[iList][1][0]*symmMat[iSymm][0][j] + tempGradPsiTempAlpha[iList][1][1]*symmMat[iSymm][1][j] +
-						   tempGradPsiTempAlpha[iList][1][2]*symmMat[iSymm][2][j] ;
-			  }
-		       if (dftParameters::spinPolarized==1)
-                          {
-			  gradRhoTempSpinPolarized[6*(numPointsDone+iList) + 0] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                                   2.0*partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempGradPsi[iList][0][0] +
-										   tempPsiAlpha[iList](1)*tempGradPsi[iList][1][0]);
-			  gradRhoTempSpinPolarized[6*(numPointsDone+iList) + 1] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                                   2.0*partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempGradPsi[iList][0][1] +
-										   tempPsiAlpha[iList](1)*tempGradPsi[iList][1][1]);
-			  gradRhoTempSpinPolarized[6*(numPointsDone+iList) + 2] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                                   2.0*partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempGradPsi[iList][0][2] +
-										   tempPsiAlpha[iList](1)*tempGradPsi[iList][1][2]);
-		          for (unsigned int j = 0; j < 3; ++j)
-                             {
-			     tempGradPsi[iList][0][j]= tempGradPsiTempBeta[iList][0][0]*symmMat[iSymm][0][j] + tempGradPsiTempBeta[iList][0][1]*symmMat[iSymm][1][j] +
-						       tempGradPsiTempBeta[iList][0][2]*symmMat[iSymm][2][j] ;
-			     tempGradPsi[iList][1][j]= tempGradPsiTempBeta[iList][1][0]*symmMat[iSymm][0][j] + tempGradPsiTempBeta[iList][1][1]*symmMat[iSymm][1][j] +
-				                       tempGradPsiTempBeta[iList][1][2]*symmMat[iSymm][2][j] ;
-			     }
-			  //
-			  gradRhoTempSpinPolarized[6*(numPointsDone+iList) + 3] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                                   2.0*partialOccupancyBeta*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiBeta[iList](0)*tempGradPsi[iList][0][0] +
-										   tempPsiBeta[iList](1)*tempGradPsi[iList][1][0]);
-			  gradRhoTempSpinPolarized[6*(numPointsDone+iList) + 4] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                                   2.0*partialOccupancyBeta*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiBeta[iList](0)*tempGradPsi[iList][0][1] +
-										   tempPsiBeta[iList](1)*tempGradPsi[iList][1][1]);
-			  gradRhoTempSpinPolarized[6*(numPointsDone+iList) + 5] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                                   2.0*partialOccupancyBeta*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiBeta[iList](0)*tempGradPsi[iList][0][2] +
-										   tempPsiBeta[iList](1)*tempGradPsi[iList][1][2]);
-			   }
-		       else
-                          {
-			  gradRhoTemp[3*(numPointsDone+iList) + 0] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                      2.0*2.0*partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempGradPsi[iList][0][0] +
-								      tempPsiAlpha[iList](1)*tempGradPsi[iList][1][0]);
-			  gradRhoTemp[3*(numPointsDone+iList) + 1] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                      2.0*2.0*partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempGradPsi[iList][0][1] +
-								      tempPsiAlpha[iList](1)*tempGradPsi[iList][1][1]);
-			  gradRhoTemp[3*(numPointsDone+iList) + 2] += 1.0 / (double(numSymmUnderGroup[kPoint])) *
-						                      2.0*2.0*partialOccupancyAlpha*(dftPtr->d_kPointWeights)[kPoint]*(tempPsiAlpha[iList](0)*tempGradPsi[iList][0][2] +
-								      tempPsiAlpha[iList](1)*tempGradPsi[iList][1][2]);
-		          }
-		       }
-		    } // loop on points list
-		 } // loop on eigenValues
-              } // if this symm is part of the group under this kpoint
-	   } // loop on k Points
-        //
-        numPointsDone += numPoint ;
-        }   // loop on group
-     //
-     numGroupsDone += recv_size0[proc] ;
-     } // loop on proc
+			  gradRho[i] += inverseJacobian[j][i]*gradRhoUnit[j] ;
+		    //
+		    for (unsigned int j = 0; j < 3; ++j)
+		       values[numSpinComponents+3*spinIndex+j] += 2.0*(gradRho[0]*symmMat[iSymm][0][j] + gradRho[1]*symmMat[iSymm][1][j] +
+								       gradRho[2]*symmMat[iSymm][2][j]) ;
+		    }
+		 } // loop on points list
+	      } // loop on cells
+           } // loop on k Points and spin
+     } // loop on blocks
   //
-  MPI_Allreduce(&rhoTemp[0], &rhoLocal[0], totPoints, MPI_DOUBLE, MPI_SUM, interpoolcomm) ;
-  if (dftParameters::xc_id==4)
-     MPI_Allreduce(&gradRhoTemp[0], &gradRhoLocal[0], 3*totPoints, MPI_DOUBLE, MPI_SUM, interpoolcomm) ;
-  if (dftParameters::spinPolarized==1)
-     {
-     MPI_Allreduce(&rhoTempSpinPolarized[0], &rhoLocalSpinPolarized[0], 2*totPoints, MPI_DOUBLE, MPI_SUM, interpoolcomm) ;
-     if (dftParameters::xc_id==4)
-	MPI_Allreduce(&gradRhoTempSpinPolarized[0], &gradRhoLocalSpinPolarized[0], 6*totPoints, MPI_DOUBLE, MPI_SUM, interpoolcomm) ;
-     }
+  MPI_Allreduce(MPI_IN_PLACE, &localValues[0], numValuesPerPoint*numEvalPoints, MPI_DOUBLE, MPI_SUM, interpoolcomm) ;
 //================================================================================================================================================
-//			      Now first prepare the flattened sending vectors and then MPI scatter.
-//		         The essential idea here is that each processor sends the computed density on the transformed points
-//                                back to all other processors.from which the points came from.
+//			     Now send the computed density on the transformed points back to the processors from which the
+//				       points came from, using the precomputed counts and offsets in a single all-to-all
 //================================================================================================================================================
-  sendData.resize((1+dftParameters::spinPolarized)*totPoints) ;
-  if (dftParameters::spinPolarized==1)
-      sendData = rhoLocalSpinPolarized ;
-  else
-      sendData = rhoLocal ;
-  //
-  typename DoFHandler<3>::active_cell_iterator cell ;
-  typename DoFHandler<3>::active_cell_iterator endc = (dftPtr->dofHandlerEigen).end();
-  //
-  for ( int sendProc = 0; sendProc<n_mpi_processes; ++sendProc)
+  std::vector<int> sendCount(n_mpi_processes), sendOffsets(n_mpi_processes), recvCount(n_mpi_processes), recvOffsets(n_mpi_processes) ;
+  for (unsigned int proc = 0; proc < n_mpi_processes; ++proc)
      {
-     recvdData.resize(recv_size[sendProc]);
-     MPI_Scatterv(&(sendData[0]),&(recv_size1[0]), &(mpi_offsets1[0]), MPI_DOUBLE, &(recvdData[0]), recv_size[sendProc], MPI_DOUBLE,sendProc,mpi_communicator);
-     //
-     cell = (dftPtr->dofHandlerEigen).begin_active();
-     unsigned int offset = 0 ;
-     for (; cell!=endc; ++cell)
-        {
-        if (cell->is_locally_owned())
-           {
-           for (unsigned int iSymm=0; iSymm<numSymm; ++iSymm)
-              {
-	      for ( unsigned int i=0; i<rhoRecvd[iSymm][globalCellId[cell->id()]][sendProc].size(); ++i)
-		 rhoRecvd[iSymm][globalCellId[cell->id()]][sendProc][i] = recvdData [ offset + i]  ;
-              //
-	      offset += rhoRecvd[iSymm][globalCellId[cell->id()]][sendProc].size();
-	      }
-           }
-	}
-	recvdData.clear();
+     sendCount[proc] = numValuesPerPoint*evalPointsSendCount[proc] ;
+     sendOffsets[proc] = numValuesPerPoint*evalPointsSendOffsets[proc] ;
+     recvCount[proc] = numValuesPerPoint*requestPointsRecvCount[proc] ;
+     recvOffsets[proc] = numValuesPerPoint*requestPointsRecvOffsets[proc] ;
      }
   //
-  if (dftParameters::xc_id==4)
-     {
-     sendData.resize(3*(1+dftParameters::spinPolarized)*totPoints) ;
-     if (dftParameters::spinPolarized==1)
-        sendData = gradRhoLocalSpinPolarized ;
-     else
-	sendData = gradRhoLocal ;
-     //
-     for ( int sendProc = 0; sendProc<n_mpi_processes; ++sendProc)
-        {
-        recvdData.resize(3*recv_size[sendProc]);
-	MPI_Scatterv(&(sendData[0]),&(recvGrad_size1[0]), &(mpiGrad_offsets1[0]), MPI_DOUBLE, &(recvdData[0]), 3*recv_size[sendProc], MPI_DOUBLE,sendProc,mpi_communicator);
-	//
-	cell = (dftPtr->dofHandlerEigen).begin_active();
-	unsigned int offset = 0 ;
-        //
-        for (; cell!=endc; ++cell)
-           {
-	   if (cell->is_locally_owned())
-              {
-              for (unsigned int iSymm=0; iSymm<numSymm; ++iSymm)
-                 {
-		 for ( unsigned int i=0; i<gradRhoRecvd[iSymm][globalCellId[cell->id()]][sendProc].size(); ++i)
-		    gradRhoRecvd[iSymm][globalCellId[cell->id()]][sendProc][i] = recvdData [ offset + i]  ;
-                 //
-		 offset += gradRhoRecvd[iSymm][globalCellId[cell->id()]][sendProc].size();
-	         }
-	      }
-	    }
-	recvdData.clear();
-	}
-     }
+  symmRecvValues.resize(numValuesPerPoint*symmRecvIndex.size()+1) ;
+  MPI_Alltoallv(&localValues[0], &sendCount[0], &sendOffsets[0], MPI_DOUBLE,
+		&symmRecvValues[0], &recvCount[0], &recvOffsets[0], MPI_DOUBLE,
+		mpi_communicator) ;
 } // end function
 } // end namespace
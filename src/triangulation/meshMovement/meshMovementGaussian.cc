@@ -18,6 +18,8 @@
 //
 #include <meshMovementGaussian.h>
 #include <dftParameters.h>
+#include <boundingBoxTree.h>
+#include <algorithm>
 
 namespace dftfe {
 
@@ -108,10 +110,26 @@ void meshMovementGaussianClass::computeIncrementTwoStep(const std::vector<Point<
 				    false);
 
    std::vector<Point<C_DIM> > nodalCoordinatesUpdated(d_dofHandlerMoveMesh.get_triangulation().n_vertices());
+
+   //only the control points whose Gaussian support, pruned where the Gaussian weight falls below
+   //a tolerance, intersects a cell contribute to the displacement of the cell vertices
+   const unsigned int exponent=dftParameters::reproducible_output?2:4;
+   vectorTools::boundingBoxTree controlPointsSupportTreeInitialMove;
+   vectorTools::buildControlPointsSupportTree(controlPointLocationsInitialMove,
+	                                      vectorTools::gaussianGeneratorSupportRadius(controllingParameterInitialMove,
+						                                          exponent),
+					      controlPointsSupportTreeInitialMove);
+   std::vector<unsigned int> cellCandidateControlPoints;
+
    DoFHandler<3>::active_cell_iterator cell = d_dofHandlerMoveMesh.begin_active(), endc = d_dofHandlerMoveMesh.end();
 
    for(; cell!=endc; ++cell)
      if(!cell->is_artificial())
+     {
+       vectorTools::findCellControlPointCandidates(*cell,
+	                                           controlPointsSupportTreeInitialMove,
+						   0.0,
+						   cellCandidateControlPoints);
        for(unsigned int i=0; i<vertices_per_cell; ++i)
 	 {
 	   const unsigned global_vertex_no = cell->vertex_index(i);
@@ -130,8 +148,9 @@ void meshMovementGaussianClass::computeIncrementTwoStep(const std::vector<Point<
 	   int overlappedControlPointId=-1;
 
 	   //check for case where control point locations coincide with nodal vertex locations
-	   for(unsigned int jControl = 0; jControl < controlPointLocationsInitialMove.size(); jControl++)
+	   for(unsigned int jCandidate = 0; jCandidate < cellCandidateControlPoints.size(); jCandidate++)
 	     {
+	       const unsigned int jControl=cellCandidateControlPoints[jCandidate];
 	       const double distance=(nodalCoor-controlPointLocationsInitialMove[jControl]).norm();
 	       if (distance < 1e-5)
 		 {
@@ -140,8 +159,9 @@ void meshMovementGaussianClass::computeIncrementTwoStep(const std::vector<Point<
 		 }
 	     }
 	   
-	   for(unsigned int iControl=0;iControl <controlPointLocationsInitialMove.size(); iControl++)
+	   for(unsigned int iCandidate=0;iCandidate <cellCandidateControlPoints.size(); iCandidate++)
 	     {
+	       const unsigned int iControl=cellCandidateControlPoints[iCandidate];
 	       if(overlappedControlPointId != iControl && overlappedControlPointId != -1)
 		 continue;
 
@@ -167,7 +187,17 @@ void meshMovementGaussianClass::computeIncrementTwoStep(const std::vector<Point<
 	     }
 
 	 }
+     }
+
 
+    //the vertices have moved in the first stage, so the candidate control points are found
+    //for each updated vertex location
+    vectorTools::boundingBoxTree controlPointsSupportTreeCurrentMove;
+    vectorTools::buildControlPointsSupportTree(controlPointLocationsCurrentMove,
+	                                       vectorTools::gaussianGeneratorSupportRadius(controllingParameterCurrentMove,
+						                                           exponent),
+					       controlPointsSupportTreeCurrentMove);
+    std::vector<unsigned int> vertexCandidateControlPoints;
 
     DoFHandler<3>::active_cell_iterator cellStep2 = d_dofHandlerMoveMesh.begin_active(), endcStep2 = d_dofHandlerMoveMesh.end();
     std::vector<bool> vertex_touchedNew(d_dofHandlerMoveMesh.get_triangulation().n_vertices(),
@@ -183,9 +213,16 @@ void meshMovementGaussianClass::computeIncrementTwoStep(const std::vector<Point<
 	      continue;
 
 	    vertex_touchedNew[global_vertex_no] = true;
+
+	    vertexCandidateControlPoints.clear();
+	    controlPointsSupportTreeCurrentMove.findBoxesContainingPoint(nodalCoordinatesUpdated[global_vertex_no],
+		                                                         vertexCandidateControlPoints);
+	    std::sort(vertexCandidateControlPoints.begin(),vertexCandidateControlPoints.end());
+
 	    int overlappedControlPointId=-1;
-	    for(unsigned int jControl = 0; jControl < controlPointLocationsCurrentMove.size(); jControl++)
+	    for(unsigned int jCandidate = 0; jCandidate < vertexCandidateControlPoints.size(); jCandidate++)
 	     {
+	       const unsigned int jControl=vertexCandidateControlPoints[jCandidate];
 	       const double distance=(nodalCoordinatesUpdated[global_vertex_no]-controlPointLocationsCurrentMove[jControl]).norm();
 	       if (distance < 1e-5)
 		 {
@@ -194,8 +231,9 @@ void meshMovementGaussianClass::computeIncrementTwoStep(const std::vector<Point<
 		 }
 	     }
 
-	    for(unsigned int iControl = 0;iControl < controlPointLocationsCurrentMove.size(); iControl++)
+	    for(unsigned int iCandidate = 0;iCandidate < vertexCandidateControlPoints.size(); iCandidate++)
 	      {
+		const unsigned int iControl=vertexCandidateControlPoints[iCandidate];
 		if(overlappedControlPointId != iControl && overlappedControlPointId != -1)
 		  continue;
 
@@ -231,11 +269,26 @@ void meshMovementGaussianClass::computeIncrement()
   unsigned int vertices_per_cell=GeometryInfo<C_DIM>::vertices_per_cell;
   std::vector<bool> vertex_touched(d_dofHandlerMoveMesh.get_triangulation().n_vertices(),
 				   false);
+
+  //only the control points whose Gaussian support, pruned where the Gaussian weight falls below
+  //a tolerance, intersects a cell contribute to the displacement of the cell vertices
+  vectorTools::boundingBoxTree controlPointsSupportTree;
+  vectorTools::buildControlPointsSupportTree(d_controlPointLocations,
+	                                     vectorTools::gaussianGeneratorSupportRadius(d_controllingParameter,
+						                                         dftParameters::reproducible_output?2:4),
+					     controlPointsSupportTree);
+  std::vector<unsigned int> cellCandidateControlPoints;
+
   DoFHandler<3>::active_cell_iterator
   cell = d_dofHandlerMoveMesh.begin_active(),
   endc = d_dofHandlerMoveMesh.end();
   for (; cell!=endc; ++cell)
    if (!cell->is_artificial())
+   {
+    vectorTools::findCellControlPointCandidates(*cell,
+	                                        controlPointsSupportTree,
+						0.0,
+						cellCandidateControlPoints);
     for (unsigned int i=0; i<vertices_per_cell; ++i)
     {
 	const unsigned global_vertex_no = cell->vertex_index(i);
@@ -246,8 +299,9 @@ void meshMovementGaussianClass::computeIncrement()
 	Point<C_DIM> nodalCoor = cell->vertex(i);
 
 	int overlappedControlPointId=-1;
-	for(unsigned int jControl=0;jControl <d_controlPointLocations.size(); jControl++)
+	for(unsigned int jCandidate=0;jCandidate <cellCandidateControlPoints.size(); jCandidate++)
 	  {
+	    const unsigned int jControl=cellCandidateControlPoints[jCandidate];
 	    const double distance=(nodalCoor-d_controlPointLocations[jControl]).norm();
 	    if (distance < 1e-5)
 	      {
@@ -256,8 +310,9 @@ void meshMovementGaussianClass::computeIncrement()
 	      }
 	  }
 
-	for(unsigned int iControl=0;iControl <d_controlPointLocations.size(); iControl++)
+	for(unsigned int iCandidate=0;iCandidate <cellCandidateControlPoints.size(); iCandidate++)
 	  {
+	    const unsigned int iControl=cellCandidateControlPoints[iCandidate];
 	    if (overlappedControlPointId!=iControl && overlappedControlPointId!=-1)
 	      {
 		//std::cout<< " overlappedControlPointId: "<< overlappedControlPointId << std::endl;
@@ -278,6 +333,7 @@ void meshMovementGaussianClass::computeIncrement()
 	      }
 	  }
      }
+   }
 }
 
 }
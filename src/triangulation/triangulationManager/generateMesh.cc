@@ -1351,6 +1351,8 @@ namespace dftfe {
 	       if (dftParameters::verbosity>=4)
 	           pcout<< "Hanging node and periodic constraints parallel consistency not achieved."<<std::endl;
 
+	       AssertThrow(!dftParameters::fullyDistributedMesh,ExcMessage("DFT-FE Error: hanging node and periodic constraints parallel consistency could not be achieved on the distributed triangulation, which requires creating the constraints from the serial triangulation. Please set FULLY DISTRIBUTED MESH to false."));
+
 	       dftParameters::createConstraintsFromSerialDofhandler=true;
 	   }
 	}
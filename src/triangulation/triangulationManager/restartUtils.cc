@@ -49,18 +49,6 @@ namespace dftfe {
 
          d_parallelTriangulationUnmovedPrevious.save(filename2.c_str());
        }
-
-       if (d_serialTriangulationUnmovedPrevious.n_global_active_cells()!=0 && this_mpi_process==0)
-       {
-         const std::string filename3="serialUnmovedPrevTria.chk";
-	 if (std::ifstream(filename3) && this_mpi_process==0)
-	 {
-	      dftUtils::moveFile(filename3, filename3+".old");
-	      dftUtils::moveFile(filename3+".info", filename3+".info.old");
-	 }
-
-         d_serialTriangulationUnmovedPrevious.save(filename3.c_str());
-       }
     }
 
     //
@@ -93,20 +81,6 @@ namespace dftfe {
 	   AssertThrow(false, ExcMessage("DFT-FE Error: Cannot open checkpoint file- parallelUmmovedPrevTria.chk or read the triangulation stored there."));
          }
        }
-
-       if (d_serialTriangulationUnmovedPrevious.n_global_active_cells()!=0)
-       {
-         const std::string filename3="serialUnmovedPrevTria.chk";
-	 dftUtils::verifyCheckpointFileExists(filename3);
-         try
-         {
-	    d_serialTriangulationUnmovedPrevious.load(filename3.c_str(),false);
-         }
-         catch (...)
-         {
-	    AssertThrow(false, ExcMessage("DFT-FE Error: Cannot open checkpoint file- serialUnmovedPrevTria.chk or read the triangulation stored there."));
-         }
-       }
     }
 
     //
@@ -45,11 +45,11 @@ namespace dftfe {
     d_triangulationElectrostaticsRho(mpi_comm_replica),
     d_triangulationElectrostaticsDisp(mpi_comm_replica),
     d_triangulationElectrostaticsForce(mpi_comm_replica),
+    d_triangulationElectrostaticsSubdivided(mpi_comm_replica),
     mpi_communicator (mpi_comm_replica),
     interpoolcomm(interpoolcomm),
     interBandGroupComm(interbandgroup_comm),
     d_serialTriangulationUnmoved(MPI_COMM_SELF),
-    d_serialTriangulationUnmovedPrevious(MPI_COMM_SELF),
     d_serialTriangulationElectrostatics(MPI_COMM_SELF),
     d_FEOrder(FEOrder),
     this_mpi_process (Utilities::MPI::this_mpi_process(mpi_comm_replica)),
@@ -86,6 +86,7 @@ namespace dftfe {
     d_atomPositions = atomLocations;
     d_imageAtomPositions = imageAtomLocations;
     d_domainBoundingVectors = domainBoundingVectors;
+    d_cellWeights.clear();
 
     //clear existing triangulation data
     d_serialTriangulationUnmoved.clear();
@@ -118,12 +119,27 @@ namespace dftfe {
 		 d_triangulationElectrostaticsForce,
 		 false,
 		 false);
+
+    //
+    //report the memory saved by not generating the serial triangulations, which is estimated
+    //from the memory per cell of the locally stored part of the parallel triangulation
+    //
+    if (dftParameters::fullyDistributedMesh && !generateSerialTria && dftParameters::verbosity>=1)
+      {
+	const unsigned int numSerialTriasSkipped=generateElectrostaticsTria?2:1;
+	const double memoryPerCell=d_parallelTriangulationUnmoved.n_active_cells()>0?
+	                           double(d_parallelTriangulationUnmoved.memory_consumption())/d_parallelTriangulationUnmoved.n_active_cells():0.0;
+	const double memorySavedMB=Utilities::MPI::max(numSerialTriasSkipped*memoryPerCell*d_parallelTriangulationUnmoved.n_global_active_cells()/(1024.0*1024.0),
+	                                               mpi_communicator);
+
+	pcout<<"Fully distributed mesh: serial triangulations are not generated, estimated memory saved per MPI task: "<<memorySavedMB<<" MB"<<std::endl;
+      }
   }
 
   //
   //generate Mesh
   //
-  void triangulationManager::generateSerialAndParallelUnmovedPreviousMesh
+  void triangulationManager::generateParallelUnmovedPreviousMesh
   (const std::vector<std::vector<double> > & atomLocations,
    const std::vector<std::vector<double> > & imageAtomLocations,
    const std::vector<std::vector<double> > & domainBoundingVectors)
@@ -137,29 +153,14 @@ namespace dftfe {
     d_domainBoundingVectors = domainBoundingVectors;
 
     d_parallelTriangulationUnmovedPrevious.clear();
-    d_serialTriangulationUnmovedPrevious.clear();
-
 
     generateCoarseMesh(d_parallelTriangulationUnmovedPrevious);
-    generateCoarseMesh(d_serialTriangulationUnmovedPrevious);
 
     for (unsigned int i=0; i<d_parallelTriaCurrentRefinement.size(); ++i)
     {
         d_parallelTriangulationUnmovedPrevious.load_refine_flags(d_parallelTriaCurrentRefinement[i]);
         d_parallelTriangulationUnmovedPrevious.execute_coarsening_and_refinement();
-
-        d_serialTriangulationUnmovedPrevious.load_refine_flags(d_serialTriaCurrentRefinement[i]);
-        d_serialTriangulationUnmovedPrevious.execute_coarsening_and_refinement();
     }
-
-    /*
-    generateMesh(d_parallelTriangulationUnmovedPrevious,
-	         d_serialTriangulationUnmovedPrevious,
-		 d_triangulationElectrostaticsRho,
-		 d_triangulationElectrostaticsDisp,
-		 d_triangulationElectrostaticsForce,
-		 false);
-		 */
   }
 
 
@@ -237,6 +238,54 @@ namespace dftfe {
 	  }
       }
 
+    //
+    //replaying the refinement flags recovers the partitioning by cell count, on which
+    //the stored cell weights were computed
+    //
+    if (!d_cellWeights.empty())
+      repartitionParallelMeshesWithStoredCellWeights();
+  }
+
+
+  //
+  //
+  void triangulationManager::generateResetElectrostaticsMeshRho()
+  {
+    d_triangulationElectrostaticsRho.clear();
+
+    generateCoarseMesh(d_triangulationElectrostaticsRho);
+    for (unsigned int i=0; i<d_parallelTriaCurrentRefinement.size(); ++i)
+      {
+	d_triangulationElectrostaticsRho.load_refine_flags(d_parallelTriaCurrentRefinement[i]);
+	d_triangulationElectrostaticsRho.execute_coarsening_and_refinement();
+      }
+  }
+
+
+  //
+  //
+  void triangulationManager::generateSubdividedElectrostaticsMesh()
+  {
+    d_triangulationElectrostaticsSubdivided.clear();
+
+    generateCoarseMesh(d_triangulationElectrostaticsSubdivided);
+    for (unsigned int i=0; i<d_parallelTriaCurrentRefinement.size(); ++i)
+      {
+	d_triangulationElectrostaticsSubdivided.load_refine_flags(d_parallelTriaCurrentRefinement[i]);
+	d_triangulationElectrostaticsSubdivided.execute_coarsening_and_refinement();
+      }
+
+    d_triangulationElectrostaticsSubdivided.set_all_refine_flags();
+    d_triangulationElectrostaticsSubdivided.prepare_coarsening_and_refinement();
+    d_triangulationElectrostaticsSubdivided.execute_coarsening_and_refinement();
+  }
+
+
+  //
+  //
+  void triangulationManager::clearSubdividedElectrostaticsMesh()
+  {
+    d_triangulationElectrostaticsSubdivided.clear();
   }
 
 
@@ -255,13 +304,13 @@ namespace dftfe {
     d_atomPositions = atomLocations;
     d_imageAtomPositions = imageAtomLocations;
     d_domainBoundingVectors = domainBoundingVectors;
+    d_cellWeights.clear();
 
     //clear existing triangulation data
     d_serialTriangulationUnmoved.clear();
     d_parallelTriangulationUnmoved.clear();
     d_parallelTriangulationMoved.clear();
     d_parallelTriangulationUnmovedPrevious.clear();
-    d_serialTriangulationUnmovedPrevious.clear();
 
     //
     //generate coarse meshes
@@ -274,7 +323,6 @@ namespace dftfe {
     if (dftParameters::isIonOpt || dftParameters::isCellOpt)
       {
 	generateCoarseMesh(d_parallelTriangulationUnmovedPrevious);
-	generateCoarseMesh(d_serialTriangulationUnmovedPrevious);
       }
   }
 
@@ -323,15 +371,6 @@ namespace dftfe {
     return d_parallelTriangulationUnmovedPrevious;
   }
 
-  //
-  //get unmoved serial mesh
-  //
-  parallel::distributed::Triangulation<3> &
-  triangulationManager::getSerialMeshUnmovedPrevious()
-  {
-    return d_serialTriangulationUnmovedPrevious;
-  }
-
 
   //
   //get electrostatics mesh
@@ -354,6 +393,63 @@ namespace dftfe {
     return d_triangulationElectrostaticsForce;
   }
 
+  parallel::distributed::Triangulation<3> &
+  triangulationManager::getElectrostaticsMeshSubdivided()
+  {
+    return d_triangulationElectrostaticsSubdivided;
+  }
+
+  //repartition parallel meshes using cell weights
+  void
+  triangulationManager::repartitionParallelMeshes(const std::map<dealii::CellId,unsigned int> & cellWeights)
+  {
+    d_cellWeights=cellWeights;
+    repartitionParallelMeshesWithStoredCellWeights();
+  }
+
+  //repartition parallel meshes using stored cell weights
+  void
+  triangulationManager::repartitionParallelMeshesWithStoredCellWeights()
+  {
+    //
+    //p4est weight of a cell is the default weight of 1000 plus the sum of the values returned by
+    //the functions connected to the cell_weight signal
+    //
+    const std::function<unsigned int(const parallel::distributed::Triangulation<3>::cell_iterator &,
+				      const parallel::distributed::Triangulation<3>::CellStatus)> cellWeightFunction=
+      [this](const parallel::distributed::Triangulation<3>::cell_iterator & cell,
+	     const parallel::distributed::Triangulation<3>::CellStatus status)->unsigned int
+      {
+	const std::map<dealii::CellId,unsigned int>::const_iterator it=d_cellWeights.find(cell->id());
+	return it!=d_cellWeights.end()?it->second:0;
+      };
+
+    //
+    //p4est partitioning is deterministic, so both meshes with the same refinement and cell weights
+    //end up with the same partitioning
+    //
+    boost::signals2::connection connectionUnmoved=d_parallelTriangulationUnmoved.signals.cell_weight.connect(cellWeightFunction);
+    boost::signals2::connection connectionMoved=d_parallelTriangulationMoved.signals.cell_weight.connect(cellWeightFunction);
+
+    d_parallelTriangulationUnmoved.repartition();
+    d_parallelTriangulationMoved.repartition();
+
+    connectionUnmoved.disconnect();
+    connectionMoved.disconnect();
+
+    //
+    //cells migrated to another processor are recreated from the coarse mesh, so the moved mesh
+    //vertices are reset to the unmoved mesh vertices
+    //
+    resetMesh(d_parallelTriangulationUnmoved,
+	      d_parallelTriangulationMoved);
+
+    if (dftParameters::verbosity>=2)
+      pcout<<"Repartitioned the parallel meshes using cell weights, number of locally owned cells: min over MPI tasks: "
+	   <<Utilities::MPI::min(d_parallelTriangulationMoved.n_locally_owned_active_cells(),mpi_communicator)
+	   <<", max over MPI tasks: "<<Utilities::MPI::max(d_parallelTriangulationMoved.n_locally_owned_active_cells(),mpi_communicator)<<std::endl;
+  }
+
   //reset MeshB to MeshA
   void
   triangulationManager::resetMesh(parallel::distributed::Triangulation<3>& parallelTriangulationA,
@@ -0,0 +1,113 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+//
+// parses the JSON records written by the performance telemetry from the sections of a
+// registered TimerOutput and from the communicated bytes counters
+//
+
+#include <performanceTelemetry.h>
+#include <deal.II/base/mpi.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/conditional_ostream.h>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+
+int main (int argc, char *argv[])
+{
+  dealii::Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+
+  const std::string fileName="performanceTelemetry_01.json";
+  dftfe::performanceTelemetry::initialize(MPI_COMM_WORLD,
+					  fileName);
+
+  dealii::ConditionalOStream pcout(std::cout,false);
+  {
+    dealii::TimerOutput timer(pcout,
+			      dealii::TimerOutput::never,
+			      dealii::TimerOutput::wall_times);
+
+    //sections timed before the registration are not reported
+    timer.enter_section("setup");
+    timer.exit_section("setup");
+
+    dftfe::performanceTelemetry::registerTimer("solver",
+					       timer);
+
+    timer.enter_section("filter \"block\"");
+    timer.exit_section("filter \"block\"");
+    dftfe::performanceTelemetry::addCommunicatedBytes("HX",
+						      1024.0);
+    dftfe::performanceTelemetry::writeRecord("scf iteration",
+					     1);
+
+    for (unsigned int i=0; i<2; ++i)
+      {
+	timer.enter_section("filter \"block\"");
+	timer.exit_section("filter \"block\"");
+	dftfe::performanceTelemetry::addCommunicatedBytes("HX",
+							  1024.0);
+      }
+    dftfe::performanceTelemetry::writeRecord("scf iteration",
+					     2);
+
+    //harvested when the timer is deregistered
+    timer.enter_section("residual");
+    timer.exit_section("residual");
+    dftfe::performanceTelemetry::deregisterTimer(timer);
+  }
+
+  dftfe::performanceTelemetry::writeSummary();
+
+  if (dealii::Utilities::MPI::this_mpi_process(MPI_COMM_WORLD)==0)
+    {
+      std::ifstream input(fileName.c_str());
+      std::string line;
+      while (std::getline(input,line))
+	{
+	  std::istringstream lineStream(line);
+	  boost::property_tree::ptree record;
+	  boost::property_tree::read_json(lineStream,record);
+
+	  std::cout<<"record: "<<record.get<std::string>("record");
+	  if (record.get_optional<unsigned int>("index"))
+	    std::cout<<", index: "<<record.get<unsigned int>("index");
+	  std::cout<<", processors: "<<record.get<unsigned int>("processors")
+		   <<", wall time: "<<(record.get<double>("wall_time")>=0.0)
+		   <<", peak memory: "<<(record.get<double>("peak_memory_max_MB")>=record.get<double>("peak_memory_avg_MB"))
+		   <<std::endl;
+
+	  for (const boost::property_tree::ptree::value_type & region : record.get_child("regions"))
+	    {
+	      const boost::property_tree::ptree & regionData=region.second;
+	      const double wallTimeMin=regionData.get<double>("wall_time_min");
+	      const double wallTimeAvg=regionData.get<double>("wall_time_avg");
+	      const double wallTimeMax=regionData.get<double>("wall_time_max");
+	      std::cout<<"  region: "<<regionData.get<std::string>("name")
+		       <<", processors: "<<regionData.get<unsigned int>("processors")
+		       <<", calls: "<<regionData.get<unsigned int>("calls_max")
+		       <<", bytes communicated: "<<regionData.get<double>("bytes_communicated")
+		       <<", wall times: "<<(wallTimeMin>=0.0 && wallTimeMin<=wallTimeAvg && wallTimeAvg<=wallTimeMax)
+		       <<std::endl;
+	    }
+	}
+    }
+
+  return 0;
+}
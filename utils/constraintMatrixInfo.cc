@@ -65,7 +65,8 @@ namespace dftUtils
   //
   //constructor
   //
-  constraintMatrixInfo::constraintMatrixInfo()
+  constraintMatrixInfo::constraintMatrixInfo():
+    d_localIndexMapUnflattenedToFlattened(std::make_shared<const std::vector<unsigned int> >())
   {
 
 
@@ -154,8 +155,8 @@ namespace dftUtils
     const unsigned int localSize  = unFlattenedPartitioner->local_size();
     const unsigned int totalSize = n_ghosts + localSize;
 
-    d_localIndexMapUnflattenedToFlattened.clear();
-    d_localIndexMapUnflattenedToFlattened.resize(totalSize);
+    std::shared_ptr<std::vector<unsigned int> > localIndexMapUnflattenedToFlattened
+      =std::make_shared<std::vector<unsigned int> >(totalSize);
 
     //
     //fill the data array
@@ -163,9 +164,17 @@ namespace dftUtils
     for(unsigned int ilocalDof = 0; ilocalDof < totalSize; ++ilocalDof)
       {
 	const dealii::types::global_dof_index globalIndex = unFlattenedPartitioner->local_to_global(ilocalDof);
-	d_localIndexMapUnflattenedToFlattened[ilocalDof] = flattenedPartitioner->global_to_local(globalIndex*blockSize);
+	(*localIndexMapUnflattenedToFlattened)[ilocalDof] = flattenedPartitioner->global_to_local(globalIndex*blockSize);
       }
 
+    d_localIndexMapUnflattenedToFlattened=localIndexMapUnflattenedToFlattened;
+
+  }
+
+
+  void constraintMatrixInfo::precomputeMaps(const std::shared_ptr<const std::vector<unsigned int> > & localIndexMapUnflattenedToFlattened)
+  {
+    d_localIndexMapUnflattenedToFlattened=localIndexMapUnflattenedToFlattened;
   }
 
 
@@ -196,6 +205,7 @@ namespace dftUtils
   void constraintMatrixInfo::distribute(dealii::parallel::distributed::Vector<T> &fieldVector,
 					const unsigned int blockSize) const
   {
+    const std::vector<unsigned int> & localIndexMapUnflattenedToFlattened=*d_localIndexMapUnflattenedToFlattened;
     fieldVector.update_ghost_values();
 
 
@@ -208,7 +218,7 @@ namespace dftUtils
 	          newValuesBlock.end(),
 		  d_inhomogenities[i]);
 
-	const dealii::types::global_dof_index startingLocalDofIndexRow = d_localIndexMapUnflattenedToFlattened[d_rowIdsLocal[i]];
+	const dealii::types::global_dof_index startingLocalDofIndexRow = localIndexMapUnflattenedToFlattened[d_rowIdsLocal[i]];
 
 	for(unsigned int j = 0; j < d_rowSizes[i]; ++j)
 	  {
@@ -216,7 +226,7 @@ namespace dftUtils
 	    Assert(count<d_columnIdsGlobal.size(),
 	    	   dealii::ExcMessage("Overloaded distribute for flattened array has indices out of bounds"));
 
-	    const dealii::types::global_dof_index startingLocalDofIndexColumn = d_localIndexMapUnflattenedToFlattened[d_columnIdsLocal[count]];
+	    const dealii::types::global_dof_index startingLocalDofIndexColumn = localIndexMapUnflattenedToFlattened[d_columnIdsLocal[count]];
 
 	    T alpha = d_columnValues[count];
 
@@ -247,15 +257,16 @@ namespace dftUtils
   void constraintMatrixInfo::distribute_slave_to_master(dealii::parallel::distributed::Vector<T> & fieldVector,
 							const unsigned int blockSize) const
   {
+    const std::vector<unsigned int> & localIndexMapUnflattenedToFlattened=*d_localIndexMapUnflattenedToFlattened;
     unsigned int count = 0;
     const unsigned int inc = 1;
     for(unsigned int i = 0; i < d_rowIdsLocal.size(); ++i)
       {
-	const dealii::types::global_dof_index startingLocalDofIndexRow = d_localIndexMapUnflattenedToFlattened[d_rowIdsLocal[i]];
+	const dealii::types::global_dof_index startingLocalDofIndexRow = localIndexMapUnflattenedToFlattened[d_rowIdsLocal[i]];
 	for(unsigned int j = 0; j < d_rowSizes[i]; ++j)
 	  {
 
-	    const dealii::types::global_dof_index startingLocalDofIndexColumn=d_localIndexMapUnflattenedToFlattened[d_columnIdsLocal[count]];
+	    const dealii::types::global_dof_index startingLocalDofIndexColumn=localIndexMapUnflattenedToFlattened[d_columnIdsLocal[count]];
 
 	    T alpha = d_columnValues[count];
 	    callaxpy(&blockSize,
@@ -282,9 +293,10 @@ namespace dftUtils
   void constraintMatrixInfo::set_zero(dealii::parallel::distributed::Vector<T> & fieldVector,
 				      const unsigned int blockSize) const
   {
+    const std::vector<unsigned int> & localIndexMapUnflattenedToFlattened=*d_localIndexMapUnflattenedToFlattened;
     for(unsigned int i = 0; i < d_rowIdsLocal.size(); ++i)
       {
-	const dealii::types::global_dof_index startingLocalDofIndexRow = d_localIndexMapUnflattenedToFlattened[d_rowIdsLocal[i]];
+	const dealii::types::global_dof_index startingLocalDofIndexRow = localIndexMapUnflattenedToFlattened[d_rowIdsLocal[i]];
 
 	//set constrained nodes to zero
 	std::fill(fieldVector.begin()+startingLocalDofIndexRow,
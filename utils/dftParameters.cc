@@ -36,6 +36,7 @@ namespace dftfe
       double chebyshevTolerance = 1e-02;
       std::string mixingMethod = "";
       std::string ionOptSolver = "";
+      std::string ionCellOptSolver = "";
 
       bool isPseudopotential=false,periodicX=false,periodicY=false,periodicZ=false, useSymm=false, timeReversal=false,pseudoTestsFlag=false, constraintMagnetization=false, writeDosFile=false, writeLdosFile=false, writePdosFile=false, writeLocalizationLengths=false;
       std::string meshFileName="",coordinatesFile="",domainBoundingVectorsFile="",kPointDataFile="", ionRelaxFlagsFile="",orthogType="", algoType="", pseudoPotentialFile="";
@@ -55,10 +56,29 @@ namespace dftfe
       double toleranceKinetic = 1e-03;
       unsigned int cellConstraintType=12;// all cell components to be relaxed
 
+      bool isBOMD=false, isXLBOMD=false;
+      double timeStepBOMD=0.5;//fs
+      unsigned int numberStepsBOMD=100;
+      double startingTempBOMD=300.0;//K
+      std::string thermostatTypeBOMD="NONE";
+      double thermostatTimeConstantBOMD=100.0;//fs
+      unsigned int dissipationOrderXLBOMD=5;
+      unsigned int numSCFIterationsBOMD=3;
+      unsigned int chebyshevPassesBOMD=1;
+      std::string trajectoryFileBOMD="mdTrajectory.out";
+
+      std::string perturbedGeometriesFile="";
+      unsigned int chebyshevPassesPerturbedGeometry=2;
+      std::string forcesFilePerturbedGeometry="perturbedGeometryForces.out";
+
+      std::string ensembleStructuresFile="";
+      std::string ensembleEnergiesFile="ensembleEnergies.out";
+
       unsigned int verbosity=0; unsigned int chkType=0;
       bool restartFromChk=false;
       bool reproducible_output=false;
       bool electrostaticsHRefinement = false;
+      bool reuseElectrostaticsHRefinement = false;
       bool electrostaticsPRefinement = false;
       bool meshAdaption = false;
       bool pinnedNodeForPBC = true;
@@ -72,6 +92,7 @@ namespace dftfe
       unsigned int subspaceRotDofsBlockSize=2000;
       bool enableSwitchToGS=true;
       unsigned int nbandGrps=1;
+      unsigned int nspinGrps=1;
       bool computeEnergyEverySCF=true;
       unsigned int scalapackParalProcs=0;
       unsigned int scalapackBlockSize=50;
@@ -82,6 +103,8 @@ namespace dftfe
       bool triMatPGSOpt=true;
       bool reuseWfcGeoOpt=false;
       bool reuseDensityGeoOpt=false;
+      unsigned int groundStateExtrapolationOrder=0;
+      bool extrapolateWfcGeoOpt=false;
       double mpiAllReduceMessageBlockSizeMB=2.0;
       bool useHigherQuadNLP=true;
       bool useMixedPrecPGS_SR=false;
@@ -94,11 +117,23 @@ namespace dftfe
       bool useELPA=false;
       bool constraintsParallelCheck=true;
       bool createConstraintsFromSerialDofhandler=true;
+      bool fullyDistributedMesh=false;
+      bool costWeightedPartitioning=false;
       bool bandParalOpt=true;
+      bool dynamicKPointScheduling=false;
+      double kPointLoadImbalanceTol=1.1;
       bool rrGEP=false;
       bool rrGEPFullMassMatrix=false;
       bool autoUserMeshParams=false;
       bool readWfcForPdosPspFile=false;
+      double occupancyCutoff=0.0;
+      std::string performanceTelemetryFile="";
+      unsigned int benchmarkRepetitions=5;
+      std::string benchmarkResultsFile="benchmarkResults.json";
+      std::string benchmarkReferenceFile="";
+      double benchmarkRegressionTolerance=0.1;
+      double memoryBudgetPerNode=0.0;
+      bool memoryDryRun=false;
 
       void declare_parameters(ParameterHandler &prm)
       {
@@ -111,6 +146,10 @@ namespace dftfe
 			  Patterns::Bool(),
 			  "[Advanced] Compute electrostatic energy and forces on a h refined mesh after each ground-state solve. Default: false.");
 
+	prm.declare_entry("REUSE H REFINED ELECTROSTATICS", "false",
+			  Patterns::Bool(),
+			  "[Advanced] Keep the h refined electrostatics mesh and the data structures built on it across ground-state solves on the same mesh. The DoFHandler and the hanging node and periodic constraints are reused until the mesh is regenerated. The MatrixFree data, the vself bins, the nuclear self-potentials and the local pseudopotential are reused only if the atoms have not moved since the previous solve, and are recomputed otherwise. The total electrostatic potential solve is warm started from the previous solution. The electron-density is transferred to the h refined mesh in every solve. Only used if H REFINED ELECTROSTATICS is true. Default: false.");
+
 	prm.declare_entry("P REFINED ELECTROSTATICS", "false",
 			  Patterns::Bool(),
 			  "[Advanced] Compute electrostatic energy on a p refined mesh after each ground-state solve. Default: false.");
@@ -150,6 +189,42 @@ namespace dftfe
 			    Patterns::Bool(),
 			    "[Standard] Computes localization lengths of all wavefunctions which is defined as the deviation around the mean position of a given wavefunction. Outputs a file name 'localizationLengths.out' containing 2 columns with first column indicating the wavefunction index and second column indicating localization length of the corresponding wavefunction.");
 
+	  prm.declare_entry("PERFORMANCE TELEMETRY FILE", "",
+			    Patterns::Anything(),
+			    "[Developer] Name of the file to which the performance telemetry is written as one JSON record per line. A record is written at the end of each self-consistent field iteration, and a summary record at the end of the run. Each record contains the wall time (minimum, maximum and average across processors) and the number of calls of the timer sections of the ground-state solve and the Chebyshev solver (for example compute rho, Chebyshev filtering and Rayleigh-Ritz), the bytes communicated in HX and across band groups, and the peak memory usage. No telemetry is collected if empty. Default: empty.");
+
+	}
+	prm.leave_subsection ();
+
+	prm.enter_subsection ("Kernel benchmark");
+	{
+	  prm.declare_entry("REPETITIONS", "5",
+			    Patterns::Integer(1,1000),
+			    "[Developer] Number of timed repetitions of each kernel (after one untimed warm up call) in the dftfeBenchmark executable. The minimum, average and maximum wall times across the repetitions are reported. Default: 5.");
+
+	  prm.declare_entry("RESULTS FILE", "benchmarkResults.json",
+			    Patterns::Anything(),
+			    "[Developer] Name of the file to which the dftfeBenchmark executable writes one JSON record per kernel, containing the problem size, the wall times and the estimated GFLOP/s and GB/s. Default: benchmarkResults.json.");
+
+	  prm.declare_entry("REFERENCE FILE", "",
+			    Patterns::Anything(),
+			    "[Developer] RESULTS FILE of a previous dftfeBenchmark run on the same input, for example with a previous build. The minimum wall time of each kernel is compared to the reference, and the dftfeBenchmark executable exits with a non-zero status if any kernel is slower than the reference by more than REGRESSION TOLERANCE. No comparison is done if empty. Default: empty.");
+
+	  prm.declare_entry("REGRESSION TOLERANCE", "0.1",
+			    Patterns::Double(0.0),
+			    "[Developer] Allowed relative increase of the minimum wall time of a kernel with respect to the REFERENCE FILE. Default: 0.1.");
+	}
+	prm.leave_subsection ();
+
+	prm.enter_subsection ("Memory");
+	{
+	  prm.declare_entry("MEMORY BUDGET PER NODE", "0.0",
+			    Patterns::Double(0.0),
+			    "[Advanced] Memory available on each compute node in GB. At the end of the problem initialization the peak memory of the ground-state solve (and of the force computation if required) is estimated for each MPI task from the mesh and the input parameters, and summed over the MPI tasks of each compute node. The run is stopped if the estimate exceeds the budget on any compute node. No check is done if set to 0.0. Default: 0.0.");
+
+	  prm.declare_entry("MEMORY DRY RUN", "false",
+			    Patterns::Bool(),
+			    "[Advanced] Only initializes the problem and prints the estimated peak memory per MPI task and per compute node, without performing the ground-state solve. The MEMORY BUDGET PER NODE check only prints a warning in this case. Default: false.");
 	}
 	prm.leave_subsection ();
 
@@ -163,6 +238,10 @@ namespace dftfe
 			       Patterns::Integer(1),
 			       "[Standard] Number of groups of MPI tasks across which the work load of the bands is parallelised. NPKPT times NPBAND must be a divisor of total number of MPI tasks. Further, NPBAND must be less than or equal to NUMBER OF KOHN-SHAM WAVEFUNCTIONS.");
 
+	    prm.declare_entry("NPSPIN", "1",
+			       Patterns::Integer(1,2),
+			       "[Advanced] Number of groups of MPI tasks across which the two spin channels of a spin polarized calculation are parallelised. For NPSPIN=2 the spin up and spin down Kohn-Sham eigen problems are solved concurrently on separate groups of MPI tasks, followed by a combined electron-density reduction. NPKPT times NPSPIN times NPBAND must be a divisor of total number of MPI tasks. NPSPIN=2 requires SPIN POLARIZATION=1. Default value is 1.");
+
 	    prm.declare_entry("MPI ALLREDUCE BLOCK SIZE", "100.0",
 			       Patterns::Double(0),
 			       "[Advanced] Block message size in MB used to break a single MPI_Allreduce call on wavefunction vectors data into multiple MPI_Allreduce calls. This is useful on certain architectures which take advantage of High Bandwidth Memory to improve efficiency of MPI operations. This variable is relevant only if NPBAND>1. Default value is 100.0 MB.");
@@ -170,6 +249,14 @@ namespace dftfe
 	    prm.declare_entry("BAND PARAL OPT", "true",
 			       Patterns::Bool(),
 			      "[Standard] Uses a more optimal route for band parallelization but at the cost of extra wavefunctions memory.");
+
+	    prm.declare_entry("DYNAMIC K POINT SCHEDULING", "false",
+			       Patterns::Bool(),
+			      "[Advanced] Re-assigns the irreducible k-points across the NPKPT groups of MPI tasks during the scf iterations based on the measured Chebyshev filtering cost of each k-point, to reduce the time the k-point groups spend waiting on each other. The wavefunctions are moved along with the k-points. The per k-point group idle times are reported at the end of the scf solve. This is only relevant for NPKPT>1, and is not used if USE GROUP SYMMETRY is true. Default: false.");
+
+	    prm.declare_entry("K POINT LOAD IMBALANCE TOL", "1.1",
+			       Patterns::Double(1.0),
+			      "[Advanced] The k-points are re-assigned across the k-point groups only if the ratio of the maximum to the average measured cost of the k-point groups is larger than this value. This variable is relevant only if DYNAMIC K POINT SCHEDULING is true. Default: 1.1.");
 	}
 	prm.leave_subsection ();
 
@@ -177,7 +264,7 @@ namespace dftfe
 	{
 	    prm.declare_entry("CHK TYPE", "0",
 			       Patterns::Integer(0,2),
-			       "[Standard] Checkpoint type, 0 (do not create any checkpoint), 1 (create checkpoint for geometry optimization restart if either ION OPT or CELL OPT is set to true. Currently, checkpointing and restart framework does not work if both ION OPT and CELL OPT are set to true simultaneously- the code will throw an error if attempted.), 2 (create checkpoint for scf restart. Currently, this option cannot be used if geometry optimization is being performed. The code will throw an error if this option is used in conjunction with geometry optimization.)");
+			       "[Standard] Checkpoint type, 0 (do not create any checkpoint), 1 (create checkpoint for geometry optimization restart if either ION OPT or CELL OPT is set to true, or for molecular dynamics restart if BOMD is set to true. If both ION OPT and CELL OPT are set to true, checkpointing and restart is only supported for ION CELL OPT SOLVER set to LBFGS- the code will throw an error if attempted with NESTED.), 2 (create checkpoint for scf restart. Currently, this option cannot be used if geometry optimization is being performed. The code will throw an error if this option is used in conjunction with geometry optimization.)");
 
 	    prm.declare_entry("RESTART FROM CHK", "false",
 			       Patterns::Bool(),
@@ -207,6 +294,14 @@ namespace dftfe
 			      Patterns::Anything(),
 			      "[Standard] Domain vectors input file name. Domain vectors are the vectors bounding the three edges of the 3D parallelepiped computational domain. File format: v1x v1y v1z (row1), v2x v2y v2z (row2), v3x v3y v3z (row3). Units: a.u. CAUTION: please ensure that the domain vectors form a right-handed coordinate system i.e. dotProduct(crossProduct(v1,v2),v3)>0. Domain vectors are the typical lattice vectors in a fully periodic calculation.");
 
+	    prm.declare_entry("ENSEMBLE STRUCTURES FILE", "",
+			      Patterns::Anything(),
+			      "[Standard] Input file name of an ensemble of structures which are solved one after the other in a single launch using the same input parameters, reusing the parallel setup, the pseudopotential data and the ELPA handles. File format: atomic-coordinates-file-name domain-vectors-file-name (one row per structure, relative file names are with respect to the directory of the ENSEMBLE STRUCTURES FILE), the two files having the same format as ATOMIC COORDINATES FILE and DOMAIN VECTORS FILE, which are not used in this case. NATOMS is set from each atomic-coordinates file. The structures are reordered such that each structure follows the most similar remaining structure with the same atoms (in the same order) and domain vectors, and for pseudopotential calculations the ground-state electron-density (and the wavefunctions if the maximum atomic displacement is less than 0.1 a.u.) of that structure is used as the starting guess. CHK TYPE must be 0.");
+
+	    prm.declare_entry("ENSEMBLE ENERGIES FILE", "ensembleEnergies.out",
+			      Patterns::Anything(),
+			      "[Standard] Output file name of the ground-state free energies of the ENSEMBLE STRUCTURES FILE structures. File format: structure-number atomic-coordinates-file-name domain-vectors-file-name free-energy (in Ha) starting-guess (0: single atom wavefunctions, 1: previous ground-state electron-density, 2: previous ground-state wavefunctions and electron-density), one row per structure in the order the structures are solved.");
+
 	    prm.enter_subsection ("Optimization");
 	    {
 
@@ -250,6 +345,10 @@ namespace dftfe
 				  Patterns::Integer(1,13),
 				  "[Standard] Cell relaxation constraint type, 1 (isotropic shape-fixed volume optimization), 2 (volume-fixed shape optimization), 3 (relax along domain vector component v1x), 4 (relax along domain vector component v2x), 5 (relax along domain vector component v3x), 6 (relax along domain vector components v2x and v3x), 7 (relax along domain vector components v1x and v3x), 8 (relax along domain vector components v1x and v2x), 9 (volume optimization- relax along domain vector components v1x, v2x and v3x), 10 (2D - relax along x and y components), 11(2D- relax only x and y components with inplane area fixed), 12(relax all domain vector components), 13 automatically decides the constraints based on boundary conditions. CAUTION: A majority of these options only make sense in an orthorhombic cell geometry.");
 
+		prm.declare_entry("ION CELL OPT SOLVER", "NESTED",
+				  Patterns::Selection("LBFGS|NESTED"),
+				  "[Standard] Method used when both ION OPT and CELL OPT are set to true. NESTED (default) relaxes the atomic positions fully for every cell update using the nonlinear conjugate gradient solvers. LBFGS relaxes the atomic positions and the cell strain simultaneously using a preconditioned limited memory BFGS solver, requiring a single ground-state solve per update.");
+
 		prm.declare_entry("REUSE WFC", "false",
 				  Patterns::Bool(),
 				  "[Standard] Reuse previous ground-state wavefunctions during geometry optimization. Default setting is false.");
@@ -258,6 +357,78 @@ namespace dftfe
 				   Patterns::Bool(),
 				  "[Standard] Reuse previous ground-state density during geometry optimization. Default setting is false.");
 
+		prm.declare_entry("GROUND STATE EXTRAPOLATION ORDER", "0",
+				  Patterns::Integer(0,2),
+				  "[Advanced] Order of the extrapolation of the starting electron-density from the previous ground-states after an atomic position update without remeshing, used during ION OPT and BOMD. The difference between the ground-state electron-density and the superposition of single atom electron-densities is extrapolated and added to the superposition of single atom electron-densities at the new atomic positions. 0 (reuse the previous ground-state electron-density), 1 (linear extrapolation using two previous ground-states), 2 (quadratic extrapolation using three previous ground-states). Not used with ANDERSON_WITH_KERKER mixing. Default setting is 0.");
+
+		prm.declare_entry("EXTRAPOLATE WFC", "false",
+				  Patterns::Bool(),
+				  "[Advanced] Linearly extrapolate the starting wavefunctions from the previous two ground-state wavefunctions, after aligning them by a subspace rotation, after an atomic position update without remeshing. When the extrapolated starting guess is used, the additional Chebyshev filtering of the first SCF iteration is skipped. Default setting is false.");
+
+	    }
+	    prm.leave_subsection ();
+
+	    prm.enter_subsection ("Molecular Dynamics");
+	    {
+		prm.declare_entry("BOMD", "false",
+				  Patterns::Bool(),
+				  "[Standard] Boolean parameter specifying if Born-Oppenheimer molecular dynamics is to be performed using the velocity-Verlet integrator. Cannot be used together with ION OPT or CELL OPT.");
+
+		prm.declare_entry("TIME STEP", "0.5",
+				  Patterns::Double(0.0),
+				  "[Standard] Time step (in femtoseconds) of the molecular dynamics.");
+
+		prm.declare_entry("NUMBER OF STEPS", "100",
+				  Patterns::Integer(0),
+				  "[Standard] Number of molecular dynamics steps. On restart from a checkpoint (CHK TYPE=1), the total number of steps including the steps of the previous runs.");
+
+		prm.declare_entry("STARTING TEMPERATURE", "300.0",
+				  Patterns::Double(0.0),
+				  "[Standard] Temperature (in Kelvin) used to draw the initial atomic velocities from the Maxwell-Boltzmann distribution. Also the target temperature of the thermostat. On restart from a checkpoint (CHK TYPE=1) the velocities are read from the checkpoint instead.");
+
+		prm.declare_entry("THERMOSTAT TYPE", "NONE",
+				  Patterns::Selection("NONE|BERENDSEN"),
+				  "[Standard] Thermostat used in the molecular dynamics. NONE (default) gives the NVE ensemble. BERENDSEN rescales the velocities every step towards the STARTING TEMPERATURE (NVT ensemble).");
+
+		prm.declare_entry("THERMOSTAT TIME CONSTANT", "100.0",
+				  Patterns::Double(0.0),
+				  "[Standard] Relaxation time (in femtoseconds) of the BERENDSEN thermostat.");
+
+		prm.declare_entry("XL BOMD", "false",
+				  Patterns::Bool(),
+				  "[Standard] Boolean parameter specifying if the extended Lagrangian Born-Oppenheimer molecular dynamics scheme is used, where an auxiliary electron-density is propagated by a time-reversible integrator with dissipation and used as the starting density of the SCF iterations in every step. Not implemented for ANDERSON_WITH_KERKER mixing.");
+
+		prm.declare_entry("XL BOMD DISSIPATION ORDER", "5",
+				  Patterns::Integer(3,7),
+				  "[Advanced] Order of the dissipation term (number of past auxiliary densities minus one) in the XL BOMD integrator. Higher orders have lower dissipation.");
+
+		prm.declare_entry("SCF ITERATIONS PER STEP", "3",
+				  Patterns::Integer(1),
+				  "[Standard] Maximum number of SCF iterations in each molecular dynamics step. The SCF iterations in a step can stop earlier if the TOLERANCE in SCF parameters is reached. The ground-state solve of the starting configuration uses the MAXIMUM ITERATIONS in SCF parameters.");
+
+		prm.declare_entry("CHEBYSHEV PASSES PER SCF ITERATION", "1",
+				  Patterns::Integer(1,100),
+				  "[Advanced] Maximum number of Chebyshev filter passes in each SCF iteration of a molecular dynamics step. This fixes the eigensolver cost per step instead of the adaptive passes based on CHEBYSHEV FILTER TOLERANCE.");
+
+		prm.declare_entry("TRAJECTORY FILE", "mdTrajectory.out",
+				  Patterns::Anything(),
+				  "[Standard] File to which the atomic positions, velocities and forces (atomic units) are appended every molecular dynamics step.");
+	    }
+	    prm.leave_subsection ();
+
+	    prm.enter_subsection ("Perturbed Geometries");
+	    {
+		prm.declare_entry("PERTURBED GEOMETRIES FILE", "",
+				  Patterns::Anything(),
+				  "[Standard] Atomic displacements input file name of a batch of perturbed geometries, for example for finite-difference phonons. After the ground-state solve, the forces of each perturbed geometry are computed non self-consistently by moving the mesh with Gaussian functions, reusing the ground-state wavefunctions and electron-density, and performing CHEBYSHEV PASSES Chebyshev filter passes without density mixing. A full ground-state solve is performed instead if the mesh movement requires remeshing. File format: the displacements (in a.u.) from the ground-state geometry delx dely delz of all NATOMS atoms (one row per atom) for the first perturbed geometry, followed by the same for the second perturbed geometry and so on. Cannot be used together with ION OPT, CELL OPT or BOMD.");
+
+		prm.declare_entry("CHEBYSHEV PASSES", "2",
+				  Patterns::Integer(1,20),
+				  "[Standard] Number of Chebyshev filter and Rayleigh-Ritz passes in the non self-consistent solve of each perturbed geometry.");
+
+		prm.declare_entry("FORCES FILE", "perturbedGeometryForces.out",
+				  Patterns::Anything(),
+				  "[Standard] File to which the atomic positions and forces (atomic units) of each perturbed geometry are appended.");
 	    }
 	    prm.leave_subsection ();
 
@@ -309,6 +480,14 @@ namespace dftfe
 			   Patterns::Anything(),
 			   "[Developer] External mesh file path. If nothing is given auto mesh generation is performed. The option is only for testing purposes.");
 
+	  prm.declare_entry("FULLY DISTRIBUTED MESH", "false",
+			   Patterns::Bool(),
+			   "[Advanced] Only use the p4est distributed triangulations and never generate the serial triangulations, which are replicated on every MPI task and hence scale with the global number of cells. Periodic and hanging node constraints are then always created from the distributed dofHandler. Default setting is false.");
+
+	  prm.declare_entry("COST WEIGHTED PARTITIONING", "false",
+			   Patterns::Bool(),
+			   "[Advanced] Repartition the p4est distributed triangulations before the ground-state solve using cell weights estimated from the cost of the Hamiltonian times wavefunctions product, which is larger in cells lying in the compact support of the nonlocal pseudopotential projectors. This improves the load balance of the eigen solve for inhomogeneous systems like slabs with vacuum. Only used for pseudopotential calculations, and cannot be used with H REFINED ELECTROSTATICS. Default setting is false.");
+
 	  prm.enter_subsection ("Auto mesh generation parameters");
 	  {
 
@@ -485,6 +664,10 @@ namespace dftfe
 			      Patterns::Bool(),
 			      "[Advanced] Boolean parameter specifying whether to use a higher order quadrature rule for the calculations involving the non-local part of the pseudopotential. Default setting is true. Could be safely set to false if you are using a very refined mesh.");
 
+	    prm.declare_entry("OCCUPANCY CUTOFF", "0.0",
+			      Patterns::Double(0.0,1.0),
+			      "[Advanced] Fermi-Dirac partial occupancy below which a Kohn-Sham state is treated as unoccupied in the electron-density, force and stress computations. As the eigenvalues are sorted, the unoccupied tail of the states is skipped entirely in these computations. This is useful for metallic systems where a significant number of buffer states with negligible occupancy are only required for the convergence of the eigen-solver. The total number of skipped state evaluations is reported at each SCF iteration for VERBOSITY>=2. The states are not truncated if spectrum splitting is active in the electron-density computation. Default value is 0.0, which does not skip any state.");
+
 	    prm.enter_subsection ("Eigen-solver parameters");
 	    {
 
@@ -632,6 +815,7 @@ namespace dftfe
 	dftParameters::verbosity                     = prm.get_integer("VERBOSITY");
 	dftParameters::reproducible_output           = prm.get_bool("REPRODUCIBLE OUTPUT");
 	dftParameters::electrostaticsHRefinement = prm.get_bool("H REFINED ELECTROSTATICS");
+	dftParameters::reuseElectrostaticsHRefinement = prm.get_bool("REUSE H REFINED ELECTROSTATICS");
 	dftParameters::electrostaticsPRefinement = prm.get_bool("P REFINED ELECTROSTATICS");
 
 	prm.enter_subsection ("Postprocessing");
@@ -643,6 +827,23 @@ namespace dftfe
           dftParameters::writePdosFile                    = prm.get_bool("WRITE PROJECTED DENSITY OF STATES"); 
           dftParameters::readWfcForPdosPspFile            = prm.get_bool("READ ATOMIC WFC PDOS FROM PSP FILE");
 	  dftParameters::writeLocalizationLengths          = prm.get_bool("WRITE LOCALIZATION LENGTHS");
+	  dftParameters::performanceTelemetryFile         = prm.get("PERFORMANCE TELEMETRY FILE");
+	}
+	prm.leave_subsection ();
+
+	prm.enter_subsection ("Kernel benchmark");
+	{
+	  dftParameters::benchmarkRepetitions             = prm.get_integer("REPETITIONS");
+	  dftParameters::benchmarkResultsFile             = prm.get("RESULTS FILE");
+	  dftParameters::benchmarkReferenceFile           = prm.get("REFERENCE FILE");
+	  dftParameters::benchmarkRegressionTolerance     = prm.get_double("REGRESSION TOLERANCE");
+	}
+	prm.leave_subsection ();
+
+	prm.enter_subsection ("Memory");
+	{
+	  dftParameters::memoryBudgetPerNode              = prm.get_double("MEMORY BUDGET PER NODE");
+	  dftParameters::memoryDryRun                     = prm.get_bool("MEMORY DRY RUN");
 	}
 	prm.leave_subsection ();
 
@@ -650,8 +851,11 @@ namespace dftfe
 	{
 	    dftParameters::npool             = prm.get_integer("NPKPT");
 	    dftParameters::nbandGrps         = prm.get_integer("NPBAND");
+	    dftParameters::nspinGrps         = prm.get_integer("NPSPIN");
 	    dftParameters::bandParalOpt = prm.get_bool("BAND PARAL OPT");
 	    dftParameters::mpiAllReduceMessageBlockSizeMB = prm.get_double("MPI ALLREDUCE BLOCK SIZE");
+	    dftParameters::dynamicKPointScheduling = prm.get_bool("DYNAMIC K POINT SCHEDULING");
+	    dftParameters::kPointLoadImbalanceTol = prm.get_double("K POINT LOAD IMBALANCE TOL");
 	}
 	prm.leave_subsection ();
 
@@ -669,6 +873,8 @@ namespace dftfe
 	    dftParameters::coordinatesFile               = prm.get("ATOMIC COORDINATES FILE");
 	    dftParameters::coordinatesGaussianDispFile   = prm.get("ATOMIC DISP COORDINATES FILE");
 	    dftParameters::domainBoundingVectorsFile     = prm.get("DOMAIN VECTORS FILE");
+	    dftParameters::ensembleStructuresFile        = prm.get("ENSEMBLE STRUCTURES FILE");
+	    dftParameters::ensembleEnergiesFile          = prm.get("ENSEMBLE ENERGIES FILE");
 	    prm.enter_subsection ("Optimization");
 	    {
 		dftParameters::isIonOpt                      = prm.get_bool("ION OPT");
@@ -681,8 +887,35 @@ namespace dftfe
 		dftParameters::isCellStress                  = dftParameters::isCellOpt || prm.get_bool("CELL STRESS");
 		dftParameters::stressRelaxTol                = prm.get_double("STRESS TOL");
 		dftParameters::cellConstraintType            = prm.get_integer("CELL CONSTRAINT TYPE");
+		dftParameters::ionCellOptSolver              = prm.get("ION CELL OPT SOLVER");
 		dftParameters::reuseWfcGeoOpt                = prm.get_bool("REUSE WFC");
 		dftParameters::reuseDensityGeoOpt            = prm.get_bool("REUSE DENSITY");
+		dftParameters::groundStateExtrapolationOrder = prm.get_integer("GROUND STATE EXTRAPOLATION ORDER");
+		dftParameters::extrapolateWfcGeoOpt          = prm.get_bool("EXTRAPOLATE WFC");
+	    }
+	    prm.leave_subsection ();
+	    prm.enter_subsection ("Molecular Dynamics");
+	    {
+		dftParameters::isBOMD                        = prm.get_bool("BOMD");
+		dftParameters::timeStepBOMD                  = prm.get_double("TIME STEP");
+		dftParameters::numberStepsBOMD               = prm.get_integer("NUMBER OF STEPS");
+		dftParameters::startingTempBOMD              = prm.get_double("STARTING TEMPERATURE");
+		dftParameters::thermostatTypeBOMD            = prm.get("THERMOSTAT TYPE");
+		dftParameters::thermostatTimeConstantBOMD    = prm.get_double("THERMOSTAT TIME CONSTANT");
+		dftParameters::isXLBOMD                      = prm.get_bool("XL BOMD");
+		dftParameters::dissipationOrderXLBOMD        = prm.get_integer("XL BOMD DISSIPATION ORDER");
+		dftParameters::numSCFIterationsBOMD          = prm.get_integer("SCF ITERATIONS PER STEP");
+		dftParameters::chebyshevPassesBOMD           = prm.get_integer("CHEBYSHEV PASSES PER SCF ITERATION");
+		dftParameters::trajectoryFileBOMD            = prm.get("TRAJECTORY FILE");
+		dftParameters::isIonForce                    = dftParameters::isIonForce || dftParameters::isBOMD;
+	    }
+	    prm.leave_subsection ();
+	    prm.enter_subsection ("Perturbed Geometries");
+	    {
+		dftParameters::perturbedGeometriesFile          = prm.get("PERTURBED GEOMETRIES FILE");
+		dftParameters::chebyshevPassesPerturbedGeometry = prm.get_integer("CHEBYSHEV PASSES");
+		dftParameters::forcesFilePerturbedGeometry      = prm.get("FORCES FILE");
+		dftParameters::isIonForce                       = dftParameters::isIonForce || !dftParameters::perturbedGeometriesFile.empty();
 	    }
 	    prm.leave_subsection ();
 	}
@@ -704,6 +937,8 @@ namespace dftfe
 	{
 	    dftParameters::finiteElementPolynomialOrder  = prm.get_integer("POLYNOMIAL ORDER");
 	    dftParameters::meshFileName                  = prm.get("MESH FILE");
+	    dftParameters::fullyDistributedMesh          = prm.get_bool("FULLY DISTRIBUTED MESH");
+	    dftParameters::costWeightedPartitioning      = prm.get_bool("COST WEIGHTED PARTITIONING");
 	    prm.enter_subsection ("Auto mesh generation parameters");
 	    {
 		dftParameters::outerAtomBallRadius           = prm.get_double("ATOM BALL RADIUS");
@@ -766,6 +1001,7 @@ namespace dftfe
 	    dftParameters::startingWFCType               = prm.get("STARTING WFC");
 	    dftParameters::computeEnergyEverySCF         = prm.get_bool("COMPUTE ENERGY EACH ITER");
 	    dftParameters::useHigherQuadNLP              = prm.get_bool("HIGHER QUAD NLP");
+	    dftParameters::occupancyCutoff               = prm.get_double("OCCUPANCY CUTOFF");
 
 
 	    prm.enter_subsection ("Eigen-solver parameters");
@@ -852,6 +1088,10 @@ namespace dftfe
 
 	if (dftParameters::isCellStress)
 	   dftParameters::electrostaticsHRefinement=false;
+
+	//a-posteriori adapted meshes cannot be regenerated from the saved refinement flags
+	if (dftParameters::meshAdaption)
+	   dftParameters::reuseElectrostaticsHRefinement=false;
       //
 	check_print_parameters(prm);
 	setHeuristicParameters();
@@ -904,6 +1144,7 @@ namespace dftfe
 	   AssertThrow(!dftParameters::useSymm,ExcMessage("DFT-FE Error: USE GROUP SYMMETRY must be set to false if either ION FORCE or CELL STRESS is set to true. This functionality will be added in a future release"));
 
 
+
 	if (dftParameters::numCoreWfcRR>0)
 	   AssertThrow(false,ExcMessage("DFT-FE Error: SPECTRUM SPLIT CORE EIGENSTATES cannot be set to a non-zero value when using complex executable. This optimization will be added in a future release"));
 #else
@@ -915,18 +1156,38 @@ namespace dftfe
 #endif
 	AssertThrow(!(dftParameters::chkType==2 && (dftParameters::isIonOpt || dftParameters::isCellOpt)),ExcMessage("DFT-FE Error: CHK TYPE=2 cannot be used if geometry optimization is being performed."));
 
-	AssertThrow(!(dftParameters::chkType==1 && (dftParameters::isIonOpt && dftParameters::isCellOpt)),ExcMessage("DFT-FE Error: CHK TYPE=1 cannot be used if both ION OPT and CELL OPT are set to true."));
+	AssertThrow(!(dftParameters::costWeightedPartitioning && dftParameters::electrostaticsHRefinement),ExcMessage("DFT-FE Error: COST WEIGHTED PARTITIONING cannot be used with H REFINED ELECTROSTATICS."));
+
+	AssertThrow(!(dftParameters::chkType==2 && dftParameters::isBOMD),ExcMessage("DFT-FE Error: CHK TYPE=2 cannot be used if BOMD is being performed."));
+
+	AssertThrow(!(dftParameters::isBOMD && (dftParameters::isIonOpt || dftParameters::isCellOpt)),ExcMessage("DFT-FE Error: BOMD cannot be used together with ION OPT or CELL OPT."));
+
+	AssertThrow(!(dftParameters::isBOMD && dftParameters::isXLBOMD && dftParameters::mixingMethod=="ANDERSON_WITH_KERKER"),ExcMessage("DFT-FE Error: XL BOMD is not implemented for ANDERSON_WITH_KERKER mixing."));
+
+	AssertThrow(dftParameters::perturbedGeometriesFile.empty() || !(dftParameters::isBOMD || dftParameters::isIonOpt || dftParameters::isCellOpt),ExcMessage("DFT-FE Error: PERTURBED GEOMETRIES FILE cannot be used together with ION OPT, CELL OPT or BOMD."));
+
+	AssertThrow(dftParameters::ensembleStructuresFile.empty() || dftParameters::chkType==0,ExcMessage("DFT-FE Error: checkpointing and restart is not implemented for ENSEMBLE STRUCTURES FILE. Set CHK TYPE to 0."));
+
+	AssertThrow(dftParameters::perturbedGeometriesFile.empty() || !(dftParameters::groundStateExtrapolationOrder>0 || dftParameters::extrapolateWfcGeoOpt),ExcMessage("DFT-FE Error: PERTURBED GEOMETRIES FILE cannot be used together with GROUND STATE EXTRAPOLATION ORDER>0 or EXTRAPOLATE WFC."));
+
+	AssertThrow(!(dftParameters::chkType==1 && (dftParameters::isIonOpt && dftParameters::isCellOpt) && dftParameters::ionCellOptSolver=="NESTED"),ExcMessage("DFT-FE Error: CHK TYPE=1 cannot be used if both ION OPT and CELL OPT are set to true and ION CELL OPT SOLVER is NESTED."));
 
 	AssertThrow(dftParameters::nbandGrps<=dftParameters::numberEigenValues
 		,ExcMessage("DFT-FE Error: NPBAND is greater than NUMBER OF KOHN-SHAM WAVEFUNCTIONS."));
 
+	AssertThrow(dftParameters::nspinGrps==1 || dftParameters::spinPolarized==1
+		,ExcMessage("DFT-FE Error: NPSPIN=2 requires SPIN POLARIZATION=1."));
+
+	AssertThrow(!(dftParameters::nspinGrps==2 && dftParameters::useSymm)
+		,ExcMessage("DFT-FE Error: NPSPIN=2 cannot be used with USE GROUP SYMMETRY set to true."));
+
 	if (dftParameters::nonSelfConsistentForce)
 	   AssertThrow(false,ExcMessage("DFT-FE Error: Implementation of this feature is not completed yet."));
 
-	AssertThrow(!dftParameters::coordinatesFile.empty()
+	AssertThrow(!dftParameters::coordinatesFile.empty() || !dftParameters::ensembleStructuresFile.empty()
 		    ,ExcMessage("DFT-FE Error: ATOMIC COORDINATES FILE not given."));
 
-	AssertThrow(!dftParameters::domainBoundingVectorsFile.empty()
+	AssertThrow(!dftParameters::domainBoundingVectorsFile.empty() || !dftParameters::ensembleStructuresFile.empty()
 		    ,ExcMessage("DFT-FE Error: DOMAIN VECTORS FILE not given."));
 
 	if (dftParameters::isPseudopotential)
@@ -944,7 +1205,7 @@ namespace dftfe
 	AssertThrow(dftParameters::numberEigenValues!=0
 		    ,ExcMessage("DFT-FE Error: Number of wavefunctions not specified or given value of zero, which is not allowed."));
 
-	AssertThrow(dftParameters::natoms!=0
+	AssertThrow(dftParameters::natoms!=0 || !dftParameters::ensembleStructuresFile.empty()
 		    ,ExcMessage("DFT-FE Error: Number of atoms not specified or given a value of zero, which is not allowed."));
 
 	AssertThrow(dftParameters::natomTypes!=0
@@ -1007,6 +1268,9 @@ namespace dftfe
 	else if (dftParameters::reproducible_output)
             dftParameters::createConstraintsFromSerialDofhandler=true;		
 
+	if (dftParameters::fullyDistributedMesh)
+	    dftParameters::createConstraintsFromSerialDofhandler=false;
+
       }
 
     }
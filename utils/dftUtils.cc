@@ -188,7 +188,7 @@ namespace dftUtils
   {
     const unsigned int n_mpi_processes = dealii::Utilities::MPI::n_mpi_processes(mpi_communicator);
     AssertThrow(n_mpi_processes % npool == 0,
-                dealii::ExcMessage("DFT-FE Error: Total number of mpi processes must be a multiple of npool. Please check that total number of mpi processes is a multiple of NPKPT*NPBAND."));
+                dealii::ExcMessage("DFT-FE Error: Total number of mpi processes must be a multiple of npool. Please check that total number of mpi processes is a multiple of NPKPT*NPSPIN*NPBAND."));
     const unsigned int poolSize= n_mpi_processes/npool;
     const unsigned int taskId = dealii::Utilities::MPI::this_mpi_process(mpi_communicator);
 
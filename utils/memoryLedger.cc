@@ -0,0 +1,189 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+
+/** @file memoryLedger.cc
+ *  @brief Global ledger of the major allocations grouped into categories
+ *
+ */
+
+#include <memoryLedger.h>
+#include <headers.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+namespace dftfe {
+
+namespace memoryLedger
+{
+  namespace internal
+  {
+    MPI_Comm ledgerComm=MPI_COMM_WORLD;
+
+    //named long lived allocations, temporary allocations and peak bytes of each category
+    std::vector<std::map<std::string,double> > namedBytes(numberCategories);
+    std::vector<double> temporaryBytes(numberCategories,0.0);
+    std::vector<double> peakBytes(numberCategories,0.0);
+
+    const char * categoryNames[numberCategories]={"wavefunctions",
+						  "rotated fractional wavefunctions",
+						  "cell Hamiltonians",
+						  "projector matrices",
+						  "quadrature fields",
+						  "mixing history",
+						  "ScaLAPACK buffers",
+						  "force tables"};
+
+    void updatePeak(const category allocationCategory)
+    {
+      peakBytes[allocationCategory]=std::max(peakBytes[allocationCategory],
+					     getCurrentBytes(allocationCategory));
+    }
+  }
+
+  void initialize(const MPI_Comm & mpiComm)
+  {
+    internal::ledgerComm=mpiComm;
+    for (unsigned int i=0; i<numberCategories; ++i)
+    {
+      internal::namedBytes[i].clear();
+      internal::temporaryBytes[i]=0.0;
+      internal::peakBytes[i]=0.0;
+    }
+  }
+
+  void setBytes(const category allocationCategory,
+		const std::string & name,
+		const double bytes)
+  {
+    if (bytes>0.0)
+      internal::namedBytes[allocationCategory][name]=bytes;
+    else
+      internal::namedBytes[allocationCategory].erase(name);
+
+    internal::updatePeak(allocationCategory);
+  }
+
+  void addBytes(const category allocationCategory,
+		const double bytes)
+  {
+    internal::temporaryBytes[allocationCategory]=std::max(internal::temporaryBytes[allocationCategory]+bytes,0.0);
+    internal::updatePeak(allocationCategory);
+  }
+
+  double getCurrentBytes(const category allocationCategory)
+  {
+    double bytes=internal::temporaryBytes[allocationCategory];
+    std::map<std::string,double>::const_iterator it;
+    for (it=internal::namedBytes[allocationCategory].begin(); it!=internal::namedBytes[allocationCategory].end(); ++it)
+      bytes+=it->second;
+    return bytes;
+  }
+
+  double getPeakBytes(const category allocationCategory)
+  {
+    return internal::peakBytes[allocationCategory];
+  }
+
+  std::string getCategoryName(const category allocationCategory)
+  {
+    return internal::categoryNames[allocationCategory];
+  }
+
+  double getResidentMemory()
+  {
+    long totalPages=0, residentPages=0;
+    std::ifstream statm("/proc/self/statm");
+    if (statm>>totalPages>>residentPages)
+      return (double)residentPages*sysconf(_SC_PAGESIZE);
+
+    return getPeakResidentMemory();
+  }
+
+  double getPeakResidentMemory()
+  {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF,&usage);
+    return usage.ru_maxrss*1.0e+3;
+  }
+
+  void printSummary(const std::string & message)
+  {
+    const unsigned int numberProcs=dealii::Utilities::MPI::n_mpi_processes(internal::ledgerComm);
+
+    std::vector<double> currentBytesMax(numberCategories,0.0);
+    std::vector<double> currentBytesSum(numberCategories,0.0);
+    std::vector<double> peakBytesMax(numberCategories,0.0);
+    double totalCurrentBytes=0.0;
+    for (unsigned int i=0; i<numberCategories; ++i)
+    {
+      currentBytesMax[i]=getCurrentBytes((category)i);
+      currentBytesSum[i]=currentBytesMax[i];
+      peakBytesMax[i]=internal::peakBytes[i];
+      totalCurrentBytes+=currentBytesMax[i];
+    }
+
+    MPI_Allreduce(MPI_IN_PLACE,&currentBytesMax[0],numberCategories,MPI_DOUBLE,MPI_MAX,internal::ledgerComm);
+    MPI_Allreduce(MPI_IN_PLACE,&currentBytesSum[0],numberCategories,MPI_DOUBLE,MPI_SUM,internal::ledgerComm);
+    MPI_Allreduce(MPI_IN_PLACE,&peakBytesMax[0],numberCategories,MPI_DOUBLE,MPI_MAX,internal::ledgerComm);
+
+    const double totalCurrentBytesMax=dealii::Utilities::MPI::max(totalCurrentBytes,internal::ledgerComm);
+    const double residentMemoryMax=dealii::Utilities::MPI::max(getResidentMemory(),internal::ledgerComm);
+    const double peakResidentMemoryMax=dealii::Utilities::MPI::max(getPeakResidentMemory(),internal::ledgerComm);
+
+    if (dealii::Utilities::MPI::this_mpi_process(internal::ledgerComm)==0)
+    {
+      const std::ios_base::fmtflags coutFlags=std::cout.flags();
+      const std::streamsize coutPrecision=std::cout.precision();
+      std::cout<<std::endl<<"Memory ledger ("<<message<<"), MB per processor:"<<std::endl;
+      std::cout<<std::left<<std::setw(36)<<"category"
+	       <<std::right<<std::setw(14)<<"current max"
+	       <<std::setw(14)<<"current avg"
+	       <<std::setw(14)<<"peak max"<<std::endl;
+      for (unsigned int i=0; i<numberCategories; ++i)
+	std::cout<<std::left<<std::setw(36)<<internal::categoryNames[i]
+		 <<std::right<<std::fixed<<std::setprecision(2)
+		 <<std::setw(14)<<currentBytesMax[i]/1.0e+6
+		 <<std::setw(14)<<currentBytesSum[i]/numberProcs/1.0e+6
+		 <<std::setw(14)<<peakBytesMax[i]/1.0e+6<<std::endl;
+      std::cout<<std::left<<std::setw(36)<<"total registered"
+	       <<std::right<<std::setw(14)<<totalCurrentBytesMax/1.0e+6<<std::endl;
+      std::cout<<"Resident memory: current max "<<residentMemoryMax/1.0e+6
+	       <<" MB, peak max "<<peakResidentMemoryMax/1.0e+6<<" MB"<<std::endl<<std::endl;
+      std::cout.flags(coutFlags);
+      std::cout.precision(coutPrecision);
+    }
+  }
+
+  Allocation::Allocation(const category allocationCategory,
+			 const double bytes):
+    d_category(allocationCategory),
+    d_bytes(bytes)
+  {
+    addBytes(d_category,d_bytes);
+  }
+
+  Allocation::~Allocation()
+  {
+    addBytes(d_category,-d_bytes);
+  }
+
+}
+
+}
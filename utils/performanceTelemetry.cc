@@ -0,0 +1,375 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+
+/** @file performanceTelemetry.cc
+ *  @brief Performance data harvested from the registered TimerOutput sections written as JSON records
+ *
+ */
+
+#include <performanceTelemetry.h>
+#include <headers.h>
+#include <sys/resource.h>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace dftfe {
+
+namespace performanceTelemetry
+{
+  namespace internal
+  {
+    struct regionStatistics
+    {
+      double wallTime=0.0;
+      unsigned int numberCalls=0;
+      double bytesCommunicated=0.0;
+      double bytesAllocated=0.0;
+      double bytesSaved=0.0;
+    };
+
+    struct registeredTimer
+    {
+      std::string timerName;
+      const dealii::TimerOutput * timer;
+
+      //section wall times and number of calls at the last harvest
+      std::map<std::string,double> wallTimes;
+      std::map<std::string,double> numberCalls;
+    };
+
+    bool isTelemetryEnabled=false;
+    MPI_Comm telemetryComm=MPI_COMM_NULL;
+    std::string telemetryFileName="";
+    double startTime=0.0;
+    double recordStartTime=0.0;
+
+    //statistics accumulated since the last record and over the whole run
+    std::map<std::string,regionStatistics> recordStatistics;
+    std::map<std::string,regionStatistics> summaryStatistics;
+
+    std::vector<registeredTimer> timers;
+
+    std::string escapeJSON(const std::string & input)
+    {
+      std::string output;
+      for (unsigned int i=0; i<input.size(); ++i)
+      {
+	if (input[i]=='"' || input[i]=='\\')
+	  output.push_back('\\');
+	output.push_back(input[i]);
+      }
+      return output;
+    }
+
+    //
+    //add the time spent in the sections of a registered timer since the last harvest
+    //to the record statistics
+    //
+    void harvestTimer(registeredTimer & timerData)
+    {
+      const std::map<std::string,double> wallTimes
+	=timerData.timer->get_summary_data(dealii::TimerOutput::total_wall_time);
+      const std::map<std::string,double> numberCalls
+	=timerData.timer->get_summary_data(dealii::TimerOutput::n_calls);
+
+      std::map<std::string,double>::const_iterator iter;
+      for (iter=numberCalls.begin(); iter!=numberCalls.end(); ++iter)
+      {
+	const double numberCallsSinceHarvest=iter->second-timerData.numberCalls[iter->first];
+	if (numberCallsSinceHarvest<=0.0)
+	  continue;
+
+	regionStatistics & statistics=recordStatistics[timerData.timerName+"/"+iter->first];
+	statistics.wallTime+=wallTimes.find(iter->first)->second-timerData.wallTimes[iter->first];
+	statistics.numberCalls+=(unsigned int)numberCallsSinceHarvest;
+      }
+
+      timerData.wallTimes=wallTimes;
+      timerData.numberCalls=numberCalls;
+    }
+
+    //
+    //peak resident set size of the current process in MB
+    //
+    double getPeakMemoryUsage()
+    {
+      struct rusage usage;
+      getrusage(RUSAGE_SELF,&usage);
+      return usage.ru_maxrss/1.0e+3;
+    }
+
+    //
+    //reduce the region statistics across all processors and write one JSON record from the root processor
+    //
+    void reduceAndWrite(const std::map<std::string,regionStatistics> & statistics,
+	                const std::string & recordType,
+			const int recordIndex,
+			const double recordWallTime)
+    {
+      const unsigned int numberProcs=dealii::Utilities::MPI::n_mpi_processes(telemetryComm);
+      const unsigned int taskId=dealii::Utilities::MPI::this_mpi_process(telemetryComm);
+
+      //
+      //regions can differ across the processors (for example across k-point pools),
+      //so first gather the union of the region names
+      //
+      std::string localRegionNames;
+      std::map<std::string,regionStatistics>::const_iterator iter;
+      for (iter=statistics.begin(); iter!=statistics.end(); ++iter)
+	localRegionNames+=iter->first+'\n';
+
+      const int localSize=localRegionNames.size();
+      std::vector<int> sizes(numberProcs,0);
+      MPI_Allgather(&localSize,
+		    1,
+		    MPI_INT,
+		    &sizes[0],
+		    1,
+		    MPI_INT,
+		    telemetryComm);
+
+      std::vector<int> offsets(numberProcs,0);
+      for (unsigned int i=1; i<numberProcs; ++i)
+	offsets[i]=offsets[i-1]+sizes[i-1];
+
+      std::vector<char> globalRegionNamesChars(offsets[numberProcs-1]+sizes[numberProcs-1]+1,'\0');
+      MPI_Allgatherv(localRegionNames.data(),
+		     localSize,
+		     MPI_CHAR,
+		     &globalRegionNamesChars[0],
+		     &sizes[0],
+		     &offsets[0],
+		     MPI_CHAR,
+		     telemetryComm);
+
+      std::set<std::string> globalRegionNamesSet;
+      const std::string globalRegionNamesString(&globalRegionNamesChars[0]);
+      std::istringstream namesStream(globalRegionNamesString);
+      std::string regionName;
+      while (std::getline(namesStream,regionName))
+	globalRegionNamesSet.insert(regionName);
+
+      const std::vector<std::string> globalRegionNames(globalRegionNamesSet.begin(),globalRegionNamesSet.end());
+      const unsigned int numberRegions=globalRegionNames.size();
+
+      std::vector<double> wallTimeMin(numberRegions,std::numeric_limits<double>::max());
+      std::vector<double> wallTimeMax(numberRegions,0.0);
+      std::vector<double> wallTimeSum(numberRegions,0.0);
+      std::vector<double> numberCallsMax(numberRegions,0.0);
+      std::vector<double> bytesSum(numberRegions,0.0);
+      std::vector<double> bytesAllocatedSum(numberRegions,0.0);
+      std::vector<double> bytesSavedSum(numberRegions,0.0);
+      std::vector<double> numberActiveProcs(numberRegions,0.0);
+      for (unsigned int i=0; i<numberRegions; ++i)
+      {
+	iter=statistics.find(globalRegionNames[i]);
+	if (iter==statistics.end())
+	  continue;
+
+	wallTimeMin[i]=iter->second.wallTime;
+	wallTimeMax[i]=iter->second.wallTime;
+	wallTimeSum[i]=iter->second.wallTime;
+	numberCallsMax[i]=iter->second.numberCalls;
+	bytesSum[i]=iter->second.bytesCommunicated;
+	bytesAllocatedSum[i]=iter->second.bytesAllocated;
+	bytesSavedSum[i]=iter->second.bytesSaved;
+	numberActiveProcs[i]=1.0;
+      }
+
+      if (numberRegions>0)
+      {
+	MPI_Allreduce(MPI_IN_PLACE,&wallTimeMin[0],numberRegions,MPI_DOUBLE,MPI_MIN,telemetryComm);
+	MPI_Allreduce(MPI_IN_PLACE,&wallTimeMax[0],numberRegions,MPI_DOUBLE,MPI_MAX,telemetryComm);
+	MPI_Allreduce(MPI_IN_PLACE,&wallTimeSum[0],numberRegions,MPI_DOUBLE,MPI_SUM,telemetryComm);
+	MPI_Allreduce(MPI_IN_PLACE,&numberCallsMax[0],numberRegions,MPI_DOUBLE,MPI_MAX,telemetryComm);
+	MPI_Allreduce(MPI_IN_PLACE,&bytesSum[0],numberRegions,MPI_DOUBLE,MPI_SUM,telemetryComm);
+	MPI_Allreduce(MPI_IN_PLACE,&bytesAllocatedSum[0],numberRegions,MPI_DOUBLE,MPI_SUM,telemetryComm);
+	MPI_Allreduce(MPI_IN_PLACE,&bytesSavedSum[0],numberRegions,MPI_DOUBLE,MPI_SUM,telemetryComm);
+	MPI_Allreduce(MPI_IN_PLACE,&numberActiveProcs[0],numberRegions,MPI_DOUBLE,MPI_SUM,telemetryComm);
+      }
+
+      const double peakMemory=getPeakMemoryUsage();
+      const double peakMemoryMax=dealii::Utilities::MPI::max(peakMemory,telemetryComm);
+      const double peakMemoryAvg=dealii::Utilities::MPI::sum(peakMemory,telemetryComm)/numberProcs;
+      const double elapsedWallTime=MPI_Wtime()-startTime;
+      const double recordWallTimeMax=dealii::Utilities::MPI::max(recordWallTime,telemetryComm);
+
+      if (taskId==0)
+      {
+	std::ofstream output(telemetryFileName.c_str(),std::ios::app);
+	output<<std::setprecision(10);
+	output<<"{\"record\":\""<<escapeJSON(recordType)<<"\"";
+	if (recordIndex>=0)
+	  output<<",\"index\":"<<recordIndex;
+	output<<",\"wall_time\":"<<recordWallTimeMax
+	      <<",\"elapsed_wall_time\":"<<elapsedWallTime
+	      <<",\"processors\":"<<numberProcs
+	      <<",\"peak_memory_max_MB\":"<<peakMemoryMax
+	      <<",\"peak_memory_avg_MB\":"<<peakMemoryAvg
+	      <<",\"regions\":[";
+	for (unsigned int i=0; i<numberRegions; ++i)
+	{
+	  if (i>0)
+	    output<<",";
+	  output<<"{\"name\":\""<<escapeJSON(globalRegionNames[i])<<"\""
+		<<",\"processors\":"<<(unsigned int)numberActiveProcs[i]
+		<<",\"calls_max\":"<<(unsigned int)numberCallsMax[i]
+		<<",\"wall_time_min\":"<<wallTimeMin[i]
+		<<",\"wall_time_max\":"<<wallTimeMax[i]
+		<<",\"wall_time_avg\":"<<wallTimeSum[i]/numberActiveProcs[i]
+		<<",\"bytes_communicated\":"<<bytesSum[i]
+		<<",\"bytes_allocated\":"<<bytesAllocatedSum[i]
+		<<",\"bytes_saved\":"<<bytesSavedSum[i]<<"}";
+	}
+	output<<"]}"<<std::endl;
+      }
+    }
+  }
+
+  void initialize(const MPI_Comm & mpiComm,
+		  const std::string & fileName)
+  {
+    internal::isTelemetryEnabled=!fileName.empty();
+    internal::telemetryComm=mpiComm;
+    internal::telemetryFileName=fileName;
+    internal::startTime=MPI_Wtime();
+    internal::recordStartTime=internal::startTime;
+    internal::recordStatistics.clear();
+    internal::summaryStatistics.clear();
+    internal::timers.clear();
+
+    //truncate the output file
+    if (internal::isTelemetryEnabled && dealii::Utilities::MPI::this_mpi_process(mpiComm)==0)
+      std::ofstream output(fileName.c_str(),std::ios::trunc);
+  }
+
+  bool isEnabled()
+  {
+    return internal::isTelemetryEnabled;
+  }
+
+  void registerTimer(const std::string & timerName,
+		     const dealii::TimerOutput & timer)
+  {
+    if (!internal::isTelemetryEnabled)
+      return;
+
+    internal::registeredTimer timerData;
+    timerData.timerName=timerName;
+    timerData.timer=&timer;
+    timerData.wallTimes=timer.get_summary_data(dealii::TimerOutput::total_wall_time);
+    timerData.numberCalls=timer.get_summary_data(dealii::TimerOutput::n_calls);
+    internal::timers.push_back(timerData);
+  }
+
+  void deregisterTimer(const dealii::TimerOutput & timer)
+  {
+    if (!internal::isTelemetryEnabled)
+      return;
+
+    for (unsigned int i=0; i<internal::timers.size(); ++i)
+      if (internal::timers[i].timer==&timer)
+      {
+	internal::harvestTimer(internal::timers[i]);
+	internal::timers.erase(internal::timers.begin()+i);
+	return;
+      }
+  }
+
+  void addCommunicatedBytes(const std::string & counterName,
+			    const double bytes)
+  {
+    if (!internal::isTelemetryEnabled)
+      return;
+
+    internal::regionStatistics & statistics=internal::recordStatistics[counterName];
+    statistics.bytesCommunicated+=bytes;
+    statistics.numberCalls++;
+  }
+
+  void addAllocatedBytes(const std::string & counterName,
+			 const double bytes,
+			 const double savedBytes)
+  {
+    if (!internal::isTelemetryEnabled)
+      return;
+
+    internal::recordStatistics[counterName].bytesAllocated+=bytes;
+    internal::recordStatistics[counterName].bytesSaved+=savedBytes;
+  }
+
+  void writeRecord(const std::string & recordType,
+		   const unsigned int recordIndex)
+  {
+    if (!internal::isTelemetryEnabled)
+      return;
+
+    for (unsigned int i=0; i<internal::timers.size(); ++i)
+      internal::harvestTimer(internal::timers[i]);
+
+    const double currentTime=MPI_Wtime();
+    internal::reduceAndWrite(internal::recordStatistics,
+			     recordType,
+			     recordIndex,
+			     currentTime-internal::recordStartTime);
+    internal::recordStartTime=currentTime;
+
+    std::map<std::string,internal::regionStatistics>::const_iterator iter;
+    for (iter=internal::recordStatistics.begin(); iter!=internal::recordStatistics.end(); ++iter)
+    {
+      internal::regionStatistics & statistics=internal::summaryStatistics[iter->first];
+      statistics.wallTime+=iter->second.wallTime;
+      statistics.numberCalls+=iter->second.numberCalls;
+      statistics.bytesCommunicated+=iter->second.bytesCommunicated;
+      statistics.bytesAllocated+=iter->second.bytesAllocated;
+      statistics.bytesSaved+=iter->second.bytesSaved;
+    }
+    internal::recordStatistics.clear();
+  }
+
+  void writeSummary()
+  {
+    if (!internal::isTelemetryEnabled)
+      return;
+
+    for (unsigned int i=0; i<internal::timers.size(); ++i)
+      internal::harvestTimer(internal::timers[i]);
+
+    std::map<std::string,internal::regionStatistics> statistics=internal::summaryStatistics;
+    std::map<std::string,internal::regionStatistics>::const_iterator iter;
+    for (iter=internal::recordStatistics.begin(); iter!=internal::recordStatistics.end(); ++iter)
+    {
+      statistics[iter->first].wallTime+=iter->second.wallTime;
+      statistics[iter->first].numberCalls+=iter->second.numberCalls;
+      statistics[iter->first].bytesCommunicated+=iter->second.bytesCommunicated;
+      statistics[iter->first].bytesAllocated+=iter->second.bytesAllocated;
+      statistics[iter->first].bytesSaved+=iter->second.bytesSaved;
+    }
+
+    internal::reduceAndWrite(statistics,
+			     "summary",
+			     -1,
+			     MPI_Wtime()-internal::startTime);
+  }
+
+}
+
+}
@@ -0,0 +1,324 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <boundingBoxTree.h>
+
+namespace dftfe
+{
+
+namespace vectorTools
+{
+
+boundingBox::boundingBox()
+{
+  for (unsigned int idim=0; idim<3; ++idim)
+  {
+    lower[idim]=std::numeric_limits<double>::max();
+    upper[idim]=-std::numeric_limits<double>::max();
+  }
+}
+
+void boundingBox::extend(const boundingBox & box)
+{
+  for (unsigned int idim=0; idim<3; ++idim)
+  {
+    lower[idim]=std::min(lower[idim],box.lower[idim]);
+    upper[idim]=std::max(upper[idim],box.upper[idim]);
+  }
+}
+
+bool boundingBox::containsPoint(const dealii::Point<3> & p) const
+{
+  for (unsigned int idim=0; idim<3; ++idim)
+    if (p[idim]<lower[idim] || p[idim]>upper[idim])
+      return false;
+  return true;
+}
+
+bool boundingBox::intersects(const boundingBox & box) const
+{
+  for (unsigned int idim=0; idim<3; ++idim)
+    if (box.upper[idim]<lower[idim] || box.lower[idim]>upper[idim])
+      return false;
+  return true;
+}
+
+double boundingBox::center(const unsigned int idim) const
+{
+  return 0.5*(lower[idim]+upper[idim]);
+}
+
+boundingBox cellBoundingBox(const dealii::TriaAccessor<3,3,3> & cell)
+{
+  boundingBox box;
+  for (unsigned int ivertex=0; ivertex<dealii::GeometryInfo<3>::vertices_per_cell; ++ivertex)
+  {
+    const dealii::Point<3> & vertex=cell.vertex(ivertex);
+    for (unsigned int idim=0; idim<3; ++idim)
+    {
+      box.lower[idim]=std::min(box.lower[idim],vertex[idim]);
+      box.upper[idim]=std::max(box.upper[idim],vertex[idim]);
+    }
+  }
+
+  const double tol=1.0e-8*cell.diameter();
+  for (unsigned int idim=0; idim<3; ++idim)
+  {
+    box.lower[idim]-=tol;
+    box.upper[idim]+=tol;
+  }
+  return box;
+}
+
+void boundingBoxTree::build(const std::vector<boundingBox> & boxes,
+			    const std::vector<unsigned int> & ids)
+{
+  AssertThrow(boxes.size()==ids.size(),dealii::ExcMessage("DFT-FE Error: size of boxes and ids are not the same."));
+
+  d_boxes=boxes;
+  d_ids=ids;
+  d_nodes.clear();
+  d_order.resize(boxes.size());
+  std::iota(d_order.begin(),d_order.end(),0);
+  if (!boxes.empty())
+    buildNode(0,boxes.size());
+}
+
+void boundingBoxTree::findBoxesContainingPoint(const dealii::Point<3> & p,
+					       std::vector<unsigned int> & idsFound) const
+{
+  if (d_nodes.empty())
+    return;
+
+  std::vector<unsigned int> stack(1,0);
+  while (!stack.empty())
+  {
+    const node & currentNode=d_nodes[stack.back()];
+    stack.pop_back();
+    if (!currentNode.box.containsPoint(p))
+      continue;
+
+    if (currentNode.left<0)
+    {
+      for (unsigned int i=currentNode.begin; i<currentNode.end; ++i)
+	if (d_boxes[d_order[i]].containsPoint(p))
+	  idsFound.push_back(d_ids[d_order[i]]);
+    }
+    else
+    {
+      stack.push_back(currentNode.left);
+      stack.push_back(currentNode.right);
+    }
+  }
+}
+
+void boundingBoxTree::findBoxesIntersectingBox(const boundingBox & box,
+					       std::vector<unsigned int> & idsFound) const
+{
+  if (d_nodes.empty())
+    return;
+
+  std::vector<unsigned int> stack(1,0);
+  while (!stack.empty())
+  {
+    const node & currentNode=d_nodes[stack.back()];
+    stack.pop_back();
+    if (!currentNode.box.intersects(box))
+      continue;
+
+    if (currentNode.left<0)
+    {
+      for (unsigned int i=currentNode.begin; i<currentNode.end; ++i)
+	if (d_boxes[d_order[i]].intersects(box))
+	  idsFound.push_back(d_ids[d_order[i]]);
+    }
+    else
+    {
+      stack.push_back(currentNode.left);
+      stack.push_back(currentNode.right);
+    }
+  }
+}
+
+unsigned int boundingBoxTree::buildNode(const unsigned int begin,
+					const unsigned int end)
+{
+  const unsigned int nodeIndex=d_nodes.size();
+  d_nodes.push_back(node());
+
+  boundingBox box;
+  boundingBox centersBox;
+  for (unsigned int i=begin; i<end; ++i)
+  {
+    box.extend(d_boxes[d_order[i]]);
+    for (unsigned int idim=0; idim<3; ++idim)
+    {
+      centersBox.lower[idim]=std::min(centersBox.lower[idim],d_boxes[d_order[i]].center(idim));
+      centersBox.upper[idim]=std::max(centersBox.upper[idim],d_boxes[d_order[i]].center(idim));
+    }
+  }
+
+  d_nodes[nodeIndex].box=box;
+  d_nodes[nodeIndex].begin=begin;
+  d_nodes[nodeIndex].end=end;
+  d_nodes[nodeIndex].left=-1;
+  d_nodes[nodeIndex].right=-1;
+
+  const unsigned int maxBoxesPerLeaf=8;
+  if (end-begin<=maxBoxesPerLeaf)
+    return nodeIndex;
+
+  unsigned int splitDim=0;
+  for (unsigned int idim=1; idim<3; ++idim)
+    if (centersBox.upper[idim]-centersBox.lower[idim]>centersBox.upper[splitDim]-centersBox.lower[splitDim])
+      splitDim=idim;
+
+  const unsigned int mid=begin+(end-begin)/2;
+  const std::vector<boundingBox> & boxes=d_boxes;
+  std::nth_element(d_order.begin()+begin,
+		   d_order.begin()+mid,
+		   d_order.begin()+end,
+		   [&boxes,splitDim](const unsigned int a, const unsigned int b)
+		   {return boxes[a].center(splitDim)<boxes[b].center(splitDim);});
+
+  const unsigned int leftChild=buildNode(begin,mid);
+  const unsigned int rightChild=buildNode(mid,end);
+  d_nodes[nodeIndex].left=leftChild;
+  d_nodes[nodeIndex].right=rightChild;
+  return nodeIndex;
+}
+
+void buildPartitionBoundingBoxTree(const std::vector<boundingBox> & locallyOwnedCellBoxes,
+				   const unsigned int maxBoxesPerProc,
+				   const MPI_Comm & mpi_comm,
+				   boundingBoxTree & partitionBoxesTree)
+{
+  const unsigned int n_mpi_processes=dealii::Utilities::MPI::n_mpi_processes(mpi_comm);
+  const unsigned int numLocallyOwnedCells=locallyOwnedCellBoxes.size();
+  const unsigned int numBoxesLocal=std::min(maxBoxesPerProc,numLocallyOwnedCells);
+
+  std::vector<double> boxesLocalData(6*numBoxesLocal+1);
+  for (unsigned int ibox=0; ibox<numBoxesLocal; ++ibox)
+  {
+     boundingBox chunkBox;
+     const unsigned int cellBegin=(ibox*numLocallyOwnedCells)/numBoxesLocal;
+     const unsigned int cellEnd=((ibox+1)*numLocallyOwnedCells)/numBoxesLocal;
+     for (unsigned int icell=cellBegin; icell<cellEnd; ++icell)
+        chunkBox.extend(locallyOwnedCellBoxes[icell]);
+
+     for (unsigned int idim=0; idim<3; ++idim)
+     {
+        boxesLocalData[6*ibox+idim]=chunkBox.lower[idim];
+	boxesLocalData[6*ibox+3+idim]=chunkBox.upper[idim];
+     }
+  }
+
+  std::vector<int> numBoxesAllProcs(n_mpi_processes,0);
+  int numBoxesLocalInt=numBoxesLocal;
+  MPI_Allgather(&numBoxesLocalInt,
+		1,
+		MPI_INT,
+		&numBoxesAllProcs[0],
+		1,
+		MPI_INT,
+		mpi_comm);
+
+  std::vector<int> boxesDataSizes(n_mpi_processes,0);
+  std::vector<int> boxesDataOffsets(n_mpi_processes,0);
+  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
+  {
+     boxesDataSizes[proc]=6*numBoxesAllProcs[proc];
+     if (proc>0)
+       boxesDataOffsets[proc]=boxesDataOffsets[proc-1]+boxesDataSizes[proc-1];
+  }
+
+  const unsigned int numBoxesGlobal=std::accumulate(numBoxesAllProcs.begin(),numBoxesAllProcs.end(),0);
+  std::vector<double> boxesGlobalData(6*numBoxesGlobal+1,0.0);
+  MPI_Allgatherv(&boxesLocalData[0],
+		 6*numBoxesLocal,
+		 MPI_DOUBLE,
+		 &boxesGlobalData[0],
+		 &boxesDataSizes[0],
+		 &boxesDataOffsets[0],
+		 MPI_DOUBLE,
+		 mpi_comm);
+
+  std::vector<boundingBox> partitionBoxes(numBoxesGlobal);
+  std::vector<unsigned int> partitionBoxesOwner(numBoxesGlobal);
+  unsigned int iboxGlobal=0;
+  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
+     for (int ibox=0; ibox<numBoxesAllProcs[proc]; ++ibox)
+     {
+        for (unsigned int idim=0; idim<3; ++idim)
+	{
+	   partitionBoxes[iboxGlobal].lower[idim]=boxesGlobalData[6*iboxGlobal+idim];
+	   partitionBoxes[iboxGlobal].upper[idim]=boxesGlobalData[6*iboxGlobal+3+idim];
+	}
+	partitionBoxesOwner[iboxGlobal]=proc;
+	iboxGlobal++;
+     }
+
+  partitionBoxesTree.build(partitionBoxes,partitionBoxesOwner);
+}
+
+double gaussianGeneratorSupportRadius(const double gaussianConstant,
+				      const unsigned int exponent,
+				      const double weightTolerance)
+{
+  AssertThrow(weightTolerance>0.0 && weightTolerance<1.0,
+	      dealii::ExcMessage("DFT-FE Error: Gaussian generator weight tolerance must be in (0,1)."));
+
+  //exp(-(r/gaussianConstant)^exponent)=weightTolerance
+  return gaussianConstant*std::pow(-std::log(weightTolerance),1.0/exponent);
+}
+
+void buildControlPointsSupportTree(const std::vector<dealii::Point<3> > & controlPoints,
+				   const double supportRadius,
+				   boundingBoxTree & controlPointsTree)
+{
+  std::vector<boundingBox> boxes(controlPoints.size());
+  std::vector<unsigned int> ids(controlPoints.size());
+  for (unsigned int i=0; i<controlPoints.size(); ++i)
+  {
+    for (unsigned int idim=0; idim<3; ++idim)
+    {
+      boxes[i].lower[idim]=controlPoints[i][idim]-supportRadius;
+      boxes[i].upper[idim]=controlPoints[i][idim]+supportRadius;
+    }
+    ids[i]=i;
+  }
+
+  controlPointsTree.build(boxes,ids);
+}
+
+void findCellControlPointCandidates(const dealii::TriaAccessor<3,3,3> & cell,
+				    const boundingBoxTree & controlPointsTree,
+				    const double padding,
+				    std::vector<unsigned int> & candidateIds)
+{
+  boundingBox box=cellBoundingBox(cell);
+  for (unsigned int idim=0; idim<3; ++idim)
+  {
+    box.lower[idim]-=padding;
+    box.upper[idim]+=padding;
+  }
+
+  candidateIds.clear();
+  controlPointsTree.findBoxesIntersectingBox(box,candidateIds);
+  std::sort(candidateIds.begin(),candidateIds.end());
+}
+
+}
+}
@@ -0,0 +1,114 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (c) 2017-2018 The Regents of the University of Michigan and DFT-FE authors.
+//
+// This file is part of the DFT-FE code.
+//
+// The DFT-FE code is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE at
+// the top level of the DFT-FE distribution.
+//
+// ---------------------------------------------------------------------
+
+#include <flattenedArrayRegistry.h>
+#include <vectorUtilities.h>
+#include <limits>
+
+namespace dftfe
+{
+
+  namespace vectorTools
+  {
+
+    flattenedArrayRegistry::registryEntry &
+    flattenedArrayRegistry::getEntry(const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & partitioner,
+				     const unsigned int blockSize)
+    {
+      //
+      //discard the entries whose single component partitioner is only referenced by the registry
+      //
+      std::vector<registryEntry>::iterator it=d_entries.begin();
+      while (it!=d_entries.end())
+	{
+	  if (it->unFlattenedPartitioner.use_count()==1)
+	    it=d_entries.erase(it);
+	  else
+	    ++it;
+	}
+
+      for (unsigned int i=0; i<d_entries.size(); ++i)
+	if (d_entries[i].unFlattenedPartitioner==partitioner && d_entries[i].blockSize==blockSize)
+	  return d_entries[i];
+
+      AssertThrow(((dealii::types::global_dof_index)partitioner->local_size()
+		   +partitioner->n_ghost_indices())*blockSize
+		  <=std::numeric_limits<unsigned int>::max(),
+		  dealii::ExcMessage("DFT-FE Error: local size of the flattened array exceeds the range of unsigned int. Reduce the wavefunction block size or use more MPI tasks."));
+
+      registryEntry entry;
+      entry.unFlattenedPartitioner=partitioner;
+      entry.blockSize=blockSize;
+      entry.isIndexMapsComputed=false;
+      entry.data=std::make_shared<flattenedArrayData>();
+      entry.data->partitioner=createFlattenedPartitioner(partitioner,
+							 blockSize);
+      d_entries.push_back(entry);
+
+      return d_entries.back();
+    }
+
+
+    std::shared_ptr<const flattenedArrayRegistry::flattenedArrayData>
+    flattenedArrayRegistry::getFlattenedArrayData(const dealii::MatrixFree<3,double> & matrixFreeData,
+						  const unsigned int blockSize)
+    {
+      const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & unFlattenedPartitioner
+	=matrixFreeData.get_vector_partitioner();
+
+      registryEntry & entry=getEntry(unFlattenedPartitioner,
+				     blockSize);
+
+      if (!entry.isIndexMapsComputed)
+	{
+	  computeCellLocalIndexSetMap(entry.data->partitioner,
+				      matrixFreeData,
+				      blockSize,
+				      entry.data->macroCellLocalProcIndexIdMap,
+				      entry.data->cellLocalProcIndexIdMap);
+
+	  const unsigned int totalSize=unFlattenedPartitioner->local_size()+unFlattenedPartitioner->n_ghost_indices();
+	  std::shared_ptr<std::vector<unsigned int> > localIndexMapUnflattenedToFlattened
+	    =std::make_shared<std::vector<unsigned int> >(totalSize);
+	  for(unsigned int ilocalDof = 0; ilocalDof < totalSize; ++ilocalDof)
+	    {
+	      const dealii::types::global_dof_index globalIndex = unFlattenedPartitioner->local_to_global(ilocalDof);
+	      (*localIndexMapUnflattenedToFlattened)[ilocalDof] = entry.data->partitioner->global_to_local(globalIndex*blockSize);
+	    }
+	  entry.data->localIndexMapUnflattenedToFlattened=localIndexMapUnflattenedToFlattened;
+
+	  entry.isIndexMapsComputed=true;
+	}
+
+      return entry.data;
+    }
+
+
+    std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+    flattenedArrayRegistry::getFlattenedPartitioner(const std::shared_ptr<const dealii::Utilities::MPI::Partitioner> & partitioner,
+						    const unsigned int blockSize)
+    {
+      return getEntry(partitioner,blockSize).data->partitioner;
+    }
+
+
+    void flattenedArrayRegistry::clear()
+    {
+      d_entries.clear();
+    }
+
+  }
+
+}
@@ -19,6 +19,7 @@
 
 
 #include <interpolateFieldsFromPreviousMesh.h>
+#include <boundingBoxTree.h>
 #include <dftParameters.h>
 
 namespace dftfe
@@ -26,6 +27,7 @@ namespace dftfe
 
 namespace vectorTools
 {
+
 //
 //constructor
 //
@@ -38,8 +40,7 @@ interpolateFieldsFromPreviousMesh::interpolateFieldsFromPreviousMesh(const MPI_C
 }
 
 void interpolateFieldsFromPreviousMesh::interpolate
-                  (const dealii::parallel::distributed::Triangulation<3> & triangulationSerPrev,
-		   const dealii::parallel::distributed::Triangulation<3> & triangulationParPrev,
+                  (const dealii::parallel::distributed::Triangulation<3> & triangulationParPrev,
 		   const dealii::parallel::distributed::Triangulation<3> & triangulationParCurrent,
 		   const dealii::FESystem<3> & FEPrev,
 		   const dealii::FESystem<3> & FECurrent,
@@ -48,10 +49,12 @@ void interpolateFieldsFromPreviousMesh::interpolate
 		   const dealii::ConstraintMatrix * constraintsCurrentPtr)
 {
   AssertThrow(FEPrev.components==FECurrent.components,dealii::ExcMessage("FEPrev and FECurrent must have the same number of components."));
+  AssertThrow(fieldsPreviousMesh.size()==fieldsCurrentMesh.size(),dealii::ExcMessage("Size of fieldsPreviousMesh and fieldsCurrentMesh are no the same."));
 
   const unsigned int dofs_per_cell_current = FECurrent.dofs_per_cell;
   const unsigned int fe_components=FECurrent.components;
   const unsigned int base_indices_per_cell_current = dofs_per_cell_current/fe_components;
+  const unsigned int fieldsBlockSize=fieldsPreviousMesh.size();
 
   /// compute-time logger
   dealii::TimerOutput computing_timer(mpi_communicator,
@@ -60,465 +63,356 @@ void interpolateFieldsFromPreviousMesh::interpolate
 				      dftParameters::verbosity<2 ? dealii::TimerOutput::never:
 				      dealii::TimerOutput::summary,dealii::TimerOutput::wall_times);
 
-  ///////////////////////////////////////////////////////////////////////////////
-  //Step1: create maps which will be used for the MPI calls in the later steps///
-  ///////////////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////////////////
+  //Step1: bounding boxes of locally owned previous mesh cells, and coarse bounding boxes ///
+  //of every processor's partition gathered on all processors                            ///
+  //////////////////////////////////////////////////////////////////////////////////////////
 
   computing_timer.enter_section("interpolate:step1");
   dealii::DoFHandler<3> dofHandlerUnmovedParPrev(triangulationParPrev);
   dofHandlerUnmovedParPrev.distribute_dofs(FEPrev);
 
-  typename dealii::parallel::distributed::Triangulation<3>::active_cell_iterator cellTria= triangulationSerPrev.begin_active(), endcTria= triangulationSerPrev.end();
-  const unsigned int numGlobalCellsPrev=triangulationSerPrev.n_global_active_cells();
-
-  std::map<dealii::CellId, unsigned int> globalCellIdToCellNumSerPrev;
-  std::map<dealii::CellId, dealii::Tensor<1, 3, double> > globalCellIdSerCenters;
-  unsigned int icell=0;
-  for (; cellTria!=endcTria; ++cellTria)
-  {
-      globalCellIdToCellNumSerPrev[cellTria->id()] = icell;
-      globalCellIdSerCenters[cellTria->id()] = cellTria->center();
-      icell++ ;
-  }
-  //
-  /// Owner processor ids of previous parallel mesh cells over a vector with ids corresponding to previous
-  /// serial mesh cell numbers starting from 0 to total number of cells
-  std::vector<unsigned int> cellParPrevToOwnerProcMap(numGlobalCellsPrev);
-
-  /// map between previous serial mesh cell number to active cell iterator
-  std::map<unsigned int,typename dealii::DoFHandler<3>::active_cell_iterator> cellNumSerPrevToParPrevCellIter;
-
-
-  std::map<dealii::CellId, unsigned int> globalCellIdToCellNumParPrev;
-  std::vector<unsigned int> ownerProcLocal(numGlobalCellsPrev,0);
+  std::vector<typename dealii::DoFHandler<3>::active_cell_iterator> locallyOwnedCellsPrev;
+  std::vector<boundingBox> locallyOwnedCellBoxesPrev;
   typename dealii::DoFHandler<3>::active_cell_iterator cell = dofHandlerUnmovedParPrev.begin_active();
   typename dealii::DoFHandler<3>::active_cell_iterator endc = dofHandlerUnmovedParPrev.end();
-  dealii::Tensor<1, 3, double> center_diff;
   for(; cell!=endc; ++cell)
-  {
      if (cell->is_locally_owned())
      {
-	 globalCellIdToCellNumParPrev[cell->id()] = globalCellIdToCellNumSerPrev[cell->id()];
-
-         AssertThrow((globalCellIdSerCenters[cell->id()]-cell->center()).norm_square()<1.0e-5,dealii::ExcMessage("Cell ids of serial and parallel triangulation are not same for the same physical cells."));
-	 /*
-	 typename dealii::parallel::distributed::Triangulation<3>::active_cell_iterator cellTriaTemp = triangulationSerPrev.begin_active(), endcTriaTemp = triangulationSerPrev.end();
-	 for(; cellTriaTemp!=endcTriaTemp; ++cellTriaTemp)
-	 {
-	    center_diff = cellTriaTemp->center() - cellTria->center() ;
-	    if (center_diff.norms_square() < 1.0E-5 )
-	    {
-		globalCellIdToCellNumSerPrev[cellTria->id()] = globalCellId[cellTriaTemp->id()] ;
-		break;
-	    }
-	 }
-	 */
-         ownerProcLocal[globalCellIdToCellNumSerPrev[cell->id()]] = this_mpi_process;
-	 cellNumSerPrevToParPrevCellIter[globalCellIdToCellNumSerPrev[cell->id()]]=cell;
-      }
-  }
-  //
-  MPI_Allreduce(&ownerProcLocal[0],
-		&cellParPrevToOwnerProcMap[0],
-		numGlobalCellsPrev,
-		MPI_UNSIGNED,
-		MPI_SUM,
-		mpi_communicator);
-
-  const unsigned int numLocallyOwnedCellsCurrent=triangulationParCurrent.n_locally_owned_active_cells();
-
-  dealii::DoFHandler<3> dofHandlerUnmovedCurrent(triangulationParCurrent);
-  dofHandlerUnmovedCurrent.distribute_dofs(FECurrent);
-  std::map<dealii::types::global_dof_index, dealii::Point<3> > supportPointsUnmovedCurrent;
-  dealii::DoFTools::map_dofs_to_support_points(dealii::MappingQ1<3,3>(), dofHandlerUnmovedCurrent, supportPointsUnmovedCurrent);
-
+        locallyOwnedCellsPrev.push_back(cell);
+	locallyOwnedCellBoxesPrev.push_back(cellBoundingBox(*cell));
+     }
+
+  const unsigned int numLocallyOwnedCellsPrev=locallyOwnedCellsPrev.size();
+  std::vector<unsigned int> localCellIds(numLocallyOwnedCellsPrev);
+  std::iota(localCellIds.begin(),localCellIds.end(),0);
+  boundingBoxTree localCellsTree;
+  localCellsTree.build(locallyOwnedCellBoxesPrev,localCellIds);
+
+  boundingBoxTree procBoxesTree;
+  buildPartitionBoundingBoxTree(locallyOwnedCellBoxesPrev,
+				32,
+				mpi_communicator,
+				procBoxesTree);
   computing_timer.exit_section("interpolate:step1");
 
-  ///////////////////////////////////////////////////////////
-  //Step2: collect sending information from each processor///
-  ///////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////////////////////
+  //Step2: route support points of locally owned current mesh dofs to candidate owning///
+  //processors of the previous mesh                                                   ///
+  //////////////////////////////////////////////////////////////////////////////////////
 
   computing_timer.enter_section("interpolate:step2");
   const dealii::MappingQ1<3> mapping;
 
-  //
-  std::vector<std::vector<std::tuple<unsigned int,unsigned int,unsigned int> >> mappedGroup(numLocallyOwnedCellsCurrent);
-
-  //<current mesh cell number<owning processor of mapped points of current mesh cell base indices in previous serial mesh<previous serial mesh cell numbers belonging to owning processor containing the mapped points>>>
-  std::vector<std::vector<std::vector<unsigned int> >> mappedGroupSend0(numLocallyOwnedCellsCurrent,std::vector<std::vector<unsigned int> >(n_mpi_processes));
-
-  //<current mesh cell no<owning processor of mapped points of current mesh cell base indices in previous serial mesh<size of mapped points inside each previous serial mesh cell number corresponding to mappedGroupSend0>>>
-  std::vector<std::vector<std::vector<unsigned int> >> mappedGroupSend2(numLocallyOwnedCellsCurrent,std::vector<std::vector<unsigned int> >(n_mpi_processes));
+  dealii::DoFHandler<3> dofHandlerUnmovedCurrent(triangulationParCurrent);
+  dofHandlerUnmovedCurrent.distribute_dofs(FECurrent);
+  std::map<dealii::types::global_dof_index, dealii::Point<3> > supportPointsUnmovedCurrent;
+  dealii::DoFTools::map_dofs_to_support_points(mapping, dofHandlerUnmovedCurrent, supportPointsUnmovedCurrent);
 
-  //<current mesh cell no<owning processor of mapped points of current mesh cell base indices in previous serial mesh<x,y,z reference coordinate component vectors<reference coordinate component value of each mapped dof of current mesh cell no in the owning processor>>>>
-  std::vector<std::vector<std::vector<std::vector<double>>> > mappedGroupSend1(numLocallyOwnedCellsCurrent,std::vector<std::vector<std::vector<double>>>(n_mpi_processes,std::vector<std::vector<double>>(3)));
+  const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner
+                   =fieldsCurrentMesh[0]->get_partitioner();
 
-  //<current mesh cell no<owning processor of mapped points of current mesh cell base indices in previous serial mesh<send buffer sizes for mappedGroupSend0 and Send2>>
-  std::vector<std::vector<unsigned int> > send0_buf_size(numLocallyOwnedCellsCurrent,std::vector<unsigned int>(n_mpi_processes,0));
+  //global dof indices of all components of each point to be interpolated
+  std::vector<dealii::types::global_dof_index> pointsDofIndices;
+  std::vector<dealii::Point<3>> pointsCurrent;
 
-  //<current mesh cell no<owning processor of mapped points of current mesh cell base indices in previous serial mesh<send buffer sizes for mappedGroupSend1>>
-  std::vector<std::vector<unsigned int> > send1_buf_size(numLocallyOwnedCellsCurrent,std::vector<unsigned int>(n_mpi_processes,0));
+  std::vector<std::vector<double> > sendPointsCoords(n_mpi_processes);
+  std::vector<std::vector<unsigned int> > sendPointsIds(n_mpi_processes);
 
-  std::vector<unsigned int> countPointPerProc(n_mpi_processes);
-  std::vector<bool> dofsTouched(dofHandlerUnmovedCurrent.n_dofs(),
-				   false);
+  std::vector<bool> dofsTouched(partitioner->local_size(),false);
+  std::vector<dealii::types::global_dof_index> cell_dof_indices(dofs_per_cell_current);
+  std::vector<unsigned int> candidateProcs;
   cell = dofHandlerUnmovedCurrent.begin_active();endc = dofHandlerUnmovedCurrent.end();
-  unsigned int iLocalCellCurrent=0;
   for (; cell!=endc; ++cell)
-  {
     if (cell->is_locally_owned())
     {
-	  std::map<dealii::CellId,std::vector<std::pair<std::vector<double>,unsigned int>>>  cellSerPrevToMappedDofData;
-
-	  std::vector<dealii::types::global_dof_index> cell_dof_indices(dofs_per_cell_current);
 	  cell->get_dof_indices(cell_dof_indices);
-
-	  std::pair<typename dealii::parallel::distributed::Triangulation<3>::active_cell_iterator, dealii::Point<3> > mappedCellSerPrev;
-	  unsigned int count=0;
 	  for(unsigned int ibase = 0; ibase< base_indices_per_cell_current; ++ibase)
 	  {
 	         const dealii::types::global_dof_index globalDofId=cell_dof_indices[FECurrent.component_to_system_index(0,ibase)];
 
-		 if (!dofsTouched[globalDofId])
-                     dofsTouched[globalDofId]=true;
+		 //only locally owned dofs are interpolated, the ghost values are obtained from their owners
+		 if (!partitioner->in_local_range(globalDofId))
+		     continue;
+
+		 if (!dofsTouched[partitioner->global_to_local(globalDofId)])
+		     dofsTouched[partitioner->global_to_local(globalDofId)]=true;
 		 else
 		     continue;
 
+		 const unsigned int pointId=pointsCurrent.size();
 		 const dealii::Point<3> & p =supportPointsUnmovedCurrent[globalDofId];
+		 pointsCurrent.push_back(p);
+		 for (unsigned int icomp=0; icomp<fe_components; icomp++)
+		     pointsDofIndices.push_back(cell_dof_indices[FECurrent.component_to_system_index(icomp,ibase)]);
 
-		 if (count==0)
-		 {
-	            mappedCellSerPrev = dealii::GridTools::find_active_cell_around_point(mapping,triangulationSerPrev,p );
-		 }
-		 else
+		 candidateProcs.clear();
+		 procBoxesTree.findBoxesContainingPoint(p,candidateProcs);
+		 std::sort(candidateProcs.begin(),candidateProcs.end());
+		 candidateProcs.erase(std::unique(candidateProcs.begin(),candidateProcs.end()),candidateProcs.end());
+
+		 AssertThrow(candidateProcs.size()>0,dealii::ExcMessage("DFT-FE Error: support point of current mesh lies outside the previous mesh."));
+
+		 for (unsigned int i=0; i<candidateProcs.size(); ++i)
 		 {
-		   double dist = 1.0E+06 ;
-		   try
-		   {
-		      dealii::Point<3> p_cell =  mapping.transform_real_to_unit_cell( mappedCellSerPrev.first, p ) ;
-		      dist = dealii::GeometryInfo<3>::distance_to_unit_cell(p_cell);
-		      if (dist < 1.0E-10)
-			mappedCellSerPrev.second = p_cell ;
-		   }
-		   catch (dealii::MappingQ1<3>::ExcTransformationFailed)
-		   {
-
-		   }
-		   if (dist > 1.0E-10)
-		      mappedCellSerPrev = dealii::GridTools::find_active_cell_around_point(mapping, triangulationSerPrev, p) ;
+		    sendPointsIds[candidateProcs[i]].push_back(pointId);
+		    for (unsigned int idim=0; idim<3; ++idim)
+		       sendPointsCoords[candidateProcs[i]].push_back(p[idim]);
 		 }
+	  }//base_indices_per_cell loop
+    }//locally owned cell loop
+  dofsTouched.clear();
+  supportPointsUnmovedCurrent.clear();
+
+  std::vector<int> sendPointsCount(n_mpi_processes,0);
+  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
+     sendPointsCount[proc]=sendPointsIds[proc].size();
+
+  std::vector<int> recvPointsCount(n_mpi_processes,0);
+  MPI_Alltoall(&sendPointsCount[0],
+	       1,
+	       MPI_INT,
+	       &recvPointsCount[0],
+	       1,
+	       MPI_INT,
+	       mpi_communicator);
+
+  std::vector<int> sendPointsOffsets(n_mpi_processes,0);
+  std::vector<int> recvPointsOffsets(n_mpi_processes,0);
+  for (unsigned int proc=1; proc<n_mpi_processes; ++proc)
+  {
+     sendPointsOffsets[proc]=sendPointsOffsets[proc-1]+sendPointsCount[proc-1];
+     recvPointsOffsets[proc]=recvPointsOffsets[proc-1]+recvPointsCount[proc-1];
+  }
+  const unsigned int totSendPoints=std::accumulate(sendPointsCount.begin(),sendPointsCount.end(),0);
+  const unsigned int totRecvPoints=std::accumulate(recvPointsCount.begin(),recvPointsCount.end(),0);
 
-		 const dealii::Point<3> pointTemp =dealii::GeometryInfo<3>::project_to_unit_cell(mappedCellSerPrev.second);
-
-		 std::vector<double> mappedPoint(3);
-		 mappedPoint[0] = pointTemp.operator()(0);
-		 mappedPoint[1] = pointTemp.operator()(1);
-		 mappedPoint[2] = pointTemp.operator()(2);
+  std::vector<double> sendPointsData(3*totSendPoints+1);
+  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
+     std::copy(sendPointsCoords[proc].begin(),sendPointsCoords[proc].end(),sendPointsData.begin()+3*sendPointsOffsets[proc]);
+  sendPointsCoords.clear();
 
-		 const std::pair<std::vector<double>,unsigned int> pairTemp = std::make_pair(mappedPoint,ibase);
-		 cellSerPrevToMappedDofData[mappedCellSerPrev.first->id()].push_back(pairTemp);
-		 count++;
-	  }//base_indices_per_cell loop
+  std::vector<int> sendCoordsCount(n_mpi_processes),sendCoordsOffsets(n_mpi_processes);
+  std::vector<int> recvCoordsCount(n_mpi_processes),recvCoordsOffsets(n_mpi_processes);
+  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
+  {
+     sendCoordsCount[proc]=3*sendPointsCount[proc];
+     sendCoordsOffsets[proc]=3*sendPointsOffsets[proc];
+     recvCoordsCount[proc]=3*recvPointsCount[proc];
+     recvCoordsOffsets[proc]=3*recvPointsOffsets[proc];
+  }
 
-	  std::fill(countPointPerProc.begin(),countPointPerProc.end(),0);
-	  for(std::map<dealii::CellId,std::vector<std::pair<std::vector<double>,unsigned int> >>::iterator iter = cellSerPrevToMappedDofData.begin(); iter != cellSerPrevToMappedDofData.end(); ++iter)
-	  {
-	     const std::vector<std::pair<std::vector<double>,unsigned int> > & value = iter->second;
-	     const dealii::CellId & key = iter->first;
-
-             Assert(globalCellIdToCellNumSerPrev.find(key)!=globalCellIdToCellNumSerPrev.end(),dealii::ExcMessage("Invalid cellid key."));
-
-             Assert(globalCellIdToCellNumSerPrev[key]<cellParPrevToOwnerProcMap.size(),dealii::ExcMessage("Invalid serial cell number."));
-
-	     const unsigned int ownerProcIdMappedCellSerPrev =
-		       cellParPrevToOwnerProcMap[globalCellIdToCellNumSerPrev[key]] ;
-	     mappedGroupSend0[iLocalCellCurrent][ownerProcIdMappedCellSerPrev].push_back(globalCellIdToCellNumSerPrev[key]) ;
-	     mappedGroupSend2[iLocalCellCurrent][ownerProcIdMappedCellSerPrev].push_back(value.size()) ;
-	     send0_buf_size[iLocalCellCurrent][ownerProcIdMappedCellSerPrev]++;
-	     //
-	     for (unsigned int i=0; i<value.size(); ++i)
-	     {
-	       const std::vector<double> & mappedPoint = value[i].first ;
-	       const unsigned int baseIndexId = value[i].second;
-	       //
-	       const std::tuple<unsigned int, unsigned int,unsigned int> tupleTemp2 = std::make_tuple(ownerProcIdMappedCellSerPrev,baseIndexId,countPointPerProc[ownerProcIdMappedCellSerPrev]);
-	       mappedGroup[iLocalCellCurrent].push_back(tupleTemp2);
-
-	       countPointPerProc[ownerProcIdMappedCellSerPrev] ++;
-	       //
-	       mappedGroupSend1[iLocalCellCurrent][ownerProcIdMappedCellSerPrev][0].push_back(mappedPoint[0]);
-	       mappedGroupSend1[iLocalCellCurrent][ownerProcIdMappedCellSerPrev][1].push_back(mappedPoint[1]);
-	       mappedGroupSend1[iLocalCellCurrent][ownerProcIdMappedCellSerPrev][2].push_back(mappedPoint[2]);
-
-	       send1_buf_size[iLocalCellCurrent][ownerProcIdMappedCellSerPrev]++;
-	     }//loop over all mapped dof points inside each serial prev cell
-          }//loop over serial prev cells
-	  iLocalCellCurrent++;
-      }//locally_owned
-  }//cell_loop
-    //
-  MPI_Barrier(mpi_communicator);
+  std::vector<double> recvPointsData(3*totRecvPoints+1);
+  MPI_Alltoallv(&sendPointsData[0],
+		&sendCoordsCount[0],
+		&sendCoordsOffsets[0],
+		MPI_DOUBLE,
+		&recvPointsData[0],
+		&recvCoordsCount[0],
+		&recvCoordsOffsets[0],
+		MPI_DOUBLE,
+		mpi_communicator);
+  sendPointsData.clear();
   computing_timer.exit_section("interpolate:step2");
 
-  ////////////////////////////////////////////////////
-  //Step3: Gather mapped points from all processors///
-  ////////////////////////////////////////////////////
+  ////////////////////////////////////////////////////////////////////////
+  //Step3: locate received points in the locally owned previous mesh cells//
+  ////////////////////////////////////////////////////////////////////////
 
   computing_timer.enter_section("interpolate:step3");
-  /// <sending processor<data size in d_recvData0 from sending processor> >
-  std::vector<int> recv_size0(n_mpi_processes, 0);
+  //distance to the reference cell of the located cell, max double if the point was not found
+  std::vector<double> recvPointsDistance(totRecvPoints,std::numeric_limits<double>::max());
+  std::vector<dealii::Point<3>> recvPointsUnitCoords(totRecvPoints);
+  std::map<unsigned int,std::vector<unsigned int> > locatedCellToRecvPoints;
+
+  std::vector<unsigned int> candidateCells;
+  unsigned int previousCellId=numLocallyOwnedCellsPrev;
+  for (unsigned int ipoint=0; ipoint<totRecvPoints; ++ipoint)
+  {
+     const dealii::Point<3> p(recvPointsData[3*ipoint],recvPointsData[3*ipoint+1],recvPointsData[3*ipoint+2]);
 
-  /// <sending processor<data size in d_recvData1 accumulated over all three components (d_recvData1[0],d_recvData1[1],d_recvData1[2]) from sending processor> >
-  std::vector<int> recv_size1(n_mpi_processes, 0);
+     double minDist=std::numeric_limits<double>::max();
+     unsigned int bestCellId=numLocallyOwnedCellsPrev;
+     dealii::Point<3> bestUnitPoint;
 
-  std::vector<int> mpi_offsets0(n_mpi_processes, 0);
+     //consecutive points mostly lie in the same cell, so first try the previously located cell
+     if (previousCellId<numLocallyOwnedCellsPrev && locallyOwnedCellBoxesPrev[previousCellId].containsPoint(p))
+     {
+        try
+        {
+	   const dealii::Point<3> p_cell=mapping.transform_real_to_unit_cell(locallyOwnedCellsPrev[previousCellId], p);
+	   const double dist=dealii::GeometryInfo<3>::distance_to_unit_cell(p_cell);
+	   if (dist < 1.0E-10)
+	   {
+	      minDist=dist;
+	      bestCellId=previousCellId;
+	      bestUnitPoint=p_cell;
+	   }
+        }
+        catch (dealii::MappingQ1<3>::ExcTransformationFailed)
+        {
 
-  std::vector<int> mpi_offsets1(n_mpi_processes, 0);
+        }
+     }
 
-  /// <serial mesh cell numbers belonging to receiving processor which contain mapped points from all sending processors>
-  std::vector<unsigned int> recvData0;
+     if (bestCellId==numLocallyOwnedCellsPrev)
+     {
+        candidateCells.clear();
+        localCellsTree.findBoxesContainingPoint(p,candidateCells);
+        for (unsigned int i=0; i<candidateCells.size(); ++i)
+        {
+	   try
+	   {
+	      const dealii::Point<3> p_cell=mapping.transform_real_to_unit_cell(locallyOwnedCellsPrev[candidateCells[i]], p);
+	      const double dist=dealii::GeometryInfo<3>::distance_to_unit_cell(p_cell);
+	      if (dist<minDist)
+	      {
+		 minDist=dist;
+		 bestCellId=candidateCells[i];
+		 bestUnitPoint=p_cell;
+	      }
+	   }
+	   catch (dealii::MappingQ1<3>::ExcTransformationFailed)
+	   {
 
-  /// <size of mapped point data attached to each entry of d_recvData0>
-  std::vector<unsigned int> recvData2;
+	   }
+        }
+     }
 
-  /// <x,y,z component of reference coordinate<accumulation from all sending processors the reference coordinate component of mapped points in receiving processor from locally owned cells from that sending processor> >
-  std::vector<std::vector<double>> recvData1(3);
-     //
-  for ( unsigned int proc = 0; proc < n_mpi_processes; ++proc)
-  {
-	unsigned int send_size1 = 0;
-	unsigned int send_size0 = 0;
-        std::vector<unsigned int> send_data0, send_data2;
-        std::vector<std::vector<double>> send_data1(3);
-	std::vector<double>  send_data, recvData;
-
-	cell = dofHandlerUnmovedCurrent.begin_active();
-	endc = dofHandlerUnmovedCurrent.end();
-	iLocalCellCurrent=0;
-	for (; cell!=endc; ++cell)
-	 {
-	  if (cell->is_locally_owned())
-	  {
-	     for (unsigned int iPoint = 0; iPoint < send1_buf_size[iLocalCellCurrent][proc]; ++iPoint)
-	     {
-		 //
-		 send_data1[0].push_back(mappedGroupSend1[iLocalCellCurrent][proc][0][iPoint])  ;
-		 send_data1[1].push_back(mappedGroupSend1[iLocalCellCurrent][proc][1][iPoint])  ;
-		 send_data1[2].push_back(mappedGroupSend1[iLocalCellCurrent][proc][2][iPoint])  ;
-	     }
-	     send_size1 += send1_buf_size[iLocalCellCurrent][proc];
-	     //
-	     for (unsigned int i = 0; i < send0_buf_size[iLocalCellCurrent][proc]; ++i)
-	     {
-		 //
-		 send_data0.push_back(mappedGroupSend0[iLocalCellCurrent][proc][i])  ;
-		 send_data2.push_back(mappedGroupSend2[iLocalCellCurrent][proc][i])  ;
-	     }
-	     send_size0 += send0_buf_size[iLocalCellCurrent][proc];
-	     //
-	     iLocalCellCurrent++;
-	   }//locally owned
-	 }//cell loop
-	 //
-	 //
-	 MPI_Gather(&send_size0,1,MPI_UNSIGNED, &(recv_size0[0]),1, MPI_UNSIGNED,proc,mpi_communicator);
-	 MPI_Gather(&send_size1,1,MPI_UNSIGNED, &(recv_size1[0]),1, MPI_UNSIGNED,proc,mpi_communicator);
-	 //
-	 if (proc==this_mpi_process)
-	 {
-	    //
-	    for(unsigned int i = 1; i < n_mpi_processes; i++)
-	    {
-	       mpi_offsets0[i] = recv_size0[i-1]+ mpi_offsets0[i-1];
-	       mpi_offsets1[i] = recv_size1[i-1]+ mpi_offsets1[i-1];
-	    }
-	    //
-	    const unsigned int recvDataSize0 = std::accumulate(&recv_size0[0], &recv_size0[n_mpi_processes], 0);
-	    recvData0.resize(recvDataSize0,0);
-	    recvData2.resize(recvDataSize0,0);
-	    //
-	    const unsigned int recvDataSize1 = std::accumulate(&recv_size1[0], &recv_size1[n_mpi_processes], 0);
-	    recvData.resize(recvDataSize1,0.0) ;
-	    recvData1.resize(3,std::vector<double>(recvDataSize1,0.0));
-	 }
-	 //
-	 MPI_Gatherv(&(send_data0[0]),send_size0,MPI_UNSIGNED, &(recvData0[0]),&(recv_size0[0]), &(mpi_offsets0[0]), MPI_UNSIGNED,proc,mpi_communicator);
-	 MPI_Gatherv(&(send_data2[0]),send_size0,MPI_UNSIGNED, &(recvData2[0]),&(recv_size0[0]), &(mpi_offsets0[0]), MPI_UNSIGNED,proc,mpi_communicator);
-	 for (unsigned int ipol=0; ipol<3; ++ipol)
-	 {
-	      send_data = send_data1[ipol] ;
-	      MPI_Gatherv(&(send_data[0]),send_size1,MPI_DOUBLE, &(recvData[0]),&(recv_size1[0]), &(mpi_offsets1[0]),  MPI_DOUBLE,proc,mpi_communicator);
-	      if (proc==this_mpi_process)
-		  recvData1[ipol] = recvData ;
-	 }
-  }//n_mpi_processes loop
-
-  MPI_Barrier(mpi_communicator);
-  mappedGroupSend0.clear();
-  mappedGroupSend1.clear();
-  mappedGroupSend2.clear();
+     if (bestCellId<numLocallyOwnedCellsPrev)
+     {
+        recvPointsDistance[ipoint]=minDist;
+	recvPointsUnitCoords[ipoint]=dealii::GeometryInfo<3>::project_to_unit_cell(bestUnitPoint);
+	locatedCellToRecvPoints[bestCellId].push_back(ipoint);
+	previousCellId=bestCellId;
+     }
+  }
+  recvPointsData.clear();
   computing_timer.exit_section("interpolate:step3");
 
   ///////////////////////////////////////////////////////////
-  //Step4: Interpolate previous fields to all mapped points//
+  //Step4: Interpolate previous fields to all located points//
   ///////////////////////////////////////////////////////////
 
   computing_timer.enter_section("interpolate:step4");
-  AssertThrow(fieldsPreviousMesh.size()==fieldsCurrentMesh.size(),dealii::ExcMessage("Size of fieldsPreviousMesh and fieldsCurrentMesh are no the same."));
-  const unsigned int fieldsBlockSize=fieldsPreviousMesh.size();
-
   for(unsigned int ifield = 0; ifield < fieldsBlockSize; ++ifield)
     fieldsPreviousMesh[ifield]->update_ghost_values();
 
-  const unsigned int totPoints = recvData1[0].size() ;
-  std::vector<double> fieldsValuesSendData(totPoints*fieldsBlockSize*fe_components, 0.0);
-  unsigned int numPointsDone = 0, numGroupsDone = 0 ;
-  for ( unsigned int proc = 0; proc < n_mpi_processes; ++proc)
+  //per point: distance to reference cell followed by the field values
+  const unsigned int valuesPerPoint=1+fieldsBlockSize*fe_components;
+  std::vector<double> fieldsValuesSendData(valuesPerPoint*totRecvPoints+1, 0.0);
+  for (unsigned int ipoint=0; ipoint<totRecvPoints; ++ipoint)
+     fieldsValuesSendData[valuesPerPoint*ipoint]=recvPointsDistance[ipoint];
+
+  for (std::map<unsigned int,std::vector<unsigned int> >::const_iterator iter=locatedCellToRecvPoints.begin(); iter!=locatedCellToRecvPoints.end(); ++iter)
   {
-     //
-     for ( unsigned int iGroup = 0; iGroup < recv_size0[proc] ; ++iGroup )
-     {
-        const unsigned int serCellNumOfMappedPointsGroup= recvData0[numGroupsDone + iGroup];
-	const unsigned int numPointsInGroup = recvData2[numGroupsDone + iGroup];
+     const std::vector<unsigned int> & recvPointsInGroup=iter->second;
+     const unsigned int numPointsInGroup=recvPointsInGroup.size();
 
-	std::vector<dealii::Point<3>> pointsList(numPointsInGroup);
-	for (unsigned int ipoint=0; ipoint<numPointsInGroup; ++ipoint)
-	{
-          const double px = recvData1[0][numPointsDone+ipoint];
-          const double py = recvData1[1][numPointsDone+ipoint];
-          const double pz = recvData1[2][numPointsDone+ipoint];
-	  //
-          const dealii::Point<3> pointTemp(px, py, pz) ;
-          pointsList[ipoint] = pointTemp;
-	} // loop on points
-        //
-        const dealii::Quadrature<3> quadRule(pointsList);
-        dealii::FEValues<3> feValues(mapping,FEPrev, quadRule, dealii::update_values);
-
-        AssertThrow(cellNumSerPrevToParPrevCellIter[serCellNumOfMappedPointsGroup]->is_locally_owned(),
-                    dealii::ExcMessage("Cell not available here"));
-
-        feValues.reinit(cellNumSerPrevToParPrevCellIter[serCellNumOfMappedPointsGroup]);
-
-	std::vector<double> tempInterpolatedField1Comp(numPointsInGroup);
-        std::vector<dealii::Vector<double> > tempInterpolatedField(numPointsInGroup,dealii::Vector<double>(fe_components));
-
-	for(unsigned int ifield = 0; ifield < fieldsBlockSize; ++ifield)
-	{
-	   if (fe_components==1)
-	   {
-	       feValues.get_function_values(*(fieldsPreviousMesh[ifield]), tempInterpolatedField1Comp);
-	       for (unsigned int ipoint=0; ipoint<numPointsInGroup; ipoint++)
-	          fieldsValuesSendData[numPointsDone*fieldsBlockSize
-				      +ipoint*fieldsBlockSize
-				      +ifield]
-				      =tempInterpolatedField1Comp[ipoint];
-	   }
-	   else
-	   {
+     std::vector<dealii::Point<3>> pointsList(numPointsInGroup);
+     for (unsigned int ipoint=0; ipoint<numPointsInGroup; ++ipoint)
+        pointsList[ipoint]=recvPointsUnitCoords[recvPointsInGroup[ipoint]];
 
-	       feValues.get_function_values(*(fieldsPreviousMesh[ifield]), tempInterpolatedField);
-	       for (unsigned int ipoint=0; ipoint<numPointsInGroup; ipoint++)
-		   for (unsigned int icomp=0; icomp<fe_components; icomp++)
-	             fieldsValuesSendData[numPointsDone*fieldsBlockSize*fe_components
-				          +ipoint*fieldsBlockSize*fe_components
-				          +ifield*fe_components
-					  +icomp]
-				          =tempInterpolatedField[ipoint][icomp];
+     const dealii::Quadrature<3> quadRule(pointsList);
+     dealii::FEValues<3> feValues(mapping,FEPrev, quadRule, dealii::update_values);
+     feValues.reinit(locallyOwnedCellsPrev[iter->first]);
 
-	   }
-	}//field loop
-        numPointsDone += numPointsInGroup ;
-     }// loop on group
-     numGroupsDone += recv_size0[proc] ;
-   }// loop on proc
-   computing_timer.exit_section("interpolate:step4");
-
-   ///////////////////////////////////////////////////////////////
-   //Step5: scatter interpolated data back to sending processors//
-   ///////////////////////////////////////////////////////////////
-
-   computing_timer.enter_section("interpolate:step5");
-
-   std::vector<std::vector<std::vector<double>>> fieldsValuesRecvData(numLocallyOwnedCellsCurrent,std::vector<std::vector<double>>(n_mpi_processes));
-   std::vector<int> fieldsValuesRecvSize(n_mpi_processes,0);
-   cell = dofHandlerUnmovedCurrent.begin_active();
-   endc = dofHandlerUnmovedCurrent.end();
-   iLocalCellCurrent=0;
-   for (; cell!=endc; ++cell)
-	if (cell->is_locally_owned())
+     std::vector<double> tempInterpolatedField1Comp(numPointsInGroup);
+     std::vector<dealii::Vector<double> > tempInterpolatedField(numPointsInGroup,dealii::Vector<double>(fe_components));
+
+     for(unsigned int ifield = 0; ifield < fieldsBlockSize; ++ifield)
+     {
+	if (fe_components==1)
 	{
-	  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
-	  {
-	       fieldsValuesRecvSize[proc] += fieldsBlockSize*fe_components*send1_buf_size[iLocalCellCurrent][proc] ;
-	       fieldsValuesRecvData[iLocalCellCurrent][proc].resize(fieldsBlockSize*fe_components*send1_buf_size[iLocalCellCurrent][proc]) ;
-	  }//procs loop
-	  iLocalCellCurrent++;
-	}//locally owned cell loop
-
-   std::vector<int> mpiOffsetsFieldsValuesSend(n_mpi_processes);
-   std::vector<int> fieldsValuesSendSize(n_mpi_processes);
-   for(unsigned int proc = 0; proc < n_mpi_processes; proc++)
-   {
-       fieldsValuesSendSize[proc] = fieldsBlockSize*fe_components*recv_size1[proc] ;
-       mpiOffsetsFieldsValuesSend[proc] = fieldsBlockSize*fe_components*mpi_offsets1[proc] ;
-   }
-
-   for (unsigned int sendProc = 0; sendProc<n_mpi_processes; ++sendProc)
-   {
-	std::vector<double> recvData(fieldsValuesRecvSize[sendProc]);
-
-	MPI_Scatterv(&(fieldsValuesSendData[0]),&(fieldsValuesSendSize[0]), &(mpiOffsetsFieldsValuesSend[0]), MPI_DOUBLE, &(recvData[0]), fieldsValuesRecvSize[sendProc], MPI_DOUBLE,sendProc,mpi_communicator);
-
-	unsigned int offset = 0;
-	iLocalCellCurrent=0;
-        cell = dofHandlerUnmovedCurrent.begin_active();
-        endc = dofHandlerUnmovedCurrent.end();
-	for (; cell!=endc; ++cell)
-	  if (cell->is_locally_owned())
-	  {
-		for ( unsigned int i=0; i<fieldsValuesRecvData[iLocalCellCurrent][sendProc].size(); ++i)
-		     fieldsValuesRecvData[iLocalCellCurrent][sendProc][i] = recvData[offset + i];
-		offset += fieldsValuesRecvData[iLocalCellCurrent][sendProc].size();
-		iLocalCellCurrent++;
-	  }//locally owned cell loop
-   }//loop on proc
-   computing_timer.exit_section("interpolate:step5");
-
-   ////////////////////////////////////////////////////////////////////////////////////////////
-   //Step6: set values on fieldsCurrentMesh using interpolated data received after scattering//
-   ////////////////////////////////////////////////////////////////////////////////////////////
-
-   computing_timer.enter_section("interpolate:step6");
-   const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner
-                   =fieldsCurrentMesh[0]->get_partitioner();
+	    feValues.get_function_values(*(fieldsPreviousMesh[ifield]), tempInterpolatedField1Comp);
+	    for (unsigned int ipoint=0; ipoint<numPointsInGroup; ipoint++)
+	       fieldsValuesSendData[valuesPerPoint*recvPointsInGroup[ipoint]
+				    +1
+				    +ifield]
+				    =tempInterpolatedField1Comp[ipoint];
+	}
+	else
+	{
+	    feValues.get_function_values(*(fieldsPreviousMesh[ifield]), tempInterpolatedField);
+	    for (unsigned int ipoint=0; ipoint<numPointsInGroup; ipoint++)
+		for (unsigned int icomp=0; icomp<fe_components; icomp++)
+		  fieldsValuesSendData[valuesPerPoint*recvPointsInGroup[ipoint]
+				       +1
+				       +ifield*fe_components
+				       +icomp]
+				       =tempInterpolatedField[ipoint][icomp];
+	}
+     }//field loop
+  }//located cells loop
+  computing_timer.exit_section("interpolate:step4");
+
+  /////////////////////////////////////////////////////////////
+  //Step5: send interpolated data back to requesting processors//
+  /////////////////////////////////////////////////////////////
+
+  computing_timer.enter_section("interpolate:step5");
+  std::vector<int> sendValuesCount(n_mpi_processes),sendValuesOffsets(n_mpi_processes);
+  std::vector<int> recvValuesCount(n_mpi_processes),recvValuesOffsets(n_mpi_processes);
+  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
+  {
+     sendValuesCount[proc]=valuesPerPoint*recvPointsCount[proc];
+     sendValuesOffsets[proc]=valuesPerPoint*recvPointsOffsets[proc];
+     recvValuesCount[proc]=valuesPerPoint*sendPointsCount[proc];
+     recvValuesOffsets[proc]=valuesPerPoint*sendPointsOffsets[proc];
+  }
 
-   cell = dofHandlerUnmovedCurrent.begin_active();endc = dofHandlerUnmovedCurrent.end();
-   iLocalCellCurrent=0;
-   for (; cell!=endc; ++cell)
-	if (cell->is_locally_owned())
+  std::vector<double> fieldsValuesRecvData(valuesPerPoint*totSendPoints+1,0.0);
+  MPI_Alltoallv(&fieldsValuesSendData[0],
+		&sendValuesCount[0],
+		&sendValuesOffsets[0],
+		MPI_DOUBLE,
+		&fieldsValuesRecvData[0],
+		&recvValuesCount[0],
+		&recvValuesOffsets[0],
+		MPI_DOUBLE,
+		mpi_communicator);
+  fieldsValuesSendData.clear();
+  computing_timer.exit_section("interpolate:step5");
+
+  ////////////////////////////////////////////////////////////////////////////////////////////
+  //Step6: set values on fieldsCurrentMesh using the closest located cell among all returned//
+  ////////////////////////////////////////////////////////////////////////////////////////////
+
+  computing_timer.enter_section("interpolate:step6");
+  const unsigned int numPointsCurrent=pointsCurrent.size();
+  std::vector<double> pointsBestDistance(numPointsCurrent,std::numeric_limits<double>::max());
+  std::vector<unsigned int> pointsBestRecvIndex(numPointsCurrent,totSendPoints);
+  for (unsigned int proc=0; proc<n_mpi_processes; ++proc)
+     for (int i=0; i<sendPointsCount[proc]; ++i)
+     {
+        const unsigned int recvIndex=sendPointsOffsets[proc]+i;
+	const unsigned int pointId=sendPointsIds[proc][i];
+	const double dist=fieldsValuesRecvData[valuesPerPoint*recvIndex];
+	if (dist<pointsBestDistance[pointId])
 	{
-	      std::vector<dealii::types::global_dof_index> cell_dof_indices(dofs_per_cell_current);
-	      cell->get_dof_indices(cell_dof_indices);
+	   pointsBestDistance[pointId]=dist;
+	   pointsBestRecvIndex[pointId]=recvIndex;
+	}
+     }
 
-	      for (unsigned int i=0; i<mappedGroup[iLocalCellCurrent].size(); i++)
-	      {
-		  const unsigned int proc = std::get<0>(mappedGroup[iLocalCellCurrent][i]);
-		  const unsigned int baseIndexId = std::get<1>(mappedGroup[iLocalCellCurrent][i]);
-		  const unsigned int pointCount = std::get<2>(mappedGroup[iLocalCellCurrent][i]);
-		  for(unsigned int ifield = 0; ifield < fieldsBlockSize; ++ifield)
-		     for (unsigned int icomp=0; icomp<fe_components; icomp++)
-		     {
-			   const dealii::types::global_dof_index globalDofId=cell_dof_indices[FECurrent.component_to_system_index(icomp,baseIndexId)];
-			   if (partitioner->in_local_range(globalDofId))
-			        (*(fieldsCurrentMesh[ifield])).local_element(partitioner->global_to_local(globalDofId))=fieldsValuesRecvData[iLocalCellCurrent][proc][
-					                pointCount*fieldsBlockSize*fe_components
-				                        +ifield*fe_components
-					                +icomp];
-		     }//loop over components
-	      }//loop over mapped points originating from iLocalCellCurrent
-	      iLocalCellCurrent++;
-        }//locally owned loop over cells
+  for (unsigned int ipoint=0; ipoint<numPointsCurrent; ++ipoint)
+  {
+      AssertThrow(pointsBestRecvIndex[ipoint]<totSendPoints,
+	          dealii::ExcMessage("DFT-FE Error: could not locate support point of current mesh in the previous mesh."));
+
+      const unsigned int recvIndex=pointsBestRecvIndex[ipoint];
+      for(unsigned int ifield = 0; ifield < fieldsBlockSize; ++ifield)
+	 for (unsigned int icomp=0; icomp<fe_components; icomp++)
+	 {
+	       const dealii::types::global_dof_index globalDofId=pointsDofIndices[ipoint*fe_components+icomp];
+	       if (partitioner->in_local_range(globalDofId))
+		   (*(fieldsCurrentMesh[ifield])).local_element(partitioner->global_to_local(globalDofId))
+		       =fieldsValuesRecvData[valuesPerPoint*recvIndex
+					     +1
+					     +ifield*fe_components
+					     +icomp];
+	 }//loop over components
+  }//loop over points
 
   if (constraintsCurrentPtr!=NULL)
      for(unsigned int ifield = 0; ifield < fieldsBlockSize; ++ifield)
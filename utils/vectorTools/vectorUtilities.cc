@@ -175,10 +175,9 @@ namespace dftfe
       computing_timer.exit_section("Create constraints from serial dofHandler");
     }
 
-    template<typename T>
-    void createDealiiVector(const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner,
-			    const unsigned int                                                   blockSize,
-			    dealii::parallel::distributed::Vector<T>                           & flattenedArray)
+    std::shared_ptr<const dealii::Utilities::MPI::Partitioner>
+    createFlattenedPartitioner(const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner,
+			       const unsigned int                                                   blockSize)
     {
 
       const MPI_Comm & mpi_communicator=partitioner->get_communicator();
@@ -250,12 +249,22 @@ namespace dftfe
       AssertThrow(locallyOwnedFlattenedNodesSet.is_ascending_and_one_to_one(mpi_communicator),
 		  dealii::ExcMessage("Incorrect renumbering and/or partitioning of flattened wave function matrix"));
 
+      return std::make_shared<const dealii::Utilities::MPI::Partitioner>(locallyOwnedFlattenedNodesSet,
+									  ghostFlattenedNodesSet,
+									  mpi_communicator);
+    }
+
+
+    template<typename T>
+    void createDealiiVector(const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner,
+			    const unsigned int                                                   blockSize,
+			    dealii::parallel::distributed::Vector<T>                           & flattenedArray)
+    {
       //
       //create flattened wave function matrix
       //
-      flattenedArray.reinit(locallyOwnedFlattenedNodesSet,
-			    ghostFlattenedNodesSet,
-			    mpi_communicator);
+      flattenedArray.reinit(createFlattenedPartitioner(partitioner,
+						       blockSize));
     }
 
 
@@ -263,8 +272,8 @@ namespace dftfe
     void computeCellLocalIndexSetMap(const std::shared_ptr< const dealii::Utilities::MPI::Partitioner > & partitioner,
 				     const dealii::MatrixFree<3,double>                                 & matrix_free_data,
 				     const unsigned int                                                   blockSize,
-				     std::vector<std::vector<dealii::types::global_dof_index> > & flattenedArrayMacroCellLocalProcIndexIdMap,
-				     std::vector<std::vector<dealii::types::global_dof_index> > & flattenedArrayCellLocalProcIndexIdMap)
+				     std::vector<unsigned int>                                          & flattenedArrayMacroCellLocalProcIndexIdMap,
+				     std::vector<unsigned int>                                          & flattenedArrayCellLocalProcIndexIdMap)
 
     {
 
@@ -291,7 +300,7 @@ namespace dftfe
 	}
 
       flattenedArrayMacroCellLocalProcIndexIdMap.clear();
-      flattenedArrayMacroCellLocalProcIndexIdMap.resize(totalLocallyOwnedCells);
+      flattenedArrayMacroCellLocalProcIndexIdMap.resize(totalLocallyOwnedCells*numberNodesPerElement);
 
       //
       //create map for all locally owned cells in the order of macrocell, subcell order
@@ -311,8 +320,7 @@ namespace dftfe
 
 		  //Think about variable blockSize
 		  dealii::types::global_dof_index globalIndexFlattenedArray = (dealii::types::global_dof_index)blockSize*globalIndex;
-		  dealii::types::global_dof_index localIndexFlattenedArray = partitioner->global_to_local(globalIndexFlattenedArray);
-		  flattenedArrayMacroCellLocalProcIndexIdMap[iElem].push_back(localIndexFlattenedArray);
+		  flattenedArrayMacroCellLocalProcIndexIdMap[iElem*numberNodesPerElement+iNode] = partitioner->global_to_local(globalIndexFlattenedArray);
 		}//idof loop
 	      ++iElem;
 	    }//subcell loop
@@ -326,7 +334,7 @@ namespace dftfe
       std::vector<dealii::types::global_dof_index> cell_dof_indices(numberNodesPerElement);
 
       flattenedArrayCellLocalProcIndexIdMap.clear();
-      flattenedArrayCellLocalProcIndexIdMap.resize(totalLocallyOwnedCells);
+      flattenedArrayCellLocalProcIndexIdMap.resize(totalLocallyOwnedCells*numberNodesPerElement);
 
       unsigned int iElemCount = 0;
       for(; cell!=endc; ++cell)
@@ -340,8 +348,7 @@ namespace dftfe
 
 		  //Think about variable blockSize
 		  dealii::types::global_dof_index globalIndexFlattenedArray = (dealii::types::global_dof_index)blockSize*globalIndex;
-		  dealii::types::global_dof_index localIndexFlattenedArray = partitioner->global_to_local(globalIndexFlattenedArray);
-		  flattenedArrayCellLocalProcIndexIdMap[iElemCount].push_back(localIndexFlattenedArray);
+		  flattenedArrayCellLocalProcIndexIdMap[iElemCount*numberNodesPerElement+iNode] = partitioner->global_to_local(globalIndexFlattenedArray);
 		}
 	      ++iElemCount;
 	    }